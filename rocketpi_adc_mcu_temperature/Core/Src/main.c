@@ -19,12 +19,15 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "adc.h"
+#include "dma.h"
 #include "usart.h"
 #include "gpio.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include <stdio.h>
+#include "driver_adc_sampler.h"
+#include "debug_driver.h"
 
 /* USER CODE END Includes */
 
@@ -52,6 +55,7 @@
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
+static HAL_StatusTypeDef start_mcu_temperature_sampler(void);
 static HAL_StatusTypeDef read_mcu_temperature(float *temperature_c);
 static void print_temperature(float temperature_c);
 static void print_temperature_read_error(void);
@@ -76,32 +80,53 @@ static void print_temperature_read_error(void);
 #define TEMPSENSOR_CAL2_ADDR  ((uint16_t*)(0x1FFF7A2EU))
 #endif
 #define ADC_CALIB_READ16(addr) (*((volatile uint16_t *)(addr)))
-#define ADC_MEDIAN_SAMPLE_COUNT    5U
-#define ADC_CONVERSION_TIMEOUT_MS 10U
+#define ADC_SAMPLER_RANK_TEMP      0U
+#define ADC_SAMPLER_RANK_VREFINT   1U
+#define ADC_SAMPLER_CHANNEL_COUNT  2U
+#define ADC_OVERSAMPLE_LOG2        4U
+#define ADC_EMA_SHIFT              4U
+#define ADC_READY_TIMEOUT_MS       20U
 
-/* 中值滤波中使用的简单插入排序，样本数较小时效率尚可。 */
-static void insertion_sort(uint32_t *data, uint32_t length)
+/*
+ * 启动后台采集：温度/VREFINT 两个通道以循环 DMA 连续扫描，
+ * 每 16 帧（约 0.75 ms）平均为一个样本，并在中断中维护滑动中值。
+ * 等到第一个中值窗口填满（约 4 ms）再返回，主循环第一次读取即有有效数据。
+ */
+static HAL_StatusTypeDef start_mcu_temperature_sampler(void)
 {
-  for (uint32_t i = 1U; i < length; ++i)
+  const adc_sampler_config_t config =
+  {
+    .hadc = &hadc1,
+    .channel_count = ADC_SAMPLER_CHANNEL_COUNT,
+    .oversample_log2 = ADC_OVERSAMPLE_LOG2,
+    .decimation_shift = ADC_OVERSAMPLE_LOG2,
+    .ema_shift = ADC_EMA_SHIFT,
+  };
+
+  if (adc_sampler_start(&config) != 0U)
+  {
+    return HAL_ERROR;
+  }
+
+  uint32_t start = HAL_GetTick();
+
+  while (adc_sampler_is_ready() == 0U)
   {
-    uint32_t key = data[i];
-    int32_t j = (int32_t)i - 1;
-    while ((j >= 0) && (data[j] > key))
+    if ((HAL_GetTick() - start) > ADC_READY_TIMEOUT_MS)
     {
-      data[j + 1] = data[j];
-      --j;
+      return HAL_TIMEOUT;
     }
-    data[j + 1] = key;
   }
+
+  return HAL_OK;
 }
 
 /*
  * 读取 MCU 内置温度与 VREFINT，结合校准常数计算校准后的摄氏温度：
- * 1. 连续触发 ADC，获取多组温度/基准电压结果。
- * 2. 对两组原始数据分别做插入排序并取中值，抑制瞬时噪声。
- * 3. 使用 VREFINT 工厂校准常数推算当前 VDDA 后，将温度采样值映射到
+ * 1. 从后台采集服务中以 O(1) 取出温度/基准电压的最新中值，不再触发或轮询 ADC。
+ * 2. 使用 VREFINT 工厂校准常数推算当前 VDDA 后，将温度采样值映射到
  *    TS_CAL1/TS_CAL2 所定义的 30°C~110°C 直线，得到实际温度。
- * 4. 若校准常数缺失，则退化为使用典型 V25/斜率的粗略计算。
+ * 3. 若校准常数缺失，则退化为使用典型 V25/斜率的粗略计算。
  */
 static HAL_StatusTypeDef read_mcu_temperature(float *temperature_c)
 {
@@ -110,47 +135,16 @@ static HAL_StatusTypeDef read_mcu_temperature(float *temperature_c)
     return HAL_ERROR;
   }
 
-  HAL_StatusTypeDef status = HAL_OK;
-  uint32_t temp_samples[ADC_MEDIAN_SAMPLE_COUNT];
-  uint32_t vref_samples[ADC_MEDIAN_SAMPLE_COUNT];
+  /* 温度与 VREFINT 必须来自同一次更新，否则 VDDA 校正会用错基准 */
+  adc_sampler_value_t values[ADC_SAMPLER_CHANNEL_COUNT];
 
-  for (uint32_t i = 0U; i < ADC_MEDIAN_SAMPLE_COUNT; ++i)
+  if (adc_sampler_read_all(values, ADC_SAMPLER_CHANNEL_COUNT) != 0U)
   {
-    status = HAL_ADC_Start(&hadc1);
-    if (status != HAL_OK)
-    {
-      goto cleanup;
-    }
-
-    status = HAL_ADC_PollForConversion(&hadc1, ADC_CONVERSION_TIMEOUT_MS);
-    if (status != HAL_OK)
-    {
-      goto cleanup;
-    }
-
-    temp_samples[i] = HAL_ADC_GetValue(&hadc1);
-
-    status = HAL_ADC_PollForConversion(&hadc1, ADC_CONVERSION_TIMEOUT_MS);
-    if (status != HAL_OK)
-    {
-      goto cleanup;
-    }
-
-    vref_samples[i] = HAL_ADC_GetValue(&hadc1);
-  }
-
-cleanup:
-  HAL_ADC_Stop(&hadc1);
-  if (status != HAL_OK)
-  {
-    return status;
+    return HAL_BUSY;
   }
 
-  insertion_sort(temp_samples, ADC_MEDIAN_SAMPLE_COUNT);
-  insertion_sort(vref_samples, ADC_MEDIAN_SAMPLE_COUNT);
-
-  uint32_t raw_temp = temp_samples[ADC_MEDIAN_SAMPLE_COUNT / 2U];
-  uint32_t raw_vrefint = vref_samples[ADC_MEDIAN_SAMPLE_COUNT / 2U];
+  uint32_t raw_temp = values[ADC_SAMPLER_RANK_TEMP].median;
+  uint32_t raw_vrefint = values[ADC_SAMPLER_RANK_VREFINT].median;
 
   if (raw_vrefint == 0U)
   {
@@ -188,15 +182,8 @@ cleanup:
 /* 将温度格式化成字符串并通过 USART2 输出。 */
 static void print_temperature(float temperature_c)
 {
-  char buffer[64];
-  int length = snprintf(buffer, sizeof(buffer), "MCU Temp: %.2f C\r\n", temperature_c);
-  if (length <= 0)
-  {
-    return;
-  }
-
-  uint16_t bytes_to_send = (length < (int)sizeof(buffer)) ? (uint16_t)length : (uint16_t)(sizeof(buffer) - 1U);
-  HAL_UART_Transmit(&huart2, (uint8_t *)buffer, bytes_to_send, HAL_MAX_DELAY);
+  /* uart_printf 用整数定点转换 %.2f，不经过 C 库的浮点格式化 */
+  uart_printf("MCU Temp: %.2f C\n", (double)temperature_c);
 }
 
 /* 当温度采集失败时输出错误信息，便于调试。 */
@@ -237,9 +224,14 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_USART2_UART_Init();
   MX_ADC1_Init();
   /* USER CODE BEGIN 2 */
+  if (start_mcu_temperature_sampler() != HAL_OK)
+  {
+    print_temperature_read_error();
+  }
 
   /* USER CODE END 2 */
 
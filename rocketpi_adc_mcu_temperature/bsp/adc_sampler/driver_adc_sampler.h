@@ -0,0 +1,158 @@
+/**
+ * @file driver_adc_sampler.h
+ * @brief ADC 规则组扫描 + 循环 DMA 的后台采集服务（过采样、中值与 EMA 滤波）。
+ * @version 1.0.0
+ * @date 2025-11-20
+ *
+ * ADC 以连续扫描模式运行，DMA 以循环方式把整条序列写入双半区缓冲：
+ *   1. 每个半区包含 2^oversample_log2 帧完整序列，半传输/传输完成中断
+ *      中对各通道求和并右移 decimation_shift 位，得到一个抽取后的样本。
+ *   2. 抽取样本写入每通道的环形缓冲，并在中断内更新滑动中值与 EMA。
+ *   3. 应用层通过 adc_sampler_read()/adc_sampler_get_*() 以 O(1) 读取
+ *      最新的滤波结果，无需再启动、轮询或停止 ADC。
+ */
+#pragma once
+
+#include "adc.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 扫描序列中支持的最大通道数（需与 hadc->Init.NbrOfConversion 匹配）。
+ */
+#ifndef ADC_SAMPLER_MAX_CHANNELS
+#define ADC_SAMPLER_MAX_CHANNELS          4U
+#endif
+
+/**
+ * @brief 允许的最大过采样倍数（以 2 的幂表示），决定 DMA 缓冲大小。
+ */
+#ifndef ADC_SAMPLER_MAX_OVERSAMPLE_LOG2
+#define ADC_SAMPLER_MAX_OVERSAMPLE_LOG2   6U
+#endif
+
+/**
+ * @brief 每通道抽取样本环形缓冲深度，必须为 2 的幂。
+ */
+#ifndef ADC_SAMPLER_RING_DEPTH
+#define ADC_SAMPLER_RING_DEPTH            8U
+#endif
+
+/**
+ * @brief 滑动中值窗口长度，必须为奇数且不大于 ADC_SAMPLER_RING_DEPTH。
+ */
+#ifndef ADC_SAMPLER_MEDIAN_WINDOW
+#define ADC_SAMPLER_MEDIAN_WINDOW         5U
+#endif
+
+#if (ADC_SAMPLER_RING_DEPTH & (ADC_SAMPLER_RING_DEPTH - 1U)) != 0U
+#error "ADC_SAMPLER_RING_DEPTH 必须为 2 的幂。"
+#endif
+
+#if ((ADC_SAMPLER_MEDIAN_WINDOW & 1U) == 0U) || (ADC_SAMPLER_MEDIAN_WINDOW > ADC_SAMPLER_RING_DEPTH)
+#error "ADC_SAMPLER_MEDIAN_WINDOW 必须为奇数且不大于 ADC_SAMPLER_RING_DEPTH。"
+#endif
+
+/**
+ * @brief 采集服务配置。
+ */
+typedef struct
+{
+    ADC_HandleTypeDef *hadc;    /**< 已由 MX_ADCx_Init 初始化、并已链接循环 DMA 的 ADC 句柄 */
+    uint8_t channel_count;      /**< 扫描序列长度（1..ADC_SAMPLER_MAX_CHANNELS） */
+    uint8_t oversample_log2;    /**< 每个抽取样本累加 2^n 帧（0..ADC_SAMPLER_MAX_OVERSAMPLE_LOG2） */
+    uint8_t decimation_shift;   /**< 累加和右移位数，等于 oversample_log2 时为平均值，更小则扩展分辨率 */
+    uint8_t ema_shift;          /**< EMA 系数 alpha = 1 / 2^ema_shift（1..8） */
+} adc_sampler_config_t;
+
+/**
+ * @brief 单通道的最新采集结果。
+ */
+typedef struct
+{
+    uint16_t raw;       /**< 最近一次抽取后的样本 */
+    uint16_t median;    /**< 最近 ADC_SAMPLER_MEDIAN_WINDOW 个抽取样本的中值 */
+    uint16_t ema;       /**< 指数滑动平均值 */
+} adc_sampler_value_t;
+
+/**
+ * @brief     启动后台采集：配置连续扫描并开启循环 DMA。
+ * @param[in] config 采集配置，内容会被复制，调用后可释放。
+ * @return    状态码
+ *            - 0 成功
+ *            - 1 参数非法
+ *            - 2 启动 ADC DMA 失败
+ */
+uint8_t adc_sampler_start(const adc_sampler_config_t *config);
+
+/**
+ * @brief  停止后台采集，已有的滤波结果保持不变。
+ * @return 状态码
+ *         - 0 成功
+ *         - 1 停止失败
+ */
+uint8_t adc_sampler_stop(void);
+
+/**
+ * @brief  查询是否已经产生至少一个完整的中值窗口。
+ * @return 就绪返回 1，否则返回 0。
+ */
+uint8_t adc_sampler_is_ready(void);
+
+/**
+ * @brief  获取已完成的抽取样本计数，可用于判断数据是否更新。
+ * @return 单调递增的样本序号。
+ */
+uint32_t adc_sampler_get_sequence(void);
+
+/**
+ * @brief      读取某个通道的一致性快照（raw/median/ema 来自同一次更新）。
+ * @param[in]  rank  扫描序列中的位置（0 起始）。
+ * @param[out] value 接收结果。
+ * @return     状态码
+ *             - 0 成功
+ *             - 1 参数非法
+ *             - 2 尚无有效数据
+ */
+uint8_t adc_sampler_read(uint8_t rank, adc_sampler_value_t *value);
+
+/**
+ * @brief      读取前 count 个通道的一致性快照，所有通道来自同一次更新。
+ *             需要组合多个通道（如 VREFINT 校正温度、摇杆 X/Y）时使用，
+ *             分别调用 adc_sampler_get_median() 可能跨越两次更新。
+ * @param[out] values 接收结果的数组，至少 count 个元素。
+ * @param[in]  count  通道数（1..channel_count）。
+ * @return     状态码
+ *             - 0 成功
+ *             - 1 参数非法
+ *             - 2 尚无有效数据
+ */
+uint8_t adc_sampler_read_all(adc_sampler_value_t *values, uint8_t count);
+
+/**
+ * @brief     读取某个通道的最新中值（O(1)，无锁）。
+ * @param[in] rank 扫描序列中的位置（0 起始），越界返回 0。
+ * @return    中值滤波结果。
+ */
+uint16_t adc_sampler_get_median(uint8_t rank);
+
+/**
+ * @brief     读取某个通道的最新 EMA（O(1)，无锁）。
+ * @param[in] rank 扫描序列中的位置（0 起始），越界返回 0。
+ * @return    EMA 滤波结果。
+ */
+uint16_t adc_sampler_get_ema(uint8_t rank);
+
+/**
+ * @brief  获取因 ADC 溢出等错误而自动重启的次数。
+ * @return 重启计数。
+ */
+uint32_t adc_sampler_get_restart_count(void);
+
+#ifdef __cplusplus
+}
+#endif
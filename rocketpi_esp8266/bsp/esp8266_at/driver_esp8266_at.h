@@ -15,8 +15,13 @@ extern "C" {
 
 #define ESP8266_AT_MAX_LINE_LENGTH          256U
 #define ESP8266_AT_MAX_ARGUMENTS            16U
-#define ESP8266_AT_MAX_ARGUMENT_LENGTH      128U
 #define ESP8266_AT_EVENT_QUEUE_DEPTH        24U
+#define ESP8266_AT_EVENT_ARENA_SIZE         1024U
+#define ESP8266_AT_ASYNC_QUEUE_DEPTH        8U
+#define ESP8266_AT_ASYNC_ARGUMENT_LENGTH    160U
+#define ESP8266_AT_MAX_URC_HANDLERS         8U
+#define ESP8266_AT_BUSY_RETRY_MS            20U
+#define ESP8266_AT_BUSY_MAX_RETRIES         5U
 #define ESP8266_AT_DEFAULT_TIMEOUT_MS       2000U
 #define ESP8266_AT_RESET_TIMEOUT_MS         3000U
 #define ESP8266_AT_PROMPT_CHAR              '>'
@@ -26,6 +31,14 @@ extern "C" {
 #define ESP8266_AT_USE_MQTTCONNCFG          0
 #endif
 
+/* 事件行文本统一存放在环形 arena 中，大小须为 2 的幂且至少容纳两条最长行。 */
+#if (ESP8266_AT_EVENT_ARENA_SIZE & (ESP8266_AT_EVENT_ARENA_SIZE - 1U)) != 0U
+#error "ESP8266_AT_EVENT_ARENA_SIZE must be a power of two"
+#endif
+#if ESP8266_AT_EVENT_ARENA_SIZE < (2U * ESP8266_AT_MAX_LINE_LENGTH)
+#error "ESP8266_AT_EVENT_ARENA_SIZE must hold at least two maximum-length lines"
+#endif
+
 
 typedef enum
 {
@@ -161,6 +174,29 @@ typedef enum
     MACRO(90, UART_CUR,         "AT+UART_CUR",        0, 1, 1, 0) \
     MACRO(91, UART_DEF,         "AT+UART_DEF",        0, 1, 1, 0)
 
+/* Unsolicited result codes that are not command prefixes. They share the
+ * prefix hash with ESP8266_AT_COMMAND_TABLE so any of them can be routed. */
+#define ESP8266_AT_URC_TABLE(MACRO) \
+    MACRO(MQTTSUBRECV,      "+MQTTSUBRECV") \
+    MACRO(MQTTCONNECTED,    "+MQTTCONNECTED") \
+    MACRO(MQTTDISCONNECTED, "+MQTTDISCONNECTED") \
+    MACRO(STA_CONNECTED,    "+STA_CONNECTED") \
+    MACRO(STA_DISCONNECTED, "+STA_DISCONNECTED") \
+    MACRO(DIST_STA_IP,      "+DIST_STA_IP") \
+    MACRO(LINK_CONN,        "+LINK_CONN") \
+    MACRO(WIFI_CONNECTED,   "WIFI CONNECTED") \
+    MACRO(WIFI_GOT_IP,      "WIFI GOT IP") \
+    MACRO(WIFI_DISCONNECT,  "WIFI DISCONNECT") \
+    MACRO(READY,            "ready")
+
+typedef enum
+{
+#define ESP8266_AT_DECLARE_URC(NAME, TEXT) ESP8266_AT_URC_##NAME,
+    ESP8266_AT_URC_TABLE(ESP8266_AT_DECLARE_URC)
+#undef ESP8266_AT_DECLARE_URC
+    ESP8266_AT_URC_COUNT
+} esp8266_at_urc_id_t;
+
 typedef enum
 {
 #define ESP8266_AT_DECLARE_ENUM(ID, NAME, LITERAL, T, Q, S, E) ESP8266_AT_CMD_##NAME = (ID),
@@ -179,24 +215,58 @@ typedef struct
     bool                    supports_execute;
 } esp8266_at_command_def_t;
 
+/**
+ * Location of one comma-separated argument inside esp8266_at_event_t::payload.
+ * Surrounding whitespace and quotes are excluded from [offset, offset + length).
+ */
 typedef struct
 {
-    char value[ESP8266_AT_MAX_ARGUMENT_LENGTH];
-    bool quoted;
+    uint8_t offset;
+    uint8_t length;
+    bool    quoted;
 } esp8266_at_argument_t;
 
+/**
+ * Zero-copy view of one received line. raw_line/payload point into the driver's
+ * event arena and stay valid until the next esp8266_at_fetch_event() or
+ * esp8266_at_clear_events() call. Arguments are tokenised on demand with
+ * esp8266_at_event_arguments()/esp8266_at_event_argument().
+ */
 typedef struct
 {
     esp8266_at_event_type_t   type;
     esp8266_at_command_id_t   command;
     esp8266_at_command_mode_t mode;
-    char                      raw_line[ESP8266_AT_MAX_LINE_LENGTH];
-    char                      prefix[32];
-    char                      payload[ESP8266_AT_MAX_LINE_LENGTH];
-    size_t                    argument_count;
-    esp8266_at_argument_t     arguments[ESP8266_AT_MAX_ARGUMENTS];
+    const char               *raw_line;      /* trimmed line, NUL terminated */
+    const char               *payload;       /* text after "+PREFIX:" or the whole line */
+    uint16_t                  line_length;
+    uint8_t                   prefix_length; /* leading prefix in raw_line, 0 if none */
 } esp8266_at_event_t;
 
+/**
+ * Receives the data bytes of one "+IPD,[<link>,]<len>:" frame. Called from the
+ * UART RX context, possibly several times per frame as DMA chunks arrive.
+ * link_id is 0 for single-connection (CIPMUX=0) frames.
+ */
+typedef void (*esp8266_at_ipd_handler_t)(uint8_t link_id,
+                                         const uint8_t *data,
+                                         size_t length,
+                                         void *context);
+
+/** Sees every parsed line (UART RX context) before it is queued. */
+typedef void (*esp8266_at_line_observer_t)(const esp8266_at_event_t *event, void *context);
+
+/**
+ * Handles a routed URC in the UART RX context. Routed lines are consumed and
+ * do not show up in esp8266_at_fetch_event(); keep the handler short.
+ */
+typedef void (*esp8266_at_urc_handler_t)(const esp8266_at_event_t *event, void *context);
+
+/** Completion of a command queued with esp8266_at_submit(); runs in esp8266_at_process(). */
+typedef void (*esp8266_at_completion_t)(esp8266_at_status_t status,
+                                        const esp8266_at_event_t *terminal_event,
+                                        void *context);
+
 typedef struct
 {
     char station_ip[48];
@@ -255,10 +325,62 @@ esp8266_at_status_t esp8266_at_mqtt_disconnect(uint8_t link_id);
 
 bool esp8266_at_fetch_event(esp8266_at_event_t *event);
 size_t esp8266_at_pending_event_count(void);
+size_t esp8266_at_dropped_event_count(void);
+
+bool esp8266_at_event_has_prefix(const esp8266_at_event_t *event, const char *prefix);
+size_t esp8266_at_event_arguments(const esp8266_at_event_t *event,
+                                  esp8266_at_argument_t *arguments,
+                                  size_t max_arguments);
+bool esp8266_at_event_argument(const esp8266_at_event_t *event,
+                               size_t index,
+                               esp8266_at_argument_t *argument);
+size_t esp8266_at_event_copy_argument(const esp8266_at_event_t *event,
+                                      size_t index,
+                                      char *buffer,
+                                      size_t buffer_size);
 void esp8266_at_poll(void);
 void esp8266_at_receive_bytes(const uint8_t *data, size_t length);
 void esp8266_at_debug_print_events(bool keep_events);
 void esp8266_at_clear_events(void);
+void esp8266_at_set_ipd_handler(esp8266_at_ipd_handler_t handler, void *context);
+void esp8266_at_set_line_observer(esp8266_at_line_observer_t observer, void *context);
+
+/*
+ * Non-blocking command pipeline: commands are queued and started one at a
+ * time from esp8266_at_process(); "busy p..." replies are retried with
+ * exponential backoff. The blocking API returns BUSY while one is in flight.
+ */
+esp8266_at_status_t esp8266_at_submit(esp8266_at_command_id_t command,
+                                      esp8266_at_command_mode_t mode,
+                                      const char *arguments,
+                                      uint32_t timeout_ms,
+                                      esp8266_at_completion_t callback,
+                                      void *context);
+/**
+ * Like esp8266_at_submit() for prompt commands (AT+CIPSEND, AT+MQTTPUBRAW):
+ * data is written once the modem answers '>'. The buffer is not copied and
+ * must stay valid until the completion callback runs.
+ */
+esp8266_at_status_t esp8266_at_submit_data(esp8266_at_command_id_t command,
+                                           esp8266_at_command_mode_t mode,
+                                           const char *arguments,
+                                           const uint8_t *data,
+                                           size_t data_length,
+                                           uint32_t timeout_ms,
+                                           esp8266_at_completion_t callback,
+                                           void *context);
+void esp8266_at_process(void);
+size_t esp8266_at_pending_command_count(void);
+
+/**
+ * Routes lines whose prefix ("+MQTTSUBRECV", "+CWJAP", ...) or full text
+ * ("WIFI DISCONNECT", "ready") matches key to handler. A "+CMD" response
+ * that answers the command currently in flight is never routed.
+ * Passing a NULL handler removes the route.
+ */
+esp8266_at_status_t esp8266_at_register_urc(const char *key,
+                                            esp8266_at_urc_handler_t handler,
+                                            void *context);
 
 #ifdef __cplusplus
 }
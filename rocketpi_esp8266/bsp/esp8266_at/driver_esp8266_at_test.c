@@ -10,6 +10,7 @@
 #include "stm32f4xx_hal.h"
 
 #include "driver_esp8266_at.h"
+#include "driver_esp8266_mqtt.h"
 
 #ifndef ESP8266_AT_TEST_WIFI_SSID
 #define ESP8266_AT_TEST_WIFI_SSID        "ZTE-45c476"
@@ -39,6 +40,13 @@
 #ifndef ESP8266_AT_TEST_MQTT_MESSAGE
 #define ESP8266_AT_TEST_MQTT_MESSAGE     "hello from rocketpi"
 #endif
+/* Messages queued through the non-blocking publisher after the blocking MQTTPUB. */
+#ifndef ESP8266_AT_TEST_MQTT_BURST
+#define ESP8266_AT_TEST_MQTT_BURST       8U
+#endif
+#ifndef ESP8266_AT_TEST_MQTT_DRAIN_MS
+#define ESP8266_AT_TEST_MQTT_DRAIN_MS    15000U
+#endif
 
 static void esp8266_at_test_log_status(const char *label, esp8266_at_status_t status)
 {
@@ -86,15 +94,21 @@ static void esp8266_at_test_print_event(const esp8266_at_event_t *event)
     }
     printf("\r\n");
 
-    if (event->argument_count > 0U)
+    if (event->type != ESP8266_AT_EVENT_TYPE_RESPONSE)
     {
-        for (size_t i = 0U; i < event->argument_count; ++i)
-        {
-            printf("        arg%u%s: %s\r\n",
-                   (unsigned int)i,
-                   event->arguments[i].quoted ? "(q)" : "",
-                   event->arguments[i].value);
-        }
+        return;
+    }
+
+    esp8266_at_argument_t arguments[ESP8266_AT_MAX_ARGUMENTS];
+    const size_t argument_count =
+        esp8266_at_event_arguments(event, arguments, ESP8266_AT_MAX_ARGUMENTS);
+    for (size_t i = 0U; i < argument_count; ++i)
+    {
+        printf("        arg%u%s: %.*s\r\n",
+               (unsigned int)i,
+               arguments[i].quoted ? "(q)" : "",
+               (int)arguments[i].length,
+               &event->payload[arguments[i].offset]);
     }
 }
 
@@ -108,6 +122,56 @@ static void esp8266_at_test_drain_events(uint32_t delay_ms)
     esp8266_at_test_poll();
 }
 
+/*
+ * Publish a burst through the esp8266_mqtt outbox and pump it from this loop,
+ * as an application main loop would. The broker link from MQTTCONN is already
+ * up, so the publisher is put online directly.
+ */
+static void esp8266_at_test_mqtt_outbox(void)
+{
+    esp8266_at_status_t status = esp8266_mqtt_init(0U, NULL);
+    esp8266_at_test_log_status("mqtt_init", status);
+    if (status != ESP8266_AT_STATUS_OK)
+    {
+        return;
+    }
+    esp8266_mqtt_set_online(true);
+
+    const esp8266_mqtt_topic_t topic = esp8266_mqtt_intern(ESP8266_AT_TEST_MQTT_TOPIC);
+    for (uint32_t i = 0U; i < ESP8266_AT_TEST_MQTT_BURST; ++i)
+    {
+        char message[ESP8266_MQTT_PAYLOAD_SIZE];
+        const int length = snprintf(message, sizeof(message), "%s #%lu",
+                                    ESP8266_AT_TEST_MQTT_MESSAGE, (unsigned long)i);
+        status = esp8266_mqtt_publish(topic, message, (size_t)length, 1U, false);
+        if (status != ESP8266_AT_STATUS_OK)
+        {
+            esp8266_at_test_log_status("mqtt_publish", status);
+            break;
+        }
+    }
+
+    /* Keep pumping until the modem acknowledged everything and the AT pipeline is idle. */
+    const uint32_t start = HAL_GetTick();
+    while ((esp8266_mqtt_outbox_count() > 0U || esp8266_at_pending_command_count() > 0U)
+           && (HAL_GetTick() - start) < ESP8266_AT_TEST_MQTT_DRAIN_MS)
+    {
+        esp8266_mqtt_process();
+    }
+
+    esp8266_mqtt_stats_t stats;
+    esp8266_mqtt_get_stats(&stats);
+    printf("[ESP8266][mqtt_outbox] published=%lu commands=%lu retries=%lu dropped=%lu left=%u (%lu ms)\r\n",
+           (unsigned long)stats.published,
+           (unsigned long)stats.commands,
+           (unsigned long)stats.retries,
+           (unsigned long)stats.dropped,
+           (unsigned int)esp8266_mqtt_outbox_count(),
+           (unsigned long)(HAL_GetTick() - start));
+    esp8266_mqtt_deinit();
+    esp8266_at_test_drain_events(150U);
+}
+
 static bool esp8266_at_test_is_placeholder(const char *value,
                                            const char *placeholder)
 {
@@ -257,6 +321,8 @@ void esp8266_at_test_run(void)
             esp8266_at_test_log_status("MQTTPUB", status);
             esp8266_at_test_drain_events(150U);
 
+            esp8266_at_test_mqtt_outbox();
+
             char unsub_args[ESP8266_AT_MAX_LINE_LENGTH];
             (void)snprintf(unsub_args,
                            sizeof(unsub_args),
@@ -0,0 +1,526 @@
+/**
+ * @file driver_esp8266_mqtt.c
+ * @brief Windowed, coalescing MQTT publisher for the ESP8266 AT driver.
+ */
+#include "driver_esp8266_mqtt.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "driver_esp8266_at_interface.h"
+
+typedef enum
+{
+    ESP8266_MQTT_SLOT_FREE = 0,
+    ESP8266_MQTT_SLOT_PENDING,
+    ESP8266_MQTT_SLOT_IN_FLIGHT
+} esp8266_mqtt_slot_state_t;
+
+typedef struct
+{
+    uint32_t sequence;
+    uint16_t length;
+    uint8_t  topic;
+    uint8_t  qos;
+    uint8_t  retain;
+    uint8_t  state;
+    uint8_t  payload[ESP8266_MQTT_PAYLOAD_SIZE];
+} esp8266_mqtt_slot_t;
+
+/* One AT+MQTTPUB / AT+MQTTPUBRAW in the AT pipeline; buffer backs the raw payload. */
+typedef struct
+{
+    bool     used;
+    uint32_t slots;           /* bit n = outbox slot n */
+    uint8_t  buffer[ESP8266_MQTT_BATCH_SIZE];
+} esp8266_mqtt_batch_t;
+
+typedef struct
+{
+    bool                   initialised;
+    volatile bool          online;
+    bool                   holdoff;
+    uint8_t                link_id;
+    uint8_t                head;
+    uint8_t                count;
+    uint8_t                in_flight;
+    uint8_t                topic_count;
+    uint32_t               next_sequence;
+    uint32_t               resume_tick;
+    esp8266_mqtt_backend_t backend;
+    esp8266_mqtt_stats_t   stats;
+    char                   topics[ESP8266_MQTT_MAX_TOPICS][ESP8266_MQTT_TOPIC_LENGTH];
+    esp8266_mqtt_slot_t    slots[ESP8266_MQTT_OUTBOX_DEPTH];
+    esp8266_mqtt_batch_t   batches[ESP8266_MQTT_WINDOW];
+} esp8266_mqtt_ctx_t;
+
+static esp8266_mqtt_ctx_t s_mqtt;
+
+static void esp8266_mqtt_on_connected(const esp8266_at_event_t *event, void *context)
+{
+    (void)event;
+    (void)context;
+    s_mqtt.online = true;
+}
+
+static void esp8266_mqtt_on_disconnected(const esp8266_at_event_t *event, void *context)
+{
+    (void)event;
+    (void)context;
+    s_mqtt.online = false;
+}
+
+/* AT string parameters need '"', ',' and '\\' escaped. Returns false if output is too small. */
+static bool esp8266_mqtt_escape(const char *input, size_t length, char *output, size_t output_size)
+{
+    size_t out = 0U;
+    for (size_t i = 0U; i < length; ++i)
+    {
+        const char ch = input[i];
+        if (ch == '\0' || ch == '\r' || ch == '\n')
+        {
+            return false;
+        }
+        if (ch == '"' || ch == ',' || ch == '\\')
+        {
+            if (out + 1U >= output_size)
+            {
+                return false;
+            }
+            output[out++] = '\\';
+        }
+        if (out + 1U >= output_size)
+        {
+            return false;
+        }
+        output[out++] = ch;
+    }
+    output[out] = '\0';
+    return true;
+}
+
+static void esp8266_mqtt_release_slot(uint8_t index)
+{
+    s_mqtt.slots[index].state    = ESP8266_MQTT_SLOT_FREE;
+    s_mqtt.slots[index].sequence = 0U;
+    if (s_mqtt.backend.erase != NULL)
+    {
+        s_mqtt.backend.erase(index, s_mqtt.backend.context);
+    }
+
+    /* Acks can complete out of order after a retry, so only trim the front. */
+    while (s_mqtt.count > 0U && s_mqtt.slots[s_mqtt.head].state == ESP8266_MQTT_SLOT_FREE)
+    {
+        s_mqtt.head = (uint8_t)((s_mqtt.head + 1U) % ESP8266_MQTT_OUTBOX_DEPTH);
+        s_mqtt.count--;
+    }
+}
+
+static void esp8266_mqtt_on_complete(esp8266_at_status_t status,
+                                     const esp8266_at_event_t *terminal_event,
+                                     void *context)
+{
+    (void)terminal_event;
+    esp8266_mqtt_batch_t *batch = (esp8266_mqtt_batch_t *)context;
+
+    s_mqtt.stats.commands++;
+    for (uint8_t i = 0U; i < ESP8266_MQTT_OUTBOX_DEPTH; ++i)
+    {
+        if ((batch->slots & (1UL << i)) == 0U)
+        {
+            continue;
+        }
+
+        esp8266_mqtt_slot_t *slot = &s_mqtt.slots[i];
+        if (status == ESP8266_AT_STATUS_OK)
+        {
+            s_mqtt.stats.published++;
+            esp8266_mqtt_release_slot(i);
+        }
+        else if (slot->qos == 0U)
+        {
+            s_mqtt.stats.dropped++;
+            esp8266_mqtt_release_slot(i);
+        }
+        else
+        {
+            s_mqtt.stats.retries++;
+            slot->state = ESP8266_MQTT_SLOT_PENDING;
+        }
+    }
+
+    if (status != ESP8266_AT_STATUS_OK)
+    {
+        s_mqtt.holdoff     = true;
+        s_mqtt.resume_tick = esp8266_at_interface_hw_get_tick() + ESP8266_MQTT_RETRY_DELAY_MS;
+    }
+
+    batch->used  = false;
+    batch->slots = 0U;
+    s_mqtt.in_flight--;
+}
+
+static esp8266_mqtt_batch_t *esp8266_mqtt_free_batch(void)
+{
+    for (size_t i = 0U; i < ESP8266_MQTT_WINDOW; ++i)
+    {
+        if (!s_mqtt.batches[i].used)
+        {
+            return &s_mqtt.batches[i];
+        }
+    }
+    return NULL;
+}
+
+/* Collects the oldest pending message plus the pending messages that directly
+ * follow it with the same topic/QoS/retain and still fit one raw payload. */
+static size_t esp8266_mqtt_collect(esp8266_mqtt_batch_t *batch, uint8_t *first_index)
+{
+    size_t position = 0U;
+    while (position < s_mqtt.count)
+    {
+        const uint8_t index = (uint8_t)((s_mqtt.head + position) % ESP8266_MQTT_OUTBOX_DEPTH);
+        if (s_mqtt.slots[index].state == ESP8266_MQTT_SLOT_PENDING)
+        {
+            break;
+        }
+        ++position;
+    }
+    if (position >= s_mqtt.count)
+    {
+        return 0U;
+    }
+
+    const uint8_t first = (uint8_t)((s_mqtt.head + position) % ESP8266_MQTT_OUTBOX_DEPTH);
+    const esp8266_mqtt_slot_t *lead = &s_mqtt.slots[first];
+    size_t length = lead->length;
+    memcpy(batch->buffer, lead->payload, lead->length);
+    batch->slots = 1UL << first;
+    *first_index = first;
+
+#if ESP8266_MQTT_COALESCE
+    for (++position; position < s_mqtt.count; ++position)
+    {
+        const uint8_t index = (uint8_t)((s_mqtt.head + position) % ESP8266_MQTT_OUTBOX_DEPTH);
+        const esp8266_mqtt_slot_t *slot = &s_mqtt.slots[index];
+        if (slot->state != ESP8266_MQTT_SLOT_PENDING
+            || slot->topic != lead->topic
+            || slot->qos != lead->qos
+            || slot->retain != lead->retain
+            || length + 1U + slot->length > ESP8266_MQTT_BATCH_SIZE)
+        {
+            break;
+        }
+
+        batch->buffer[length++] = (uint8_t)ESP8266_MQTT_BATCH_SEPARATOR;
+        memcpy(&batch->buffer[length], slot->payload, slot->length);
+        length += slot->length;
+        batch->slots |= 1UL << index;
+    }
+#endif
+
+    return length;
+}
+
+/* Hands one batch to the AT pipeline. Returns false if nothing was queued. */
+static bool esp8266_mqtt_dispatch_one(void)
+{
+    esp8266_mqtt_batch_t *batch = esp8266_mqtt_free_batch();
+    if (batch == NULL)
+    {
+        return false;
+    }
+
+    uint8_t first = 0U;
+    const size_t length = esp8266_mqtt_collect(batch, &first);
+    if (length == 0U)
+    {
+        return false;
+    }
+
+    const esp8266_mqtt_slot_t *lead = &s_mqtt.slots[first];
+    const char *topic = s_mqtt.topics[lead->topic];
+    char topic_field[ESP8266_MQTT_TOPIC_LENGTH * 2U];
+    (void)esp8266_mqtt_escape(topic, strlen(topic), topic_field, sizeof(topic_field));
+
+    char args[ESP8266_AT_ASYNC_ARGUMENT_LENGTH];
+    esp8266_at_status_t status;
+
+    /* A lone printable message goes out as one AT+MQTTPUB round trip; batches
+     * and binary payloads need AT+MQTTPUBRAW and its '>' prompt. */
+    char payload_field[ESP8266_AT_ASYNC_ARGUMENT_LENGTH];
+    int written = -1;
+    if (batch->slots == (1UL << first)
+        && esp8266_mqtt_escape((const char *)batch->buffer, length, payload_field, sizeof(payload_field)))
+    {
+        written = snprintf(args,
+                           sizeof(args),
+                           "%u,\"%s\",\"%s\",%u,%u",
+                           (unsigned int)s_mqtt.link_id,
+                           topic_field,
+                           payload_field,
+                           (unsigned int)lead->qos,
+                           (unsigned int)lead->retain);
+    }
+
+    if (written > 0 && (size_t)written < sizeof(args))
+    {
+        status = esp8266_at_submit(ESP8266_AT_CMD_MQTTPUB,
+                                   ESP8266_AT_COMMAND_MODE_SET,
+                                   args,
+                                   ESP8266_MQTT_PUBLISH_TIMEOUT_MS,
+                                   esp8266_mqtt_on_complete,
+                                   batch);
+    }
+    else
+    {
+        (void)snprintf(args,
+                       sizeof(args),
+                       "%u,\"%s\",%u,%u,%u",
+                       (unsigned int)s_mqtt.link_id,
+                       topic_field,
+                       (unsigned int)length,
+                       (unsigned int)lead->qos,
+                       (unsigned int)lead->retain);
+        status = esp8266_at_submit_data(ESP8266_AT_CMD_MQTTPUBRAW,
+                                        ESP8266_AT_COMMAND_MODE_SET,
+                                        args,
+                                        batch->buffer,
+                                        length,
+                                        ESP8266_MQTT_PUBLISH_TIMEOUT_MS,
+                                        esp8266_mqtt_on_complete,
+                                        batch);
+    }
+
+    if (status != ESP8266_AT_STATUS_OK)
+    {
+        batch->slots = 0U;
+        return false;
+    }
+
+    for (uint8_t i = 0U; i < ESP8266_MQTT_OUTBOX_DEPTH; ++i)
+    {
+        if ((batch->slots & (1UL << i)) != 0U)
+        {
+            s_mqtt.slots[i].state = ESP8266_MQTT_SLOT_IN_FLIGHT;
+        }
+    }
+    batch->used = true;
+    s_mqtt.in_flight++;
+    return true;
+}
+
+static void esp8266_mqtt_restore(void)
+{
+    esp8266_mqtt_record_t record;
+    uint32_t lowest  = UINT32_MAX;
+    uint32_t highest = 0U;
+    uint8_t  first   = 0U;
+    uint8_t  last    = 0U;
+
+    for (uint8_t i = 0U; i < ESP8266_MQTT_OUTBOX_DEPTH; ++i)
+    {
+        if (!s_mqtt.backend.load(i, &record, s_mqtt.backend.context)
+            || record.sequence == 0U
+            || record.length == 0U
+            || record.length > ESP8266_MQTT_PAYLOAD_SIZE)
+        {
+            continue;
+        }
+
+        record.topic[ESP8266_MQTT_TOPIC_LENGTH - 1U] = '\0';
+        const esp8266_mqtt_topic_t topic = esp8266_mqtt_intern(record.topic);
+        if (topic == ESP8266_MQTT_TOPIC_INVALID)
+        {
+            continue;
+        }
+
+        esp8266_mqtt_slot_t *slot = &s_mqtt.slots[i];
+        slot->sequence = record.sequence;
+        slot->length   = record.length;
+        slot->topic    = topic;
+        slot->qos      = record.qos;
+        slot->retain   = record.retain;
+        slot->state    = ESP8266_MQTT_SLOT_PENDING;
+        memcpy(slot->payload, record.payload, record.length);
+
+        if (record.sequence < lowest)
+        {
+            lowest = record.sequence;
+            first  = i;
+        }
+        if (record.sequence >= highest)
+        {
+            highest = record.sequence;
+            last    = i;
+        }
+    }
+
+    if (highest != 0U)
+    {
+        /* Slots are handed out in ring order, so the oldest and newest record
+         * bound the live span. */
+        s_mqtt.head          = first;
+        s_mqtt.count         = (uint8_t)(((last + ESP8266_MQTT_OUTBOX_DEPTH - first) % ESP8266_MQTT_OUTBOX_DEPTH) + 1U);
+        s_mqtt.next_sequence = highest + 1U;
+    }
+}
+
+esp8266_at_status_t esp8266_mqtt_init(uint8_t link_id, const esp8266_mqtt_backend_t *backend)
+{
+    memset(&s_mqtt, 0, sizeof(s_mqtt));
+    s_mqtt.link_id       = link_id;
+    s_mqtt.next_sequence = 1U;
+    if (backend != NULL)
+    {
+        s_mqtt.backend = *backend;
+    }
+
+    esp8266_at_status_t status =
+        esp8266_at_register_urc("+MQTTCONNECTED", esp8266_mqtt_on_connected, NULL);
+    if (status == ESP8266_AT_STATUS_OK)
+    {
+        status = esp8266_at_register_urc("+MQTTDISCONNECTED", esp8266_mqtt_on_disconnected, NULL);
+    }
+    if (status != ESP8266_AT_STATUS_OK)
+    {
+        esp8266_mqtt_deinit();
+        return status;
+    }
+
+    s_mqtt.initialised = true;
+    if (s_mqtt.backend.load != NULL)
+    {
+        esp8266_mqtt_restore();
+    }
+    return ESP8266_AT_STATUS_OK;
+}
+
+void esp8266_mqtt_deinit(void)
+{
+    (void)esp8266_at_register_urc("+MQTTCONNECTED", NULL, NULL);
+    (void)esp8266_at_register_urc("+MQTTDISCONNECTED", NULL, NULL);
+    memset(&s_mqtt, 0, sizeof(s_mqtt));
+}
+
+esp8266_mqtt_topic_t esp8266_mqtt_intern(const char *topic)
+{
+    if (topic == NULL || topic[0] == '\0' || strlen(topic) >= ESP8266_MQTT_TOPIC_LENGTH)
+    {
+        return ESP8266_MQTT_TOPIC_INVALID;
+    }
+
+    for (uint8_t i = 0U; i < s_mqtt.topic_count; ++i)
+    {
+        if (strcmp(s_mqtt.topics[i], topic) == 0)
+        {
+            return i;
+        }
+    }
+
+    if (s_mqtt.topic_count >= ESP8266_MQTT_MAX_TOPICS)
+    {
+        return ESP8266_MQTT_TOPIC_INVALID;
+    }
+
+    (void)strcpy(s_mqtt.topics[s_mqtt.topic_count], topic);
+    return s_mqtt.topic_count++;
+}
+
+esp8266_at_status_t esp8266_mqtt_publish(esp8266_mqtt_topic_t topic,
+                                         const void *payload,
+                                         size_t length,
+                                         uint8_t qos,
+                                         bool retain)
+{
+    if (!s_mqtt.initialised)
+    {
+        return ESP8266_AT_STATUS_NOT_INITIALISED;
+    }
+    if (topic >= s_mqtt.topic_count || payload == NULL || length == 0U
+        || length > ESP8266_MQTT_PAYLOAD_SIZE || qos > 2U)
+    {
+        return ESP8266_AT_STATUS_INVALID_ARGUMENT;
+    }
+    if (s_mqtt.count >= ESP8266_MQTT_OUTBOX_DEPTH)
+    {
+        s_mqtt.stats.rejected++;
+        return ESP8266_AT_STATUS_BUFFER_OVERFLOW;
+    }
+
+    const uint8_t index = (uint8_t)((s_mqtt.head + s_mqtt.count) % ESP8266_MQTT_OUTBOX_DEPTH);
+    esp8266_mqtt_slot_t *slot = &s_mqtt.slots[index];
+    slot->sequence = s_mqtt.next_sequence++;
+    slot->length   = (uint16_t)length;
+    slot->topic    = topic;
+    slot->qos      = qos;
+    slot->retain   = retain ? 1U : 0U;
+    slot->state    = ESP8266_MQTT_SLOT_PENDING;
+    memcpy(slot->payload, payload, length);
+    s_mqtt.count++;
+
+    if (s_mqtt.backend.save != NULL)
+    {
+        esp8266_mqtt_record_t record;
+        memset(&record, 0, sizeof(record));
+        record.sequence = slot->sequence;
+        record.length   = slot->length;
+        record.qos      = slot->qos;
+        record.retain   = slot->retain;
+        (void)strcpy(record.topic, s_mqtt.topics[topic]);
+        memcpy(record.payload, payload, length);
+        s_mqtt.backend.save(index, &record, s_mqtt.backend.context);
+    }
+
+    return ESP8266_AT_STATUS_OK;
+}
+
+void esp8266_mqtt_process(void)
+{
+    if (!s_mqtt.initialised)
+    {
+        return;
+    }
+
+    if (s_mqtt.holdoff
+        && (int32_t)(esp8266_at_interface_hw_get_tick() - s_mqtt.resume_tick) >= 0)
+    {
+        s_mqtt.holdoff = false;
+    }
+
+    if (s_mqtt.online && !s_mqtt.holdoff)
+    {
+        while (s_mqtt.in_flight < ESP8266_MQTT_WINDOW && esp8266_mqtt_dispatch_one())
+        {
+        }
+    }
+
+    esp8266_at_process();
+}
+
+void esp8266_mqtt_set_online(bool online)
+{
+    s_mqtt.online = online;
+    if (online)
+    {
+        s_mqtt.holdoff = false;
+    }
+}
+
+bool esp8266_mqtt_is_online(void)
+{
+    return s_mqtt.online;
+}
+
+size_t esp8266_mqtt_outbox_count(void)
+{
+    return s_mqtt.count;
+}
+
+void esp8266_mqtt_get_stats(esp8266_mqtt_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_mqtt.stats;
+    }
+}
@@ -0,0 +1,144 @@
+/**
+ * @file driver_esp8266_mqtt.h
+ * @brief Non-blocking MQTT publisher on top of the ESP8266 AT MQTT commands.
+ *
+ * Messages are copied into an outbox and drained from esp8266_mqtt_process():
+ *  - up to ESP8266_MQTT_WINDOW publishes are queued in the AT pipeline at once;
+ *  - consecutive small messages for the same topic/QoS/retain are coalesced
+ *    into one AT+MQTTPUBRAW payload, separated by '\n';
+ *  - a message leaves the outbox only after the modem acknowledged it, so
+ *    anything in flight when the broker link drops is resent after
+ *    +MQTTCONNECTED;
+ *  - topics are interned once and referenced by a small id afterwards.
+ * An optional backend mirrors outbox slots to non-volatile storage.
+ */
+#ifndef DRIVER_ESP8266_MQTT_H
+#define DRIVER_ESP8266_MQTT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "driver_esp8266_at.h"
+
+#ifndef ESP8266_MQTT_MAX_TOPICS
+#define ESP8266_MQTT_MAX_TOPICS         8U
+#endif
+#ifndef ESP8266_MQTT_TOPIC_LENGTH
+#define ESP8266_MQTT_TOPIC_LENGTH       64U
+#endif
+/* Outbox slots; each holds one message of up to ESP8266_MQTT_PAYLOAD_SIZE bytes. */
+#ifndef ESP8266_MQTT_OUTBOX_DEPTH
+#define ESP8266_MQTT_OUTBOX_DEPTH       16U
+#endif
+#ifndef ESP8266_MQTT_PAYLOAD_SIZE
+#define ESP8266_MQTT_PAYLOAD_SIZE       128U
+#endif
+/* Publishes queued in the AT pipeline at the same time. */
+#ifndef ESP8266_MQTT_WINDOW
+#define ESP8266_MQTT_WINDOW             4U
+#endif
+/* Largest coalesced AT+MQTTPUBRAW payload. */
+#ifndef ESP8266_MQTT_BATCH_SIZE
+#define ESP8266_MQTT_BATCH_SIZE         512U
+#endif
+/* Coalesced messages are joined with this byte; set ESP8266_MQTT_COALESCE to 0
+ * if subscribers cannot split them. */
+#ifndef ESP8266_MQTT_COALESCE
+#define ESP8266_MQTT_COALESCE           1
+#endif
+#ifndef ESP8266_MQTT_BATCH_SEPARATOR
+#define ESP8266_MQTT_BATCH_SEPARATOR    '\n'
+#endif
+/* Pause before resending after a failed publish. */
+#ifndef ESP8266_MQTT_RETRY_DELAY_MS
+#define ESP8266_MQTT_RETRY_DELAY_MS     500U
+#endif
+#ifndef ESP8266_MQTT_PUBLISH_TIMEOUT_MS
+#define ESP8266_MQTT_PUBLISH_TIMEOUT_MS (ESP8266_AT_DEFAULT_TIMEOUT_MS * 2U)
+#endif
+
+#if ESP8266_MQTT_WINDOW > ESP8266_AT_ASYNC_QUEUE_DEPTH
+#error "ESP8266_MQTT_WINDOW must not exceed ESP8266_AT_ASYNC_QUEUE_DEPTH"
+#endif
+#if ESP8266_MQTT_OUTBOX_DEPTH > 32U
+#error "ESP8266_MQTT_OUTBOX_DEPTH must not exceed 32"
+#endif
+#if ESP8266_MQTT_BATCH_SIZE < ESP8266_MQTT_PAYLOAD_SIZE
+#error "ESP8266_MQTT_BATCH_SIZE must hold at least one payload"
+#endif
+
+#define ESP8266_MQTT_TOPIC_INVALID      0xFFU
+
+typedef uint8_t esp8266_mqtt_topic_t;
+
+/** Outbox slot image as written to the persistence backend. */
+typedef struct
+{
+    uint32_t sequence;        /* 0 = free slot */
+    uint16_t length;
+    uint8_t  qos;
+    uint8_t  retain;
+    char     topic[ESP8266_MQTT_TOPIC_LENGTH];
+    uint8_t  payload[ESP8266_MQTT_PAYLOAD_SIZE];
+} esp8266_mqtt_record_t;
+
+/**
+ * Optional non-volatile mirror of the outbox. save() is called when a slot is
+ * filled, erase() when its message was acknowledged or dropped, load() once
+ * at init for every slot index. Any callback may be NULL.
+ */
+typedef struct
+{
+    void (*save)(uint8_t slot, const esp8266_mqtt_record_t *record, void *context);
+    void (*erase)(uint8_t slot, void *context);
+    bool (*load)(uint8_t slot, esp8266_mqtt_record_t *record, void *context);
+    void *context;
+} esp8266_mqtt_backend_t;
+
+typedef struct
+{
+    uint32_t published;       /* messages acknowledged by the modem */
+    uint32_t commands;        /* AT+MQTTPUB / AT+MQTTPUBRAW commands completed */
+    uint32_t retries;         /* QoS 1/2 messages put back into the outbox after a failure */
+    uint32_t dropped;         /* QoS 0 messages whose publish failed */
+    uint32_t rejected;        /* esp8266_mqtt_publish() calls refused because the outbox was full */
+} esp8266_mqtt_stats_t;
+
+/**
+ * Must be called after esp8266_at_init(). The publisher starts offline and
+ * goes online on +MQTTCONNECTED or esp8266_mqtt_set_online(true).
+ */
+esp8266_at_status_t esp8266_mqtt_init(uint8_t link_id, const esp8266_mqtt_backend_t *backend);
+void esp8266_mqtt_deinit(void);
+
+/** Returns the id of topic, adding it to the table on first use. */
+esp8266_mqtt_topic_t esp8266_mqtt_intern(const char *topic);
+
+/**
+ * Copies the message into the outbox; main-loop context only.
+ * Returns ESP8266_AT_STATUS_BUFFER_OVERFLOW when the outbox is full.
+ */
+esp8266_at_status_t esp8266_mqtt_publish(esp8266_mqtt_topic_t topic,
+                                         const void *payload,
+                                         size_t length,
+                                         uint8_t qos,
+                                         bool retain);
+
+/** Queues new publishes and runs esp8266_at_process(); call from the main loop. */
+void esp8266_mqtt_process(void);
+
+void esp8266_mqtt_set_online(bool online);
+bool esp8266_mqtt_is_online(void);
+size_t esp8266_mqtt_outbox_count(void);
+void esp8266_mqtt_get_stats(esp8266_mqtt_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRIVER_ESP8266_MQTT_H */
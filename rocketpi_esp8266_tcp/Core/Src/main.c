@@ -29,6 +29,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include "driver_esp8266_at.h"
+#include "driver_esp8266_socket.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -50,6 +51,9 @@
 #ifndef ESP8266_TCP_TEST_REMOTE_PORT
 #define ESP8266_TCP_TEST_REMOTE_PORT      8899U
 #endif
+#ifndef ESP8266_TCP_TEST_LINK_ID
+#define ESP8266_TCP_TEST_LINK_ID          0U
+#endif
 
 /* USER CODE END PD */
 
@@ -70,7 +74,7 @@ void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
 static void esp8266_tcp_test_run(void);
 static void esp8266_tcp_test_poll(void);
-static void esp8266_tcp_print_ipd_payload(const esp8266_at_event_t *event);
+static void esp8266_tcp_print_rx(uint8_t link_id);
 static void esp8266_tcp_log_status(const char *label, esp8266_at_status_t status);
 static void esp8266_tcp_print_ip_info(void);
 
@@ -107,86 +111,26 @@ static void esp8266_tcp_print_ip_info(void)
          ip_info.softap_netmask);
 }
 
-static void esp8266_tcp_print_ipd_payload(const esp8266_at_event_t *event)
+static void esp8266_tcp_print_rx(uint8_t link_id)
 {
-  if (event == NULL)
-  {
-    return;
-  }
+  uint8_t buffer[128];
+  size_t length;
 
-  const char *raw_line = event->raw_line;
-  if (raw_line == NULL || raw_line[0] == '\0')
-  {
-    return;
-  }
-
-  const char *payload = NULL;
-  unsigned int channel = 0U;
-  unsigned int payload_length = 0U;
-  bool channel_valid = false;
-  bool length_valid = false;
-  int payload_offset = 0;
-
-  if (sscanf(raw_line, "+IPD,%u,%u:%n", &channel, &payload_length, &payload_offset) == 2)
-  {
-    channel_valid = true;
-    length_valid = true;
-    payload = raw_line + payload_offset;
-  }
-  else if (sscanf(raw_line, "+IPD,%u:%n", &payload_length, &payload_offset) == 1)
-  {
-    length_valid = true;
-    payload = raw_line + payload_offset;
-  }
-  else
+  while ((length = esp8266_socket_recv(link_id, buffer, sizeof(buffer))) > 0U)
   {
-    const char *colon = strchr(raw_line, ':');
-    if (colon != NULL)
+    /* Payload is binary-safe now; show non-printable bytes as '.'. */
+    for (size_t i = 0U; i < length; ++i)
     {
-      payload = colon + 1;
+      if (buffer[i] < 0x20U || buffer[i] > 0x7EU)
+      {
+        buffer[i] = '.';
+      }
     }
-  }
-
-  if (payload == NULL || *payload == '\0')
-  {
-    printf("[ESP8266][TCP RX] (empty payload)\r\n");
-    return;
-  }
-
-  char buffer[ESP8266_AT_MAX_LINE_LENGTH];
-  size_t available = strlen(payload);
-  size_t copy_len = available;
-
-  if (length_valid && payload_length < copy_len)
-  {
-    copy_len = payload_length;
-  }
-
-  if (copy_len >= sizeof(buffer))
-  {
-    copy_len = sizeof(buffer) - 1U;
-  }
-
-  memcpy(buffer, payload, copy_len);
-  buffer[copy_len] = '\0';
-
-  if (!length_valid)
-  {
-    payload_length = (unsigned int)copy_len;
-  }
-
-  if (channel_valid)
-  {
-    printf("[ESP8266][TCP RX][id=%u len=%u] %s\r\n",
-           channel,
-           payload_length,
-           buffer);
-  }
-  else
-  {
-    printf("[ESP8266][TCP RX][len=%u] %s\r\n",
-           payload_length,
-           buffer);
+    printf("[ESP8266][TCP RX][id=%u len=%u] %.*s\r\n",
+           (unsigned int)link_id,
+           (unsigned int)length,
+           (int)length,
+           (const char *)buffer);
   }
 }
 
@@ -229,29 +173,18 @@ static void esp8266_tcp_test_run(void)
   }
   esp8266_tcp_print_ip_info();
 
-  status = esp8266_at_send_command(ESP8266_AT_CMD_CIPMUX,
-                                   ESP8266_AT_COMMAND_MODE_SET,
-                                   "0",
-                                   ESP8266_AT_DEFAULT_TIMEOUT_MS,
-                                   false);
+  status = esp8266_socket_init();
   esp8266_tcp_log_status("CIPMUX", status);
   if (status != ESP8266_AT_STATUS_OK)
   {
     return;
   }
 
-  char start_args[ESP8266_AT_MAX_LINE_LENGTH];
-  (void)snprintf(start_args,
-                 sizeof(start_args),
-                 "\"TCP\",\"%s\",%u",
-                 ESP8266_TCP_TEST_REMOTE_HOST,
-                 (unsigned int)ESP8266_TCP_TEST_REMOTE_PORT);
-
-  status = esp8266_at_send_command(ESP8266_AT_CMD_CIPSTART,
-                                   ESP8266_AT_COMMAND_MODE_SET,
-                                   start_args,
-                                   ESP8266_AT_DEFAULT_TIMEOUT_MS * 5U,
-                                   false);
+  status = esp8266_socket_connect(ESP8266_TCP_TEST_LINK_ID,
+                                  ESP8266_SOCKET_TCP,
+                                  ESP8266_TCP_TEST_REMOTE_HOST,
+                                  (uint16_t)ESP8266_TCP_TEST_REMOTE_PORT,
+                                  ESP8266_AT_DEFAULT_TIMEOUT_MS * 5U);
   esp8266_tcp_log_status("CIPSTART", status);
   if (status == ESP8266_AT_STATUS_OK)
   {
@@ -269,26 +202,22 @@ static void esp8266_tcp_test_poll(void)
 
   esp8266_at_poll();
 
+  /* +IPD data no longer arrives as events; just keep the queue drained. */
   while (esp8266_at_fetch_event(&event))
   {
-    if (strncmp(event.raw_line, "+IPD", 4) == 0)
-    {
-      if (s_esp8266_tcp_link_ready)
-      {
-        esp8266_tcp_print_ipd_payload(&event);
-      }
-      continue;
-    }
+  }
 
-    if (strstr(event.raw_line, "CLOSED") != NULL)
-    {
-      if (s_esp8266_tcp_link_ready)
-      {
-        printf("[ESP8266][TCP] connection closed\r\n");
-      }
-      s_esp8266_tcp_link_ready = false;
-      continue;
-    }
+  if (!s_esp8266_tcp_link_ready)
+  {
+    return;
+  }
+
+  esp8266_tcp_print_rx(ESP8266_TCP_TEST_LINK_ID);
+
+  if (esp8266_socket_get_state(ESP8266_TCP_TEST_LINK_ID) == ESP8266_SOCKET_STATE_CLOSED)
+  {
+    printf("[ESP8266][TCP] connection closed\r\n");
+    s_esp8266_tcp_link_ready = false;
   }
 }
 
@@ -21,6 +21,46 @@ typedef enum
     ESP8266_AT_PHASE_WAITING_FINAL
 } esp8266_at_phase_t;
 
+#define ESP8266_AT_ARENA_MASK           (ESP8266_AT_EVENT_ARENA_SIZE - 1U)
+#define ESP8266_AT_TERMINAL_LINE_LENGTH 16U
+
+/* Routing keys: command prefixes first, then ESP8266_AT_URC_TABLE. They are
+ * placed in a perfect hash (hash-and-displace) built once at init. */
+#define ESP8266_AT_KEY_COUNT            ((size_t)ESP8266_AT_CMD_COUNT + (size_t)ESP8266_AT_URC_COUNT)
+#define ESP8266_AT_KEY_NONE             0xFFU
+#define ESP8266_AT_KEY_SLOTS            128U
+#define ESP8266_AT_KEY_BUCKETS          32U
+
+/* Queued line descriptor; the text lives once in the arena at `position`
+ * (a free-running byte counter, masked on access). */
+typedef struct
+{
+    uint32_t position;
+    uint16_t line_length;
+    uint8_t  payload_offset;
+    uint8_t  prefix_length;
+    uint8_t  type;
+    uint8_t  command;
+    uint8_t  mode;
+    uint8_t  key;              /* routing key, ESP8266_AT_KEY_NONE if none */
+} esp8266_at_record_t;
+
+typedef struct
+{
+    esp8266_at_command_id_t   command;
+    esp8266_at_command_mode_t mode;
+    uint32_t                  timeout_ms;
+    esp8266_at_completion_t   callback;
+    void                     *context;
+    const uint8_t            *data;         /* sent after the '>' prompt, NULL if none */
+    size_t                    data_length;
+    char                      arguments[ESP8266_AT_ASYNC_ARGUMENT_LENGTH];
+} esp8266_at_async_slot_t;
+
+typedef bool (*esp8266_at_record_match_t)(const esp8266_at_record_t *record,
+                                          const char *line,
+                                          const char *key);
+
 typedef struct
 {
     bool                    initialised;
@@ -34,6 +74,7 @@ typedef struct
     esp8266_at_status_t     last_status;
     esp8266_at_event_t      last_terminal_event;
     bool                    last_terminal_event_valid;
+    char                    terminal_line[ESP8266_AT_TERMINAL_LINE_LENGTH];
     struct
     {
         char   buffer[ESP8266_AT_MAX_LINE_LENGTH];
@@ -41,11 +82,48 @@ typedef struct
     } line;
     struct
     {
-        esp8266_at_event_t events[ESP8266_AT_EVENT_QUEUE_DEPTH];
-        uint8_t            head;
-        uint8_t            tail;
-        uint8_t            count;
+        char     bytes[ESP8266_AT_EVENT_ARENA_SIZE];
+        uint32_t write;
+        uint32_t held;         /* line of the last fetched event */
+        bool     held_valid;
+        uint32_t dropped;
+    } arena;
+    struct
+    {
+        esp8266_at_record_t records[ESP8266_AT_EVENT_QUEUE_DEPTH];
+        uint8_t             head;
+        uint8_t             tail;
+        uint8_t             count;
     } queue;
+    struct
+    {
+        bool     active;       /* counting raw data bytes of a +IPD frame */
+        uint8_t  link_id;
+        uint32_t remaining;
+    } ipd;
+    esp8266_at_ipd_handler_t   ipd_handler;
+    void                      *ipd_context;
+    esp8266_at_line_observer_t line_observer;
+    void                      *line_observer_context;
+    struct
+    {
+        esp8266_at_async_slot_t slots[ESP8266_AT_ASYNC_QUEUE_DEPTH];
+        uint8_t                 head;
+        uint8_t                 count;
+        bool                    in_flight;
+        bool                    backoff;
+        uint8_t                 retries;
+        uint32_t                resume_tick;
+    } async;
+    struct
+    {
+        struct
+        {
+            esp8266_at_urc_handler_t handler;
+            void                    *context;
+        } handlers[ESP8266_AT_MAX_URC_HANDLERS];
+        uint8_t route[ESP8266_AT_KEY_COUNT];   /* handler index + 1, 0 = queue */
+    } urc;
 } esp8266_at_core_t;
 
 static esp8266_at_core_t s_core;
@@ -58,27 +136,61 @@ static const esp8266_at_command_def_t s_command_table[ESP8266_AT_CMD_COUNT] =
 #undef ESP8266_AT_BUILD_DEF
 };
 
+static const char *const s_urc_table[ESP8266_AT_URC_COUNT] =
+{
+#define ESP8266_AT_BUILD_URC(NAME, TEXT) [ESP8266_AT_URC_##NAME] = TEXT,
+    ESP8266_AT_URC_TABLE(ESP8266_AT_BUILD_URC)
+#undef ESP8266_AT_BUILD_URC
+};
+
+static uint8_t s_key_displacement[ESP8266_AT_KEY_BUCKETS];
+static uint8_t s_key_slots[ESP8266_AT_KEY_SLOTS];          /* key + 1, 0 = empty */
+static bool    s_key_hash_ready;
+
 static void esp8266_at_core_reset_line(esp8266_at_core_t *ctx);
 static void esp8266_at_core_reset_state(esp8266_at_core_t *ctx);
 static void esp8266_at_core_process_byte(esp8266_at_core_t *ctx, uint8_t byte);
-static void esp8266_at_core_handle_line(esp8266_at_core_t *ctx, const char *line);
+static bool esp8266_at_core_begin_ipd(esp8266_at_core_t *ctx);
+static size_t esp8266_at_core_process_ipd(esp8266_at_core_t *ctx,
+                                          const uint8_t *data,
+                                          size_t length);
+static void esp8266_at_core_emit(esp8266_at_core_t *ctx,
+                                 const esp8266_at_record_t *record,
+                                 const char *line);
+static void esp8266_at_core_handle_line(esp8266_at_core_t *ctx, char *line);
 static void esp8266_at_core_process_prompt(esp8266_at_core_t *ctx);
-static bool esp8266_at_queue_push(esp8266_at_core_t *ctx, const esp8266_at_event_t *event);
+static void esp8266_at_core_set_terminal(esp8266_at_core_t *ctx,
+                                         const esp8266_at_record_t *record,
+                                         const char *line);
+static bool esp8266_at_queue_push(esp8266_at_core_t *ctx,
+                                  const esp8266_at_record_t *record,
+                                  const char *line);
 static bool esp8266_at_queue_pop(esp8266_at_core_t *ctx, esp8266_at_event_t *event);
-static void esp8266_at_queue_restore(esp8266_at_core_t *ctx,
-                                     const esp8266_at_event_t *events,
-                                     size_t count);
+static bool esp8266_at_queue_take(esp8266_at_core_t *ctx,
+                                  esp8266_at_record_match_t match,
+                                  const char *key,
+                                  esp8266_at_event_t *event);
+static void esp8266_at_queue_drop_head(esp8266_at_core_t *ctx);
+static uint32_t esp8266_at_arena_oldest(const esp8266_at_core_t *ctx);
+static void esp8266_at_record_to_event(const esp8266_at_core_t *ctx,
+                                       const esp8266_at_record_t *record,
+                                       esp8266_at_event_t *event);
+static bool esp8266_at_match_line(const esp8266_at_record_t *record,
+                                  const char *line,
+                                  const char *key);
+static bool esp8266_at_match_prefix(const esp8266_at_record_t *record,
+                                    const char *line,
+                                    const char *key);
 static uint32_t esp8266_at_tick_elapsed(uint32_t start, uint32_t now);
 static size_t esp8266_at_strnlen(const char *str, size_t max_len);
 static int esp8266_at_strcasecmp(const char *lhs, const char *rhs);
 static int esp8266_at_strncasecmp(const char *lhs, const char *rhs, size_t length);
 static void esp8266_at_trim(char *str);
 static void esp8266_at_copy_lower(char *dest, size_t dest_size, const char *source);
-static void esp8266_at_parse_response_payload(esp8266_at_event_t *event);
 static void esp8266_at_parse_ip_descriptor(const esp8266_at_event_t *event,
                                            bool station,
                                            esp8266_at_ip_info_t *info);
-static esp8266_at_command_id_t esp8266_at_match_command_by_prefix(const char *prefix);
+static const char *esp8266_at_key_text(uint8_t key);
 static void esp8266_at_escape_field(const char *input, char *output, size_t output_size);
 static esp8266_at_status_t esp8266_at_send_and_wait_internal(esp8266_at_command_id_t command,
                                                              esp8266_at_command_mode_t mode,
@@ -86,7 +198,18 @@ static esp8266_at_status_t esp8266_at_send_and_wait_internal(esp8266_at_command_
                                                              uint32_t timeout_ms,
                                                              bool expect_prompt,
                                                              esp8266_at_event_t *terminal_event);
+static esp8266_at_status_t esp8266_at_start_command(esp8266_at_command_id_t command,
+                                                    esp8266_at_command_mode_t mode,
+                                                    const char *arguments,
+                                                    uint32_t timeout_ms,
+                                                    bool expect_prompt);
 static bool esp8266_at_pop_event_by_prefix(const char *prefix, esp8266_at_event_t *out_event);
+static uint32_t esp8266_at_key_hash(const char *key, size_t length, uint32_t seed);
+static void esp8266_at_build_key_hash(void);
+static uint8_t esp8266_at_lookup_key(const char *key, size_t length);
+static bool esp8266_at_core_dispatch_urc(esp8266_at_core_t *ctx,
+                                         const esp8266_at_record_t *record,
+                                         const esp8266_at_event_t *event);
 static const char *esp8266_at_event_type_name(esp8266_at_event_type_t type);
 
 const esp8266_at_command_def_t *esp8266_at_get_command_def(esp8266_at_command_id_t command)
@@ -133,6 +256,7 @@ esp8266_at_status_t esp8266_at_init(void)
 
     memset(&s_core, 0, sizeof(s_core));
     esp8266_at_core_reset_state(&s_core);
+    esp8266_at_build_key_hash();
 
     const esp8266_at_status_t status = esp8266_at_interface_hw_init();
     if (status != ESP8266_AT_STATUS_OK)
@@ -180,34 +304,17 @@ esp8266_at_status_t esp8266_at_reset(uint32_t ready_timeout_ms)
 
     const uint32_t start = esp8266_at_interface_hw_get_tick();
     esp8266_at_event_t event;
-    esp8266_at_event_t stash[ESP8266_AT_EVENT_QUEUE_DEPTH];
-    size_t stash_count = 0U;
     bool ready_received = false;
 
+    /* Only the "ready" line is consumed; boot noise stays queued in order. */
     while (esp8266_at_tick_elapsed(start, esp8266_at_interface_hw_get_tick()) < timeout)
     {
         esp8266_at_poll();
-        if (!esp8266_at_fetch_event(&event))
-        {
-            continue;
-        }
-
-        if (esp8266_at_strcasecmp(event.payload, "ready") == 0
-            || esp8266_at_strcasecmp(event.raw_line, "ready") == 0)
+        if (esp8266_at_queue_take(&s_core, esp8266_at_match_line, "ready", &event))
         {
             ready_received = true;
             break;
         }
-
-        if (stash_count < ESP8266_AT_EVENT_QUEUE_DEPTH)
-        {
-            stash[stash_count++] = event;
-        }
-    }
-
-    if (stash_count > 0U)
-    {
-        esp8266_at_queue_restore(&s_core, stash, stash_count);
     }
 
     if (!ready_received)
@@ -284,9 +391,14 @@ esp8266_at_status_t esp8266_at_wait_for_completion(uint32_t timeout_ms,
         }
     }
 
-    if (terminal_event != NULL && s_core.last_terminal_event_valid)
+    if (terminal_event != NULL)
     {
-        *terminal_event = s_core.last_terminal_event;
+        const uint32_t state = esp8266_at_interface_hw_enter_critical();
+        if (s_core.last_terminal_event_valid)
+        {
+            *terminal_event = s_core.last_terminal_event;
+        }
+        esp8266_at_interface_hw_exit_critical(state);
     }
 
     return s_core.last_status;
@@ -686,6 +798,129 @@ size_t esp8266_at_pending_event_count(void)
     return s_core.queue.count;
 }
 
+size_t esp8266_at_dropped_event_count(void)
+{
+    return s_core.arena.dropped;
+}
+
+bool esp8266_at_event_has_prefix(const esp8266_at_event_t *event, const char *prefix)
+{
+    if (event == NULL || event->raw_line == NULL || prefix == NULL)
+    {
+        return false;
+    }
+
+    const size_t length = strlen(prefix);
+    return length != 0U
+        && length == event->prefix_length
+        && esp8266_at_strncasecmp(event->raw_line, prefix, length) == 0;
+}
+
+size_t esp8266_at_event_arguments(const esp8266_at_event_t *event,
+                                  esp8266_at_argument_t *arguments,
+                                  size_t max_arguments)
+{
+    if (event == NULL || event->payload == NULL || event->payload[0] == '\0'
+        || (arguments != NULL && max_arguments == 0U))
+    {
+        return 0U;
+    }
+
+    const char *payload = event->payload;
+    size_t count = 0U;
+    size_t start = 0U;
+    bool in_quote = false;
+    bool quoted   = false;
+
+    for (size_t i = 0U; count < ESP8266_AT_MAX_ARGUMENTS; ++i)
+    {
+        const char ch = payload[i];
+        if (ch == '"')
+        {
+            in_quote = !in_quote;
+            quoted   = true;
+            continue;
+        }
+        if (ch != '\0' && (ch != ',' || in_quote))
+        {
+            continue;
+        }
+
+        if (arguments != NULL)
+        {
+            size_t first = start;
+            size_t last  = i;
+            while (first < last && ((unsigned char)payload[first] <= ' ' || payload[first] == '"'))
+            {
+                ++first;
+            }
+            while (last > first && ((unsigned char)payload[last - 1U] <= ' ' || payload[last - 1U] == '"'))
+            {
+                --last;
+            }
+            arguments[count].offset = (uint8_t)first;
+            arguments[count].length = (uint8_t)(last - first);
+            arguments[count].quoted = quoted;
+        }
+        ++count;
+
+        if (ch == '\0' || (arguments != NULL && count >= max_arguments))
+        {
+            break;
+        }
+        start  = i + 1U;
+        quoted = false;
+    }
+
+    return count;
+}
+
+bool esp8266_at_event_argument(const esp8266_at_event_t *event,
+                               size_t index,
+                               esp8266_at_argument_t *argument)
+{
+    if (argument == NULL || index >= ESP8266_AT_MAX_ARGUMENTS)
+    {
+        return false;
+    }
+
+    esp8266_at_argument_t arguments[ESP8266_AT_MAX_ARGUMENTS];
+    if (esp8266_at_event_arguments(event, arguments, index + 1U) <= index)
+    {
+        return false;
+    }
+
+    *argument = arguments[index];
+    return true;
+}
+
+size_t esp8266_at_event_copy_argument(const esp8266_at_event_t *event,
+                                      size_t index,
+                                      char *buffer,
+                                      size_t buffer_size)
+{
+    if (buffer == NULL || buffer_size == 0U)
+    {
+        return 0U;
+    }
+
+    buffer[0] = '\0';
+    esp8266_at_argument_t argument;
+    if (!esp8266_at_event_argument(event, index, &argument))
+    {
+        return 0U;
+    }
+
+    size_t length = argument.length;
+    if (length >= buffer_size)
+    {
+        length = buffer_size - 1U;
+    }
+    memcpy(buffer, &event->payload[argument.offset], length);
+    buffer[length] = '\0';
+    return length;
+}
+
 void esp8266_at_poll(void)
 {
     esp8266_at_interface_flush_trace();
@@ -711,34 +946,296 @@ void esp8266_at_receive_bytes(const uint8_t *data, size_t length)
         return;
     }
 
-    for (size_t i = 0U; i < length; ++i)
+    size_t i = 0U;
+    while (i < length)
     {
-        esp8266_at_core_process_byte(&s_core, data[i]);
+        if (s_core.ipd.active)
+        {
+            /* Data bytes are counted, never scanned for line endings. */
+            i += esp8266_at_core_process_ipd(&s_core, &data[i], length - i);
+            continue;
+        }
+        esp8266_at_core_process_byte(&s_core, data[i++]);
     }
 }
 
-void esp8266_at_debug_print_events(bool keep_events)
+void esp8266_at_set_ipd_handler(esp8266_at_ipd_handler_t handler, void *context)
+{
+    const uint32_t state = esp8266_at_interface_hw_enter_critical();
+    s_core.ipd_handler = handler;
+    s_core.ipd_context = context;
+    esp8266_at_interface_hw_exit_critical(state);
+}
+
+void esp8266_at_set_line_observer(esp8266_at_line_observer_t observer, void *context)
+{
+    const uint32_t state = esp8266_at_interface_hw_enter_critical();
+    s_core.line_observer         = observer;
+    s_core.line_observer_context = context;
+    esp8266_at_interface_hw_exit_critical(state);
+}
+
+esp8266_at_status_t esp8266_at_submit(esp8266_at_command_id_t command,
+                                      esp8266_at_command_mode_t mode,
+                                      const char *arguments,
+                                      uint32_t timeout_ms,
+                                      esp8266_at_completion_t callback,
+                                      void *context)
+{
+    return esp8266_at_submit_data(command, mode, arguments, NULL, 0U, timeout_ms, callback, context);
+}
+
+esp8266_at_status_t esp8266_at_submit_data(esp8266_at_command_id_t command,
+                                           esp8266_at_command_mode_t mode,
+                                           const char *arguments,
+                                           const uint8_t *data,
+                                           size_t data_length,
+                                           uint32_t timeout_ms,
+                                           esp8266_at_completion_t callback,
+                                           void *context)
+{
+    if (!s_core.initialised)
+    {
+        return ESP8266_AT_STATUS_NOT_INITIALISED;
+    }
+    if (command >= ESP8266_AT_CMD_COUNT || (data != NULL && data_length == 0U))
+    {
+        return ESP8266_AT_STATUS_INVALID_ARGUMENT;
+    }
+
+    const char *args = (arguments != NULL) ? arguments : "";
+    const size_t length = esp8266_at_strnlen(args, ESP8266_AT_ASYNC_ARGUMENT_LENGTH);
+    if (length >= ESP8266_AT_ASYNC_ARGUMENT_LENGTH)
+    {
+        return ESP8266_AT_STATUS_INVALID_ARGUMENT;
+    }
+    if (s_core.async.count >= ESP8266_AT_ASYNC_QUEUE_DEPTH)
+    {
+        return ESP8266_AT_STATUS_BUSY;
+    }
+
+    const uint8_t index = (uint8_t)((s_core.async.head + s_core.async.count) % ESP8266_AT_ASYNC_QUEUE_DEPTH);
+    esp8266_at_async_slot_t *slot = &s_core.async.slots[index];
+    slot->command    = command;
+    slot->mode       = mode;
+    slot->timeout_ms = (timeout_ms != 0U) ? timeout_ms : ESP8266_AT_DEFAULT_TIMEOUT_MS;
+    slot->callback    = callback;
+    slot->context     = context;
+    slot->data        = data;
+    slot->data_length = (data != NULL) ? data_length : 0U;
+    memcpy(slot->arguments, args, length + 1U);
+    s_core.async.count++;
+
+    return ESP8266_AT_STATUS_OK;
+}
+
+static void esp8266_at_async_complete(esp8266_at_status_t status, bool with_terminal)
+{
+    const esp8266_at_async_slot_t slot = s_core.async.slots[s_core.async.head];
+    s_core.async.head = (uint8_t)((s_core.async.head + 1U) % ESP8266_AT_ASYNC_QUEUE_DEPTH);
+    s_core.async.count--;
+    s_core.async.retries = 0U;
+
+    esp8266_at_event_t terminal;
+    bool terminal_valid = false;
+    if (with_terminal)
+    {
+        const uint32_t state = esp8266_at_interface_hw_enter_critical();
+        terminal_valid = s_core.last_terminal_event_valid;
+        if (terminal_valid)
+        {
+            terminal = s_core.last_terminal_event;
+        }
+        esp8266_at_interface_hw_exit_critical(state);
+    }
+
+    if (slot.callback != NULL)
+    {
+        slot.callback(status, terminal_valid ? &terminal : NULL, slot.context);
+    }
+}
+
+void esp8266_at_process(void)
 {
     if (!s_core.initialised)
     {
         return;
     }
 
-    esp8266_at_event_t stash[ESP8266_AT_EVENT_QUEUE_DEPTH];
-    size_t stash_count = 0U;
-    esp8266_at_event_t event;
+    esp8266_at_poll();
+    const uint32_t now = esp8266_at_interface_hw_get_tick();
+
+    if (s_core.async.in_flight)
+    {
+        if (s_core.awaiting_reply)
+        {
+            return;
+        }
+
+        const esp8266_at_async_slot_t *slot = &s_core.async.slots[s_core.async.head];
+        if (s_core.phase == ESP8266_AT_PHASE_READY_FOR_DATA
+            && s_core.last_status == ESP8266_AT_STATUS_PROMPT
+            && slot->data != NULL)
+        {
+            const esp8266_at_status_t status = esp8266_at_send_data(slot->data, slot->data_length, slot->timeout_ms);
+            if (status == ESP8266_AT_STATUS_OK)
+            {
+                return;
+            }
+            s_core.phase           = ESP8266_AT_PHASE_IDLE;
+            s_core.async.in_flight = false;
+            esp8266_at_async_complete(status, false);
+            return;
+        }
+        s_core.async.in_flight = false;
+
+        const esp8266_at_status_t status = s_core.last_status;
+        if (status == ESP8266_AT_STATUS_BUSY_RESPONSE
+            && s_core.async.retries < ESP8266_AT_BUSY_MAX_RETRIES)
+        {
+            /* "busy p..." means the modem dropped the command; back off and resend. */
+            s_core.async.backoff     = true;
+            s_core.async.resume_tick = now + (ESP8266_AT_BUSY_RETRY_MS << s_core.async.retries);
+            s_core.async.retries++;
+            return;
+        }
+        esp8266_at_async_complete(status, true);
+    }
+
+    if (s_core.async.count == 0U)
+    {
+        return;
+    }
+    if (s_core.async.backoff)
+    {
+        if ((int32_t)(now - s_core.async.resume_tick) < 0)
+        {
+            return;
+        }
+        s_core.async.backoff = false;
+    }
+    if (!esp8266_at_is_ready())
+    {
+        return;
+    }
+
+    const esp8266_at_async_slot_t *slot = &s_core.async.slots[s_core.async.head];
+    const esp8266_at_status_t status =
+        esp8266_at_start_command(slot->command,
+                                 slot->mode,
+                                 (slot->mode == ESP8266_AT_COMMAND_MODE_EXECUTE && slot->arguments[0] == '\0')
+                                     ? NULL
+                                     : slot->arguments,
+                                 slot->timeout_ms,
+                                 slot->data != NULL);
+    if (status == ESP8266_AT_STATUS_OK)
+    {
+        s_core.async.in_flight = true;
+    }
+    else if (status != ESP8266_AT_STATUS_BUSY)
+    {
+        esp8266_at_async_complete(status, false);
+    }
+}
+
+size_t esp8266_at_pending_command_count(void)
+{
+    return s_core.async.count;
+}
+
+esp8266_at_status_t esp8266_at_register_urc(const char *key,
+                                            esp8266_at_urc_handler_t handler,
+                                            void *context)
+{
+    if (!s_core.initialised)
+    {
+        return ESP8266_AT_STATUS_NOT_INITIALISED;
+    }
+    if (key == NULL)
+    {
+        return ESP8266_AT_STATUS_INVALID_ARGUMENT;
+    }
+
+    const uint8_t id = esp8266_at_lookup_key(key, strlen(key));
+    if (id == ESP8266_AT_KEY_NONE)
+    {
+        return ESP8266_AT_STATUS_INVALID_ARGUMENT;
+    }
 
-    while (esp8266_at_queue_pop(&s_core, &event))
+    esp8266_at_status_t status = ESP8266_AT_STATUS_OK;
+    const uint32_t state = esp8266_at_interface_hw_enter_critical();
+    uint8_t route = s_core.urc.route[id];
+
+    if (handler == NULL)
+    {
+        if (route != 0U)
+        {
+            s_core.urc.handlers[route - 1U].handler = NULL;
+            s_core.urc.route[id] = 0U;
+        }
+    }
+    else
     {
-        if (keep_events && stash_count < ESP8266_AT_EVENT_QUEUE_DEPTH)
+        for (uint8_t i = 0U; route == 0U && i < ESP8266_AT_MAX_URC_HANDLERS; ++i)
         {
-            stash[stash_count++] = event;
+            if (s_core.urc.handlers[i].handler == NULL)
+            {
+                route = (uint8_t)(i + 1U);
+            }
+        }
+        if (route == 0U)
+        {
+            status = ESP8266_AT_STATUS_BUFFER_OVERFLOW;
         }
+        else
+        {
+            s_core.urc.handlers[route - 1U].handler = handler;
+            s_core.urc.handlers[route - 1U].context = context;
+            s_core.urc.route[id] = route;
+        }
+    }
+
+    esp8266_at_interface_hw_exit_critical(state);
+    return status;
+}
+
+void esp8266_at_debug_print_events(bool keep_events)
+{
+    if (!s_core.initialised)
+    {
+        return;
     }
 
-    if (keep_events && stash_count > 0U)
+    char line[ESP8266_AT_MAX_LINE_LENGTH];
+    size_t index = 0U;
+
+    /* Copy each line out under the lock so printing never races the RX callback. */
+    while (true)
     {
-        esp8266_at_queue_restore(&s_core, stash, stash_count);
+        const uint32_t state = esp8266_at_interface_hw_enter_critical();
+        if (index >= s_core.queue.count)
+        {
+            esp8266_at_interface_hw_exit_critical(state);
+            break;
+        }
+
+        const uint8_t slot = (uint8_t)((s_core.queue.head + index) % ESP8266_AT_EVENT_QUEUE_DEPTH);
+        const esp8266_at_record_t record = s_core.queue.records[slot];
+        memcpy(line, &s_core.arena.bytes[record.position & ESP8266_AT_ARENA_MASK], record.line_length + 1U);
+
+        if (keep_events)
+        {
+            ++index;
+        }
+        else
+        {
+            esp8266_at_queue_drop_head(&s_core);
+        }
+        esp8266_at_interface_hw_exit_critical(state);
+
+        printf("[ESP8266][event][%s] %s\r\n",
+               esp8266_at_event_type_name((esp8266_at_event_type_t)record.type),
+               line);
     }
 }
 
@@ -749,10 +1246,13 @@ void esp8266_at_clear_events(void)
         return;
     }
 
+    const uint32_t state = esp8266_at_interface_hw_enter_critical();
     s_core.queue.head = 0U;
     s_core.queue.tail = 0U;
     s_core.queue.count = 0U;
+    s_core.arena.held_valid = false;
     s_core.last_terminal_event_valid = false;
+    esp8266_at_interface_hw_exit_critical(state);
 }
 
 static esp8266_at_status_t esp8266_at_send_and_wait_internal(esp8266_at_command_id_t command,
@@ -761,6 +1261,22 @@ static esp8266_at_status_t esp8266_at_send_and_wait_internal(esp8266_at_command_
                                                              uint32_t timeout_ms,
                                                              bool expect_prompt,
                                                              esp8266_at_event_t *terminal_event)
+{
+    const esp8266_at_status_t status =
+        esp8266_at_start_command(command, mode, arguments, timeout_ms, expect_prompt);
+    if (status != ESP8266_AT_STATUS_OK)
+    {
+        return status;
+    }
+
+    return esp8266_at_wait_for_completion(timeout_ms, terminal_event);
+}
+
+static esp8266_at_status_t esp8266_at_start_command(esp8266_at_command_id_t command,
+                                                    esp8266_at_command_mode_t mode,
+                                                    const char *arguments,
+                                                    uint32_t timeout_ms,
+                                                    bool expect_prompt)
 {
     if (!s_core.initialised)
     {
@@ -803,9 +1319,13 @@ static esp8266_at_status_t esp8266_at_send_and_wait_internal(esp8266_at_command_
             return ESP8266_AT_STATUS_INVALID_ARGUMENT;
     }
 
+    /* An async command owns the link until esp8266_at_process() retires it,
+     * and after a '>' prompt the modem takes the next bytes as payload. */
     if (s_core.awaiting_reply
+        || s_core.async.in_flight
         || s_core.phase == ESP8266_AT_PHASE_WAITING_PROMPT
-        || s_core.phase == ESP8266_AT_PHASE_WAITING_FINAL)
+        || s_core.phase == ESP8266_AT_PHASE_WAITING_FINAL
+        || s_core.phase == ESP8266_AT_PHASE_READY_FOR_DATA)
     {
         return ESP8266_AT_STATUS_BUSY;
     }
@@ -870,7 +1390,7 @@ static esp8266_at_status_t esp8266_at_send_and_wait_internal(esp8266_at_command_
     s_core.phase                     = expect_prompt ? ESP8266_AT_PHASE_WAITING_PROMPT
                                                      : ESP8266_AT_PHASE_WAITING_FINAL;
 
-    return esp8266_at_wait_for_completion(timeout_ms, terminal_event);
+    return ESP8266_AT_STATUS_OK;
 }
 
 static void esp8266_at_escape_field(const char *input, char *output, size_t output_size)
@@ -916,6 +1436,11 @@ static void esp8266_at_core_reset_state(esp8266_at_core_t *ctx)
     ctx->last_status               = ESP8266_AT_STATUS_OK;
     ctx->last_terminal_event_valid = false;
     ctx->queue.head = ctx->queue.tail = ctx->queue.count = 0U;
+    ctx->arena.write      = 0U;
+    ctx->arena.held_valid = false;
+    ctx->arena.dropped    = 0U;
+    ctx->ipd.active       = false;
+    ctx->ipd.remaining    = 0U;
     esp8266_at_core_reset_line(ctx);
 }
 
@@ -927,23 +1452,47 @@ static void esp8266_at_core_reset_line(esp8266_at_core_t *ctx)
 
 static void esp8266_at_core_process_prompt(esp8266_at_core_t *ctx)
 {
-    esp8266_at_event_t event;
-    memset(&event, 0, sizeof(event));
-
-    event.type    = ESP8266_AT_EVENT_TYPE_PROMPT;
-    event.command = ctx->pending_command;
-    event.raw_line[0] = ESP8266_AT_PROMPT_CHAR;
-    event.raw_line[1] = '\0';
-    strncpy(event.payload, event.raw_line, sizeof(event.payload) - 1U);
-
-    ctx->awaiting_reply            = false;
-    ctx->expect_prompt             = false;
-    ctx->phase                     = ESP8266_AT_PHASE_READY_FOR_DATA;
-    ctx->last_status               = ESP8266_AT_STATUS_PROMPT;
-    ctx->last_terminal_event       = event;
-    ctx->last_terminal_event_valid = true;
+    static const char prompt_line[] = { ESP8266_AT_PROMPT_CHAR, '\0' };
+    esp8266_at_record_t record;
+    memset(&record, 0, sizeof(record));
+    record.key = ESP8266_AT_KEY_NONE;
+
+    record.type        = (uint8_t)ESP8266_AT_EVENT_TYPE_PROMPT;
+    record.command     = (uint8_t)ctx->pending_command;
+    record.mode        = (uint8_t)ctx->pending_mode;
+    record.line_length = 1U;
+
+    ctx->awaiting_reply = false;
+    ctx->expect_prompt  = false;
+    ctx->phase          = ESP8266_AT_PHASE_READY_FOR_DATA;
+    ctx->last_status    = ESP8266_AT_STATUS_PROMPT;
+    esp8266_at_core_set_terminal(ctx, &record, prompt_line);
+
+    esp8266_at_core_emit(ctx, &record, prompt_line);
+}
 
-    (void)esp8266_at_queue_push(ctx, &event);
+static void esp8266_at_core_set_terminal(esp8266_at_core_t *ctx,
+                                         const esp8266_at_record_t *record,
+                                         const char *line)
+{
+    /* Terminal lines are short ("OK", "SEND FAIL", ">"), so keep a private
+     * copy that outlives the arena slot. */
+    size_t length = record->line_length;
+    if (length >= sizeof(ctx->terminal_line))
+    {
+        length = sizeof(ctx->terminal_line) - 1U;
+    }
+    memcpy(ctx->terminal_line, line, length);
+    ctx->terminal_line[length] = '\0';
+
+    ctx->last_terminal_event.type          = (esp8266_at_event_type_t)record->type;
+    ctx->last_terminal_event.command       = (esp8266_at_command_id_t)record->command;
+    ctx->last_terminal_event.mode          = (esp8266_at_command_mode_t)record->mode;
+    ctx->last_terminal_event.raw_line      = ctx->terminal_line;
+    ctx->last_terminal_event.payload       = ctx->terminal_line;
+    ctx->last_terminal_event.line_length   = (uint16_t)length;
+    ctx->last_terminal_event.prefix_length = 0U;
+    ctx->last_terminal_event_valid         = true;
 }
 
 static void esp8266_at_core_process_byte(esp8266_at_core_t *ctx, uint8_t byte)
@@ -973,6 +1522,11 @@ static void esp8266_at_core_process_byte(esp8266_at_core_t *ctx, uint8_t byte)
         return;
     }
 
+    if (byte == ':' && esp8266_at_core_begin_ipd(ctx))
+    {
+        return;
+    }
+
     if (byte == '\n')
     {
         if (ctx->line.length == 0U)
@@ -995,187 +1549,506 @@ static void esp8266_at_core_process_byte(esp8266_at_core_t *ctx, uint8_t byte)
     ctx->line.buffer[ctx->line.length++] = (char)byte;
 }
 
-static void esp8266_at_core_handle_line(esp8266_at_core_t *ctx, const char *line)
+static bool esp8266_at_core_begin_ipd(esp8266_at_core_t *ctx)
 {
-    if (ctx == NULL || line == NULL || line[0] == '\0')
+    /* "+IPD,<len>" or "+IPD,<link>,<len>[,<ip>,<port>]" has just been
+     * followed by ':'; everything after it is <len> raw bytes. */
+    static const char header[] = "+IPD,";
+    const size_t header_length = sizeof(header) - 1U;
+
+    if (ctx->line.length <= header_length
+        || memcmp(ctx->line.buffer, header, header_length) != 0)
+    {
+        return false;
+    }
+
+    /* A ':' inside a quoted CIPDINFO address ("fe80::1") is not the end of the header. */
+    bool in_quote = false;
+    for (size_t i = header_length; i < ctx->line.length; ++i)
+    {
+        if (ctx->line.buffer[i] == '"')
+        {
+            in_quote = !in_quote;
+        }
+    }
+    if (in_quote)
+    {
+        return false;
+    }
+
+    uint32_t fields[2] = { 0U, 0U };
+    size_t field_count = 0U;
+    size_t index = header_length;
+    while (field_count < 2U && index < ctx->line.length)
+    {
+        const size_t start = index;
+        uint32_t value = 0U;
+        while (index < ctx->line.length
+               && ctx->line.buffer[index] >= '0' && ctx->line.buffer[index] <= '9'
+               && value < 100000U)
+        {
+            value = (value * 10U) + (uint32_t)(ctx->line.buffer[index] - '0');
+            ++index;
+        }
+        if (index == start)
+        {
+            break;
+        }
+        fields[field_count++] = value;
+        if (index < ctx->line.length && ctx->line.buffer[index] != ',')
+        {
+            if (field_count == 2U && ctx->line.buffer[index] == '.')
+            {
+                /* CIPMUX=0 with CIPDINFO: the second field is the remote IP. */
+                field_count = 1U;
+                break;
+            }
+            return false;
+        }
+        ++index;
+    }
+
+    if (field_count == 0U)
+    {
+        return false;
+    }
+
+    const bool multi_link = (field_count == 2U);
+    const uint32_t data_length = multi_link ? fields[1] : fields[0];
+    if (data_length == 0U || (multi_link && fields[0] > UINT8_MAX))
+    {
+        return false;
+    }
+
+    ctx->ipd.active    = true;
+    ctx->ipd.link_id   = multi_link ? (uint8_t)fields[0] : 0U;
+    ctx->ipd.remaining = data_length;
+
+    if (ctx->ipd_handler != NULL)
+    {
+        esp8266_at_core_reset_line(ctx);
+    }
+    else if (ctx->line.length < (sizeof(ctx->line.buffer) - 1U))
+    {
+        /* No sink: keep the legacy "+IPD,...:data" event, truncated to a line. */
+        ctx->line.buffer[ctx->line.length++] = ':';
+    }
+    return true;
+}
+
+static size_t esp8266_at_core_process_ipd(esp8266_at_core_t *ctx,
+                                          const uint8_t *data,
+                                          size_t length)
+{
+    const size_t chunk = (length < ctx->ipd.remaining) ? length : (size_t)ctx->ipd.remaining;
+
+    if (ctx->ipd_handler != NULL)
+    {
+        ctx->ipd_handler(ctx->ipd.link_id, data, chunk, ctx->ipd_context);
+    }
+    else
+    {
+        size_t room = (sizeof(ctx->line.buffer) - 1U) - ctx->line.length;
+        if (room > chunk)
+        {
+            room = chunk;
+        }
+        memcpy(&ctx->line.buffer[ctx->line.length], data, room);
+        ctx->line.length += room;
+    }
+
+    ctx->ipd.remaining -= (uint32_t)chunk;
+    if (ctx->ipd.remaining == 0U)
+    {
+        ctx->ipd.active = false;
+        if (ctx->ipd_handler == NULL)
+        {
+            ctx->line.buffer[ctx->line.length] = '\0';
+            esp8266_at_core_handle_line(ctx, ctx->line.buffer);
+            esp8266_at_core_reset_line(ctx);
+        }
+    }
+    return chunk;
+}
+
+static void esp8266_at_core_handle_line(esp8266_at_core_t *ctx, char *line)
+{
+    if (ctx == NULL || line == NULL || line[0] == '\0')
     {
         return;
     }
 
-    char trimmed[ESP8266_AT_MAX_LINE_LENGTH];
-    strncpy(trimmed, line, sizeof(trimmed) - 1U);
-    trimmed[sizeof(trimmed) - 1U] = '\0';
-    esp8266_at_trim(trimmed);
-    if (trimmed[0] == '\0')
+    esp8266_at_trim(line);
+    if (line[0] == '\0')
     {
         return;
     }
 
-    esp8266_at_event_t event;
-    memset(&event, 0, sizeof(event));
-    strncpy(event.raw_line, trimmed, sizeof(event.raw_line) - 1U);
-    strncpy(event.payload, trimmed, sizeof(event.payload) - 1U);
+    esp8266_at_record_t record;
+    memset(&record, 0, sizeof(record));
+    record.line_length = (uint16_t)strlen(line);
+    record.command     = (uint8_t)ESP8266_AT_CMD_COUNT;
+    record.key         = ESP8266_AT_KEY_NONE;
 
-    if (esp8266_at_strcasecmp(trimmed, "OK") == 0)
+    esp8266_at_event_type_t type;
+    if (esp8266_at_strcasecmp(line, "OK") == 0)
     {
-        event.type = ESP8266_AT_EVENT_TYPE_OK;
+        type = ESP8266_AT_EVENT_TYPE_OK;
     }
-    else if (esp8266_at_strcasecmp(trimmed, "ERROR") == 0)
+    else if (esp8266_at_strcasecmp(line, "ERROR") == 0)
     {
-        event.type = ESP8266_AT_EVENT_TYPE_ERROR;
+        type = ESP8266_AT_EVENT_TYPE_ERROR;
     }
-    else if (esp8266_at_strcasecmp(trimmed, "FAIL") == 0)
+    else if (esp8266_at_strcasecmp(line, "FAIL") == 0)
     {
-        event.type = ESP8266_AT_EVENT_TYPE_FAIL;
+        type = ESP8266_AT_EVENT_TYPE_FAIL;
     }
-    else if (esp8266_at_strcasecmp(trimmed, "SEND OK") == 0)
+    else if (esp8266_at_strcasecmp(line, "SEND OK") == 0)
     {
-        event.type = ESP8266_AT_EVENT_TYPE_SEND_OK;
+        type = ESP8266_AT_EVENT_TYPE_SEND_OK;
     }
-    else if (esp8266_at_strcasecmp(trimmed, "SEND FAIL") == 0)
+    else if (esp8266_at_strcasecmp(line, "SEND FAIL") == 0)
     {
-        event.type = ESP8266_AT_EVENT_TYPE_SEND_FAIL;
+        type = ESP8266_AT_EVENT_TYPE_SEND_FAIL;
     }
-    else if (esp8266_at_strncasecmp(trimmed, "busy", 4U) == 0)
+    else if (esp8266_at_strncasecmp(line, "busy", 4U) == 0)
     {
-        event.type = ESP8266_AT_EVENT_TYPE_BUSY;
+        type = ESP8266_AT_EVENT_TYPE_BUSY;
     }
-    else if (trimmed[0] == '+')
+    else if (line[0] == '+')
     {
-        event.type = ESP8266_AT_EVENT_TYPE_RESPONSE;
-
-        char local[ESP8266_AT_MAX_LINE_LENGTH];
-        strncpy(local, trimmed, sizeof(local) - 1U);
-        local[sizeof(local) - 1U] = '\0';
+        type = ESP8266_AT_EVENT_TYPE_RESPONSE;
 
-        char *separator = strpbrk(local, ":=");
-        char *payload   = NULL;
+        /* "+PREFIX:payload" is only located here; arguments are split on access. */
+        const char *separator = strpbrk(line, ":=");
+        size_t prefix_length  = record.line_length;
+        size_t payload_offset = 0U;
         if (separator != NULL)
         {
-            *separator = '\0';
-            payload = separator + 1;
-            while (payload[0] == ' ')
+            prefix_length  = (size_t)(separator - line);
+            payload_offset = prefix_length + 1U;
+            while (line[payload_offset] == ' ')
             {
-                ++payload;
+                ++payload_offset;
             }
         }
 
-        strncpy(event.prefix, local, sizeof(event.prefix) - 1U);
-        if (payload != NULL)
+        record.prefix_length  = (uint8_t)((prefix_length > UINT8_MAX) ? UINT8_MAX : prefix_length);
+        record.payload_offset = (uint8_t)payload_offset;
+        record.key            = esp8266_at_lookup_key(line, prefix_length);
+        if (record.key < (uint8_t)ESP8266_AT_CMD_COUNT)
         {
-            strncpy(event.payload, payload, sizeof(event.payload) - 1U);
+            record.command = record.key;
         }
-
-        event.command = esp8266_at_match_command_by_prefix(event.prefix);
-        esp8266_at_parse_response_payload(&event);
     }
-    else if (esp8266_at_strcasecmp(trimmed, "ready") == 0)
+    else if (esp8266_at_strcasecmp(line, "ready") == 0)
     {
-        event.type = ESP8266_AT_EVENT_TYPE_INDICATION;
-        strncpy(event.prefix, "READY", sizeof(event.prefix) - 1U);
+        type = ESP8266_AT_EVENT_TYPE_INDICATION;
+        record.prefix_length = 5U;
+        record.key           = esp8266_at_lookup_key(line, record.line_length);
     }
-    else if (esp8266_at_strncasecmp(trimmed, "WIFI ", 5U) == 0)
+    else if (esp8266_at_strncasecmp(line, "WIFI ", 5U) == 0)
     {
-        event.type = ESP8266_AT_EVENT_TYPE_INDICATION;
-        strncpy(event.prefix, "WIFI", sizeof(event.prefix) - 1U);
+        type = ESP8266_AT_EVENT_TYPE_INDICATION;
+        record.prefix_length = 4U;
+        record.key           = esp8266_at_lookup_key(line, record.line_length);
     }
     else
     {
-        event.type = ESP8266_AT_EVENT_TYPE_INFO;
+        type = ESP8266_AT_EVENT_TYPE_INFO;
     }
+    record.type = (uint8_t)type;
 
-    switch (event.type)
+    if (type == ESP8266_AT_EVENT_TYPE_OK && ctx->awaiting_reply && ctx->expect_prompt)
+    {
+        /* AT+CIPSEND / AT+MQTTPUBRAW answer "OK" and then '>'; keep waiting. */
+        esp8266_at_core_emit(ctx, &record, line);
+        return;
+    }
+    if (type == ESP8266_AT_EVENT_TYPE_RESPONSE
+        && ctx->awaiting_reply
+        && ctx->phase == ESP8266_AT_PHASE_WAITING_FINAL
+        && ctx->pending_command == ESP8266_AT_CMD_MQTTPUBRAW
+        && record.command == (uint8_t)ESP8266_AT_CMD_MQTTPUB)
+    {
+        /* The raw payload is acknowledged with "+MQTTPUB:OK" / "+MQTTPUB:FAIL". */
+        const char *payload = line + record.payload_offset;
+        type = (esp8266_at_strcasecmp(payload, "OK") == 0) ? ESP8266_AT_EVENT_TYPE_SEND_OK
+                                                           : ESP8266_AT_EVENT_TYPE_SEND_FAIL;
+        record.type = (uint8_t)type;
+    }
+
+    switch (type)
     {
         case ESP8266_AT_EVENT_TYPE_OK:
         case ESP8266_AT_EVENT_TYPE_SEND_OK:
-            event.command                 = ctx->pending_command;
-            ctx->awaiting_reply            = false;
-            ctx->phase                     = ESP8266_AT_PHASE_IDLE;
-            ctx->last_status               = ESP8266_AT_STATUS_OK;
-            ctx->last_terminal_event       = event;
-            ctx->last_terminal_event_valid = true;
+            ctx->last_status = ESP8266_AT_STATUS_OK;
             break;
 
         case ESP8266_AT_EVENT_TYPE_ERROR:
-            event.command                 = ctx->pending_command;
-            ctx->awaiting_reply            = false;
-            ctx->phase                     = ESP8266_AT_PHASE_IDLE;
-            ctx->last_status               = ESP8266_AT_STATUS_ERROR_RESPONSE;
-            ctx->last_terminal_event       = event;
-            ctx->last_terminal_event_valid = true;
+            ctx->last_status = ESP8266_AT_STATUS_ERROR_RESPONSE;
             break;
 
         case ESP8266_AT_EVENT_TYPE_FAIL:
         case ESP8266_AT_EVENT_TYPE_SEND_FAIL:
-            event.command                 = ctx->pending_command;
-            ctx->awaiting_reply            = false;
-            ctx->phase                     = ESP8266_AT_PHASE_IDLE;
-            ctx->last_status               = ESP8266_AT_STATUS_FAIL_RESPONSE;
-            ctx->last_terminal_event       = event;
-            ctx->last_terminal_event_valid = true;
+            ctx->last_status = ESP8266_AT_STATUS_FAIL_RESPONSE;
             break;
 
         case ESP8266_AT_EVENT_TYPE_BUSY:
-            event.command                 = ctx->pending_command;
-            ctx->awaiting_reply            = false;
-            ctx->phase                     = ESP8266_AT_PHASE_IDLE;
-            ctx->last_status               = ESP8266_AT_STATUS_BUSY_RESPONSE;
-            ctx->last_terminal_event       = event;
-            ctx->last_terminal_event_valid = true;
+            ctx->last_status = ESP8266_AT_STATUS_BUSY_RESPONSE;
             break;
 
         default:
-            break;
+            esp8266_at_core_emit(ctx, &record, line);
+            return;
     }
 
-    (void)esp8266_at_queue_push(ctx, &event);
+    record.command      = (uint8_t)ctx->pending_command;
+    record.mode         = (uint8_t)ctx->pending_mode;
+    ctx->awaiting_reply = false;
+    ctx->phase          = ESP8266_AT_PHASE_IDLE;
+    esp8266_at_core_set_terminal(ctx, &record, line);
+
+    esp8266_at_core_emit(ctx, &record, line);
 }
 
-static bool esp8266_at_queue_push(esp8266_at_core_t *ctx, const esp8266_at_event_t *event)
+static void esp8266_at_core_emit(esp8266_at_core_t *ctx,
+                                 const esp8266_at_record_t *record,
+                                 const char *line)
 {
-    if (ctx == NULL || event == NULL)
+    esp8266_at_event_t event;
+    event.type          = (esp8266_at_event_type_t)record->type;
+    event.command       = (esp8266_at_command_id_t)record->command;
+    event.mode          = (esp8266_at_command_mode_t)record->mode;
+    event.raw_line      = line;
+    event.payload       = line + record->payload_offset;
+    event.line_length   = record->line_length;
+    event.prefix_length = record->prefix_length;
+
+    if (ctx->line_observer != NULL)
+    {
+        ctx->line_observer(&event, ctx->line_observer_context);
+    }
+
+    if (esp8266_at_core_dispatch_urc(ctx, record, &event))
+    {
+        return;
+    }
+
+    (void)esp8266_at_queue_push(ctx, record, line);
+}
+
+static bool esp8266_at_core_dispatch_urc(esp8266_at_core_t *ctx,
+                                         const esp8266_at_record_t *record,
+                                         const esp8266_at_event_t *event)
+{
+    if (record->key == ESP8266_AT_KEY_NONE)
+    {
+        return false;
+    }
+
+    const uint8_t route = ctx->urc.route[record->key];
+    if (route == 0U)
+    {
+        return false;
+    }
+
+    /* "+CMD:" lines answering the command in flight belong to its caller. */
+    if (ctx->awaiting_reply && record->key == (uint8_t)ctx->pending_command)
+    {
+        return false;
+    }
+
+    const esp8266_at_urc_handler_t handler = ctx->urc.handlers[route - 1U].handler;
+    if (handler == NULL)
+    {
+        return false;
+    }
+
+    handler(event, ctx->urc.handlers[route - 1U].context);
+    return true;
+}
+
+static uint32_t esp8266_at_arena_oldest(const esp8266_at_core_t *ctx)
+{
+    /* Positions are free-running, so the oldest live byte is the one
+     * furthest behind the write cursor. */
+    uint32_t oldest = ctx->arena.write;
+
+    if (ctx->queue.count > 0U)
+    {
+        const uint32_t position = ctx->queue.records[ctx->queue.head].position;
+        if ((ctx->arena.write - position) > (ctx->arena.write - oldest))
+        {
+            oldest = position;
+        }
+    }
+    if (ctx->arena.held_valid
+        && (ctx->arena.write - ctx->arena.held) > (ctx->arena.write - oldest))
+    {
+        oldest = ctx->arena.held;
+    }
+    return oldest;
+}
+
+static void esp8266_at_queue_drop_head(esp8266_at_core_t *ctx)
+{
+    ctx->queue.head = (uint8_t)((ctx->queue.head + 1U) % ESP8266_AT_EVENT_QUEUE_DEPTH);
+    ctx->queue.count--;
+}
+
+static bool esp8266_at_queue_push(esp8266_at_core_t *ctx,
+                                  const esp8266_at_record_t *record,
+                                  const char *line)
+{
+    if (ctx == NULL || record == NULL || line == NULL)
     {
         return false;
     }
 
     if (ctx->queue.count >= ESP8266_AT_EVENT_QUEUE_DEPTH)
     {
-        ctx->queue.head = (uint8_t)((ctx->queue.head + 1U) % ESP8266_AT_EVENT_QUEUE_DEPTH);
-        ctx->queue.count--;
+        esp8266_at_queue_drop_head(ctx);
+        ctx->arena.dropped++;
+    }
+
+    /* Lines never wrap: if the tail of the arena is too short, skip to its start. */
+    const uint32_t need = (uint32_t)record->line_length + 1U;
+    uint32_t start;
+    while (true)
+    {
+        start = ctx->arena.write;
+        const uint32_t offset = start & ESP8266_AT_ARENA_MASK;
+        if (offset + need > ESP8266_AT_EVENT_ARENA_SIZE)
+        {
+            start += ESP8266_AT_EVENT_ARENA_SIZE - offset;
+        }
+        if ((start + need - esp8266_at_arena_oldest(ctx)) <= ESP8266_AT_EVENT_ARENA_SIZE)
+        {
+            break;
+        }
+        if (ctx->queue.count == 0U
+            || (ctx->arena.held_valid
+                && (ctx->arena.write - ctx->arena.held)
+                   > (ctx->arena.write - ctx->queue.records[ctx->queue.head].position)))
+        {
+            /* The event the application is still reading is the oldest line, so
+             * evicting queued lines frees nothing: lose only the new one. */
+            ctx->arena.dropped++;
+            return false;
+        }
+        esp8266_at_queue_drop_head(ctx);
+        ctx->arena.dropped++;
     }
 
-    ctx->queue.events[ctx->queue.tail] = *event;
+    char *slot = &ctx->arena.bytes[start & ESP8266_AT_ARENA_MASK];
+    memcpy(slot, line, record->line_length);
+    slot[record->line_length] = '\0';
+    ctx->arena.write = start + need;
+
+    esp8266_at_record_t *entry = &ctx->queue.records[ctx->queue.tail];
+    *entry = *record;
+    entry->position = start;
     ctx->queue.tail = (uint8_t)((ctx->queue.tail + 1U) % ESP8266_AT_EVENT_QUEUE_DEPTH);
     ctx->queue.count++;
     return true;
 }
 
+static void esp8266_at_record_to_event(const esp8266_at_core_t *ctx,
+                                       const esp8266_at_record_t *record,
+                                       esp8266_at_event_t *event)
+{
+    const char *line = &ctx->arena.bytes[record->position & ESP8266_AT_ARENA_MASK];
+
+    event->type          = (esp8266_at_event_type_t)record->type;
+    event->command       = (esp8266_at_command_id_t)record->command;
+    event->mode          = (esp8266_at_command_mode_t)record->mode;
+    event->raw_line      = line;
+    event->payload       = line + record->payload_offset;
+    event->line_length   = record->line_length;
+    event->prefix_length = record->prefix_length;
+}
+
 static bool esp8266_at_queue_pop(esp8266_at_core_t *ctx, esp8266_at_event_t *event)
 {
-    if (ctx == NULL || event == NULL || ctx->queue.count == 0U)
+    if (ctx == NULL || event == NULL)
     {
         return false;
     }
 
-    *event = ctx->queue.events[ctx->queue.head];
-    ctx->queue.head = (uint8_t)((ctx->queue.head + 1U) % ESP8266_AT_EVENT_QUEUE_DEPTH);
-    ctx->queue.count--;
-    return true;
+    const uint32_t state = esp8266_at_interface_hw_enter_critical();
+    ctx->arena.held_valid = false;
+    const bool found = (ctx->queue.count != 0U);
+    if (found)
+    {
+        const esp8266_at_record_t *record = &ctx->queue.records[ctx->queue.head];
+        esp8266_at_record_to_event(ctx, record, event);
+        ctx->arena.held       = record->position;
+        ctx->arena.held_valid = true;
+        esp8266_at_queue_drop_head(ctx);
+    }
+    esp8266_at_interface_hw_exit_critical(state);
+    return found;
 }
 
-static void esp8266_at_queue_restore(esp8266_at_core_t *ctx,
-                                     const esp8266_at_event_t *events,
-                                     size_t count)
+static bool esp8266_at_queue_take(esp8266_at_core_t *ctx,
+                                  esp8266_at_record_match_t match,
+                                  const char *key,
+                                  esp8266_at_event_t *event)
 {
-    if (ctx == NULL || events == NULL)
+    if (ctx == NULL || match == NULL || event == NULL)
     {
-        return;
+        return false;
     }
 
-    for (size_t i = 0U; i < count; ++i)
+    bool found = false;
+    const uint32_t state = esp8266_at_interface_hw_enter_critical();
+    ctx->arena.held_valid = false;
+
+    for (uint8_t i = 0U; i < ctx->queue.count && !found; ++i)
     {
-        (void)esp8266_at_queue_push(ctx, &events[i]);
+        uint8_t slot = (uint8_t)((ctx->queue.head + i) % ESP8266_AT_EVENT_QUEUE_DEPTH);
+        const esp8266_at_record_t *record = &ctx->queue.records[slot];
+        if (!match(record, &ctx->arena.bytes[record->position & ESP8266_AT_ARENA_MASK], key))
+        {
+            continue;
+        }
+
+        esp8266_at_record_to_event(ctx, record, event);
+        ctx->arena.held       = record->position;
+        ctx->arena.held_valid = true;
+        found = true;
+
+        /* Close the gap so the remaining descriptors keep their order. */
+        for (uint8_t j = (uint8_t)(i + 1U); j < ctx->queue.count; ++j)
+        {
+            const uint8_t next = (uint8_t)((slot + 1U) % ESP8266_AT_EVENT_QUEUE_DEPTH);
+            ctx->queue.records[slot] = ctx->queue.records[next];
+            slot = next;
+        }
+        ctx->queue.tail  = slot;
+        ctx->queue.count--;
     }
+
+    esp8266_at_interface_hw_exit_critical(state);
+    return found;
+}
+
+static bool esp8266_at_match_line(const esp8266_at_record_t *record,
+                                  const char *line,
+                                  const char *key)
+{
+    (void)record;
+    return esp8266_at_strcasecmp(line, key) == 0;
+}
+
+static bool esp8266_at_match_prefix(const esp8266_at_record_t *record,
+                                    const char *line,
+                                    const char *key)
+{
+    const size_t length = strlen(key);
+    return length == record->prefix_length
+        && esp8266_at_strncasecmp(line, key, length) == 0;
 }
 
 static uint32_t esp8266_at_tick_elapsed(uint32_t start, uint32_t now)
@@ -1326,67 +2199,6 @@ static void esp8266_at_copy_lower(char *dest, size_t dest_size, const char *sour
     dest[index] = '\0';
 }
 
-static void esp8266_at_parse_response_payload(esp8266_at_event_t *event)
-{
-    if (event == NULL)
-    {
-        return;
-    }
-
-    for (size_t i = 0U; i < ESP8266_AT_MAX_ARGUMENTS; ++i)
-    {
-        event->arguments[i].value[0] = '\0';
-        event->arguments[i].quoted   = false;
-    }
-
-    if (event->payload[0] == '\0')
-    {
-        event->argument_count = 0U;
-        return;
-    }
-
-    size_t arg_index = 0U;
-    size_t out_index = 0U;
-    bool in_quote = false;
-    const char *cursor = event->payload;
-
-    event->argument_count = 1U;
-    event->arguments[0].value[0] = '\0';
-
-    while (*cursor != '\0' && arg_index < ESP8266_AT_MAX_ARGUMENTS)
-    {
-        const char ch = *cursor++;
-        if (ch == '"')
-        {
-            in_quote = !in_quote;
-            event->arguments[arg_index].quoted = true;
-            continue;
-        }
-        if (ch == ',' && !in_quote)
-        {
-            esp8266_at_trim(event->arguments[arg_index].value);
-            ++arg_index;
-            if (arg_index >= ESP8266_AT_MAX_ARGUMENTS)
-            {
-                break;
-            }
-            event->arguments[arg_index].value[0] = '\0';
-            event->arguments[arg_index].quoted   = false;
-            out_index = 0U;
-            event->argument_count = arg_index + 1U;
-            continue;
-        }
-        if (out_index < (ESP8266_AT_MAX_ARGUMENT_LENGTH - 1U))
-        {
-            event->arguments[arg_index].value[out_index++] = ch;
-            event->arguments[arg_index].value[out_index]   = '\0';
-        }
-    }
-
-    esp8266_at_trim(event->arguments[arg_index].value);
-    event->argument_count = arg_index + 1U;
-}
-
 static void esp8266_at_parse_ip_descriptor(const esp8266_at_event_t *event,
                                            bool station,
                                            esp8266_at_ip_info_t *info)
@@ -1498,58 +2310,160 @@ static void esp8266_at_parse_ip_descriptor(const esp8266_at_event_t *event,
     }
 }
 
-static esp8266_at_command_id_t esp8266_at_match_command_by_prefix(const char *prefix)
+static const char *esp8266_at_key_text(uint8_t key)
 {
-    if (prefix == NULL || prefix[0] == '\0')
+    if (key < (uint8_t)ESP8266_AT_CMD_COUNT)
     {
-        return ESP8266_AT_CMD_COUNT;
+        const char *literal = s_command_table[key].literal;
+        const char *plus    = strchr(literal, '+');
+        return (plus != NULL) ? plus : literal;
     }
+    return s_urc_table[key - (uint8_t)ESP8266_AT_CMD_COUNT];
+}
 
-    for (size_t i = 0U; i < ESP8266_AT_CMD_COUNT; ++i)
+static uint32_t esp8266_at_key_hash(const char *key, size_t length, uint32_t seed)
+{
+    /* Case-insensitive FNV-1a. */
+    uint32_t hash = 2166136261UL ^ seed;
+    for (size_t i = 0U; i < length; ++i)
     {
-        const char *literal = s_command_table[i].literal;
-        const char *plus    = strchr(literal, '+');
-        const char *candidate = (plus != NULL) ? plus : literal;
-        if (esp8266_at_strcasecmp(candidate, prefix) == 0)
-        {
-            return (esp8266_at_command_id_t)i;
-        }
+        hash ^= (uint32_t)toupper((int)(unsigned char)key[i]);
+        hash *= 16777619UL;
     }
-    return ESP8266_AT_CMD_COUNT;
+    return hash;
 }
 
-static bool esp8266_at_pop_event_by_prefix(const char *prefix, esp8266_at_event_t *out_event)
+static uint32_t esp8266_at_key_seed(uint8_t displacement)
 {
-    if (prefix == NULL || out_event == NULL)
+    return ((uint32_t)displacement + 1UL) * 0x9E3779B9UL;
+}
+
+static void esp8266_at_build_key_hash(void)
+{
+    if (s_key_hash_ready)
     {
-        return false;
+        return;
     }
 
-    if (s_core.queue.count == 0U)
+    uint8_t bucket_size[ESP8266_AT_KEY_BUCKETS] = { 0U };
+    bool    bucket_done[ESP8266_AT_KEY_BUCKETS] = { false };
+    uint8_t placed[ESP8266_AT_KEY_COUNT];
+
+    memset(s_key_slots, 0, sizeof(s_key_slots));
+    for (size_t key = 0U; key < ESP8266_AT_KEY_COUNT; ++key)
     {
-        return false;
+        const char *text = esp8266_at_key_text((uint8_t)key);
+        bucket_size[esp8266_at_key_hash(text, strlen(text), 0U) % ESP8266_AT_KEY_BUCKETS]++;
     }
 
-    const uint8_t initial_count = s_core.queue.count;
-    bool found = false;
+    /* Largest buckets first; each gets the first displacement that drops all
+     * of its keys into free slots. */
+    for (size_t round = 0U; round < ESP8266_AT_KEY_BUCKETS; ++round)
+    {
+        size_t bucket = ESP8266_AT_KEY_BUCKETS;
+        for (size_t i = 0U; i < ESP8266_AT_KEY_BUCKETS; ++i)
+        {
+            if (!bucket_done[i] && (bucket == ESP8266_AT_KEY_BUCKETS || bucket_size[i] > bucket_size[bucket]))
+            {
+                bucket = i;
+            }
+        }
+        bucket_done[bucket] = true;
+        if (bucket_size[bucket] == 0U)
+        {
+            continue;
+        }
+
+        bool fitted = false;
+        for (uint32_t displacement = 0U; displacement <= UINT8_MAX && !fitted; ++displacement)
+        {
+            const uint32_t seed = esp8266_at_key_seed((uint8_t)displacement);
+            size_t placed_count = 0U;
+            fitted = true;
 
-    for (uint8_t i = 0U; i < initial_count; ++i)
+            for (size_t key = 0U; key < ESP8266_AT_KEY_COUNT; ++key)
+            {
+                const char  *text   = esp8266_at_key_text((uint8_t)key);
+                const size_t length = strlen(text);
+                if ((esp8266_at_key_hash(text, length, 0U) % ESP8266_AT_KEY_BUCKETS) != bucket)
+                {
+                    continue;
+                }
+
+                const uint8_t slot = (uint8_t)(esp8266_at_key_hash(text, length, seed) % ESP8266_AT_KEY_SLOTS);
+                if (s_key_slots[slot] != 0U)
+                {
+                    fitted = false;
+                    break;
+                }
+                s_key_slots[slot] = (uint8_t)(key + 1U);
+                placed[placed_count++] = slot;
+            }
+
+            if (fitted)
+            {
+                s_key_displacement[bucket] = (uint8_t)displacement;
+            }
+            else
+            {
+                while (placed_count > 0U)
+                {
+                    s_key_slots[placed[--placed_count]] = 0U;
+                }
+            }
+        }
+
+        if (!fitted)
+        {
+            return;   /* esp8266_at_lookup_key() falls back to a linear scan */
+        }
+    }
+
+    s_key_hash_ready = true;
+}
+
+static uint8_t esp8266_at_lookup_key(const char *key, size_t length)
+{
+    if (key == NULL || length == 0U)
     {
-        esp8266_at_event_t event;
-        if (!esp8266_at_queue_pop(&s_core, &event))
+        return ESP8266_AT_KEY_NONE;
+    }
+
+    if (s_key_hash_ready)
+    {
+        const uint32_t bucket = esp8266_at_key_hash(key, length, 0U) % ESP8266_AT_KEY_BUCKETS;
+        const uint32_t seed   = esp8266_at_key_seed(s_key_displacement[bucket]);
+        const uint8_t  entry  = s_key_slots[esp8266_at_key_hash(key, length, seed) % ESP8266_AT_KEY_SLOTS];
+        if (entry == 0U)
         {
-            break;
+            return ESP8266_AT_KEY_NONE;
         }
 
-        if (!found && esp8266_at_strcasecmp(event.prefix, prefix) == 0)
+        const char *text = esp8266_at_key_text((uint8_t)(entry - 1U));
+        return (esp8266_at_strnlen(text, length + 1U) == length
+                && esp8266_at_strncasecmp(text, key, length) == 0)
+               ? (uint8_t)(entry - 1U)
+               : ESP8266_AT_KEY_NONE;
+    }
+
+    for (size_t i = 0U; i < ESP8266_AT_KEY_COUNT; ++i)
+    {
+        const char *text = esp8266_at_key_text((uint8_t)i);
+        if (esp8266_at_strnlen(text, length + 1U) == length
+            && esp8266_at_strncasecmp(text, key, length) == 0)
         {
-            *out_event = event;
-            found = true;
-            continue;
+            return (uint8_t)i;
         }
+    }
+    return ESP8266_AT_KEY_NONE;
+}
 
-        (void)esp8266_at_queue_push(&s_core, &event);
+static bool esp8266_at_pop_event_by_prefix(const char *prefix, esp8266_at_event_t *out_event)
+{
+    if (prefix == NULL || out_event == NULL)
+    {
+        return false;
     }
 
-    return found;
+    return esp8266_at_queue_take(&s_core, esp8266_at_match_prefix, prefix, out_event);
 }
@@ -154,6 +154,23 @@ void esp8266_at_interface_hw_restart_rx(void)
     (void)esp8266_at_interface_start_rx();
 }
 
+/* The event queue is filled from the UART RX event callback, so the core
+ * masks interrupts briefly while it pops or searches queued lines. */
+uint32_t esp8266_at_interface_hw_enter_critical(void)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+void esp8266_at_interface_hw_exit_critical(uint32_t state)
+{
+    if (state == 0U)
+    {
+        __enable_irq();
+    }
+}
+
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
     if (s_hal.initialised && huart == s_hal.uart)
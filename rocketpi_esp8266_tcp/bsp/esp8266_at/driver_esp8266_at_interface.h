@@ -20,6 +20,8 @@ esp8266_at_status_t esp8266_at_interface_hw_send(const uint8_t *data,
                                                  uint32_t timeout_ms);
 uint32_t esp8266_at_interface_hw_get_tick(void);
 void esp8266_at_interface_hw_restart_rx(void);
+uint32_t esp8266_at_interface_hw_enter_critical(void);
+void esp8266_at_interface_hw_exit_critical(uint32_t state);
 void esp8266_at_interface_flush_trace(void);
 
 #ifdef __cplusplus
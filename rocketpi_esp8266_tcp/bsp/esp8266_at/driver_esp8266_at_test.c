@@ -86,15 +86,21 @@ static void esp8266_at_test_print_event(const esp8266_at_event_t *event)
     }
     printf("\r\n");
 
-    if (event->argument_count > 0U)
+    if (event->type != ESP8266_AT_EVENT_TYPE_RESPONSE)
     {
-        for (size_t i = 0U; i < event->argument_count; ++i)
-        {
-            printf("        arg%u%s: %s\r\n",
-                   (unsigned int)i,
-                   event->arguments[i].quoted ? "(q)" : "",
-                   event->arguments[i].value);
-        }
+        return;
+    }
+
+    esp8266_at_argument_t arguments[ESP8266_AT_MAX_ARGUMENTS];
+    const size_t argument_count =
+        esp8266_at_event_arguments(event, arguments, ESP8266_AT_MAX_ARGUMENTS);
+    for (size_t i = 0U; i < argument_count; ++i)
+    {
+        printf("        arg%u%s: %.*s\r\n",
+               (unsigned int)i,
+               arguments[i].quoted ? "(q)" : "",
+               (int)arguments[i].length,
+               &event->payload[arguments[i].offset]);
     }
 }
 
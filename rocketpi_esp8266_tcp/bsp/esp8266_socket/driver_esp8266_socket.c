@@ -0,0 +1,304 @@
+/**
+ * @file driver_esp8266_socket.c
+ * @brief Socket-style multi-link API for the ESP8266 AT driver.
+ */
+#include "driver_esp8266_socket.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define ESP8266_SOCKET_RING_MASK (ESP8266_SOCKET_RX_RING_SIZE - 1U)
+
+typedef struct
+{
+    volatile esp8266_socket_state_t state;
+    volatile uint32_t               head;      /* written by the RX callback */
+    volatile uint32_t               tail;      /* advanced by esp8266_socket_recv() */
+    volatile uint32_t               overflow;
+    uint8_t                         ring[ESP8266_SOCKET_RX_RING_SIZE];
+} esp8266_socket_link_t;
+
+typedef struct
+{
+    bool                  initialised;
+    bool                  send_pending;
+    esp8266_socket_link_t links[ESP8266_SOCKET_MAX_LINKS];
+} esp8266_socket_ctx_t;
+
+static esp8266_socket_ctx_t s_socket;
+
+static void esp8266_socket_on_ipd(uint8_t link_id,
+                                  const uint8_t *data,
+                                  size_t length,
+                                  void *context)
+{
+    (void)context;
+    if (link_id >= ESP8266_SOCKET_MAX_LINKS)
+    {
+        return;
+    }
+
+    esp8266_socket_link_t *link = &s_socket.links[link_id];
+    const uint32_t head = link->head;
+    const uint32_t space = ESP8266_SOCKET_RX_RING_SIZE - (head - link->tail);
+    const size_t accepted = (length < space) ? length : (size_t)space;
+
+    const uint32_t offset = head & ESP8266_SOCKET_RING_MASK;
+    const size_t first = ((ESP8266_SOCKET_RX_RING_SIZE - offset) < accepted)
+                       ? (size_t)(ESP8266_SOCKET_RX_RING_SIZE - offset)
+                       : accepted;
+    memcpy(&link->ring[offset], data, first);
+    memcpy(&link->ring[0], &data[first], accepted - first);
+
+    link->head = head + (uint32_t)accepted;
+    link->overflow += (uint32_t)(length - accepted);
+}
+
+static void esp8266_socket_on_line(const esp8266_at_event_t *event, void *context)
+{
+    (void)context;
+
+    /* Link state URCs look like "<link>,CONNECT", "<link>,CLOSED", "<link>,CONNECT FAIL". */
+    const char *line = event->raw_line;
+    if (line[0] < '0' || line[0] > '9' || line[1] != ',')
+    {
+        return;
+    }
+
+    const uint8_t link_id = (uint8_t)(line[0] - '0');
+    if (link_id >= ESP8266_SOCKET_MAX_LINKS)
+    {
+        return;
+    }
+
+    if (strcmp(&line[2], "CONNECT") == 0)
+    {
+        s_socket.links[link_id].state = ESP8266_SOCKET_STATE_CONNECTED;
+    }
+    else if (strcmp(&line[2], "CLOSED") == 0 || strcmp(&line[2], "CONNECT FAIL") == 0)
+    {
+        s_socket.links[link_id].state = ESP8266_SOCKET_STATE_CLOSED;
+    }
+}
+
+esp8266_at_status_t esp8266_socket_init(void)
+{
+    memset(&s_socket, 0, sizeof(s_socket));
+
+    esp8266_at_set_ipd_handler(esp8266_socket_on_ipd, NULL);
+    esp8266_at_set_line_observer(esp8266_socket_on_line, NULL);
+
+    const esp8266_at_status_t status =
+        esp8266_at_send_command(ESP8266_AT_CMD_CIPMUX,
+                                ESP8266_AT_COMMAND_MODE_SET,
+                                "1",
+                                ESP8266_AT_DEFAULT_TIMEOUT_MS,
+                                false);
+    if (status != ESP8266_AT_STATUS_OK)
+    {
+        esp8266_socket_deinit();
+        return status;
+    }
+
+    s_socket.initialised = true;
+    return ESP8266_AT_STATUS_OK;
+}
+
+void esp8266_socket_deinit(void)
+{
+    esp8266_at_set_ipd_handler(NULL, NULL);
+    esp8266_at_set_line_observer(NULL, NULL);
+    memset(&s_socket, 0, sizeof(s_socket));
+}
+
+esp8266_at_status_t esp8266_socket_connect(uint8_t link_id,
+                                           esp8266_socket_type_t type,
+                                           const char *host,
+                                           uint16_t port,
+                                           uint32_t timeout_ms)
+{
+    if (!s_socket.initialised)
+    {
+        return ESP8266_AT_STATUS_NOT_INITIALISED;
+    }
+    if (link_id >= ESP8266_SOCKET_MAX_LINKS || host == NULL || port == 0U)
+    {
+        return ESP8266_AT_STATUS_INVALID_ARGUMENT;
+    }
+
+    esp8266_at_status_t status = esp8266_socket_flush(timeout_ms);
+    if (status != ESP8266_AT_STATUS_OK)
+    {
+        return status;
+    }
+
+    esp8266_socket_link_t *link = &s_socket.links[link_id];
+    link->tail     = link->head;
+    link->overflow = 0U;
+    link->state    = ESP8266_SOCKET_STATE_CONNECTING;
+
+    char args[ESP8266_AT_MAX_LINE_LENGTH];
+    (void)snprintf(args,
+                   sizeof(args),
+                   "%u,\"%s\",\"%s\",%u",
+                   (unsigned int)link_id,
+                   (type == ESP8266_SOCKET_UDP) ? "UDP" : "TCP",
+                   host,
+                   (unsigned int)port);
+
+    status = esp8266_at_send_command(ESP8266_AT_CMD_CIPSTART,
+                                     ESP8266_AT_COMMAND_MODE_SET,
+                                     args,
+                                     (timeout_ms != 0U) ? timeout_ms : (ESP8266_AT_DEFAULT_TIMEOUT_MS * 5U),
+                                     false);
+    link->state = (status == ESP8266_AT_STATUS_OK) ? ESP8266_SOCKET_STATE_CONNECTED
+                                                    : ESP8266_SOCKET_STATE_CLOSED;
+    return status;
+}
+
+esp8266_at_status_t esp8266_socket_send(uint8_t link_id,
+                                        const void *data,
+                                        size_t length,
+                                        uint32_t timeout_ms)
+{
+    if (!s_socket.initialised)
+    {
+        return ESP8266_AT_STATUS_NOT_INITIALISED;
+    }
+    if (link_id >= ESP8266_SOCKET_MAX_LINKS || data == NULL || length == 0U)
+    {
+        return ESP8266_AT_STATUS_INVALID_ARGUMENT;
+    }
+    if (s_socket.links[link_id].state != ESP8266_SOCKET_STATE_CONNECTED)
+    {
+        return ESP8266_AT_STATUS_UNEXPECTED_RESPONSE;
+    }
+
+    const uint8_t *cursor = (const uint8_t *)data;
+    while (length > 0U)
+    {
+        const size_t chunk = (length < ESP8266_SOCKET_TX_CHUNK_SIZE) ? length : ESP8266_SOCKET_TX_CHUNK_SIZE;
+
+        /* The previous chunk's "SEND OK" is collected only now, so the modem's
+         * radio time overlaps with the caller preparing the next buffer. */
+        esp8266_at_status_t status = esp8266_socket_flush(timeout_ms);
+        if (status != ESP8266_AT_STATUS_OK)
+        {
+            return status;
+        }
+
+        char args[16];
+        (void)snprintf(args, sizeof(args), "%u,%u", (unsigned int)link_id, (unsigned int)chunk);
+        status = esp8266_at_send_command(ESP8266_AT_CMD_CIPSEND,
+                                         ESP8266_AT_COMMAND_MODE_SET,
+                                         args,
+                                         timeout_ms,
+                                         true);
+        if (status != ESP8266_AT_STATUS_PROMPT)
+        {
+            return (status == ESP8266_AT_STATUS_OK) ? ESP8266_AT_STATUS_UNEXPECTED_RESPONSE : status;
+        }
+
+        status = esp8266_at_send_data(cursor, chunk, timeout_ms);
+        if (status != ESP8266_AT_STATUS_OK)
+        {
+            return status;
+        }
+        s_socket.send_pending = true;
+
+        cursor += chunk;
+        length -= chunk;
+    }
+
+    return ESP8266_AT_STATUS_OK;
+}
+
+esp8266_at_status_t esp8266_socket_flush(uint32_t timeout_ms)
+{
+    if (!s_socket.send_pending)
+    {
+        return ESP8266_AT_STATUS_OK;
+    }
+
+    s_socket.send_pending = false;
+    return esp8266_at_wait_for_completion(timeout_ms, NULL);
+}
+
+size_t esp8266_socket_recv(uint8_t link_id, void *buffer, size_t size)
+{
+    if (link_id >= ESP8266_SOCKET_MAX_LINKS || buffer == NULL || size == 0U)
+    {
+        return 0U;
+    }
+
+    esp8266_socket_link_t *link = &s_socket.links[link_id];
+    const uint32_t tail = link->tail;
+    const uint32_t available = link->head - tail;
+    const size_t count = (size < available) ? size : (size_t)available;
+
+    const uint32_t offset = tail & ESP8266_SOCKET_RING_MASK;
+    const size_t first = ((ESP8266_SOCKET_RX_RING_SIZE - offset) < count)
+                       ? (size_t)(ESP8266_SOCKET_RX_RING_SIZE - offset)
+                       : count;
+    uint8_t *out = (uint8_t *)buffer;
+    memcpy(out, &link->ring[offset], first);
+    memcpy(&out[first], &link->ring[0], count - first);
+
+    link->tail = tail + (uint32_t)count;
+    return count;
+}
+
+size_t esp8266_socket_available(uint8_t link_id)
+{
+    if (link_id >= ESP8266_SOCKET_MAX_LINKS)
+    {
+        return 0U;
+    }
+    return (size_t)(s_socket.links[link_id].head - s_socket.links[link_id].tail);
+}
+
+esp8266_at_status_t esp8266_socket_close(uint8_t link_id)
+{
+    if (!s_socket.initialised)
+    {
+        return ESP8266_AT_STATUS_NOT_INITIALISED;
+    }
+    if (link_id >= ESP8266_SOCKET_MAX_LINKS)
+    {
+        return ESP8266_AT_STATUS_INVALID_ARGUMENT;
+    }
+
+    esp8266_at_status_t status = esp8266_socket_flush(ESP8266_AT_DEFAULT_TIMEOUT_MS);
+    if (status != ESP8266_AT_STATUS_OK)
+    {
+        return status;
+    }
+
+    char args[8];
+    (void)snprintf(args, sizeof(args), "%u", (unsigned int)link_id);
+    status = esp8266_at_send_command(ESP8266_AT_CMD_CIPCLOSE,
+                                     ESP8266_AT_COMMAND_MODE_SET,
+                                     args,
+                                     ESP8266_AT_DEFAULT_TIMEOUT_MS,
+                                     false);
+    s_socket.links[link_id].state = ESP8266_SOCKET_STATE_CLOSED;
+    return status;
+}
+
+esp8266_socket_state_t esp8266_socket_get_state(uint8_t link_id)
+{
+    if (link_id >= ESP8266_SOCKET_MAX_LINKS)
+    {
+        return ESP8266_SOCKET_STATE_CLOSED;
+    }
+    return s_socket.links[link_id].state;
+}
+
+uint32_t esp8266_socket_rx_overflow(uint8_t link_id)
+{
+    if (link_id >= ESP8266_SOCKET_MAX_LINKS)
+    {
+        return 0U;
+    }
+    return s_socket.links[link_id].overflow;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file driver_esp8266_socket.h
+ * @brief Socket-style multi-link TCP/UDP API on top of the ESP8266 AT driver.
+ *
+ * Runs the modem in CIPMUX=1 mode. "+IPD,<link>,<len>:" data is counted in
+ * binary by the AT core and copied straight into a per-link receive ring, so
+ * payloads may contain CR/LF/NUL and may be longer than a text line.
+ * Sends are pipelined: esp8266_socket_send() returns once a chunk has been
+ * handed to the modem and only waits for its "SEND OK" before the next
+ * AT command goes out.
+ */
+#ifndef DRIVER_ESP8266_SOCKET_H
+#define DRIVER_ESP8266_SOCKET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "driver_esp8266_at.h"
+
+#define ESP8266_SOCKET_MAX_LINKS        5U
+/* Per-link receive ring; keep it above one TCP segment (1460 bytes). */
+#ifndef ESP8266_SOCKET_RX_RING_SIZE
+#define ESP8266_SOCKET_RX_RING_SIZE     2048U
+#endif
+/* Bounded by the 1 KB DMA buffer of the interface layer and AT+CIPSEND's 2048 limit. */
+#ifndef ESP8266_SOCKET_TX_CHUNK_SIZE
+#define ESP8266_SOCKET_TX_CHUNK_SIZE    1024U
+#endif
+
+#if (ESP8266_SOCKET_RX_RING_SIZE & (ESP8266_SOCKET_RX_RING_SIZE - 1U)) != 0U
+#error "ESP8266_SOCKET_RX_RING_SIZE must be a power of two"
+#endif
+
+typedef enum
+{
+    ESP8266_SOCKET_STATE_CLOSED = 0,
+    ESP8266_SOCKET_STATE_CONNECTING,
+    ESP8266_SOCKET_STATE_CONNECTED
+} esp8266_socket_state_t;
+
+typedef enum
+{
+    ESP8266_SOCKET_TCP = 0,
+    ESP8266_SOCKET_UDP
+} esp8266_socket_type_t;
+
+/** Must be called after esp8266_at_init(); switches the modem to CIPMUX=1. */
+esp8266_at_status_t esp8266_socket_init(void);
+void esp8266_socket_deinit(void);
+
+esp8266_at_status_t esp8266_socket_connect(uint8_t link_id,
+                                           esp8266_socket_type_t type,
+                                           const char *host,
+                                           uint16_t port,
+                                           uint32_t timeout_ms);
+esp8266_at_status_t esp8266_socket_send(uint8_t link_id,
+                                        const void *data,
+                                        size_t length,
+                                        uint32_t timeout_ms);
+/** Waits for the "SEND OK" of the last pipelined chunk. */
+esp8266_at_status_t esp8266_socket_flush(uint32_t timeout_ms);
+size_t esp8266_socket_recv(uint8_t link_id, void *buffer, size_t size);
+size_t esp8266_socket_available(uint8_t link_id);
+esp8266_at_status_t esp8266_socket_close(uint8_t link_id);
+
+esp8266_socket_state_t esp8266_socket_get_state(uint8_t link_id);
+/** Bytes discarded because the link's receive ring was full. */
+uint32_t esp8266_socket_rx_overflow(uint8_t link_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRIVER_ESP8266_SOCKET_H */
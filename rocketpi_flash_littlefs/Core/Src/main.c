@@ -23,6 +23,7 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -49,6 +50,7 @@
 
 /* USER CODE BEGIN PV */
 static lfs_t g_lfs;
+static bool g_lfs_mounted;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -123,6 +125,15 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+    /* Nothing else runs in this demo, so spend the idle time pre-erasing sectors */
+    if (g_lfs_mounted) {
+      int idle = lfs_port_idle(&g_lfs);
+      if (idle < 0) {
+        LittleFS_LogError("LittleFS: idle maintenance failed", idle);
+        lfs_port_unmount(&g_lfs);
+        g_lfs_mounted = false;
+      }
+    }
   }
   /* USER CODE END 3 */
 }
@@ -242,7 +253,8 @@ static void LittleFS_Test(void)
     LittleFS_Log(log_buffer);
   }
 
-  lfs_port_unmount(&g_lfs);
+  /* Stay mounted so the main loop can run lfs_port_idle() */
+  g_lfs_mounted = true;
 }
 /* USER CODE END 4 */
 
@@ -104,8 +104,7 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
-    aht30_test_log_measurement();
-    HAL_Delay(1000);
+    aht30_test_async_poll(1000U);
   }
   /* USER CODE END 3 */
 }
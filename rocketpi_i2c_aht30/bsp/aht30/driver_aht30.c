@@ -4,6 +4,8 @@
 
 #include <stddef.h>
 
+#include "i2c_async.h"
+
 #if AHT30_USE_SOFT_I2C
 #include "soft_i2c.h"
 #include "gpio.h"
@@ -22,6 +24,24 @@
 #define AHT30_CMD_RESET         0xBAU
 #define AHT30_STATUS_BUSY       0x80U
 
+/* 异步测量状态：中断回调只推进状态，转换与用户回调在 aht30_async_process() 中完成 */
+typedef enum {
+    AHT30_ASYNC_IDLE = 0,
+    AHT30_ASYNC_TRIGGER,    /* 触发命令传输中 */
+    AHT30_ASYNC_WAIT,       /* 等待测量转换完成 */
+    AHT30_ASYNC_READ,       /* 读取6字节结果中 */
+    AHT30_ASYNC_DONE        /* 结果待交付 */
+} aht30_async_state_t;
+
+static i2c_async_bus_t s_async_bus;
+static volatile aht30_async_state_t s_async_state = AHT30_ASYNC_IDLE;
+static volatile HAL_StatusTypeDef s_async_status = HAL_OK;
+static volatile uint32_t s_async_trigger_tick = 0U;
+static aht30_async_callback_t s_async_callback = NULL;
+static void *s_async_ctx = NULL;
+static const uint8_t s_async_cmd[3] = {AHT30_CMD_TRIGGER, AHT30_CMD_CONFIG_0, AHT30_CMD_CONFIG_1};
+static uint8_t s_async_raw[6];
+
 #if AHT30_USE_SOFT_I2C
 
 typedef struct {
@@ -96,6 +116,45 @@ static HAL_StatusTypeDef aht30_bus_receive(uint8_t *data, size_t size)
     return (status == SOFT_I2C_STATUS_OK) ? HAL_OK : HAL_ERROR;
 }
 
+/* TIM10 直接按寄存器配置为周期更新中断，作为异步软件I2C的节拍源 */
+static void aht30_async_timer_start(void)
+{
+    AHT30_ASYNC_TIM->CNT = 0U;
+    AHT30_ASYNC_TIM->SR = 0U;
+    AHT30_ASYNC_TIM->CR1 |= TIM_CR1_CEN;
+}
+
+static void aht30_async_timer_stop(void)
+{
+    AHT30_ASYNC_TIM->CR1 &= ~TIM_CR1_CEN;
+}
+
+static HAL_StatusTypeDef aht30_async_bus_init(void)
+{
+    __HAL_RCC_TIM10_CLK_ENABLE();
+    /* APB2 不分频，定时器时钟等于 PCLK2；预分频到 1MHz 后按微秒设置节拍 */
+    AHT30_ASYNC_TIM->CR1 = 0U;
+    AHT30_ASYNC_TIM->PSC = (HAL_RCC_GetPCLK2Freq() / 1000000U) - 1U;
+    AHT30_ASYNC_TIM->ARR = AHT30_ASYNC_TICK_US - 1U;
+    AHT30_ASYNC_TIM->EGR = TIM_EGR_UG;
+    AHT30_ASYNC_TIM->SR = 0U;
+    AHT30_ASYNC_TIM->DIER = TIM_DIER_UIE;
+    HAL_NVIC_SetPriority(AHT30_ASYNC_TIM_IRQn, 1, 0);
+    HAL_NVIC_EnableIRQ(AHT30_ASYNC_TIM_IRQn);
+
+    i2c_async_status_t status = i2c_async_init_soft(&s_async_bus, &s_aht30_bus.scl, &s_aht30_bus.sda,
+                                                    aht30_async_timer_start, aht30_async_timer_stop);
+    return (status == I2C_ASYNC_STATUS_OK) ? HAL_OK : HAL_ERROR;
+}
+
+void aht30_async_tick_irq(void)
+{
+    if ((AHT30_ASYNC_TIM->SR & TIM_SR_UIF) != 0U) {
+        AHT30_ASYNC_TIM->SR = (uint32_t)~TIM_SR_UIF;
+        i2c_async_soft_tick(&s_async_bus);
+    }
+}
+
 #else
 
 static HAL_StatusTypeDef aht30_bus_init(void)
@@ -113,6 +172,16 @@ static HAL_StatusTypeDef aht30_bus_receive(uint8_t *data, size_t size)
     return HAL_I2C_Master_Receive(&AHT30_I2C_HANDLE, AHT30_I2C_ADDRESS, data, size, HAL_MAX_DELAY);
 }
 
+static HAL_StatusTypeDef aht30_async_bus_init(void)
+{
+    i2c_async_status_t status = i2c_async_init_hw(&s_async_bus, &AHT30_I2C_HANDLE);
+    return (status == I2C_ASYNC_STATUS_OK) ? HAL_OK : HAL_ERROR;
+}
+
+void aht30_async_tick_irq(void)
+{
+}
+
 #endif /* AHT30_USE_SOFT_I2C */
 
 static HAL_StatusTypeDef aht30_soft_reset(void)
@@ -145,7 +214,12 @@ HAL_StatusTypeDef aht30_init(void)
     HAL_Delay(AHT30_POWER_ON_DELAY);
     status = aht30_soft_reset();
     HAL_Delay(AHT30_POST_RESET_DELAY);
-    return status;
+    if (status != HAL_OK) {
+        return status;
+    }
+
+    s_async_state = AHT30_ASYNC_IDLE;
+    return aht30_async_bus_init();
 }
 
 HAL_StatusTypeDef aht30_read_raw(uint8_t raw[6])
@@ -184,3 +258,95 @@ HAL_StatusTypeDef aht30_read(float *temperature_c, float *humidity_pct)
     aht30_convert_samples(raw, temperature_c, humidity_pct);
     return HAL_OK;
 }
+
+static HAL_StatusTypeDef aht30_async_to_hal(i2c_async_status_t status)
+{
+    if (status == I2C_ASYNC_STATUS_OK) {
+        return HAL_OK;
+    }
+    return (status == I2C_ASYNC_STATUS_TIMEOUT) ? HAL_TIMEOUT : HAL_ERROR;
+}
+
+static void aht30_async_read_done(i2c_async_status_t status, void *ctx)
+{
+    (void)ctx;
+    s_async_status = aht30_async_to_hal(status);
+    s_async_state = AHT30_ASYNC_DONE;
+}
+
+static void aht30_async_trigger_done(i2c_async_status_t status, void *ctx)
+{
+    (void)ctx;
+    if (status != I2C_ASYNC_STATUS_OK) {
+        s_async_status = aht30_async_to_hal(status);
+        s_async_state = AHT30_ASYNC_DONE;
+        return;
+    }
+
+    s_async_trigger_tick = HAL_GetTick();
+    s_async_state = AHT30_ASYNC_WAIT;
+}
+
+HAL_StatusTypeDef aht30_async_start(aht30_async_callback_t callback, void *ctx)
+{
+    if (callback == NULL) {
+        return HAL_ERROR;
+    }
+    if (s_async_state != AHT30_ASYNC_IDLE) {
+        return HAL_BUSY;
+    }
+
+    s_async_callback = callback;
+    s_async_ctx = ctx;
+    s_async_state = AHT30_ASYNC_TRIGGER;
+
+    i2c_async_status_t status = i2c_async_write(&s_async_bus, AHT30_I2C_ADDRESS, s_async_cmd,
+                                                sizeof(s_async_cmd), aht30_async_trigger_done, NULL);
+    if (status != I2C_ASYNC_STATUS_OK) {
+        s_async_state = AHT30_ASYNC_IDLE;
+        return (status == I2C_ASYNC_STATUS_QUEUE_FULL) ? HAL_BUSY : HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+void aht30_async_process(void)
+{
+    if (s_async_state == AHT30_ASYNC_WAIT) {
+        if ((HAL_GetTick() - s_async_trigger_tick) < AHT30_MEASUREMENT_DELAY) {
+            return;
+        }
+
+        s_async_state = AHT30_ASYNC_READ;
+        if (i2c_async_read(&s_async_bus, AHT30_I2C_ADDRESS, s_async_raw, sizeof(s_async_raw),
+                           aht30_async_read_done, NULL) != I2C_ASYNC_STATUS_OK) {
+            /* 队列暂满，下一轮再试 */
+            s_async_state = AHT30_ASYNC_WAIT;
+        }
+        return;
+    }
+
+    if (s_async_state != AHT30_ASYNC_DONE) {
+        return;
+    }
+
+    float temperature = 0.0f;
+    float humidity = 0.0f;
+    HAL_StatusTypeDef status = s_async_status;
+    if ((status == HAL_OK) && ((s_async_raw[0] & AHT30_STATUS_BUSY) != 0U)) {
+        status = HAL_BUSY;
+    }
+    if (status == HAL_OK) {
+        aht30_convert_samples(s_async_raw, &temperature, &humidity);
+    }
+
+    aht30_async_callback_t callback = s_async_callback;
+    void *ctx = s_async_ctx;
+    s_async_state = AHT30_ASYNC_IDLE;
+    callback(status, temperature, humidity, ctx);
+}
+
+uint8_t aht30_async_busy(void)
+{
+    return (s_async_state != AHT30_ASYNC_IDLE) ? 1U : 0U;
+}
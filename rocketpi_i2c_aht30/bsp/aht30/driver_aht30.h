@@ -22,6 +22,29 @@ HAL_StatusTypeDef aht30_init(void);
 HAL_StatusTypeDef aht30_read_raw(uint8_t raw[6]);
 HAL_StatusTypeDef aht30_read(float *temperature_c, float *humidity_pct);
 
+/**
+ * 异步测量完成回调，在 aht30_async_process() 中（主循环上下文）调用。
+ * status 为 HAL_BUSY 表示传感器仍在测量，此时温湿度无效。
+ */
+typedef void (*aht30_async_callback_t)(HAL_StatusTypeDef status, float temperature_c,
+                                       float humidity_pct, void *ctx);
+
+/**
+ * 发起一次非阻塞测量：触发命令与读数均由 i2c_async 队列在中断中完成，
+ * 80ms 转换等待由 aht30_async_process() 基于 HAL_GetTick 判断，不再 HAL_Delay。
+ * 需先调用 aht30_init()，且不要与阻塞接口同时使用。
+ */
+HAL_StatusTypeDef aht30_async_start(aht30_async_callback_t callback, void *ctx);
+
+/** 在主循环中周期调用，推进等待/读取并交付结果。 */
+void aht30_async_process(void);
+
+/** 异步测量进行中返回1。 */
+uint8_t aht30_async_busy(void);
+
+/** 软件I2C节拍定时器中断入口，放在 TIM1_UP_TIM10_IRQHandler 中调用。 */
+void aht30_async_tick_irq(void);
+
 #ifdef __cplusplus
 }
 #endif
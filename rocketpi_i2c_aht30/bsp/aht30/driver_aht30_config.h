@@ -37,6 +37,18 @@
 #define AHT30_SOFT_STRETCH_TICKS 8000U
 #endif
 
+#ifndef AHT30_ASYNC_TIM
+#define AHT30_ASYNC_TIM TIM10                   /**< 异步软件I2C节拍定时器。 */
+#endif
+
+#ifndef AHT30_ASYNC_TIM_IRQn
+#define AHT30_ASYNC_TIM_IRQn TIM1_UP_TIM10_IRQn
+#endif
+
+#ifndef AHT30_ASYNC_TICK_US
+#define AHT30_ASYNC_TICK_US 10U                 /**< 节拍周期（微秒），每位占2拍，10us约为50kHz SCL。 */
+#endif
+
 #else
 
 #include "i2c.h"
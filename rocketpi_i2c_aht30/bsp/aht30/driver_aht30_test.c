@@ -43,6 +43,49 @@ HAL_StatusTypeDef aht30_test_log_measurement(void)
     return status;
 }
 
+/**
+ * @brief 异步测量完成回调：与同步版本相同的格式输出结果。
+ */
+static void aht30_test_async_done(HAL_StatusTypeDef status, float temperature, float humidity, void *ctx)
+{
+    (void)ctx;
+    if (status == HAL_OK) {
+        int16_t temp10 = (int16_t)(temperature * 10.0f);
+        uint16_t hum10 = (uint16_t)(humidity * 10.0f);
+        printf("AHT30 -> T=%d.%01dC  RH=%d.%01d%%\r\n",
+               temp10 / 10, abs(temp10 % 10),
+               hum10 / 10, hum10 % 10);
+    } else if (status == HAL_BUSY) {
+        printf("AHT30 measurement busy\r\n");
+    } else {
+        aht30_test_print_status("async", status);
+    }
+}
+
+/**
+ * @brief 主循环轮询入口：按周期发起异步测量并推进状态机，不会阻塞。
+ * @param period_ms 两次测量之间的间隔（毫秒）。
+ */
+void aht30_test_async_poll(uint32_t period_ms)
+{
+    static uint32_t last_start = 0U;
+    static uint8_t started = 0U;
+
+    aht30_async_process();
+
+    if ((aht30_async_busy() == 0U) &&
+        ((started == 0U) || ((HAL_GetTick() - last_start) >= period_ms))) {
+        HAL_StatusTypeDef status = aht30_async_start(aht30_test_async_done, NULL);
+        if (status == HAL_OK) {
+            last_start = HAL_GetTick();
+            started = 1U;
+        } else if (status != HAL_BUSY) {
+            aht30_test_print_status("start", status);
+            last_start = HAL_GetTick();
+        }
+    }
+}
+
 /**
  * @brief 读取6字节原始数据并打印，便于调试。
  * @return 成功捕获数据返回HAL_OK，设备仍在测量时返回HAL_BUSY，否则返回HAL错误码。
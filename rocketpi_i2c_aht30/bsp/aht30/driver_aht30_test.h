@@ -24,6 +24,12 @@ HAL_StatusTypeDef aht30_test_log_measurement(void);
  */
 HAL_StatusTypeDef aht30_test_log_raw(void);
 
+/**
+ * @brief 在主循环中调用：周期性发起异步测量并在完成时打印结果，不阻塞CPU。
+ * @param period_ms 测量周期（毫秒）。
+ */
+void aht30_test_async_poll(uint32_t period_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,8 @@
 /* USER CODE BEGIN Includes */
 #include "driver_at24cxx.h"
 #include "driver_at24cxx_read_test.h"
+#include "driver_at24cxx_async.h"
+#include "kvstore_port.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -45,7 +47,11 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-
+static uint8_t s_async_buf[16];
+static volatile uint8_t s_async_done = 0U;
+static volatile uint8_t s_async_status = 0U;
+static kvstore_t s_kv;
+static kvstore_backend_t s_kv_backend;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -56,7 +62,39 @@ void SystemClock_Config(void);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+static void at24cxx_async_read_done(uint8_t status, void *ctx)
+{
+  (void)ctx;
+  s_async_status = status;
+  s_async_done = 1U;
+}
+
+/* 挂载键值存储并累加上电次数；读写测试会改写整片 EEPROM，因此演示放在片内 Flash 上，
+   EEPROM 后端可用 kvstore_port_at24cxx_init(&s_kv_backend, AT24C02, AT24CXX_ADDRESS_A000, 0U, 128U, 2U) */
+static void kvstore_boot_count(void)
+{
+  uint32_t boot = 0U;
+  kvstore_stats_t stats;
+
+  kvstore_port_flash_init(&s_kv_backend);
+  if (kvstore_mount(&s_kv, &s_kv_backend) != KVSTORE_OK)
+  {
+    at24cxx_interface_debug_print("kvstore: mount failed.\n");
+    return;
+  }
 
+  (void)kvstore_get(&s_kv, "boot", &boot, sizeof(boot), NULL);
+  boot++;
+  if (kvstore_set(&s_kv, "boot", &boot, sizeof(boot)) != KVSTORE_OK)
+  {
+    at24cxx_interface_debug_print("kvstore: set failed.\n");
+    return;
+  }
+
+  kvstore_get_stats(&s_kv, &stats);
+  at24cxx_interface_debug_print("kvstore: boot %u, keys %u, free %u bytes.\n",
+                                (unsigned)boot, (unsigned)stats.live_keys, (unsigned)stats.free_bytes);
+}
 /* USER CODE END 0 */
 
 /**
@@ -92,6 +130,14 @@ int main(void)
   /* USER CODE BEGIN 2 */
 
   at24cxx_read_test(AT24C02, AT24CXX_ADDRESS_A000);
+  kvstore_boot_count();
+
+  /* 异步读：请求排队后立即返回，由 TIM10 中断推进软件I2C */
+  if ((at24cxx_async_init(AT24C02, AT24CXX_ADDRESS_A000) != 0U) ||
+      (at24cxx_async_read(0x00U, s_async_buf, sizeof(s_async_buf), at24cxx_async_read_done, NULL) != 0U))
+  {
+    at24cxx_interface_debug_print("at24cxx: async read submit failed.\n");
+  }
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -101,6 +147,19 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+    if (s_async_done != 0U)
+    {
+      s_async_done = 0U;
+      if (s_async_status == 0U)
+      {
+        at24cxx_interface_debug_print("at24cxx: async read 0x00: %02X %02X %02X %02X ...\n",
+                                      s_async_buf[0], s_async_buf[1], s_async_buf[2], s_async_buf[3]);
+      }
+      else
+      {
+        at24cxx_interface_debug_print("at24cxx: async read failed.\n");
+      }
+    }
   }
   /* USER CODE END 3 */
 }
@@ -22,6 +22,7 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "driver_at24cxx_async.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -199,5 +200,11 @@ void SysTick_Handler(void)
 /******************************************************************************/
 
 /* USER CODE BEGIN 1 */
-
+/**
+  * @brief TIM10 更新中断：异步软件I2C节拍（TIM10 由 driver_at24cxx_async 按寄存器配置）。
+  */
+void TIM1_UP_TIM10_IRQHandler(void)
+{
+  at24cxx_async_tick_irq();
+}
 /* USER CODE END 1 */
@@ -0,0 +1,290 @@
+/**
+ * @file      driver_at24cxx_async.c
+ * @brief     基于 i2c_async 队列的 AT24Cxx 非阻塞读写实现。
+ */
+
+#include "driver_at24cxx_async.h"
+
+#include "i2c_async.h"
+#include "main.h"
+
+#include <string.h>
+
+#define AT24CXX_ASYNC_TIM          TIM10
+#define AT24CXX_ASYNC_TIM_IRQn     TIM1_UP_TIM10_IRQn
+#define AT24CXX_ASYNC_BASE_ADDR    0xA0U
+
+/**
+ * @brief 请求池条目：保存地址前缀/写数据与用户回调，完成后释放。
+ */
+typedef struct
+{
+    uint8_t in_use;
+    at24cxx_async_callback_t callback;
+    void *ctx;
+    uint8_t tx[2U + AT24CXX_ASYNC_PAGE_MAX];
+} at24cxx_async_request_t;
+
+static i2c_async_bus_t s_bus;
+static at24cxx_async_request_t s_requests[I2C_ASYNC_QUEUE_DEPTH];
+static uint32_t s_size = 0U;
+static uint16_t s_page_size = 0U;
+static uint8_t s_iic_addr = 0U;
+
+static soft_i2c_status_t at24cxx_async_scl_write(void *ctx, soft_i2c_pin_state_t state)
+{
+    (void)ctx;
+    HAL_GPIO_WritePin(AT24CXX_SCL_GPIO_Port, AT24CXX_SCL_Pin,
+                      (state == SOFT_I2C_PIN_SET) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+
+    return SOFT_I2C_STATUS_OK;
+}
+
+static soft_i2c_pin_state_t at24cxx_async_scl_read(void *ctx)
+{
+    (void)ctx;
+    return (HAL_GPIO_ReadPin(AT24CXX_SCL_GPIO_Port, AT24CXX_SCL_Pin) == GPIO_PIN_SET)
+               ? SOFT_I2C_PIN_SET
+               : SOFT_I2C_PIN_RESET;
+}
+
+static soft_i2c_status_t at24cxx_async_sda_write(void *ctx, soft_i2c_pin_state_t state)
+{
+    (void)ctx;
+    HAL_GPIO_WritePin(AT24CXX_SDA_GPIO_Port, AT24CXX_SDA_Pin,
+                      (state == SOFT_I2C_PIN_SET) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+
+    return SOFT_I2C_STATUS_OK;
+}
+
+static soft_i2c_pin_state_t at24cxx_async_sda_read(void *ctx)
+{
+    (void)ctx;
+    return (HAL_GPIO_ReadPin(AT24CXX_SDA_GPIO_Port, AT24CXX_SDA_Pin) == GPIO_PIN_SET)
+               ? SOFT_I2C_PIN_SET
+               : SOFT_I2C_PIN_RESET;
+}
+
+static void at24cxx_async_timer_start(void)
+{
+    AT24CXX_ASYNC_TIM->CNT = 0U;
+    AT24CXX_ASYNC_TIM->SR = 0U;
+    AT24CXX_ASYNC_TIM->CR1 |= TIM_CR1_CEN;
+}
+
+static void at24cxx_async_timer_stop(void)
+{
+    AT24CXX_ASYNC_TIM->CR1 &= ~TIM_CR1_CEN;
+}
+
+static uint16_t at24cxx_async_page_size(at24cxx_t type)
+{
+    if (type <= AT24C02)
+    {
+        return 8U;
+    }
+    if (type <= AT24C16)
+    {
+        return 16U;
+    }
+    if (type <= AT24C64)
+    {
+        return 32U;
+    }
+    if (type <= AT24C256)
+    {
+        return 64U;
+    }
+    if (type <= AT24C512)
+    {
+        return 128U;
+    }
+
+    return 256U;
+}
+
+/**
+ * @brief 按 libdriver 的规则拼出器件地址与字地址前缀
+ * @return 前缀长度（1 或 2 字节）
+ */
+static uint8_t at24cxx_async_prefix(uint32_t address, uint8_t *dev, uint8_t *prefix)
+{
+    if (s_size > (uint32_t)AT24C16)
+    {
+        *dev = (uint8_t)(s_iic_addr + ((address / 65536U) << 1));
+        prefix[0] = (uint8_t)((address % 65536U) >> 8);
+        prefix[1] = (uint8_t)(address & 0xFFU);
+        return 2U;
+    }
+
+    *dev = (uint8_t)(s_iic_addr + ((address / 256U) << 1));
+    prefix[0] = (uint8_t)(address % 256U);
+    return 1U;
+}
+
+static at24cxx_async_request_t *at24cxx_async_alloc(at24cxx_async_callback_t callback, void *ctx)
+{
+    at24cxx_async_request_t *request = NULL;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    for (uint32_t i = 0U; i < I2C_ASYNC_QUEUE_DEPTH; ++i)
+    {
+        if (s_requests[i].in_use == 0U)
+        {
+            request = &s_requests[i];
+            request->in_use = 1U;
+            request->callback = callback;
+            request->ctx = ctx;
+            break;
+        }
+    }
+    __set_PRIMASK(primask);
+
+    return request;
+}
+
+static void at24cxx_async_done(i2c_async_status_t status, void *ctx)
+{
+    at24cxx_async_request_t *request = (at24cxx_async_request_t *)ctx;
+    at24cxx_async_callback_t callback = request->callback;
+    void *user_ctx = request->ctx;
+
+    request->in_use = 0U;
+    if (callback != NULL)
+    {
+        callback((status == I2C_ASYNC_STATUS_OK) ? 0U : 1U, user_ctx);
+    }
+}
+
+static uint8_t at24cxx_async_submit(at24cxx_async_request_t *request, const i2c_async_job_t *job)
+{
+    i2c_async_status_t status = i2c_async_submit(&s_bus, job);
+
+    if (status != I2C_ASYNC_STATUS_OK)
+    {
+        request->in_use = 0U;
+        return (status == I2C_ASYNC_STATUS_QUEUE_FULL) ? 2U : 1U;
+    }
+
+    return 0U;
+}
+
+/**
+ * @brief 初始化引脚、TIM10 节拍与异步总线
+ */
+uint8_t at24cxx_async_init(at24cxx_t type, at24cxx_address_t address)
+{
+    GPIO_InitTypeDef init = {0};
+    const soft_i2c_pin_io_t scl = {at24cxx_async_scl_write, at24cxx_async_scl_read, NULL};
+    const soft_i2c_pin_io_t sda = {at24cxx_async_sda_write, at24cxx_async_sda_read, NULL};
+
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    init.Pin = AT24CXX_SCL_Pin;
+    init.Mode = GPIO_MODE_OUTPUT_OD;
+    init.Pull = GPIO_PULLUP;
+    init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    HAL_GPIO_Init(AT24CXX_SCL_GPIO_Port, &init);
+    init.Pin = AT24CXX_SDA_Pin;
+    HAL_GPIO_Init(AT24CXX_SDA_GPIO_Port, &init);
+
+    /* TIM10 挂在 APB2（不分频），预分频到 1MHz 后按微秒设置节拍 */
+    __HAL_RCC_TIM10_CLK_ENABLE();
+    AT24CXX_ASYNC_TIM->CR1 = 0U;
+    AT24CXX_ASYNC_TIM->PSC = (HAL_RCC_GetPCLK2Freq() / 1000000U) - 1U;
+    AT24CXX_ASYNC_TIM->ARR = AT24CXX_ASYNC_TICK_US - 1U;
+    AT24CXX_ASYNC_TIM->EGR = TIM_EGR_UG;
+    AT24CXX_ASYNC_TIM->SR = 0U;
+    AT24CXX_ASYNC_TIM->DIER = TIM_DIER_UIE;
+    HAL_NVIC_SetPriority(AT24CXX_ASYNC_TIM_IRQn, 1, 0);
+    HAL_NVIC_EnableIRQ(AT24CXX_ASYNC_TIM_IRQn);
+
+    memset(s_requests, 0, sizeof(s_requests));
+    s_size = (uint32_t)type;
+    s_page_size = at24cxx_async_page_size(type);
+    s_iic_addr = (uint8_t)(AT24CXX_ASYNC_BASE_ADDR | ((uint8_t)address << 1));
+
+    return (i2c_async_init_soft(&s_bus, &scl, &sda, at24cxx_async_timer_start,
+                                at24cxx_async_timer_stop) == I2C_ASYNC_STATUS_OK) ? 0U : 1U;
+}
+
+/**
+ * @brief 提交一次顺序读
+ */
+uint8_t at24cxx_async_read(uint32_t address, uint8_t *buf, uint16_t len,
+                           at24cxx_async_callback_t callback, void *ctx)
+{
+    uint32_t block = (s_size > (uint32_t)AT24C16) ? 65536U : 256U;
+
+    if ((s_size == 0U) || (buf == NULL) || (len == 0U) || ((address + len) > s_size) ||
+        ((address / block) != ((address + len - 1U) / block)))
+    {
+        return 1U;
+    }
+
+    at24cxx_async_request_t *request = at24cxx_async_alloc(callback, ctx);
+    if (request == NULL)
+    {
+        return 2U;
+    }
+
+    i2c_async_job_t job = {0};
+    job.tx = request->tx;
+    job.tx_len = at24cxx_async_prefix(address, &job.address, request->tx);
+    job.rx = buf;
+    job.rx_len = len;
+    job.callback = at24cxx_async_done;
+    job.ctx = request;
+
+    return at24cxx_async_submit(request, &job);
+}
+
+/**
+ * @brief 提交一次页写
+ */
+uint8_t at24cxx_async_write_page(uint32_t address, const uint8_t *buf, uint16_t len,
+                                 at24cxx_async_callback_t callback, void *ctx)
+{
+    if ((s_size == 0U) || (buf == NULL) || (len == 0U) || (len > AT24CXX_ASYNC_PAGE_MAX) ||
+        ((address + len) > s_size) ||
+        ((address / s_page_size) != ((address + len - 1U) / s_page_size)))
+    {
+        return 1U;
+    }
+
+    at24cxx_async_request_t *request = at24cxx_async_alloc(callback, ctx);
+    if (request == NULL)
+    {
+        return 2U;
+    }
+
+    i2c_async_job_t job = {0};
+    uint8_t prefix_len = at24cxx_async_prefix(address, &job.address, request->tx);
+    memcpy(&request->tx[prefix_len], buf, len);
+    job.tx = request->tx;
+    job.tx_len = (uint16_t)(prefix_len + len);
+    job.callback = at24cxx_async_done;
+    job.ctx = request;
+
+    return at24cxx_async_submit(request, &job);
+}
+
+/**
+ * @brief 查询队列是否已全部完成
+ */
+uint8_t at24cxx_async_is_idle(void)
+{
+    return i2c_async_is_idle(&s_bus);
+}
+
+/**
+ * @brief 节拍定时器中断入口
+ */
+void at24cxx_async_tick_irq(void)
+{
+    if ((AT24CXX_ASYNC_TIM->SR & TIM_SR_UIF) != 0U)
+    {
+        AT24CXX_ASYNC_TIM->SR = (uint32_t)~TIM_SR_UIF;
+        i2c_async_soft_tick(&s_bus);
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * @file      driver_at24cxx_async.h
+ * @brief     基于 i2c_async 队列的 AT24Cxx 非阻塞读写接口。
+ *
+ * 软件I2C由 TIM10 更新中断逐相位推进，读写请求排队后立即返回，完成时在
+ * 中断上下文中调用回调。写入仅覆盖单页，写后器件进入内部擦写周期（tWR），
+ * 期间的访问会被NACK，调用者需自行等待或重试。
+ */
+
+#ifndef DRIVER_AT24CXX_ASYNC_H
+#define DRIVER_AT24CXX_ASYNC_H
+
+#include "driver_at24cxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief 单次写入允许的最大页长（字节），决定请求池的静态缓冲大小。
+ */
+#ifndef AT24CXX_ASYNC_PAGE_MAX
+#define AT24CXX_ASYNC_PAGE_MAX    64U
+#endif
+
+/**
+ * @brief 软件I2C节拍周期（微秒），每位占2拍，10us 约为 50kHz SCL。
+ */
+#ifndef AT24CXX_ASYNC_TICK_US
+#define AT24CXX_ASYNC_TICK_US     10U
+#endif
+
+/**
+ * @brief 异步请求完成回调（中断上下文）。
+ * @param status 0 成功，1 NACK/超时
+ * @param ctx    提交时传入的用户参数
+ */
+typedef void (*at24cxx_async_callback_t)(uint8_t status, void *ctx);
+
+/**
+ * @brief     初始化引脚、TIM10 节拍与异步总线
+ * @param[in] type 芯片型号
+ * @param[in] address A2A1A0 地址引脚
+ * @return    状态码
+ *            - 0 成功
+ *            - 1 初始化失败
+ */
+uint8_t at24cxx_async_init(at24cxx_t type, at24cxx_address_t address);
+
+/**
+ * @brief      提交一次顺序读（先写地址后重复起始读）
+ * @param[in]  address 存储地址
+ * @param[out] *buf 接收缓冲，回调前必须保持有效
+ * @param[in]  len 读取长度，不可跨越器件地址块（<=AT24C16 为 256 字节，其余为 64K）
+ * @param[in]  callback 完成回调，可为 NULL
+ * @param[in]  ctx 用户参数
+ * @return     状态码
+ *             - 0 已排队
+ *             - 1 参数非法或未初始化
+ *             - 2 队列已满
+ */
+uint8_t at24cxx_async_read(uint32_t address, uint8_t *buf, uint16_t len,
+                           at24cxx_async_callback_t callback, void *ctx);
+
+/**
+ * @brief     提交一次页写，数据会被复制进请求池，调用后即可复用 buf
+ * @param[in] address 存储地址
+ * @param[in] *buf 待写数据
+ * @param[in] len 写入长度，不可跨页且不超过 AT24CXX_ASYNC_PAGE_MAX
+ * @param[in] callback 完成回调，可为 NULL
+ * @param[in] ctx 用户参数
+ * @return    状态码
+ *            - 0 已排队
+ *            - 1 参数非法或未初始化
+ *            - 2 队列已满
+ */
+uint8_t at24cxx_async_write_page(uint32_t address, const uint8_t *buf, uint16_t len,
+                                 at24cxx_async_callback_t callback, void *ctx);
+
+/**
+ * @brief  查询队列是否已全部完成
+ * @return 空闲返回 1，否则返回 0
+ */
+uint8_t at24cxx_async_is_idle(void);
+
+/**
+ * @brief 节拍定时器中断入口，放在 TIM1_UP_TIM10_IRQHandler 中调用
+ */
+void at24cxx_async_tick_irq(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,370 @@
+/**
+ * @file      driver_at24cxx_fast.c
+ * @brief     AT24Cxx 快速读写路径实现。
+ */
+
+#include "driver_at24cxx_fast.h"
+
+#include <string.h>
+
+/**
+ * @brief 芯片真实页长，超过 AT24CXX_FAST_PAGE_MAX 时按上限分段（页长均为 2 的幂，可整除）
+ */
+static uint16_t at24cxx_fast_page_size(uint32_t id)
+{
+    uint16_t page;
+
+    if (id <= (uint32_t)AT24C02)
+    {
+        page = 8U;
+    }
+    else if (id <= (uint32_t)AT24C16)
+    {
+        page = 16U;
+    }
+    else if (id <= (uint32_t)AT24C64)
+    {
+        page = 32U;
+    }
+    else if (id <= (uint32_t)AT24C256)
+    {
+        page = 64U;
+    }
+    else if (id <= (uint32_t)AT24C512)
+    {
+        page = 128U;
+    }
+    else
+    {
+        page = 256U;
+    }
+
+    return (page > AT24CXX_FAST_PAGE_MAX) ? (uint16_t)AT24CXX_FAST_PAGE_MAX : page;
+}
+
+/**
+ * @brief 器件地址块大小：高位地址编码在器件地址中，顺序读不能跨块
+ */
+static uint32_t at24cxx_fast_block_size(const at24cxx_handle_t *dev)
+{
+    return (dev->id > (uint32_t)AT24C16) ? 65536U : 256U;
+}
+
+static uint8_t at24cxx_fast_dev_addr(const at24cxx_handle_t *dev, uint32_t address)
+{
+    return (uint8_t)(dev->iic_addr + ((address / at24cxx_fast_block_size(dev)) << 1));
+}
+
+static uint8_t at24cxx_fast_bus_read(at24cxx_handle_t *dev, uint32_t address, uint8_t *buf, uint16_t len)
+{
+    uint8_t addr = at24cxx_fast_dev_addr(dev, address);
+
+    if (dev->id > (uint32_t)AT24C16)
+    {
+        return dev->iic_read_address16(addr, (uint16_t)(address % 65536U), buf, len);
+    }
+
+    return dev->iic_read(addr, (uint8_t)(address % 256U), buf, len);
+}
+
+/**
+ * @brief 写一页（调用者保证不跨页），记录待轮询的器件地址
+ */
+static uint8_t at24cxx_fast_bus_write_page(at24cxx_fast_handle_t *handle, uint32_t address,
+                                           const uint8_t *buf, uint16_t len)
+{
+    at24cxx_handle_t *dev = handle->dev;
+    uint8_t addr = at24cxx_fast_dev_addr(dev, address);
+    uint8_t res;
+
+    if (at24cxx_fast_wait_ready(handle) != 0)
+    {
+        return 1;
+    }
+
+    if (dev->id > (uint32_t)AT24C16)
+    {
+        res = dev->iic_write_address16(addr, (uint16_t)(address % 65536U), (uint8_t *)buf, len);
+    }
+    else
+    {
+        res = dev->iic_write(addr, (uint8_t)(address % 256U), (uint8_t *)buf, len);
+    }
+    if (res != 0)
+    {
+        dev->debug_print("at24cxx: fast write failed.\n");
+
+        return 1;
+    }
+
+    handle->write_pending = 1;
+    handle->pending_addr = addr;
+
+    return 0;
+}
+
+/**
+ * @brief 初始化快速路径
+ */
+uint8_t at24cxx_fast_init(at24cxx_fast_handle_t *handle, at24cxx_handle_t *dev,
+                          uint8_t (*iic_probe)(uint8_t addr))
+{
+    if ((handle == NULL) || (dev == NULL) || (iic_probe == NULL))
+    {
+        return 2;
+    }
+    if (dev->inited != 1)
+    {
+        return 3;
+    }
+
+    memset(handle, 0, sizeof(*handle));
+    handle->dev = dev;
+    handle->iic_probe = iic_probe;
+    handle->page_size = at24cxx_fast_page_size(dev->id);
+
+    return 0;
+}
+
+/**
+ * @brief 等待上一页写周期结束
+ */
+uint8_t at24cxx_fast_wait_ready(at24cxx_fast_handle_t *handle)
+{
+    uint32_t waited_ms = 0U;
+    uint32_t burst = 0U;
+
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    if (handle->write_pending == 0U)
+    {
+        return 0;
+    }
+
+    /* 擦写期间器件不应答地址，首次 ACK 即表示写入完成 */
+    while (handle->iic_probe(handle->pending_addr) != 0)
+    {
+        handle->poll_count++;
+        if (burst < AT24CXX_FAST_POLL_BURST)
+        {
+            burst++;
+            continue;
+        }
+        if (waited_ms >= AT24CXX_FAST_TWR_MAX_MS)
+        {
+            handle->dev->debug_print("at24cxx: write cycle timeout.\n");
+
+            return 1;
+        }
+        handle->dev->delay_ms(1);
+        waited_ms++;
+    }
+    handle->write_pending = 0U;
+
+    return 0;
+}
+
+/**
+ * @brief 顺序读
+ */
+uint8_t at24cxx_fast_read(at24cxx_fast_handle_t *handle, uint32_t address, uint8_t *buf, uint16_t len)
+{
+    uint32_t start = address;
+    uint8_t *out = buf;
+    uint16_t remain = len;
+
+    if ((handle == NULL) || (buf == NULL))
+    {
+        return 2;
+    }
+    if ((address + len) > handle->dev->id)
+    {
+        handle->dev->debug_print("at24cxx: read out of range.\n");
+
+        return 4;
+    }
+    if (at24cxx_fast_wait_ready(handle) != 0)
+    {
+        return 1;
+    }
+
+    /* 每个器件地址块只需一次起始 */
+    while (remain > 0U)
+    {
+        uint32_t block = at24cxx_fast_block_size(handle->dev);
+        uint32_t chunk = block - (address % block);
+
+        if (chunk > remain)
+        {
+            chunk = remain;
+        }
+        if (at24cxx_fast_bus_read(handle->dev, address, out, (uint16_t)chunk) != 0)
+        {
+            handle->dev->debug_print("at24cxx: fast read failed.\n");
+
+            return 1;
+        }
+        address += chunk;
+        out += chunk;
+        remain = (uint16_t)(remain - chunk);
+    }
+
+    /* 叠加缓存中尚未写回的数据 */
+    if ((handle->cache_valid != 0U) && (handle->dirty != 0U))
+    {
+        uint32_t lo = handle->cache_page + handle->dirty_lo;
+        uint32_t hi = handle->cache_page + handle->dirty_hi + 1U;
+        uint32_t end = start + len;
+
+        if ((lo < end) && (hi > start))
+        {
+            uint32_t from = (lo > start) ? lo : start;
+            uint32_t to = (hi < end) ? hi : end;
+
+            memcpy(&buf[from - start], &handle->cache[from - handle->cache_page], to - from);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 按页直接写入
+ */
+uint8_t at24cxx_fast_write(at24cxx_fast_handle_t *handle, uint32_t address, const uint8_t *buf, uint16_t len)
+{
+    if ((handle == NULL) || (buf == NULL))
+    {
+        return 2;
+    }
+    if ((address + len) > handle->dev->id)
+    {
+        handle->dev->debug_print("at24cxx: write out of range.\n");
+
+        return 4;
+    }
+
+    while (len > 0U)
+    {
+        uint16_t chunk = (uint16_t)(handle->page_size - (address % handle->page_size));
+
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+        if (at24cxx_fast_bus_write_page(handle, address, buf, chunk) != 0)
+        {
+            return 1;
+        }
+
+        /* 直接写入覆盖了缓存页时同步缓存，避免写回旧数据 */
+        if ((handle->cache_valid != 0U) &&
+            ((address - (address % handle->page_size)) == handle->cache_page))
+        {
+            memcpy(&handle->cache[address % handle->page_size], buf, chunk);
+        }
+
+        address += chunk;
+        buf += chunk;
+        len = (uint16_t)(len - chunk);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 写回缓存中的脏区间
+ */
+uint8_t at24cxx_fast_flush(at24cxx_fast_handle_t *handle)
+{
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    if ((handle->cache_valid == 0U) || (handle->dirty == 0U))
+    {
+        return 0;
+    }
+
+    if (at24cxx_fast_bus_write_page(handle, handle->cache_page + handle->dirty_lo,
+                                    &handle->cache[handle->dirty_lo],
+                                    (uint16_t)(handle->dirty_hi - handle->dirty_lo + 1U)) != 0)
+    {
+        return 1;
+    }
+    handle->dirty = 0U;
+
+    return 0;
+}
+
+/**
+ * @brief 写入写合并缓存
+ */
+uint8_t at24cxx_fast_cache_write(at24cxx_fast_handle_t *handle, uint32_t address, const uint8_t *buf, uint16_t len)
+{
+    if ((handle == NULL) || (buf == NULL))
+    {
+        return 2;
+    }
+    if ((address + len) > handle->dev->id)
+    {
+        handle->dev->debug_print("at24cxx: write out of range.\n");
+
+        return 4;
+    }
+
+    while (len > 0U)
+    {
+        uint16_t offset = (uint16_t)(address % handle->page_size);
+        uint32_t page = address - offset;
+        uint16_t chunk = (uint16_t)(handle->page_size - offset);
+
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        if ((handle->cache_valid == 0U) || (handle->cache_page != page))
+        {
+            if (at24cxx_fast_flush(handle) != 0)
+            {
+                return 1;
+            }
+            /* 整页载入，使脏区间内未改写的字节也保持器件原值 */
+            handle->cache_valid = 0U;
+            if (at24cxx_fast_read(handle, page, handle->cache, handle->page_size) != 0)
+            {
+                return 1;
+            }
+            handle->cache_page = page;
+            handle->cache_valid = 1U;
+        }
+
+        memcpy(&handle->cache[offset], buf, chunk);
+        if (handle->dirty == 0U)
+        {
+            handle->dirty_lo = offset;
+            handle->dirty_hi = (uint16_t)(offset + chunk - 1U);
+            handle->dirty = 1U;
+        }
+        else
+        {
+            if (offset < handle->dirty_lo)
+            {
+                handle->dirty_lo = offset;
+            }
+            if ((uint16_t)(offset + chunk - 1U) > handle->dirty_hi)
+            {
+                handle->dirty_hi = (uint16_t)(offset + chunk - 1U);
+            }
+        }
+
+        address += chunk;
+        buf += chunk;
+        len = (uint16_t)(len - chunk);
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file      driver_at24cxx_fast.h
+ * @brief     AT24Cxx 快速读写路径：ACK 轮询、跨页顺序读与写合并缓存。
+ *
+ * 与 libdriver 的 at24cxx_read/at24cxx_write 相比：
+ *   1. 读：一次起始即可顺序读完整个器件地址块（<=AT24C16 为 256 字节，
+ *      其余为 64K），不再按 8 字节切分。
+ *   2. 写：按芯片真实页长写入，页写后不再固定 delay_ms(6)，而是在下一次
+ *      访问前以地址探测（ACK 轮询）确认内部擦写周期结束，相邻页可背靠背写入。
+ *   3. 缓存：at24cxx_fast_cache_write() 把零散的小写合并到一页缓存中，
+ *      换页或 at24cxx_fast_flush() 时一次性写回脏区间。
+ */
+
+#ifndef DRIVER_AT24CXX_FAST_H
+#define DRIVER_AT24CXX_FAST_H
+
+#include "driver_at24cxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief 写合并缓存的页长上限，大页器件按此长度对齐分段写入。
+ */
+#ifndef AT24CXX_FAST_PAGE_MAX
+#define AT24CXX_FAST_PAGE_MAX        64U
+#endif
+
+/**
+ * @brief 不插入延时的连续 ACK 轮询次数，超过后每次轮询间隔 1ms。
+ */
+#ifndef AT24CXX_FAST_POLL_BURST
+#define AT24CXX_FAST_POLL_BURST      64U
+#endif
+
+/**
+ * @brief 等待写周期结束的最长时间（毫秒），器件 tWR 典型值 5ms。
+ */
+#ifndef AT24CXX_FAST_TWR_MAX_MS
+#define AT24CXX_FAST_TWR_MAX_MS      10U
+#endif
+
+/**
+ * @brief at24cxx fast handle structure definition
+ */
+typedef struct at24cxx_fast_handle_s
+{
+    at24cxx_handle_t *dev;                  /**< 已 at24cxx_init 的 libdriver 句柄 */
+    uint8_t (*iic_probe)(uint8_t addr);     /**< 仅发送地址字节，ACK 返回 0 */
+    uint16_t page_size;                     /**< 实际使用的页长 */
+    uint8_t write_pending;                  /**< 上一页写入尚未确认完成 */
+    uint8_t pending_addr;                   /**< 待轮询的器件地址 */
+    uint8_t cache_valid;                    /**< 缓存页有效 */
+    uint8_t dirty;                          /**< 缓存存在未写回数据 */
+    uint16_t dirty_lo;                      /**< 脏区间起点（页内偏移） */
+    uint16_t dirty_hi;                      /**< 脏区间终点（页内偏移，含） */
+    uint32_t cache_page;                    /**< 缓存页起始地址 */
+    uint32_t poll_count;                    /**< 累计 ACK 轮询次数，便于评估 tWR */
+    uint8_t cache[AT24CXX_FAST_PAGE_MAX];   /**< 页缓存 */
+} at24cxx_fast_handle_t;
+
+/**
+ * @brief     初始化快速路径
+ * @param[in] *handle 快速路径句柄
+ * @param[in] *dev 已初始化的 libdriver 句柄
+ * @param[in] *iic_probe 地址探测函数（如 at24cxx_interface_iic_probe）
+ * @return    状态码
+ *            - 0 成功
+ *            - 2 参数为空
+ *            - 3 dev 未初始化
+ */
+uint8_t at24cxx_fast_init(at24cxx_fast_handle_t *handle, at24cxx_handle_t *dev,
+                          uint8_t (*iic_probe)(uint8_t addr));
+
+/**
+ * @brief      顺序读，结果包含缓存中尚未写回的数据
+ * @param[in]  *handle 快速路径句柄
+ * @param[in]  address 起始地址
+ * @param[out] *buf 接收缓冲
+ * @param[in]  len 长度
+ * @return     状态码
+ *             - 0 成功
+ *             - 1 读失败或等待写周期超时
+ *             - 2 参数为空
+ *             - 4 地址越界
+ */
+uint8_t at24cxx_fast_read(at24cxx_fast_handle_t *handle, uint32_t address, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     按页直接写入，页间以 ACK 轮询代替固定延时
+ * @param[in] *handle 快速路径句柄
+ * @param[in] address 起始地址
+ * @param[in] *buf 数据
+ * @param[in] len 长度
+ * @return    状态码
+ *            - 0 成功
+ *            - 1 写失败或等待写周期超时
+ *            - 2 参数为空
+ *            - 4 地址越界
+ * @note      返回时最后一页可能仍在内部擦写，下一次访问前会自动等待
+ */
+uint8_t at24cxx_fast_write(at24cxx_fast_handle_t *handle, uint32_t address, const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     写入写合并缓存，仅在换页时写回
+ * @param[in] *handle 快速路径句柄
+ * @param[in] address 起始地址
+ * @param[in] *buf 数据
+ * @param[in] len 长度
+ * @return    状态码
+ *            - 0 成功
+ *            - 1 读入新页或写回旧页失败
+ *            - 2 参数为空
+ *            - 4 地址越界
+ */
+uint8_t at24cxx_fast_cache_write(at24cxx_fast_handle_t *handle, uint32_t address, const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     写回缓存中的脏区间
+ * @param[in] *handle 快速路径句柄
+ * @return    状态码
+ *            - 0 成功
+ *            - 1 写失败
+ *            - 2 参数为空
+ */
+uint8_t at24cxx_fast_flush(at24cxx_fast_handle_t *handle);
+
+/**
+ * @brief     等待上一页写周期结束
+ * @param[in] *handle 快速路径句柄
+ * @return    状态码
+ *            - 0 就绪
+ *            - 1 超时
+ *            - 2 参数为空
+ */
+uint8_t at24cxx_fast_wait_ready(at24cxx_fast_handle_t *handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -413,6 +413,19 @@ uint8_t at24cxx_interface_iic_write_address16(uint8_t addr, uint16_t reg, uint8_
     return at24cxx_interface_write_with_prefix(addr, prefix, sizeof(prefix), buf, len);
 }
 
+/**
+ * @brief     interface iic bus address probe
+ * @param[in] addr iic device write address
+ * @return    status code
+ *            - 0 device acknowledged
+ *            - 1 no acknowledge
+ * @note      sends only the address byte, used for write-cycle ack polling
+ */
+uint8_t at24cxx_interface_iic_probe(uint8_t addr)
+{
+    return (soft_i2c_master_transmit(&s_at24cxx_soft_i2c_bus, addr, NULL, 0U) == SOFT_I2C_STATUS_OK) ? 0U : 1U;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
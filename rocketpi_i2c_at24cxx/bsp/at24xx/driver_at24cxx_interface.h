@@ -121,6 +121,16 @@ uint8_t at24cxx_interface_iic_read_address16(uint8_t addr, uint16_t reg, uint8_t
  */
 uint8_t at24cxx_interface_iic_write_address16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     interface iic bus address probe
+ * @param[in] addr iic device write address
+ * @return    status code
+ *            - 0 device acknowledged
+ *            - 1 no acknowledge
+ * @note      sends only the address byte, used for write-cycle ack polling
+ */
+uint8_t at24cxx_interface_iic_probe(uint8_t addr);
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -125,6 +125,19 @@ uint8_t at24cxx_interface_iic_write_address16(uint8_t addr, uint16_t reg, uint8_
     return 0;
 }
 
+/**
+ * @brief     interface iic bus address probe
+ * @param[in] addr iic device write address
+ * @return    status code
+ *            - 0 device acknowledged
+ *            - 1 no acknowledge
+ * @note      sends only the address byte, used for write-cycle ack polling
+ */
+uint8_t at24cxx_interface_iic_probe(uint8_t addr)
+{
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -0,0 +1,857 @@
+/**
+ * @file debug_format.c
+ * @brief 轻量格式化引擎实现。
+ *
+ * 整数按 32 位为主转换，64 位值每次除以 1e9 取 9 位，十六进制/八进制只用移位。
+ * 浮点数拆成 double 的尾数与指数：整数部分落在 64 位内时直接按整数转换，
+ * 小数部分以 60 位定点数逐位乘 10 取出；更大或更小的值用 32 位字数组做精确运算。
+ * 舍入在精确值上按四舍六入五成双进行，与 glibc 的默认舍入一致。
+ */
+#include "debug_format.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#define FMT_LEFT    0x01U   /* '-' */
+#define FMT_PLUS    0x02U   /* '+' */
+#define FMT_SPACE   0x04U   /* ' ' */
+#define FMT_ALT     0x08U   /* '#' */
+#define FMT_ZERO    0x10U   /* '0' */
+#define FMT_UPPER   0x20U   /* X / F */
+#define FMT_PREC    0x40U   /* 给出了精度 */
+
+#define FRAC_BITS   60U     /* 小数定点位数，乘 10 后仍在 64 位内 */
+#define FRAC_MASK   ((1ULL << FRAC_BITS) - 1U)
+#define BIG_WORDS   35U     /* 1074 位小数或 1024 位整数所需的 32 位字数 */
+
+#if (DEBUG_FORMAT_FLOAT_DIGITS < 1) || (DEBUG_FORMAT_FLOAT_DIGITS > 64)
+#error "DEBUG_FORMAT_FLOAT_DIGITS must be in 1..64"
+#endif
+
+enum
+{
+    LEN_NONE = 0,
+    LEN_HH,
+    LEN_H,
+    LEN_L,
+    LEN_LL,
+    LEN_J,
+    LEN_Z,
+    LEN_T,
+    LEN_LONG_DOUBLE
+};
+
+typedef struct
+{
+    debug_format_out_t out;
+    void *ctx;
+    int count;
+} fmt_state_t;
+
+typedef struct
+{
+    unsigned flags;
+    int width;
+    int prec;
+} fmt_spec_t;
+
+typedef struct
+{
+    char *buf;
+    size_t size;
+    size_t len;
+} fmt_buffer_t;
+
+static void fmt_emit(fmt_state_t *st, const char *data, size_t len)
+{
+    if (len > 0U)
+    {
+        st->out(st->ctx, data, len);
+        st->count += (int)len;
+    }
+}
+
+static void fmt_pad(fmt_state_t *st, char c, int n)
+{
+    static const char kSpaces[16] = {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
+                                     ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '};
+    static const char kZeros[16] = {'0', '0', '0', '0', '0', '0', '0', '0',
+                                    '0', '0', '0', '0', '0', '0', '0', '0'};
+    const char *src = (c == '0') ? kZeros : kSpaces;
+
+    while (n > 0)
+    {
+        int chunk = (n > 16) ? 16 : n;
+
+        fmt_emit(st, src, (size_t)chunk);
+        n -= chunk;
+    }
+}
+
+/**
+ * @brief 输出一个字段：[空格]前缀[补零]主体[空格]，zeros 为精度要求的前导零。
+ */
+static void fmt_field(fmt_state_t *st, const fmt_spec_t *spec, const char *prefix, size_t prefix_len,
+                      int zeros, const char *body, size_t body_len)
+{
+    int pad = spec->width - (int)(prefix_len + body_len) - zeros;
+    unsigned align = spec->flags & (FMT_LEFT | FMT_ZERO);
+
+    if (align == 0U)
+    {
+        fmt_pad(st, ' ', pad);
+    }
+    fmt_emit(st, prefix, prefix_len);
+    if (align == FMT_ZERO)
+    {
+        fmt_pad(st, '0', pad);
+    }
+    fmt_pad(st, '0', zeros);
+    fmt_emit(st, body, body_len);
+    if ((spec->flags & FMT_LEFT) != 0U)
+    {
+        fmt_pad(st, ' ', pad);
+    }
+}
+
+static char *fmt_u32_dec(char *end, uint32_t value)
+{
+    do
+    {
+        *--end = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+    return end;
+}
+
+/* 64 位除法在 Cortex-M 上是库调用，每次除以 1e9 取出 9 位，余下部分走 32 位路径 */
+static char *fmt_u64_dec(char *end, uint64_t value)
+{
+    while (value > 0xFFFFFFFFU)
+    {
+        uint64_t q = value / 1000000000U;
+        uint32_t r = (uint32_t)(value - (q * 1000000000U));
+
+        for (int i = 0; i < 9; ++i)
+        {
+            *--end = (char)('0' + (r % 10U));
+            r /= 10U;
+        }
+        value = q;
+    }
+    return fmt_u32_dec(end, (uint32_t)value);
+}
+
+static void fmt_integer(fmt_state_t *st, const fmt_spec_t *spec, char conv, uint64_t value, int negative)
+{
+    const char *digits = ((spec->flags & FMT_UPPER) != 0U) ? "0123456789ABCDEF" : "0123456789abcdef";
+    char buf[24];
+    char *end = buf + sizeof(buf);
+    char *p = end;
+    char prefix[2];
+    size_t prefix_len = 0U;
+    int zeros = 0;
+    int len;
+
+    /* 精度为 0 且值为 0 时不输出数字 */
+    if ((value != 0U) || ((spec->flags & FMT_PREC) == 0U) || (spec->prec != 0))
+    {
+        uint64_t v = value;
+
+        if (conv == 'o')
+        {
+            do
+            {
+                *--p = (char)('0' + (v & 7U));
+                v >>= 3;
+            } while (v != 0U);
+        }
+        else if ((conv == 'x') || (conv == 'X'))
+        {
+            do
+            {
+                *--p = digits[v & 15U];
+                v >>= 4;
+            } while (v != 0U);
+        }
+        else
+        {
+            p = fmt_u64_dec(end, v);
+        }
+    }
+    len = (int)(end - p);
+
+    if (((spec->flags & FMT_PREC) != 0U) && (spec->prec > len))
+    {
+        zeros = spec->prec - len;
+    }
+    if ((conv == 'o') && ((spec->flags & FMT_ALT) != 0U) && (zeros == 0) && ((len == 0) || (*p != '0')))
+    {
+        zeros = 1;
+    }
+    if (((conv == 'x') || (conv == 'X')) && ((spec->flags & FMT_ALT) != 0U) && (value != 0U))
+    {
+        prefix[prefix_len++] = '0';
+        prefix[prefix_len++] = conv;
+    }
+    if ((conv == 'd') || (conv == 'i'))
+    {
+        if (negative)
+        {
+            prefix[prefix_len++] = '-';
+        }
+        else if ((spec->flags & FMT_PLUS) != 0U)
+        {
+            prefix[prefix_len++] = '+';
+        }
+        else if ((spec->flags & FMT_SPACE) != 0U)
+        {
+            prefix[prefix_len++] = ' ';
+        }
+    }
+    fmt_field(st, spec, prefix, prefix_len, zeros, p, (size_t)len);
+}
+
+/**
+ * @brief 输出浮点字段：[空格]符号[补零]整数[.小数][空格]，frac 为 NULL 表示小数全为 0。
+ */
+static void fmt_float_field(fmt_state_t *st, const fmt_spec_t *spec, char sign,
+                            const char *int_digits, size_t int_len, const char *frac, int prec)
+{
+    fmt_spec_t field = *spec;
+    size_t sign_len = (sign != '\0') ? 1U : 0U;
+    size_t point = ((prec > 0) || ((spec->flags & FMT_ALT) != 0U)) ? 1U : 0U;
+
+    /* 小数部分折算成主体之后的补零，复用 fmt_field 的对齐逻辑 */
+    field.width -= (int)point + prec;
+    if ((field.flags & FMT_LEFT) != 0U)
+    {
+        field.width = 0;
+    }
+    fmt_field(st, &field, &sign, sign_len, 0, int_digits, int_len);
+    if (point != 0U)
+    {
+        fmt_emit(st, ".", 1U);
+    }
+    if (frac != NULL)
+    {
+        fmt_emit(st, frac, (size_t)prec);
+    }
+    else
+    {
+        fmt_pad(st, '0', prec);
+    }
+    if ((spec->flags & FMT_LEFT) != 0U)
+    {
+        fmt_pad(st, ' ', spec->width - (int)(sign_len + int_len + point) - prec);
+    }
+}
+
+/**
+ * @brief 小数部分超过 60 位定点时的精确转换：frac / 2^shift 左对齐放入 32 位字数组。
+ * @return 剩余部分与 1/2 比较：-1 小于，0 相等，1 大于。
+ */
+static int fmt_frac_digits_big(uint64_t frac, unsigned shift, char *digits, int prec)
+{
+    uint32_t w[BIG_WORDS];
+    unsigned words = (shift + 31U) / 32U;
+    unsigned offset = (words * 32U) - shift;
+    uint32_t top;
+
+    memset(w, 0, words * sizeof(w[0]));
+    for (unsigned k = 0U; (k < 3U) && (k < words); ++k)
+    {
+        int pos = (int)(k * 32U) - (int)offset;
+
+        if (pos < 0)
+        {
+            w[k] = (uint32_t)(frac << (unsigned)(-pos));
+        }
+        else if (pos < 64)
+        {
+            w[k] = (uint32_t)(frac >> (unsigned)pos);
+        }
+    }
+    for (int i = 0; i < prec; ++i)
+    {
+        uint32_t carry = 0U;
+
+        for (unsigned k = 0U; k < words; ++k)
+        {
+            uint64_t t = ((uint64_t)w[k] * 10U) + carry;
+
+            w[k] = (uint32_t)t;
+            carry = (uint32_t)(t >> 32);
+        }
+        digits[i] = (char)('0' + carry);
+    }
+    top = w[words - 1U];
+    if (top != 0x80000000U)
+    {
+        return (top > 0x80000000U) ? 1 : -1;
+    }
+    for (unsigned k = 0U; k + 1U < words; ++k)
+    {
+        if (w[k] != 0U)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 取出 frac / 2^shift 的前 prec 位小数并舍入。
+ * @param odd prec 为 0 时整数个位是否为奇数，用于恰好一半时的舍入。
+ * @return 1 表示舍入进位到整数部分。
+ */
+static int fmt_frac_digits(uint64_t frac, unsigned shift, char *digits, int prec, int odd)
+{
+    int cmp;
+
+    if (shift <= FRAC_BITS)
+    {
+        const uint64_t half = 1ULL << (FRAC_BITS - 1U);
+        uint64_t x = frac << (FRAC_BITS - shift);
+
+        for (int i = 0; i < prec; ++i)
+        {
+            x *= 10U;
+            digits[i] = (char)('0' + (x >> FRAC_BITS));
+            x &= FRAC_MASK;
+        }
+        cmp = (x > half) ? 1 : ((x == half) ? 0 : -1);
+    }
+    else
+    {
+        cmp = fmt_frac_digits_big(frac, shift, digits, prec);
+    }
+    if (prec > 0)
+    {
+        odd = digits[prec - 1] & 1;
+    }
+    if ((cmp < 0) || ((cmp == 0) && !odd))
+    {
+        return 0;
+    }
+    for (int i = prec; i > 0; --i)
+    {
+        if (digits[i - 1] != '9')
+        {
+            digits[i - 1]++;
+            return 0;
+        }
+        digits[i - 1] = '0';
+    }
+    return 1;
+}
+
+/**
+ * @brief 整数部分超过 64 位（|x| >= 2^64）时的精确转换，此时没有小数位。
+ */
+static void fmt_float_big(fmt_state_t *st, const fmt_spec_t *spec, char sign, uint64_t mant, unsigned e, int prec)
+{
+    uint32_t w[BIG_WORDS];
+    char buf[BIG_WORDS * 9U];
+    char *end = buf + sizeof(buf);
+    char *p = end;
+    unsigned ws = e / 32U;
+    unsigned bs = e % 32U;
+    unsigned words = ws + 3U;
+
+    memset(w, 0, sizeof(w));
+    w[ws] = (uint32_t)(mant << bs);
+    w[ws + 1U] = (uint32_t)(mant >> (32U - bs));
+    w[ws + 2U] = (bs != 0U) ? (uint32_t)(mant >> (64U - bs)) : 0U;
+    while (w[words - 1U] == 0U)
+    {
+        words--;
+    }
+    while (words > 0U)
+    {
+        uint32_t rem = 0U;
+
+        for (unsigned k = words; k-- > 0U;)
+        {
+            uint64_t cur = ((uint64_t)rem << 32) | w[k];
+
+            w[k] = (uint32_t)(cur / 1000000000U);
+            rem = (uint32_t)(cur % 1000000000U);
+        }
+        while ((words > 0U) && (w[words - 1U] == 0U))
+        {
+            words--;
+        }
+        if (words > 0U)
+        {
+            for (int i = 0; i < 9; ++i)
+            {
+                *--p = (char)('0' + (rem % 10U));
+                rem /= 10U;
+            }
+        }
+        else
+        {
+            p = fmt_u32_dec(p, rem);
+        }
+    }
+    fmt_float_field(st, spec, sign, p, (size_t)(end - p), NULL, prec);
+}
+
+static void fmt_float(fmt_state_t *st, fmt_spec_t *spec, double value)
+{
+    uint64_t bits;
+    uint64_t mant;
+    uint64_t ipart;
+    uint64_t frac = 0U;
+    unsigned shift = 0U;
+    int exponent;
+    int prec = ((spec->flags & FMT_PREC) != 0U) ? spec->prec : 6;
+    char sign = '\0';
+    char frac_digits[DEBUG_FORMAT_FLOAT_DIGITS];
+    char int_digits[20];
+    char *p;
+    int round_carry;
+
+    memcpy(&bits, &value, sizeof(bits));
+    exponent = (int)((bits >> 52) & 0x7FFU);
+    mant = bits & ((1ULL << 52) - 1U);
+    if (prec > DEBUG_FORMAT_FLOAT_DIGITS)
+    {
+        prec = DEBUG_FORMAT_FLOAT_DIGITS;
+    }
+    if ((bits >> 63) != 0U)
+    {
+        sign = '-';
+    }
+    else if ((spec->flags & FMT_PLUS) != 0U)
+    {
+        sign = '+';
+    }
+    else if ((spec->flags & FMT_SPACE) != 0U)
+    {
+        sign = ' ';
+    }
+
+    if (exponent == 0x7FF)
+    {
+        const char *text = (mant != 0U) ? "nan" : "inf";
+
+        if ((spec->flags & FMT_UPPER) != 0U)
+        {
+            text = (mant != 0U) ? "NAN" : "INF";
+        }
+        spec->flags &= ~FMT_ZERO;
+        fmt_field(st, spec, &sign, (sign != '\0') ? 1U : 0U, 0, text, 3U);
+        return;
+    }
+    /* 值 = mant * 2^(exponent - 1075)，非规格数的指数按 1 计 */
+    if (exponent == 0)
+    {
+        exponent = 1;
+    }
+    else
+    {
+        mant |= 1ULL << 52;
+    }
+    exponent -= 1075;
+    if (exponent > 11)
+    {
+        fmt_float_big(st, spec, sign, mant, (unsigned)exponent, prec);
+        return;
+    }
+    if (exponent >= 0)
+    {
+        ipart = mant << (unsigned)exponent;
+    }
+    else
+    {
+        shift = (unsigned)(-exponent);
+        if (shift >= 64U)
+        {
+            ipart = 0U;
+            frac = mant;
+        }
+        else
+        {
+            ipart = mant >> shift;
+            frac = mant & ((1ULL << shift) - 1U);
+        }
+    }
+
+    round_carry = 0;
+    if (frac != 0U)
+    {
+        round_carry = fmt_frac_digits(frac, shift, frac_digits, prec, (int)(ipart & 1U));
+    }
+    p = fmt_u64_dec(int_digits + sizeof(int_digits), ipart + (uint64_t)round_carry);
+    fmt_float_field(st, spec, sign, p, (size_t)(int_digits + sizeof(int_digits) - p),
+                    (frac != 0U) ? frac_digits : NULL, prec);
+}
+
+static uint64_t fmt_arg_unsigned(va_list *ap, unsigned length)
+{
+    switch (length)
+    {
+    case LEN_HH:
+        return (unsigned char)va_arg(*ap, unsigned int);
+    case LEN_H:
+        return (unsigned short)va_arg(*ap, unsigned int);
+    case LEN_L:
+        return va_arg(*ap, unsigned long);
+    case LEN_LL:
+        return va_arg(*ap, unsigned long long);
+    case LEN_J:
+        return va_arg(*ap, uintmax_t);
+    case LEN_Z:
+        return va_arg(*ap, size_t);
+    case LEN_T:
+        return (size_t)va_arg(*ap, ptrdiff_t);
+    default:
+        return va_arg(*ap, unsigned int);
+    }
+}
+
+static int64_t fmt_arg_signed(va_list *ap, unsigned length)
+{
+    switch (length)
+    {
+    case LEN_HH:
+        return (signed char)va_arg(*ap, int);
+    case LEN_H:
+        return (short)va_arg(*ap, int);
+    case LEN_L:
+        return va_arg(*ap, long);
+    case LEN_LL:
+        return va_arg(*ap, long long);
+    case LEN_J:
+        return va_arg(*ap, intmax_t);
+    case LEN_Z:
+        return (ptrdiff_t)va_arg(*ap, size_t);
+    case LEN_T:
+        return va_arg(*ap, ptrdiff_t);
+    default:
+        return va_arg(*ap, int);
+    }
+}
+
+/**
+ * @brief 解析并输出一个转换说明，fmt 指向 '%' 之后。
+ * @return 转换说明之后的位置。
+ */
+static const char *fmt_conversion(fmt_state_t *st, const char *fmt, va_list *ap)
+{
+    const char *start = fmt - 1;
+    fmt_spec_t spec = {0U, 0, 0};
+    unsigned length = LEN_NONE;
+    char conv;
+
+    for (;;)
+    {
+        unsigned flag;
+
+        switch (*fmt)
+        {
+        case '-': flag = FMT_LEFT; break;
+        case '+': flag = FMT_PLUS; break;
+        case ' ': flag = FMT_SPACE; break;
+        case '#': flag = FMT_ALT; break;
+        case '0': flag = FMT_ZERO; break;
+        default: flag = 0U; break;
+        }
+        if (flag == 0U)
+        {
+            break;
+        }
+        spec.flags |= flag;
+        fmt++;
+    }
+
+    if (*fmt == '*')
+    {
+        spec.width = va_arg(*ap, int);
+        if (spec.width < 0)
+        {
+            spec.flags |= FMT_LEFT;
+            spec.width = -spec.width;
+        }
+        fmt++;
+    }
+    else
+    {
+        while ((*fmt >= '0') && (*fmt <= '9'))
+        {
+            spec.width = (spec.width * 10) + (*fmt++ - '0');
+        }
+    }
+
+    if (*fmt == '.')
+    {
+        fmt++;
+        spec.flags |= FMT_PREC;
+        if (*fmt == '*')
+        {
+            spec.prec = va_arg(*ap, int);
+            if (spec.prec < 0)
+            {
+                spec.flags &= ~FMT_PREC;
+                spec.prec = 0;
+            }
+            fmt++;
+        }
+        else
+        {
+            while ((*fmt >= '0') && (*fmt <= '9'))
+            {
+                spec.prec = (spec.prec * 10) + (*fmt++ - '0');
+            }
+        }
+    }
+
+    switch (*fmt)
+    {
+    case 'h':
+        fmt++;
+        length = LEN_H;
+        if (*fmt == 'h')
+        {
+            fmt++;
+            length = LEN_HH;
+        }
+        break;
+    case 'l':
+        fmt++;
+        length = LEN_L;
+        if (*fmt == 'l')
+        {
+            fmt++;
+            length = LEN_LL;
+        }
+        break;
+    case 'j': fmt++; length = LEN_J; break;
+    case 'z': fmt++; length = LEN_Z; break;
+    case 't': fmt++; length = LEN_T; break;
+    case 'L': fmt++; length = LEN_LONG_DOUBLE; break;
+    default: break;
+    }
+
+    conv = *fmt;
+    if (conv == '\0')
+    {
+        return fmt;
+    }
+    fmt++;
+
+    switch (conv)
+    {
+    case 'd':
+    case 'i':
+    {
+        int64_t v = fmt_arg_signed(ap, length);
+        uint64_t magnitude = (v < 0) ? (0U - (uint64_t)v) : (uint64_t)v;
+
+        if ((spec.flags & FMT_PREC) != 0U)
+        {
+            spec.flags &= ~FMT_ZERO;
+        }
+        fmt_integer(st, &spec, conv, magnitude, v < 0);
+        break;
+    }
+    case 'X':
+        spec.flags |= FMT_UPPER;
+        /* fall through */
+    case 'u':
+    case 'o':
+    case 'x':
+        if ((spec.flags & FMT_PREC) != 0U)
+        {
+            spec.flags &= ~FMT_ZERO;
+        }
+        fmt_integer(st, &spec, conv, fmt_arg_unsigned(ap, length), 0);
+        break;
+    case 'c':
+    {
+        char c = (char)va_arg(*ap, int);
+
+        spec.flags &= ~FMT_ZERO;   /* '0' 只对数值转换有效 */
+        fmt_field(st, &spec, NULL, 0U, 0, &c, 1U);
+        break;
+    }
+    case 's':
+    {
+        const char *s = va_arg(*ap, const char *);
+        size_t len;
+
+        if (s == NULL)
+        {
+            /* 与 glibc 相同：精度放不下时输出空串 */
+            s = (((spec.flags & FMT_PREC) == 0U) || (spec.prec >= 6)) ? "(null)" : "";
+        }
+        if ((spec.flags & FMT_PREC) != 0U)
+        {
+            const char *nul = (const char *)memchr(s, '\0', (size_t)spec.prec);
+
+            len = (nul != NULL) ? (size_t)(nul - s) : (size_t)spec.prec;
+        }
+        else
+        {
+            len = strlen(s);
+        }
+        spec.flags &= ~FMT_ZERO;
+        fmt_field(st, &spec, NULL, 0U, 0, s, len);
+        break;
+    }
+    case 'p':
+    {
+        void *ptr = va_arg(*ap, void *);
+
+        if (ptr == NULL)
+        {
+            spec.flags &= ~(FMT_ZERO | FMT_PREC);
+            fmt_field(st, &spec, NULL, 0U, 0, "(nil)", 5U);
+        }
+        else
+        {
+            spec.flags |= FMT_ALT;
+            spec.flags &= ~(FMT_PLUS | FMT_SPACE);
+            if ((spec.flags & FMT_PREC) != 0U)
+            {
+                spec.flags &= ~FMT_ZERO;
+            }
+            fmt_integer(st, &spec, 'x', (uint64_t)(uintptr_t)ptr, 0);
+        }
+        break;
+    }
+    case 'F':
+        spec.flags |= FMT_UPPER;
+        /* fall through */
+    case 'f':
+    {
+        double v;
+
+        if (length == LEN_LONG_DOUBLE)
+        {
+            v = (double)va_arg(*ap, long double);
+        }
+        else
+        {
+            v = va_arg(*ap, double);
+        }
+        fmt_float(st, &spec, v);
+        break;
+    }
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        /* 不支持的浮点转换：取走参数后原样输出，不冒充 %f 的结果 */
+        if (length == LEN_LONG_DOUBLE)
+        {
+            (void)va_arg(*ap, long double);
+        }
+        else
+        {
+            (void)va_arg(*ap, double);
+        }
+        fmt_emit(st, start, (size_t)(fmt - start));
+        break;
+    case 'n':
+        /* 不写入计数：取走指针后原样输出 */
+        (void)va_arg(*ap, void *);
+        fmt_emit(st, start, (size_t)(fmt - start));
+        break;
+    case '%':
+        fmt_emit(st, "%", 1U);
+        break;
+    default:
+        /* 未知转换原样输出 */
+        fmt_emit(st, start, (size_t)(fmt - start));
+        break;
+    }
+    return fmt;
+}
+
+int debug_vformat(debug_format_out_t out, void *ctx, const char *fmt, va_list ap)
+{
+    fmt_state_t st;
+    va_list args;
+
+    st.out = out;
+    st.ctx = ctx;
+    st.count = 0;
+    va_copy(args, ap);
+    while (*fmt != '\0')
+    {
+        const char *run = fmt;
+
+        while ((*fmt != '\0') && (*fmt != '%'))
+        {
+            fmt++;
+        }
+        fmt_emit(&st, run, (size_t)(fmt - run));
+        if (*fmt == '\0')
+        {
+            break;
+        }
+        fmt = fmt_conversion(&st, fmt + 1, &args);
+    }
+    va_end(args);
+    return st.count;
+}
+
+int debug_format(debug_format_out_t out, void *ctx, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = debug_vformat(out, ctx, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+static void fmt_buffer_out(void *ctx, const char *data, size_t len)
+{
+    fmt_buffer_t *b = (fmt_buffer_t *)ctx;
+
+    if (b->len + 1U < b->size)
+    {
+        size_t room = b->size - 1U - b->len;
+
+        if (len > room)
+        {
+            len = room;
+        }
+        memcpy(&b->buf[b->len], data, len);
+        b->len += len;
+    }
+}
+
+int debug_vsnprintf(char *buf, size_t size, const char *fmt, va_list ap)
+{
+    fmt_buffer_t b;
+    int n;
+
+    b.buf = buf;
+    b.size = size;
+    b.len = 0U;
+    n = debug_vformat(fmt_buffer_out, &b, fmt, ap);
+    if (size > 0U)
+    {
+        buf[b.len] = '\0';
+    }
+    return n;
+}
+
+int debug_snprintf(char *buf, size_t size, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = debug_vsnprintf(buf, size, fmt, ap);
+    va_end(ap);
+    return n;
+}
@@ -0,0 +1,462 @@
+#include "i2c_async.h"
+
+#include <string.h>
+
+/**
+ * @file i2c_async.c
+ * @brief 异步I2C事务队列与软件/硬件执行引擎实现。
+ */
+
+#define I2C_ASYNC_QUEUE_MASK   (I2C_ASYNC_QUEUE_DEPTH - 1U)
+#define I2C_ASYNC_ACK_SLOT     8U   /**< 每字节9个时隙：0..7为数据位，8为ACK位。 */
+
+/* 软件引擎状态：每个节拍只执行一个相位，一个数据位占用 LOW/HIGH 两个节拍 */
+enum {
+    SOFT_ST_IDLE = 0,
+    SOFT_ST_START_A,      /* 释放SDA/SCL，总线进入空闲高电平 */
+    SOFT_ST_START_B,      /* SCL高时拉低SDA：起始条件 */
+    SOFT_ST_LOW,          /* 拉低SCL并准备当前时隙的SDA */
+    SOFT_ST_HIGH,         /* 释放SCL（处理时钟延展）并采样SDA */
+    SOFT_ST_RESTART_A,    /* 拉低SCL并释放SDA，准备重复起始 */
+    SOFT_ST_RESTART_B,    /* 释放SCL，下一拍进入 START_B */
+    SOFT_ST_STOP_A,       /* 拉低SCL并拉低SDA */
+    SOFT_ST_STOP_B,       /* 释放SCL */
+    SOFT_ST_STOP_C        /* SCL高时释放SDA：停止条件，作业结束 */
+};
+
+/* 作业内部阶段 */
+enum {
+    SOFT_PH_ADDR_W = 0,
+    SOFT_PH_TX,
+    SOFT_PH_ADDR_R,
+    SOFT_PH_RX
+};
+
+#ifdef HAL_I2C_MODULE_ENABLED
+static i2c_async_bus_t *s_hw_bus = NULL;
+#endif
+
+static void i2c_async_kick(i2c_async_bus_t *bus);
+
+/* 关中断保护队列索引，返回进入前的PRIMASK以支持嵌套调用 */
+static uint32_t i2c_async_lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static void i2c_async_unlock(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+/* 当前作业结束：出队、统计、回调，然后启动下一个作业 */
+static void i2c_async_finish(i2c_async_bus_t *bus, i2c_async_status_t status)
+{
+    i2c_async_job_t job = bus->queue[bus->tail & I2C_ASYNC_QUEUE_MASK];
+
+    bus->result = status;
+    bus->tail++;
+    bus->active = 0U;
+    if (status == I2C_ASYNC_STATUS_OK) {
+        bus->completed++;
+    } else {
+        bus->failed++;
+    }
+
+    if (job.callback != NULL) {
+        job.callback(status, job.ctx);
+    }
+
+    if (bus->active == 0U) {
+        i2c_async_kick(bus);
+    }
+}
+
+/* ---------------- 软件引擎 ---------------- */
+
+static void soft_scl(i2c_async_bus_t *bus, soft_i2c_pin_state_t state)
+{
+    (void)bus->soft.scl.write(bus->soft.scl.ctx, state);
+}
+
+static void soft_sda(i2c_async_bus_t *bus, soft_i2c_pin_state_t state)
+{
+    (void)bus->soft.sda.write(bus->soft.sda.ctx, state);
+}
+
+static soft_i2c_pin_state_t soft_bit(uint8_t value)
+{
+    return (value != 0U) ? SOFT_I2C_PIN_SET : SOFT_I2C_PIN_RESET;
+}
+
+/* 释放SCL并检测时钟延展；返回1表示SCL已为高，0表示仍被从机拉低 */
+static uint8_t soft_release_scl(i2c_async_bus_t *bus)
+{
+    soft_scl(bus, SOFT_I2C_PIN_SET);
+    if (bus->soft.scl.read(bus->soft.scl.ctx) == SOFT_I2C_PIN_RESET) {
+        if (++bus->soft.stretch > I2C_ASYNC_STRETCH_TICKS) {
+            bus->soft.state = SOFT_ST_IDLE;
+            soft_sda(bus, SOFT_I2C_PIN_SET);
+            i2c_async_finish(bus, I2C_ASYNC_STATUS_TIMEOUT);
+        }
+        return 0U;
+    }
+
+    bus->soft.stretch = 0U;
+    return 1U;
+}
+
+static void soft_begin(i2c_async_bus_t *bus, const i2c_async_job_t *job)
+{
+    i2c_async_soft_engine_t *eng = &bus->soft;
+
+    if (job->tx_len > 0U || job->rx_len == 0U) {
+        eng->shift = job->address & (uint8_t)~0x01U;
+        eng->phase = SOFT_PH_ADDR_W;
+    } else {
+        eng->shift = job->address | 0x01U;
+        eng->phase = SOFT_PH_ADDR_R;
+    }
+    eng->index = 0U;
+    eng->bit = 0U;
+    eng->ack = 0U;
+    eng->stretch = 0U;
+    eng->state = SOFT_ST_START_A;
+
+    if (eng->timer_start != NULL) {
+        eng->timer_start();
+    }
+}
+
+/* 一个字节（含ACK时隙）完成后决定下一步 */
+static void soft_byte_done(i2c_async_bus_t *bus)
+{
+    i2c_async_soft_engine_t *eng = &bus->soft;
+    const i2c_async_job_t *job = &bus->queue[bus->tail & I2C_ASYNC_QUEUE_MASK];
+
+    eng->bit = 0U;
+
+    if (eng->phase == SOFT_PH_RX) {
+        if (eng->index < job->rx_len) {
+            eng->shift = 0U;
+            eng->state = SOFT_ST_LOW;
+        } else {
+            eng->state = SOFT_ST_STOP_A;
+        }
+        return;
+    }
+
+    if (eng->ack != 0U) {
+        bus->result = I2C_ASYNC_STATUS_ERROR;
+        eng->state = SOFT_ST_STOP_A;
+        return;
+    }
+
+    if (eng->phase == SOFT_PH_ADDR_R) {
+        eng->phase = SOFT_PH_RX;
+        eng->index = 0U;
+        eng->shift = 0U;
+        eng->state = SOFT_ST_LOW;
+    } else if (eng->index < job->tx_len) {
+        eng->phase = SOFT_PH_TX;
+        eng->shift = job->tx[eng->index++];
+        eng->state = SOFT_ST_LOW;
+    } else if (job->rx_len > 0U) {
+        eng->phase = SOFT_PH_ADDR_R;
+        eng->shift = job->address | 0x01U;
+        eng->state = SOFT_ST_RESTART_A;
+    } else {
+        eng->state = SOFT_ST_STOP_A;
+    }
+}
+
+/* 定时器节拍：推进一个相位 */
+void i2c_async_soft_tick(i2c_async_bus_t *bus)
+{
+    if ((bus == NULL) || (bus->backend != I2C_ASYNC_BACKEND_SOFT)) {
+        return;
+    }
+
+    i2c_async_soft_engine_t *eng = &bus->soft;
+    const i2c_async_job_t *job = &bus->queue[bus->tail & I2C_ASYNC_QUEUE_MASK];
+
+    switch (eng->state) {
+    case SOFT_ST_START_A:
+        soft_sda(bus, SOFT_I2C_PIN_SET);
+        if (soft_release_scl(bus) != 0U) {
+            bus->result = I2C_ASYNC_STATUS_OK;
+            eng->state = SOFT_ST_START_B;
+        }
+        break;
+
+    case SOFT_ST_START_B:
+        soft_sda(bus, SOFT_I2C_PIN_RESET);
+        eng->state = SOFT_ST_LOW;
+        break;
+
+    case SOFT_ST_LOW:
+        soft_scl(bus, SOFT_I2C_PIN_RESET);
+        if (eng->bit < I2C_ASYNC_ACK_SLOT) {
+            if (eng->phase == SOFT_PH_RX) {
+                soft_sda(bus, SOFT_I2C_PIN_SET);
+            } else {
+                soft_sda(bus, soft_bit((uint8_t)((eng->shift >> (7U - eng->bit)) & 0x01U)));
+            }
+        } else if (eng->phase == SOFT_PH_RX) {
+            /* 还有后续字节则ACK，最后一个字节发送NACK */
+            soft_sda(bus, soft_bit((uint8_t)(eng->index >= job->rx_len)));
+        } else {
+            soft_sda(bus, SOFT_I2C_PIN_SET);
+        }
+        eng->state = SOFT_ST_HIGH;
+        break;
+
+    case SOFT_ST_HIGH:
+        if (soft_release_scl(bus) == 0U) {
+            break;
+        }
+        if (eng->bit < I2C_ASYNC_ACK_SLOT) {
+            if (eng->phase == SOFT_PH_RX) {
+                if (bus->soft.sda.read(bus->soft.sda.ctx) == SOFT_I2C_PIN_SET) {
+                    eng->shift |= (uint8_t)(1U << (7U - eng->bit));
+                }
+                if (eng->bit == (I2C_ASYNC_ACK_SLOT - 1U)) {
+                    job->rx[eng->index++] = eng->shift;
+                }
+            }
+            eng->bit++;
+            eng->state = SOFT_ST_LOW;
+        } else {
+            if (eng->phase != SOFT_PH_RX) {
+                eng->ack = (bus->soft.sda.read(bus->soft.sda.ctx) == SOFT_I2C_PIN_SET) ? 1U : 0U;
+            }
+            soft_byte_done(bus);
+        }
+        break;
+
+    case SOFT_ST_RESTART_A:
+        soft_scl(bus, SOFT_I2C_PIN_RESET);
+        soft_sda(bus, SOFT_I2C_PIN_SET);
+        eng->state = SOFT_ST_RESTART_B;
+        break;
+
+    case SOFT_ST_RESTART_B:
+        if (soft_release_scl(bus) != 0U) {
+            eng->state = SOFT_ST_START_B;
+        }
+        break;
+
+    case SOFT_ST_STOP_A:
+        soft_scl(bus, SOFT_I2C_PIN_RESET);
+        soft_sda(bus, SOFT_I2C_PIN_RESET);
+        eng->state = SOFT_ST_STOP_B;
+        break;
+
+    case SOFT_ST_STOP_B:
+        if (soft_release_scl(bus) != 0U) {
+            eng->state = SOFT_ST_STOP_C;
+        }
+        break;
+
+    case SOFT_ST_STOP_C:
+        soft_sda(bus, SOFT_I2C_PIN_SET);
+        eng->state = SOFT_ST_IDLE;
+        i2c_async_finish(bus, bus->result);
+        break;
+
+    case SOFT_ST_IDLE:
+    default:
+        break;
+    }
+}
+
+/* ---------------- 硬件引擎 ---------------- */
+
+#ifdef HAL_I2C_MODULE_ENABLED
+static void hw_begin(i2c_async_bus_t *bus, const i2c_async_job_t *job)
+{
+    HAL_StatusTypeDef status;
+
+    if ((job->tx_len > 0U) && (job->rx_len > 0U)) {
+        status = HAL_I2C_Master_Seq_Transmit_IT(bus->hi2c, job->address, (uint8_t *)job->tx,
+                                                job->tx_len, I2C_FIRST_FRAME);
+    } else if (job->tx_len > 0U) {
+        status = HAL_I2C_Master_Transmit_IT(bus->hi2c, job->address, (uint8_t *)job->tx, job->tx_len);
+    } else {
+        status = HAL_I2C_Master_Receive_IT(bus->hi2c, job->address, job->rx, job->rx_len);
+    }
+
+    if (status != HAL_OK) {
+        i2c_async_finish(bus, I2C_ASYNC_STATUS_ERROR);
+    }
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    i2c_async_bus_t *bus = s_hw_bus;
+    if ((bus == NULL) || (bus->hi2c != hi2c) || (bus->active == 0U)) {
+        return;
+    }
+
+    const i2c_async_job_t *job = &bus->queue[bus->tail & I2C_ASYNC_QUEUE_MASK];
+    if (job->rx_len > 0U) {
+        if (HAL_I2C_Master_Seq_Receive_IT(hi2c, job->address, job->rx, job->rx_len,
+                                          I2C_LAST_FRAME) != HAL_OK) {
+            i2c_async_finish(bus, I2C_ASYNC_STATUS_ERROR);
+        }
+        return;
+    }
+
+    i2c_async_finish(bus, I2C_ASYNC_STATUS_OK);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    i2c_async_bus_t *bus = s_hw_bus;
+    if ((bus != NULL) && (bus->hi2c == hi2c) && (bus->active != 0U)) {
+        i2c_async_finish(bus, I2C_ASYNC_STATUS_OK);
+    }
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    i2c_async_bus_t *bus = s_hw_bus;
+    if ((bus != NULL) && (bus->hi2c == hi2c) && (bus->active != 0U)) {
+        i2c_async_finish(bus, I2C_ASYNC_STATUS_ERROR);
+    }
+}
+
+i2c_async_status_t i2c_async_init_hw(i2c_async_bus_t *bus, I2C_HandleTypeDef *hi2c)
+{
+    if ((bus == NULL) || (hi2c == NULL)) {
+        return I2C_ASYNC_STATUS_INVALID_PARAM;
+    }
+
+    memset(bus, 0, sizeof(*bus));
+    bus->backend = I2C_ASYNC_BACKEND_HW;
+    bus->hi2c = hi2c;
+    s_hw_bus = bus;
+    return I2C_ASYNC_STATUS_OK;
+}
+#endif /* HAL_I2C_MODULE_ENABLED */
+
+/* ---------------- 队列 ---------------- */
+
+/* 引擎空闲且队列非空时启动队首作业；队列清空时关闭软件节拍 */
+static void i2c_async_kick(i2c_async_bus_t *bus)
+{
+    if (bus->active != 0U) {
+        return;
+    }
+
+    if (bus->head == bus->tail) {
+        if ((bus->backend == I2C_ASYNC_BACKEND_SOFT) && (bus->soft.timer_stop != NULL)) {
+            bus->soft.timer_stop();
+        }
+        return;
+    }
+
+    const i2c_async_job_t *job = &bus->queue[bus->tail & I2C_ASYNC_QUEUE_MASK];
+    bus->active = 1U;
+
+    if (bus->backend == I2C_ASYNC_BACKEND_SOFT) {
+        soft_begin(bus, job);
+    }
+#ifdef HAL_I2C_MODULE_ENABLED
+    else if (bus->backend == I2C_ASYNC_BACKEND_HW) {
+        hw_begin(bus, job);
+    }
+#endif
+}
+
+i2c_async_status_t i2c_async_init_soft(i2c_async_bus_t *bus,
+                                       const soft_i2c_pin_io_t *scl,
+                                       const soft_i2c_pin_io_t *sda,
+                                       i2c_async_timer_fn timer_start,
+                                       i2c_async_timer_fn timer_stop)
+{
+    if ((bus == NULL) || (scl == NULL) || (sda == NULL) ||
+        (scl->write == NULL) || (scl->read == NULL) ||
+        (sda->write == NULL) || (sda->read == NULL) ||
+        (timer_start == NULL) || (timer_stop == NULL)) {
+        return I2C_ASYNC_STATUS_INVALID_PARAM;
+    }
+
+    memset(bus, 0, sizeof(*bus));
+    bus->backend = I2C_ASYNC_BACKEND_SOFT;
+    bus->soft.scl = *scl;
+    bus->soft.sda = *sda;
+    bus->soft.timer_start = timer_start;
+    bus->soft.timer_stop = timer_stop;
+    bus->soft.state = SOFT_ST_IDLE;
+
+    soft_scl(bus, SOFT_I2C_PIN_SET);
+    soft_sda(bus, SOFT_I2C_PIN_SET);
+    return I2C_ASYNC_STATUS_OK;
+}
+
+i2c_async_status_t i2c_async_submit(i2c_async_bus_t *bus, const i2c_async_job_t *job)
+{
+    if ((bus == NULL) || (job == NULL) || (bus->backend == I2C_ASYNC_BACKEND_NONE) ||
+        ((job->tx == NULL) && (job->tx_len > 0U)) ||
+        ((job->rx == NULL) && (job->rx_len > 0U))) {
+        return I2C_ASYNC_STATUS_INVALID_PARAM;
+    }
+    /* 仅地址探测（无数据）的作业只有软件引擎支持，可用于ACK轮询 */
+    if ((bus->backend == I2C_ASYNC_BACKEND_HW) && (job->tx_len == 0U) && (job->rx_len == 0U)) {
+        return I2C_ASYNC_STATUS_INVALID_PARAM;
+    }
+
+    uint32_t primask = i2c_async_lock();
+    if ((bus->head - bus->tail) >= I2C_ASYNC_QUEUE_DEPTH) {
+        i2c_async_unlock(primask);
+        return I2C_ASYNC_STATUS_QUEUE_FULL;
+    }
+
+    bus->queue[bus->head & I2C_ASYNC_QUEUE_MASK] = *job;
+    bus->head++;
+    i2c_async_kick(bus);
+    i2c_async_unlock(primask);
+
+    return I2C_ASYNC_STATUS_OK;
+}
+
+i2c_async_status_t i2c_async_write(i2c_async_bus_t *bus, uint8_t address,
+                                   const uint8_t *data, uint16_t size,
+                                   i2c_async_callback_t callback, void *ctx)
+{
+    const i2c_async_job_t job = {address, data, size, NULL, 0U, callback, ctx};
+    return i2c_async_submit(bus, &job);
+}
+
+i2c_async_status_t i2c_async_read(i2c_async_bus_t *bus, uint8_t address,
+                                  uint8_t *data, uint16_t size,
+                                  i2c_async_callback_t callback, void *ctx)
+{
+    if (size == 0U) {
+        return I2C_ASYNC_STATUS_INVALID_PARAM;
+    }
+
+    const i2c_async_job_t job = {address, NULL, 0U, data, size, callback, ctx};
+    return i2c_async_submit(bus, &job);
+}
+
+i2c_async_status_t i2c_async_write_read(i2c_async_bus_t *bus, uint8_t address,
+                                        const uint8_t *tx_data, uint16_t tx_size,
+                                        uint8_t *rx_data, uint16_t rx_size,
+                                        i2c_async_callback_t callback, void *ctx)
+{
+    const i2c_async_job_t job = {address, tx_data, tx_size, rx_data, rx_size, callback, ctx};
+    return i2c_async_submit(bus, &job);
+}
+
+uint8_t i2c_async_is_idle(const i2c_async_bus_t *bus)
+{
+    if (bus == NULL) {
+        return 1U;
+    }
+
+    return ((bus->active == 0U) && (bus->head == bus->tail)) ? 1U : 0U;
+}
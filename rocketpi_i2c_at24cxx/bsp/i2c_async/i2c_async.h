@@ -0,0 +1,147 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "main.h"
+#include "soft_i2c.h"
+
+/**
+ * @file i2c_async.h
+ * @brief 异步I2C事务队列：写/读/先写后读作业排队执行，完成后回调通知。
+ *
+ * 支持两种执行引擎：
+ *   - 软件引擎：由定时器中断周期性调用 i2c_async_soft_tick()，每次只推进
+ *     半个SCL周期的一个相位，CPU不再忙等 soft_i2c_delay。
+ *   - 硬件引擎：基于HAL I2C中断序列接口（Seq_Transmit/Seq_Receive），
+ *     仅在 HAL_I2C_MODULE_ENABLED 时编译。
+ *
+ * 完成回调在中断上下文中执行，应只做置标志、拷贝等轻量操作。
+ */
+
+#ifndef I2C_ASYNC_QUEUE_DEPTH
+#define I2C_ASYNC_QUEUE_DEPTH   8U   /**< 每条总线可排队的作业数，必须为2的幂。 */
+#endif
+
+#ifndef I2C_ASYNC_STRETCH_TICKS
+#define I2C_ASYNC_STRETCH_TICKS 200U /**< 软件引擎允许的时钟延展节拍数，超过即超时。 */
+#endif
+
+#if (I2C_ASYNC_QUEUE_DEPTH & (I2C_ASYNC_QUEUE_DEPTH - 1U)) != 0U
+#error "I2C_ASYNC_QUEUE_DEPTH 必须为2的幂。"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    I2C_ASYNC_STATUS_OK = 0,
+    I2C_ASYNC_STATUS_ERROR = 1,          /**< 从机NACK或总线错误。 */
+    I2C_ASYNC_STATUS_TIMEOUT = 2,        /**< 时钟延展超时。 */
+    I2C_ASYNC_STATUS_INVALID_PARAM = 3,
+    I2C_ASYNC_STATUS_QUEUE_FULL = 4
+} i2c_async_status_t;
+
+typedef enum {
+    I2C_ASYNC_BACKEND_NONE = 0,
+    I2C_ASYNC_BACKEND_SOFT = 1,
+    I2C_ASYNC_BACKEND_HW = 2
+} i2c_async_backend_t;
+
+/** 作业完成回调（中断上下文）。 */
+typedef void (*i2c_async_callback_t)(i2c_async_status_t status, void *ctx);
+
+/** 软件引擎的节拍定时器启停钩子，队列空闲时停表以节省中断。 */
+typedef void (*i2c_async_timer_fn)(void);
+
+/**
+ * 单个I2C作业：tx_len>0 且 rx_len>0 时为先写后读（重复起始），
+ * 只有其中一项非零时为纯写或纯读。缓冲区在回调前必须保持有效。
+ */
+typedef struct {
+    uint8_t address;              /**< 8位格式地址（7位地址左移1位）。 */
+    const uint8_t *tx;
+    uint16_t tx_len;
+    uint8_t *rx;
+    uint16_t rx_len;
+    i2c_async_callback_t callback;
+    void *ctx;
+} i2c_async_job_t;
+
+/** 软件引擎的运行状态，由 i2c_async.c 内部维护。 */
+typedef struct {
+    soft_i2c_pin_io_t scl;
+    soft_i2c_pin_io_t sda;
+    i2c_async_timer_fn timer_start;
+    i2c_async_timer_fn timer_stop;
+    uint8_t state;
+    uint8_t phase;
+    uint8_t shift;
+    uint8_t bit;
+    uint8_t ack;
+    uint16_t index;
+    uint16_t stretch;
+} i2c_async_soft_engine_t;
+
+typedef struct {
+    i2c_async_backend_t backend;
+    i2c_async_job_t queue[I2C_ASYNC_QUEUE_DEPTH];
+    volatile uint32_t head;       /**< 下一个写入位置（提交者推进）。 */
+    volatile uint32_t tail;       /**< 当前执行的作业（引擎推进）。 */
+    volatile uint8_t active;      /**< 引擎正在执行 queue[tail]。 */
+    volatile i2c_async_status_t result;
+    i2c_async_soft_engine_t soft;
+#ifdef HAL_I2C_MODULE_ENABLED
+    I2C_HandleTypeDef *hi2c;
+#endif
+    uint32_t completed;           /**< 已完成作业计数，便于统计。 */
+    uint32_t failed;              /**< 失败作业计数。 */
+} i2c_async_bus_t;
+
+/**
+ * 初始化软件引擎总线。
+ * @param bus         总线对象。
+ * @param scl/sda     引脚读写回调（与 soft_i2c 共用同一套开漏IO接口）。
+ * @param timer_start 启动节拍定时器（每个节拍为半个SCL周期）。
+ * @param timer_stop  停止节拍定时器。
+ */
+i2c_async_status_t i2c_async_init_soft(i2c_async_bus_t *bus,
+                                       const soft_i2c_pin_io_t *scl,
+                                       const soft_i2c_pin_io_t *sda,
+                                       i2c_async_timer_fn timer_start,
+                                       i2c_async_timer_fn timer_stop);
+
+#ifdef HAL_I2C_MODULE_ENABLED
+/** 初始化硬件引擎总线，需在CubeMX中使能对应I2C的事件/错误中断。 */
+i2c_async_status_t i2c_async_init_hw(i2c_async_bus_t *bus, I2C_HandleTypeDef *hi2c);
+#endif
+
+/** 将作业拷贝进队列，总线空闲时立即启动。可在中断回调中调用以串联作业。 */
+i2c_async_status_t i2c_async_submit(i2c_async_bus_t *bus, const i2c_async_job_t *job);
+
+/** 纯写作业的便捷封装。 */
+i2c_async_status_t i2c_async_write(i2c_async_bus_t *bus, uint8_t address,
+                                   const uint8_t *data, uint16_t size,
+                                   i2c_async_callback_t callback, void *ctx);
+
+/** 纯读作业的便捷封装。 */
+i2c_async_status_t i2c_async_read(i2c_async_bus_t *bus, uint8_t address,
+                                  uint8_t *data, uint16_t size,
+                                  i2c_async_callback_t callback, void *ctx);
+
+/** 先写后读（重复起始）作业的便捷封装。 */
+i2c_async_status_t i2c_async_write_read(i2c_async_bus_t *bus, uint8_t address,
+                                        const uint8_t *tx_data, uint16_t tx_size,
+                                        uint8_t *rx_data, uint16_t rx_size,
+                                        i2c_async_callback_t callback, void *ctx);
+
+/** 队列为空且引擎空闲时返回1。 */
+uint8_t i2c_async_is_idle(const i2c_async_bus_t *bus);
+
+/** 软件引擎节拍，在定时器更新中断中调用。 */
+void i2c_async_soft_tick(i2c_async_bus_t *bus);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,573 @@
+#include "kvstore.h"
+
+#include <string.h>
+
+/**
+ * @file kvstore.c
+ * @brief 日志结构键值存储实现。
+ *
+ * 扇区布局：[扇区头 8B][记录][记录]...[0xFF...]
+ * 记录布局：[key_len 1B][type 1B][value_len 2B][crc32 4B][key][value][对齐填充]
+ * CRC 覆盖记录头前4字节、键与值。
+ */
+
+#define KVSTORE_MAGIC         0x3153564BUL    /* "KVS1" */
+#define KVSTORE_SECTOR_HDR    8U
+#define KVSTORE_REC_HDR       8U
+#define KVSTORE_REC_VALUE     0x5AU
+#define KVSTORE_REC_DELETED   0xA5U
+#define KVSTORE_INDEX_MASK    (KVSTORE_INDEX_SIZE - 1U)
+#define KVSTORE_INDEX_LIMIT   ((KVSTORE_INDEX_SIZE * 3U) / 4U)
+#define KVSTORE_CHUNK         32U
+
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;
+} kvstore_sector_hdr_t;
+
+typedef struct {
+    uint8_t key_len;
+    uint8_t type;
+    uint16_t value_len;
+    uint32_t crc;
+} kvstore_rec_hdr_t;
+
+/* 记录解析结果 */
+enum {
+    KVSTORE_REC_OK = 0,
+    KVSTORE_REC_END,        /* 读到擦除区，日志结束 */
+    KVSTORE_REC_CORRUPT,    /* 头非法或CRC不符：掉电残留 */
+    KVSTORE_REC_IO
+};
+
+static const uint32_t s_crc32_nibble[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+static uint32_t kvstore_crc32(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ s_crc32_nibble[crc & 0x0FU];
+        crc = (crc >> 4) ^ s_crc32_nibble[crc & 0x0FU];
+    }
+    return crc;
+}
+
+/* FNV-1a */
+static uint32_t kvstore_hash(const char *key, uint32_t len)
+{
+    uint32_t hash = 2166136261UL;
+    for (uint32_t i = 0; i < len; ++i) {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static uint32_t kvstore_rec_size(uint32_t key_len, uint32_t value_len)
+{
+    return (KVSTORE_REC_HDR + key_len + value_len + 3U) & ~3UL;
+}
+
+static uint8_t kvstore_read(const kvstore_t *kv, uint16_t sector, uint32_t offset, void *buf, uint32_t len)
+{
+    const kvstore_backend_t *be = kv->backend;
+    return be->read(be->ctx, (uint32_t)sector * be->sector_size + offset, buf, len);
+}
+
+static uint8_t kvstore_prog(const kvstore_t *kv, uint16_t sector, uint32_t offset, const void *buf, uint32_t len)
+{
+    const kvstore_backend_t *be = kv->backend;
+    return be->prog(be->ctx, (uint32_t)sector * be->sector_size + offset, buf, len);
+}
+
+/* 读取并校验一条记录，key 至少 KVSTORE_KEY_MAX 字节 */
+static int kvstore_rec_load(const kvstore_t *kv, uint16_t sector, uint32_t offset,
+                            kvstore_rec_hdr_t *hdr, char *key)
+{
+    const uint32_t sector_size = kv->backend->sector_size;
+    uint8_t chunk[KVSTORE_CHUNK];
+
+    if (offset + KVSTORE_REC_HDR > sector_size) {
+        return KVSTORE_REC_END;
+    }
+    if (kvstore_read(kv, sector, offset, hdr, sizeof(*hdr)) != 0U) {
+        return KVSTORE_REC_IO;
+    }
+
+    const uint8_t *raw = (const uint8_t *)hdr;
+    uint8_t erased = 1U;
+    for (uint32_t i = 0; i < sizeof(*hdr); ++i) {
+        if (raw[i] != 0xFFU) {
+            erased = 0U;
+            break;
+        }
+    }
+    if (erased != 0U) {
+        return KVSTORE_REC_END;
+    }
+
+    if ((hdr->key_len == 0U) || (hdr->key_len > KVSTORE_KEY_MAX) ||
+        ((hdr->type != KVSTORE_REC_VALUE) && (hdr->type != KVSTORE_REC_DELETED)) ||
+        ((hdr->type == KVSTORE_REC_DELETED) && (hdr->value_len != 0U)) ||
+        (offset + kvstore_rec_size(hdr->key_len, hdr->value_len) > sector_size)) {
+        return KVSTORE_REC_CORRUPT;
+    }
+
+    if (kvstore_read(kv, sector, offset + KVSTORE_REC_HDR, key, hdr->key_len) != 0U) {
+        return KVSTORE_REC_IO;
+    }
+
+    uint32_t crc = kvstore_crc32(0xFFFFFFFFU, raw, 4U);
+    crc = kvstore_crc32(crc, (const uint8_t *)key, hdr->key_len);
+
+    uint32_t pos = offset + KVSTORE_REC_HDR + hdr->key_len;
+    uint32_t remain = hdr->value_len;
+    while (remain > 0U) {
+        uint32_t n = (remain > KVSTORE_CHUNK) ? KVSTORE_CHUNK : remain;
+        if (kvstore_read(kv, sector, pos, chunk, n) != 0U) {
+            return KVSTORE_REC_IO;
+        }
+        crc = kvstore_crc32(crc, chunk, n);
+        pos += n;
+        remain -= n;
+    }
+
+    return ((crc ^ 0xFFFFFFFFU) == hdr->crc) ? KVSTORE_REC_OK : KVSTORE_REC_CORRUPT;
+}
+
+/* 在索引中查找键，返回槽号，未找到返回 -1 */
+static int32_t kvstore_find(const kvstore_t *kv, const char *key, uint32_t key_len, uint32_t hash)
+{
+    uint8_t buf[KVSTORE_REC_HDR + KVSTORE_KEY_MAX];
+    uint32_t i = hash & KVSTORE_INDEX_MASK;
+
+    while (kv->index[i].offset != 0U) {
+        if (kv->index[i].hash == hash) {
+            if (kvstore_read(kv, kv->active, kv->index[i].offset, buf, KVSTORE_REC_HDR + key_len) == 0U &&
+                (buf[0] == key_len) && (memcmp(&buf[KVSTORE_REC_HDR], key, key_len) == 0)) {
+                return (int32_t)i;
+            }
+        }
+        i = (i + 1U) & KVSTORE_INDEX_MASK;
+    }
+
+    return -1;
+}
+
+static void kvstore_index_insert(kvstore_t *kv, uint32_t hash, uint32_t offset, uint32_t size)
+{
+    uint32_t i = hash & KVSTORE_INDEX_MASK;
+
+    while (kv->index[i].offset != 0U) {
+        i = (i + 1U) & KVSTORE_INDEX_MASK;
+    }
+    kv->index[i].hash = hash;
+    kv->index[i].offset = offset;
+    kv->index[i].size = size;
+    kv->live_keys++;
+    kv->live_bytes += size;
+}
+
+/* 线性探测的回移删除，保证后续探测链不断开 */
+static void kvstore_index_remove(kvstore_t *kv, uint32_t i)
+{
+    uint32_t j = i;
+
+    kv->live_keys--;
+    kv->live_bytes -= kv->index[i].size;
+
+    for (;;) {
+        j = (j + 1U) & KVSTORE_INDEX_MASK;
+        if (kv->index[j].offset == 0U) {
+            break;
+        }
+        uint32_t home = kv->index[j].hash & KVSTORE_INDEX_MASK;
+        uint8_t stays = (i <= j) ? ((home > i) && (home <= j)) : ((home > i) || (home <= j));
+        if (stays != 0U) {
+            continue;
+        }
+        kv->index[i] = kv->index[j];
+        i = j;
+    }
+
+    kv->index[i].hash = 0U;
+    kv->index[i].offset = 0U;
+    kv->index[i].size = 0U;
+}
+
+/* 追加一条记录：先写头再写键值，残缺记录由CRC识别 */
+static kvstore_status_t kvstore_append(kvstore_t *kv, const char *key, uint8_t key_len, uint8_t type,
+                                       const void *value, uint16_t value_len, uint32_t *offset)
+{
+    uint32_t size = kvstore_rec_size(key_len, value_len);
+    uint32_t pos = kv->write_offset;
+    kvstore_rec_hdr_t hdr;
+
+    if (pos + size > kv->backend->sector_size) {
+        return KVSTORE_ERR_NO_SPACE;
+    }
+
+    hdr.key_len = key_len;
+    hdr.type = type;
+    hdr.value_len = value_len;
+    uint32_t crc = kvstore_crc32(0xFFFFFFFFU, (const uint8_t *)&hdr, 4U);
+    crc = kvstore_crc32(crc, (const uint8_t *)key, key_len);
+    crc = kvstore_crc32(crc, (const uint8_t *)value, value_len);
+    hdr.crc = crc ^ 0xFFFFFFFFU;
+
+    /* 无论成功与否该区域都已被占用，失败时把扇区视为写满，下次写入触发回收 */
+    kv->write_offset = pos + size;
+    kv->write_count++;
+    if ((kvstore_prog(kv, kv->active, pos, &hdr, sizeof(hdr)) != 0U) ||
+        (kvstore_prog(kv, kv->active, pos + KVSTORE_REC_HDR, key, key_len) != 0U) ||
+        ((value_len > 0U) &&
+         (kvstore_prog(kv, kv->active, pos + KVSTORE_REC_HDR + key_len, value, value_len) != 0U))) {
+        kv->write_offset = kv->backend->sector_size;
+        return KVSTORE_ERR_IO;
+    }
+
+    *offset = pos;
+    return KVSTORE_OK;
+}
+
+/* 当前值是否与待写值相同，相同则跳过写入以减少磨损 */
+static uint8_t kvstore_value_equal(const kvstore_t *kv, const kvstore_slot_t *slot, uint32_t key_len,
+                                   const uint8_t *value, uint16_t len)
+{
+    uint8_t chunk[KVSTORE_CHUNK];
+
+    if (slot->size != kvstore_rec_size(key_len, len)) {
+        return 0U;
+    }
+
+    kvstore_rec_hdr_t hdr;
+    if ((kvstore_read(kv, kv->active, slot->offset, &hdr, sizeof(hdr)) != 0U) || (hdr.value_len != len)) {
+        return 0U;
+    }
+
+    uint32_t pos = slot->offset + KVSTORE_REC_HDR + key_len;
+    for (uint32_t done = 0; done < len;) {
+        uint32_t n = ((len - done) > KVSTORE_CHUNK) ? KVSTORE_CHUNK : (len - done);
+        if ((kvstore_read(kv, kv->active, pos + done, chunk, n) != 0U) ||
+            (memcmp(chunk, &value[done], n) != 0)) {
+            return 0U;
+        }
+        done += n;
+    }
+
+    return 1U;
+}
+
+static kvstore_status_t kvstore_check_key(const kvstore_t *kv, const char *key, uint32_t *key_len)
+{
+    if ((kv == NULL) || (key == NULL)) {
+        return KVSTORE_ERR_PARAM;
+    }
+    if (kv->mounted == 0U) {
+        return KVSTORE_ERR_NOT_MOUNTED;
+    }
+
+    size_t len = strlen(key);
+    if ((len == 0U) || (len > KVSTORE_KEY_MAX)) {
+        return KVSTORE_ERR_PARAM;
+    }
+
+    *key_len = (uint32_t)len;
+    return KVSTORE_OK;
+}
+
+kvstore_status_t kvstore_format(kvstore_t *kv, const kvstore_backend_t *backend)
+{
+    if ((kv == NULL) || (backend == NULL)) {
+        return KVSTORE_ERR_PARAM;
+    }
+
+    memset(kv, 0, sizeof(*kv));
+    kv->backend = backend;
+
+    for (uint16_t s = 0; s < backend->sector_count; ++s) {
+        if (backend->erase(backend->ctx, s) != 0U) {
+            return KVSTORE_ERR_IO;
+        }
+    }
+
+    const kvstore_sector_hdr_t hdr = {KVSTORE_MAGIC, 1U};
+    if (kvstore_prog(kv, 0U, 0U, &hdr, sizeof(hdr)) != 0U) {
+        return KVSTORE_ERR_IO;
+    }
+
+    kv->active = 0U;
+    kv->seq = 1U;
+    kv->write_offset = KVSTORE_SECTOR_HDR;
+    kv->mounted = 1U;
+    return KVSTORE_OK;
+}
+
+kvstore_status_t kvstore_mount(kvstore_t *kv, const kvstore_backend_t *backend)
+{
+    kvstore_sector_hdr_t sector_hdr;
+    kvstore_rec_hdr_t hdr;
+    char key[KVSTORE_KEY_MAX];
+    int32_t best = -1;
+    uint32_t best_seq = 0U;
+
+    if ((kv == NULL) || (backend == NULL) || (backend->read == NULL) || (backend->prog == NULL) ||
+        (backend->erase == NULL) || (backend->sector_count < 2U) ||
+        (backend->sector_size < (KVSTORE_SECTOR_HDR + kvstore_rec_size(KVSTORE_KEY_MAX, 4U)))) {
+        return KVSTORE_ERR_PARAM;
+    }
+
+    memset(kv, 0, sizeof(*kv));
+    kv->backend = backend;
+
+    /* 取序号最新的有效扇区为活动扇区 */
+    for (uint16_t s = 0; s < backend->sector_count; ++s) {
+        if (kvstore_read(kv, s, 0U, &sector_hdr, sizeof(sector_hdr)) != 0U) {
+            return KVSTORE_ERR_IO;
+        }
+        if ((sector_hdr.magic != KVSTORE_MAGIC) || (sector_hdr.seq == 0xFFFFFFFFU)) {
+            continue;
+        }
+        if ((best < 0) || ((int32_t)(sector_hdr.seq - best_seq) > 0)) {
+            best = (int32_t)s;
+            best_seq = sector_hdr.seq;
+        }
+    }
+
+    if (best < 0) {
+        return kvstore_format(kv, backend);
+    }
+
+    kv->active = (uint16_t)best;
+    kv->seq = best_seq;
+
+    /* 重放日志重建索引 */
+    uint32_t offset = KVSTORE_SECTOR_HDR;
+    for (;;) {
+        int res = kvstore_rec_load(kv, kv->active, offset, &hdr, key);
+        if (res == KVSTORE_REC_IO) {
+            return KVSTORE_ERR_IO;
+        }
+        if (res == KVSTORE_REC_END) {
+            break;
+        }
+        if (res == KVSTORE_REC_CORRUPT) {
+            /* 掉电残留：其后无法安全追加，标记写满，由下次写入触发回收 */
+            offset = backend->sector_size;
+            break;
+        }
+
+        uint32_t hash = kvstore_hash(key, hdr.key_len);
+        uint32_t size = kvstore_rec_size(hdr.key_len, hdr.value_len);
+        int32_t slot = kvstore_find(kv, key, hdr.key_len, hash);
+        if (slot >= 0) {
+            kvstore_index_remove(kv, (uint32_t)slot);
+        }
+        if (hdr.type == KVSTORE_REC_VALUE) {
+            if (kv->live_keys >= KVSTORE_INDEX_LIMIT) {
+                return KVSTORE_ERR_INDEX_FULL;
+            }
+            kvstore_index_insert(kv, hash, offset, size);
+        }
+        offset += size;
+    }
+
+    kv->write_offset = offset;
+    kv->mounted = 1U;
+    return KVSTORE_OK;
+}
+
+kvstore_status_t kvstore_gc(kvstore_t *kv)
+{
+    uint8_t chunk[KVSTORE_CHUNK];
+
+    if (kv == NULL) {
+        return KVSTORE_ERR_PARAM;
+    }
+    if (kv->mounted == 0U) {
+        return KVSTORE_ERR_NOT_MOUNTED;
+    }
+
+    const kvstore_backend_t *be = kv->backend;
+    uint16_t target = (uint16_t)((kv->active + 1U) % be->sector_count);
+
+    kv->gc_count++;
+    if (be->erase(be->ctx, target) != 0U) {
+        return KVSTORE_ERR_IO;
+    }
+
+    /* 第一遍：按槽顺序搬移有效记录 */
+    uint32_t w = KVSTORE_SECTOR_HDR;
+    for (uint32_t i = 0; i < KVSTORE_INDEX_SIZE; ++i) {
+        const kvstore_slot_t *slot = &kv->index[i];
+        if (slot->offset == 0U) {
+            continue;
+        }
+        for (uint32_t done = 0; done < slot->size;) {
+            uint32_t n = ((slot->size - done) > KVSTORE_CHUNK) ? KVSTORE_CHUNK : (slot->size - done);
+            if ((kvstore_read(kv, kv->active, slot->offset + done, chunk, n) != 0U) ||
+                (kvstore_prog(kv, target, w + done, chunk, n) != 0U)) {
+                return KVSTORE_ERR_IO;
+            }
+            done += n;
+        }
+        w += slot->size;
+    }
+
+    /* 最后写扇区头：此前掉电，挂载时仍以旧扇区为准 */
+    const kvstore_sector_hdr_t hdr = {KVSTORE_MAGIC, kv->seq + 1U};
+    if (kvstore_prog(kv, target, 0U, &hdr, sizeof(hdr)) != 0U) {
+        return KVSTORE_ERR_IO;
+    }
+
+    /* 第二遍：以相同顺序更新索引偏移 */
+    w = KVSTORE_SECTOR_HDR;
+    for (uint32_t i = 0; i < KVSTORE_INDEX_SIZE; ++i) {
+        if (kv->index[i].offset != 0U) {
+            kv->index[i].offset = w;
+            w += kv->index[i].size;
+        }
+    }
+
+    kv->active = target;
+    kv->seq++;
+    kv->write_offset = w;
+    return KVSTORE_OK;
+}
+
+kvstore_status_t kvstore_get(kvstore_t *kv, const char *key, void *buf, uint32_t buf_size, uint32_t *len)
+{
+    uint32_t key_len;
+    kvstore_rec_hdr_t hdr;
+    kvstore_status_t status = kvstore_check_key(kv, key, &key_len);
+    if (status != KVSTORE_OK) {
+        return status;
+    }
+
+    int32_t slot = kvstore_find(kv, key, key_len, kvstore_hash(key, key_len));
+    if (slot < 0) {
+        return KVSTORE_ERR_NOT_FOUND;
+    }
+
+    uint32_t offset = kv->index[slot].offset;
+    if (kvstore_read(kv, kv->active, offset, &hdr, sizeof(hdr)) != 0U) {
+        return KVSTORE_ERR_IO;
+    }
+    if (len != NULL) {
+        *len = hdr.value_len;
+    }
+    if (hdr.value_len == 0U) {
+        return KVSTORE_OK;
+    }
+    if ((buf == NULL) || (buf_size < hdr.value_len)) {
+        return KVSTORE_ERR_PARAM;
+    }
+
+    if (kvstore_read(kv, kv->active, offset + KVSTORE_REC_HDR + key_len, buf, hdr.value_len) != 0U) {
+        return KVSTORE_ERR_IO;
+    }
+    return KVSTORE_OK;
+}
+
+kvstore_status_t kvstore_set(kvstore_t *kv, const char *key, const void *value, uint16_t len)
+{
+    uint32_t key_len;
+    uint32_t offset;
+    kvstore_status_t status = kvstore_check_key(kv, key, &key_len);
+    if (status != KVSTORE_OK) {
+        return status;
+    }
+    if ((value == NULL) && (len > 0U)) {
+        return KVSTORE_ERR_PARAM;
+    }
+
+    uint32_t size = kvstore_rec_size(key_len, len);
+    if (KVSTORE_SECTOR_HDR + size > kv->backend->sector_size) {
+        return KVSTORE_ERR_NO_SPACE;
+    }
+
+    uint32_t hash = kvstore_hash(key, key_len);
+    int32_t slot = kvstore_find(kv, key, key_len, hash);
+    if (slot >= 0) {
+        if (kvstore_value_equal(kv, &kv->index[slot], key_len, (const uint8_t *)value, len) != 0U) {
+            return KVSTORE_OK;
+        }
+    } else if (kv->live_keys >= KVSTORE_INDEX_LIMIT) {
+        return KVSTORE_ERR_INDEX_FULL;
+    }
+
+    if (kv->write_offset + size > kv->backend->sector_size) {
+        status = kvstore_gc(kv);
+        if (status != KVSTORE_OK) {
+            return status;
+        }
+        /* 有效数据本身已接近扇区容量 */
+        if (kv->write_offset + size > kv->backend->sector_size) {
+            return KVSTORE_ERR_NO_SPACE;
+        }
+    }
+
+    status = kvstore_append(kv, key, (uint8_t)key_len, KVSTORE_REC_VALUE, value, len, &offset);
+    if (status != KVSTORE_OK) {
+        return status;
+    }
+
+    if (slot >= 0) {
+        kv->live_bytes = kv->live_bytes - kv->index[slot].size + size;
+        kv->index[slot].offset = offset;
+        kv->index[slot].size = size;
+    } else {
+        kvstore_index_insert(kv, hash, offset, size);
+    }
+
+    return KVSTORE_OK;
+}
+
+kvstore_status_t kvstore_del(kvstore_t *kv, const char *key)
+{
+    uint32_t key_len;
+    uint32_t offset;
+    kvstore_status_t status = kvstore_check_key(kv, key, &key_len);
+    if (status != KVSTORE_OK) {
+        return status;
+    }
+
+    int32_t slot = kvstore_find(kv, key, key_len, kvstore_hash(key, key_len));
+    if (slot < 0) {
+        return KVSTORE_ERR_NOT_FOUND;
+    }
+
+    /* 放不下删除标记时直接回收：新扇区不含该键，无需标记 */
+    if (kv->write_offset + kvstore_rec_size(key_len, 0U) > kv->backend->sector_size) {
+        kvstore_index_remove(kv, (uint32_t)slot);
+        return kvstore_gc(kv);
+    }
+
+    status = kvstore_append(kv, key, (uint8_t)key_len, KVSTORE_REC_DELETED, NULL, 0U, &offset);
+    if (status != KVSTORE_OK) {
+        return status;
+    }
+
+    kvstore_index_remove(kv, (uint32_t)slot);
+    return KVSTORE_OK;
+}
+
+void kvstore_get_stats(const kvstore_t *kv, kvstore_stats_t *stats)
+{
+    if ((kv == NULL) || (stats == NULL)) {
+        return;
+    }
+
+    uint32_t sector_size = (kv->backend != NULL) ? kv->backend->sector_size : 0U;
+    stats->used_bytes = kv->write_offset;
+    stats->live_bytes = kv->live_bytes;
+    stats->free_bytes = (kv->write_offset < sector_size) ? (sector_size - kv->write_offset) : 0U;
+    stats->live_keys = kv->live_keys;
+    stats->gc_count = kv->gc_count;
+    stats->write_count = kv->write_count;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file kvstore.h
+ * @brief 日志结构的键值存储：只追加记录 + CRC 校验 + RAM 哈希索引 + 轮转垃圾回收。
+ *
+ * 存储被划分为若干等长扇区，任意时刻只有一个“活动扇区”在追加记录：
+ *   - 扇区头 {magic, seq} 标识扇区有效性与新旧，挂载时取 seq 最大者；
+ *   - 每条记录先写头（含 CRC）再写键值，掉电造成的残缺记录在挂载时被 CRC
+ *     识别并丢弃，因此一次 kv_set 要么完整生效要么完全不生效；
+ *   - 活动扇区写满时，把有效记录搬到下一个扇区，最后才写新扇区头，
+ *     搬移过程中掉电仍以旧扇区为准；扇区按顺序轮转使用以均衡磨损。
+ *
+ * 后端只需提供读、写、擦三个接口，可落在 AT24Cxx 或片内 Flash 上。
+ */
+
+#ifndef KVSTORE_KEY_MAX
+#define KVSTORE_KEY_MAX      16U   /**< 键的最大长度（不含结束符）。 */
+#endif
+
+#ifndef KVSTORE_INDEX_SIZE
+#define KVSTORE_INDEX_SIZE   64U   /**< 哈希索引槽数，必须为2的幂；有效键数上限为其3/4。 */
+#endif
+
+#if (KVSTORE_INDEX_SIZE & (KVSTORE_INDEX_SIZE - 1U)) != 0U
+#error "KVSTORE_INDEX_SIZE 必须为2的幂。"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    KVSTORE_OK = 0,
+    KVSTORE_ERR_PARAM = 1,
+    KVSTORE_ERR_IO = 2,          /**< 后端读写擦失败。 */
+    KVSTORE_ERR_NOT_FOUND = 3,
+    KVSTORE_ERR_NO_SPACE = 4,    /**< 回收后扇区仍放不下该记录。 */
+    KVSTORE_ERR_INDEX_FULL = 5,  /**< 有效键数达到索引上限。 */
+    KVSTORE_ERR_NOT_MOUNTED = 6
+} kvstore_status_t;
+
+/** 存储后端：偏移均相对后端起始地址，返回0表示成功。 */
+typedef struct {
+    uint32_t sector_size;        /**< 擦除单元大小（字节），至少容纳扇区头与一条最大记录。 */
+    uint16_t sector_count;       /**< 扇区数量，至少为2。 */
+    uint8_t (*read)(void *ctx, uint32_t offset, void *buf, uint32_t len);
+    uint8_t (*prog)(void *ctx, uint32_t offset, const void *buf, uint32_t len);
+    uint8_t (*erase)(void *ctx, uint16_t sector); /**< 擦除后内容须为0xFF。 */
+    void *ctx;
+} kvstore_backend_t;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t offset;             /**< 记录在活动扇区内的偏移，0表示空槽。 */
+    uint32_t size;               /**< 记录占用字节数（含头与对齐）。 */
+} kvstore_slot_t;
+
+typedef struct {
+    const kvstore_backend_t *backend;
+    uint16_t active;             /**< 活动扇区号。 */
+    uint32_t seq;                /**< 活动扇区序号。 */
+    uint32_t write_offset;       /**< 下一条记录的写入偏移。 */
+    uint32_t live_bytes;         /**< 有效记录占用字节数。 */
+    uint16_t live_keys;
+    uint8_t mounted;
+    uint32_t gc_count;           /**< 垃圾回收（即扇区擦除）次数，用于评估磨损。 */
+    uint32_t write_count;        /**< 追加记录次数。 */
+    kvstore_slot_t index[KVSTORE_INDEX_SIZE];
+} kvstore_t;
+
+typedef struct {
+    uint32_t used_bytes;         /**< 活动扇区已写入字节。 */
+    uint32_t live_bytes;         /**< 其中仍有效的字节。 */
+    uint32_t free_bytes;         /**< 活动扇区剩余字节。 */
+    uint16_t live_keys;
+    uint32_t gc_count;
+    uint32_t write_count;
+} kvstore_stats_t;
+
+/** 挂载：定位活动扇区并重建索引；存储为空时自动格式化。 */
+kvstore_status_t kvstore_mount(kvstore_t *kv, const kvstore_backend_t *backend);
+
+/** 擦除全部扇区并重新挂载。 */
+kvstore_status_t kvstore_format(kvstore_t *kv, const kvstore_backend_t *backend);
+
+/**
+ * 读取键值。
+ * @param len 输出实际长度，可为NULL；buf_size 小于实际长度时返回 KVSTORE_ERR_PARAM。
+ */
+kvstore_status_t kvstore_get(kvstore_t *kv, const char *key, void *buf, uint32_t buf_size, uint32_t *len);
+
+/** 写入键值；与当前值相同时不产生写入。 */
+kvstore_status_t kvstore_set(kvstore_t *kv, const char *key, const void *value, uint16_t len);
+
+/** 删除键（追加删除标记）。 */
+kvstore_status_t kvstore_del(kvstore_t *kv, const char *key);
+
+/** 立即执行一次垃圾回收。 */
+kvstore_status_t kvstore_gc(kvstore_t *kv);
+
+/** 获取空间与磨损统计。 */
+void kvstore_get_stats(const kvstore_t *kv, kvstore_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
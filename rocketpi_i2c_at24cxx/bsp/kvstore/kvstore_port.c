@@ -0,0 +1,167 @@
+#include "kvstore_port.h"
+
+#include "driver_at24cxx_fast.h"
+#include "driver_at24cxx_interface.h"
+#include "main.h"
+
+#include <string.h>
+
+/**
+ * @file kvstore_port.c
+ * @brief kvstore 存储后端实现。
+ */
+
+/* ---------------- AT24Cxx ---------------- */
+
+typedef struct {
+    at24cxx_handle_t dev;
+    at24cxx_fast_handle_t fast;
+    uint32_t base;
+    uint32_t sector_size;
+} kvstore_at24cxx_ctx_t;
+
+static kvstore_at24cxx_ctx_t s_at24cxx_ctx;
+
+static uint8_t kvstore_at24cxx_read(void *ctx, uint32_t offset, void *buf, uint32_t len)
+{
+    kvstore_at24cxx_ctx_t *c = (kvstore_at24cxx_ctx_t *)ctx;
+    return (at24cxx_fast_read(&c->fast, c->base + offset, (uint8_t *)buf, (uint16_t)len) == 0U) ? 0U : 1U;
+}
+
+static uint8_t kvstore_at24cxx_prog(void *ctx, uint32_t offset, const void *buf, uint32_t len)
+{
+    kvstore_at24cxx_ctx_t *c = (kvstore_at24cxx_ctx_t *)ctx;
+    return (at24cxx_fast_write(&c->fast, c->base + offset, (const uint8_t *)buf, (uint16_t)len) == 0U) ? 0U : 1U;
+}
+
+/* EEPROM 无擦除操作，整扇区写0xFF，与Flash擦除后的状态一致 */
+static uint8_t kvstore_at24cxx_erase(void *ctx, uint16_t sector)
+{
+    kvstore_at24cxx_ctx_t *c = (kvstore_at24cxx_ctx_t *)ctx;
+    uint8_t ones[AT24CXX_FAST_PAGE_MAX];
+    uint32_t address = c->base + (uint32_t)sector * c->sector_size;
+
+    memset(ones, 0xFF, sizeof(ones));
+    for (uint32_t done = 0U; done < c->sector_size; done += c->fast.page_size) {
+        uint32_t n = c->sector_size - done;
+        if (n > c->fast.page_size) {
+            n = c->fast.page_size;
+        }
+        if (at24cxx_fast_write(&c->fast, address + done, ones, (uint16_t)n) != 0U) {
+            return 1U;
+        }
+    }
+
+    return 0U;
+}
+
+uint8_t kvstore_port_at24cxx_init(kvstore_backend_t *backend, at24cxx_t type, at24cxx_address_t address,
+                                  uint32_t base, uint32_t sector_size, uint16_t sector_count)
+{
+    kvstore_at24cxx_ctx_t *c = &s_at24cxx_ctx;
+
+    if ((backend == NULL) || (base + sector_size * sector_count > (uint32_t)type)) {
+        return 1U;
+    }
+
+    DRIVER_AT24CXX_LINK_INIT(&c->dev, at24cxx_handle_t);
+    DRIVER_AT24CXX_LINK_IIC_INIT(&c->dev, at24cxx_interface_iic_init);
+    DRIVER_AT24CXX_LINK_IIC_DEINIT(&c->dev, at24cxx_interface_iic_deinit);
+    DRIVER_AT24CXX_LINK_IIC_READ(&c->dev, at24cxx_interface_iic_read);
+    DRIVER_AT24CXX_LINK_IIC_WRITE(&c->dev, at24cxx_interface_iic_write);
+    DRIVER_AT24CXX_LINK_IIC_READ_ADDRESS16(&c->dev, at24cxx_interface_iic_read_address16);
+    DRIVER_AT24CXX_LINK_IIC_WRITE_ADDRESS16(&c->dev, at24cxx_interface_iic_write_address16);
+    DRIVER_AT24CXX_LINK_DELAY_MS(&c->dev, at24cxx_interface_delay_ms);
+    DRIVER_AT24CXX_LINK_DEBUG_PRINT(&c->dev, at24cxx_interface_debug_print);
+
+    if ((at24cxx_set_type(&c->dev, type) != 0U) ||
+        (at24cxx_set_addr_pin(&c->dev, address) != 0U) ||
+        (at24cxx_init(&c->dev) != 0U)) {
+        return 1U;
+    }
+    if (at24cxx_fast_init(&c->fast, &c->dev, at24cxx_interface_iic_probe) != 0U) {
+        (void)at24cxx_deinit(&c->dev);
+        return 1U;
+    }
+
+    c->base = base;
+    c->sector_size = sector_size;
+
+    backend->sector_size = sector_size;
+    backend->sector_count = sector_count;
+    backend->read = kvstore_at24cxx_read;
+    backend->prog = kvstore_at24cxx_prog;
+    backend->erase = kvstore_at24cxx_erase;
+    backend->ctx = c;
+    return 0U;
+}
+
+/* ---------------- 片内 Flash ---------------- */
+
+static uint8_t kvstore_flash_read(void *ctx, uint32_t offset, void *buf, uint32_t len)
+{
+    (void)ctx;
+    memcpy(buf, (const void *)(KVSTORE_FLASH_BASE + offset), len);
+    return 0U;
+}
+
+/* 对齐部分按字编程，首尾不齐的部分按字节编程 */
+static uint8_t kvstore_flash_prog(void *ctx, uint32_t offset, const void *buf, uint32_t len)
+{
+    const uint8_t *src = (const uint8_t *)buf;
+    uint32_t address = KVSTORE_FLASH_BASE + offset;
+    HAL_StatusTypeDef status = HAL_OK;
+
+    (void)ctx;
+    HAL_FLASH_Unlock();
+    while ((len > 0U) && (status == HAL_OK)) {
+        if (((address & 3U) == 0U) && (len >= 4U)) {
+            uint32_t word;
+            memcpy(&word, src, sizeof(word));
+            status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, word);
+            address += 4U;
+            src += 4U;
+            len -= 4U;
+        } else {
+            status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_BYTE, address, *src);
+            address++;
+            src++;
+            len--;
+        }
+    }
+    HAL_FLASH_Lock();
+
+    return (status == HAL_OK) ? 0U : 1U;
+}
+
+static uint8_t kvstore_flash_erase(void *ctx, uint16_t sector)
+{
+    FLASH_EraseInitTypeDef erase = {0};
+    uint32_t sector_error = 0U;
+
+    (void)ctx;
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Sector = KVSTORE_FLASH_FIRST_SECTOR + sector;
+    erase.NbSectors = 1U;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &sector_error);
+    HAL_FLASH_Lock();
+
+    return (status == HAL_OK) ? 0U : 1U;
+}
+
+void kvstore_port_flash_init(kvstore_backend_t *backend)
+{
+    if (backend == NULL) {
+        return;
+    }
+
+    backend->sector_size = KVSTORE_FLASH_SECTOR_SIZE;
+    backend->sector_count = KVSTORE_FLASH_SECTOR_COUNT;
+    backend->read = kvstore_flash_read;
+    backend->prog = kvstore_flash_prog;
+    backend->erase = kvstore_flash_erase;
+    backend->ctx = NULL;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "kvstore.h"
+#include "driver_at24cxx.h"
+
+/**
+ * @file kvstore_port.h
+ * @brief kvstore 的存储后端：AT24Cxx EEPROM 与 STM32F4 片内 Flash 扇区。
+ */
+
+#ifndef KVSTORE_FLASH_FIRST_SECTOR
+#define KVSTORE_FLASH_FIRST_SECTOR   6U            /**< F401RE 的扇区6/7（各128KB，位于末尾）。 */
+#endif
+
+#ifndef KVSTORE_FLASH_BASE
+#define KVSTORE_FLASH_BASE           0x08040000UL  /**< 扇区6起始地址。 */
+#endif
+
+#ifndef KVSTORE_FLASH_SECTOR_SIZE
+#define KVSTORE_FLASH_SECTOR_SIZE    (128UL * 1024UL)
+#endif
+
+#ifndef KVSTORE_FLASH_SECTOR_COUNT
+#define KVSTORE_FLASH_SECTOR_COUNT   2U
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 在 AT24Cxx 的 [base, base + sector_size * sector_count) 区间上构建后端。
+ * 擦除以写入0xFF实现；页写完成以ACK轮询判断（见 driver_at24cxx_fast）。
+ * @return 0 成功，1 初始化EEPROM失败。
+ */
+uint8_t kvstore_port_at24cxx_init(kvstore_backend_t *backend, at24cxx_t type, at24cxx_address_t address,
+                                  uint32_t base, uint32_t sector_size, uint16_t sector_count);
+
+/**
+ * 使用片内 Flash 的 KVSTORE_FLASH_FIRST_SECTOR 起连续扇区构建后端。
+ * 注意：擦除128KB扇区约需1~2秒，期间CPU从Flash取指会被阻塞。
+ */
+void kvstore_port_flash_init(kvstore_backend_t *backend);
+
+#ifdef __cplusplus
+}
+#endif
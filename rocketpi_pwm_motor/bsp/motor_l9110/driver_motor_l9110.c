@@ -15,6 +15,12 @@
 #define MOTOR_L9110_CHANNEL_IB  TIM_CHANNEL_1
 #define MOTOR_L9110_CHANNEL_IA  TIM_CHANNEL_2
 
+#define MOTOR_L9110_TRAJECTORY_AXIS       0U
+#define MOTOR_L9110_TRAJECTORY_SAMPLE_US  1000U   /* 1 kHz 占空比采样，定时器 1 us 计数 */
+#define MOTOR_L9110_TRAJECTORY_ACCEL      250U    /* 每侧加减速占斜坡时间的 25% */
+
+static uint8_t s_trajectory_ready = 0U;
+
 /* 将 0-100% 占空比换算为 CCR 脉宽 */
 static uint32_t motor_l9110_calc_pulse(uint8_t duty_percent)
 {
@@ -105,3 +111,65 @@ void motor_l9110_brake(void)
 {
     motor_l9110_apply(0U, 0U);
 }
+
+/* 轨迹引擎：INB=CCR1 为突发槽 0，INA=CCR2 为突发槽 1 */
+uint8_t motor_l9110_trajectory_init(void)
+{
+    trajectory_config_t config = {0};
+    uint32_t period = MOTOR_L9110_TIMER->Init.Period + 1U;
+    uint8_t res;
+
+    config.htim = MOTOR_L9110_TIMER;
+    config.burst_base = TIM_DMABASE_CCR1;
+    config.slot_count = 2U;
+    config.axis_count = 1U;
+    config.hold_frames = (uint16_t)(MOTOR_L9110_TRAJECTORY_SAMPLE_US / period);
+    config.samples_per_half = 2U;
+    config.sample_period_us = (uint32_t)config.hold_frames * period;
+    config.axes[MOTOR_L9110_TRAJECTORY_AXIS].type = TRAJECTORY_AXIS_HBRIDGE;
+    config.axes[MOTOR_L9110_TRAJECTORY_AXIS].slot_a = 1U;
+    config.axes[MOTOR_L9110_TRAJECTORY_AXIS].slot_b = 0U;
+    config.axes[MOTOR_L9110_TRAJECTORY_AXIS].min = -(int32_t)period;
+    config.axes[MOTOR_L9110_TRAJECTORY_AXIS].max = (int32_t)period;
+    config.axes[MOTOR_L9110_TRAJECTORY_AXIS].initial = 0;
+
+    res = trajectory_start(&config);
+    s_trajectory_ready = (res == 0U) ? 1U : 0U;
+
+    return res;
+}
+
+uint8_t motor_l9110_ramp_to(int8_t duty_percent, uint32_t ramp_ms, uint16_t blend_ms,
+                            trajectory_profile_t profile)
+{
+    trajectory_segment_t segment;
+    int32_t duty = duty_percent;
+
+    if (s_trajectory_ready == 0U)
+    {
+        return 1U;
+    }
+    if (duty > 100)
+    {
+        duty = 100;
+    }
+    else if (duty < -100)
+    {
+        duty = -100;
+    }
+
+    /* 有符号 CCR：正值输出到 INA，负值输出到 INB */
+    segment.target = (duty >= 0) ? (int32_t)motor_l9110_calc_pulse((uint8_t)duty)
+                                 : -(int32_t)motor_l9110_calc_pulse((uint8_t)(-duty));
+    segment.duration_ms = ramp_ms;
+    segment.accel_permille = MOTOR_L9110_TRAJECTORY_ACCEL;
+    segment.blend_ms = blend_ms;
+    segment.profile = profile;
+
+    return trajectory_enqueue(MOTOR_L9110_TRAJECTORY_AXIS, &segment);
+}
+
+void motor_l9110_ramp_abort(void)
+{
+    (void)trajectory_abort(MOTOR_L9110_TRAJECTORY_AXIS);
+}
@@ -15,6 +15,7 @@ extern "C" {
 
 #include <stdint.h>
 #include "tim.h"
+#include "driver_trajectory.h"
 
 typedef enum
 {
@@ -40,6 +41,25 @@ void motor_l9110_drive_signed(int8_t duty_percent);
 /* 立即刹车（双低） */
 void motor_l9110_brake(void);
 
+/* 启动轨迹引擎：TIM4 更新事件触发 DMA 突发写 CCR1/CCR2，每 1 ms 一个占空比采样
+ * 启动后由 motor_l9110_ramp_to() 排队调速，drive/brake 的直接写入会被 DMA 覆盖
+ * @return 0 成功，1 参数错误，2 DMA 启动失败
+ */
+uint8_t motor_l9110_trajectory_init(void);
+
+/* 排队一段调速斜坡（非阻塞），从上一段的终点占空比过渡到目标占空比
+ * @param duty_percent -100~100，目标占空比，正负代表方向
+ * @param ramp_ms      斜坡时间
+ * @param blend_ms     与上一段重叠的时间，0 表示上一段结束后再开始
+ * @param profile      梯形或 S 曲线
+ * @return 0 成功，1 参数错误/未启动，2 队列已满
+ */
+uint8_t motor_l9110_ramp_to(int8_t duty_percent, uint32_t ramp_ms, uint16_t blend_ms,
+                            trajectory_profile_t profile);
+
+/* 丢弃未执行的斜坡并停在当前占空比 */
+void motor_l9110_ramp_abort(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,6 +21,32 @@ typedef enum
 static motor_l9110_test_state_t s_state = MOTOR_L9110_TEST_FORWARD_SOFT;
 static uint32_t s_state_tick = 0;
 static uint32_t s_state_hold_ms = 0;
+static uint8_t s_ramp_enabled = 0;
+
+/* 各状态对应的斜坡：加速用 S 曲线，刹车用较短的梯形斜坡 */
+static void motor_l9110_test_ramp(motor_l9110_test_state_t state)
+{
+    switch (state)
+    {
+    case MOTOR_L9110_TEST_FORWARD_SOFT:
+        (void)motor_l9110_ramp_to(50, 500U, 0U, TRAJECTORY_PROFILE_SCURVE);
+        break;
+    case MOTOR_L9110_TEST_FORWARD_FAST:
+        (void)motor_l9110_ramp_to(100, 500U, 0U, TRAJECTORY_PROFILE_SCURVE);
+        break;
+    case MOTOR_L9110_TEST_REVERSE_SOFT:
+        (void)motor_l9110_ramp_to(-50, 500U, 0U, TRAJECTORY_PROFILE_SCURVE);
+        break;
+    case MOTOR_L9110_TEST_REVERSE_FAST:
+        (void)motor_l9110_ramp_to(-100, 500U, 0U, TRAJECTORY_PROFILE_SCURVE);
+        break;
+    case MOTOR_L9110_TEST_BRAKE_FROM_FWD:
+    case MOTOR_L9110_TEST_BRAKE_FROM_REV:
+    default:
+        (void)motor_l9110_ramp_to(0, 200U, 0U, TRAJECTORY_PROFILE_TRAPEZOID);
+        break;
+    }
+}
 
 /* 切换到新状态
  * @param next_state 目标状态
@@ -33,6 +59,13 @@ static void motor_l9110_test_enter(motor_l9110_test_state_t next_state, uint32_t
     s_state_hold_ms = hold_ms;
     s_state_tick = HAL_GetTick();
 
+    /* 轨迹引擎可用时用 S 曲线斜坡过渡，否则直接跳变占空比 */
+    if (s_ramp_enabled != 0U)
+    {
+        motor_l9110_test_ramp(next_state);
+        return;
+    }
+
     switch (next_state)
     {
     case MOTOR_L9110_TEST_FORWARD_SOFT:
@@ -61,6 +94,7 @@ void motor_l9110_test_init(void)
 {
     /* 初始化驱动后进入初始状态 */
     motor_l9110_init();
+    s_ramp_enabled = (motor_l9110_trajectory_init() == 0U) ? 1U : 0U;
     motor_l9110_test_enter(MOTOR_L9110_TEST_FORWARD_SOFT, 2000);
 }
 
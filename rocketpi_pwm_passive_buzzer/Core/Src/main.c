@@ -26,6 +26,7 @@
 /* USER CODE BEGIN Includes */
 #include "driver_buzzer_test.h"
 #include "driver_buzzer_songs.h"
+#include "driver_buzzer_sequencer.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -96,7 +97,8 @@ int main(void)
 	HAL_Delay(100);
 	buzzer_test_beep(2700,50,200);
 	HAL_Delay(500);
-	buzzer_test_play_sequence(buzzer_song_ode_to_joy, 300, 300);
+	/* Queued playback: TIM3 update interrupt steps through the notes, main loop stays free */
+	buzzer_seq_enqueue(buzzer_song_ode_to_joy, BUZZER_SONG_ODE_TO_JOY_LENGTH, 300U);
 
 
 
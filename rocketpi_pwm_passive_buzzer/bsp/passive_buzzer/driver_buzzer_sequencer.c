@@ -0,0 +1,326 @@
+/**
+ * @file      driver_buzzer_sequencer.c
+ * @brief     Non-blocking TIM3 melody sequencer for the passive buzzer
+ * @version   1.0.0
+ */
+
+#include "driver_buzzer_sequencer.h"
+
+#include "tim.h"
+
+#include <stddef.h>
+
+#define BUZZER_SEQ_TIMER_MAX_PERIOD_TICKS         0x10000UL
+#define BUZZER_SEQ_TIMER_MAX_PRESCALER            0x10000UL
+#define BUZZER_SEQ_STEP_MASK                      (BUZZER_SEQ_STEP_CAPACITY - 1U)
+
+static buzzer_seq_step_t s_steps[BUZZER_SEQ_STEP_CAPACITY];
+static volatile uint32_t s_head = 0U;        /* written by enqueue */
+static volatile uint32_t s_tail = 0U;        /* advanced by the update interrupt */
+static volatile uint8_t s_playing = 0U;
+static volatile uint8_t s_draining = 0U;     /* last step done, silence latched, stop on next update */
+static uint32_t s_remaining = 0U;            /* update events left in the current step */
+static buzzer_seq_step_t s_current;
+static uint16_t s_tempo_percent = 100U;
+static uint8_t s_release_percent = 0U;
+
+static uint32_t buzzer_seq_get_timer_clock(void)
+{
+    RCC_ClkInitTypeDef clk_config;
+    uint32_t flash_latency;
+    uint32_t pclk1;
+
+    HAL_RCC_GetClockConfig(&clk_config, &flash_latency);
+    pclk1 = HAL_RCC_GetPCLK1Freq();
+
+    if (clk_config.APB1CLKDivider == RCC_HCLK_DIV1)
+    {
+        return pclk1;
+    }
+
+    return pclk1 * 2U;
+}
+
+uint8_t buzzer_seq_build_step(uint32_t timer_clock_hz, uint32_t frequency_hz, uint8_t duty_percent,
+                              uint32_t duration_ms, buzzer_seq_step_t *step)
+{
+    uint32_t ticks;
+    uint32_t prescaler = 1U;
+    uint32_t compare;
+    uint64_t periods;
+
+    if ((step == NULL) || (timer_clock_hz == 0U))
+    {
+        return 1U;
+    }
+
+    if (frequency_hz == 0U)
+    {
+        frequency_hz = BUZZER_SEQ_REST_FREQUENCY_HZ;
+        duty_percent = 0U;
+    }
+    else
+    {
+        if (duty_percent == 0U)
+        {
+            duty_percent = BUZZER_TEST_DEFAULT_DUTY_PERCENT;
+        }
+        if (duty_percent > BUZZER_TEST_MAX_DUTY_PERCENT)
+        {
+            duty_percent = BUZZER_TEST_MAX_DUTY_PERCENT;
+        }
+    }
+
+    ticks = (timer_clock_hz + (frequency_hz / 2U)) / frequency_hz;
+    if (ticks == 0U)
+    {
+        ticks = 1U;
+    }
+    if (ticks > BUZZER_SEQ_TIMER_MAX_PERIOD_TICKS)
+    {
+        prescaler = (ticks + BUZZER_SEQ_TIMER_MAX_PERIOD_TICKS - 1U) / BUZZER_SEQ_TIMER_MAX_PERIOD_TICKS;
+        if (prescaler > BUZZER_SEQ_TIMER_MAX_PRESCALER)
+        {
+            prescaler = BUZZER_SEQ_TIMER_MAX_PRESCALER;
+        }
+        ticks = (ticks + prescaler - 1U) / prescaler;
+        if (ticks > BUZZER_SEQ_TIMER_MAX_PERIOD_TICKS)
+        {
+            ticks = BUZZER_SEQ_TIMER_MAX_PERIOD_TICKS;
+        }
+    }
+
+    compare = (ticks * duty_percent) / 100U;
+    if ((compare > 0U) && (compare >= ticks))
+    {
+        /* Keep the compare register strictly inside the counter range */
+        compare = ticks - 1U;
+    }
+
+    /* Count whole PWM periods of the frequency actually produced */
+    periods = ((uint64_t)duration_ms * timer_clock_hz) / (1000ULL * prescaler * ticks);
+    if (periods == 0ULL)
+    {
+        periods = 1ULL;
+    }
+
+    step->psc = (uint16_t)(prescaler - 1U);
+    step->arr = (uint16_t)(ticks - 1U);
+    step->ccr = (uint16_t)compare;
+    step->release = 0U;
+    step->periods = (periods > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32_t)periods;
+
+    return 0U;
+}
+
+/**
+ * @brief Write a step into the preload registers, it becomes active on the next update event
+ */
+static void buzzer_seq_load(const buzzer_seq_step_t *step)
+{
+    s_current = *step;
+    s_remaining = step->periods;
+    htim3.Instance->PSC = step->psc;
+    htim3.Instance->ARR = step->arr;
+    htim3.Instance->CCR3 = step->ccr;
+}
+
+static void buzzer_seq_halt(void)
+{
+    (void)HAL_TIM_PWM_Stop(&htim3, TIM_CHANNEL_3);
+    (void)HAL_TIM_Base_Stop_IT(&htim3);
+    htim3.Instance->CCR3 = 0U;
+    /* Hand the timer back to the blocking helpers with CubeMX's unbuffered ARR */
+    htim3.Instance->CR1 &= ~TIM_CR1_ARPE;
+    s_draining = 0U;
+    s_playing = 0U;
+}
+
+/**
+ * @brief Start the timer on the step at the queue tail (caller holds interrupts off)
+ */
+static uint8_t buzzer_seq_start(void)
+{
+    buzzer_seq_load(&s_steps[s_tail & BUZZER_SEQ_STEP_MASK]);
+    s_tail++;
+
+    /* Buffer ARR and CCR3 so that new values only apply at period boundaries */
+    htim3.Instance->CR1 |= TIM_CR1_ARPE;
+    htim3.Instance->CCMR2 |= TIM_CCMR2_OC3PE;
+    htim3.Instance->CNT = 0U;
+    htim3.Instance->EGR = TIM_EGR_UG;
+    __HAL_TIM_CLEAR_FLAG(&htim3, TIM_FLAG_UPDATE);
+    htim3.Init.Prescaler = s_current.psc;
+    htim3.Init.Period = s_current.arr;
+
+    s_draining = 0U;
+    s_playing = 1U;
+    if ((HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_3) != HAL_OK) ||
+        (HAL_TIM_Base_Start_IT(&htim3) != HAL_OK))
+    {
+        buzzer_seq_halt();
+
+        return 1U;
+    }
+
+    return 0U;
+}
+
+uint8_t buzzer_seq_enqueue(const buzzer_test_note_t *notes, uint32_t length, uint32_t gap_ms)
+{
+    const uint32_t gap = (gap_ms == 0U) ? BUZZER_TEST_DEFAULT_NOTE_GAP_MS : gap_ms;
+    const uint32_t clock = buzzer_seq_get_timer_clock();
+    uint32_t head = s_head;
+    uint32_t needed = 0U;
+    uint32_t primask;
+    uint8_t res = 0U;
+
+    if ((notes == NULL) || (length == 0U))
+    {
+        return 1U;
+    }
+
+    for (uint32_t i = 0U; i < length; ++i)
+    {
+        needed += ((gap > 0U) && (i + 1U < length)) ? 2U : 1U;
+    }
+    if (needed > buzzer_seq_free_steps())
+    {
+        return 2U;
+    }
+
+    for (uint32_t i = 0U; i < length; ++i)
+    {
+        buzzer_seq_step_t *step = &s_steps[head & BUZZER_SEQ_STEP_MASK];
+        uint32_t duration = (notes[i].duration_ms == 0U) ? BUZZER_TEST_DEFAULT_DURATION_MS : notes[i].duration_ms;
+
+        duration = (uint32_t)(((uint64_t)duration * 100U) / s_tempo_percent);
+        if (buzzer_seq_build_step(clock, notes[i].frequency_hz, notes[i].duty_percent, duration, step) != 0U)
+        {
+            return 1U;
+        }
+        if ((notes[i].frequency_hz != 0U) && (s_release_percent > 0U))
+        {
+            uint32_t release = (uint32_t)(((uint64_t)step->periods * s_release_percent) / 100U);
+            step->release = (uint16_t)((release > 0xFFFFU) ? 0xFFFFU : release);
+        }
+        head++;
+
+        if ((gap > 0U) && (i + 1U < length))
+        {
+            duration = (uint32_t)(((uint64_t)gap * 100U) / s_tempo_percent);
+            (void)buzzer_seq_build_step(clock, 0U, 0U, duration, &s_steps[head & BUZZER_SEQ_STEP_MASK]);
+            head++;
+        }
+    }
+
+    /* Publish the steps; start the timer if the interrupt has already stopped it */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    s_head = head;
+    if (s_playing == 0U)
+    {
+        res = (buzzer_seq_start() == 0U) ? 0U : 3U;
+    }
+    __set_PRIMASK(primask);
+
+    return res;
+}
+
+uint8_t buzzer_seq_set_tempo(uint16_t percent)
+{
+    if (percent == 0U)
+    {
+        return 1U;
+    }
+
+    s_tempo_percent = percent;
+
+    return 0U;
+}
+
+uint8_t buzzer_seq_set_envelope(uint8_t release_percent)
+{
+    if (release_percent > 100U)
+    {
+        return 1U;
+    }
+
+    s_release_percent = release_percent;
+
+    return 0U;
+}
+
+uint8_t buzzer_seq_stop(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    s_tail = s_head;
+    if (s_playing != 0U)
+    {
+        buzzer_seq_halt();
+    }
+    __set_PRIMASK(primask);
+
+    return 0U;
+}
+
+uint8_t buzzer_seq_is_playing(void)
+{
+    return s_playing;
+}
+
+uint32_t buzzer_seq_free_steps(void)
+{
+    return BUZZER_SEQ_STEP_CAPACITY - (s_head - s_tail);
+}
+
+/**
+ * @brief TIM3 update event: count down the current step and load the next one at its end
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if ((htim->Instance != TIM3) || (s_playing == 0U))
+    {
+        return;
+    }
+
+    if (s_draining != 0U)
+    {
+        /* Silence is now active; resume if more steps arrived meanwhile */
+        if (s_tail != s_head)
+        {
+            s_draining = 0U;
+            buzzer_seq_load(&s_steps[s_tail & BUZZER_SEQ_STEP_MASK]);
+            s_tail++;
+        }
+        else
+        {
+            buzzer_seq_halt();
+        }
+        return;
+    }
+
+    if (s_remaining > 1U)
+    {
+        s_remaining--;
+        if (s_remaining <= s_current.release)
+        {
+            /* Linear release: duty falls to zero over the last 'release' periods */
+            htim3.Instance->CCR3 = ((uint32_t)s_current.ccr * (s_remaining - 1U)) / s_current.release;
+        }
+        return;
+    }
+
+    if (s_tail != s_head)
+    {
+        buzzer_seq_load(&s_steps[s_tail & BUZZER_SEQ_STEP_MASK]);
+        s_tail++;
+    }
+    else
+    {
+        htim3.Instance->CCR3 = 0U;
+        s_draining = 1U;
+    }
+}
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_buzzer_sequencer.h
+ * @brief     Non-blocking TIM3 melody sequencer for the passive buzzer
+ * @version   1.0.0
+ * @date      2025-11-22
+ *
+ * Note lists are converted once, at enqueue time, into PSC/ARR/CCR steps with
+ * a period count. The TIM3 update interrupt then walks the step queue: it only
+ * decrements a counter on most periods and writes the next preloaded
+ * PSC/ARR/CCR triple at note boundaries, so the CPU stays free while a song
+ * is playing. Do not mix with the blocking buzzer_test_* helpers while the
+ * sequencer is running.
+ */
+
+#ifndef DRIVER_BUZZER_SEQUENCER_H
+#define DRIVER_BUZZER_SEQUENCER_H
+
+#include "driver_buzzer_test.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Capacity of the precomputed step queue, must be a power of two
+ *
+ * Every note takes one step, plus one more when a gap follows it.
+ */
+#ifndef BUZZER_SEQ_STEP_CAPACITY
+#define BUZZER_SEQ_STEP_CAPACITY                  256U
+#endif
+
+/**
+ * @brief Carrier frequency used to time rests and gaps (Hz), output is held low
+ */
+#ifndef BUZZER_SEQ_REST_FREQUENCY_HZ
+#define BUZZER_SEQ_REST_FREQUENCY_HZ              1000U
+#endif
+
+#if (BUZZER_SEQ_STEP_CAPACITY & (BUZZER_SEQ_STEP_CAPACITY - 1U)) != 0U
+#error "BUZZER_SEQ_STEP_CAPACITY must be a power of two"
+#endif
+
+/**
+ * @brief One precomputed timer step
+ */
+typedef struct
+{
+    uint16_t psc;      /**< Prescaler register value */
+    uint16_t arr;      /**< Auto-reload register value */
+    uint16_t ccr;      /**< Compare value at the start of the step (0 for silence) */
+    uint16_t release;  /**< Trailing periods over which the duty ramps down to 0 */
+    uint32_t periods;  /**< Step length in PWM periods */
+} buzzer_seq_step_t;
+
+/**
+ * @brief     Convert a note list into steps and append it to the playback queue
+ * @param[in] notes  Pointer to an array of @ref buzzer_test_note_t descriptors
+ * @param[in] length Number of entries in the notes array
+ * @param[in] gap_ms Pause added between successive notes (0 selects the default)
+ * @return    Status code
+ *            - 0 success, playback starts immediately when idle
+ *            - 1 invalid parameters
+ *            - 2 not enough free steps, nothing was queued
+ *            - 3 HAL error while starting the timer
+ */
+uint8_t buzzer_seq_enqueue(const buzzer_test_note_t *notes, uint32_t length, uint32_t gap_ms);
+
+/**
+ * @brief     Set the tempo applied to songs enqueued afterwards
+ * @param[in] percent Playback speed in percent (100 plays as written, 200 twice as fast)
+ * @return    Status code
+ *            - 0 success
+ *            - 1 percent is 0
+ */
+uint8_t buzzer_seq_set_tempo(uint16_t percent);
+
+/**
+ * @brief     Set the release envelope applied to notes enqueued afterwards
+ * @param[in] release_percent Share of every note (0..100) during which the duty fades to silence
+ * @return    Status code
+ *            - 0 success
+ *            - 1 value above 100
+ */
+uint8_t buzzer_seq_set_envelope(uint8_t release_percent);
+
+/**
+ * @brief  Stop playback immediately and drop all queued steps
+ * @return Status code
+ *         - 0 success
+ *         - 1 HAL error
+ */
+uint8_t buzzer_seq_stop(void);
+
+/**
+ * @brief  Query whether the sequencer is playing
+ * @return 1 while playing, 0 when idle
+ */
+uint8_t buzzer_seq_is_playing(void);
+
+/**
+ * @brief  Number of free entries in the step queue
+ * @return Free step count
+ */
+uint32_t buzzer_seq_free_steps(void);
+
+/**
+ * @brief     Build a single step (exposed for inspection and host-side checks)
+ * @param[in] timer_clock_hz Timer input clock in Hertz
+ * @param[in] frequency_hz   Tone frequency (0 for silence)
+ * @param[in] duty_percent   Duty cycle (0 selects the default)
+ * @param[in] duration_ms    Step length in milliseconds
+ * @param[out] step          Receives the computed step
+ * @return    Status code
+ *            - 0 success
+ *            - 1 invalid parameters
+ */
+uint8_t buzzer_seq_build_step(uint32_t timer_clock_hz, uint32_t frequency_hz, uint8_t duty_percent,
+                              uint32_t duration_ms, buzzer_seq_step_t *step);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -95,7 +95,8 @@ int main(void)
   /* USER CODE BEGIN 2 */
   SG90_Test_Init();
 //	SG90_Test_Sweep(500);
-	SG90_Test_Scan(2);
+//	SG90_Test_Scan(2);
+  SG90_Test_TrajectoryInit();
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -105,6 +106,7 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+    SG90_Test_ScanTask(1500U);
   }
   /* USER CODE END 3 */
 }
@@ -61,6 +61,9 @@ void uart_puts(const char *s);
 
 /**
  * @brief printf 风格的调试 UART 输出辅助。
+ *
+ * 由 debug_format 格式化：浮点只支持 %f %F，%e %g %a 与 %n 原样输出。
+ * 不超过 UART_LOG_LINE_SIZE（含 CRLF 展开）的输出一次写入发送路径。
  * @param fmt 格式化描述字符串。
  * @return 预期写入的字符数，错误返回负值。
  */
@@ -1,4 +1,5 @@
 #include "driver_sg90_test.h"
+#include "driver_trajectory.h"
 
 #include "tim.h"
 #include "usart.h"
@@ -138,3 +139,110 @@ void SG90_Test_Scan(uint32_t step_delay_ms)
         }
     }
 }
+
+#define SG90_TRAJECTORY_AXIS         0U
+#define SG90_TRAJECTORY_ACCEL        300U   /* ramp takes 30 % of each move per side */
+#define SG90_LOG_STEP_CENTIDEG       500U
+
+static uint8_t s_trajectory_ready;
+static uint16_t s_logged_centideg = 0xFFFFU;
+
+uint16_t SG90_Test_AngleToPulse(uint16_t angle_centideg)
+{
+    if (angle_centideg > 18000U)
+    {
+        angle_centideg = 18000U;
+    }
+
+    return (uint16_t)(SG90_MIN_PULSE_US +
+                      (((uint32_t)angle_centideg * (SG90_MAX_PULSE_US - SG90_MIN_PULSE_US) + 9000U) / 18000U));
+}
+
+HAL_StatusTypeDef SG90_Test_TrajectoryInit(void)
+{
+    trajectory_config_t config = {0};
+
+    config.htim = &htim3;
+    config.burst_base = TIM_DMABASE_CCR4;
+    config.slot_count = 1U;
+    config.axis_count = 1U;
+    config.hold_frames = 1U;            /* one new pulse width per 20 ms servo frame */
+    config.samples_per_half = 4U;       /* refill callback every 80 ms */
+    config.sample_period_us = SG90_FRAME_PERIOD_US;
+    config.axes[SG90_TRAJECTORY_AXIS].type = TRAJECTORY_AXIS_SERVO;
+    config.axes[SG90_TRAJECTORY_AXIS].slot_a = 0U;
+    config.axes[SG90_TRAJECTORY_AXIS].min = SG90_MIN_PULSE_US;
+    config.axes[SG90_TRAJECTORY_AXIS].max = SG90_MAX_PULSE_US;
+    config.axes[SG90_TRAJECTORY_AXIS].initial = (int32_t)__HAL_TIM_GET_COMPARE(&htim3, TIM_CHANNEL_4);
+
+    if (trajectory_start(&config) != 0U)
+    {
+        return HAL_ERROR;
+    }
+    s_trajectory_ready = 1U;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef SG90_Test_MoveTo(uint16_t angle_centideg, uint32_t duration_ms, uint16_t blend_ms)
+{
+    trajectory_segment_t segment;
+
+    if (s_trajectory_ready == 0U)
+    {
+        return HAL_ERROR;
+    }
+
+    segment.target = SG90_Test_AngleToPulse(angle_centideg);
+    segment.duration_ms = duration_ms;
+    segment.accel_permille = SG90_TRAJECTORY_ACCEL;
+    segment.blend_ms = blend_ms;
+    segment.profile = TRAJECTORY_PROFILE_SCURVE;
+
+    return (trajectory_enqueue(SG90_TRAJECTORY_AXIS, &segment) == 0U) ? HAL_OK : HAL_BUSY;
+}
+
+static void log_centideg(uint16_t angle_centideg)
+{
+    if (huart2.gState != HAL_UART_STATE_READY)
+    {
+        return;
+    }
+
+    uint8_t next_buffer = uart_active_buffer ^ 1U;
+    int len = snprintf(uart_log_buffer[next_buffer], sizeof(uart_log_buffer[next_buffer]),
+                       "SG90 angle: %u.%02u\r\n", angle_centideg / 100U, angle_centideg % 100U);
+    if (len <= 0)
+    {
+        return;
+    }
+
+    if (HAL_UART_Transmit_DMA(&huart2,
+                              (uint8_t *)uart_log_buffer[next_buffer],
+                              (uint16_t)len) == HAL_OK)
+    {
+        uart_active_buffer = next_buffer;
+    }
+}
+
+void SG90_Test_ScanTask(uint32_t sweep_ms)
+{
+    uint32_t pulse;
+    uint16_t angle;
+
+    /* Keep one full 0 -> 180 -> 0 cycle queued ahead of the DMA stream */
+    if (trajectory_free_segments(SG90_TRAJECTORY_AXIS) >= 2U)
+    {
+        (void)SG90_Test_MoveTo(18000U, sweep_ms, 0U);
+        (void)SG90_Test_MoveTo(0U, sweep_ms, 0U);
+    }
+
+    pulse = (uint32_t)trajectory_get_position(SG90_TRAJECTORY_AXIS);
+    angle = (uint16_t)(((pulse - SG90_MIN_PULSE_US) * 18000U) / (SG90_MAX_PULSE_US - SG90_MIN_PULSE_US));
+    angle -= angle % SG90_LOG_STEP_CENTIDEG;
+    if (angle != s_logged_centideg)
+    {
+        s_logged_centideg = angle;
+        log_centideg(angle);
+    }
+}
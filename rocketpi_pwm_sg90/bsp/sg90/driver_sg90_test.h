@@ -54,6 +54,36 @@ void SG90_Test_Sweep(uint32_t dwell_ms);
  */
 void SG90_Test_Scan(uint32_t step_delay_ms);
 
+/**
+ * @brief Convert an angle to a pulse width using integer math only.
+ * @param angle_centideg Angle in 0.01 degree units, saturated to 0-18000.
+ * @return Pulse width in microseconds (equal to the TIM3 CCR value).
+ */
+uint16_t SG90_Test_AngleToPulse(uint16_t angle_centideg);
+
+/**
+ * @brief Hand TIM3 CH4 over to the trajectory engine: the compare register is
+ *        refreshed by DMA on every 20 ms update event from a precomputed table.
+ *        Call after SG90_Test_Init(); SetPulse/SetAngle are overwritten afterwards.
+ */
+HAL_StatusTypeDef SG90_Test_TrajectoryInit(void);
+
+/**
+ * @brief Queue an S-curve move; returns immediately.
+ * @param angle_centideg Target angle in 0.01 degree units.
+ * @param duration_ms    Move time.
+ * @param blend_ms       Overlap with the previous move, 0 to stop in between.
+ * @return HAL_BUSY when the segment queue is full, HAL_ERROR before TrajectoryInit.
+ */
+HAL_StatusTypeDef SG90_Test_MoveTo(uint16_t angle_centideg, uint32_t duration_ms, uint16_t blend_ms);
+
+/**
+ * @brief Non-blocking replacement for SG90_Test_Scan(): keeps 0-180-0 moves queued
+ *        and logs the angle every 5 degrees. Call from the main loop.
+ * @param sweep_ms Time for one 0-180 sweep.
+ */
+void SG90_Test_ScanTask(uint32_t sweep_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,439 @@
+/**
+ * @file driver_trajectory.c
+ * @brief 定点轨迹生成与循环 DMA 突发输出实现。
+ *
+ * 轴位置 = 基准位置 + Σ(各活动段位移 × 归一化曲线 s_i(t))，s_i 为 Q16 格式。
+ * 通常只有一个活动段；混合窗口内下一段提前开始，两段位移叠加，
+ * 速度在拐角处平滑过渡而不必停下。
+ */
+
+#include "driver_trajectory.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/** @brief Q16 格式的 1.0。 */
+#define TRAJECTORY_Q16_ONE          65536U
+
+/** @brief 一次突发最多写入的 CCR 个数（CCR1..CCR4）。 */
+#define TRAJECTORY_MAX_SLOTS        4U
+
+#define TRAJECTORY_QUEUE_MASK       (TRAJECTORY_QUEUE_DEPTH - 1U)
+
+/**
+ * @brief 已换算为采样数的运动段。
+ */
+typedef struct
+{
+    int32_t displacement;               /**< 相对上一段终点的位移 */
+    uint32_t total;                     /**< 总采样数 */
+    uint32_t accel;                     /**< 单侧斜坡采样数 */
+    uint32_t blend;                     /**< 与上一段重叠的采样数 */
+    uint32_t elapsed;                   /**< 已输出的采样数 */
+    trajectory_profile_t profile;
+} trajectory_motion_t;
+
+/**
+ * @brief 单轴运行状态。
+ */
+typedef struct
+{
+    trajectory_motion_t queue[TRAJECTORY_QUEUE_DEPTH];
+    volatile uint32_t head;             /**< 由 trajectory_enqueue() 推进 */
+    volatile uint32_t tail;             /**< 由 DMA 回调推进 */
+    trajectory_motion_t active[2];      /**< 运行中的段与正在混入的下一段 */
+    uint8_t active_count;
+    int32_t base;                       /**< 已完成各段累加后的位置 */
+    int32_t planned_end;                /**< 全部排队段执行完后的位置 */
+    volatile int32_t position;          /**< 最近生成的采样 */
+} trajectory_axis_t;
+
+static trajectory_config_t s_config;
+static trajectory_axis_t s_axes[TRAJECTORY_MAX_AXES];
+/** @brief 循环 DMA 表（两个半区），按帧交错存放各槽位的 CCR 值。 */
+static uint32_t s_dma_buf[TRAJECTORY_DMA_BUFFER_WORDS];
+static uint32_t s_dma_words = 0U;
+static volatile uint8_t s_running = 0U;
+
+/**
+ * @brief 归一化曲线值，t^2 与 x^4 项用 64 位中间量保持精确。
+ */
+uint32_t trajectory_profile_q16(trajectory_profile_t profile, uint32_t t, uint32_t total, uint32_t accel)
+{
+    uint64_t cruise;
+    uint32_t rest;
+
+    if ((total == 0U) || (t >= total))
+    {
+        return TRAJECTORY_Q16_ONE;
+    }
+    if (accel > (total / 2U))
+    {
+        accel = total / 2U;
+    }
+    if (accel == 0U)
+    {
+        return (uint32_t)(((uint64_t)t * TRAJECTORY_Q16_ONE) / total);
+    }
+
+    /* 两种形状的峰值速度都是 1 / (total - accel)，每个斜坡走过 accel / 2 */
+    cruise = total - accel;
+    if ((t > accel) && (t < (total - accel)))
+    {
+        return (uint32_t)((((uint64_t)(2U * t - accel)) * TRAJECTORY_Q16_ONE) / (2U * cruise));
+    }
+
+    rest = (t <= accel) ? t : (total - t);
+    if (profile == TRAJECTORY_PROFILE_SCURVE)
+    {
+        /* 斜坡上速度按 smoothstep(x) 变化，位置积分为 x^3 - x^4 / 2 */
+        /* x 为 Q16，x^3、x^4 保留到 Q32，否则长斜坡上截断误差会使相邻采样倒退 1 */
+        uint64_t x = ((uint64_t)rest * TRAJECTORY_Q16_ONE) / accel;
+        uint64_t x3 = (x * x * x) >> 16;
+        uint64_t x4 = (x3 * x) >> 16;
+        uint64_t ramp = (((x3 - (x4 / 2U)) * accel) / cruise) >> 16;
+
+        return (t <= accel) ? (uint32_t)ramp : (uint32_t)(TRAJECTORY_Q16_ONE - ramp);
+    }
+    else
+    {
+        uint64_t ramp = ((uint64_t)rest * rest * TRAJECTORY_Q16_ONE) / (2U * (uint64_t)accel * cruise);
+
+        return (t <= accel) ? (uint32_t)ramp : (uint32_t)(TRAJECTORY_Q16_ONE - ramp);
+    }
+}
+
+/**
+ * @brief 毫秒换算为采样数（四舍五入）。
+ */
+static uint32_t trajectory_ms_to_samples(uint32_t ms)
+{
+    return (uint32_t)((((uint64_t)ms * 1000U) + (s_config.sample_period_us / 2U)) / s_config.sample_period_us);
+}
+
+/**
+ * @brief 把位置限制在轴的 [min, max] 范围内。
+ */
+static int32_t trajectory_clamp(const trajectory_axis_config_t *cfg, int32_t value)
+{
+    if (value < cfg->min)
+    {
+        return cfg->min;
+    }
+    if (value > cfg->max)
+    {
+        return cfg->max;
+    }
+    return value;
+}
+
+/**
+ * @brief 单轴前进一个采样（DMA 回调上下文）。
+ * @param axis 轴状态。
+ * @return 未限幅的位置。
+ */
+static int32_t trajectory_axis_step(trajectory_axis_t *axis)
+{
+    int32_t position;
+    uint8_t i;
+
+    if ((axis->active_count == 0U) && (axis->tail != axis->head))
+    {
+        axis->active[0] = axis->queue[axis->tail & TRAJECTORY_QUEUE_MASK];
+        axis->active_count = 1U;
+        axis->tail++;
+    }
+    if ((axis->active_count == 1U) && (axis->tail != axis->head))
+    {
+        const trajectory_motion_t *next = &axis->queue[axis->tail & TRAJECTORY_QUEUE_MASK];
+
+        if (next->blend >= (axis->active[0].total - axis->active[0].elapsed))
+        {
+            axis->active[1] = *next;
+            axis->active_count = 2U;
+            axis->tail++;
+        }
+    }
+
+    position = axis->base;
+    for (i = 0U; i < axis->active_count; i++)
+    {
+        trajectory_motion_t *m = &axis->active[i];
+        uint32_t s;
+
+        m->elapsed++;
+        s = trajectory_profile_q16(m->profile, m->elapsed, m->total, m->accel);
+        position += (int32_t)(((int64_t)m->displacement * s) / (int64_t)TRAJECTORY_Q16_ONE);
+    }
+
+    /* 已结束的段并入基准位置 */
+    i = 0U;
+    while (i < axis->active_count)
+    {
+        if (axis->active[i].elapsed >= axis->active[i].total)
+        {
+            axis->base += axis->active[i].displacement;
+            if ((i == 0U) && (axis->active_count == 2U))
+            {
+                axis->active[0] = axis->active[1];
+            }
+            axis->active_count--;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return position;
+}
+
+/**
+ * @brief 生成一个半区：各轴逐采样前进，并按零阶保持重复 hold_frames 帧。
+ * @param half 半区起始地址。
+ */
+static void trajectory_fill(uint32_t *half)
+{
+    const uint32_t slots = s_config.slot_count;
+    uint32_t *out = half;
+
+    for (uint32_t sample = 0U; sample < s_config.samples_per_half; sample++)
+    {
+        uint32_t frame[TRAJECTORY_MAX_SLOTS] = {0U};
+
+        for (uint8_t a = 0U; a < s_config.axis_count; a++)
+        {
+            const trajectory_axis_config_t *cfg = &s_config.axes[a];
+            int32_t position = trajectory_clamp(cfg, trajectory_axis_step(&s_axes[a]));
+
+            s_axes[a].position = position;
+            if (cfg->type == TRAJECTORY_AXIS_HBRIDGE)
+            {
+                frame[cfg->slot_a] = (position > 0) ? (uint32_t)position : 0U;
+                frame[cfg->slot_b] = (position < 0) ? (uint32_t)(-position) : 0U;
+            }
+            else
+            {
+                frame[cfg->slot_a] = (uint32_t)position;
+            }
+        }
+
+        /* 零阶保持：同一帧在 hold_frames 个更新事件中重复输出 */
+        for (uint32_t h = 0U; h < s_config.hold_frames; h++)
+        {
+            for (uint32_t k = 0U; k < slots; k++)
+            {
+                *out++ = frame[k];
+            }
+        }
+    }
+}
+
+/**
+ * @brief 启动输出。
+ */
+uint8_t trajectory_start(const trajectory_config_t *config)
+{
+    uint32_t words;
+
+    if ((config == NULL) || (config->htim == NULL) || (config->htim->hdma[TIM_DMA_ID_UPDATE] == NULL))
+    {
+        return 1U;
+    }
+    if ((config->slot_count == 0U) || (config->slot_count > TRAJECTORY_MAX_SLOTS) ||
+        (config->axis_count == 0U) || (config->axis_count > TRAJECTORY_MAX_AXES) ||
+        (config->hold_frames == 0U) || (config->samples_per_half == 0U) || (config->sample_period_us == 0U))
+    {
+        return 1U;
+    }
+    words = 2U * (uint32_t)config->samples_per_half * config->hold_frames * config->slot_count;
+    if (words > TRAJECTORY_DMA_BUFFER_WORDS)
+    {
+        return 1U;
+    }
+    for (uint8_t a = 0U; a < config->axis_count; a++)
+    {
+        const trajectory_axis_config_t *cfg = &config->axes[a];
+
+        if ((cfg->slot_a >= config->slot_count) || (cfg->min > cfg->max) ||
+            ((cfg->type == TRAJECTORY_AXIS_HBRIDGE) &&
+             ((cfg->slot_b >= config->slot_count) || (cfg->slot_b == cfg->slot_a))))
+        {
+            return 1U;
+        }
+    }
+
+    if (s_running != 0U)
+    {
+        (void)trajectory_stop();
+    }
+
+    s_config = *config;
+    s_dma_words = words;
+    memset(s_axes, 0, sizeof(s_axes));
+    for (uint8_t a = 0U; a < s_config.axis_count; a++)
+    {
+        int32_t initial = trajectory_clamp(&s_config.axes[a], s_config.axes[a].initial);
+
+        s_axes[a].base = initial;
+        s_axes[a].planned_end = initial;
+        s_axes[a].position = initial;
+    }
+    trajectory_fill(&s_dma_buf[0]);
+    trajectory_fill(&s_dma_buf[words / 2U]);
+
+    s_running = 1U;
+    if (HAL_TIM_DMABurst_MultiWriteStart(s_config.htim, s_config.burst_base, TIM_DMA_UPDATE, s_dma_buf,
+                                         ((uint32_t)s_config.slot_count - 1U) << TIM_DCR_DBL_Pos,
+                                         words) != HAL_OK)
+    {
+        s_running = 0U;
+        return 2U;
+    }
+
+    return 0U;
+}
+
+/**
+ * @brief 停止输出。
+ */
+uint8_t trajectory_stop(void)
+{
+    if (s_running == 0U)
+    {
+        return 0U;
+    }
+
+    s_running = 0U;
+    if (HAL_TIM_DMABurst_WriteStop(s_config.htim, TIM_DMA_UPDATE) != HAL_OK)
+    {
+        return 1U;
+    }
+
+    return 0U;
+}
+
+/**
+ * @brief 排入运动段。
+ */
+uint8_t trajectory_enqueue(uint8_t axis, const trajectory_segment_t *segment)
+{
+    trajectory_axis_t *ax;
+    trajectory_motion_t *m;
+    int32_t target;
+
+    if ((axis >= s_config.axis_count) || (segment == NULL) || (segment->accel_permille > 500U))
+    {
+        return 1U;
+    }
+
+    ax = &s_axes[axis];
+    if ((ax->head - ax->tail) >= TRAJECTORY_QUEUE_DEPTH)
+    {
+        return 2U;
+    }
+
+    target = trajectory_clamp(&s_config.axes[axis], segment->target);
+    m = &ax->queue[ax->head & TRAJECTORY_QUEUE_MASK];
+    m->displacement = target - ax->planned_end;
+    m->total = trajectory_ms_to_samples(segment->duration_ms);
+    if (m->total == 0U)
+    {
+        m->total = 1U;
+    }
+    m->accel = (uint32_t)(((uint64_t)m->total * segment->accel_permille) / 1000U);
+    m->blend = trajectory_ms_to_samples(segment->blend_ms);
+    if (m->blend >= m->total)
+    {
+        m->blend = m->total - 1U;
+    }
+    m->elapsed = 0U;
+    m->profile = segment->profile;
+
+    ax->planned_end = target;
+    __DMB();
+    ax->head++;
+
+    return 0U;
+}
+
+/**
+ * @brief 中止某轴的运动。
+ */
+uint8_t trajectory_abort(uint8_t axis)
+{
+    trajectory_axis_t *ax;
+    uint32_t primask;
+
+    if (axis >= s_config.axis_count)
+    {
+        return 1U;
+    }
+
+    ax = &s_axes[axis];
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ax->tail = ax->head;
+    ax->active_count = 0U;
+    ax->base = ax->position;
+    ax->planned_end = ax->position;
+    __set_PRIMASK(primask);
+
+    return 0U;
+}
+
+/**
+ * @brief 查询队列空闲项数。
+ */
+uint32_t trajectory_free_segments(uint8_t axis)
+{
+    if (axis >= s_config.axis_count)
+    {
+        return 0U;
+    }
+
+    return TRAJECTORY_QUEUE_DEPTH - (s_axes[axis].head - s_axes[axis].tail);
+}
+
+/**
+ * @brief 查询某轴是否空闲。
+ */
+uint8_t trajectory_is_idle(uint8_t axis)
+{
+    if (axis >= s_config.axis_count)
+    {
+        return 1U;
+    }
+
+    return ((s_axes[axis].head == s_axes[axis].tail) && (s_axes[axis].active_count == 0U)) ? 1U : 0U;
+}
+
+/**
+ * @brief 读取最近生成的位置。
+ */
+int32_t trajectory_get_position(uint8_t axis)
+{
+    return (axis < s_config.axis_count) ? s_axes[axis].position : 0;
+}
+
+/**
+ * @brief DMA 已输出前半区：在后半区输出期间重新生成前半区。
+ */
+void HAL_TIM_PeriodElapsedHalfCpltCallback(TIM_HandleTypeDef *htim)
+{
+    if ((s_running != 0U) && (htim == s_config.htim))
+    {
+        trajectory_fill(&s_dma_buf[0]);
+    }
+}
+
+/**
+ * @brief DMA 已输出后半区：在前半区输出期间重新生成后半区。
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if ((s_running != 0U) && (htim == s_config.htim))
+    {
+        trajectory_fill(&s_dma_buf[s_dma_words / 2U]);
+    }
+}
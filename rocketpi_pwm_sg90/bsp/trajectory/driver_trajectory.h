@@ -0,0 +1,180 @@
+/**
+ * @file driver_trajectory.h
+ * @brief 多轴 PWM 轨迹引擎：定点生成 CCR 表，由 DMA 突发传输写入定时器比较寄存器。
+ *
+ * 每个轴有独立的运动段队列（梯形或 S 曲线）：
+ *   1. 运动段按定点算法求值，写入双半区的 CCR 表；
+ *   2. 循环 DMA 经 TIMx_DMAR 在每个更新事件把一帧写入 CCRx（DMA 突发）；
+ *   3. CPU 只在 DMA 半传输/传输完成中断中各生成一个半区，运动过程中
+ *      无需轮询，也不需要 HAL_Delay。
+ *
+ * 共用一个定时器的轴依次占用突发中的 CCR 槽位：
+ *   - 舵机轴：一个槽位，位置即 CCR 值（1 MHz 计数时 1 tick = 1 us）；
+ *   - H 桥轴：两个槽位（正转/反转），位置为有符号 CCR，另一输入保持低电平（刹车式 PWM）。
+ */
+#pragma once
+
+#include "tim.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 一个定时器驱动的最大轴数。
+ */
+#ifndef TRAJECTORY_MAX_AXES
+#define TRAJECTORY_MAX_AXES             4U
+#endif
+
+/**
+ * @brief 每轴排队的运动段数，必须为 2 的幂。
+ */
+#ifndef TRAJECTORY_QUEUE_DEPTH
+#define TRAJECTORY_QUEUE_DEPTH          8U
+#endif
+
+/**
+ * @brief 循环 DMA 表大小（32 位字，含两个半区）。
+ */
+#ifndef TRAJECTORY_DMA_BUFFER_WORDS
+#define TRAJECTORY_DMA_BUFFER_WORDS     256U
+#endif
+
+#if (TRAJECTORY_QUEUE_DEPTH & (TRAJECTORY_QUEUE_DEPTH - 1U)) != 0U
+#error "TRAJECTORY_QUEUE_DEPTH 必须为 2 的幂。"
+#endif
+
+/**
+ * @brief 加减速曲线形状。
+ */
+typedef enum
+{
+    TRAJECTORY_PROFILE_TRAPEZOID = 0,   /**< 恒加速度斜坡 */
+    TRAJECTORY_PROFILE_SCURVE           /**< 限加加速度斜坡（加速度按 smoothstep 变化） */
+} trajectory_profile_t;
+
+/**
+ * @brief 轴类型。
+ */
+typedef enum
+{
+    TRAJECTORY_AXIS_SERVO = 0,          /**< 位置写入 slot_a */
+    TRAJECTORY_AXIS_HBRIDGE             /**< 正位置写入 slot_a，负位置取反写入 slot_b */
+} trajectory_axis_type_t;
+
+/**
+ * @brief 单轴配置。
+ */
+typedef struct
+{
+    trajectory_axis_type_t type;
+    uint8_t slot_a;                     /**< 突发中的 CCR 槽位 */
+    uint8_t slot_b;                     /**< 反转槽位，仅 H 桥轴使用 */
+    int32_t min;                        /**< 位置下限（CCR tick） */
+    int32_t max;                        /**< 位置上限（CCR tick） */
+    int32_t initial;                    /**< 第一个运动段开始前输出的位置 */
+} trajectory_axis_config_t;
+
+/**
+ * @brief 引擎配置。
+ */
+typedef struct
+{
+    TIM_HandleTypeDef *htim;            /**< 已链接更新 DMA（hdma[TIM_DMA_ID_UPDATE]）的定时器 */
+    uint32_t burst_base;                /**< 槽位 0 对应的 TIM_DMABASE_CCRx */
+    uint8_t slot_count;                 /**< 每次更新写入的 CCR 个数（1..4） */
+    uint8_t axis_count;
+    uint16_t hold_frames;               /**< 每个轨迹采样保持的更新事件数 */
+    uint16_t samples_per_half;          /**< 每个 DMA 半区包含的轨迹采样数 */
+    uint32_t sample_period_us;          /**< 采样周期，等于 hold_frames × 定时器周期 */
+    trajectory_axis_config_t axes[TRAJECTORY_MAX_AXES];
+} trajectory_config_t;
+
+/**
+ * @brief 运动段。
+ */
+typedef struct
+{
+    int32_t target;                     /**< 终点绝对位置（CCR tick） */
+    uint32_t duration_ms;               /**< 运动总时长 */
+    uint16_t accel_permille;            /**< 单侧斜坡占总时长的千分比（0..500，0 为匀速） */
+    uint16_t blend_ms;                  /**< 提前于上一段结束的时长，两段在此窗口内叠加 */
+    trajectory_profile_t profile;
+} trajectory_segment_t;
+
+/**
+ * @brief     启动输出：以初始位置填满 CCR 表，并在更新事件上启动循环 DMA 突发。
+ *            调用前 PWM 输出必须已经运行。
+ * @param[in] config 引擎配置，内容会被复制。
+ * @return    状态码
+ *            - 0 成功
+ *            - 1 配置非法
+ *            - 2 DMA 启动失败
+ */
+uint8_t trajectory_start(const trajectory_config_t *config);
+
+/**
+ * @brief  停止 DMA 输出，比较寄存器保持最后写入的值。
+ * @return 状态码
+ *         - 0 成功
+ *         - 1 HAL 错误
+ */
+uint8_t trajectory_stop(void);
+
+/**
+ * @brief     为某个轴排入一个运动段，上一段结束时开始（或提前 blend_ms 与上一段叠加）。
+ * @param[in] axis    轴号。
+ * @param[in] segment 运动段，内容会被复制。
+ * @return    状态码
+ *            - 0 成功
+ *            - 1 参数非法
+ *            - 2 队列已满
+ */
+uint8_t trajectory_enqueue(uint8_t axis, const trajectory_segment_t *segment);
+
+/**
+ * @brief     丢弃该轴排队的运动段，并停在当前位置。
+ * @param[in] axis 轴号。
+ * @return    状态码
+ *            - 0 成功
+ *            - 1 轴号非法
+ */
+uint8_t trajectory_abort(uint8_t axis);
+
+/**
+ * @brief     查询某轴队列的空闲项数。
+ * @param[in] axis 轴号。
+ * @return    空闲项数，轴号非法时为 0。
+ */
+uint32_t trajectory_free_segments(uint8_t axis);
+
+/**
+ * @brief     查询某轴是否空闲。
+ * @param[in] axis 轴号。
+ * @return    没有运行中或排队的运动段时返回 1，否则返回 0。
+ */
+uint8_t trajectory_is_idle(uint8_t axis);
+
+/**
+ * @brief     读取某轴最近生成的位置。
+ * @param[in] axis 轴号。
+ * @return    位置（CCR tick，H 桥轴为有符号值）。
+ */
+int32_t trajectory_get_position(uint8_t axis);
+
+/**
+ * @brief     归一化曲线值，供校验使用。
+ * @param[in] profile 斜坡形状。
+ * @param[in] t       已经过的采样数（0..total）。
+ * @param[in] total   运动段长度（采样数）。
+ * @param[in] accel   单侧斜坡长度（采样数），最大为 total / 2。
+ * @return    已走过的比例，Q16 格式（0..65536）。
+ */
+uint32_t trajectory_profile_q16(trajectory_profile_t profile, uint32_t t, uint32_t total, uint32_t accel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "main.h"
+
+/**
+ * @file debug_retarget.h
+ * @brief 调试串口的 DMA 收发环形缓冲，供 debug_driver 的 stdio 重定向使用。
+ *
+ * 开启 DEBUG_RETARGET_ENABLE 后：
+ * - 发送：写入只拷贝到 TX 环形缓冲，DMA 空闲时立即启动，完成回调中链式发送剩余数据，
+ *   printf 不再等待串口移位；
+ * - 接收：串口以循环 DMA + 空闲中断（ReceiveToIdle）接收，事件回调把新数据搬入 RX 环形缓冲。
+ * 发送端用 LDREX/STREX 预留缓冲区空间，中断打断写入时嵌套写入排在其后，两段输出都不丢不乱；
+ * DMA 启动用 LDREX/STREX 抢占标志，全程不关中断。
+ * 关闭时（默认）所有接口退化为原来的阻塞收发，工程无需 DMA 配置。
+ *
+ * 开启时工程需要为该串口配置 TX DMA（普通模式）、RX DMA（循环模式）和串口中断，
+ * 并在 HAL 回调中调用 debug_retarget_tx_complete() / debug_retarget_rx_event() /
+ * debug_retarget_error()。
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========= Configuration section ========= */
+#ifndef DEBUG_RETARGET_ENABLE
+#define DEBUG_RETARGET_ENABLE       0           // 1：DMA 环形缓冲；0：阻塞收发
+#endif
+
+#ifndef DEBUG_RETARGET_UART
+#define DEBUG_RETARGET_UART         huart2      // 调试串口句柄
+#endif
+
+#ifndef DEBUG_RETARGET_TX_SIZE
+#define DEBUG_RETARGET_TX_SIZE      1024U       // TX 环形缓冲大小，必须为 2 的幂且不超过 8 MB
+#endif
+
+#ifndef DEBUG_RETARGET_RX_SIZE
+#define DEBUG_RETARGET_RX_SIZE      256U        // RX 环形缓冲大小，必须为 2 的幂
+#endif
+
+#ifndef DEBUG_RETARGET_RX_DMA_SIZE
+#define DEBUG_RETARGET_RX_DMA_SIZE  64U         // RX 循环 DMA 缓冲大小
+#endif
+
+/* TX 缓冲区满时的处理方式 */
+#define DEBUG_RETARGET_OVERFLOW_BLOCK     0     // 等待 DMA 腾出空间（中断中退化为 TRUNCATE）
+#define DEBUG_RETARGET_OVERFLOW_DROP      1     // 放不下时整次写入丢弃，保持行完整
+#define DEBUG_RETARGET_OVERFLOW_TRUNCATE  2     // 写入能放下的部分，其余丢弃
+
+#ifndef DEBUG_RETARGET_OVERFLOW
+#define DEBUG_RETARGET_OVERFLOW     DEBUG_RETARGET_OVERFLOW_BLOCK
+#endif
+/* ======================================== */
+
+#if ((DEBUG_RETARGET_TX_SIZE & (DEBUG_RETARGET_TX_SIZE - 1U)) != 0U) || \
+    ((DEBUG_RETARGET_RX_SIZE & (DEBUG_RETARGET_RX_SIZE - 1U)) != 0U)
+#error "DEBUG_RETARGET_TX_SIZE and DEBUG_RETARGET_RX_SIZE must be powers of two"
+#endif
+
+/**
+ * @brief 收发统计。
+ */
+typedef struct
+{
+    uint32_t tx_bytes;      /**< 写入 TX 缓冲的字节数 */
+    uint32_t tx_dropped;    /**< 因缓冲区满而丢弃的字节数 */
+    uint32_t tx_transfers;  /**< 启动的 DMA 发送次数 */
+    uint32_t rx_bytes;      /**< 搬入 RX 缓冲的字节数 */
+    uint32_t rx_dropped;    /**< RX 缓冲区满而丢弃的字节数 */
+    uint32_t rx_errors;     /**< 串口错误（重启接收）次数 */
+} debug_retarget_stats_t;
+
+/**
+ * @brief 复位缓冲区并启动 RX DMA，需在 MX_USARTx_UART_Init() 之后调用。
+ */
+void debug_retarget_init(void);
+
+/**
+ * @brief 发送数据（原样，不做换行转换）。
+ * @param data 数据指针。
+ * @param len  字节数。
+ * @return 实际写入的字节数。
+ */
+size_t debug_retarget_write(const void *data, size_t len);
+
+/**
+ * @brief 读取已接收的数据，不等待。
+ * @param data 接收缓冲区。
+ * @param len  缓冲区大小。
+ * @return 实际读取的字节数。
+ */
+size_t debug_retarget_read(void *data, size_t len);
+
+/**
+ * @brief 阻塞读取一个字节。
+ * @return 接收到的字节。
+ */
+int debug_retarget_getc(void);
+
+/**
+ * @brief 等待 TX 缓冲全部发出，需在线程模式且开中断时调用。
+ */
+void debug_retarget_flush(void);
+
+/**
+ * @brief 故障处理用的刷新：停止 DMA，改为轮询寄存器发出剩余数据，不依赖中断与 SysTick。
+ */
+void debug_retarget_flush_panic(void);
+
+/**
+ * @brief 在 HAL_UART_TxCpltCallback 中调用。
+ */
+void debug_retarget_tx_complete(UART_HandleTypeDef *huart);
+
+/**
+ * @brief 在 HAL_UARTEx_RxEventCallback 中调用。
+ * @param size HAL 上报的 DMA 缓冲写入位置。
+ */
+void debug_retarget_rx_event(UART_HandleTypeDef *huart, uint16_t size);
+
+/**
+ * @brief 在 HAL_UART_ErrorCallback 中调用，重启接收并恢复发送状态。
+ */
+void debug_retarget_error(UART_HandleTypeDef *huart);
+
+/**
+ * @brief 读取收发统计。
+ */
+void debug_retarget_get_stats(debug_retarget_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,504 @@
+/**
+ * @file debug_retarget.c
+ * @brief 调试串口 DMA 收发环形缓冲实现。
+ *
+ * TX：写入方用 LDREX/STREX 推进 s_tx_state 中的预留位置并登记写入者数，各自向预留区拷贝，
+ * 最后一个提交的写入者把 s_tx_published 推进到当前预留位置，DMA 只发送已发布的数据；
+ * 中断打断写入时嵌套写入得到紧随其后的预留区，两次输出都完整且不交错。
+ * s_tx_tail 只在 DMA 完成回调中推进；位置按 2^24 取模。
+ * s_tx_dma_busy 为 DMA 启动/进行中的抢占标志，s_tx_dma_len 为当前传输长度。
+ * RX：s_rx_head 只在 RX 事件回调中推进，s_rx_tail 只由读取方推进。
+ */
+#include "debug_retarget.h"
+
+#include "usart.h"
+#include <string.h>
+
+static debug_retarget_stats_t s_stats;
+
+#if DEBUG_RETARGET_ENABLE
+
+#if (DEBUG_RETARGET_TX_SIZE > 0x800000U)
+#error "DEBUG_RETARGET_TX_SIZE must not exceed 8 MB"
+#endif
+
+#define TX_MASK     (DEBUG_RETARGET_TX_SIZE - 1U)
+#define RX_MASK     (DEBUG_RETARGET_RX_SIZE - 1U)
+#define TX_POS_MASK 0x00FFFFFFU
+#define TX_DIST(a, b)   (((a) - (b)) & TX_POS_MASK)
+
+static uint8_t s_tx_buf[DEBUG_RETARGET_TX_SIZE];
+static volatile uint32_t s_tx_state;        /* 写入者数 << 24 | 预留位置 */
+static volatile uint32_t s_tx_published;    /* 已提交数据的末尾 */
+static volatile uint32_t s_tx_tail;
+static volatile uint32_t s_tx_dma_busy;
+static volatile uint32_t s_tx_dma_len;
+
+static uint8_t s_rx_dma[DEBUG_RETARGET_RX_DMA_SIZE];
+static uint8_t s_rx_buf[DEBUG_RETARGET_RX_SIZE];
+static volatile uint32_t s_rx_head;
+static volatile uint32_t s_rx_tail;
+static uint16_t s_rx_dma_pos;
+
+/**
+ * @brief 抢占标志：LDREX/STREX 之间被中断打断时 STREX 失败并重试，已被占用则返回 0。
+ */
+static int retarget_claim(volatile uint32_t *flag)
+{
+    do
+    {
+        if (__LDREXW(flag) != 0U)
+        {
+            __CLREX();
+            return 0;
+        }
+    } while (__STREXW(1U, flag) != 0U);
+    __DMB();
+    return 1;
+}
+
+static void retarget_release(volatile uint32_t *flag)
+{
+    __DMB();
+    *flag = 0U;
+}
+
+/**
+ * @brief 原子累加，供任意上下文更新统计计数。
+ */
+static void retarget_add(volatile uint32_t *counter, uint32_t n)
+{
+    uint32_t value;
+
+    do
+    {
+        value = __LDREXW(counter) + n;
+    } while (__STREXW(value, counter) != 0U);
+}
+
+/**
+ * @brief 只有线程模式且开中断时才能等待 DMA 完成回调。
+ */
+static int retarget_can_wait(void)
+{
+    return (__get_IPSR() == 0U) && (__get_PRIMASK() == 0U);
+}
+
+/**
+ * @brief DMA 空闲且有数据时启动下一次传输，一次最多发送到缓冲区末尾。
+ */
+static void retarget_kick(void)
+{
+    while (s_tx_published != s_tx_tail)
+    {
+        if (!retarget_claim(&s_tx_dma_busy))
+        {
+            return;     /* DMA 正在发送，完成回调会继续 */
+        }
+
+        uint32_t tail = s_tx_tail;
+        uint32_t len = TX_DIST(s_tx_published, tail);
+
+        if (len != 0U)
+        {
+            uint32_t offset = tail & TX_MASK;
+
+            if (len > (DEBUG_RETARGET_TX_SIZE - offset))
+            {
+                len = DEBUG_RETARGET_TX_SIZE - offset;
+            }
+            if (len > 0xFFFFU)
+            {
+                len = 0xFFFFU;
+            }
+            s_tx_dma_len = len;
+            if (HAL_UART_Transmit_DMA(&DEBUG_RETARGET_UART, &s_tx_buf[offset], (uint16_t)len) == HAL_OK)
+            {
+                s_stats.tx_transfers++;
+                return;
+            }
+            /* 串口忙（例如仍有阻塞发送），下一次写入时重试 */
+            s_tx_dma_len = 0U;
+            retarget_release(&s_tx_dma_busy);
+            return;
+        }
+        /* 持有标志期间写入方可能刚发布数据且启动失败，释放后再检查一次 */
+        retarget_release(&s_tx_dma_busy);
+    }
+}
+
+/**
+ * @brief 预留 TX 缓冲区空间并登记为写入者，可在任意上下文调用。
+ * @param min 至少需要的字节数（不小于 1），空闲空间不足时不预留。
+ * @param max 最多预留的字节数。
+ * @param pos 返回预留区的起始位置。
+ * @return 预留的字节数，0 表示未预留。
+ */
+static uint32_t retarget_reserve(uint32_t min, uint32_t max, uint32_t *pos)
+{
+    uint32_t state;
+    uint32_t writers;
+    uint32_t len;
+
+    do
+    {
+        state = __LDREXW(&s_tx_state);
+        writers = state >> 24;
+        *pos = state & TX_POS_MASK;
+        len = DEBUG_RETARGET_TX_SIZE - TX_DIST(*pos, s_tx_tail);
+        if ((writers == 0xFFU) || (len < min))
+        {
+            __CLREX();
+            return 0U;
+        }
+        if (len > max)
+        {
+            len = max;
+        }
+    } while (__STREXW(((writers + 1U) << 24) | ((*pos + len) & TX_POS_MASK), &s_tx_state) != 0U);
+    return len;
+}
+
+/**
+ * @brief 推进已发布位置，已发布到更后面时不回退。
+ */
+static void retarget_publish(uint32_t pos)
+{
+    uint32_t cur;
+
+    do
+    {
+        cur = __LDREXW(&s_tx_published);
+        if ((TX_DIST(pos, cur) == 0U) || (TX_DIST(pos, cur) > DEBUG_RETARGET_TX_SIZE))
+        {
+            __CLREX();
+            return;
+        }
+    } while (__STREXW(pos, &s_tx_published) != 0U);
+}
+
+/**
+ * @brief 拷贝到预留区并提交，最后一个退出的写入者发布目前为止的全部预留。
+ */
+static void retarget_commit(uint32_t pos, const uint8_t *src, uint32_t len)
+{
+    uint32_t offset = pos & TX_MASK;
+    uint32_t first = DEBUG_RETARGET_TX_SIZE - offset;
+    uint32_t state;
+    uint32_t writers;
+
+    if (first > len)
+    {
+        first = len;
+    }
+    memcpy(&s_tx_buf[offset], src, first);
+    memcpy(s_tx_buf, &src[first], len - first);
+
+    do
+    {
+        state = __LDREXW(&s_tx_state);
+        writers = (state >> 24) - 1U;
+    } while (__STREXW((writers << 24) | (state & TX_POS_MASK), &s_tx_state) != 0U);
+    if (writers == 0U)
+    {
+        __DMB();
+        retarget_publish(state & TX_POS_MASK);
+    }
+}
+
+/**
+ * @brief 把 DMA 缓冲中的新数据存入 RX 环形缓冲，满时丢弃。
+ */
+static void retarget_rx_store(const uint8_t *src, uint32_t len)
+{
+    uint32_t head = s_rx_head;
+    uint32_t space = DEBUG_RETARGET_RX_SIZE - (head - s_rx_tail);
+
+    if (len > space)
+    {
+        s_stats.rx_dropped += len - space;
+        len = space;
+    }
+    for (uint32_t i = 0U; i < len; ++i)
+    {
+        s_rx_buf[(head + i) & RX_MASK] = src[i];
+    }
+    s_rx_head = head + len;
+    s_stats.rx_bytes += len;
+}
+
+static void retarget_rx_start(void)
+{
+    s_rx_dma_pos = 0U;
+    (void)HAL_UARTEx_ReceiveToIdle_DMA(&DEBUG_RETARGET_UART, s_rx_dma, DEBUG_RETARGET_RX_DMA_SIZE);
+}
+
+void debug_retarget_init(void)
+{
+    s_tx_state = 0U;
+    s_tx_published = 0U;
+    s_tx_tail = 0U;
+    s_tx_dma_busy = 0U;
+    s_tx_dma_len = 0U;
+    s_rx_head = 0U;
+    s_rx_tail = 0U;
+    memset(&s_stats, 0, sizeof(s_stats));
+    retarget_rx_start();
+}
+
+size_t debug_retarget_write(const void *data, size_t len)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    size_t done = 0U;
+#if (DEBUG_RETARGET_OVERFLOW == DEBUG_RETARGET_OVERFLOW_BLOCK)
+    int can_wait = retarget_can_wait();
+#endif
+
+    if ((data == NULL) || (len == 0U))
+    {
+        return 0U;
+    }
+    while (done < len)
+    {
+        size_t rest = len - done;
+        uint32_t want = (rest > DEBUG_RETARGET_TX_SIZE) ? DEBUG_RETARGET_TX_SIZE : (uint32_t)rest;
+        uint32_t pos;
+        uint32_t n;
+
+#if (DEBUG_RETARGET_OVERFLOW == DEBUG_RETARGET_OVERFLOW_DROP)
+        /* 整次写入一次预留，放不下则全部丢弃 */
+        n = (rest > DEBUG_RETARGET_TX_SIZE) ? 0U : retarget_reserve(want, want, &pos);
+#elif (DEBUG_RETARGET_OVERFLOW == DEBUG_RETARGET_OVERFLOW_BLOCK)
+        /* 能等待时等到整段放得下再预留，不被其他写入拆开 */
+        n = retarget_reserve(can_wait ? want : 1U, want, &pos);
+        if ((n == 0U) && can_wait)
+        {
+            retarget_kick();
+            continue;
+        }
+#else
+        n = retarget_reserve(1U, want, &pos);
+#endif
+        if (n == 0U)
+        {
+            break;
+        }
+        retarget_commit(pos, &src[done], n);
+        done += n;
+    }
+    retarget_add(&s_stats.tx_bytes, (uint32_t)done);
+
+    if (done < len)
+    {
+        retarget_add(&s_stats.tx_dropped, (uint32_t)(len - done));
+    }
+    retarget_kick();
+    return done;
+}
+
+size_t debug_retarget_read(void *data, size_t len)
+{
+    uint8_t *dst = (uint8_t *)data;
+    uint32_t tail = s_rx_tail;
+    size_t n = 0U;
+
+    while ((n < len) && (tail != s_rx_head))
+    {
+        dst[n++] = s_rx_buf[tail & RX_MASK];
+        tail++;
+    }
+    s_rx_tail = tail;
+    return n;
+}
+
+int debug_retarget_getc(void)
+{
+    uint8_t ch;
+
+    while (debug_retarget_read(&ch, 1U) == 0U)
+    {
+    }
+    return (int)ch;
+}
+
+void debug_retarget_flush(void)
+{
+    if (!retarget_can_wait())
+    {
+        return;
+    }
+    while (s_tx_published != s_tx_tail)
+    {
+        retarget_kick();
+    }
+}
+
+void debug_retarget_flush_panic(void)
+{
+    UART_HandleTypeDef *huart = &DEBUG_RETARGET_UART;
+    uint32_t tail = s_tx_tail;
+    uint32_t head = s_tx_published;
+
+    if ((s_tx_dma_len != 0U) && (huart->hdmatx != NULL))
+    {
+        DMA_HandleTypeDef *hdma = huart->hdmatx;
+
+        /* 停止 DMA，按剩余计数算出已送入串口的字节数 */
+        CLEAR_BIT(huart->Instance->CR3, USART_CR3_DMAT);
+        __HAL_DMA_DISABLE(hdma);
+        while ((hdma->Instance->CR & DMA_SxCR_EN) != 0U)
+        {
+        }
+        tail = (tail + s_tx_dma_len - __HAL_DMA_GET_COUNTER(hdma)) & TX_POS_MASK;
+    }
+    while (tail != head)
+    {
+        while (__HAL_UART_GET_FLAG(huart, UART_FLAG_TXE) == RESET)
+        {
+        }
+        huart->Instance->DR = s_tx_buf[tail & TX_MASK];
+        tail = (tail + 1U) & TX_POS_MASK;
+    }
+    while (__HAL_UART_GET_FLAG(huart, UART_FLAG_TC) == RESET)
+    {
+    }
+    CLEAR_BIT(huart->Instance->CR1, USART_CR1_TCIE);
+
+    s_tx_tail = tail;
+    s_tx_dma_len = 0U;
+    huart->gState = HAL_UART_STATE_READY;
+    s_tx_dma_busy = 0U;
+}
+
+void debug_retarget_tx_complete(UART_HandleTypeDef *huart)
+{
+    /* 接收错误也会进入 ErrorCallback，此时发送仍在进行（gState 为 BUSY_TX） */
+    if ((huart != &DEBUG_RETARGET_UART) || (s_tx_dma_len == 0U) ||
+        (huart->gState != HAL_UART_STATE_READY))
+    {
+        return;
+    }
+    s_tx_tail = (s_tx_tail + s_tx_dma_len) & TX_POS_MASK;
+    s_tx_dma_len = 0U;
+    retarget_release(&s_tx_dma_busy);
+    retarget_kick();
+}
+
+void debug_retarget_rx_event(UART_HandleTypeDef *huart, uint16_t size)
+{
+    uint16_t pos = size;
+
+    if ((huart != &DEBUG_RETARGET_UART) || (pos > DEBUG_RETARGET_RX_DMA_SIZE))
+    {
+        return;
+    }
+    /* 循环 DMA：size 为本轮写入位置，半满/满/空闲各上报一次 */
+    if (pos > s_rx_dma_pos)
+    {
+        retarget_rx_store(&s_rx_dma[s_rx_dma_pos], (uint32_t)(pos - s_rx_dma_pos));
+    }
+    else if (pos < s_rx_dma_pos)
+    {
+        retarget_rx_store(&s_rx_dma[s_rx_dma_pos], (uint32_t)(DEBUG_RETARGET_RX_DMA_SIZE - s_rx_dma_pos));
+        retarget_rx_store(s_rx_dma, pos);
+    }
+    s_rx_dma_pos = (pos == DEBUG_RETARGET_RX_DMA_SIZE) ? 0U : pos;
+}
+
+void debug_retarget_error(UART_HandleTypeDef *huart)
+{
+    if (huart != &DEBUG_RETARGET_UART)
+    {
+        return;
+    }
+    s_stats.rx_errors++;
+    /* HAL 在溢出/帧错误时终止了 RX DMA，重新开始接收 */
+    if (huart->RxState == HAL_UART_STATE_READY)
+    {
+        retarget_rx_start();
+    }
+    debug_retarget_tx_complete(huart);
+}
+
+#else /* !DEBUG_RETARGET_ENABLE：退化为阻塞收发 */
+
+void debug_retarget_init(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+size_t debug_retarget_write(const void *data, size_t len)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    size_t done = 0U;
+
+    if ((data == NULL) || (len == 0U))
+    {
+        return 0U;
+    }
+    /* HAL 单次最多发送 0xFFFF 字节，更长的数据分段发送 */
+    while (done < len)
+    {
+        uint16_t chunk = ((len - done) > 0xFFFFU) ? 0xFFFFU : (uint16_t)(len - done);
+
+        HAL_UART_Transmit(&DEBUG_RETARGET_UART, (uint8_t *)&src[done], chunk, HAL_MAX_DELAY);
+        done += chunk;
+    }
+    s_stats.tx_bytes += (uint32_t)len;
+    return len;
+}
+
+size_t debug_retarget_read(void *data, size_t len)
+{
+    UART_HandleTypeDef *huart = &DEBUG_RETARGET_UART;
+    uint8_t *dst = (uint8_t *)data;
+    size_t n = 0U;
+
+    /* 只取数据寄存器中已有的字节，不等待 */
+    while ((n < len) && (__HAL_UART_GET_FLAG(huart, UART_FLAG_RXNE) != RESET))
+    {
+        dst[n++] = (uint8_t)(huart->Instance->DR & 0xFFU);
+    }
+    s_stats.rx_bytes += (uint32_t)n;
+    return n;
+}
+
+int debug_retarget_getc(void)
+{
+    uint8_t ch;
+
+    HAL_UART_Receive(&DEBUG_RETARGET_UART, &ch, 1U, HAL_MAX_DELAY);
+    s_stats.rx_bytes++;
+    return (int)ch;
+}
+
+void debug_retarget_flush(void)
+{
+}
+
+void debug_retarget_flush_panic(void)
+{
+}
+
+void debug_retarget_tx_complete(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+void debug_retarget_rx_event(UART_HandleTypeDef *huart, uint16_t size)
+{
+    (void)huart;
+    (void)size;
+}
+
+void debug_retarget_error(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+#endif /* DEBUG_RETARGET_ENABLE */
+
+void debug_retarget_get_stats(debug_retarget_stats_t *stats)
+{
+    *stats = s_stats;
+}
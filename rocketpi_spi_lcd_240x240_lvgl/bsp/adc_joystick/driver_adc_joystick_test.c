@@ -1,6 +1,6 @@
 /**
  * @file driver_adc_joystick_test.c
- * @brief 双轴模拟摇杆及按键的阻塞采样辅助函数。
+ * @brief 双轴模拟摇杆及按键的采样辅助函数（基于后台 ADC DMA 采集服务）。
  * @version 1.0.0
  * @date 2025-11-16
  *
@@ -13,10 +13,14 @@
 
 #include <stdio.h>
 #include "gpio.h"
+#include "driver_adc_sampler.h"
 
 /** @brief hadc1 采集的 12 位 ADC 最大值。 */
 #define ADC_JOYSTICK_TEST_ADC_MAX_VALUE   4095U
 
+/** @brief 后台采集服务是否已由本模块启动。 */
+static uint8_t s_sampler_started = 0U;
+
 static uint16_t adc_joystick_test_scale_permille(uint16_t raw);
 static void adc_joystick_test_map_direction(const adc_joystick_sample_t *sample, char *out, uint32_t *n);
 
@@ -50,50 +54,79 @@ static uint8_t adc_joystick_test_read_key_internal(void)
 }
 
 /**
- * @brief 获取摇杆两个轴的原始值、千分比和按键状态。
- * @param[out] sample 接收原始计数、千分比和按键标志。
- * @return 成功返回 0，任一 ADC 操作失败返回 1。
+ * @brief 确保后台 ADC 采集已启动，首次调用时等待第一个中值窗口就绪。
+ * @return 就绪返回 0，启动失败或等待超时返回 1。
  */
-uint8_t adc_joystick_test_sample(adc_joystick_sample_t *sample)
+static uint8_t adc_joystick_test_ensure_sampler(void)
 {
-    HAL_StatusTypeDef status;
-    uint16_t raw_x = 0U;
-    uint16_t raw_y = 0U;
+    uint32_t start;
 
-    if (sample == NULL)
+    if (adc_sampler_is_ready() != 0U)
     {
-        return 1U;
+        return 0U;
     }
 
-    status = HAL_ADC_Start(&hadc1);
-    if (status != HAL_OK)
+    if (s_sampler_started == 0U)
     {
-        return 1U;
+        const adc_sampler_config_t config =
+        {
+            .hadc = &hadc1,
+            .channel_count = ADC_JOYSTICK_TEST_CHANNEL_COUNT,
+            .oversample_log2 = ADC_JOYSTICK_TEST_OVERSAMPLE_LOG2,
+            .decimation_shift = ADC_JOYSTICK_TEST_OVERSAMPLE_LOG2,
+            .ema_shift = ADC_JOYSTICK_TEST_EMA_SHIFT,
+        };
+
+        if (adc_sampler_start(&config) != 0U)
+        {
+            return 1U;
+        }
+        s_sampler_started = 1U;
     }
 
-    status = HAL_ADC_PollForConversion(&hadc1, ADC_JOYSTICK_TEST_POLL_TIMEOUT_MS);
-    if (status != HAL_OK)
+    start = HAL_GetTick();
+    while (adc_sampler_is_ready() == 0U)
     {
-        (void)HAL_ADC_Stop(&hadc1);
+        if ((HAL_GetTick() - start) > ADC_JOYSTICK_TEST_POLL_TIMEOUT_MS)
+        {
+            return 1U;
+        }
+    }
+
+    return 0U;
+}
+
+/**
+ * @brief 获取摇杆两个轴的滤波值、千分比和按键状态。
+ *
+ * 数据来自后台循环 DMA 采集服务的中值滤波结果，读取为 O(1)，
+ * 不会启动、轮询或停止 ADC。
+ * @param[out] sample 接收原始计数、千分比和按键标志。
+ * @return 成功返回 0，采集服务未就绪返回 1。
+ */
+uint8_t adc_joystick_test_sample(adc_joystick_sample_t *sample)
+{
+    adc_sampler_value_t values[ADC_JOYSTICK_TEST_CHANNEL_COUNT];
+    uint16_t raw_x;
+    uint16_t raw_y;
 
+    if (sample == NULL)
+    {
         return 1U;
     }
-    raw_x = (uint16_t)HAL_ADC_GetValue(&hadc1);
 
-    status = HAL_ADC_PollForConversion(&hadc1, ADC_JOYSTICK_TEST_POLL_TIMEOUT_MS);
-    if (status != HAL_OK)
+    if (adc_joystick_test_ensure_sampler() != 0U)
     {
-        (void)HAL_ADC_Stop(&hadc1);
-
         return 1U;
     }
-    raw_y = (uint16_t)HAL_ADC_GetValue(&hadc1);
 
-    status = HAL_ADC_Stop(&hadc1);
-    if (status != HAL_OK)
+    /* X/Y 取自同一次更新 */
+    if (adc_sampler_read_all(values, ADC_JOYSTICK_TEST_CHANNEL_COUNT) != 0U)
     {
         return 1U;
     }
+    raw_x = values[ADC_JOYSTICK_TEST_RANK_X].median;
+    raw_y = values[ADC_JOYSTICK_TEST_RANK_Y].median;
 
     sample->x.raw = raw_x;
     sample->x.permille = adc_joystick_test_scale_permille(raw_x);
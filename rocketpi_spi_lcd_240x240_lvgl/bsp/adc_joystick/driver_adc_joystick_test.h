@@ -1,6 +1,6 @@
 /**
  * @file driver_adc_joystick_test.h
- * @brief 双轴摇杆采样辅助（ADC 通道 14/15 加按键输入）。
+ * @brief 双轴摇杆采样辅助（ADC 通道 14/15 加按键输入），数据来自后台 DMA 采集服务。
  * @version 1.0.0
  * @date 2025-11-16
  */
@@ -10,10 +10,28 @@
 #include "usart.h"
 
 /**
- * @brief 轮询每次 ADC 转换时的超时时间（毫秒）。
+ * @brief 首次采样时等待后台采集就绪的超时时间（毫秒）。
  */
 #define ADC_JOYSTICK_TEST_POLL_TIMEOUT_MS        10U
 
+/**
+ * @brief 扫描序列长度及 X/Y 轴在序列中的位置（与 MX_ADC1_Init 的 Rank 对应）。
+ */
+#define ADC_JOYSTICK_TEST_CHANNEL_COUNT          2U
+#define ADC_JOYSTICK_TEST_RANK_X                 0U
+#define ADC_JOYSTICK_TEST_RANK_Y                 1U
+
+/**
+ * @brief 过采样倍数（2^n 帧平均为一个样本，结果仍为 12 位）。
+ *        112 周期采样时 64 帧约 0.76 ms，即每 0.76 ms 产生一个滤波样本。
+ */
+#define ADC_JOYSTICK_TEST_OVERSAMPLE_LOG2        6U
+
+/**
+ * @brief EMA 系数 alpha = 1 / 2^n。
+ */
+#define ADC_JOYSTICK_TEST_EMA_SHIFT              2U
+
 /**
  * @brief 传入 0 时使用的默认采样次数。
  */
@@ -0,0 +1,373 @@
+/**
+ * @file driver_adc_sampler.c
+ * @brief ADC 规则组扫描 + 循环 DMA 的后台采集服务实现。
+ * @version 1.0.0
+ * @date 2025-11-20
+ *
+ * DMA 缓冲按帧交错存放：buf[frame * channel_count + rank]，前后两个半区
+ * 分别在 HAL_ADC_ConvHalfCpltCallback/HAL_ADC_ConvCpltCallback 中处理，
+ * 处理期间 DMA 正在写入另一半区，因此不会读到撕裂的数据。
+ */
+#include "driver_adc_sampler.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/** @brief 单个半区最多容纳的帧数。 */
+#define ADC_SAMPLER_MAX_FRAMES   (1UL << ADC_SAMPLER_MAX_OVERSAMPLE_LOG2)
+
+/** @brief 抽取结果允许的最大扩展位数（12 位 + 4 位 = 16 位）。 */
+#define ADC_SAMPLER_MAX_EXTRA_BITS   4U
+
+/** @brief EMA 系数允许的最大移位。 */
+#define ADC_SAMPLER_MAX_EMA_SHIFT    8U
+
+static adc_sampler_config_t s_config;
+static uint8_t s_running = 0U;
+
+/** @brief 循环 DMA 目标缓冲（两个半区）。 */
+static uint16_t s_dma_buf[2UL * ADC_SAMPLER_MAX_FRAMES * ADC_SAMPLER_MAX_CHANNELS];
+static uint32_t s_dma_len = 0U;
+
+/** @brief 每通道抽取样本的环形缓冲。 */
+static uint16_t s_ring[ADC_SAMPLER_MAX_CHANNELS][ADC_SAMPLER_RING_DEPTH];
+static uint32_t s_ring_head = 0U;
+static uint32_t s_ring_fill = 0U;
+
+/** @brief EMA 累加器，定点格式 Q(ema_shift)。 */
+static uint32_t s_ema_acc[ADC_SAMPLER_MAX_CHANNELS];
+
+/** @brief 对外发布的最新结果，由顺序锁保护一致性。 */
+static volatile adc_sampler_value_t s_latest[ADC_SAMPLER_MAX_CHANNELS];
+static volatile uint32_t s_seqlock = 0U;
+static volatile uint32_t s_sequence = 0U;
+static volatile uint8_t s_ready = 0U;
+static volatile uint32_t s_restart_count = 0U;
+
+/**
+ * @brief 求最近 ADC_SAMPLER_MEDIAN_WINDOW 个样本的中值（窗口很小，插入排序即可）。
+ * @param ring  通道环形缓冲。
+ * @param count 参与排序的样本数（未填满窗口时小于窗口长度）。
+ * @return 中值。
+ */
+static uint16_t adc_sampler_window_median(const uint16_t *ring, uint32_t count)
+{
+    uint16_t window[ADC_SAMPLER_MEDIAN_WINDOW];
+
+    for (uint32_t i = 0U; i < count; ++i)
+    {
+        uint32_t index = (s_ring_head - 1U - i) & (ADC_SAMPLER_RING_DEPTH - 1U);
+        uint16_t key = ring[index];
+        int32_t j = (int32_t)i - 1;
+
+        while ((j >= 0) && (window[j] > key))
+        {
+            window[j + 1] = window[j];
+            --j;
+        }
+        window[j + 1] = key;
+    }
+
+    return window[count / 2U];
+}
+
+/**
+ * @brief 处理一个 DMA 半区：过采样累加、抽取、入环并更新滤波结果。
+ * @param half 半区起始地址。
+ */
+static void adc_sampler_process_half(const uint16_t *half)
+{
+    const uint32_t channels = s_config.channel_count;
+    const uint32_t frames = 1UL << s_config.oversample_log2;
+    uint32_t sums[ADC_SAMPLER_MAX_CHANNELS] = {0U};
+    adc_sampler_value_t values[ADC_SAMPLER_MAX_CHANNELS];
+    uint32_t window;
+
+    for (uint32_t frame = 0U; frame < frames; ++frame)
+    {
+        const uint16_t *row = &half[frame * channels];
+
+        for (uint32_t rank = 0U; rank < channels; ++rank)
+        {
+            sums[rank] += row[rank];
+        }
+    }
+
+    if (s_ring_fill < ADC_SAMPLER_MEDIAN_WINDOW)
+    {
+        ++s_ring_fill;
+    }
+    window = s_ring_fill;
+
+    for (uint32_t rank = 0U; rank < channels; ++rank)
+    {
+        uint16_t sample = (uint16_t)(sums[rank] >> s_config.decimation_shift);
+
+        s_ring[rank][s_ring_head & (ADC_SAMPLER_RING_DEPTH - 1U)] = sample;
+
+        if (s_sequence == 0U)
+        {
+            s_ema_acc[rank] = (uint32_t)sample << s_config.ema_shift;
+        }
+        else
+        {
+            s_ema_acc[rank] = s_ema_acc[rank] - (s_ema_acc[rank] >> s_config.ema_shift) + sample;
+        }
+
+        values[rank].raw = sample;
+        values[rank].ema = (uint16_t)(s_ema_acc[rank] >> s_config.ema_shift);
+    }
+    ++s_ring_head;
+
+    for (uint32_t rank = 0U; rank < channels; ++rank)
+    {
+        values[rank].median = adc_sampler_window_median(s_ring[rank], window);
+    }
+
+    /* 顺序锁：奇数表示正在写入，读者遇到奇数或前后不一致时重读。 */
+    ++s_seqlock;
+    __DMB();
+    for (uint32_t rank = 0U; rank < channels; ++rank)
+    {
+        s_latest[rank].raw = values[rank].raw;
+        s_latest[rank].median = values[rank].median;
+        s_latest[rank].ema = values[rank].ema;
+    }
+    __DMB();
+    ++s_seqlock;
+
+    ++s_sequence;
+    if (window >= ADC_SAMPLER_MEDIAN_WINDOW)
+    {
+        s_ready = 1U;
+    }
+}
+
+/**
+ * @brief 使能连续扫描与 DMA 连续请求，并启动循环 DMA。
+ * @return HAL 状态。
+ */
+static HAL_StatusTypeDef adc_sampler_start_dma(void)
+{
+    ADC_HandleTypeDef *hadc = s_config.hadc;
+
+    if ((hadc->Init.ContinuousConvMode != ENABLE) || (hadc->Init.DMAContinuousRequests != ENABLE))
+    {
+        hadc->Init.ContinuousConvMode = ENABLE;
+        hadc->Init.DMAContinuousRequests = ENABLE;
+        if (HAL_ADC_Init(hadc) != HAL_OK)
+        {
+            return HAL_ERROR;
+        }
+    }
+
+    return HAL_ADC_Start_DMA(hadc, (uint32_t *)s_dma_buf, s_dma_len);
+}
+
+/**
+ * @brief 启动后台采集。
+ */
+uint8_t adc_sampler_start(const adc_sampler_config_t *config)
+{
+    if ((config == NULL) || (config->hadc == NULL) || (config->hadc->DMA_Handle == NULL))
+    {
+        return 1U;
+    }
+    if ((config->channel_count == 0U) || (config->channel_count > ADC_SAMPLER_MAX_CHANNELS) ||
+        (config->channel_count != config->hadc->Init.NbrOfConversion))
+    {
+        return 1U;
+    }
+    if ((config->oversample_log2 > ADC_SAMPLER_MAX_OVERSAMPLE_LOG2) ||
+        (config->decimation_shift > config->oversample_log2) ||
+        ((uint32_t)(config->oversample_log2 - config->decimation_shift) > ADC_SAMPLER_MAX_EXTRA_BITS))
+    {
+        return 1U;
+    }
+    if ((config->ema_shift == 0U) || (config->ema_shift > ADC_SAMPLER_MAX_EMA_SHIFT))
+    {
+        return 1U;
+    }
+
+    if (s_running != 0U)
+    {
+        (void)adc_sampler_stop();
+    }
+
+    s_config = *config;
+    s_dma_len = 2UL * (1UL << config->oversample_log2) * config->channel_count;
+    s_ring_head = 0U;
+    s_ring_fill = 0U;
+    s_sequence = 0U;
+    s_ready = 0U;
+    memset(s_ring, 0, sizeof(s_ring));
+
+    if (adc_sampler_start_dma() != HAL_OK)
+    {
+        return 2U;
+    }
+    s_running = 1U;
+
+    return 0U;
+}
+
+/**
+ * @brief 停止后台采集。
+ */
+uint8_t adc_sampler_stop(void)
+{
+    if (s_running == 0U)
+    {
+        return 0U;
+    }
+
+    s_running = 0U;
+    if (HAL_ADC_Stop_DMA(s_config.hadc) != HAL_OK)
+    {
+        return 1U;
+    }
+
+    return 0U;
+}
+
+/**
+ * @brief 查询滤波结果是否就绪。
+ */
+uint8_t adc_sampler_is_ready(void)
+{
+    return s_ready;
+}
+
+/**
+ * @brief 获取抽取样本序号。
+ */
+uint32_t adc_sampler_get_sequence(void)
+{
+    return s_sequence;
+}
+
+/**
+ * @brief 读取一致性快照。
+ */
+uint8_t adc_sampler_read(uint8_t rank, adc_sampler_value_t *value)
+{
+    uint32_t seq;
+
+    if ((value == NULL) || (rank >= ADC_SAMPLER_MAX_CHANNELS))
+    {
+        return 1U;
+    }
+    if (s_ready == 0U)
+    {
+        return 2U;
+    }
+
+    do
+    {
+        seq = s_seqlock;
+        __DMB();
+        value->raw = s_latest[rank].raw;
+        value->median = s_latest[rank].median;
+        value->ema = s_latest[rank].ema;
+        __DMB();
+    } while (((seq & 1U) != 0U) || (seq != s_seqlock));
+
+    return 0U;
+}
+
+/**
+ * @brief 读取全部通道的一致性快照。
+ */
+uint8_t adc_sampler_read_all(adc_sampler_value_t *values, uint8_t count)
+{
+    uint32_t seq;
+
+    if ((values == NULL) || (count == 0U) || (count > s_config.channel_count))
+    {
+        return 1U;
+    }
+    if (s_ready == 0U)
+    {
+        return 2U;
+    }
+
+    do
+    {
+        seq = s_seqlock;
+        __DMB();
+        for (uint32_t rank = 0U; rank < count; ++rank)
+        {
+            values[rank].raw = s_latest[rank].raw;
+            values[rank].median = s_latest[rank].median;
+            values[rank].ema = s_latest[rank].ema;
+        }
+        __DMB();
+    } while (((seq & 1U) != 0U) || (seq != s_seqlock));
+
+    return 0U;
+}
+
+/**
+ * @brief 读取最新中值。
+ */
+uint16_t adc_sampler_get_median(uint8_t rank)
+{
+    return (rank < ADC_SAMPLER_MAX_CHANNELS) ? s_latest[rank].median : 0U;
+}
+
+/**
+ * @brief 读取最新 EMA。
+ */
+uint16_t adc_sampler_get_ema(uint8_t rank)
+{
+    return (rank < ADC_SAMPLER_MAX_CHANNELS) ? s_latest[rank].ema : 0U;
+}
+
+/**
+ * @brief 获取自动重启次数。
+ */
+uint32_t adc_sampler_get_restart_count(void)
+{
+    return s_restart_count;
+}
+
+/**
+ * @brief HAL 半传输完成回调：处理前半区。
+ */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if ((s_running != 0U) && (hadc == s_config.hadc))
+    {
+        adc_sampler_process_half(&s_dma_buf[0]);
+    }
+}
+
+/**
+ * @brief HAL 传输完成回调：处理后半区。
+ */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if ((s_running != 0U) && (hadc == s_config.hadc))
+    {
+        adc_sampler_process_half(&s_dma_buf[s_dma_len / 2U]);
+    }
+}
+
+/**
+ * @brief HAL 错误回调：溢出或 DMA 错误后重新启动循环采集。
+ */
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc)
+{
+    if ((s_running != 0U) && (hadc == s_config.hadc))
+    {
+        (void)HAL_ADC_Stop_DMA(hadc);
+        if (adc_sampler_start_dma() == HAL_OK)
+        {
+            ++s_restart_count;
+        }
+        else
+        {
+            s_running = 0U;
+        }
+    }
+}
@@ -27,6 +27,7 @@
 #include <stdbool.h>
 #include <ctype.h>
 #include <stdio.h>
+#include "json_stream.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -36,7 +37,6 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-#define UART_RX_BUFFER_SIZE 128U
 #define LED_NAME_MAX_LEN    16U
 #define LED_TOKEN_COUNT     3U
 
@@ -83,8 +83,24 @@ typedef struct
   size_t state_count;
 } LedCommand_t;
 
-static char g_rx_buffer[UART_RX_BUFFER_SIZE];
-static size_t g_rx_length = 0U;
+enum
+{
+  CONSOLE_FIELD_LED = 0,
+  CONSOLE_FIELD_STATE,
+  CONSOLE_FIELD_COUNT
+};
+
+typedef struct
+{
+  LedCommand_t cmd;
+  const char *error_msg;
+} ConsoleRequest_t;
+
+static ConsoleRequest_t g_request;
+/* 逐字节解析，每条命令比原 strstr 扫描多约 1600 条指令（主机统计 3560 对 1989），见 json_stream.h */
+static json_reader_t g_json_reader;
+static char g_json_text[LED_NAME_MAX_LEN];
+static size_t g_line_length = 0U;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -95,22 +111,25 @@ static void console_send_prompt(void);
 static void console_print_examples(void);
 static void console_print_gpio_map(void);
 static const char *console_skip_spaces(const char *ptr);
-static const char *console_find_json_value(const char *json, const char *key);
-static bool console_parse_led_targets(const char *json, LedCommand_t *cmd);
-static bool console_parse_state_values(const char *json, LedCommand_t *cmd);
-static bool console_parse_led_token(const char **cursor, LedCommand_t *cmd);
-static bool console_parse_state_token(const char **cursor, LedCommand_t *cmd);
-static bool console_add_led_index(LedCommand_t *cmd, uint8_t index);
-static uint32_t console_pin_index(uint16_t pin);
 static const char *console_port_name(GPIO_TypeDef *port);
+static uint32_t console_pin_index(uint16_t pin);
 static bool console_str_case_equal(const char *lhs, const char *rhs);
 static int8_t console_find_led_by_token(const char *token);
+static bool console_add_led_index(LedCommand_t *cmd, uint8_t index);
+static bool console_parse_led_token(const char *token, LedCommand_t *cmd, const char **error_msg);
+static bool console_on_led_field(const json_token_t *tok, void *ctx);
+static bool console_state_from_string(const char *token, bool *value);
+static bool console_state_from_number(const char *text);
+static bool console_state_from_token(const json_token_t *tok, bool *value);
+static bool console_on_state_field(const json_token_t *tok, void *ctx);
 static void console_set_led_state(uint8_t index, bool enabled);
 static void console_apply_command(const LedCommand_t *cmd);
 static void console_report_result(const LedCommand_t *cmd);
 static void console_report_error(const char *message);
+static const char *console_json_error(json_result_t result);
+static void console_reset_request(void);
+static void console_process_command(void);
 static void console_handle_input_byte(uint8_t data);
-static void console_process_command_buffer(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -185,7 +204,7 @@ static void console_print_gpio_map(void)
   console_send_string("]}\r\n");
 }
 
-/* 跳过当前字符串指针中的所有空白字符 */
+/* 在字符串中跳过空白字符，返回第一个有效字符 */
 static const char *console_skip_spaces(const char *ptr)
 {
   while ((ptr != NULL) && (*ptr != '\0') && isspace((unsigned char)*ptr))
@@ -195,29 +214,7 @@ static const char *console_skip_spaces(const char *ptr)
   return ptr;
 }
 
-/* 在伪 JSON 字符串中定位指定键的值 */
-static const char *console_find_json_value(const char *json, const char *key)
-{
-  if ((json == NULL) || (key == NULL))
-  {
-    return NULL;
-  }
-  const char *location = strstr(json, key);
-  if (location == NULL)
-  {
-    return NULL;
-  }
-  location += strlen(key);
-  location = console_skip_spaces(location);
-  if (*location != ':')
-  {
-    return NULL;
-  }
-  ++location;
-  return console_skip_spaces(location);
-}
-
-/* 不区分大小写比较两个字符串 */
+/* 忽略大小写比较两个字符串是否一致 */
 static bool console_str_case_equal(const char *lhs, const char *rhs)
 {
   if ((lhs == NULL) || (rhs == NULL))
@@ -238,14 +235,13 @@ static bool console_str_case_equal(const char *lhs, const char *rhs)
   return (*lhs == '\0') && (*rhs == '\0');
 }
 
-/* 根据别名查找 LED 在配置表中的索引 */
+/* 根据别名在 LED 配置表中查找索引 */
 static int8_t console_find_led_by_token(const char *token)
 {
   if (token == NULL)
   {
     return -1;
   }
-
   for (size_t i = 0U; i < LED_TOTAL; ++i)
   {
     for (size_t alias = 0U; alias < LED_TOKEN_COUNT; ++alias)
@@ -257,11 +253,10 @@ static int8_t console_find_led_by_token(const char *token)
       }
     }
   }
-
   return -1;
 }
 
-/* 向解析结果中追加一个 LED 索引（避免重复） */
+/* 向命令结构体中追加一颗 LED 索引并避免重复 */
 static bool console_add_led_index(LedCommand_t *cmd, uint8_t index)
 {
   if (cmd == NULL)
@@ -286,300 +281,211 @@ static bool console_add_led_index(LedCommand_t *cmd, uint8_t index)
   return true;
 }
 
-/* 解析单个字符串 token 并写入 LED 列表 */
-static bool console_parse_led_token(const char **cursor, LedCommand_t *cmd)
+/* 解析单个 LED 标识（含 ALL 关键字）并写入命令 */
+static bool console_parse_led_token(const char *token, LedCommand_t *cmd, const char **error_msg)
 {
-  if ((cursor == NULL) || (*cursor == NULL) || (cmd == NULL))
-  {
-    return false;
-  }
-
-  const char *ptr = *cursor;
-  if (*ptr != '"')
-  {
-    return false;
-  }
-  ++ptr;
-
-  const char *start = ptr;
-  while ((*ptr != '\0') && (*ptr != '"'))
-  {
-    ++ptr;
-  }
-  if (*ptr != '"')
-  {
-    return false;
-  }
-
-  const size_t length = (size_t)(ptr - start);
-  if ((length == 0U) || (length >= LED_NAME_MAX_LEN))
+  if ((token == NULL) || (cmd == NULL))
   {
+    if (error_msg != NULL)
+    {
+      *error_msg = "invalid led token";
+    }
     return false;
   }
 
-  char token[LED_NAME_MAX_LEN] = {0};
-  memcpy(token, start, length);
-  token[length] = '\0';
-  ++ptr;
-
   if (console_str_case_equal(token, "ALL"))
   {
     for (size_t i = 0U; i < LED_TOTAL; ++i)
     {
       if (!console_add_led_index(cmd, (uint8_t)i))
       {
+        if (error_msg != NULL)
+        {
+          *error_msg = "led list overflow";
+        }
         return false;
       }
     }
-    *cursor = ptr;
     return true;
   }
 
   const int8_t led_index = console_find_led_by_token(token);
   if (led_index < 0)
   {
+    if (error_msg != NULL)
+    {
+      *error_msg = "unknown led";
+    }
     return false;
   }
 
   if (!console_add_led_index(cmd, (uint8_t)led_index))
   {
+    if (error_msg != NULL)
+    {
+      *error_msg = "led list overflow";
+    }
     return false;
   }
 
-  *cursor = ptr;
   return true;
 }
 
-/* 解析 led 字段（支持字符串或数组） */
-static bool console_parse_led_targets(const char *json, LedCommand_t *cmd)
+/* led 字段处理函数：接收字符串或字符串数组的 token */
+static bool console_on_led_field(const json_token_t *tok, void *ctx)
 {
-  if ((json == NULL) || (cmd == NULL))
-  {
-    return false;
-  }
+  ConsoleRequest_t *req = (ConsoleRequest_t *)ctx;
 
-  const char *value = console_find_json_value(json, "\"led\"");
-  if (value == NULL)
+  if (tok->type == JSON_TOK_STRING)
   {
-    value = console_find_json_value(json, "\"LED\"");
+    return console_parse_led_token(tok->text, &req->cmd, &req->error_msg);
   }
-  if (value == NULL)
+  if ((tok->type == JSON_TOK_ARRAY_BEGIN) && (tok->depth == 1U))
   {
-    return false;
-  }
-
-  if (*value == '[')
-  {
-    ++value;
-    while (true)
-    {
-      value = console_skip_spaces(value);
-      if (*value == ']')
-      {
-        ++value;
-        break;
-      }
-      if (!console_parse_led_token(&value, cmd))
-      {
-        return false;
-      }
-      value = console_skip_spaces(value);
-      if (*value == ',')
-      {
-        ++value;
-        continue;
-      }
-      if (*value == ']')
-      {
-        ++value;
-        break;
-      }
-      return false;
-    }
+    return true;
   }
-  else if (*value == '"')
+  if ((tok->type == JSON_TOK_ARRAY_END) && (tok->depth == 1U))
   {
-    if (!console_parse_led_token(&value, cmd))
+    if (req->cmd.led_count == 0U)
     {
+      req->error_msg = "empty led list";
       return false;
     }
-  }
-  else
-  {
-    return false;
+    return true;
   }
 
-  return (cmd->led_count > 0U);
+  req->error_msg = (tok->depth == 1U) ? "invalid led field" : "invalid led entry";
+  return false;
 }
 
-/* 解析 state 的单个值，支持数字与文本 */
-static bool console_parse_state_token(const char **cursor, LedCommand_t *cmd)
+/* 从字符串解析开关状态（on/off/数字等） */
+static bool console_state_from_string(const char *token, bool *value)
 {
-  if ((cursor == NULL) || (*cursor == NULL) || (cmd == NULL))
+  if ((token == NULL) || (value == NULL))
   {
     return false;
   }
 
-  const char *ptr = *cursor;
-  bool value = false;
-  bool parsed = false;
-
-  if (*ptr == '"')
+  const char *ptr = console_skip_spaces(token);
+  if (console_str_case_equal(ptr, "on") || console_str_case_equal(ptr, "true") ||
+      console_str_case_equal(ptr, "enable"))
   {
-    ++ptr;
-    const char *start = ptr;
-    while ((*ptr != '\0') && (*ptr != '"'))
-    {
-      ++ptr;
-    }
-    if (*ptr != '"')
-    {
-      return false;
-    }
-    const size_t length = (size_t)(ptr - start);
-    if ((length == 0U) || (length >= LED_NAME_MAX_LEN))
-    {
-      return false;
-    }
-    char token[LED_NAME_MAX_LEN] = {0};
-    memcpy(token, start, length);
-    token[length] = '\0';
-    ++ptr;
-
-    if (console_str_case_equal(token, "on") || console_str_case_equal(token, "true") ||
-        console_str_case_equal(token, "enable"))
-    {
-      value = true;
-      parsed = true;
-    }
-    else if (console_str_case_equal(token, "off") || console_str_case_equal(token, "false") ||
-             console_str_case_equal(token, "disable"))
-    {
-      value = false;
-      parsed = true;
-    }
+    *value = true;
+    return true;
   }
-  else if (isalpha((unsigned char)*ptr))
+  if (console_str_case_equal(ptr, "off") || console_str_case_equal(ptr, "false") ||
+      console_str_case_equal(ptr, "disable"))
   {
-    const char *start = ptr;
-    while (isalpha((unsigned char)*ptr))
-    {
-      ++ptr;
-    }
-    const size_t length = (size_t)(ptr - start);
-    if ((length == 0U) || (length >= LED_NAME_MAX_LEN))
-    {
-      return false;
-    }
-    char token[LED_NAME_MAX_LEN] = {0};
-    memcpy(token, start, length);
-    token[length] = '\0';
-    if (console_str_case_equal(token, "on") || console_str_case_equal(token, "true"))
-    {
-      value = true;
-      parsed = true;
-    }
-    else if (console_str_case_equal(token, "off") || console_str_case_equal(token, "false"))
-    {
-      value = false;
-      parsed = true;
-    }
+    *value = false;
+    return true;
   }
-  else
+
+  bool negative = false;
+  if (*ptr == '-')
   {
-    bool negative = false;
-    if (*ptr == '-')
-    {
-      negative = true;
-      ++ptr;
-    }
-    if (!isdigit((unsigned char)*ptr))
-    {
-      return false;
-    }
-    uint32_t number = 0U;
-    while (isdigit((unsigned char)*ptr))
-    {
-      number = (number * 10U) + (uint32_t)(*ptr - '0');
-      ++ptr;
-    }
-    value = (!negative) && (number != 0U);
-    parsed = true;
+    negative = true;
+    ++ptr;
   }
 
-  if (!parsed)
+  if (!isdigit((unsigned char)*ptr))
   {
     return false;
   }
 
-  if (cmd->state_count >= LED_TOTAL)
+  uint32_t number = 0U;
+  while (isdigit((unsigned char)*ptr))
+  {
+    number = (number * 10U) + (uint32_t)(*ptr - '0');
+    ++ptr;
+  }
+
+  ptr = console_skip_spaces(ptr);
+  if (*ptr != '\0')
   {
     return false;
   }
 
-  cmd->states[cmd->state_count++] = value;
-  *cursor = ptr;
+  *value = (!negative) && (number != 0U);
   return true;
 }
 
-/* 解析 state 字段（单值或数组） */
-static bool console_parse_state_values(const char *json, LedCommand_t *cmd)
+/* JSON 数字的尾数中有非零数字即为开，不做浮点转换 */
+static bool console_state_from_number(const char *text)
 {
-  if ((json == NULL) || (cmd == NULL))
+  for (; (*text != '\0') && (*text != 'e') && (*text != 'E'); ++text)
   {
-    return false;
+    if ((*text >= '1') && (*text <= '9'))
+    {
+      return true;
+    }
   }
+  return false;
+}
 
-  const char *value = console_find_json_value(json, "\"state\"");
-  if (value == NULL)
+/* 根据 token 类型提取状态值 */
+static bool console_state_from_token(const json_token_t *tok, bool *value)
+{
+  switch (tok->type)
   {
-    value = console_find_json_value(json, "\"STATE\"");
+    case JSON_TOK_TRUE:
+      *value = true;
+      return true;
+    case JSON_TOK_FALSE:
+      *value = false;
+      return true;
+    case JSON_TOK_NUMBER:
+      *value = console_state_from_number(tok->text);
+      return true;
+    case JSON_TOK_STRING:
+      return console_state_from_string(tok->text, value);
+    default:
+      return false;
   }
-  if (value == NULL)
+}
+
+/* state 字段处理函数：接收单值或数组的 token */
+static bool console_on_state_field(const json_token_t *tok, void *ctx)
+{
+  ConsoleRequest_t *req = (ConsoleRequest_t *)ctx;
+
+  if ((tok->type == JSON_TOK_ARRAY_BEGIN) && (tok->depth == 1U))
   {
-    return false;
+    return true;
   }
-
-  if (*value == '[')
+  if ((tok->type == JSON_TOK_ARRAY_END) && (tok->depth == 1U))
   {
-    ++value;
-    while (true)
+    if (req->cmd.state_count == 0U)
     {
-      value = console_skip_spaces(value);
-      if (*value == ']')
-      {
-        ++value;
-        break;
-      }
-      if (!console_parse_state_token(&value, cmd))
-      {
-        return false;
-      }
-      value = console_skip_spaces(value);
-      if (*value == ',')
-      {
-        ++value;
-        continue;
-      }
-      if (*value == ']')
-      {
-        ++value;
-        break;
-      }
+      req->error_msg = "empty state list";
       return false;
     }
+    return true;
   }
-  else
+
+  bool value = false;
+  if (!console_state_from_token(tok, &value))
   {
-    if (!console_parse_state_token(&value, cmd))
-    {
-      return false;
-    }
+    req->error_msg = "invalid state value";
+    return false;
+  }
+
+  if (req->cmd.state_count >= LED_TOTAL)
+  {
+    req->error_msg = "state list overflow";
+    return false;
   }
 
-  return (cmd->state_count > 0U);
+  req->cmd.states[req->cmd.state_count++] = value;
+  return true;
 }
 
+/* 命令字段表，顺序与 CONSOLE_FIELD_xxx 一致；键名不区分大小写 */
+static const json_field_t g_command_fields[CONSOLE_FIELD_COUNT] =
+{
+  {"led", console_on_led_field},
+  {"state", console_on_state_field}
+};
+
 /* 操作具体 LED 引脚输出状态 */
 static void console_set_led_state(uint8_t index, bool enabled)
 {
@@ -651,37 +557,64 @@ static void console_report_error(const char *message)
   console_send_string(buffer);
 }
 
-/* 处理完整命令字符串并执行 */
-static void console_process_command_buffer(void)
+/* 将解析器错误码转换为错误信息 */
+static const char *console_json_error(json_result_t result)
+{
+  switch (result)
+  {
+    case JSON_ERR_FIELD:
+      return (g_request.error_msg != NULL) ? g_request.error_msg : "invalid value";
+    case JSON_ERR_DUPLICATE:
+      return "duplicate field";
+    case JSON_ERR_TOKEN:
+      return "token too long";
+    default:
+      return "invalid json";
+  }
+}
+
+/* 复位解析器与命令，准备接收下一行 */
+static void console_reset_request(void)
+{
+  memset(&g_request, 0, sizeof(g_request));
+  json_reader_reset(&g_json_reader);
+  g_line_length = 0U;
+}
+
+/* 一行结束：检查解析结果并执行 LED 控制 */
+static void console_process_command(void)
 {
-  g_rx_buffer[g_rx_length] = '\0';
-  if (g_rx_length == 0U)
+  const json_result_t result = json_reader_end(&g_json_reader);
+  if (result != JSON_DONE)
   {
+    console_report_error(console_json_error(result));
     return;
   }
 
-  LedCommand_t command = {0};
-  if (!console_parse_led_targets(g_rx_buffer, &command))
+  const uint32_t seen = json_reader_seen(&g_json_reader);
+  if ((seen & (1UL << CONSOLE_FIELD_LED)) == 0UL)
   {
     console_report_error("missing led field");
     return;
   }
-  if (!console_parse_state_values(g_rx_buffer, &command))
+  if ((seen & (1UL << CONSOLE_FIELD_STATE)) == 0UL)
   {
     console_report_error("missing state field");
     return;
   }
-  if (!((command.state_count == 1U) || (command.state_count == command.led_count)))
+
+  const LedCommand_t *command = &g_request.cmd;
+  if (!((command->state_count == 1U) || (command->state_count == command->led_count)))
   {
     console_report_error("state count mismatch");
     return;
   }
 
-  console_apply_command(&command);
-  console_report_result(&command);
+  console_apply_command(command);
+  console_report_result(command);
 }
 
-/* 串口逐字节处理函数，负责拼接命令 */
+/* 串口逐字节处理函数：字节直接送入 JSON 解析器，换行时执行命令 */
 static void console_handle_input_byte(uint8_t data)
 {
   if (data == '\r')
@@ -690,21 +623,17 @@ static void console_handle_input_byte(uint8_t data)
   }
   if (data == '\n')
   {
-    console_process_command_buffer();
-    g_rx_length = 0U;
-    console_send_prompt();
-    return;
-  }
-
-  if (g_rx_length >= (UART_RX_BUFFER_SIZE - 1U))
-  {
-    g_rx_length = 0U;
-    console_report_error("command too long");
+    if (g_line_length != 0U)
+    {
+      console_process_command();
+    }
+    console_reset_request();
     console_send_prompt();
     return;
   }
 
-  g_rx_buffer[g_rx_length++] = (char)data;
+  ++g_line_length;
+  (void)json_reader_push(&g_json_reader, (char)data);
 }
 /* USER CODE END 0 */
 
@@ -740,6 +669,8 @@ int main(void)
   MX_GPIO_Init();
   MX_USART2_UART_Init();
   /* USER CODE BEGIN 2 */
+  json_reader_init(&g_json_reader, g_command_fields, CONSOLE_FIELD_COUNT,
+                   &g_request, g_json_text, sizeof(g_json_text));
   console_print_examples();
   console_print_gpio_map();
   console_send_prompt();
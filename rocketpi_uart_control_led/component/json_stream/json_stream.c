@@ -0,0 +1,625 @@
+/**
+ * @file    json_stream.c
+ * @brief   逐字节 JSON 词法器与对象读取器实现。
+ *
+ * 词法器是一个字节驱动的状态机，容器类型用 containers 位栈记录。
+ * 数字与字面量没有结束符，要等到下一个分隔字节才能确定结束，
+ * 因此一次推入最多产生两个 token（例如 "1]" 中的 ']'）。
+ */
+#include "json_stream.h"
+
+#define JSON_NO_FIELD   0xFFU
+
+enum
+{
+    ST_VALUE = 0,       /* 等待值 */
+    ST_ARRAY_FIRST,     /* '[' 之后：值或 ']' */
+    ST_OBJECT_FIRST,    /* '{' 之后：键或 '}' */
+    ST_KEY,             /* ',' 之后：键 */
+    ST_COLON,           /* 键之后：':' */
+    ST_AFTER_VALUE,     /* 值之后：',' 或结束符 */
+    ST_STRING,
+    ST_STRING_ESC,
+    ST_STRING_HEX,
+    ST_NUMBER,
+    ST_LITERAL,
+    ST_DONE,
+    ST_ERROR
+};
+
+static bool json_is_space(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+static bool json_is_digit(char c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+static json_result_t json_fail(json_stream_t *js, json_result_t result)
+{
+    js->state = ST_ERROR;
+    js->result = result;
+    return result;
+}
+
+static json_result_t json_emit(json_stream_t *js, json_tok_type_t type, bool has_text)
+{
+    json_token_t *tok = &js->pending[js->pending_count++];
+
+    tok->type = type;
+    tok->depth = js->depth;
+    tok->len = has_text ? js->text_len : 0U;
+    tok->text = has_text ? js->text : NULL;
+    return JSON_OK;
+}
+
+static json_result_t json_append(json_stream_t *js, char c)
+{
+    if ((uint16_t)(js->text_len + 1U) >= js->text_size)
+    {
+        return json_fail(js, JSON_ERR_TOKEN);
+    }
+    js->text[js->text_len++] = c;
+    js->text[js->text_len] = '\0';
+    return JSON_OK;
+}
+
+static void json_text_clear(json_stream_t *js)
+{
+    js->text_len = 0U;
+    js->text[0] = '\0';
+}
+
+/* 一个值结束：回到容器内或结束顶层 */
+static json_result_t json_value_done(json_stream_t *js)
+{
+    if (js->depth == 0U)
+    {
+        js->state = ST_DONE;
+        js->result = JSON_DONE;
+        return JSON_DONE;
+    }
+    js->state = ST_AFTER_VALUE;
+    return JSON_OK;
+}
+
+static json_result_t json_open(json_stream_t *js, bool is_object)
+{
+    if (js->depth >= JSON_STREAM_MAX_DEPTH)
+    {
+        return json_fail(js, JSON_ERR_DEPTH);
+    }
+    (void)json_emit(js, is_object ? JSON_TOK_OBJECT_BEGIN : JSON_TOK_ARRAY_BEGIN, false);
+    if (is_object)
+    {
+        js->containers |= (1U << js->depth);
+    }
+    else
+    {
+        js->containers &= ~(1U << js->depth);
+    }
+    js->depth++;
+    js->state = is_object ? ST_OBJECT_FIRST : ST_ARRAY_FIRST;
+    return JSON_OK;
+}
+
+static json_result_t json_close(json_stream_t *js, bool is_object)
+{
+    bool top_is_object;
+
+    if (js->depth == 0U)
+    {
+        return json_fail(js, JSON_ERR_SYNTAX);
+    }
+    top_is_object = ((js->containers >> (js->depth - 1U)) & 1U) != 0U;
+    if (top_is_object != is_object)
+    {
+        return json_fail(js, JSON_ERR_SYNTAX);
+    }
+    js->depth--;
+    (void)json_emit(js, is_object ? JSON_TOK_OBJECT_END : JSON_TOK_ARRAY_END, false);
+    return json_value_done(js);
+}
+
+static json_result_t json_begin_value(json_stream_t *js, char c)
+{
+    json_text_clear(js);
+    if (c == '{')
+    {
+        return json_open(js, true);
+    }
+    if (c == '[')
+    {
+        return json_open(js, false);
+    }
+    if (c == '"')
+    {
+        js->is_key = 0U;
+        js->state = ST_STRING;
+        return JSON_OK;
+    }
+    if ((c == '-') || json_is_digit(c))
+    {
+        js->state = ST_NUMBER;
+        return json_append(js, c);
+    }
+    if ((c == 't') || (c == 'f') || (c == 'n'))
+    {
+        js->state = ST_LITERAL;
+        return json_append(js, c);
+    }
+    return json_fail(js, JSON_ERR_SYNTAX);
+}
+
+static json_result_t json_begin_key(json_stream_t *js)
+{
+    json_text_clear(js);
+    js->is_key = 1U;
+    js->state = ST_STRING;
+    return JSON_OK;
+}
+
+/* 按 JSON 语法检查数字：-?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)? */
+static bool json_number_valid(const char *p)
+{
+    if (*p == '-')
+    {
+        p++;
+    }
+    if (*p == '0')
+    {
+        p++;
+    }
+    else if (json_is_digit(*p))
+    {
+        while (json_is_digit(*p))
+        {
+            p++;
+        }
+    }
+    else
+    {
+        return false;
+    }
+    if (*p == '.')
+    {
+        p++;
+        if (!json_is_digit(*p))
+        {
+            return false;
+        }
+        while (json_is_digit(*p))
+        {
+            p++;
+        }
+    }
+    if ((*p == 'e') || (*p == 'E'))
+    {
+        p++;
+        if ((*p == '+') || (*p == '-'))
+        {
+            p++;
+        }
+        if (!json_is_digit(*p))
+        {
+            return false;
+        }
+        while (json_is_digit(*p))
+        {
+            p++;
+        }
+    }
+    return *p == '\0';
+}
+
+static bool json_text_equal(const json_stream_t *js, const char *literal)
+{
+    uint16_t i = 0U;
+
+    while ((i < js->text_len) && (literal[i] != '\0') && (js->text[i] == literal[i]))
+    {
+        i++;
+    }
+    return (i == js->text_len) && (literal[i] == '\0');
+}
+
+/* 数字或字面量遇到分隔字节时结束 */
+static json_result_t json_end_scalar(json_stream_t *js)
+{
+    json_tok_type_t type;
+
+    if (js->state == ST_NUMBER)
+    {
+        if (!json_number_valid(js->text))
+        {
+            return json_fail(js, JSON_ERR_SYNTAX);
+        }
+        type = JSON_TOK_NUMBER;
+    }
+    else if (json_text_equal(js, "true"))
+    {
+        type = JSON_TOK_TRUE;
+    }
+    else if (json_text_equal(js, "false"))
+    {
+        type = JSON_TOK_FALSE;
+    }
+    else if (json_text_equal(js, "null"))
+    {
+        type = JSON_TOK_NULL;
+    }
+    else
+    {
+        return json_fail(js, JSON_ERR_SYNTAX);
+    }
+    (void)json_emit(js, type, true);
+    return json_value_done(js);
+}
+
+/* 把 \uXXXX 按 UTF-8 写入文本（代理对不合并） */
+static json_result_t json_append_code(json_stream_t *js, uint16_t code)
+{
+    json_result_t result;
+
+    if (code < 0x80U)
+    {
+        return json_append(js, (char)code);
+    }
+    if (code < 0x800U)
+    {
+        result = json_append(js, (char)(0xC0U | (code >> 6)));
+    }
+    else
+    {
+        result = json_append(js, (char)(0xE0U | (code >> 12)));
+        if (result == JSON_OK)
+        {
+            result = json_append(js, (char)(0x80U | ((code >> 6) & 0x3FU)));
+        }
+    }
+    if (result == JSON_OK)
+    {
+        result = json_append(js, (char)(0x80U | (code & 0x3FU)));
+    }
+    return result;
+}
+
+static json_result_t json_string_escape(json_stream_t *js, char c)
+{
+    static const char kEscIn[] = "\"\\/bfnrt";
+    static const char kEscOut[] = "\"\\/\b\f\n\r\t";
+
+    if (c == 'u')
+    {
+        js->esc_hex = 4U;
+        js->esc_code = 0U;
+        js->state = ST_STRING_HEX;
+        return JSON_OK;
+    }
+    for (uint8_t i = 0U; kEscIn[i] != '\0'; i++)
+    {
+        if (kEscIn[i] == c)
+        {
+            js->state = ST_STRING;
+            return json_append(js, kEscOut[i]);
+        }
+    }
+    return json_fail(js, JSON_ERR_SYNTAX);
+}
+
+static json_result_t json_string_hex(json_stream_t *js, char c)
+{
+    uint16_t digit;
+
+    if (json_is_digit(c))
+    {
+        digit = (uint16_t)(c - '0');
+    }
+    else if ((c >= 'a') && (c <= 'f'))
+    {
+        digit = (uint16_t)(c - 'a' + 10);
+    }
+    else if ((c >= 'A') && (c <= 'F'))
+    {
+        digit = (uint16_t)(c - 'A' + 10);
+    }
+    else
+    {
+        return json_fail(js, JSON_ERR_SYNTAX);
+    }
+    js->esc_code = (uint16_t)((js->esc_code << 4) | digit);
+    if (--js->esc_hex != 0U)
+    {
+        return JSON_OK;
+    }
+    js->state = ST_STRING;
+    if (js->esc_code == 0U)
+    {
+        /* 文本以 0 结尾，不接受 \u0000 */
+        return json_fail(js, JSON_ERR_SYNTAX);
+    }
+    return json_append_code(js, js->esc_code);
+}
+
+static json_result_t json_string_char(json_stream_t *js, char c)
+{
+    if (c == '"')
+    {
+        if (js->is_key != 0U)
+        {
+            (void)json_emit(js, JSON_TOK_KEY, true);
+            js->state = ST_COLON;
+            return JSON_OK;
+        }
+        (void)json_emit(js, JSON_TOK_STRING, true);
+        return json_value_done(js);
+    }
+    if (c == '\\')
+    {
+        js->state = ST_STRING_ESC;
+        return JSON_OK;
+    }
+    if ((unsigned char)c < 0x20U)
+    {
+        return json_fail(js, JSON_ERR_SYNTAX);
+    }
+    return json_append(js, c);
+}
+
+/* 处理一个字节；数字/字面量结束时该字节需要在新状态下再处理一次 */
+static json_result_t json_step(json_stream_t *js, char c)
+{
+    switch (js->state)
+    {
+    case ST_STRING:
+        return json_string_char(js, c);
+    case ST_STRING_ESC:
+        return json_string_escape(js, c);
+    case ST_STRING_HEX:
+        return json_string_hex(js, c);
+    case ST_NUMBER:
+        if (json_is_digit(c) || (c == '.') || (c == 'e') || (c == 'E') || (c == '+') || (c == '-'))
+        {
+            return json_append(js, c);
+        }
+        if (json_end_scalar(js) >= JSON_ERR_SYNTAX)
+        {
+            return js->result;
+        }
+        return json_step(js, c);
+    case ST_LITERAL:
+        if ((c >= 'a') && (c <= 'z'))
+        {
+            return json_append(js, c);
+        }
+        if (json_end_scalar(js) >= JSON_ERR_SYNTAX)
+        {
+            return js->result;
+        }
+        return json_step(js, c);
+    default:
+        break;
+    }
+
+    if (json_is_space(c))
+    {
+        return (js->state == ST_DONE) ? JSON_DONE : JSON_OK;
+    }
+
+    switch (js->state)
+    {
+    case ST_VALUE:
+        return json_begin_value(js, c);
+    case ST_ARRAY_FIRST:
+        return (c == ']') ? json_close(js, false) : json_begin_value(js, c);
+    case ST_OBJECT_FIRST:
+        if (c == '}')
+        {
+            return json_close(js, true);
+        }
+        return (c == '"') ? json_begin_key(js) : json_fail(js, JSON_ERR_SYNTAX);
+    case ST_KEY:
+        return (c == '"') ? json_begin_key(js) : json_fail(js, JSON_ERR_SYNTAX);
+    case ST_COLON:
+        if (c != ':')
+        {
+            return json_fail(js, JSON_ERR_SYNTAX);
+        }
+        js->state = ST_VALUE;
+        return JSON_OK;
+    case ST_AFTER_VALUE:
+        if (c == ',')
+        {
+            js->state = (((js->containers >> (js->depth - 1U)) & 1U) != 0U) ? ST_KEY : ST_VALUE;
+            return JSON_OK;
+        }
+        if ((c == ']') || (c == '}'))
+        {
+            return json_close(js, c == '}');
+        }
+        return json_fail(js, JSON_ERR_SYNTAX);
+    default:
+        /* ST_DONE 之后的非空白字节 */
+        return json_fail(js, JSON_ERR_SYNTAX);
+    }
+}
+
+void json_stream_init(json_stream_t *js, char *text, uint16_t text_size)
+{
+    js->text = text;
+    js->text_size = text_size;
+    json_stream_reset(js);
+}
+
+void json_stream_reset(json_stream_t *js)
+{
+    js->text_len = 0U;
+    js->state = ST_VALUE;
+    js->depth = 0U;
+    js->is_key = 0U;
+    js->esc_hex = 0U;
+    js->esc_code = 0U;
+    js->pending_count = 0U;
+    js->pending_read = 0U;
+    js->containers = 0U;
+    js->result = JSON_OK;
+}
+
+json_result_t json_stream_push(json_stream_t *js, char c)
+{
+    js->pending_count = 0U;
+    js->pending_read = 0U;
+    /* 字符串中的普通字节占输入的大部分，直接追加 */
+    if ((js->state == ST_STRING) && (c != '"') && (c != '\\') && ((unsigned char)c >= 0x20U))
+    {
+        return json_append(js, c);
+    }
+    if (js->state == ST_ERROR)
+    {
+        return js->result;
+    }
+    (void)json_step(js, c);
+    return js->result;
+}
+
+bool json_stream_next(json_stream_t *js, json_token_t *tok)
+{
+    if (js->pending_read >= js->pending_count)
+    {
+        return false;
+    }
+    *tok = js->pending[js->pending_read++];
+    return true;
+}
+
+json_result_t json_stream_end(json_stream_t *js)
+{
+    js->pending_count = 0U;
+    js->pending_read = 0U;
+    if ((js->state == ST_NUMBER) || (js->state == ST_LITERAL))
+    {
+        (void)json_end_scalar(js);
+    }
+    if ((js->state != ST_DONE) && (js->state != ST_ERROR))
+    {
+        (void)json_fail(js, JSON_ERR_INCOMPLETE);
+    }
+    return js->result;
+}
+
+/* ASCII 不区分大小写比较键名 */
+static bool json_key_equal(const char *lhs, const char *rhs)
+{
+    while ((*lhs != '\0') && (*rhs != '\0'))
+    {
+        char a = *lhs++;
+        char b = *rhs++;
+
+        if ((a >= 'A') && (a <= 'Z'))
+        {
+            a = (char)(a - 'A' + 'a');
+        }
+        if ((b >= 'A') && (b <= 'Z'))
+        {
+            b = (char)(b - 'A' + 'a');
+        }
+        if (a != b)
+        {
+            return false;
+        }
+    }
+    return *lhs == *rhs;
+}
+
+/* 分发一个 token，返回 JSON_OK 或错误码 */
+static json_result_t json_reader_dispatch(json_reader_t *reader, const json_token_t *tok)
+{
+    if (tok->depth == 0U)
+    {
+        /* 顶层必须是对象 */
+        return ((tok->type == JSON_TOK_OBJECT_BEGIN) || (tok->type == JSON_TOK_OBJECT_END)) ?
+               JSON_OK : JSON_ERR_SYNTAX;
+    }
+    if ((tok->depth == 1U) && (tok->type == JSON_TOK_KEY))
+    {
+        reader->active = JSON_NO_FIELD;
+        for (uint8_t i = 0U; i < reader->field_count; i++)
+        {
+            if (json_key_equal(tok->text, reader->fields[i].key))
+            {
+                if ((reader->seen & (1U << i)) != 0U)
+                {
+                    return JSON_ERR_DUPLICATE;
+                }
+                reader->seen |= (1U << i);
+                reader->active = i;
+                break;
+            }
+        }
+        return JSON_OK;
+    }
+    if (reader->active == JSON_NO_FIELD)
+    {
+        return JSON_OK;
+    }
+    return reader->fields[reader->active].handler(tok, reader->ctx) ? JSON_OK : JSON_ERR_FIELD;
+}
+
+static json_result_t json_reader_drain(json_reader_t *reader)
+{
+    json_token_t tok;
+
+    while (json_stream_next(&reader->stream, &tok))
+    {
+        json_result_t result = json_reader_dispatch(reader, &tok);
+        if (result != JSON_OK)
+        {
+            return json_fail(&reader->stream, result);
+        }
+    }
+    return reader->stream.result;
+}
+
+void json_reader_init(json_reader_t *reader, const json_field_t *fields, uint8_t field_count,
+                      void *ctx, char *text, uint16_t text_size)
+{
+    reader->fields = fields;
+    reader->field_count = (field_count > 32U) ? 32U : field_count;
+    reader->ctx = ctx;
+    json_stream_init(&reader->stream, text, text_size);
+    json_reader_reset(reader);
+}
+
+void json_reader_reset(json_reader_t *reader)
+{
+    json_stream_reset(&reader->stream);
+    reader->seen = 0U;
+    reader->active = JSON_NO_FIELD;
+}
+
+json_result_t json_reader_push(json_reader_t *reader, char c)
+{
+    json_result_t result = json_stream_push(&reader->stream, c);
+
+    if ((result >= JSON_ERR_SYNTAX) || (reader->stream.pending_count == 0U))
+    {
+        return result;
+    }
+    return json_reader_drain(reader);
+}
+
+json_result_t json_reader_end(json_reader_t *reader)
+{
+    if (json_stream_end(&reader->stream) >= JSON_ERR_SYNTAX)
+    {
+        return reader->stream.result;
+    }
+    return json_reader_drain(reader);
+}
+
+uint32_t json_reader_seen(const json_reader_t *reader)
+{
+    return reader->seen;
+}
@@ -59,6 +59,8 @@ typedef struct
 /* USER CODE BEGIN PD */
 #define UART_RX_BUFFER_SIZE 128U
 #define LED_NAME_MAX_LEN    16U
+/* 解析一条命令可用的 cJSON 节点数，完整命令最多 9 个（对象 + 两个 3 元素数组） */
+#define JSON_NODE_COUNT     24U
 
 #define LED_ACTIVE_LOW      1
 
@@ -87,6 +89,12 @@ static const LedConfig_t g_led_config[LED_TOTAL] =
 
 static char g_rx_buffer[UART_RX_BUFFER_SIZE];
 static size_t g_rx_length = 0U;
+
+/* cJSON 在节点池上解析，字符串就地指向 g_rx_buffer，数字的临时文本放在 scratch 中，不使用堆。
+ * 本示例用于演示 cJSON，不改用 rocketpi_uart_control_led 中的 json_stream 流式解析 */
+static cJSON g_json_nodes[JSON_NODE_COUNT];
+static char g_json_scratch[UART_RX_BUFFER_SIZE];
+static cJSON_Arena g_json_arena;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -629,7 +637,10 @@ static void console_process_command_buffer(void)
     return;
   }
 
-  cJSON *root = cJSON_Parse(g_rx_buffer);
+  /* 上一条命令的树随之释放；节点不够时按无效 JSON 处理 */
+  cJSON_ArenaReset(&g_json_arena);
+  const cJSON *root = cJSON_ParseArena(&g_json_arena, g_rx_buffer, g_rx_length + 1U, NULL,
+                                       cJSON_ArenaInSitu);
   if (root == NULL)
   {
     console_report_error("invalid json");
@@ -641,20 +652,16 @@ static void console_process_command_buffer(void)
 
   if (!console_parse_led_targets(root, &command, &error_msg))
   {
-    cJSON_Delete(root);
     console_report_error((error_msg != NULL) ? error_msg : "invalid led field");
     return;
   }
 
   if (!console_parse_state_values(root, &command, &error_msg))
   {
-    cJSON_Delete(root);
     console_report_error((error_msg != NULL) ? error_msg : "invalid state field");
     return;
   }
 
-  cJSON_Delete(root);
-
   if (!((command.state_count == 1U) || (command.state_count == command.led_count)))
   {
     console_report_error("state count mismatch");
@@ -723,6 +730,7 @@ int main(void)
   MX_GPIO_Init();
   MX_USART2_UART_Init();
   /* USER CODE BEGIN 2 */
+  cJSON_ArenaInit(&g_json_arena, g_json_nodes, JSON_NODE_COUNT, g_json_scratch, sizeof(g_json_scratch));
   console_print_examples();
   console_print_gpio_map();
   console_send_prompt();
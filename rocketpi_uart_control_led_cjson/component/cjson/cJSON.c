@@ -185,6 +185,71 @@ static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
 
 static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc };
 
+/* arena used by cJSON_ParseArena while it runs */
+static cJSON_Arena *current_arena = NULL;
+
+static void * CJSON_CDECL arena_allocate(size_t size)
+{
+    cJSON_Arena *arena = current_arena;
+    void *pointer = NULL;
+
+    if ((arena == NULL) || (size > (arena->buffer_size - arena->buffer_used)))
+    {
+        return NULL;
+    }
+
+    pointer = arena->buffer + arena->buffer_used;
+    arena->last = arena->buffer_used;
+    arena->buffer_used += size;
+    arena->allocations++;
+
+    return pointer;
+}
+
+/* only the most recent allocation can be given back (number scratch, failed strings) */
+static void CJSON_CDECL arena_deallocate(void *pointer)
+{
+    cJSON_Arena *arena = current_arena;
+
+    if ((arena == NULL) || (pointer == NULL))
+    {
+        return;
+    }
+
+    if ((arena->nodes_used > 0) && (pointer == (void*)&arena->nodes[arena->nodes_used - 1]))
+    {
+        arena->nodes_used--;
+    }
+    else if ((arena->last < arena->buffer_used) && (pointer == (void*)(arena->buffer + arena->last)))
+    {
+        arena->buffer_used = arena->last;
+    }
+}
+
+static const internal_hooks arena_hooks = { arena_allocate, arena_deallocate, NULL };
+
+static cJSON *arena_new_node(void)
+{
+    cJSON_Arena *arena = current_arena;
+
+    if ((arena == NULL) || (arena->nodes_used >= arena->node_count))
+    {
+        return NULL;
+    }
+
+    arena->allocations++;
+    return &arena->nodes[arena->nodes_used++];
+}
+
+/* arena trees are released by cJSON_ArenaReset, not item by item */
+static void delete_parsed(cJSON *item, const internal_hooks * const hooks)
+{
+    if (hooks->allocate != arena_allocate)
+    {
+        cJSON_Delete(item);
+    }
+}
+
 static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
 {
     size_t length = 0;
@@ -240,7 +305,7 @@ CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
 /* Internal constructor. */
 static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
 {
-    cJSON* node = (cJSON*)hooks->allocate(sizeof(cJSON));
+    cJSON* node = (hooks->allocate == arena_allocate) ? arena_new_node() : (cJSON*)hooks->allocate(sizeof(cJSON));
     if (node)
     {
         memset(node, '\0', sizeof(cJSON));
@@ -293,6 +358,7 @@ typedef struct
     size_t offset;
     size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
     internal_hooks hooks;
+    cJSON_bool in_situ; /* unescape strings into the input instead of allocating them */
 } parse_buffer;
 
 /* check if the given size is left to read in a given parse buffer (starting with 1) */
@@ -853,12 +919,20 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
             goto fail; /* string ended unexpectedly */
         }
 
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
+        if (input_buffer->in_situ)
         {
-            goto fail; /* allocation failure */
+            /* unescaping never makes the string longer, and the closing quote takes the terminator */
+            output = (unsigned char*)input_pointer;
+        }
+        else
+        {
+            /* This is at most how much we need for the output */
+            allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+            output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+            if (output == NULL)
+            {
+                goto fail; /* allocation failure */
+            }
         }
     }
 
@@ -931,7 +1005,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     return true;
 
 fail:
-    if (output != NULL)
+    if ((output != NULL) && !input_buffer->in_situ)
     {
         input_buffer->hooks.deallocate(output);
         output = NULL;
@@ -1139,9 +1213,9 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return
 }
 
 /* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+static cJSON *parse_with_hooks(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, const internal_hooks * const hooks, cJSON_bool in_situ)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, 0 };
     cJSON *item = NULL;
 
     /* reset error position */
@@ -1156,9 +1230,10 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
     buffer.content = (const unsigned char*)value;
     buffer.length = buffer_length;
     buffer.offset = 0;
-    buffer.hooks = global_hooks;
+    buffer.hooks = *hooks;
+    buffer.in_situ = in_situ;
 
-    item = cJSON_New_Item(&global_hooks);
+    item = cJSON_New_Item(hooks);
     if (item == NULL) /* memory fail */
     {
         goto fail;
@@ -1189,7 +1264,7 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer
 fail:
     if (item != NULL)
     {
-        cJSON_Delete(item);
+        delete_parsed(item, hooks);
     }
 
     if (value != NULL)
@@ -1218,6 +1293,67 @@ fail:
     return NULL;
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_with_hooks(value, buffer_length, return_parse_end, require_null_terminated, &global_hooks, false);
+}
+
+CJSON_PUBLIC(void) cJSON_ArenaInit(cJSON_Arena *arena, cJSON *nodes, size_t node_count, void *buffer, size_t buffer_size)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    arena->nodes = nodes;
+    arena->node_count = (nodes != NULL) ? node_count : 0;
+    arena->buffer = (unsigned char*)buffer;
+    arena->buffer_size = (buffer != NULL) ? buffer_size : 0;
+    cJSON_ArenaReset(arena);
+}
+
+CJSON_PUBLIC(void) cJSON_ArenaReset(cJSON_Arena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    arena->nodes_used = 0;
+    arena->buffer_used = 0;
+    arena->last = 0;
+    arena->allocations = 0;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseArena(cJSON_Arena *arena, char *value, size_t buffer_length, const char **return_parse_end, int options)
+{
+    size_t nodes_used = 0;
+    size_t buffer_used = 0;
+    cJSON *item = NULL;
+
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    nodes_used = arena->nodes_used;
+    buffer_used = arena->buffer_used;
+
+    current_arena = arena;
+    item = parse_with_hooks(value, buffer_length, return_parse_end, (options & cJSON_ArenaRequireNullTerminated) != 0, &arena_hooks, (options & cJSON_ArenaInSitu) != 0);
+    current_arena = NULL;
+
+    if (item == NULL)
+    {
+        /* give back the partial tree */
+        arena->nodes_used = nodes_used;
+        arena->buffer_used = buffer_used;
+        arena->last = buffer_used;
+    }
+
+    return item;
+}
+
 /* Default options for cJSON_Parse */
 CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
 {
@@ -1580,7 +1716,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        delete_parsed(head, &input_buffer->hooks);
     }
 
     return false;
@@ -1760,7 +1896,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        delete_parsed(head, &input_buffer->hooks);
     }
 
     return false;
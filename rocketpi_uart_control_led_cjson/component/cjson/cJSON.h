@@ -158,6 +158,36 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/* Arena mode: parse without touching the heap.
+ * Nodes are taken from a fixed pool of cJSON structs and strings from a bump buffer, both supplied by the caller.
+ * A tree parsed this way must NOT be passed to cJSON_Delete or modified with the cJSON_Add/Replace functions;
+ * it stays valid until cJSON_ArenaReset, which releases everything at once.
+ * Arena parsing uses a global "current arena" just like cJSON_InitHooks, so it is not reentrant. */
+typedef struct cJSON_Arena
+{
+    cJSON *nodes;
+    size_t node_count;
+    size_t nodes_used;
+    unsigned char *buffer;
+    size_t buffer_size;
+    size_t buffer_used;
+    /* start of the most recent buffer allocation, freeing it rolls the buffer back */
+    size_t last;
+    /* allocations served since the last reset (nodes and buffer) */
+    size_t allocations;
+} cJSON_Arena;
+
+/* cJSON_ParseArena options */
+/* Unescape strings in place and point valuestring/string into the input, which must then be writable. */
+#define cJSON_ArenaInSitu (1 << 0)
+/* Same as require_null_terminated of cJSON_ParseWithLengthOpts. */
+#define cJSON_ArenaRequireNullTerminated (1 << 1)
+
+CJSON_PUBLIC(void) cJSON_ArenaInit(cJSON_Arena *arena, cJSON *nodes, size_t node_count, void *buffer, size_t buffer_size);
+CJSON_PUBLIC(void) cJSON_ArenaReset(cJSON_Arena *arena);
+/* On failure everything allocated by this call is given back, trees parsed earlier stay valid. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseArena(cJSON_Arena *arena, char *value, size_t buffer_length, const char **return_parse_end, int options);
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
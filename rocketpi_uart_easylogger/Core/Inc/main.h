@@ -57,6 +57,14 @@ void Error_Handler(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
+#define W25QXX_MISO_Pin GPIO_PIN_2
+#define W25QXX_MISO_GPIO_Port GPIOC
+#define W25QXX_CS_Pin GPIO_PIN_12
+#define W25QXX_CS_GPIO_Port GPIOB
+#define W25QXX_SCK_Pin GPIO_PIN_13
+#define W25QXX_SCK_GPIO_Port GPIOB
+#define W25QXX_MOSI_Pin GPIO_PIN_15
+#define W25QXX_MOSI_GPIO_Port GPIOB
 
 /* USER CODE BEGIN Private defines */
 
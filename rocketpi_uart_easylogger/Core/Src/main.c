@@ -19,12 +19,18 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "dma.h"
+#include "spi.h"
 #include "usart.h"
 #include "gpio.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "elog.h"
+#include "elog_port.h"
+#include "elog_trace.h"
+#ifdef ELOG_FLASH_ENABLE
+#include "elog_flash.h"
+#endif
 
 /* USER CODE END Includes */
 
@@ -54,6 +60,7 @@ static uint32_t s_log_counter = 0;
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
 static void elog_demo_all_levels(void);
+static void elog_demo_trace_cost(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -92,6 +99,7 @@ int main(void)
   MX_GPIO_Init();
   MX_DMA_Init();
   MX_USART2_UART_Init();
+  MX_SPI2_Init();
   /* USER CODE BEGIN 2 */
   if (elog_init() == ELOG_NO_ERR) {
     elog_set_fmt(ELOG_LVL_ASSERT, ELOG_FMT_ALL & ~ELOG_FMT_P_INFO);
@@ -100,9 +108,22 @@ int main(void)
     elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
     elog_set_fmt(ELOG_LVL_DEBUG, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
     elog_set_fmt(ELOG_LVL_VERBOSE, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
+#ifdef ELOG_FLASH_ENABLE
+    /* before elog_start(), every output line is copied to the flash plugin */
+    ElogFlashErrCode flash_result = elog_flash_init();
+#endif
     elog_start();
+#ifdef ELOG_FLASH_ENABLE
+    if (flash_result != ELOG_FLASH_NO_ERR) {
+      elog_e("main", "Mount the log store in flash failed (%d).", (int)flash_result);
+    } else {
+      /* replay the tail of the previous run before new logs are appended */
+      elog_flash_output_recent(elog_flash_log_get_used_size() < 1024U ? elog_flash_log_get_used_size() : 1024U);
+    }
+#endif
     elog_i("main", "EasyLogger initialized. DMA UART logging ready.");
     elog_demo_all_levels();
+    elog_demo_trace_cost();
   } else {
     Error_Handler();
   }
@@ -117,6 +138,18 @@ int main(void)
     /* USER CODE BEGIN 3 */
     HAL_Delay(1000);
     elog_i("main", "Heartbeat %lu", (unsigned long)s_log_counter++);
+    if ((s_log_counter % 10U) == 0U) {
+      elog_port_stats_t stats;
+
+      elog_port_get_stats(&stats);
+      elog_d("main", "log lines %lu, dropped %lu, ring peak %lu bytes",
+             (unsigned long)stats.lines, (unsigned long)stats.dropped_lines,
+             (unsigned long)stats.high_water);
+    }
+#ifdef ELOG_FLASH_ENABLE
+    /* program the buffered logs with interrupts enabled */
+    elog_flash_flush();
+#endif
   }
   /* USER CODE END 3 */
 }
@@ -177,6 +210,26 @@ static void elog_demo_all_levels(void) {
   elog_v("main", "Verbose level demo log.");
 }
 
+/* compare the cost of a text log line with the same line as a binary trace record */
+static void elog_demo_trace_cost(void) {
+  uint32_t text_cycles, trace_cycles, start;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  start = DWT->CYCCNT;
+  elog_i("main", "adc ch%d = %d mV, state 0x%08x", 3, 1650, 0x5AU);
+  text_cycles = DWT->CYCCNT - start;
+
+  start = DWT->CYCCNT;
+  elog_trace_i("main", "adc ch%d = %d mV, state 0x%08x", 3, 1650, 0x5AU);
+  trace_cycles = DWT->CYCCNT - start;
+
+  elog_i("main", "text log %lu cycles, binary trace %lu cycles",
+         (unsigned long)text_cycles, (unsigned long)trace_cycles);
+}
+
 /* USER CODE END 4 */
 
 /**
@@ -35,8 +35,8 @@
 #define ELOG_OUTPUT_LVL                          ELOG_LVL_VERBOSE
 /* enable assert check */
 #define ELOG_ASSERT_ENABLE
-/* buffer size for every line's log */
-#define ELOG_LINE_BUF_SIZE                       1024
+/* buffer size for every line's log, it lives on the stack of the logging thread or ISR */
+#define ELOG_LINE_BUF_SIZE                       256
 /* output line number max length */
 #define ELOG_LINE_NUM_MAX_LEN                    5
 /* output filter's tag max length */
@@ -45,6 +45,8 @@
 #define ELOG_FILTER_KW_MAX_LEN                   16
 /* output filter's tag level max num */
 #define ELOG_FILTER_TAG_LVL_MAX_NUM              5
+/* tag ID table size (power of two), each tag's filter result is cached in it */
+#define ELOG_FILTER_TAG_ID_MAX_NUM               16
 /* output newline sign */
 #define ELOG_NEWLINE_SIGN                        "\r\n"
 /*---------------------------------------------------------------------------*/
@@ -79,5 +81,19 @@
 /* #define ELOG_BUF_OUTPUT_ENABLE */
 /* buffer size for buffered output mode */
 /* #define ELOG_BUF_OUTPUT_BUF_SIZE             (ELOG_LINE_BUF_SIZE * 10) */
+/*---------------------------------------------------------------------------*/
+/* enable bare-metal asynchronous output: lines are copied into a lock-free ring
+ * and sent by UART DMA in the background (see port/elog_port.c) */
+#define ELOG_PORT_ASYNC_ENABLE
+/* ring size for bare-metal asynchronous output, must be a power of two */
+#define ELOG_PORT_ASYNC_BUF_SIZE                 4096
+/* when the ring is full: ELOG_PORT_ASYNC_DROP discards the line,
+ * ELOG_PORT_ASYNC_BLOCK waits for space (thread mode only, ISRs still drop) */
+#define ELOG_PORT_ASYNC_FULL_POLICY              ELOG_PORT_ASYNC_DROP
+/*---------------------------------------------------------------------------*/
+/* copy every log to the flash log plugin (plugins/flash), a circular segment
+ * store on the W25Q64 behind SPI2 (bsp/w25qxx). When commented out, also
+ * remove plugins/flash and bsp/w25qxx from the project */
+#define ELOG_FLASH_ENABLE
 
 #endif /* _ELOG_CFG_H_ */
@@ -29,16 +29,23 @@
 #define LOG_TAG    "elog.flash"
 
 #include "elog_flash.h"
-#include <easyflash.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #ifdef ELOG_FLASH_USING_BUF_MODE
-/* flash log buffer */
-static char log_buf[ELOG_FLASH_BUF_SIZE] = { 0 };
-/* current flash log buffer write position  */
-static size_t cur_buf_size = 0;
+/* flash log buffers, one is filled by elog_flash_write() while the other one waits for elog_flash_flush() */
+static uint32_t log_buf[2][ELOG_FLASH_BUF_SIZE / 4] = { 0 };
+/* flash log buffers write position */
+static size_t log_buf_size[2] = { 0 };
+/* the buffer filled by elog_flash_write() */
+static uint8_t log_buf_cur = 0;
+/* the other buffer is full and waits to be written to flash */
+static bool log_buf_pending = false;
+/* elog_flash_flush() is writing to flash */
+static bool log_buf_flushing = false;
+/* log size dropped because both buffers were full */
+static size_t log_buf_dropped = 0;
 #endif
 
 /* initialize OK flag */
@@ -53,25 +60,33 @@ static void log_buf_lock(void);
 static void log_buf_unlock(void);
 
 /**
- * EasyLogger flash log plugin initialize.
+ * EasyLogger flash log plugin initialize. It runs before elog_start(), so it
+ * does not log anything itself: the caller reports a failed mount once the
+ * logger is running.
  *
- * @return result
+ * @return result of mounting the log store
  */
-ElogErrCode elog_flash_init(void) {
-    ElogErrCode result = ELOG_NO_ERR;
+ElogFlashErrCode elog_flash_init(void) {
+    ElogFlashErrCode result;
 
     /* buffer size must be word alignment */
     ELOG_ASSERT(ELOG_FLASH_BUF_SIZE % 4 == 0);
 
 #ifdef ELOG_FLASH_USING_BUF_MODE
-    /* initialize current flash log buffer write position */
-    cur_buf_size = 0;
+    /* initialize flash log buffers */
+    log_buf_size[0] = log_buf_size[1] = 0;
+    log_buf_cur = 0;
+    log_buf_pending = false;
+    log_buf_flushing = false;
+    log_buf_dropped = 0;
 #endif
 
     /* port initialize */
     elog_flash_port_init();
-    /* initialize OK */
+    /* initialize OK, on a mount error the buffers still work and flushes fail */
     init_ok = true;
+    /* mount the log store */
+    result = elog_flash_log_init();
 
     return result;
 }
@@ -87,7 +102,7 @@ ElogErrCode elog_flash_init(void) {
 void elog_flash_output(size_t index, size_t size) {
     /* 128 bytes buffer */
     uint32_t buf[32] = { 0 };
-    size_t log_total_size = ef_log_get_used_size();
+    size_t log_total_size = elog_flash_log_get_used_size();
     size_t buf_size = sizeof(buf);
     size_t read_size = 0, read_overage_size = 0;
 
@@ -99,12 +114,12 @@ void elog_flash_output(size_t index, size_t size) {
     }
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
-    /* lock flash log buffer */
-    log_buf_lock();
+    /* the log store is only used in thread mode, so no lock is held here and the
+     * output port may wait for the UART */
     /* output all flash saved log. It will use filter */
     while (true) {
         if (read_size + buf_size < size) {
-            ef_log_read(index + read_size, buf, buf_size);
+            elog_flash_log_read(index + read_size, buf, buf_size);
             elog_flash_port_output((const char*)buf, buf_size);
             read_size += buf_size;
         } else {
@@ -114,22 +129,20 @@ void elog_flash_output(size_t index, size_t size) {
             } else {
                 read_overage_size = 4 - ((size - read_size) % 4);
             }
-            ef_log_read(index + read_size, buf, size - read_size + read_overage_size);
+            elog_flash_log_read(index + read_size, buf, size - read_size + read_overage_size);
             elog_flash_port_output((const char*) buf + read_overage_size, size - read_size);
             /* output newline sign */
             elog_flash_port_output(ELOG_NEWLINE_SIGN, strlen(ELOG_NEWLINE_SIGN));
             break;
         }
     }
-    /* unlock flash log buffer */
-    log_buf_unlock();
 }
 
 /**
  * Read and output all log which saved in flash.
  */
 void elog_flash_output_all(void) {
-    elog_flash_output(0, ef_log_get_used_size());
+    elog_flash_output(0, elog_flash_log_get_used_size());
 }
 
 /**
@@ -138,7 +151,7 @@ void elog_flash_output_all(void) {
  * @param size recent log size
  */
 void elog_flash_output_recent(size_t size) {
-    size_t max_size = ef_log_get_used_size();
+    size_t max_size = elog_flash_log_get_used_size();
 
     if (size == 0) {
         return;
@@ -152,7 +165,8 @@ void elog_flash_output_recent(size_t size) {
 }
 
 /**
- * Write log to flash. The flash write use buffer mode.
+ * Write log to flash. In buffer mode the log is only copied to RAM, so it is
+ * callable from any context; elog_flash_flush() writes it to flash.
  *
  * @param log log
  * @param size log size
@@ -163,7 +177,7 @@ void elog_flash_write(const char *log, size_t size) {
     size_t write_size = 0, write_index = 0;
 #else
     size_t write_size_temp = 0;
-    EfErrCode result = EF_NO_ERR;
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
     /* write some '\r' for word alignment */
     char write_overage_c[4] = { '\r', '\r', '\r', '\r' };
 #endif
@@ -175,34 +189,40 @@ void elog_flash_write(const char *log, size_t size) {
     log_buf_lock();
 
 #ifdef ELOG_FLASH_USING_BUF_MODE
-    while (true) {
-        if (cur_buf_size + size > ELOG_FLASH_BUF_SIZE) {
-            write_size = ELOG_FLASH_BUF_SIZE - cur_buf_size;
-            elog_memcpy(log_buf + cur_buf_size, log + write_index, write_size);
-            write_index += write_size;
-            size -= write_size;
-            cur_buf_size += write_size;
-            /* unlock flash log buffer */
-            log_buf_unlock();
-            /* write all buffered log to flash, cur_buf_size will reset */
-            elog_flash_flush();
-            /* lock flash log buffer */
-            log_buf_lock();
-        } else {
-            elog_memcpy(log_buf + cur_buf_size, log + write_index, size);
-            cur_buf_size += size;
-            break;
+    /* drop the whole log when it does not fit until the next elog_flash_flush() */
+    write_size = ELOG_FLASH_BUF_SIZE - log_buf_size[log_buf_cur];
+    if (!log_buf_pending) {
+        write_size += ELOG_FLASH_BUF_SIZE;
+    }
+    if (size > write_size) {
+        log_buf_dropped += size;
+        size = 0;
+    }
+    while (size > 0) {
+        write_size = ELOG_FLASH_BUF_SIZE - log_buf_size[log_buf_cur];
+        if (write_size == 0) {
+            /* hand the full buffer over to elog_flash_flush() and switch to the empty one */
+            log_buf_pending = true;
+            log_buf_cur ^= 1;
+            continue;
         }
+        if (write_size > size) {
+            write_size = size;
+        }
+        elog_memcpy((char *) log_buf[log_buf_cur] + log_buf_size[log_buf_cur], log + write_index, write_size);
+        log_buf_size[log_buf_cur] += write_size;
+        write_index += write_size;
+        size -= write_size;
     }
 #else
     /* calculate the word alignment write size */
     write_size_temp = size / 4 * 4;
     /* write log to flash */
-    result = ef_log_write((uint32_t *) log, write_size_temp);
+    result = elog_flash_log_write((const uint32_t *) log, write_size_temp);
     /* write last word alignment data */
-    if ((result == EF_NO_ERR) && (write_size_temp != size)) {
+    if ((result == ELOG_FLASH_NO_ERR) && (write_size_temp != size)) {
         elog_memcpy(write_overage_c, log + write_size_temp, size - write_size_temp);
-        ef_log_write((uint32_t *) write_overage_c, 4);
+        elog_flash_log_write((const uint32_t *) write_overage_c, 4);
     }
 #endif
 
@@ -212,52 +232,83 @@ void elog_flash_write(const char *log, size_t size) {
 
 #ifdef ELOG_FLASH_USING_BUF_MODE
 /**
- * write all buffered log to flash
+ * Write all buffered log to flash. Call it from thread mode only, e.g. from the
+ * main loop, the buffers stay unlocked while the flash is written.
  */
 void elog_flash_flush(void) {
-    size_t write_overage_size = 0;
+    size_t write_overage_size = 0, write_size = 0;
+    uint8_t round, index;
 
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
     /* lock flash log buffer */
     log_buf_lock();
-    /* flash write is word alignment */
-    if (cur_buf_size % 4 != 0) {
-        write_overage_size = 4 - (cur_buf_size % 4);
+    if (log_buf_flushing) {
+        log_buf_unlock();
+        return;
     }
-    /* fill '\r' for word alignment */
-    memset(log_buf + cur_buf_size, '\r', write_overage_size);
-    /* write all buffered log to flash */
-    ef_log_write((uint32_t *) log_buf, cur_buf_size + write_overage_size);
-    /* reset position */
-    cur_buf_size = 0;
+    log_buf_flushing = true;
+    /* the full buffer first, then the one being filled */
+    for (round = 0; round < 2; round++) {
+        if (!log_buf_pending) {
+            if (log_buf_size[log_buf_cur] == 0) {
+                break;
+            }
+            /* flash write is word alignment, fill '\r' for it */
+            write_overage_size = (4 - log_buf_size[log_buf_cur] % 4) % 4;
+            memset((char *) log_buf[log_buf_cur] + log_buf_size[log_buf_cur], '\r', write_overage_size);
+            log_buf_size[log_buf_cur] += write_overage_size;
+            log_buf_pending = true;
+            log_buf_cur ^= 1;
+        }
+        index = log_buf_cur ^ 1;
+        write_size = log_buf_size[index];
+        /* unlock flash log buffer, new log goes to the other buffer meanwhile */
+        log_buf_unlock();
+        elog_flash_log_write(log_buf[index], write_size);
+        /* lock flash log buffer */
+        log_buf_lock();
+        log_buf_size[index] = 0;
+        log_buf_pending = false;
+    }
+    log_buf_flushing = false;
     /* unlock flash log buffer */
     log_buf_unlock();
 }
+
+/**
+ * get the log size dropped because elog_flash_flush() was not called in time
+ *
+ * @return dropped size
+ */
+size_t elog_flash_get_dropped(void) {
+    return log_buf_dropped;
+}
 #endif
 
 /**
  * clean all log which in flash and ram buffer
  */
 void elog_flash_clean(void) {
-    EfErrCode clean_result = EF_NO_ERR;
+    ElogFlashErrCode clean_result = ELOG_FLASH_NO_ERR;
 
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
-    /* lock flash log buffer */
-    log_buf_lock();
-    /* clean all log which in flash */
-    clean_result = ef_log_clean();
 
 #ifdef ELOG_FLASH_USING_BUF_MODE
+    /* lock flash log buffer */
+    log_buf_lock();
     /* reset position */
-    cur_buf_size = 0;
-#endif
-
+    log_buf_size[0] = log_buf_size[1] = 0;
+    log_buf_pending = false;
     /* unlock flash log buffer */
     log_buf_unlock();
+#endif
+
+    /* clean all log which in flash, thread mode only */
+    clean_result = elog_flash_log_clean();
 
-    if(clean_result == EF_NO_ERR) {
+    if(clean_result == ELOG_FLASH_NO_ERR) {
         log_i("All logs which in flash is clean OK.");
     } else {
         log_e("Clean logs which in flash has an error!");
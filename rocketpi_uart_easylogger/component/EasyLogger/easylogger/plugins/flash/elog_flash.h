@@ -31,6 +31,7 @@
 
 #include <elog.h>
 #include <elog_flash_cfg.h>
+#include <elog_flash_log.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,7 +45,7 @@ extern "C" {
 #define ELOG_FLASH_SW_VERSION                "V2.0.1"
 
 /* elog_flash.c */
-ElogErrCode elog_flash_init(void);
+ElogFlashErrCode elog_flash_init(void);
 void elog_flash_output(size_t pos, size_t size);
 void elog_flash_output_all(void);
 void elog_flash_output_recent(size_t size);
@@ -55,6 +56,7 @@ void elog_flash_lock_enabled(bool enabled);
 
 #ifdef ELOG_FLASH_USING_BUF_MODE
 void elog_flash_flush(void);
+size_t elog_flash_get_dropped(void);
 #endif
 
 /* elog_flash_port.c */
@@ -31,7 +31,17 @@
 
 /* EasyLogger flash log plugin's using buffer mode */
 #define ELOG_FLASH_USING_BUF_MODE
-/* EasyLogger flash log plugin's RAM buffer size */
-#define ELOG_FLASH_BUF_SIZE                  /* @note you must define it for a value */
+/* EasyLogger flash log plugin's RAM buffer size, there are two of them: one is
+ * filled by elog_flash_write() while the other is programmed by elog_flash_flush() */
+#define ELOG_FLASH_BUF_SIZE                  1024
+/*---------------------------------------------------------------------------*/
+/* log store start address in the NOR flash, must be segment aligned */
+#define ELOG_FLASH_LOG_ADDR                  0x000000
+/* segment size, the erase unit of the flash (W25Q64 4K sector) */
+#define ELOG_FLASH_LOG_SEG_SIZE              4096
+/* segment count, at least 3. 256 * 4K = 1M of the W25Q64 */
+#define ELOG_FLASH_LOG_SEG_NUM               256
+/* program page size, a program never crosses a page boundary */
+#define ELOG_FLASH_LOG_PAGE_SIZE             256
 
 #endif /* _ELOG_FLASH_CFG_H_ */
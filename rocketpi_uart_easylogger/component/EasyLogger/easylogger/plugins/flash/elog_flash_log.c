@@ -0,0 +1,315 @@
+/*
+ * Function: Circular segment log store on NOR flash for the flash log plugin.
+ * Created on: 2026-10-18
+ *
+ * The store is a ring of ELOG_FLASH_LOG_SEG_NUM segments, one erase unit each.
+ * Every segment starts with a 16 bytes header (magic, sequence, CRC32) and is
+ * followed by log data appended word by word. A new segment gets the previous
+ * sequence plus one, and when the ring is full the oldest segment is erased and
+ * reused. Programs are split at page boundaries, so each write costs one page
+ * program per touched page.
+ *
+ * Mount never scans the whole store:
+ * - the segments from the first valid one up to the newest one carry consecutive
+ *   sequences, so the newest segment is found by binary search on headers;
+ * - data in the newest segment is a prefix of non erased words, so its fill
+ *   level is found by binary search too.
+ * A power loss while a segment is being erased or opened leaves at most one
+ * invalid header right after the newest segment, which mount skips.
+ *
+ * @note A log word must never be 0xFFFFFFFF. Text logs can not contain it
+ *       (0xFF is not valid in UTF-8) and the plugin pads with '\r'.
+ */
+
+#include "elog_flash_log.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define LOG_SEG_MAGIC                        0x53474C45UL    /* "ELGS" */
+#define LOG_SEG_HDR_SIZE                     16
+#define LOG_SEG_DATA_SIZE                    (ELOG_FLASH_LOG_SEG_SIZE - LOG_SEG_HDR_SIZE)
+#define LOG_ERASED_WORD                      0xFFFFFFFFUL
+
+/* segment header, reserved stays erased */
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;
+    uint32_t reserved;
+    uint32_t crc;
+} log_seg_hdr;
+
+/* the oldest and the newest segment index */
+static uint32_t seg_oldest = 0, seg_head = 0;
+/* sequence of the newest segment */
+static uint32_t head_seq = 0;
+/* log bytes in the newest segment */
+static size_t head_used = 0;
+
+static uint32_t calc_crc32(const void *buf, size_t size) {
+    const uint8_t *p = (const uint8_t *) buf;
+    uint32_t crc = 0xFFFFFFFFUL;
+    uint8_t i;
+
+    while (size--) {
+        crc ^= *p++;
+        for (i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1U)));
+        }
+    }
+
+    return crc ^ 0xFFFFFFFFUL;
+}
+
+static uint32_t seg_addr(uint32_t seg) {
+    return ELOG_FLASH_LOG_ADDR + seg * ELOG_FLASH_LOG_SEG_SIZE;
+}
+
+static uint32_t seg_next(uint32_t seg) {
+    return (seg + 1 == ELOG_FLASH_LOG_SEG_NUM) ? 0 : seg + 1;
+}
+
+/**
+ * read a segment header
+ *
+ * @param seg segment index
+ * @param seq sequence of the segment when it is valid
+ *
+ * @return true when the header is valid
+ */
+static bool seg_read_hdr(uint32_t seg, uint32_t *seq) {
+    log_seg_hdr hdr;
+
+    if (elog_flash_port_read(seg_addr(seg), (uint8_t *) &hdr, sizeof(hdr)) != ELOG_FLASH_NO_ERR) {
+        return false;
+    }
+    if (hdr.magic != LOG_SEG_MAGIC || hdr.crc != calc_crc32(&hdr, offsetof(log_seg_hdr, crc))) {
+        return false;
+    }
+    *seq = hdr.seq;
+
+    return true;
+}
+
+/**
+ * erase a segment and write its header
+ *
+ * @param seg segment index
+ * @param seq sequence of the segment
+ *
+ * @return result
+ */
+static ElogFlashErrCode seg_open(uint32_t seg, uint32_t seq) {
+    log_seg_hdr hdr;
+
+    if (elog_flash_port_erase(seg_addr(seg)) != ELOG_FLASH_NO_ERR) {
+        return ELOG_FLASH_ERASE_ERR;
+    }
+    hdr.magic = LOG_SEG_MAGIC;
+    hdr.seq = seq;
+    hdr.reserved = LOG_ERASED_WORD;
+    hdr.crc = calc_crc32(&hdr, offsetof(log_seg_hdr, crc));
+    if (elog_flash_port_program(seg_addr(seg), (const uint8_t *) &hdr, sizeof(hdr)) != ELOG_FLASH_NO_ERR) {
+        return ELOG_FLASH_WRITE_ERR;
+    }
+
+    return ELOG_FLASH_NO_ERR;
+}
+
+/**
+ * find the log size of a segment by binary search for its first erased word
+ *
+ * @param seg segment index
+ * @param used log bytes in the segment
+ *
+ * @return result
+ */
+static ElogFlashErrCode seg_find_used(uint32_t seg, size_t *used) {
+    uint32_t word, base = seg_addr(seg) + LOG_SEG_HDR_SIZE;
+    size_t lo = 0, hi = LOG_SEG_DATA_SIZE / 4, mid;
+
+    /* words [0, lo) are written, words [hi, end) are erased */
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (elog_flash_port_read(base + mid * 4, (uint8_t *) &word, 4) != ELOG_FLASH_NO_ERR) {
+            return ELOG_FLASH_READ_ERR;
+        }
+        if (word == LOG_ERASED_WORD) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    *used = lo * 4;
+
+    return ELOG_FLASH_NO_ERR;
+}
+
+/**
+ * Mount the log store. The store is created when no valid segment is found.
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_log_init(void) {
+    uint32_t first, first_seq, seq, lo, hi, mid, cand;
+    uint8_t i;
+
+    if (seg_read_hdr(0, &first_seq)) {
+        first = 0;
+    } else if (seg_read_hdr(1, &first_seq)) {
+        /* segment 0 was being erased after the ring wrapped */
+        first = 1;
+    } else {
+        return elog_flash_log_clean();
+    }
+
+    /* the newest segment is the last one continuing the sequence of the first */
+    lo = first;
+    hi = ELOG_FLASH_LOG_SEG_NUM - 1;
+    while (lo < hi) {
+        mid = lo + (hi - lo + 1) / 2;
+        if (seg_read_hdr(mid, &seq) && seq == first_seq + (mid - first)) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    seg_head = lo;
+    head_seq = first_seq + (lo - first);
+
+    /* after a wrap the oldest segment follows the newest, or one more when an erase was cut */
+    seg_oldest = first;
+    cand = seg_head;
+    for (i = 1; i <= 2; i++) {
+        cand = seg_next(cand);
+        if (seg_read_hdr(cand, &seq) && seq == head_seq - (ELOG_FLASH_LOG_SEG_NUM - i)) {
+            seg_oldest = cand;
+            break;
+        }
+    }
+
+    return seg_find_used(seg_head, &head_used);
+}
+
+/**
+ * Append log to the store, the oldest segment is reused when the store is full.
+ *
+ * @param log log, word aligned
+ * @param size log size, multiple of 4
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_log_write(const uint32_t *log, size_t size) {
+    const uint8_t *p = (const uint8_t *) log;
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    uint32_t addr, next;
+    size_t chunk;
+
+    if (size % 4 != 0) {
+        return ELOG_FLASH_WRITE_ERR;
+    }
+
+    while (size > 0) {
+        if (head_used == LOG_SEG_DATA_SIZE) {
+            next = seg_next(seg_head);
+            if (next == seg_oldest) {
+                seg_oldest = seg_next(seg_oldest);
+            }
+            result = seg_open(next, head_seq + 1);
+            if (result != ELOG_FLASH_NO_ERR) {
+                return result;
+            }
+            seg_head = next;
+            head_seq++;
+            head_used = 0;
+        }
+        addr = seg_addr(seg_head) + LOG_SEG_HDR_SIZE + head_used;
+        /* stop at the page boundary and at the end of the segment */
+        chunk = ELOG_FLASH_LOG_PAGE_SIZE - addr % ELOG_FLASH_LOG_PAGE_SIZE;
+        if (chunk > LOG_SEG_DATA_SIZE - head_used) {
+            chunk = LOG_SEG_DATA_SIZE - head_used;
+        }
+        if (chunk > size) {
+            chunk = size;
+        }
+        result = elog_flash_port_program(addr, p, chunk);
+        if (result != ELOG_FLASH_NO_ERR) {
+            return result;
+        }
+        head_used += chunk;
+        p += chunk;
+        size -= chunk;
+    }
+
+    return result;
+}
+
+/**
+ * Read log from the store.
+ *
+ * @param index offset from the oldest log, word aligned
+ * @param log read buffer
+ * @param size read size, multiple of 4
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_log_read(size_t index, uint32_t *log, size_t size) {
+    uint8_t *p = (uint8_t *) log;
+    uint32_t seg;
+    size_t offset, chunk;
+
+    if (index % 4 != 0 || size % 4 != 0 || index + size > elog_flash_log_get_used_size()) {
+        return ELOG_FLASH_OUT_OF_BOUND;
+    }
+
+    seg = (seg_oldest + index / LOG_SEG_DATA_SIZE) % ELOG_FLASH_LOG_SEG_NUM;
+    offset = index % LOG_SEG_DATA_SIZE;
+    while (size > 0) {
+        chunk = LOG_SEG_DATA_SIZE - offset;
+        if (chunk > size) {
+            chunk = size;
+        }
+        if (elog_flash_port_read(seg_addr(seg) + LOG_SEG_HDR_SIZE + offset, p, chunk) != ELOG_FLASH_NO_ERR) {
+            return ELOG_FLASH_READ_ERR;
+        }
+        p += chunk;
+        size -= chunk;
+        seg = seg_next(seg);
+        offset = 0;
+    }
+
+    return ELOG_FLASH_NO_ERR;
+}
+
+/**
+ * Get the log size in the store.
+ *
+ * @return size
+ */
+size_t elog_flash_log_get_used_size(void) {
+    uint32_t full = (seg_head + ELOG_FLASH_LOG_SEG_NUM - seg_oldest) % ELOG_FLASH_LOG_SEG_NUM;
+
+    return (size_t) full * LOG_SEG_DATA_SIZE + head_used;
+}
+
+/**
+ * Erase all segments holding log and start over at segment 0.
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_log_clean(void) {
+    ElogFlashErrCode result;
+    uint32_t seg, seq;
+
+    /* other valid headers would be picked up by the next mount */
+    for (seg = 1; seg < ELOG_FLASH_LOG_SEG_NUM; seg++) {
+        if (seg_read_hdr(seg, &seq) && elog_flash_port_erase(seg_addr(seg)) != ELOG_FLASH_NO_ERR) {
+            return ELOG_FLASH_ERASE_ERR;
+        }
+    }
+    result = seg_open(0, 1);
+    seg_oldest = seg_head = 0;
+    head_seq = 1;
+    head_used = 0;
+
+    return result;
+}
@@ -0,0 +1,55 @@
+/*
+ * Function: Circular segment log store on NOR flash for the flash log plugin.
+ *           It stands in for the EasyFlash log API (ef_log_xxx) the plugin was written for.
+ * Created on: 2026-10-18
+ */
+
+#ifndef __ELOG_FLASH_LOG_H__
+#define __ELOG_FLASH_LOG_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <elog_flash_cfg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !defined(ELOG_FLASH_LOG_SEG_SIZE) || !defined(ELOG_FLASH_LOG_SEG_NUM) || !defined(ELOG_FLASH_LOG_PAGE_SIZE)
+    #error "Please configure the log store geometry (in elog_flash_cfg.h)"
+#endif
+
+#if ELOG_FLASH_LOG_SEG_NUM < 3
+    #error "ELOG_FLASH_LOG_SEG_NUM must be at least 3"
+#endif
+
+#if (ELOG_FLASH_LOG_SEG_SIZE % ELOG_FLASH_LOG_PAGE_SIZE) != 0
+    #error "ELOG_FLASH_LOG_SEG_SIZE must be a multiple of ELOG_FLASH_LOG_PAGE_SIZE"
+#endif
+
+/* log store error code */
+typedef enum {
+    ELOG_FLASH_NO_ERR,
+    ELOG_FLASH_READ_ERR,
+    ELOG_FLASH_WRITE_ERR,
+    ELOG_FLASH_ERASE_ERR,
+    ELOG_FLASH_OUT_OF_BOUND,
+} ElogFlashErrCode;
+
+/* elog_flash_log.c */
+ElogFlashErrCode elog_flash_log_init(void);
+ElogFlashErrCode elog_flash_log_write(const uint32_t *log, size_t size);
+ElogFlashErrCode elog_flash_log_read(size_t index, uint32_t *log, size_t size);
+size_t elog_flash_log_get_used_size(void);
+ElogFlashErrCode elog_flash_log_clean(void);
+
+/* elog_flash_port.c */
+ElogFlashErrCode elog_flash_port_read(uint32_t addr, uint8_t *buf, size_t size);
+ElogFlashErrCode elog_flash_port_program(uint32_t addr, const uint8_t *buf, size_t size);
+ElogFlashErrCode elog_flash_port_erase(uint32_t addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ELOG_FLASH_LOG_H__ */
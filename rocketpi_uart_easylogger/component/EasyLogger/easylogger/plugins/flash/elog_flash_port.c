@@ -27,6 +27,14 @@
  */
 
 #include "elog_flash.h"
+#include "elog_port.h"
+#include "main.h"
+#include "driver_w25qxx.h"
+#include "driver_w25qxx_interface.h"
+
+/* W25Q64 on SPI2 through the libdriver w25qxx driver, see rocketpi_w25qxx */
+static w25qxx_handle_t w25qxx_handle;
+static uint32_t lock_primask = 0;
 
 /**
  * EasyLogger flash log pulgin port initialize
@@ -35,38 +43,97 @@
  */
 ElogErrCode elog_flash_port_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
-    
-    /* add your code here */
+
+    DRIVER_W25QXX_LINK_INIT(&w25qxx_handle, w25qxx_handle_t);
+    DRIVER_W25QXX_LINK_SPI_QSPI_INIT(&w25qxx_handle, w25qxx_interface_spi_qspi_init);
+    DRIVER_W25QXX_LINK_SPI_QSPI_DEINIT(&w25qxx_handle, w25qxx_interface_spi_qspi_deinit);
+    DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(&w25qxx_handle, w25qxx_interface_spi_qspi_write_read);
+    DRIVER_W25QXX_LINK_DELAY_MS(&w25qxx_handle, w25qxx_interface_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_US(&w25qxx_handle, w25qxx_interface_delay_us);
+    DRIVER_W25QXX_LINK_DEBUG_PRINT(&w25qxx_handle, w25qxx_interface_debug_print);
+
+    w25qxx_set_type(&w25qxx_handle, W25Q64);
+    w25qxx_set_interface(&w25qxx_handle, W25QXX_INTERFACE_SPI);
+    w25qxx_set_dual_quad_spi(&w25qxx_handle, W25QXX_BOOL_FALSE);
+    /* a failed init makes every flash access fail, the mount reports it */
+    w25qxx_init(&w25qxx_handle);
 
     return result;
 }
 
 /**
- * output flash saved log port interface
+ * read the NOR flash
+ *
+ * @param addr flash address
+ * @param buf read buffer
+ * @param size read size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_read(uint32_t addr, uint8_t *buf, size_t size) {
+    if (w25qxx_read(&w25qxx_handle, addr, buf, (uint32_t) size) != 0) {
+        return ELOG_FLASH_READ_ERR;
+    }
+    return ELOG_FLASH_NO_ERR;
+}
+
+/**
+ * program the NOR flash, the range never crosses a page boundary
+ *
+ * @param addr flash address
+ * @param buf data
+ * @param size data size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_program(uint32_t addr, const uint8_t *buf, size_t size) {
+    if (w25qxx_page_program(&w25qxx_handle, addr, (uint8_t *) buf, (uint16_t) size) != 0) {
+        return ELOG_FLASH_WRITE_ERR;
+    }
+    return ELOG_FLASH_NO_ERR;
+}
+
+/**
+ * erase one segment of the NOR flash
+ *
+ * @param addr segment address
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_erase(uint32_t addr) {
+    if (w25qxx_sector_erase_4k(&w25qxx_handle, addr) != 0) {
+        return ELOG_FLASH_ERASE_ERR;
+    }
+    return ELOG_FLASH_NO_ERR;
+}
+
+/**
+ * output flash saved log port interface, it waits for the UART so nothing is
+ * dropped by the asynchronous output ring
  *
  * @param log flash saved log
  * @param size log size
  */
 void elog_flash_port_output(const char *log, size_t size) {
-    
-    /* add your code here */
-    
+    elog_port_write(log, size);
+    elog_port_flush();
 }
 
 /**
- * flash log lock
+ * flash log lock, only guards the RAM buffers
  */
 void elog_flash_port_lock(void) {
-    
-    /* add your code here */
-    
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    lock_primask = primask;
 }
 
 /**
  * flash log unlock
  */
 void elog_flash_port_unlock(void) {
-    
-    /* add your code here */
-    
-}
\ No newline at end of file
+    if (!lock_primask) {
+        __enable_irq();
+    }
+}
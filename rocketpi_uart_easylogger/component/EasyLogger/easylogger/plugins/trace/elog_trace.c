@@ -0,0 +1,72 @@
+/*
+ * Function: Deferred binary logging for EasyLogger.
+ * Created on: 2026-10-18
+ */
+
+#include <stdarg.h>
+#include <elog_trace.h>
+
+/* UART only, binary records are kept out of the flash log */
+extern void elog_port_write(const char *log, size_t size);
+
+static volatile uint8_t trace_level = ELOG_TRACE_LVL;
+
+static uint8_t *put_le32(uint8_t *p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+    return p + 4;
+}
+
+/**
+ * emit one binary record, called through the elog_trace_x() macros
+ *
+ * @param desc call site descriptor
+ * @param nargs number of argument words following the format
+ * @param ... the format string (skipped) and the arguments
+ */
+void elog_trace_output(const elog_trace_desc_t *desc, uint8_t nargs, ...) {
+    uint8_t record[ELOG_TRACE_RECORD_OVERHEAD + ELOG_TRACE_MAX_ARGS * 4];
+    uint8_t *p = record, check = 0;
+    size_t i, len;
+    va_list args;
+
+    if (desc->level > trace_level || !elog_get_output_enabled()) {
+        return;
+    }
+    /* the macros reject this at compile time, a direct caller loses the record */
+    if (nargs > ELOG_TRACE_MAX_ARGS) {
+        return;
+    }
+
+    *p++ = ELOG_TRACE_SYNC;
+    *p++ = nargs;
+    p = put_le32(p, (uint32_t)(uintptr_t)desc);
+    p = put_le32(p, elog_trace_port_get_timestamp());
+    va_start(args, nargs);
+    (void)va_arg(args, const char *);
+    for (i = 0; i < nargs; i++) {
+        p = put_le32(p, va_arg(args, uint32_t));
+    }
+    va_end(args);
+
+    len = (size_t)(p - record);
+    for (i = 0; i < len; i++) {
+        check ^= record[i];
+    }
+    *p++ = check;
+
+    elog_port_write((const char *)record, len + 1);
+}
+
+/**
+ * set the runtime trace level, records above it are discarded
+ */
+void elog_trace_set_lvl(uint8_t level) {
+    trace_level = level;
+}
+
+uint8_t elog_trace_get_lvl(void) {
+    return trace_level;
+}
@@ -0,0 +1,128 @@
+/*
+ * Function: Deferred binary logging for EasyLogger.
+ *
+ * elog_trace_x() does not format anything on the MCU. Each call site owns a
+ * static const descriptor (level, tag, format, file, line) that stays in the
+ * firmware image; a record only carries the descriptor address, a timestamp
+ * and the raw argument words:
+ *
+ *   0xA5 | nargs | desc address (LE32) | timestamp (LE32) | args (LE32 * nargs) | xor
+ *
+ * Records go through elog_port_write(), so they share the UART (and, with
+ * ELOG_PORT_ASYNC_ENABLE, the lock-free ring) with text logs but are not
+ * copied to the flash log.
+ * scripts/elog_trace_decode.py splits the stream and expands records with the
+ * descriptors read from the ELF (.axf) of the same build.
+ *
+ * Arguments are passed as 32-bit words: integers, chars and pointers work as
+ * is, %s only for strings that live in the image, floats must be wrapped in
+ * ELOG_TRACE_FLOAT(). 64-bit values are not supported.
+ */
+
+#ifndef __ELOG_TRACE_H__
+#define __ELOG_TRACE_H__
+
+#include <elog.h>
+#include <elog_trace_cfg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ELOG_TRACE_SYNC                          0xA5U
+/* sync + nargs + descriptor + timestamp + checksum */
+#define ELOG_TRACE_RECORD_OVERHEAD               11U
+
+#if ELOG_TRACE_MAX_ARGS > 15
+    #error "ELOG_TRACE_MAX_ARGS must not exceed 15"
+#endif
+
+/* one per call site, read back from the ELF by the host decoder */
+typedef struct {
+    const char *format;
+    const char *tag;
+    const char *file;
+    uint16_t line;
+    uint8_t level;
+    uint8_t reserved;
+} elog_trace_desc_t;
+
+/* pass a float as its IEEE-754 bit pattern, decoded for %f/%e/%g */
+#define ELOG_TRACE_FLOAT(x)                      elog_trace_float_bits((float)(x))
+
+static inline uint32_t elog_trace_float_bits(float value) {
+    union { float f; uint32_t u; } bits;
+
+    bits.f = value;
+    return bits.u;
+}
+
+/* counts the format plus up to 31 arguments, no GNU extension needed */
+#define ELOG_TRACE_COUNT(...)                                                                    \
+        ELOG_TRACE_COUNT_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18,  \
+                          17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define ELOG_TRACE_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,  \
+                          _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30,  \
+                          _31, _32, N, ...) N
+#define ELOG_TRACE_FORMAT(...)                   ELOG_TRACE_FORMAT_(__VA_ARGS__, 0)
+#define ELOG_TRACE_FORMAT_(fmt, ...)             fmt
+
+/* fails to compile (negative bit-field width) when a call site passes too many arguments,
+ * C99 compatible for ARMCC 5 which has no _Static_assert */
+#define ELOG_TRACE_CHECK_NARGS(n)                                                             \
+        ((void)sizeof(struct { int elog_trace_too_many_args : ((n) <= ELOG_TRACE_MAX_ARGS) ? 1 : -1; }))
+
+/* the format is passed on as the first variadic argument and skipped */
+#define ELOG_TRACE_RECORD(lvl, tag_, ...)                                                       \
+        do {                                                                                  \
+            static const elog_trace_desc_t elog_trace_desc_ = {                               \
+                ELOG_TRACE_FORMAT(__VA_ARGS__), tag_, __FILE__, (uint16_t)__LINE__, lvl, 0    \
+            };                                                                                \
+            ELOG_TRACE_CHECK_NARGS(ELOG_TRACE_COUNT(__VA_ARGS__) - 1);                        \
+            elog_trace_output(&elog_trace_desc_, ELOG_TRACE_COUNT(__VA_ARGS__) - 1, __VA_ARGS__); \
+        } while (0)
+
+#if defined(ELOG_TRACE_ENABLE) && ELOG_TRACE_LVL >= ELOG_LVL_ASSERT
+    #define elog_trace_a(tag, ...) ELOG_TRACE_RECORD(ELOG_LVL_ASSERT, tag, __VA_ARGS__)
+#else
+    #define elog_trace_a(tag, ...)
+#endif
+#if defined(ELOG_TRACE_ENABLE) && ELOG_TRACE_LVL >= ELOG_LVL_ERROR
+    #define elog_trace_e(tag, ...) ELOG_TRACE_RECORD(ELOG_LVL_ERROR, tag, __VA_ARGS__)
+#else
+    #define elog_trace_e(tag, ...)
+#endif
+#if defined(ELOG_TRACE_ENABLE) && ELOG_TRACE_LVL >= ELOG_LVL_WARN
+    #define elog_trace_w(tag, ...) ELOG_TRACE_RECORD(ELOG_LVL_WARN, tag, __VA_ARGS__)
+#else
+    #define elog_trace_w(tag, ...)
+#endif
+#if defined(ELOG_TRACE_ENABLE) && ELOG_TRACE_LVL >= ELOG_LVL_INFO
+    #define elog_trace_i(tag, ...) ELOG_TRACE_RECORD(ELOG_LVL_INFO, tag, __VA_ARGS__)
+#else
+    #define elog_trace_i(tag, ...)
+#endif
+#if defined(ELOG_TRACE_ENABLE) && ELOG_TRACE_LVL >= ELOG_LVL_DEBUG
+    #define elog_trace_d(tag, ...) ELOG_TRACE_RECORD(ELOG_LVL_DEBUG, tag, __VA_ARGS__)
+#else
+    #define elog_trace_d(tag, ...)
+#endif
+#if defined(ELOG_TRACE_ENABLE) && ELOG_TRACE_LVL == ELOG_LVL_VERBOSE
+    #define elog_trace_v(tag, ...) ELOG_TRACE_RECORD(ELOG_LVL_VERBOSE, tag, __VA_ARGS__)
+#else
+    #define elog_trace_v(tag, ...)
+#endif
+
+/* elog_trace.c */
+void elog_trace_output(const elog_trace_desc_t *desc, uint8_t nargs, ...);
+void elog_trace_set_lvl(uint8_t level);
+uint8_t elog_trace_get_lvl(void);
+
+/* elog_trace_port.c, defaults to HAL_GetTick() */
+uint32_t elog_trace_port_get_timestamp(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ELOG_TRACE_H__ */
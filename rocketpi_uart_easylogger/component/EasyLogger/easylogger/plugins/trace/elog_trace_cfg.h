@@ -0,0 +1,16 @@
+/*
+ * Function: It is the configure head file for the binary trace plugin.
+ * Created on: 2026-10-18
+ */
+
+#ifndef _ELOG_TRACE_CFG_H_
+#define _ELOG_TRACE_CFG_H_
+
+/* enable binary trace records, elog_trace_x() compiles to nothing without it */
+#define ELOG_TRACE_ENABLE
+/* static trace level, range: from ELOG_LVL_ASSERT to ELOG_LVL_VERBOSE */
+#define ELOG_TRACE_LVL                           ELOG_LVL_VERBOSE
+/* most raw argument words one record can carry, at most 15 */
+#define ELOG_TRACE_MAX_ARGS                      8
+
+#endif /* _ELOG_TRACE_CFG_H_ */
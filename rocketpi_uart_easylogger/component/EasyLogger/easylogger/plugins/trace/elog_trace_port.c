@@ -0,0 +1,16 @@
+/*
+ * Function: Portable interface of the binary trace plugin.
+ * Created on: 2026-10-18
+ */
+
+#include <elog_trace.h>
+#include "main.h"
+
+/**
+ * get the record timestamp
+ *
+ * @return milliseconds since boot, replace with DWT->CYCCNT for finer stamps
+ */
+uint32_t elog_trace_port_get_timestamp(void) {
+    return HAL_GetTick();
+}
@@ -28,14 +28,109 @@
  
 #include <elog.h>
 #include <stdio.h>
+#include <string.h>
 #include "usart.h"
+#include "elog_port.h"
+#ifdef ELOG_FLASH_ENABLE
+#include "elog_flash.h"
+#endif
 
+#ifdef ELOG_PORT_ASYNC_ENABLE
+#include "elog_ring.h"
+
+#ifndef ELOG_PORT_ASYNC_BUF_SIZE
+#define ELOG_PORT_ASYNC_BUF_SIZE                 4096
+#endif
+#ifndef ELOG_PORT_ASYNC_FULL_POLICY
+#define ELOG_PORT_ASYNC_FULL_POLICY              ELOG_PORT_ASYNC_DROP
+#endif
+
+#if (ELOG_PORT_ASYNC_BUF_SIZE & (ELOG_PORT_ASYNC_BUF_SIZE - 1)) != 0
+#error "ELOG_PORT_ASYNC_BUF_SIZE must be a power of two"
+#endif
+
+static uint8_t async_buf[ELOG_PORT_ASYNC_BUF_SIZE];
+static elog_ring_t async_ring;
+/* 1 while a DMA transfer is running or being started */
+static volatile uint32_t dma_busy = 0;
+static volatile uint16_t dma_len = 0;
+static volatile elog_port_stats_t async_stats;
+#else
 static volatile bool uart_dma_idle = true;
-static volatile uint8_t elog_lock_flag = 0;
+#endif /* ELOG_PORT_ASYNC_ENABLE */
+
+/* the output lock masks interrupts, nesting depth and PRIMASK of the outermost owner */
+static uint32_t lock_depth = 0;
+static uint32_t lock_primask = 0;
+
+/**
+ * run the UART DMA completion chain by hand, only while interrupts are masked
+ */
+static void dma_poll(void) {
+    HAL_DMA_IRQHandler(huart2.hdmatx);
+    HAL_UART_IRQHandler(&huart2);
+}
 
+#ifdef ELOG_PORT_ASYNC_ENABLE
+/**
+ * start the next DMA transfer if none is running, callable from any context
+ */
+static void dma_kick(void) {
+    const uint8_t *data;
+    uint32_t len;
+
+    for (;;) {
+        if (!elog_ring_cas(&dma_busy, 0U, 1U)) {
+            /* the owner of dma_busy will see our data */
+            return;
+        }
+        len = elog_ring_peek(&async_ring, &data);
+        if (len > 0xFFFFU) {
+            len = 0xFFFFU;
+        }
+        if (len > 0U) {
+            dma_len = (uint16_t)len;
+            if (HAL_UART_Transmit_DMA(&huart2, (uint8_t *)data, (uint16_t)len) == HAL_OK) {
+                elog_ring_add(&async_stats.dma_transfers, 1U);
+                return;
+            }
+            /* UART busy with a transfer started elsewhere, retry on its completion */
+            dma_len = 0;
+            dma_busy = 0;
+            return;
+        }
+        dma_busy = 0;
+        /* a producer may have published after peek but before dma_busy was cleared */
+        if (elog_ring_peek(&async_ring, &data) == 0U) {
+            return;
+        }
+    }
+}
+
+static void dma_done(void) {
+    elog_ring_consume(&async_ring, dma_len);
+    dma_len = 0;
+    dma_busy = 0;
+    dma_kick();
+}
+
+static void update_high_water(void) {
+    uint32_t used = elog_ring_used(&async_ring), cur;
+
+    do {
+        cur = async_stats.high_water;
+        if (used <= cur) {
+            return;
+        }
+    } while (!elog_ring_cas(&async_stats.high_water, cur, used));
+}
+#else
 static void wait_uart_idle(void) {
     while (!uart_dma_idle) {
-        /* wait for ongoing DMA transfer to finish */
+        /* wait for ongoing DMA transfer to finish, the output lock masks its interrupt */
+        if (__get_PRIMASK() != 0U) {
+            dma_poll();
+        }
     }
 }
 
@@ -47,6 +142,7 @@ static bool uart_tx_dma(const uint8_t *buf, uint16_t len) {
     }
     return true;
 }
+#endif /* ELOG_PORT_ASYNC_ENABLE */
 
 /**
  * EasyLogger port initialize
@@ -56,8 +152,15 @@ static bool uart_tx_dma(const uint8_t *buf, uint16_t len) {
 ElogErrCode elog_port_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
 
+#ifdef ELOG_PORT_ASYNC_ENABLE
+    elog_ring_init(&async_ring, async_buf, sizeof(async_buf));
+    dma_busy = 0;
+    dma_len = 0;
+    memset((void *)&async_stats, 0, sizeof(async_stats));
+#else
     uart_dma_idle = true;
-    elog_lock_flag = 0;
+#endif
+    lock_depth = 0;
 
     return result;
 }
@@ -68,7 +171,11 @@ ElogErrCode elog_port_init(void) {
  */
 void elog_port_deinit(void) {
 
+#ifdef ELOG_PORT_ASYNC_ENABLE
+    elog_port_flush();
+#else
     wait_uart_idle();
+#endif
 }
 
 /**
@@ -78,6 +185,45 @@ void elog_port_deinit(void) {
  * @param size log size
  */
 void elog_port_output(const char *log, size_t size) {
+    elog_port_write(log, size);
+#ifdef ELOG_FLASH_ENABLE
+    /* only copied to RAM here, elog_flash_flush() writes it to flash */
+    elog_flash_write(log, size);
+#endif
+}
+
+/**
+ * send log to the UART only
+ *
+ * @param log output of log
+ * @param size log size
+ */
+void elog_port_write(const char *log, size_t size) {
+#ifdef ELOG_PORT_ASYNC_ENABLE
+    if ((log == NULL) || (size == 0U)) {
+        return;
+    }
+
+    while (!elog_ring_write(&async_ring, log, (uint32_t)size)) {
+#if ELOG_PORT_ASYNC_FULL_POLICY == ELOG_PORT_ASYNC_BLOCK
+        /* only thread mode may wait, the output lock masks the DMA interrupt so poll it */
+        if ((size <= sizeof(async_buf)) && (__get_IPSR() == 0U)) {
+            if (__get_PRIMASK() != 0U) {
+                dma_poll();
+            }
+            dma_kick();
+            continue;
+        }
+#endif
+        elog_ring_add(&async_stats.dropped_lines, 1U);
+        elog_ring_add(&async_stats.dropped_bytes, (uint32_t)size);
+        return;
+    }
+    elog_ring_add(&async_stats.lines, 1U);
+    elog_ring_add(&async_stats.bytes, (uint32_t)size);
+    update_high_water();
+    dma_kick();
+#else
     const uint8_t *cur = (const uint8_t *)log;
 
     if ((log == NULL) || (size == 0U)) {
@@ -98,25 +244,23 @@ void elog_port_output(const char *log, size_t size) {
         cur += chunk;
         size -= chunk;
     }
+#endif /* ELOG_PORT_ASYNC_ENABLE */
 }
 
 /**
- * output lock
+ * output lock, masks interrupts so an ISR never waits for the code it preempted
+ *
+ * elog formats every line on the caller's stack and holds the lock only to
+ * hand the finished line to elog_port_output(). With ELOG_PORT_ASYNC_ENABLE
+ * that is a copy into the ring; the blocking output polls the DMA handler.
+ * Nested calls keep the PRIMASK of the outermost owner.
  */
 void elog_port_output_lock(void) {
-    while (1) {
-        uint32_t primask = __get_PRIMASK();
-        __disable_irq();
-        if (!elog_lock_flag) {
-            elog_lock_flag = 1;
-            if (!primask) {
-                __enable_irq();
-            }
-            break;
-        }
-        if (!primask) {
-            __enable_irq();
-        }
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (lock_depth++ == 0U) {
+        lock_primask = primask;
     }
 }
 
@@ -124,10 +268,7 @@ void elog_port_output_lock(void) {
  * output unlock
  */
 void elog_port_output_unlock(void) {
-    uint32_t primask = __get_PRIMASK();
-    __disable_irq();
-    elog_lock_flag = 0;
-    if (!primask) {
+    if ((lock_depth > 0U) && (--lock_depth == 0U) && (lock_primask == 0U)) {
         __enable_irq();
     }
 }
@@ -163,14 +304,57 @@ const char *elog_port_get_t_info(void) {
     return "";
 }
 
+/**
+ * wait until every queued log has left the UART, thread mode only
+ */
+void elog_port_flush(void) {
+#ifdef ELOG_PORT_ASYNC_ENABLE
+    while (elog_ring_used(&async_ring) != 0U) {
+        /* drained by the DMA completion chain, kick again in case a start failed */
+        if (__get_PRIMASK() != 0U) {
+            dma_poll();
+        }
+        dma_kick();
+    }
+#else
+    wait_uart_idle();
+#endif
+}
+
+/**
+ * get asynchronous output counters
+ *
+ * @param stats output
+ */
+void elog_port_get_stats(elog_port_stats_t *stats) {
+#ifdef ELOG_PORT_ASYNC_ENABLE
+    *stats = async_stats;
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
     if (huart == &huart2) {
+#ifdef ELOG_PORT_ASYNC_ENABLE
+        dma_done();
+#else
         uart_dma_idle = true;
+#endif
     }
 }
 
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
     if (huart == &huart2) {
+        /* receive errors land here too while the transfer is still running (gState BUSY_TX) */
+        if (huart->gState != HAL_UART_STATE_READY) {
+            return;
+        }
+#ifdef ELOG_PORT_ASYNC_ENABLE
+        /* the pending bytes are lost, keep the chain going */
+        dma_done();
+#else
         uart_dma_idle = true;
+#endif
     }
 }
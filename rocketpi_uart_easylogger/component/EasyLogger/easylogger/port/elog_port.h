@@ -0,0 +1,40 @@
+/*
+ * Function: Bare-metal asynchronous output of the EasyLogger port.
+ *
+ * With ELOG_PORT_ASYNC_ENABLE, elog_port_output() only copies the formatted
+ * line into a lock-free ring; USART2 DMA drains it in the background and
+ * HAL_UART_TxCpltCallback chains the next transfer.
+ */
+
+#ifndef _ELOG_PORT_H_
+#define _ELOG_PORT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* full ring policy for ELOG_PORT_ASYNC_FULL_POLICY */
+#define ELOG_PORT_ASYNC_DROP                     0
+#define ELOG_PORT_ASYNC_BLOCK                    1
+
+typedef struct {
+    uint32_t lines;                   /* lines queued */
+    uint32_t bytes;                   /* bytes queued */
+    uint32_t dropped_lines;           /* lines discarded because the ring was full */
+    uint32_t dropped_bytes;
+    uint32_t high_water;              /* largest ring fill level seen */
+    uint32_t dma_transfers;           /* DMA transfers started */
+} elog_port_stats_t;
+
+void elog_port_write(const char *log, size_t size);
+void elog_port_get_stats(elog_port_stats_t *stats);
+void elog_port_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ELOG_PORT_H_ */
@@ -0,0 +1,123 @@
+/*
+ * Function: Lock-free multi-producer byte ring for the bare-metal async port.
+ */
+
+#include <string.h>
+#include "elog_ring.h"
+
+#define RING_DIST(a, b)                          (((a) - (b)) & ELOG_RING_POS_MASK)
+
+/**
+ * initialize the ring
+ *
+ * @param ring ring object
+ * @param buf storage
+ * @param size storage size, power of two
+ */
+void elog_ring_init(elog_ring_t *ring, uint8_t *buf, uint32_t size) {
+    ring->buf = buf;
+    ring->size = size;
+    ring->state = 0;
+    ring->published = 0;
+    ring->release = 0;
+}
+
+/**
+ * publish everything up to pos unless a later position is already published
+ */
+static void ring_publish(elog_ring_t *ring, uint32_t pos) {
+    uint32_t cur;
+
+    do {
+        cur = __LDREXW(&ring->published);
+        if (RING_DIST(pos, cur) == 0U || RING_DIST(pos, cur) > ring->size) {
+            __CLREX();
+            return;
+        }
+    } while (__STREXW(pos, &ring->published) != 0U);
+}
+
+/**
+ * copy a block into the ring, all or nothing
+ *
+ * @param ring ring object
+ * @param data bytes to copy
+ * @param len byte count
+ *
+ * @return false when the ring does not have len free bytes
+ */
+bool elog_ring_write(elog_ring_t *ring, const void *data, uint32_t len) {
+    uint32_t state, pos, writers, offset, first;
+
+    if (len == 0U || len > ring->size) {
+        return false;
+    }
+
+    /* reserve */
+    do {
+        state = __LDREXW(&ring->state);
+        pos = state & ELOG_RING_POS_MASK;
+        writers = state >> 24;
+        if (writers == 0xFFU || RING_DIST(pos, ring->release) + len > ring->size) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(((writers + 1U) << 24) | ((pos + len) & ELOG_RING_POS_MASK), &ring->state) != 0U);
+
+    /* copy, possibly wrapping around the end of the storage */
+    offset = pos & (ring->size - 1U);
+    first = ring->size - offset;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&ring->buf[offset], data, first);
+    memcpy(ring->buf, (const uint8_t *)data + first, len - first);
+
+    /* commit, the last writer out publishes all reservations made so far */
+    do {
+        state = __LDREXW(&ring->state);
+        writers = (state >> 24) - 1U;
+    } while (__STREXW((writers << 24) | (state & ELOG_RING_POS_MASK), &ring->state) != 0U);
+    if (writers == 0U) {
+        __DMB();
+        ring_publish(ring, state & ELOG_RING_POS_MASK);
+    }
+
+    return true;
+}
+
+/**
+ * @return bytes reserved by producers and not yet released by the consumer
+ */
+uint32_t elog_ring_used(const elog_ring_t *ring) {
+    return RING_DIST(ring->state & ELOG_RING_POS_MASK, ring->release);
+}
+
+/**
+ * get the longest contiguous run of published bytes, consumer only
+ *
+ * @param ring ring object
+ * @param data start of the run
+ *
+ * @return run length, 0 when nothing is published
+ */
+uint32_t elog_ring_peek(const elog_ring_t *ring, const uint8_t **data) {
+    uint32_t release = ring->release;
+    uint32_t avail = RING_DIST(ring->published, release);
+    uint32_t offset = release & (ring->size - 1U);
+
+    __DMB();
+    if (avail > ring->size - offset) {
+        avail = ring->size - offset;
+    }
+    *data = &ring->buf[offset];
+
+    return avail;
+}
+
+/**
+ * give len bytes back to the producers, consumer only
+ */
+void elog_ring_consume(elog_ring_t *ring, uint32_t len) {
+    ring->release = (ring->release + len) & ELOG_RING_POS_MASK;
+}
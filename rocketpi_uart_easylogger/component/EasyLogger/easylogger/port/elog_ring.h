@@ -0,0 +1,76 @@
+/*
+ * Function: Lock-free multi-producer byte ring for the bare-metal async port.
+ *
+ * Producers (thread or interrupt context) reserve space with LDREX/STREX,
+ * copy their bytes outside of any critical section and commit. Data becomes
+ * visible to the single consumer once every overlapping reservation has been
+ * committed, so a producer preempted in the middle of its copy only delays
+ * publication, it never blocks the interrupting producer.
+ */
+
+#ifndef _ELOG_RING_H_
+#define _ELOG_RING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cmsis_compiler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* positions are kept modulo 2^24, the top byte of state counts active writers */
+#define ELOG_RING_POS_MASK                       0x00FFFFFFUL
+#define ELOG_RING_MAX_SIZE                       (1UL << 23)
+
+typedef struct {
+    uint8_t *buf;
+    uint32_t size;                    /* power of two, <= ELOG_RING_MAX_SIZE */
+    volatile uint32_t state;          /* writers << 24 | reserve position */
+    volatile uint32_t published;      /* end of committed bytes */
+    volatile uint32_t release;        /* start of bytes still owned by the consumer */
+} elog_ring_t;
+
+/**
+ * compare and swap on a word, usable from thread and interrupt context
+ *
+ * STREX may fail without another writer (an exception clears the monitor),
+ * so retry for as long as the word still holds expect.
+ *
+ * @return true if *p was expect and now holds desired
+ */
+static inline bool elog_ring_cas(volatile uint32_t *p, uint32_t expect, uint32_t desired) {
+    do {
+        if (__LDREXW(p) != expect) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(desired, p) != 0U);
+
+    return true;
+}
+
+/**
+ * atomically add to a counter and return the new value
+ */
+static inline uint32_t elog_ring_add(volatile uint32_t *p, uint32_t value) {
+    uint32_t result;
+
+    do {
+        result = __LDREXW(p) + value;
+    } while (__STREXW(result, p) != 0U);
+
+    return result;
+}
+
+void elog_ring_init(elog_ring_t *ring, uint8_t *buf, uint32_t size);
+bool elog_ring_write(elog_ring_t *ring, const void *data, uint32_t len);
+uint32_t elog_ring_used(const elog_ring_t *ring);
+uint32_t elog_ring_peek(const elog_ring_t *ring, const uint8_t **data);
+void elog_ring_consume(elog_ring_t *ring, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ELOG_RING_H_ */
@@ -62,6 +62,14 @@
 #define ELOG_FILTER_TAG_LVL_MAX_NUM          4
 #endif
 
+/* tag ID table size, tags beyond it fall back to the string compare filters */
+#ifndef ELOG_FILTER_TAG_ID_MAX_NUM
+#define ELOG_FILTER_TAG_ID_MAX_NUM           16
+#endif
+#if (ELOG_FILTER_TAG_ID_MAX_NUM & (ELOG_FILTER_TAG_ID_MAX_NUM - 1)) != 0
+    #error "ELOG_FILTER_TAG_ID_MAX_NUM must be a power of two"
+#endif
+
 #ifdef ELOG_COLOR_ENABLE
 /**
  * CSI(Control Sequence Introducer/Initiator) sign
@@ -116,8 +124,21 @@
 
 /* EasyLogger object */
 static EasyLogger elog;
-/* every line log's buffer */
-static char log_buf[ELOG_LINE_BUF_SIZE] = { 0 };
+
+/**
+ * Every tag seen by elog_output() gets an ID (its slot) in this open
+ * addressing table. The slot caches the result of the level, tag and tag
+ * level filters, so a log is accepted or dropped before anything is
+ * formatted and without taking the output lock. The cache is rebuilt
+ * whenever one of those filters changes.
+ */
+typedef struct {
+    volatile uint32_t hash;           /**< 0: free slot */
+    volatile uint8_t pass;            /**< log passes when level < pass, 0 blocks every level */
+    char tag[ELOG_FILTER_TAG_MAX_LEN + 1];
+} ElogTagId, *ElogTagId_t;
+
+static ElogTagId tag_id_table[ELOG_FILTER_TAG_ID_MAX_NUM];
 /* level output info */
 static const char *level_output_info[] = {
         [ELOG_LVL_ASSERT]  = "A/",
@@ -144,6 +165,7 @@ static bool get_fmt_enabled(uint8_t level, size_t set);
 static bool get_fmt_used_and_enabled_u32(uint8_t level, size_t set, uint32_t arg);
 static bool get_fmt_used_and_enabled_ptr(uint8_t level, size_t set, const char* arg);
 static void elog_set_filter_tag_lvl_default(void);
+static void tag_id_refresh(void);
 
 /* EasyLogger assert hook */
 void (*elog_assert_hook)(const char* expr, const char* func, size_t line);
@@ -346,6 +368,7 @@ void elog_set_filter_lvl(uint8_t level) {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
     elog.filter.level = level;
+    tag_id_refresh();
 }
 
 /**
@@ -355,6 +378,7 @@ void elog_set_filter_lvl(uint8_t level) {
  */
 void elog_set_filter_tag(const char *tag) {
     strncpy(elog.filter.tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+    tag_id_refresh();
 }
 
 /**
@@ -402,6 +426,7 @@ static void elog_set_filter_tag_lvl_default(void)
         elog.filter.tag_lvl[i].level = ELOG_FILTER_LVL_SILENT;
         elog.filter.tag_lvl[i].tag_use_flag = false;
     }
+    tag_id_refresh();
 }
 
 /**
@@ -464,7 +489,105 @@ void elog_set_filter_tag_lvl(const char *tag, uint8_t level)
             }
         }
     }
+    tag_id_refresh();
+    elog_output_unlock();
+}
+
+/**
+ * FNV-1a hash of a tag, never 0
+ */
+static uint32_t tag_id_hash(const char *tag) {
+    uint32_t hash = 2166136261UL;
+    size_t i;
+
+    for (i = 0; i < ELOG_FILTER_TAG_MAX_LEN && tag[i] != '\0'; i++) {
+        hash = (hash ^ (uint8_t)tag[i]) * 16777619UL;
+    }
+
+    return (hash != 0) ? hash : 1;
+}
+
+/**
+ * evaluate the level, tag and tag level filters for one tag
+ *
+ * @return the pass value stored in the tag's slot
+ */
+static uint8_t tag_id_pass(const char *tag) {
+    uint8_t level = elog.filter.level, i;
+
+    if (!strstr(tag, elog.filter.tag)) {
+        return 0;
+    }
+    for (i = 0; i < ELOG_FILTER_TAG_LVL_MAX_NUM; i++) {
+        if (elog.filter.tag_lvl[i].tag_use_flag == true &&
+            !strncmp(tag, elog.filter.tag_lvl[i].tag, ELOG_FILTER_TAG_MAX_LEN)) {
+            if (elog.filter.tag_lvl[i].level < level) {
+                level = elog.filter.tag_lvl[i].level;
+            }
+            break;
+        }
+    }
+
+    return level + 1;
+}
+
+/**
+ * re-evaluate the cached filter result of every known tag
+ */
+static void tag_id_refresh(void) {
+    size_t i;
+
+    for (i = 0; i < ELOG_FILTER_TAG_ID_MAX_NUM; i++) {
+        if (tag_id_table[i].hash != 0) {
+            tag_id_table[i].pass = tag_id_pass(tag_id_table[i].tag);
+        }
+    }
+}
+
+/**
+ * get the ID slot of a tag, adding it on first use
+ *
+ * @param tag tag
+ *
+ * @return NULL when the table is full
+ */
+static ElogTagId_t tag_id_get(const char *tag) {
+    uint32_t hash = tag_id_hash(tag);
+    size_t i, n;
+    ElogTagId_t slot = NULL;
+
+    /* lookup, lock free */
+    for (n = 0, i = hash; n < ELOG_FILTER_TAG_ID_MAX_NUM; n++, i++) {
+        slot = &tag_id_table[i & (ELOG_FILTER_TAG_ID_MAX_NUM - 1)];
+        if (slot->hash == 0) {
+            break;
+        }
+        if (slot->hash == hash && !strncmp(tag, slot->tag, ELOG_FILTER_TAG_MAX_LEN)) {
+            return slot;
+        }
+    }
+    if (n == ELOG_FILTER_TAG_ID_MAX_NUM) {
+        return NULL;
+    }
+
+    /* insert, the slot may have been taken meanwhile so probe again under the lock */
+    elog_output_lock();
+    for (; n < ELOG_FILTER_TAG_ID_MAX_NUM; n++, i++) {
+        slot = &tag_id_table[i & (ELOG_FILTER_TAG_ID_MAX_NUM - 1)];
+        if (slot->hash == 0) {
+            strncpy(slot->tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+            slot->pass = tag_id_pass(tag);
+            /* publish last, lock free readers test hash first */
+            slot->hash = hash;
+            break;
+        }
+        if (slot->hash == hash && !strncmp(tag, slot->tag, ELOG_FILTER_TAG_MAX_LEN)) {
+            break;
+        }
+    }
     elog_output_unlock();
+
+    return (n < ELOG_FILTER_TAG_ID_MAX_NUM) ? slot : NULL;
 }
 
 /**
@@ -506,6 +629,8 @@ uint8_t elog_get_filter_tag_lvl(const char *tag)
  * @param ... args
  */
 void elog_raw_output(const char *format, ...) {
+    /* every caller formats on its own stack, so an interrupt can log while a thread is formatting */
+    char log_buf[ELOG_LINE_BUF_SIZE];
     va_list args;
     size_t log_len = 0;
     int fmt_result;
@@ -518,9 +643,6 @@ void elog_raw_output(const char *format, ...) {
     /* args point to the first variable parameter */
     va_start(args, format);
 
-    /* lock output */
-    elog_output_lock();
-
     /* package log data to buffer */
     fmt_result = vsnprintf(log_buf, ELOG_LINE_BUF_SIZE, format, args);
 
@@ -530,6 +652,8 @@ void elog_raw_output(const char *format, ...) {
     } else {
         log_len = ELOG_LINE_BUF_SIZE;
     }
+    /* lock output */
+    elog_output_lock();
     /* output log */
 #if defined(ELOG_ASYNC_OUTPUT_ENABLE)
     extern void elog_async_output(uint8_t level, const char *log, size_t size);
@@ -565,11 +689,13 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
     extern const char *elog_port_get_p_info(void);
     extern const char *elog_port_get_t_info(void);
 
-    size_t tag_len = strlen(tag), log_len = 0, newline_len = strlen(ELOG_NEWLINE_SIGN);
-    char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
-    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
+    char log_buf[ELOG_LINE_BUF_SIZE];
+    size_t tag_len, log_len = 0, newline_len = sizeof(ELOG_NEWLINE_SIGN) - 1;
+    char line_num[ELOG_LINE_NUM_MAX_LEN + 1];
+    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1];
     va_list args;
     int fmt_result;
+    ElogTagId_t tag_id;
 
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
@@ -578,15 +704,23 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
         return;
     }
     /* level filter */
-    if (level > elog.filter.level || level > elog_get_filter_tag_lvl(tag)) {
+    if (level > elog.filter.level) {
         return;
-    } else if (!strstr(tag, elog.filter.tag)) { /* tag filter */
+    }
+    /* tag and tag level filters, cached per tag ID */
+    tag_id = tag_id_get(tag);
+    if (tag_id != NULL) {
+        if (level >= tag_id->pass) {
+            return;
+        }
+    } else if (level > elog_get_filter_tag_lvl(tag) || !strstr(tag, elog.filter.tag)) {
         return;
     }
+    tag_len = strlen(tag);
+    memset(line_num, 0, sizeof(line_num));
+    memset(tag_sapce, 0, sizeof(tag_sapce));
     /* args point to the first variable parameter */
     va_start(args, format);
-    /* lock output */
-    elog_output_lock();
 
 #ifdef ELOG_COLOR_ENABLE
     /* add CSI start sign and color info */
@@ -615,7 +749,10 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
         log_len += elog_strcpy(log_len, log_buf + log_len, "[");
         /* package time info */
         if (get_fmt_enabled(level, ELOG_FMT_TIME)) {
+            /* the port returns a static buffer, copy it before another context reuses it */
+            elog_output_lock();
             log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_time());
+            elog_output_unlock();
             if (get_fmt_enabled(level, ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
                 log_len += elog_strcpy(log_len, log_buf + log_len, " ");
             }
@@ -694,8 +831,6 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
         log_buf[log_len] = '\0';
         /* find the keyword */
         if (!strstr(log_buf, elog.filter.keyword)) {
-            /* unlock output */
-            elog_output_unlock();
             return;
         }
     }
@@ -709,6 +844,8 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
 
     /* package newline sign */
     log_len += elog_strcpy(log_len, log_buf + log_len, ELOG_NEWLINE_SIGN);
+    /* lock output */
+    elog_output_lock();
     /* output log */
 #if defined(ELOG_ASYNC_OUTPUT_ENABLE)
     extern void elog_async_output(uint8_t level, const char *log, size_t size);
@@ -865,6 +1002,7 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
 {
 #define __is_print(ch)       ((unsigned int)((ch) - ' ') < 127u - ' ')
 
+    char log_buf[ELOG_LINE_BUF_SIZE];
     uint16_t i, j;
     uint16_t log_len = 0;
     const uint8_t *buf_p = buf;
@@ -882,9 +1020,6 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
         return;
     }
 
-    /* lock output */
-    elog_output_lock();
-
     for (i = 0; i < size; i += width) {
         /* package header */
         fmt_result = snprintf(log_buf, ELOG_LINE_BUF_SIZE, "D/HEX %s: %04X-%04X: ", name, i, i + width - 1);
@@ -920,6 +1055,8 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
         }
         /* package newline sign */
         log_len += elog_strcpy(log_len, log_buf + log_len, ELOG_NEWLINE_SIGN);
+        /* lock output */
+        elog_output_lock();
         /* do log output */
 #if defined(ELOG_ASYNC_OUTPUT_ENABLE)
         extern void elog_async_output(uint8_t level, const char *log, size_t size);
@@ -930,7 +1067,7 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
 #else
         elog_port_output(log_buf, log_len);
 #endif
+        /* unlock output */
+        elog_output_unlock();
     }
-    /* unlock output */
-    elog_output_unlock();
 }
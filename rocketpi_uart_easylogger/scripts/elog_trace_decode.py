@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""
+Decode EasyLogger binary trace records (plugins/trace) captured from the UART.
+
+Text log lines in the same stream are passed through unchanged; records are
+expanded with the call site descriptors read from the ELF image (.axf) of the
+firmware that produced them.
+
+    python scripts/elog_trace_decode.py MDK-ARM/rocketpi_uart_easylogger/rocketpi_uart_easylogger.axf capture.bin
+    python scripts/elog_trace_decode.py firmware.axf --port COM5 --baud 115200
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import struct
+import sys
+from pathlib import Path
+from typing import BinaryIO, Iterator
+
+SYNC = 0xA5
+MAX_ARGS = 15
+DESC_SIZE = 16
+LEVELS = "AEWIDV"
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|z|j|t)?([diouxXcspfFeEgG%])")
+
+
+class ElfImage:
+    """Loadable sections of a 32-bit little-endian ELF file."""
+
+    def __init__(self, path: Path) -> None:
+        data = path.read_bytes()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError(f"{path} is not a 32-bit little-endian ELF file")
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+        self.sections: list[tuple[int, bytes]] = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIIIII", data, shoff + i * shentsize)
+            # SHT_PROGBITS with SHF_ALLOC: code and constant data in flash
+            if sh_type == 1 and flags & 0x2 and size:
+                self.sections.append((addr, data[offset:offset + size]))
+
+    def read(self, addr: int, size: int) -> bytes:
+        for base, blob in self.sections:
+            if base <= addr and addr + size <= base + len(blob):
+                return blob[addr - base:addr - base + size]
+        raise KeyError(f"address 0x{addr:08x} is not in the image")
+
+    def string(self, addr: int) -> str:
+        for base, blob in self.sections:
+            if base <= addr < base + len(blob):
+                end = blob.find(b"\0", addr - base)
+                return blob[addr - base:end].decode("utf-8", errors="replace")
+        return f"<0x{addr:08x}>"
+
+
+def pad(digits: str, flags: str, width: str | None, precision: str | None) -> str:
+    size = int(width or 0)
+    if "-" in flags:
+        return digits.ljust(size)
+    if "0" in flags and precision is None:
+        return digits.rjust(size, "0")
+    return digits.rjust(size)
+
+
+def format_record(image: ElfImage, desc_addr: int, timestamp: int, args: list[int]) -> str:
+    try:
+        fmt_ptr, tag_ptr, file_ptr, line, level = struct.unpack("<IIIHB", image.read(desc_addr, DESC_SIZE - 1))
+    except KeyError:
+        return f"?/trace  [{timestamp}] unknown descriptor 0x{desc_addr:08x} args={args}"
+
+    words = iter(args)
+
+    def expand(match: re.Match[str]) -> str:
+        flags, width, precision, _, conv = match.groups()
+        if conv == "%":
+            return "%"
+        if width == "*":
+            width = str(next(words, 0))
+        if precision == "*":
+            precision = str(next(words, 0))
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+        word = next(words, 0)
+        if conv in "di":
+            return (spec + "d") % (word - (1 << 32) if word & 0x80000000 else word)
+        if conv == "u":
+            return (spec + "d") % word
+        if conv == "o" and "#" in flags:
+            # C only forces a leading 0, Python would print 0o17
+            digits = ("%" + ("." + precision if precision is not None else "") + "o") % word
+            digits = digits if digits.startswith("0") else "0" + digits
+            return pad(digits, flags, width, precision)
+        if conv in "xX" and "#" in flags and word == 0:
+            # C prints no 0x prefix for zero
+            return (spec.replace("#", "") + conv) % word
+        if conv in "oxX":
+            return (spec + conv) % word
+        if conv == "c":
+            return (spec + "c") % chr(word & 0xFF)
+        if conv == "p":
+            return "0x%08x" % word
+        if conv == "s":
+            return (spec + "s") % image.string(word)
+        return (spec + conv) % struct.unpack("<f", struct.pack("<I", word))[0]
+
+    message = CONVERSION.sub(expand, image.string(fmt_ptr))
+    lvl = LEVELS[level] if level < len(LEVELS) else "?"
+    file_name = image.string(file_ptr).replace("\\", "/").rsplit("/", 1)[-1]
+    return f"{lvl}/{image.string(tag_ptr):<8} [{timestamp}] {message} ({file_name}:{line})"
+
+
+def decode(stream: BinaryIO, image: ElfImage, follow: bool = False) -> Iterator[str]:
+    buf = bytearray()
+    text = bytearray()
+    eof = False
+    while True:
+        chunk = stream.read(256)
+        if chunk:
+            buf.extend(chunk)
+        elif not follow:
+            # no more data: a sync byte that cannot start a whole record is text
+            eof = True
+        while buf:
+            if buf[0] != SYNC:
+                text.append(buf.pop(0))
+                if text.endswith(b"\n"):
+                    yield text.decode("utf-8", errors="replace").rstrip("\r\n")
+                    text.clear()
+                continue
+            if len(buf) < 2:
+                if eof:
+                    text.append(buf.pop(0))
+                    continue
+                break
+            nargs = buf[1]
+            size = 11 + nargs * 4
+            if nargs > MAX_ARGS:
+                text.append(buf.pop(0))
+                continue
+            if len(buf) < size:
+                if eof:
+                    text.append(buf.pop(0))
+                    continue
+                break
+            check = 0
+            for b in buf[:size - 1]:
+                check ^= b
+            if check != buf[size - 1]:
+                # not a record after all, treat the sync byte as text
+                text.append(buf.pop(0))
+                continue
+            desc_addr, timestamp = struct.unpack_from("<II", buf, 2)
+            args = list(struct.unpack_from(f"<{nargs}I", buf, 10))
+            del buf[:size]
+            yield format_record(image, desc_addr, timestamp, args)
+        if eof:
+            break
+    if text:
+        yield text.decode("utf-8", errors="replace")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", type=Path, help="firmware image (.axf/.elf) with the trace descriptors")
+    parser.add_argument("capture", nargs="?", type=Path, help="raw UART capture, stdin if omitted")
+    parser.add_argument("--port", help="read from a serial port instead (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    image = ElfImage(args.elf)
+    if args.port:
+        import serial  # type: ignore[import-not-found]
+
+        stream: BinaryIO = serial.Serial(args.port, args.baud, timeout=0.1)
+    elif args.capture:
+        stream = args.capture.open("rb")
+    else:
+        stream = sys.stdin.buffer
+
+    try:
+        for line in decode(stream, image, follow=bool(args.port)):
+            print(line, flush=True)
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -25,6 +25,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include <string.h>
+#include "uart_stream.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -34,7 +35,7 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-#define UART_DMA_BUFFER_SIZE 128U  /* 单次回显缓存大小 */
+#define UART_STREAM_BUFFER_SIZE 1024U  /* 循环接收缓冲大小，必须为 2 的幂，回显每段最多半个缓冲区 */
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -51,33 +52,16 @@
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
-static HAL_StatusTypeDef uart_restart_rx_dma(void);
 static void uart_send_string(const char *msg);
 static void uart_send_banner(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-static uint8_t g_uart_rx_buffer[UART_DMA_BUFFER_SIZE];
-static uint8_t g_uart_tx_buffer[UART_DMA_BUFFER_SIZE];
+static uint8_t g_uart_rx_buffer[UART_STREAM_BUFFER_SIZE];
+static uart_stream_t g_uart_stream;
 
-/* 重新启动串口空闲中断 DMA 接收，始终准备下一帧数据 */
-static HAL_StatusTypeDef uart_restart_rx_dma(void)
-{
-  HAL_StatusTypeDef status = HAL_UARTEx_ReceiveToIdle_DMA(&huart2,
-                                                          g_uart_rx_buffer,
-                                                          UART_DMA_BUFFER_SIZE);
-  if (status == HAL_OK)
-  {
-    if (huart2.hdmarx != NULL)
-    {
-      __HAL_DMA_DISABLE_IT(huart2.hdmarx, DMA_IT_HT);
-    }
-  }
-  return status;
-}
-
-/* 阻塞方式发送字符串，主要用于提示和回显 */
+/* 阻塞方式发送字符串，用于启动提示 */
 static void uart_send_string(const char *msg)
 {
   if ((msg == NULL) || (*msg == '\0'))
@@ -105,40 +89,22 @@ static void uart_send_banner(void)
   uart_send_string("Type any text and it will be echoed back.\r\n> ");
 }
 
-/* 串口接收到一帧数据后立即回显，并重新打开 DMA 接收 */
+/* DMA 写指针推进（HT/TC/IDLE）后立即从接收缓冲直接回显，不拷贝、不重启 DMA */
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
-  if ((huart != &huart2) || (Size == 0U))
-  {
-    return;
-  }
-
-  const uint16_t copy_size = (Size <= UART_DMA_BUFFER_SIZE) ? Size : UART_DMA_BUFFER_SIZE;
-  memcpy(g_uart_tx_buffer, g_uart_rx_buffer, copy_size);
-
-  if (uart_restart_rx_dma() != HAL_OK)
-  {
-    Error_Handler();
-  }
+  uart_stream_on_rx_event(&g_uart_stream, huart, Size);
+}
 
-  if (HAL_UART_Transmit(&huart2, g_uart_tx_buffer, copy_size, HAL_MAX_DELAY) != HAL_OK)
-  {
-    Error_Handler();
-  }
+/* 回显段发送完成，释放该段并发送后续数据 */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  uart_stream_on_tx_complete(&g_uart_stream, huart);
 }
 
 /* 若发生串口错误则重新启动 DMA 接收，保证示例持续运行 */
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
-  if (huart != &huart2)
-  {
-    return;
-  }
-
-  if (uart_restart_rx_dma() != HAL_OK)
-  {
-    Error_Handler();
-  }
+  uart_stream_on_error(&g_uart_stream, huart);
 }
 /* USER CODE END 0 */
 
@@ -174,12 +140,14 @@ int main(void)
   MX_DMA_Init();
   MX_USART2_UART_Init();
   /* USER CODE BEGIN 2 */
-  /* 上电后先启动 DMA 接收，再输出提示信息 */
-  if (uart_restart_rx_dma() != HAL_OK)
+  /* 上电后先启动循环 DMA 接收，输出提示信息后再开始回显 */
+  if ((uart_stream_init(&g_uart_stream, &huart2, g_uart_rx_buffer, UART_STREAM_BUFFER_SIZE) != HAL_OK) ||
+      (uart_stream_start(&g_uart_stream) != HAL_OK))
   {
     Error_Handler();
   }
   uart_send_banner();
+  uart_stream_forward(&g_uart_stream, &huart2);
   /* USER CODE END 2 */
 
   /* Infinite loop */
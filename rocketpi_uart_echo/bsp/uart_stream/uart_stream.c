@@ -0,0 +1,254 @@
+/**
+ * @file    uart_stream.c
+ * @brief   串口循环 DMA 接收环形缓冲实现。
+ *
+ * HAL 在循环模式下上报的 Size 是 DMA 在缓冲区中的写入位置（TC 时为缓冲区大小），
+ * 与上一次位置相减（模缓冲区大小）即为新收到的字节数。HT 与 TC 保证每半个缓冲区至少有一次事件，
+ * 因此两次 HT/TC 事件之间最多相差半个缓冲区，不会出现整圈的歧义。
+ *
+ * 串口错误时 HAL 会中止 RX DMA，重启后 DMA 从偏移 0 开始写入：中断里记录新的 rx_base
+ * 并增加 rx_epoch，读取方发现轮次变化后把读指针移到 rx_base，丢弃重启前未读的数据。
+ */
+#include "uart_stream.h"
+
+#include <string.h>
+
+/* DMA 写指针与最早未读数据之间保留的余量，容忍发送方波特率略快于转发串口 */
+#define UART_STREAM_GUARD(size)     ((size) / 8U)
+
+/*
+ * 重启前的未读数据作废，读指针对齐到新的接收轮次。
+ * 事件只上报到 HT/TC/IDLE 为止，DMA 此后可能又写入了最多半个缓冲区，因此按 NDTR 计算
+ * DMA 的实际位置：未读数据加上未上报部分超过 (缓冲区 - 余量) 时，最早的数据即将或已经被覆盖，
+ * 丢弃超出的部分，保证随后读取或转发的数据不会在途中被 DMA 改写。
+ */
+static uint32_t uart_stream_sync(uart_stream_t *s)
+{
+    uint32_t size = s->mask + 1U;
+    uint32_t primask;
+    uint32_t head;
+    uint32_t pending;
+    uint32_t avail;
+    uint32_t limit;
+
+    if (s->tail_epoch != s->rx_epoch)
+    {
+        uint32_t epoch;
+        uint32_t base;
+
+        do
+        {
+            epoch = s->rx_epoch;
+            base = s->rx_base;
+        } while (epoch != s->rx_epoch);
+        s->stats.rx_dropped += base - s->tail;
+        s->tail = base;
+        s->tail_epoch = epoch;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    head = s->rx_head;
+    pending = (size - (uint32_t)__HAL_DMA_GET_COUNTER(s->huart->hdmarx) - s->dma_pos) & s->mask;
+    if (primask == 0U)
+    {
+        __enable_irq();
+    }
+
+    avail = head - s->tail;
+    limit = size - UART_STREAM_GUARD(size);
+    if ((avail + pending) > limit)
+    {
+        uint32_t excess = avail + pending - limit;
+
+        if (excess > avail)
+        {
+            excess = avail;
+        }
+        s->stats.rx_dropped += excess;
+        s->tail += excess;
+        avail -= excess;
+    }
+    return avail;
+}
+
+static HAL_StatusTypeDef uart_stream_start_dma(uart_stream_t *s)
+{
+    /* HAL 默认打开 HT 中断，循环模式下 HT/TC/IDLE 都会进入 RxEventCallback */
+    return HAL_UARTEx_ReceiveToIdle_DMA(s->huart, s->buf, (uint16_t)(s->mask + 1U));
+}
+
+/* 转发空闲且有数据时以环形缓冲中的连续段为源启动 TX DMA，调用方需保证不被回调打断 */
+static void uart_stream_kick(uart_stream_t *s)
+{
+    const uint8_t *data;
+    size_t len;
+
+    if ((s->fwd == NULL) || (s->tx_len != 0U))
+    {
+        return;
+    }
+    len = uart_stream_peek(s, &data);
+    if (len == 0U)
+    {
+        return;
+    }
+    s->tx_len = (uint32_t)len;
+    if (HAL_UART_Transmit_DMA(s->fwd, (uint8_t *)data, (uint16_t)len) == HAL_OK)
+    {
+        s->stats.tx_segments++;
+    }
+    else
+    {
+        /* 目标串口忙（例如仍有阻塞发送），下一次事件时重试 */
+        s->tx_len = 0U;
+    }
+}
+
+HAL_StatusTypeDef uart_stream_init(uart_stream_t *s, UART_HandleTypeDef *huart,
+                                   uint8_t *buf, uint16_t size)
+{
+    if ((s == NULL) || (huart == NULL) || (buf == NULL) ||
+        (size < 2U) || (size > 32768U) || ((size & (size - 1U)) != 0U))
+    {
+        return HAL_ERROR;
+    }
+    memset(s, 0, sizeof(*s));
+    s->huart = huart;
+    s->buf = buf;
+    s->mask = (uint32_t)size - 1U;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef uart_stream_start(uart_stream_t *s)
+{
+    s->dma_pos = 0U;
+    s->rx_base = s->rx_head;
+    s->rx_epoch++;
+    return uart_stream_start_dma(s);
+}
+
+size_t uart_stream_available(uart_stream_t *s)
+{
+    return uart_stream_sync(s);
+}
+
+size_t uart_stream_peek(uart_stream_t *s, const uint8_t **data)
+{
+    uint32_t avail = uart_stream_sync(s);
+    uint32_t offset = (s->tail - s->rx_base) & s->mask;
+    uint32_t len = s->mask + 1U - offset;
+
+    if (len > avail)
+    {
+        len = avail;
+    }
+    *data = &s->buf[offset];
+    return len;
+}
+
+void uart_stream_consume(uart_stream_t *s, size_t len)
+{
+    uint32_t avail = s->rx_head - s->tail;
+
+    if (len > avail)
+    {
+        len = avail;
+    }
+    s->tail += (uint32_t)len;
+}
+
+size_t uart_stream_read(uart_stream_t *s, void *data, size_t len)
+{
+    uint8_t *dst = (uint8_t *)data;
+    size_t done = 0U;
+
+    /* 数据可能跨越缓冲区末尾，最多分两段拷贝 */
+    while (done < len)
+    {
+        const uint8_t *src;
+        size_t chunk = uart_stream_peek(s, &src);
+
+        if (chunk == 0U)
+        {
+            break;
+        }
+        if (chunk > (len - done))
+        {
+            chunk = len - done;
+        }
+        memcpy(&dst[done], src, chunk);
+        uart_stream_consume(s, chunk);
+        done += chunk;
+    }
+    return done;
+}
+
+void uart_stream_forward(uart_stream_t *s, UART_HandleTypeDef *tx_huart)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    s->fwd = tx_huart;
+    uart_stream_kick(s);
+    if (primask == 0U)
+    {
+        __enable_irq();
+    }
+}
+
+void uart_stream_on_rx_event(uart_stream_t *s, UART_HandleTypeDef *huart, uint16_t size)
+{
+    uint32_t pos;
+    uint32_t len;
+
+    if (huart != s->huart)
+    {
+        return;
+    }
+    /* TC 上报的 Size 等于缓冲区大小，即回到偏移 0 */
+    pos = (uint32_t)size & s->mask;
+    len = (pos - s->dma_pos) & s->mask;
+    if ((len > ((s->mask + 1U) / 2U)) && (HAL_UARTEx_GetRxEventType(huart) != HAL_UART_RXEVENT_IDLE))
+    {
+        /* IDLE 在中断里读取实时 NDTR，可能已越过尚未处理的 HT/TC 边界，此时该边界事件落后，忽略 */
+        return;
+    }
+    s->dma_pos = pos;
+    s->rx_head += len;
+    s->stats.rx_bytes += len;
+    s->stats.rx_events++;
+    uart_stream_kick(s);
+}
+
+void uart_stream_on_tx_complete(uart_stream_t *s, UART_HandleTypeDef *huart)
+{
+    if ((huart != s->fwd) || (s->tx_len == 0U))
+    {
+        return;
+    }
+    s->stats.tx_bytes += s->tx_len;
+    s->tail += s->tx_len;
+    s->tx_len = 0U;
+    uart_stream_kick(s);
+}
+
+void uart_stream_on_error(uart_stream_t *s, UART_HandleTypeDef *huart)
+{
+    if ((huart == s->huart) && (huart->RxState == HAL_UART_STATE_READY))
+    {
+        s->stats.rx_errors++;
+        (void)uart_stream_start(s);
+    }
+    if ((huart == s->fwd) && (s->tx_len != 0U) && (huart->gState == HAL_UART_STATE_READY))
+    {
+        /* 转发被中止，该段未释放，重新发送 */
+        s->tx_len = 0U;
+    }
+    uart_stream_kick(s);
+}
+
+void uart_stream_get_stats(const uart_stream_t *s, uart_stream_stats_t *stats)
+{
+    *stats = s->stats;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file    uart_stream.h
+ * @brief   串口循环 DMA 接收环形缓冲：HT/TC/IDLE 事件推进写指针，支持零拷贝转发。
+ *
+ * 接收使用 HAL_UARTEx_ReceiveToIdle_DMA 的循环模式，DMA 缓冲区本身就是环形缓冲，
+ * 不再在每帧结束后拷贝并重启 DMA，因此帧与帧之间没有丢字节的窗口，帧长也不受缓冲区大小限制。
+ * 半满（HT）、全满（TC）和空闲线（IDLE）三种事件都只把写指针推进到 DMA 当前位置。
+ *
+ * 读取方式二选一：
+ * - 应用读取：uart_stream_peek() 取出一段连续数据，处理后 uart_stream_consume()；
+ * - 转发：uart_stream_forward() 之后直接以环形缓冲中的连续段为源启动 TX DMA，
+ *   发送完成回调中释放该段并发送下一段，全程不拷贝。
+ *
+ * 读取不及时时，未读数据加上 DMA 已写入但未上报的部分（按 NDTR 计算）接近缓冲区大小，
+ * 最早的数据会被丢弃并计入 rx_dropped，读出或转发的数据不会在途中被 DMA 覆盖。
+ *
+ * 工程需要为接收串口配置 RX DMA（循环模式，不要关闭 HT 中断）和串口中断，
+ * 转发时目标串口需要 TX DMA（普通模式），并在 HAL 回调中调用对应的 uart_stream_on_xxx()。
+ */
+#ifndef UART_STREAM_H
+#define UART_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "main.h"
+
+typedef struct
+{
+    uint32_t rx_bytes;       /* DMA 写入环形缓冲的字节数 */
+    uint32_t rx_events;      /* HT/TC/IDLE 事件次数 */
+    uint32_t rx_dropped;     /* 读取不及时或因重启接收丢弃的字节数 */
+    uint32_t rx_errors;      /* 串口错误（重启接收）次数 */
+    uint32_t tx_bytes;       /* 转发完成的字节数 */
+    uint32_t tx_segments;    /* 启动的转发 DMA 次数 */
+} uart_stream_stats_t;
+
+/**
+ * 计数均为累计字节数，缓冲区偏移由 (计数 - rx_base) & mask 得出；
+ * rx_head/rx_base/rx_epoch 只在中断中修改，tail 只由读取方修改。
+ */
+typedef struct
+{
+    UART_HandleTypeDef *huart;        /* 接收串口 */
+    UART_HandleTypeDef *fwd;          /* 转发目标串口，NULL 表示由应用读取 */
+    uint8_t *buf;                     /* 循环 DMA 缓冲区 */
+    uint32_t mask;                    /* 缓冲区大小 - 1 */
+    uint32_t dma_pos;                 /* 上一次事件时的 DMA 写入偏移 */
+    volatile uint32_t rx_head;        /* 累计接收字节数 */
+    volatile uint32_t rx_base;        /* 最近一次启动 DMA 时的 rx_head，对应偏移 0 */
+    volatile uint32_t rx_epoch;       /* 每次重启接收加一 */
+    uint32_t tail;                    /* 累计读出字节数 */
+    uint32_t tail_epoch;              /* tail 所属的接收轮次 */
+    volatile uint32_t tx_len;         /* 正在转发的段长度，0 表示空闲 */
+    uart_stream_stats_t stats;
+} uart_stream_t;
+
+/**
+ * @brief 绑定串口与缓冲区，需在 MX_USARTx_UART_Init() 之后调用。
+ * @param size 缓冲区大小，必须为 2 的幂且不超过 32768。
+ * @return 参数不合法时返回 HAL_ERROR。
+ */
+HAL_StatusTypeDef uart_stream_init(uart_stream_t *s, UART_HandleTypeDef *huart,
+                                   uint8_t *buf, uint16_t size);
+
+/** 启动循环 DMA 接收 */
+HAL_StatusTypeDef uart_stream_start(uart_stream_t *s);
+
+/** 已接收未读取的字节数 */
+size_t uart_stream_available(uart_stream_t *s);
+
+/**
+ * @brief 取得最早未读数据所在的连续段，不移动读指针。
+ * @param data 输出段起始地址。
+ * @return 段长度，0 表示没有数据。
+ */
+size_t uart_stream_peek(uart_stream_t *s, const uint8_t **data);
+
+/** 释放 uart_stream_peek() 得到的前 len 字节 */
+void uart_stream_consume(uart_stream_t *s, size_t len);
+
+/** 拷贝读取最多 len 字节，返回实际读取的字节数 */
+size_t uart_stream_read(uart_stream_t *s, void *data, size_t len);
+
+/**
+ * @brief 把接收到的数据直接从环形缓冲经 TX DMA 转发到 tx_huart（可以是同一串口，即回显）。
+ *        开启后不要再调用 peek/consume/read。
+ */
+void uart_stream_forward(uart_stream_t *s, UART_HandleTypeDef *tx_huart);
+
+/** 在 HAL_UARTEx_RxEventCallback 中调用 */
+void uart_stream_on_rx_event(uart_stream_t *s, UART_HandleTypeDef *huart, uint16_t size);
+
+/** 在 HAL_UART_TxCpltCallback 中调用 */
+void uart_stream_on_tx_complete(uart_stream_t *s, UART_HandleTypeDef *huart);
+
+/** 在 HAL_UART_ErrorCallback 中调用，重启接收并恢复转发 */
+void uart_stream_on_error(uart_stream_t *s, UART_HandleTypeDef *huart);
+
+void uart_stream_get_stats(const uart_stream_t *s, uart_stream_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UART_STREAM_H */
@@ -59,7 +59,8 @@ void Error_Handler(void);
 /* Private defines -----------------------------------------------------------*/
 
 /* USER CODE BEGIN Private defines */
-
+/* stdio 与 uart_printf 经 DMA 环形缓冲收发，见 bsp/debug/debug_retarget.h */
+#define DEBUG_RETARGET_ENABLE 1
 /* USER CODE END Private defines */
 
 #ifdef __cplusplus
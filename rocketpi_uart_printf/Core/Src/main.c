@@ -18,6 +18,7 @@
 /* USER CODE END Header */
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "dma.h"
 #include "usart.h"
 #include "gpio.h"
 
@@ -28,6 +29,7 @@
 #include <string.h>
 #include <stdint.h>
 #include "debug_driver.h"
+#include "debug_retarget.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -91,9 +93,10 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_USART2_UART_Init();
   /* USER CODE BEGIN 2 */
-
+  debug_retarget_init();
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -165,7 +168,20 @@ void SystemClock_Config(void)
 }
 
 /* USER CODE BEGIN 4 */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  debug_retarget_tx_complete(huart);
+}
+
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+  debug_retarget_rx_event(huart, Size);
+}
 
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+  debug_retarget_error(huart);
+}
 /* USER CODE END 4 */
 
 /**
@@ -177,6 +193,7 @@ void Error_Handler(void)
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
   __disable_irq();
+  debug_retarget_flush_panic();
   while (1)
   {
   }
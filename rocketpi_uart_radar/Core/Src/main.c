@@ -94,6 +94,7 @@ int main(void)
   MX_USART1_UART_Init();
   /* USER CODE BEGIN 2 */
   mg58f18_radar_test_run();
+  mg58f18_radar_test_async_run();
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -14,6 +14,33 @@
 #define MG58F18_RADAR_CHECKSUM_INDEX 5U  /**< Data1^Data2^Data3^Data4 的放置位置 */
 #define MG58F18_RADAR_TAIL_INDEX     6U  /**< 帧尾 FE 的偏移 */
 #define MG58F18_RADAR_DELAY_SCALER   32U /**< 协议时间单位换算：raw/32 = 毫秒 */
+#define MG58F18_RADAR_ASYNC_MASK     (MG58F18_RADAR_ASYNC_QUEUE_DEPTH - 1U)
+
+/**
+ * @brief 异步队列槽位状态。
+ */
+typedef enum
+{
+    MG58F18_RADAR_SLOT_QUEUED = 0, /**< 已入队，尚未发出 */
+    MG58F18_RADAR_SLOT_SENT,       /**< 已发出，等待应答 */
+    MG58F18_RADAR_SLOT_REPLIED,    /**< 解析器已匹配到应答，等待主循环收尾 */
+    MG58F18_RADAR_SLOT_FAILED      /**< 发送失败，error 中为原因 */
+} mg58f18_radar_slot_state_t;
+
+/**
+ * @brief 异步队列中的一条命令。
+ */
+typedef struct
+{
+    uint8_t tx[MG58F18_RADAR_FRAME_SIZE];     /**< 已组好的发送帧 */
+    bool expect_echo;                         /**< 是否校验回显 */
+    volatile uint8_t state;                   /**< mg58f18_radar_slot_state_t */
+    uint32_t timeout_ms;                      /**< 应答超时 */
+    uint32_t sent_tick;                       /**< 发出时刻 */
+    mg58f18_radar_status_t error;             /**< 发送失败原因 */
+    mg58f18_radar_frame_t reply;              /**< 匹配到的应答 */
+    mg58f18_radar_future_t *future;           /**< 结果句柄，可为 NULL */
+} mg58f18_radar_slot_t;
 
 /**
  * @brief 协议核心状态：记录收发上下文、解析状态机和最新帧。
@@ -27,9 +54,18 @@ typedef struct
     mg58f18_radar_frame_t last_frame;  /**< 最近收到的有效帧 */
     struct
     {
-        uint8_t buffer[MG58F18_RADAR_FRAME_SIZE]; /**< 接收缓冲 */
-        uint8_t index;                            /**< 当前写入位置 */
+        uint8_t buffer[MG58F18_RADAR_FRAME_SIZE]; /**< 滑动窗口，buffer[0] 恒为帧头 */
+        uint8_t index;                            /**< 窗口内已有字节数 */
     } parser;
+    mg58f18_radar_parser_stats_t stats;       /**< 解析统计 */
+    struct
+    {
+        mg58f18_radar_slot_t slots[MG58F18_RADAR_ASYNC_QUEUE_DEPTH];
+        volatile uint32_t head;                   /**< 下一个入队位置 */
+        volatile uint32_t next;                   /**< 下一条待发送 */
+        volatile uint32_t tail;                   /**< 最早一条未结束 */
+        uint32_t last_tx_tick;                    /**< 最近一次发送时刻，用于帧间隔 */
+    } async;
 } mg58f18_radar_core_t;
 
 static mg58f18_radar_core_t s_core;
@@ -46,15 +82,6 @@ static inline uint8_t mg58f18_radar_compute_checksum(uint8_t command,
     return (uint8_t)(command ^ data2 ^ data3 ^ data4);
 }
 
-/**
- * @brief 清空解析状态机。
- */
-static void mg58f18_radar_core_reset_parser(mg58f18_radar_core_t *ctx)
-{
-    ctx->parser.index = 0U;
-    memset(ctx->parser.buffer, 0, sizeof(ctx->parser.buffer));
-}
-
 /**
  * @brief 将解析到的原始帧搬运到对外可读结构体。
  */
@@ -107,58 +134,91 @@ static void mg58f18_radar_core_mark_timeout(mg58f18_radar_core_t *ctx)
 }
 
 /**
- * @brief 单字节推进解析状态机，识别完整帧并校验。
+ * @brief 在已发出的异步命令中查找命令码相同的一条并记录应答（解析上下文调用）。
+ * @return 匹配成功返回 true。
  */
-static mg58f18_radar_status_t mg58f18_radar_core_process_byte(mg58f18_radar_core_t *ctx, uint8_t byte)
+static bool mg58f18_radar_async_match(mg58f18_radar_core_t *ctx, const mg58f18_radar_frame_t *frame)
 {
-    if (ctx->parser.index == 0U)
+    for (uint32_t i = ctx->async.tail; i != ctx->async.next; ++i)
     {
-        if (byte != MG58F18_RADAR_HEAD_BYTE)
+        mg58f18_radar_slot_t *slot = &ctx->async.slots[i & MG58F18_RADAR_ASYNC_MASK];
+
+        if (slot->state == MG58F18_RADAR_SLOT_SENT && slot->tx[1] == frame->command)
         {
-            return ctx->last_error;
+            slot->reply = *frame;
+            slot->state = MG58F18_RADAR_SLOT_REPLIED;
+            return true;
         }
-        ctx->parser.buffer[ctx->parser.index++] = byte;
-        return ctx->last_error;
     }
+    return false;
+}
 
-    ctx->parser.buffer[ctx->parser.index++] = byte;
-    if (ctx->parser.index < MG58F18_RADAR_FRAME_SIZE)
+/**
+ * @brief 判断窗口内的 7 字节是否构成合法帧（帧头、校验和、帧尾）。
+ */
+static bool mg58f18_radar_core_frame_valid(const uint8_t buffer[MG58F18_RADAR_FRAME_SIZE])
+{
+    const uint8_t checksum = mg58f18_radar_compute_checksum(buffer[1], buffer[2], buffer[3], buffer[4]);
+
+    return (buffer[0] == MG58F18_RADAR_HEAD_BYTE)
+        && (checksum == buffer[MG58F18_RADAR_CHECKSUM_INDEX])
+        && (buffer[MG58F18_RADAR_TAIL_INDEX] == MG58F18_RADAR_TAIL_BYTE);
+}
+
+/**
+ * @brief 校验失败后滑动窗口：丢弃当前帧头，从窗口内下一个 5A 处重新对齐。
+ *
+ * 窗口内剩余字节原样保留，因此无论噪声插入在哪个偏移，紧随其后的真实帧都不会丢失。
+ */
+static void mg58f18_radar_core_resync(mg58f18_radar_core_t *ctx)
+{
+    uint8_t offset = 1U;
+
+    while ((offset < ctx->parser.index) && (ctx->parser.buffer[offset] != MG58F18_RADAR_HEAD_BYTE))
     {
-        return ctx->last_error;
+        ++offset;
     }
 
-    const uint8_t checksum = mg58f18_radar_compute_checksum(ctx->parser.buffer[1],
-                                                            ctx->parser.buffer[2],
-                                                            ctx->parser.buffer[3],
-                                                            ctx->parser.buffer[4]);
-    const bool checksum_ok = (checksum == ctx->parser.buffer[MG58F18_RADAR_CHECKSUM_INDEX]);
-    const bool tail_ok     = (ctx->parser.buffer[MG58F18_RADAR_TAIL_INDEX] == MG58F18_RADAR_TAIL_BYTE);
+    ctx->stats.dropped_bytes += offset;
+    ctx->parser.index = (uint8_t)(ctx->parser.index - offset);
+    memmove(ctx->parser.buffer, &ctx->parser.buffer[offset], ctx->parser.index);
+}
 
-    if (checksum_ok && tail_ok)
+/**
+ * @brief 单字节推进解析状态机，识别完整帧并校验。
+ */
+static mg58f18_radar_status_t mg58f18_radar_core_process_byte(mg58f18_radar_core_t *ctx, uint8_t byte)
+{
+    if ((ctx->parser.index == 0U) && (byte != MG58F18_RADAR_HEAD_BYTE))
     {
-        mg58f18_radar_core_store_frame(ctx, ctx->parser.buffer);
+        ++ctx->stats.dropped_bytes;
+        return ctx->last_error;
+    }
 
-        if (ctx->awaiting_reply && ctx->last_frame.command == ctx->pending_command)
-        {
-            ctx->awaiting_reply = false;
-            ctx->last_error     = MG58F18_RADAR_STATUS_OK;
-        }
-        else
-        {
-            ctx->last_error = MG58F18_RADAR_STATUS_OK;
-        }
+    ctx->parser.buffer[ctx->parser.index++] = byte;
+    if (ctx->parser.index < MG58F18_RADAR_FRAME_SIZE)
+    {
+        return ctx->last_error;
     }
-    else
+
+    if (!mg58f18_radar_core_frame_valid(ctx->parser.buffer))
     {
+        ++ctx->stats.frame_errors;
         ctx->last_error = MG58F18_RADAR_STATUS_FRAME_ERROR;
+        mg58f18_radar_core_resync(ctx);
+        return ctx->last_error;
     }
 
-    const bool restart = (ctx->parser.buffer[MG58F18_RADAR_TAIL_INDEX] == MG58F18_RADAR_HEAD_BYTE);
-    mg58f18_radar_core_reset_parser(ctx);
-    if (restart)
+    ++ctx->stats.frames;
+    mg58f18_radar_core_store_frame(ctx, ctx->parser.buffer);
+    ctx->parser.index = 0U;
+    ctx->last_error   = MG58F18_RADAR_STATUS_OK;
+
+    /* 先匹配异步队列中已发出的命令，再匹配同步事务 */
+    if (!mg58f18_radar_async_match(ctx, &ctx->last_frame)
+        && ctx->awaiting_reply && ctx->last_frame.command == ctx->pending_command)
     {
-        ctx->parser.buffer[0] = MG58F18_RADAR_HEAD_BYTE;
-        ctx->parser.index     = 1U;
+        ctx->awaiting_reply = false;
     }
     return ctx->last_error;
 }
@@ -227,6 +287,11 @@ static mg58f18_radar_status_t mg58f18_radar_send_command_raw(uint8_t command,
     {
         return MG58F18_RADAR_STATUS_NOT_INITIALISED;
     }
+    if (!mg58f18_radar_async_idle())
+    {
+        /* 异步队列占用串口期间不允许插入同步事务 */
+        return MG58F18_RADAR_STATUS_BUSY;
+    }
 
     uint8_t frame[MG58F18_RADAR_FRAME_SIZE];
     frame[0] = MG58F18_RADAR_HEAD_BYTE;
@@ -1003,6 +1068,277 @@ const char *mg58f18_radar_status_string(mg58f18_radar_status_t status)
     }
 }
 
+/**
+ * @brief 读取解析器统计信息。
+ */
+void mg58f18_radar_get_parser_stats(mg58f18_radar_parser_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_core.stats;
+    }
+}
+
+/**
+ * @brief 初始化 future。
+ */
+void mg58f18_radar_future_init(mg58f18_radar_future_t *future,
+                               mg58f18_radar_async_callback_t callback,
+                               void *ctx)
+{
+    if (future == NULL)
+    {
+        return;
+    }
+    memset(future, 0, sizeof(*future));
+    future->status   = MG58F18_RADAR_STATUS_BUSY;
+    future->callback = callback;
+    future->ctx      = ctx;
+}
+
+/**
+ * @brief 组帧并加入异步队列。
+ */
+mg58f18_radar_status_t mg58f18_radar_async_submit(uint8_t command,
+                                                  uint8_t data2,
+                                                  uint8_t data3,
+                                                  uint8_t data4,
+                                                  bool expect_echo,
+                                                  uint32_t timeout_ms,
+                                                  mg58f18_radar_future_t *future)
+{
+    if (!s_initialised)
+    {
+        return MG58F18_RADAR_STATUS_NOT_INITIALISED;
+    }
+    if ((s_core.async.head - s_core.async.tail) >= MG58F18_RADAR_ASYNC_QUEUE_DEPTH)
+    {
+        return MG58F18_RADAR_STATUS_BUSY;
+    }
+
+    mg58f18_radar_slot_t *slot = &s_core.async.slots[s_core.async.head & MG58F18_RADAR_ASYNC_MASK];
+    slot->tx[0] = MG58F18_RADAR_HEAD_BYTE;
+    slot->tx[1] = command;
+    slot->tx[2] = data2;
+    slot->tx[3] = data3;
+    slot->tx[4] = data4;
+    slot->tx[MG58F18_RADAR_CHECKSUM_INDEX] = mg58f18_radar_compute_checksum(command, data2, data3, data4);
+    slot->tx[MG58F18_RADAR_TAIL_INDEX]     = MG58F18_RADAR_TAIL_BYTE;
+    slot->expect_echo = expect_echo;
+    slot->timeout_ms  = (timeout_ms == 0U) ? MG58F18_RADAR_DEFAULT_TIMEOUT_MS : timeout_ms;
+    slot->future      = future;
+    slot->state       = MG58F18_RADAR_SLOT_QUEUED;
+    if (future != NULL)
+    {
+        future->done   = false;
+        future->status = MG58F18_RADAR_STATUS_BUSY;
+    }
+
+    ++s_core.async.head;
+    return MG58F18_RADAR_STATUS_OK;
+}
+
+/**
+ * @brief 异步查询。
+ */
+mg58f18_radar_status_t mg58f18_radar_async_query(mg58f18_radar_command_t command,
+                                                 mg58f18_radar_future_t *future)
+{
+    return mg58f18_radar_async_submit((uint8_t)command, 0x00U, 0x00U, 0x00U, false, 0U, future);
+}
+
+/**
+ * @brief 异步设置感应距离阈值。
+ */
+mg58f18_radar_status_t mg58f18_radar_async_set_distance_threshold(uint16_t threshold,
+                                                                  mg58f18_radar_future_t *future)
+{
+    if (threshold < 100U || threshold > 65000U)
+    {
+        return MG58F18_RADAR_STATUS_INVALID_ARGUMENT;
+    }
+    return mg58f18_radar_async_submit(MG58F18_RADAR_CMD_SET_DISTANCE_THRESHOLD,
+                                      0x00U,
+                                      (uint8_t)((threshold >> 8) & 0xFFU),
+                                      (uint8_t)(threshold & 0xFFU),
+                                      true,
+                                      0U,
+                                      future);
+}
+
+/**
+ * @brief 异步设置输出保持/延迟时间（ms）。
+ */
+mg58f18_radar_status_t mg58f18_radar_async_set_delay_ms(uint32_t delay_ms, mg58f18_radar_future_t *future)
+{
+    if (delay_ms > (0xFFFFFFUL / MG58F18_RADAR_DELAY_SCALER))
+    {
+        return MG58F18_RADAR_STATUS_INVALID_ARGUMENT;
+    }
+    const uint32_t value = delay_ms * MG58F18_RADAR_DELAY_SCALER;
+    return mg58f18_radar_async_submit(MG58F18_RADAR_CMD_SET_DELAY_TIME,
+                                      (uint8_t)((value >> 16) & 0xFFU),
+                                      (uint8_t)((value >> 8) & 0xFFU),
+                                      (uint8_t)(value & 0xFFU),
+                                      true,
+                                      0U,
+                                      future);
+}
+
+/**
+ * @brief 异步设置光感是否参与触发。
+ */
+mg58f18_radar_status_t mg58f18_radar_async_set_light_sensor_enabled(bool enable,
+                                                                    mg58f18_radar_future_t *future)
+{
+    return mg58f18_radar_async_submit(MG58F18_RADAR_CMD_SET_LIGHT_SENSOR_ENABLE,
+                                      0x00U,
+                                      0x00U,
+                                      enable ? 0x01U : 0x00U,
+                                      true,
+                                      0U,
+                                      future);
+}
+
+/**
+ * @brief 异步设置屏蔽时间（ms）。
+ */
+mg58f18_radar_status_t mg58f18_radar_async_set_block_time_ms(uint32_t block_time_ms,
+                                                             mg58f18_radar_future_t *future)
+{
+    if (block_time_ms > (0xFFFFFFUL / MG58F18_RADAR_DELAY_SCALER))
+    {
+        return MG58F18_RADAR_STATUS_INVALID_ARGUMENT;
+    }
+    const uint32_t value = block_time_ms * MG58F18_RADAR_DELAY_SCALER;
+    return mg58f18_radar_async_submit(MG58F18_RADAR_CMD_SET_BLOCK_TIME,
+                                      (uint8_t)((value >> 16) & 0xFFU),
+                                      (uint8_t)((value >> 8) & 0xFFU),
+                                      (uint8_t)(value & 0xFFU),
+                                      true,
+                                      0U,
+                                      future);
+}
+
+/**
+ * @brief 判断是否已有同命令码的命令在途（应答只能按命令码区分）。
+ */
+static bool mg58f18_radar_async_command_in_flight(uint8_t command)
+{
+    for (uint32_t i = s_core.async.tail; i != s_core.async.next; ++i)
+    {
+        const mg58f18_radar_slot_t *slot = &s_core.async.slots[i & MG58F18_RADAR_ASYNC_MASK];
+        if (slot->state == MG58F18_RADAR_SLOT_SENT && slot->tx[1] == command)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 结束一条命令：写 future 并执行回调。
+ */
+static void mg58f18_radar_async_complete(mg58f18_radar_slot_t *slot, mg58f18_radar_status_t status)
+{
+    mg58f18_radar_future_t *future = slot->future;
+
+    if (future == NULL)
+    {
+        return;
+    }
+    future->reply  = slot->reply;
+    future->status = status;
+    future->done   = true;
+    if (future->callback != NULL)
+    {
+        future->callback(future, future->ctx);
+    }
+}
+
+/**
+ * @brief 推进异步队列。
+ */
+void mg58f18_radar_async_process(void)
+{
+    if (!s_initialised)
+    {
+        return;
+    }
+
+    const uint32_t now = mg58f18_radar_interface_hw_get_tick();
+
+    /* 发送：窗口未满、帧间隔已到、同命令码不在途时发出下一条 */
+    if (s_core.async.next != s_core.async.head
+        && (s_core.async.next - s_core.async.tail) < MG58F18_RADAR_ASYNC_WINDOW
+        && (now - s_core.async.last_tx_tick) >= MG58F18_RADAR_ASYNC_GAP_MS
+        && mg58f18_radar_interface_hw_tx_idle())
+    {
+        mg58f18_radar_slot_t *slot = &s_core.async.slots[s_core.async.next & MG58F18_RADAR_ASYNC_MASK];
+
+        if (!mg58f18_radar_async_command_in_flight(slot->tx[1]))
+        {
+            slot->sent_tick = now;
+            slot->state     = MG58F18_RADAR_SLOT_SENT;
+            ++s_core.async.next;
+            const mg58f18_radar_status_t status =
+                mg58f18_radar_interface_hw_send_async(slot->tx, MG58F18_RADAR_FRAME_SIZE);
+            if (status == MG58F18_RADAR_STATUS_OK)
+            {
+                s_core.async.last_tx_tick = now;
+            }
+            else
+            {
+                /* 发送失败：以该状态结束，由下面的收尾流程出队 */
+                slot->error = status;
+                slot->state = MG58F18_RADAR_SLOT_FAILED;
+            }
+        }
+    }
+
+    /* 收尾：按提交顺序结束已应答或已超时的命令 */
+    while (s_core.async.tail != s_core.async.next)
+    {
+        mg58f18_radar_slot_t *slot = &s_core.async.slots[s_core.async.tail & MG58F18_RADAR_ASYNC_MASK];
+        mg58f18_radar_status_t status;
+
+        if (slot->state == MG58F18_RADAR_SLOT_REPLIED)
+        {
+            status = MG58F18_RADAR_STATUS_OK;
+            if (slot->expect_echo
+                && (slot->reply.data2 != slot->tx[2] || slot->reply.data3 != slot->tx[3]
+                    || slot->reply.data4 != slot->tx[4]))
+            {
+                status = MG58F18_RADAR_STATUS_FRAME_ERROR;
+            }
+        }
+        else if (slot->state == MG58F18_RADAR_SLOT_FAILED)
+        {
+            status = slot->error;
+        }
+        else if ((now - slot->sent_tick) > slot->timeout_ms)
+        {
+            /* 出队后解析器不再扫描该槽位，截止时刻之后才到的应答按超时处理 */
+            status = MG58F18_RADAR_STATUS_TIMEOUT;
+        }
+        else
+        {
+            break;
+        }
+
+        ++s_core.async.tail;
+        mg58f18_radar_async_complete(slot, status);
+    }
+}
+
+/**
+ * @brief 异步队列是否空闲。
+ */
+bool mg58f18_radar_async_idle(void)
+{
+    return (s_core.async.head == s_core.async.tail);
+}
+
 /**
  * @brief 串口 DMA/中断回调中调用，向协议层灌入收到的字节流。
  */
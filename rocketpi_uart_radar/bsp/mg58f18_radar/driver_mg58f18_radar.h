@@ -23,6 +23,20 @@ extern "C" {
 #define MG58F18_RADAR_RX_BUFFER_SIZE        64U  /**< DMA 接收环形缓冲区大小 */
 #define MG58F18_RADAR_DEFAULT_TIMEOUT_MS    150U /**< 发送等待应答的默认超时（毫秒） */
 
+#ifndef MG58F18_RADAR_ASYNC_QUEUE_DEPTH
+#define MG58F18_RADAR_ASYNC_QUEUE_DEPTH     8U   /**< 异步命令队列深度，必须为 2 的幂 */
+#endif
+#ifndef MG58F18_RADAR_ASYNC_WINDOW
+#define MG58F18_RADAR_ASYNC_WINDOW          4U   /**< 同时在途（已发出未应答）的命令数上限 */
+#endif
+#ifndef MG58F18_RADAR_ASYNC_GAP_MS
+#define MG58F18_RADAR_ASYNC_GAP_MS          10U  /**< 相邻两帧发送的最小间隔（毫秒） */
+#endif
+
+#if (MG58F18_RADAR_ASYNC_QUEUE_DEPTH & (MG58F18_RADAR_ASYNC_QUEUE_DEPTH - 1U)) != 0U
+#error "MG58F18_RADAR_ASYNC_QUEUE_DEPTH 必须为 2 的幂"
+#endif
+
 typedef enum
 {
     MG58F18_RADAR_CMD_SET_DISTANCE_THRESHOLD       = 0x01, /**< 设置感应距离阈值，Data3/Data4=高/低 8 位 */
@@ -78,6 +92,35 @@ typedef struct
     uint8_t checksum;                      /**< 校验和（cmd^data2^data3^data4） */
 } mg58f18_radar_frame_t;
 
+/**
+ * @brief 解析器统计：用于观察线路噪声与重同步情况。
+ */
+typedef struct
+{
+    uint32_t frames;        /**< 校验通过的帧数 */
+    uint32_t frame_errors;  /**< 7 字节窗口校验/帧尾失败次数（每次都会滑窗重同步） */
+    uint32_t dropped_bytes; /**< 为重新对齐而丢弃的字节数 */
+} mg58f18_radar_parser_stats_t;
+
+struct mg58f18_radar_future;
+
+/**
+ * @brief 异步命令完成回调，在 mg58f18_radar_async_process() 的调用上下文中执行。
+ */
+typedef void (*mg58f18_radar_async_callback_t)(struct mg58f18_radar_future *future, void *ctx);
+
+/**
+ * @brief 异步命令的结果句柄（future），由调用者分配，完成前必须保持有效。
+ */
+typedef struct mg58f18_radar_future
+{
+    volatile bool done;                      /**< 命令已结束（成功、超时或校验失败） */
+    volatile mg58f18_radar_status_t status;  /**< 结束状态 */
+    mg58f18_radar_frame_t reply;             /**< 模组应答帧（status 为 OK 时有效） */
+    mg58f18_radar_async_callback_t callback; /**< 可选回调 */
+    void *ctx;                               /**< 回调上下文 */
+} mg58f18_radar_future_t;
+
 /**
  * @brief 初始化雷达协议栈并启动 DMA 接收（默认使用 USART1）。
  */
@@ -182,6 +225,10 @@ mg58f18_radar_status_t mg58f18_radar_read_io(bool *active);
  * @brief 拉取最新一帧应答数据（有则拷贝到 @p frame 并消费）。
  */
 bool mg58f18_radar_fetch_frame(mg58f18_radar_frame_t *frame);
+/**
+ * @brief 按协议拼出 24bit 整数（Data2 为高 8 位）。
+ */
+uint32_t mg58f18_radar_frame_get_u24(const mg58f18_radar_frame_t *frame);
 /**
  * @brief 以人类可读格式打印一帧应答。
  */
@@ -195,6 +242,66 @@ void mg58f18_radar_poll_and_print(void);
  */
 const char *mg58f18_radar_status_string(mg58f18_radar_status_t status);
 
+/**
+ * @brief 读取解析器统计信息。
+ */
+void mg58f18_radar_get_parser_stats(mg58f18_radar_parser_stats_t *stats);
+
+/**
+ * @brief 初始化 future，可选绑定完成回调。
+ */
+void mg58f18_radar_future_init(mg58f18_radar_future_t *future,
+                               mg58f18_radar_async_callback_t callback,
+                               void *ctx);
+
+/**
+ * @brief 将任意命令加入异步队列，立即返回。
+ *
+ * 队列中的命令按顺序发出，最多 MG58F18_RADAR_ASYNC_WINDOW 条同时在途，
+ * 应答按命令码匹配；每条命令独立计时，超时只影响自身。
+ *
+ * @param expect_echo true 时要求应答载荷与发送载荷一致（参数写入校验）。
+ * @param timeout_ms  自发出起等待应答的时间，0 表示使用默认值。
+ * @param future      结果句柄，可为 NULL（不关心结果）。
+ * @return 队列已满返回 MG58F18_RADAR_STATUS_BUSY。
+ */
+mg58f18_radar_status_t mg58f18_radar_async_submit(uint8_t command,
+                                                  uint8_t data2,
+                                                  uint8_t data3,
+                                                  uint8_t data4,
+                                                  bool expect_echo,
+                                                  uint32_t timeout_ms,
+                                                  mg58f18_radar_future_t *future);
+
+/**
+ * @brief 异步查询：发送载荷全 0 的查询命令，结果在 future->reply 中。
+ */
+mg58f18_radar_status_t mg58f18_radar_async_query(mg58f18_radar_command_t command,
+                                                 mg58f18_radar_future_t *future);
+
+/**
+ * @brief 常用配置项的异步写入（参数范围与同步接口一致，应答需回显）。
+ */
+mg58f18_radar_status_t mg58f18_radar_async_set_distance_threshold(uint16_t threshold,
+                                                                  mg58f18_radar_future_t *future);
+mg58f18_radar_status_t mg58f18_radar_async_set_delay_ms(uint32_t delay_ms,
+                                                        mg58f18_radar_future_t *future);
+mg58f18_radar_status_t mg58f18_radar_async_set_light_sensor_enabled(bool enable,
+                                                                    mg58f18_radar_future_t *future);
+mg58f18_radar_status_t mg58f18_radar_async_set_block_time_ms(uint32_t block_time_ms,
+                                                             mg58f18_radar_future_t *future);
+
+/**
+ * @brief 推进异步队列：发出下一条命令、判定超时、结束已应答的命令并执行回调。
+ *        在主循环中周期调用。
+ */
+void mg58f18_radar_async_process(void);
+
+/**
+ * @brief 异步队列为空且没有在途命令时返回 true。
+ */
+bool mg58f18_radar_async_idle(void);
+
 /**
  * @brief DMA 回调向协议层馈入收到的字节流。
  */
@@ -121,6 +121,42 @@ mg58f18_radar_status_t mg58f18_radar_interface_hw_send(const uint8_t *data,
     return MG58F18_RADAR_STATUS_OK;
 }
 
+mg58f18_radar_status_t mg58f18_radar_interface_hw_send_async(const uint8_t *data, size_t length)
+{
+    if (!s_hal.initialised || s_hal.uart == NULL || data == NULL || length == 0U)
+    {
+        return MG58F18_RADAR_STATUS_NOT_INITIALISED;
+    }
+
+    if (length > sizeof(s_hal.tx_buffer))
+    {
+        return MG58F18_RADAR_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (s_hal.tx_busy)
+    {
+        return MG58F18_RADAR_STATUS_BUSY;
+    }
+
+    memcpy(s_hal.tx_buffer, data, length);
+
+    s_hal.tx_busy = true;
+    const HAL_StatusTypeDef hal_status =
+        HAL_UART_Transmit_DMA(s_hal.uart, s_hal.tx_buffer, (uint16_t)length);
+    if (hal_status != HAL_OK)
+    {
+        s_hal.tx_busy = false;
+        return (hal_status == HAL_BUSY) ? MG58F18_RADAR_STATUS_BUSY : MG58F18_RADAR_STATUS_HAL_ERROR;
+    }
+
+    return MG58F18_RADAR_STATUS_OK;
+}
+
+bool mg58f18_radar_interface_hw_tx_idle(void)
+{
+    return !s_hal.tx_busy;
+}
+
 uint32_t mg58f18_radar_interface_hw_get_tick(void)
 {
     return HAL_GetTick();
@@ -29,6 +29,14 @@ mg58f18_radar_status_t mg58f18_radar_interface_hw_init(void);
 mg58f18_radar_status_t mg58f18_radar_interface_hw_send(const uint8_t *data,
                                                        size_t length,
                                                        uint32_t timeout_ms);
+/**
+ * @brief 启动一帧 DMA 发送后立即返回，DMA 正忙时返回 MG58F18_RADAR_STATUS_BUSY。
+ */
+mg58f18_radar_status_t mg58f18_radar_interface_hw_send_async(const uint8_t *data, size_t length);
+/**
+ * @brief 查询 DMA 发送是否空闲。
+ */
+bool mg58f18_radar_interface_hw_tx_idle(void);
 /**
  * @brief 获取毫秒滴答，用于等待/超时判断。
  */
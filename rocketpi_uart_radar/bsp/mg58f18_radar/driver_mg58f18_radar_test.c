@@ -261,11 +261,82 @@ void mg58f18_radar_test_run(void)
     printf("=== MG58F18 radar smoke test done ===\r\n");
 }
 
+/**
+ * @brief 推进异步队列直到全部命令结束（演示用，期间不再逐条忙等应答）。
+ */
+static void mg58f18_radar_test_async_drain(void)
+{
+    while (!mg58f18_radar_async_idle())
+    {
+        mg58f18_radar_async_process();
+    }
+}
+
+/**
+ * @brief 流水线方式读回并写入 阈值 + 延迟 + 光感 + 屏蔽时间 四项配置。
+ */
+void mg58f18_radar_test_async_run(void)
+{
+    static const mg58f18_radar_command_t queries[] = {
+        MG58F18_RADAR_CMD_QUERY_DISTANCE_THRESHOLD,
+        MG58F18_RADAR_CMD_QUERY_DELAY_TIME,
+        MG58F18_RADAR_CMD_QUERY_LIGHT_SENSOR_ENABLE,
+        MG58F18_RADAR_CMD_QUERY_BLOCK_TIME,
+    };
+    mg58f18_radar_future_t get[4];
+    mg58f18_radar_future_t set[4];
+    const uint32_t start = HAL_GetTick();
+
+    printf("\r\n=== MG58F18 radar async pipeline ===\r\n");
+
+    for (size_t i = 0U; i < 4U; ++i)
+    {
+        mg58f18_radar_future_init(&get[i], NULL, NULL);
+        (void)mg58f18_radar_async_query(queries[i], &get[i]);
+    }
+    mg58f18_radar_test_async_drain();
+
+    for (size_t i = 0U; i < 4U; ++i)
+    {
+        if (get[i].status != MG58F18_RADAR_STATUS_OK)
+        {
+            printf("[RADAR][async] query 0x%02X: %s\r\n", queries[i], mg58f18_radar_status_string(get[i].status));
+            return;
+        }
+        mg58f18_radar_future_init(&set[i], NULL, NULL);
+    }
+
+    const uint16_t threshold = (uint16_t)(((uint16_t)get[0].reply.data3 << 8) | get[0].reply.data4);
+    const uint32_t delay_ms  = mg58f18_radar_frame_get_u24(&get[1].reply) / 32U;
+    const bool light_enabled = (get[2].reply.data4 == 0x01U);
+    const uint32_t block_ms  = mg58f18_radar_frame_get_u24(&get[3].reply) / 32U;
+
+    (void)mg58f18_radar_async_set_distance_threshold(threshold, &set[0]);
+    (void)mg58f18_radar_async_set_delay_ms(delay_ms, &set[1]);
+    (void)mg58f18_radar_async_set_light_sensor_enabled(light_enabled, &set[2]);
+    (void)mg58f18_radar_async_set_block_time_ms(block_ms, &set[3]);
+    mg58f18_radar_test_async_drain();
+
+    mg58f18_radar_test_print_status("async set_distance_threshold", set[0].status);
+    mg58f18_radar_test_print_status("async set_delay_ms", set[1].status);
+    mg58f18_radar_test_print_status("async set_light_sensor_enabled", set[2].status);
+    mg58f18_radar_test_print_status("async set_block_time_ms", set[3].status);
+
+    mg58f18_radar_parser_stats_t stats;
+    mg58f18_radar_get_parser_stats(&stats);
+    printf("[RADAR][async] 8 commands in %lu ms, frames=%lu errors=%lu dropped=%lu\r\n",
+           (unsigned long)(HAL_GetTick() - start),
+           (unsigned long)stats.frames,
+           (unsigned long)stats.frame_errors,
+           (unsigned long)stats.dropped_bytes);
+}
+
 /**
  * @brief 周期调用：打印串口收到的帧并监视 OUT 引脚跳变。
  */
 void mg58f18_radar_test_poll(void)
 {
+    mg58f18_radar_async_process();
     mg58f18_radar_poll_and_print();
 
     static bool io_state_initialised = false;
@@ -12,6 +12,8 @@ extern "C" {
 
 /** 执行一轮完整的协议交互测试并打印结果。 */
 void mg58f18_radar_test_run(void);
+/** 以异步队列流水线方式读写常用配置（阈值/延迟/光感/屏蔽时间）。 */
+void mg58f18_radar_test_async_run(void);
 /** 持续轮询并打印串口数据与 OUT 引脚变化。 */
 void mg58f18_radar_test_poll(void);
 
@@ -18,20 +18,25 @@
 /* USER CODE END Header */
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "dma.h"
 #include "usart.h"
 #include "gpio.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "microrl.h"
+#include "uart_tx.h"
 #include <string.h>
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
+typedef int (*shell_cmd_handler_t)(int argc, const char * const * argv);
+
 typedef struct {
   const char *name;
   const char *description;
+  shell_cmd_handler_t handler;
 } shell_cmd_desc_t;
 
 typedef struct {
@@ -47,6 +52,8 @@ typedef struct {
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 #define LED_ON_STATE GPIO_PIN_RESET
 #define LED_OFF_STATE GPIO_PIN_SET
+/* 注册一条命令：kShellCmdTable 必须按名称的 strcmp 顺序排列 */
+#define SHELL_CMD(name, description, handler) {(name), (description), (handler)}
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -55,18 +62,26 @@ typedef struct {
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
+static int shell_cmd_echo(int argc, const char * const * argv);
+static int shell_cmd_help(int argc, const char * const * argv);
+static int shell_cmd_led(int argc, const char * const * argv);
+static int shell_cmd_version(int argc, const char * const * argv);
+
 static microrl_t s_shell;
 static uint8_t s_uart2_rx;
 static volatile uint8_t s_shell_rx_buffer[SHELL_RX_BUFFER_SIZE];
 static volatile uint16_t s_shell_rx_head;
 static volatile uint16_t s_shell_rx_tail;
 
+/* 命令查找与 TAB 补全共用此表，均为二分查找 */
 static const shell_cmd_desc_t kShellCmdTable[] = {
-  {"help", "List available commands"},
-  {"version", "Show shell information"},
-  {"echo", "Echo back the provided text"},
-  {"led", "Control on-board LEDs"},
+  SHELL_CMD("echo", "Echo back the provided text", shell_cmd_echo),
+  SHELL_CMD("help", "List available commands", shell_cmd_help),
+  SHELL_CMD("led", "Control on-board LEDs", shell_cmd_led),
+  SHELL_CMD("version", "Show shell information", shell_cmd_version),
 };
+/* 启动时校验表的顺序，未排序时退化为顺序查找 */
+static uint8_t s_shell_cmd_sorted;
 
 static const led_desc_t kLedTable[] = {
   {"blue", LED_B_GPIO_Port, LED_B_Pin},
@@ -88,7 +103,9 @@ static void shell_start_rx(void);
 static void shell_queue_char(uint8_t value);
 static void shell_process_input(void);
 static int shell_execute(int argc, const char * const * argv);
-static int shell_cmd_led(int argc, const char * const * argv);
+static void shell_check_cmd_table(void);
+static size_t shell_cmd_lower_bound(const char *name, size_t len);
+static const shell_cmd_desc_t *shell_find_cmd(const char *name);
 static void shell_print_led_usage(void);
 static int shell_str_casecmp(const char *lhs, const char *rhs);
 static const led_desc_t *shell_find_led(const char *name);
@@ -99,22 +116,10 @@ static char **shell_complete(int argc, const char * const * argv);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-/* 通过 USART2 输出字符串（LF 自动转换为 CRLF） */
+/* 通过 USART2 DMA 发送缓冲输出字符串（LF 自动转换为 CRLF） */
 static void shell_print(const char *str)
 {
-  if ((str == NULL) || (huart2.gState == HAL_UART_STATE_RESET)) {
-    return;
-  }
-  while (*str != '\0') {
-    if (*str == '\n') {
-      const uint8_t newline[2] = {'\r', '\n'};
-      HAL_UART_Transmit(&huart2, (uint8_t *)newline, sizeof(newline), HAL_MAX_DELAY);
-    } else {
-      uint8_t ch = (uint8_t)(*str);
-      HAL_UART_Transmit(&huart2, &ch, 1, HAL_MAX_DELAY);
-    }
-    str++;
-  }
+  uart_tx_puts(str);
 }
 
 /* 打印一行文本并追加换行 */
@@ -168,45 +173,65 @@ static void shell_process_input(void)
   }
 }
 
-/* microrl 执行回调，根据命令执行功能 */
-static int shell_execute(int argc, const char * const * argv)
+/* 检查命令表是否按名称排序 */
+static void shell_check_cmd_table(void)
 {
-  if (argc <= 0) {
-    return 0;
+  s_shell_cmd_sorted = 1U;
+  for (size_t i = 1; i < ARRAY_SIZE(kShellCmdTable); ++i) {
+    if (strcmp(kShellCmdTable[i - 1U].name, kShellCmdTable[i].name) >= 0) {
+      s_shell_cmd_sorted = 0U;
+      shell_print("Command table not sorted at: ");
+      shell_print_line(kShellCmdTable[i].name);
+      return;
+    }
   }
+}
 
-  if (strcmp(argv[0], "help") == 0) {
-    shell_print_line("Available commands:");
-    for (size_t i = 0; i < ARRAY_SIZE(kShellCmdTable); ++i) {
-      shell_print("  ");
-      shell_print(kShellCmdTable[i].name);
-      shell_print(" - ");
-      shell_print(kShellCmdTable[i].description);
-      shell_print(ENDL);
+/* 返回第一个前 len 个字符不小于 name 的表项下标 */
+static size_t shell_cmd_lower_bound(const char *name, size_t len)
+{
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(kShellCmdTable);
+
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2U;
+    if (strncmp(kShellCmdTable[mid].name, name, len) < 0) {
+      lo = mid + 1U;
+    } else {
+      hi = mid;
     }
-    return 0;
   }
+  return lo;
+}
 
-  if (strcmp(argv[0], "version") == 0) {
-    shell_print("microrl ");
-    shell_print(MICRORL_LIB_VER);
-    shell_print_line(" on USART2 (115200 8N1)");
-    return 0;
+/* 在命令表中查找命令 */
+static const shell_cmd_desc_t *shell_find_cmd(const char *name)
+{
+  if (s_shell_cmd_sorted != 0U) {
+    size_t i = shell_cmd_lower_bound(name, strlen(name) + 1U);
+    if ((i < ARRAY_SIZE(kShellCmdTable)) && (strcmp(kShellCmdTable[i].name, name) == 0)) {
+      return &kShellCmdTable[i];
+    }
+    return NULL;
   }
-
-  if (strcmp(argv[0], "echo") == 0) {
-    for (int i = 1; i < argc; ++i) {
-      shell_print(argv[i]);
-      if (i < (argc - 1)) {
-        shell_print(" ");
-      }
+  for (size_t i = 0; i < ARRAY_SIZE(kShellCmdTable); ++i) {
+    if (strcmp(kShellCmdTable[i].name, name) == 0) {
+      return &kShellCmdTable[i];
     }
-    shell_print(ENDL);
+  }
+  return NULL;
+}
+
+/* microrl 执行回调，查表执行命令 */
+static int shell_execute(int argc, const char * const * argv)
+{
+  if (argc <= 0) {
     return 0;
   }
 
-  if (strcmp(argv[0], "led") == 0) {
-    return shell_cmd_led(argc, argv);
+  const shell_cmd_desc_t *cmd = shell_find_cmd(argv[0]);
+  if (cmd != NULL) {
+    return cmd->handler(argc, argv);
   }
 
   shell_print("Unknown command: ");
@@ -216,6 +241,46 @@ static int shell_execute(int argc, const char * const * argv)
   return 0;
 }
 
+/* help 命令：列出命令表 */
+static int shell_cmd_help(int argc, const char * const * argv)
+{
+  (void)argc;
+  (void)argv;
+  shell_print_line("Available commands:");
+  for (size_t i = 0; i < ARRAY_SIZE(kShellCmdTable); ++i) {
+    shell_print("  ");
+    shell_print(kShellCmdTable[i].name);
+    shell_print(" - ");
+    shell_print(kShellCmdTable[i].description);
+    shell_print(ENDL);
+  }
+  return 0;
+}
+
+/* version 命令 */
+static int shell_cmd_version(int argc, const char * const * argv)
+{
+  (void)argc;
+  (void)argv;
+  shell_print("microrl ");
+  shell_print(MICRORL_LIB_VER);
+  shell_print_line(" on USART2 (115200 8N1)");
+  return 0;
+}
+
+/* echo 命令：原样输出参数 */
+static int shell_cmd_echo(int argc, const char * const * argv)
+{
+  for (int i = 1; i < argc; ++i) {
+    shell_print(argv[i]);
+    if (i < (argc - 1)) {
+      shell_print(" ");
+    }
+  }
+  shell_print(ENDL);
+  return 0;
+}
+
 /* LED 命令：led <颜色> <on|off|toggle> */
 static int shell_cmd_led(int argc, const char * const * argv)
 {
@@ -331,10 +396,14 @@ static char **shell_complete(int argc, const char * const * argv)
   }
 
   if (argc <= 1) {
-    for (size_t i = 0; i < ARRAY_SIZE(kShellCmdTable); ++i) {
+    /* 有序表中前缀相同的命令相邻，从下界开始取连续匹配项 */
+    size_t i = (s_shell_cmd_sorted != 0U) ? shell_cmd_lower_bound(current, strlen(current)) : 0U;
+    for (; i < ARRAY_SIZE(kShellCmdTable); ++i) {
       const char *name = kShellCmdTable[i].name;
       if (shell_prefix_match(current, name)) {
         idx = shell_add_completion(name, idx);
+      } else if (s_shell_cmd_sorted != 0U) {
+        break;
       }
     }
     return (char **)s_shell_completion;
@@ -371,9 +440,12 @@ int main(void)
   HAL_Init();
   SystemClock_Config();
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_USART2_UART_Init();
 
+  uart_tx_init(&huart2);
   shell_show_banner();
+  shell_check_cmd_table();
   microrl_init(&s_shell, shell_print);
   microrl_set_execute_callback(&s_shell, shell_execute);
   microrl_set_complete_callback(&s_shell, shell_complete);
@@ -433,10 +505,17 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
   }
 }
 
+/* UART 发送完成回调：继续发送缓冲区中的数据 */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  uart_tx_on_complete(huart);
+}
+
 /* UART 出错回调：重启接收以保持 shell 可用 */
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
   if (huart->Instance == USART2) {
+    uart_tx_on_complete(huart);
     shell_start_rx();
   }
 }
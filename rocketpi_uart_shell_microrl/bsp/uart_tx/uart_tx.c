@@ -0,0 +1,170 @@
+/**
+ * @file    uart_tx.c
+ * @brief   USART2 DMA 发送环形缓冲实现。
+ *
+ * s_head 只由写入方（主循环）推进，s_tail 只在 DMA 完成回调中推进；
+ * s_dma_len 非 0 表示有一次 DMA 传输正在进行，其值为该次传输的长度。
+ */
+#include "uart_tx.h"
+
+#include <string.h>
+
+#define UART_TX_MASK    (UART_TX_BUFFER_SIZE - 1U)
+
+static UART_HandleTypeDef *s_huart;
+static uint8_t s_buf[UART_TX_BUFFER_SIZE];
+static volatile uint32_t s_head;
+static volatile uint32_t s_tail;
+static volatile uint32_t s_dma_len;
+static uart_tx_stats_t s_stats;
+
+/* DMA 空闲且有数据时启动下一次传输，一次最多发送到缓冲区末尾 */
+static void uart_tx_kick(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if ((s_huart != NULL) && (s_dma_len == 0U) && (s_head != s_tail))
+    {
+        uint32_t offset = s_tail & UART_TX_MASK;
+        uint32_t len = s_head - s_tail;
+
+        if (len > (UART_TX_BUFFER_SIZE - offset))
+        {
+            len = UART_TX_BUFFER_SIZE - offset;
+        }
+        s_dma_len = len;
+        if (HAL_UART_Transmit_DMA(s_huart, &s_buf[offset], (uint16_t)len) == HAL_OK)
+        {
+            s_stats.transfers++;
+        }
+        else
+        {
+            /* 串口忙（例如仍有阻塞发送），下一次写入或完成回调时重试 */
+            s_dma_len = 0U;
+        }
+    }
+    if (primask == 0U)
+    {
+        __enable_irq();
+    }
+}
+
+/* 只有线程模式且开中断时才能等待 DMA 完成回调 */
+static int uart_tx_can_wait(void)
+{
+    return (__get_IPSR() == 0U) && (__get_PRIMASK() == 0U);
+}
+
+/* 拷贝到环形缓冲，满时等待或丢弃，不启动 DMA */
+static size_t uart_tx_copy(const uint8_t *src, size_t len)
+{
+    size_t done = 0U;
+
+    while (done < len)
+    {
+        uint32_t head = s_head;
+        uint32_t space = UART_TX_BUFFER_SIZE - (head - s_tail);
+        uint32_t offset = head & UART_TX_MASK;
+        size_t chunk = len - done;
+
+        if (space == 0U)
+        {
+            if (!uart_tx_can_wait())
+            {
+                s_stats.dropped += (uint32_t)(len - done);
+                break;
+            }
+            uart_tx_kick();
+            continue;
+        }
+        if (chunk > space)
+        {
+            chunk = space;
+        }
+        if (chunk > (UART_TX_BUFFER_SIZE - offset))
+        {
+            chunk = UART_TX_BUFFER_SIZE - offset;
+        }
+        memcpy(&s_buf[offset], &src[done], chunk);
+        s_head = head + (uint32_t)chunk;
+        done += chunk;
+    }
+    s_stats.bytes += (uint32_t)done;
+    return done;
+}
+
+void uart_tx_init(UART_HandleTypeDef *huart)
+{
+    s_huart = huart;
+    s_head = 0U;
+    s_tail = 0U;
+    s_dma_len = 0U;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+size_t uart_tx_write(const void *data, size_t len)
+{
+    size_t done;
+
+    if ((data == NULL) || (len == 0U))
+    {
+        return 0U;
+    }
+    s_stats.writes++;
+    done = uart_tx_copy((const uint8_t *)data, len);
+    uart_tx_kick();
+    return done;
+}
+
+void uart_tx_puts(const char *str)
+{
+    static const uint8_t kCrLf[2] = {'\r', '\n'};
+
+    if (str == NULL)
+    {
+        return;
+    }
+    s_stats.writes++;
+    while (*str != '\0')
+    {
+        size_t run = strcspn(str, "\n");
+
+        if (run > 0U)
+        {
+            (void)uart_tx_copy((const uint8_t *)str, run);
+            str += run;
+        }
+        if (*str == '\n')
+        {
+            (void)uart_tx_copy(kCrLf, sizeof(kCrLf));
+            str++;
+        }
+    }
+    uart_tx_kick();
+}
+
+void uart_tx_flush(void)
+{
+    while (s_head != s_tail)
+    {
+        uart_tx_kick();
+    }
+}
+
+void uart_tx_on_complete(UART_HandleTypeDef *huart)
+{
+    /* 接收错误也会进入 ErrorCallback，此时发送仍在进行（gState 为 BUSY_TX） */
+    if ((huart != s_huart) || (s_dma_len == 0U) || (huart->gState != HAL_UART_STATE_READY))
+    {
+        return;
+    }
+    s_tail += s_dma_len;
+    s_dma_len = 0U;
+    uart_tx_kick();
+}
+
+void uart_tx_get_stats(uart_tx_stats_t *stats)
+{
+    *stats = s_stats;
+}
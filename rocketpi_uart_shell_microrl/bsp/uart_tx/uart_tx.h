@@ -0,0 +1,59 @@
+/**
+ * @file    uart_tx.h
+ * @brief   USART2 DMA 发送环形缓冲：shell 输出只做内存拷贝，由 DMA 在后台发送。
+ *
+ * uart_tx_puts() 按段扫描 '\n'，整段拷入环形缓冲并把 LF 转为 CRLF，
+ * 不再逐字符调用 HAL_UART_Transmit。DMA 空闲时立即启动一次传输；
+ * 传输进行中写入的数据在 TxCplt 中合并为下一次传输（每次最多到缓冲区末尾）。
+ * 缓冲区满时在线程模式下等待 DMA 腾出空间，在中断或关中断状态下丢弃。
+ */
+#ifndef UART_TX_H
+#define UART_TX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "main.h"
+
+/* 必须为 2 的幂 */
+#ifndef UART_TX_BUFFER_SIZE
+#define UART_TX_BUFFER_SIZE     1024U
+#endif
+
+#if (UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1U)) != 0U
+#error "UART_TX_BUFFER_SIZE must be a power of two"
+#endif
+
+typedef struct
+{
+    uint32_t bytes;          /* 写入环形缓冲的字节数（含插入的 CR） */
+    uint32_t writes;         /* uart_tx_write / uart_tx_puts 调用次数 */
+    uint32_t transfers;      /* 启动的 DMA 传输次数 */
+    uint32_t dropped;        /* 无法等待时丢弃的字节数 */
+} uart_tx_stats_t;
+
+/** 绑定串口句柄并清空缓冲区，需在 MX_USARTx_UART_Init() 之后调用 */
+void uart_tx_init(UART_HandleTypeDef *huart);
+
+/** 原样写入 len 字节，返回实际写入的字节数 */
+size_t uart_tx_write(const void *data, size_t len);
+
+/** 写入以 0 结尾的字符串，LF 转换为 CRLF */
+void uart_tx_puts(const char *str);
+
+/** 等待缓冲区发送完毕，需开中断 */
+void uart_tx_flush(void);
+
+/** 在 HAL_UART_TxCpltCallback / HAL_UART_ErrorCallback 中调用 */
+void uart_tx_on_complete(UART_HandleTypeDef *huart);
+
+void uart_tx_get_stats(uart_tx_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UART_TX_H */
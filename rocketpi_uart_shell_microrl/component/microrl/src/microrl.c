@@ -499,7 +499,9 @@ static void microrl_get_complite (microrl_t * pThis)
 		return;
 	
 	int status = split (pThis, pThis->cursor, tkn_arr);
-	if (pThis->cmdline[pThis->cursor-1] == '\0')
+	if (status < 0) // more than _COMMAND_TOKEN_NMB - 1 tokens, nothing to complete
+		return;
+	if ((pThis->cursor == 0) || (pThis->cmdline[pThis->cursor-1] == '\0'))
 		tkn_arr[status++] = "";
 	compl_token = pThis->get_completion (status, tkn_arr);
 	if (compl_token[0] != NULL) {
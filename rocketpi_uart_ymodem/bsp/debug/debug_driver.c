@@ -1,5 +1,7 @@
 #include "debug_driver.h"
 
+#include "debug_format.h"
+#include "debug_retarget.h"
 #include "usart.h"
 #include <stdarg.h>
 #include <stdio.h>
@@ -23,7 +25,9 @@
 int _write(int file, char *ptr, int len)
 {
     (void)file;
-    HAL_UART_Transmit(&huart2, (uint8_t *)ptr, len, HAL_MAX_DELAY);
+    if (len > 0) {
+        (void)debug_retarget_write(ptr, (size_t)len);
+    }
     return len;
 }
 
@@ -37,8 +41,12 @@ int _write(int file, char *ptr, int len)
 int _read(int file, char *ptr, int len)
 {
     (void)file;
-    HAL_UART_Receive(&huart2, (uint8_t *)ptr, len, HAL_MAX_DELAY);
-    return len;
+    if (len <= 0) {
+        return 0;
+    }
+    /* Block for the first byte, then hand back whatever else has arrived */
+    ptr[0] = (char)debug_retarget_getc();
+    return 1 + (int)debug_retarget_read(ptr + 1, (size_t)len - 1U);
 }
 #elif defined(__ARMCC_VERSION)  // Keil
 /**
@@ -51,7 +59,7 @@ int fputc(int ch, FILE *f)
 {
     (void)f;
     uint8_t data = (uint8_t)ch;
-    HAL_UART_Transmit(&huart2, &data, 1U, HAL_MAX_DELAY);
+    (void)debug_retarget_write(&data, 1U);
     return ch;
 }
 
@@ -63,9 +71,7 @@ int fputc(int ch, FILE *f)
 int fgetc(FILE *f)
 {
     (void)f;
-    uint8_t ch;
-    HAL_UART_Receive(&huart2, &ch, 1U, HAL_MAX_DELAY);
-    return (int)ch;
+    return debug_retarget_getc();
 }
 
 #ifndef __MICROLIB
@@ -102,8 +108,8 @@ int fgetc(FILE *f)
 #define UART_LOG_TIMEOUT   1000        // Send timeout (ms)
 #endif
 
-#ifndef UART_LOG_BUF_SIZE
-#define UART_LOG_BUF_SIZE  256         // Size of the formatting buffer
+#ifndef UART_LOG_LINE_SIZE
+#define UART_LOG_LINE_SIZE 128         // uart_printf line buffer size, longer output takes several writes
 #endif
 /* ======================================== */
 
@@ -112,35 +118,67 @@ int fgetc(FILE *f)
  */
 static inline void uart_write_blocking(const uint8_t *data, size_t len)
 {
+#if DEBUG_RETARGET_ENABLE
+    (void)debug_retarget_write(data, len);
+#else
     HAL_UART_Transmit(&UART_LOG_INSTANCE, (uint8_t *)data, (uint16_t)len, UART_LOG_TIMEOUT);
+#endif
+}
+
+/**
+ * @brief Line buffer: output is CRLF-normalized here and handed to the transmit path in one piece.
+ */
+typedef struct {
+    char buf[UART_LOG_LINE_SIZE];
+    size_t len;
+} uart_line_t;
+
+static void uart_line_flush(uart_line_t *line)
+{
+    if (line->len > 0) {
+        uart_write_blocking((const uint8_t*)line->buf, line->len);
+        line->len = 0;
+    }
 }
 
 /**
- * @brief Normalize newlines to CRLF before sending to the terminal.
+ * @brief Append to the line buffer expanding '\n' to CRLF, sending what is buffered when it fills up.
  */
-static void uart_write_with_crlf(const char *s, size_t len)
+static void uart_line_put(uart_line_t *line, const char *s, size_t len)
 {
     for (size_t i = 0; i < len; ++i) {
-        char c = s[i];
-        if (c == '\n') {
-            const char crlf[2] = {'\r','\n'};
-            uart_write_blocking((const uint8_t*)crlf, 2);
-        } else {
-            uart_write_blocking((const uint8_t*)&c, 1);
+        if (line->len + 2 > sizeof(line->buf)) {
+            uart_line_flush(line);
+        }
+        if (s[i] == '\n') {
+            line->buf[line->len++] = '\r';
         }
+        line->buf[line->len++] = s[i];
     }
 }
 
+/**
+ * @brief debug_format output callback.
+ */
+static void uart_format_out(void *ctx, const char *data, size_t len)
+{
+    uart_line_put((uart_line_t*)ctx, data, len);
+}
+
 /**
  * @brief Output a zero-terminated string (with automatic CRLF normalization).
  */
 void uart_puts(const char *s)
 {
+    uart_line_t line;
+
     if (s == NULL) {
         return;
     }
 
-    uart_write_with_crlf(s, strlen(s));
+    line.len = 0;
+    uart_line_put(&line, s, strlen(s));
+    uart_line_flush(&line);
 }
 
 /**
@@ -149,20 +187,15 @@ void uart_puts(const char *s)
  */
 int uart_printf(const char *fmt, ...)
 {
-    char buf[UART_LOG_BUF_SIZE];
+    uart_line_t line;
     va_list ap;
+
+    line.len = 0;
     va_start(ap, fmt);
-    int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    /* Format into the line buffer and write it once, so DROP mode sends or drops whole lines */
+    int n = debug_vformat(uart_format_out, &line, fmt, ap);
     va_end(ap);
-    if (n < 0) return n;  
-    size_t out_len = (n < (int)sizeof(buf)) ? (size_t)n : (size_t)sizeof(buf) - 1;
-    uart_write_with_crlf(buf, out_len);
-
-    /* 
-    if (n >= (int)sizeof(buf)) {
-        uart_puts("...[truncated]\n");
-    }
-    */
+    uart_line_flush(&line);
     return n;
 }
 
@@ -177,22 +210,22 @@ void uart_hexdump(const void *data, size_t len, const char *title)
     char line[80];
     for (size_t i = 0; i < len; i += 16) {
         int pos = 0;
-        pos += snprintf(line + pos, sizeof(line) - pos, "%08X  ", (unsigned)i);
+        pos += debug_snprintf(line + pos, sizeof(line) - pos, "%08X  ", (unsigned)i);
 
         /* hex */
         for (size_t j = 0; j < 16; ++j) {
-            if (i + j < len) pos += snprintf(line + pos, sizeof(line) - pos, "%02X ", p[i + j]);
-            else              pos += snprintf(line + pos, sizeof(line) - pos, "   ");
-            if (j == 7) pos += snprintf(line + pos, sizeof(line) - pos, " ");
+            if (i + j < len) pos += debug_snprintf(line + pos, sizeof(line) - pos, "%02X ", p[i + j]);
+            else              pos += debug_snprintf(line + pos, sizeof(line) - pos, "   ");
+            if (j == 7) pos += debug_snprintf(line + pos, sizeof(line) - pos, " ");
         }
 
         /* ascii */
-        pos += snprintf(line + pos, sizeof(line) - pos, " |");
+        pos += debug_snprintf(line + pos, sizeof(line) - pos, " |");
         for (size_t j = 0; j < 16 && i + j < len; ++j) {
             uint8_t c = p[i + j];
-            pos += snprintf(line + pos, sizeof(line) - pos, "%c", (c >= 32 && c <= 126) ? c : '.');
+            pos += debug_snprintf(line + pos, sizeof(line) - pos, "%c", (c >= 32 && c <= 126) ? c : '.');
         }
-        pos += snprintf(line + pos, sizeof(line) - pos, "|\n");
+        pos += debug_snprintf(line + pos, sizeof(line) - pos, "|\n");
 
         uart_puts(line);
     }
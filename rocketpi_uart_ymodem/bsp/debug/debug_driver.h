@@ -61,6 +61,9 @@ void uart_puts(const char *s);
 
 /**
  * @brief printf-style helper forwarding formatted text to the debug UART.
+ *
+ * Formatting is done by debug_format: floats support %f %F only, %e %g %a and %n are printed as is.
+ * Output up to UART_LOG_LINE_SIZE (after CRLF expansion) reaches the transmit path in one write.
  * @param fmt Format string describing the output.
  * @return Number of characters that would have been written, or negative on error.
  */
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdarg.h>
+#include <stddef.h>
+
+/**
+ * @file debug_format.h
+ * @brief 调试输出用的轻量格式化引擎：纯整数运算、可重入、不使用堆。
+ *
+ * 支持的转换：%d %i %u %o %x %X %c %s %p %% 以及 %f %F；
+ * 标志 "-+ #0"、宽度、精度（含 *）和长度修饰 hh h l ll j z t L。
+ * %f 直接按 double 的位模式做定点十进制转换（四舍六入五成双，结果与 glibc 一致），
+ * 不调用任何软件浮点运算。不支持 %e %E %g %G %a %A 和 %n：取走对应参数后原样输出转换说明
+ * （例如 "%.3e"），%n 不写入。
+ * 输出通过回调按段交出，不经过整行缓冲。
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========= Configuration section ========= */
+#ifndef DEBUG_FORMAT_FLOAT_DIGITS
+#define DEBUG_FORMAT_FLOAT_DIGITS   20      // %f 小数位上限，更大的精度按此值输出
+#endif
+/* ======================================== */
+
+/**
+ * @brief 输出回调，每次交出一段连续字符（不以 0 结尾）。
+ * @param ctx  调用者上下文。
+ * @param data 字符起始指针。
+ * @param len  字符数。
+ */
+typedef void (*debug_format_out_t)(void *ctx, const char *data, size_t len);
+
+/**
+ * @brief 按格式串输出到回调。
+ * @param out 输出回调。
+ * @param ctx 传给回调的上下文。
+ * @param fmt 格式串。
+ * @param ap  参数列表。
+ * @return 输出的字符数。
+ */
+int debug_vformat(debug_format_out_t out, void *ctx, const char *fmt, va_list ap);
+
+/**
+ * @brief debug_vformat() 的可变参数版本。
+ */
+int debug_format(debug_format_out_t out, void *ctx, const char *fmt, ...);
+
+/**
+ * @brief 格式化到缓冲区，语义同 vsnprintf：总是以 0 结尾，返回完整输出应有的长度。
+ * @param buf  目标缓冲区（size 为 0 时可为 NULL）。
+ * @param size 缓冲区大小。
+ * @param fmt  格式串。
+ * @param ap   参数列表。
+ * @return 不截断时的字符数。
+ */
+int debug_vsnprintf(char *buf, size_t size, const char *fmt, va_list ap);
+
+/**
+ * @brief debug_vsnprintf() 的可变参数版本。
+ */
+int debug_snprintf(char *buf, size_t size, const char *fmt, ...);
+
+#ifdef __cplusplus
+}
+#endif
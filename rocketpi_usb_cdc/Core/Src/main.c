@@ -112,11 +112,15 @@ int main(void)
     /* Process received CDC data when stack notifies readiness */
     if (CDC_IsRxReady())
     {
-      cdcRxAppLen = CDC_ReadRxData(cdcRxAppBuffer, sizeof(cdcRxAppBuffer));
+      /* Only take what the TX ring can hold; the rest stays queued (and the
+         host is NAKed) instead of being dropped */
+      uint32_t txFree = CDC_GetTxFree();
+      cdcRxAppLen = CDC_ReadRxData(cdcRxAppBuffer,
+                                   (txFree < sizeof(cdcRxAppBuffer)) ? txFree : sizeof(cdcRxAppBuffer));
       if (cdcRxAppLen > 0U)
       {
         /* Echo received payload back to host; replace with custom handling */
-        CDC_Transmit_FS(cdcRxAppBuffer, (uint16_t)cdcRxAppLen);
+        (void)CDC_Write(cdcRxAppBuffer, cdcRxAppLen);
       }
     }
 
@@ -63,6 +63,23 @@
   */
 
 /* USER CODE BEGIN PRIVATE_DEFINES */
+/* UserRxBufferFS is split into packet slots the OUT endpoint writes into
+ * directly; the endpoint is only re-armed while a slot is free, so the host
+ * is NAKed instead of data being overwritten. */
+#define CDC_RX_SLOT_SIZE   CDC_DATA_FS_OUT_PACKET_SIZE
+#define CDC_RX_SLOT_COUNT  (APP_RX_DATA_SIZE / CDC_RX_SLOT_SIZE)
+
+#if (CDC_RX_SLOT_COUNT < 2U) || ((CDC_RX_SLOT_COUNT & (CDC_RX_SLOT_COUNT - 1U)) != 0U)
+#error "APP_RX_DATA_SIZE / CDC_DATA_FS_OUT_PACKET_SIZE must be a power of two >= 2"
+#endif
+
+/* UserTxBufferFS is a byte ring; everything queued while a transfer is in
+ * flight goes out as one multi-packet transfer from CDC_TransmitCplt_FS. */
+#define CDC_TX_MASK        (APP_TX_DATA_SIZE - 1U)
+
+#if (APP_TX_DATA_SIZE & (APP_TX_DATA_SIZE - 1U)) != 0U
+#error "APP_TX_DATA_SIZE must be a power of two"
+#endif
 /* USER CODE END PRIVATE_DEFINES */
 
 /**
@@ -95,9 +112,18 @@ uint8_t UserRxBufferFS[APP_RX_DATA_SIZE];
 uint8_t UserTxBufferFS[APP_TX_DATA_SIZE];
 
 /* USER CODE BEGIN PRIVATE_VARIABLES */
-static uint8_t cdcRxBuffer[APP_RX_DATA_SIZE];
-static volatile uint32_t cdcRxLength = 0U;
-static volatile uint8_t cdcRxReady = 0U;
+/* Single producer (USB IRQ advances cdcRxHead), single consumer (main loop
+ * advances cdcRxTail); both counters run freely and are masked on use. */
+static volatile uint16_t cdcRxSlotLength[CDC_RX_SLOT_COUNT];
+static volatile uint32_t cdcRxHead = 0U;
+static volatile uint32_t cdcRxTail = 0U;
+static volatile uint8_t cdcRxPaused = 0U;
+static uint32_t cdcRxOffset = 0U;
+/* cdcTxHead is advanced by writers, cdcTxTail and cdcTxInFlight by CDC_TxKick */
+static volatile uint32_t cdcTxHead = 0U;
+static volatile uint32_t cdcTxTail = 0U;
+static volatile uint32_t cdcTxInFlight = 0U;
+static uint32_t cdcTxTransfers = 0U;
 /* USER CODE END PRIVATE_VARIABLES */
 
 /**
@@ -131,7 +157,9 @@ static int8_t CDC_Receive_FS(uint8_t* pbuf, uint32_t *Len);
 static int8_t CDC_TransmitCplt_FS(uint8_t *pbuf, uint32_t *Len, uint8_t epnum);
 
 /* USER CODE BEGIN PRIVATE_FUNCTIONS_DECLARATION */
-
+static uint8_t *CDC_RxSlot(uint32_t index);
+static void CDC_ArmRx(void);
+static void CDC_TxKick(void);
 /* USER CODE END PRIVATE_FUNCTIONS_DECLARATION */
 
 /**
@@ -156,8 +184,15 @@ static int8_t CDC_Init_FS(void)
 {
   /* USER CODE BEGIN 3 */
   /* Set Application Buffers */
+  cdcRxHead = 0U;
+  cdcRxTail = 0U;
+  cdcRxOffset = 0U;
+  cdcRxPaused = 0U;
+  cdcTxHead = 0U;
+  cdcTxTail = 0U;
+  cdcTxInFlight = 0U;
   USBD_CDC_SetTxBuffer(&hUsbDeviceFS, UserTxBufferFS, 0);
-  USBD_CDC_SetRxBuffer(&hUsbDeviceFS, UserRxBufferFS);
+  USBD_CDC_SetRxBuffer(&hUsbDeviceFS, CDC_RxSlot(0U));
   return (USBD_OK);
   /* USER CODE END 3 */
 }
@@ -264,16 +299,26 @@ static int8_t CDC_Control_FS(uint8_t cmd, uint8_t* pbuf, uint16_t length)
 static int8_t CDC_Receive_FS(uint8_t* Buf, uint32_t *Len)
 {
   /* USER CODE BEGIN 6 */
+  UNUSED(Buf);
+
+  /* Buf is CDC_RxSlot(cdcRxHead); a zero-length packet just re-arms it */
   if ((Len != NULL) && (*Len > 0U))
   {
-    uint32_t copyLen = (*Len <= APP_RX_DATA_SIZE) ? *Len : APP_RX_DATA_SIZE;
-    memcpy(cdcRxBuffer, Buf, copyLen);
-    cdcRxLength = copyLen;
-    cdcRxReady = 1U;
+    uint32_t head = cdcRxHead;
+    cdcRxSlotLength[head & (CDC_RX_SLOT_COUNT - 1U)] =
+        (uint16_t)((*Len <= CDC_RX_SLOT_SIZE) ? *Len : CDC_RX_SLOT_SIZE);
+    __DMB();
+    cdcRxHead = head + 1U;
+
+    if ((cdcRxHead - cdcRxTail) >= CDC_RX_SLOT_COUNT)
+    {
+      /* Ring full: leave the endpoint NAKing until CDC_ReadRxData frees a slot */
+      cdcRxPaused = 1U;
+      return (USBD_OK);
+    }
   }
 
-  USBD_CDC_SetRxBuffer(&hUsbDeviceFS, &Buf[0]);
-  USBD_CDC_ReceivePacket(&hUsbDeviceFS);
+  CDC_ArmRx();
   return (USBD_OK);
   /* USER CODE END 6 */
 }
@@ -287,18 +332,24 @@ static int8_t CDC_Receive_FS(uint8_t* Buf, uint32_t *Len)
   *
   * @param  Buf: Buffer of data to be sent
   * @param  Len: Number of data to be sent (in bytes)
-  * @retval USBD_OK if all operations are OK else USBD_FAIL or USBD_BUSY
+  * @retval USBD_OK if all operations are OK, USBD_BUSY if the ring is full for now,
+  *         USBD_FAIL if Len exceeds APP_TX_DATA_SIZE
   */
 uint8_t CDC_Transmit_FS(uint8_t* Buf, uint16_t Len)
 {
   uint8_t result = USBD_OK;
   /* USER CODE BEGIN 7 */
-  USBD_CDC_HandleTypeDef *hcdc = (USBD_CDC_HandleTypeDef*)hUsbDeviceFS.pClassData;
-  if (hcdc->TxState != 0){
+  /* All or nothing, so existing retry-until-USBD_OK callers keep working */
+  if (Len > APP_TX_DATA_SIZE)
+  {
+    /* Can never fit in the staging ring; BUSY would make the caller retry forever */
+    return USBD_FAIL;
+  }
+  if ((hUsbDeviceFS.pClassData == NULL) || (CDC_GetTxFree() < Len))
+  {
     return USBD_BUSY;
   }
-  USBD_CDC_SetTxBuffer(&hUsbDeviceFS, Buf, Len);
-  result = USBD_CDC_TransmitPacket(&hUsbDeviceFS);
+  (void)CDC_Write(Buf, Len);
   /* USER CODE END 7 */
   return result;
 }
@@ -322,28 +373,171 @@ static int8_t CDC_TransmitCplt_FS(uint8_t *Buf, uint32_t *Len, uint8_t epnum)
   UNUSED(Buf);
   UNUSED(Len);
   UNUSED(epnum);
+  cdcTxTail += cdcTxInFlight;
+  cdcTxInFlight = 0U;
+  CDC_TxKick();
   /* USER CODE END 13 */
   return result;
 }
 
 /* USER CODE BEGIN PRIVATE_FUNCTIONS_IMPLEMENTATION */
+static uint8_t *CDC_RxSlot(uint32_t index)
+{
+  return &UserRxBufferFS[(index & (CDC_RX_SLOT_COUNT - 1U)) * CDC_RX_SLOT_SIZE];
+}
+
+static void CDC_ArmRx(void)
+{
+  USBD_CDC_SetRxBuffer(&hUsbDeviceFS, CDC_RxSlot(cdcRxHead));
+  USBD_CDC_ReceivePacket(&hUsbDeviceFS);
+}
+
 uint8_t CDC_IsRxReady(void)
 {
-  return cdcRxReady;
+  return (cdcRxHead != cdcRxTail) ? 1U : 0U;
+}
+
+uint32_t CDC_GetRxAvailable(void)
+{
+  uint32_t tail = cdcRxTail;
+  uint32_t head = cdcRxHead;
+  uint32_t total = 0U;
+
+  __DMB();
+  for (; tail != head; ++tail)
+  {
+    total += cdcRxSlotLength[tail & (CDC_RX_SLOT_COUNT - 1U)];
+  }
+  return total - cdcRxOffset;
 }
 
 uint32_t CDC_ReadRxData(uint8_t *Buf, uint32_t BufSize)
 {
-  if ((cdcRxReady == 0U) || (cdcRxLength == 0U) || (Buf == NULL) || (BufSize == 0U))
+  uint32_t copied = 0U;
+
+  if ((Buf == NULL) || (BufSize == 0U))
+  {
+    return 0U;
+  }
+
+  /* Stream read: packets are concatenated, a partly read packet keeps its slot */
+  while ((copied < BufSize) && (cdcRxTail != cdcRxHead))
+  {
+    __DMB();
+    uint32_t tail = cdcRxTail;
+    uint32_t length = cdcRxSlotLength[tail & (CDC_RX_SLOT_COUNT - 1U)];
+    uint32_t chunk = length - cdcRxOffset;
+
+    if (chunk > (BufSize - copied))
+    {
+      chunk = BufSize - copied;
+    }
+    memcpy(&Buf[copied], CDC_RxSlot(tail) + cdcRxOffset, chunk);
+    copied += chunk;
+    cdcRxOffset += chunk;
+
+    if (cdcRxOffset >= length)
+    {
+      cdcRxOffset = 0U;
+      __DMB();
+      cdcRxTail = tail + 1U;
+
+      /* The OUT endpoint is idle while paused, so re-arming here cannot race the IRQ */
+      if (cdcRxPaused != 0U)
+      {
+        cdcRxPaused = 0U;
+        CDC_ArmRx();
+      }
+    }
+  }
+
+  return copied;
+}
+
+/* Starts the next transfer if the IN endpoint is idle; callers outside the
+ * USB IRQ must hold interrupts off. */
+static void CDC_TxKick(void)
+{
+  uint32_t pending = cdcTxHead - cdcTxTail;
+  uint32_t offset = cdcTxTail & CDC_TX_MASK;
+
+  if ((cdcTxInFlight != 0U) || (pending == 0U) || (hUsbDeviceFS.pClassData == NULL))
+  {
+    return;
+  }
+
+  /* One transfer per contiguous span; the class appends a ZLP when the length
+   * is a multiple of the packet size */
+  if (pending > (APP_TX_DATA_SIZE - offset))
+  {
+    pending = APP_TX_DATA_SIZE - offset;
+  }
+
+  USBD_CDC_SetTxBuffer(&hUsbDeviceFS, &UserTxBufferFS[offset], pending);
+  if (USBD_CDC_TransmitPacket(&hUsbDeviceFS) == USBD_OK)
+  {
+    cdcTxInFlight = pending;
+    ++cdcTxTransfers;
+  }
+}
+
+uint32_t CDC_GetTxFree(void)
+{
+  return APP_TX_DATA_SIZE - (cdcTxHead - cdcTxTail);
+}
+
+uint32_t CDC_Write(const uint8_t *Buf, uint32_t Len)
+{
+  uint32_t head = cdcTxHead;
+  uint32_t space = APP_TX_DATA_SIZE - (head - cdcTxTail);
+  uint32_t offset = head & CDC_TX_MASK;
+  uint32_t first;
+  uint32_t primask;
+
+  if ((Buf == NULL) || (Len == 0U) || (hUsbDeviceFS.pClassData == NULL))
   {
     return 0U;
   }
 
-  uint32_t bytesToCopy = (cdcRxLength <= BufSize) ? cdcRxLength : BufSize;
-  memcpy(Buf, cdcRxBuffer, bytesToCopy);
-  cdcRxLength = 0U;
-  cdcRxReady = 0U;
-  return bytesToCopy;
+  /* Never blocks: whatever does not fit is left to the caller */
+  if (Len > space)
+  {
+    Len = space;
+  }
+  first = APP_TX_DATA_SIZE - offset;
+  if (first > Len)
+  {
+    first = Len;
+  }
+  memcpy(&UserTxBufferFS[offset], Buf, first);
+  memcpy(&UserTxBufferFS[0], &Buf[first], Len - first);
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  cdcTxHead = head + Len;
+  CDC_TxKick();
+  __set_PRIMASK(primask);
+
+  return Len;
+}
+
+uint8_t CDC_TxFlush(uint32_t Timeout)
+{
+  uint32_t tickstart = HAL_GetTick();
+
+  while ((cdcTxHead != cdcTxTail) || (cdcTxInFlight != 0U))
+  {
+    if ((hUsbDeviceFS.pClassData == NULL) || ((HAL_GetTick() - tickstart) >= Timeout))
+    {
+      return USBD_BUSY;
+    }
+  }
+  return USBD_OK;
+}
+
+uint32_t CDC_GetTxTransferCount(void)
+{
+  return cdcTxTransfers;
 }
 
 /* USER CODE END PRIVATE_FUNCTIONS_IMPLEMENTATION */
@@ -110,7 +110,12 @@ uint8_t CDC_Transmit_FS(uint8_t* Buf, uint16_t Len);
 
 /* USER CODE BEGIN EXPORTED_FUNCTIONS */
 uint8_t CDC_IsRxReady(void);
+uint32_t CDC_GetRxAvailable(void);
 uint32_t CDC_ReadRxData(uint8_t *Buf, uint32_t BufSize);
+uint32_t CDC_Write(const uint8_t *Buf, uint32_t Len);
+uint32_t CDC_GetTxFree(void);
+uint8_t CDC_TxFlush(uint32_t Timeout);
+uint32_t CDC_GetTxTransferCount(void);
 
 /* USER CODE END EXPORTED_FUNCTIONS */
 
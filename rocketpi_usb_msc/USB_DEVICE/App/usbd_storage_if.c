@@ -2,7 +2,7 @@
 /**
   ******************************************************************************
   * @file           : usbd_storage_if.c
-  * @brief          : RAM-backed USB MSC storage layer
+  * @brief          : USB MSC storage layer, forwards to the msc_storage medium
   ******************************************************************************
   */
 /* USER CODE END Header */
@@ -11,8 +11,8 @@
 #include "usbd_storage_if.h"
 
 /* USER CODE BEGIN INCLUDE */
-#include <string.h>
 #include <stdbool.h>
+#include "msc_storage.h"
 /* USER CODE END INCLUDE */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -36,9 +36,6 @@
 
 /* USER CODE BEGIN PRIVATE_DEFINES */
 #define STORAGE_LUN_NBR                  1U
-#define STORAGE_BLK_SIZ                  0x200U                /* 512 bytes  */
-#define RAM_DISK_SIZE                    (64UL * 1024UL)       /* 64 KB SRAM */
-#define STORAGE_BLK_NBR                  (RAM_DISK_SIZE / STORAGE_BLK_SIZ)
 /* USER CODE END PRIVATE_DEFINES */
 
 /**
@@ -76,7 +73,6 @@
 
 /* USER CODE BEGIN PV */
 static bool storage_ready = false;
-static uint8_t ram_disk[RAM_DISK_SIZE];
 /* USER CODE END PV */
 
 /**
@@ -111,9 +107,7 @@ static int8_t STORAGE_Write_FS (uint8_t lun, uint8_t *buf, uint32_t blk_addr, ui
 static int8_t STORAGE_GetMaxLun_FS(void);
 
 /* USER CODE BEGIN PRIVATE_FUNCTIONS_DECLARATION */
-void MSC_FlashStorage_Init(void); /* kept for compatibility, now initializes RAM disk */
-static bool Storage_CheckRange(uint32_t blk_addr, uint32_t blk_len);
-static uint32_t Storage_BlockToAddress(uint32_t blk_addr);
+void MSC_FlashStorage_Init(void); /* kept for compatibility, initializes the storage medium */
 /* USER CODE END PRIVATE_FUNCTIONS_DECLARATION */
 
 /**
@@ -127,7 +121,7 @@ static const int8_t STORAGE_Inquirydata_FS[] = {
   (STANDARD_INQUIRY_DATA_LEN - 5),
   0x00, 0x00, 0x00,
   'R','o','c','k','e','t','P','i',
-  'R','A','M',' ','D','i','s','k',' ',' ',' ',' ',' ',' ',' ',' ',
+  'M','a','s','s',' ','S','t','o','r','a','g','e',' ',' ',' ',' ',
   '0','.','0','1'
 };
 /* USER CODE END INQUIRY_DATA_FS */
@@ -165,9 +159,7 @@ static int8_t STORAGE_GetCapacity_FS(uint8_t lun, uint32_t *block_num, uint16_t
 {
   /* USER CODE BEGIN 3 */
   UNUSED(lun);
-  *block_num = STORAGE_BLK_NBR;
-  *block_size = STORAGE_BLK_SIZ;
-  return USBD_OK;
+  return (msc_storage_get()->get_capacity(block_num, block_size) == 0) ? USBD_OK : USBD_FAIL;
   /* USER CODE END 3 */
 }
 
@@ -178,7 +170,11 @@ static int8_t STORAGE_IsReady_FS(uint8_t lun)
 {
   /* USER CODE BEGIN 4 */
   UNUSED(lun);
-  return storage_ready ? USBD_OK : USBD_FAIL;
+  if (!storage_ready)
+  {
+    return USBD_FAIL;
+  }
+  return (msc_storage_get()->is_ready() == 0) ? USBD_OK : USBD_FAIL;
   /* USER CODE END 4 */
 }
 
@@ -201,12 +197,11 @@ static int8_t STORAGE_Read_FS(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint
   /* USER CODE BEGIN 6 */
   UNUSED(lun);
 
-  if (!storage_ready || !Storage_CheckRange(blk_addr, blk_len))
+  /* blk_len covers a whole media packet (up to MSC_MEDIA_PACKET bytes) */
+  if (!storage_ready || (msc_storage_get()->read(buf, blk_addr, blk_len) != 0))
   {
     return USBD_FAIL;
   }
-
-  memcpy(buf, &ram_disk[Storage_BlockToAddress(blk_addr)], (uint32_t)blk_len * STORAGE_BLK_SIZ);
   return USBD_OK;
   /* USER CODE END 6 */
 }
@@ -219,12 +214,10 @@ static int8_t STORAGE_Write_FS(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uin
   /* USER CODE BEGIN 7 */
   UNUSED(lun);
 
-  if (!storage_ready || !Storage_CheckRange(blk_addr, blk_len))
+  if (!storage_ready || (msc_storage_get()->write(buf, blk_addr, blk_len) != 0))
   {
     return USBD_FAIL;
   }
-
-  memcpy(&ram_disk[Storage_BlockToAddress(blk_addr)], buf, (uint32_t)blk_len * STORAGE_BLK_SIZ);
   return USBD_OK;
   /* USER CODE END 7 */
 }
@@ -244,18 +237,7 @@ void MSC_FlashStorage_Init(void)
 {
   if (!storage_ready)
   {
-    memset(ram_disk, 0xFF, sizeof(ram_disk));
-    storage_ready = true;
+    storage_ready = (msc_storage_get()->init() == 0);
   }
 }
-
-static bool Storage_CheckRange(uint32_t blk_addr, uint32_t blk_len)
-{
-  return (blk_len > 0U) && ((blk_addr + blk_len) <= STORAGE_BLK_NBR);
-}
-
-static uint32_t Storage_BlockToAddress(uint32_t blk_addr)
-{
-  return blk_addr * STORAGE_BLK_SIZ;
-}
 /* USER CODE END PRIVATE_FUNCTIONS_IMPLEMENTATION */
@@ -75,7 +75,7 @@
 /*---------- -----------*/
 #define USBD_SELF_POWERED     1U
 /*---------- -----------*/
-#define MSC_MEDIA_PACKET     512U
+#define MSC_MEDIA_PACKET     4096U
 
 /****************************************/
 /* #define for FS and HS identification */
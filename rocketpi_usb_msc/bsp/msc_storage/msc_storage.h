@@ -0,0 +1,44 @@
+/**
+ * @file    msc_storage.h
+ * @brief   USB MSC 存储介质接口，当前只有 64 KB RAM 盘一个实现。
+ *
+ * usbd_storage_if.c 通过 msc_storage_get() 访问介质，更换介质时只需提供新的
+ * msc_storage_backend_t 并修改 msc_storage_get()。
+ * read/write 一次处理最多 MSC_MEDIA_PACKET 字节（多个 512 字节块），
+ * 介质应把一次调用映射为一次底层多块传输。
+ * 这些回调在 OTG_FS 中断里执行，不能忙等外设。
+ */
+#ifndef MSC_STORAGE_H
+#define MSC_STORAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define MSC_STORAGE_BLOCK_SIZE      512U
+
+typedef struct
+{
+    const char *name;
+    int8_t (*init)(void);
+    int8_t (*get_capacity)(uint32_t *block_num, uint16_t *block_size);
+    int8_t (*is_ready)(void);
+    int8_t (*read)(uint8_t *buf, uint32_t blk_addr, uint16_t blk_len);
+    int8_t (*write)(const uint8_t *buf, uint32_t blk_addr, uint16_t blk_len);
+} msc_storage_backend_t;
+
+extern const msc_storage_backend_t msc_storage_ram;
+
+/** 返回当前使用的介质 */
+static inline const msc_storage_backend_t *msc_storage_get(void)
+{
+    return &msc_storage_ram;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MSC_STORAGE_H */
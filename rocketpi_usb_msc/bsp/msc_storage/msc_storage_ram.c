@@ -0,0 +1,65 @@
+/**
+ * @file    msc_storage_ram.c
+ * @brief   64 KB SRAM 盘，上电内容为 0xFF。
+ */
+#include "msc_storage.h"
+
+#include <string.h>
+
+#define RAM_DISK_SIZE       (64UL * 1024UL)
+#define RAM_DISK_BLK_NBR    (RAM_DISK_SIZE / MSC_STORAGE_BLOCK_SIZE)
+
+static uint8_t s_ram_disk[RAM_DISK_SIZE];
+static uint8_t s_ready;
+
+static int8_t ram_init(void)
+{
+    if (s_ready == 0U)
+    {
+        memset(s_ram_disk, 0xFF, sizeof(s_ram_disk));
+        s_ready = 1U;
+    }
+    return 0;
+}
+
+static int8_t ram_get_capacity(uint32_t *block_num, uint16_t *block_size)
+{
+    *block_num = RAM_DISK_BLK_NBR;
+    *block_size = MSC_STORAGE_BLOCK_SIZE;
+    return 0;
+}
+
+static int8_t ram_is_ready(void)
+{
+    return (s_ready != 0U) ? 0 : -1;
+}
+
+static int8_t ram_read(uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
+{
+    if ((blk_len == 0U) || ((blk_addr + blk_len) > RAM_DISK_BLK_NBR))
+    {
+        return -1;
+    }
+    memcpy(buf, &s_ram_disk[blk_addr * MSC_STORAGE_BLOCK_SIZE], (uint32_t)blk_len * MSC_STORAGE_BLOCK_SIZE);
+    return 0;
+}
+
+static int8_t ram_write(const uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
+{
+    if ((blk_len == 0U) || ((blk_addr + blk_len) > RAM_DISK_BLK_NBR))
+    {
+        return -1;
+    }
+    memcpy(&s_ram_disk[blk_addr * MSC_STORAGE_BLOCK_SIZE], buf, (uint32_t)blk_len * MSC_STORAGE_BLOCK_SIZE);
+    return 0;
+}
+
+const msc_storage_backend_t msc_storage_ram =
+{
+    "RAM Disk",
+    ram_init,
+    ram_get_capacity,
+    ram_is_ready,
+    ram_read,
+    ram_write
+};
@@ -1,5 +1,7 @@
 #include "debug_driver.h"
 
+#include "debug_format.h"
+#include "debug_retarget.h"
 #include "usart.h"
 #include <stdarg.h>
 #include <stdio.h>
@@ -22,7 +24,9 @@
 int _write(int file, char *ptr, int len)
 {
     (void)file;
-    HAL_UART_Transmit(&huart2, (uint8_t *)ptr, len, HAL_MAX_DELAY);
+    if (len > 0) {
+        (void)debug_retarget_write(ptr, (size_t)len);
+    }
     return len;
 }
 
@@ -36,8 +40,12 @@ int _write(int file, char *ptr, int len)
 int _read(int file, char *ptr, int len)
 {
     (void)file;
-    HAL_UART_Receive(&huart2, (uint8_t *)ptr, len, HAL_MAX_DELAY);
-    return len;
+    if (len <= 0) {
+        return 0;
+    }
+    /* 等待第一个字节，其余只取已收到的部分 */
+    ptr[0] = (char)debug_retarget_getc();
+    return 1 + (int)debug_retarget_read(ptr + 1, (size_t)len - 1U);
 }
 #elif defined(__ARMCC_VERSION)  // Keil
 /**
@@ -50,7 +58,7 @@ int fputc(int ch, FILE *f)
 {
     (void)f;
     uint8_t data = (uint8_t)ch;
-    HAL_UART_Transmit(&huart2, &data, 1U, HAL_MAX_DELAY);
+    (void)debug_retarget_write(&data, 1U);
     return ch;
 }
 
@@ -62,9 +70,7 @@ int fputc(int ch, FILE *f)
 int fgetc(FILE *f)
 {
     (void)f;
-    uint8_t ch;
-    HAL_UART_Receive(&huart2, &ch, 1U, HAL_MAX_DELAY);
-    return (int)ch;
+    return debug_retarget_getc();
 }
 
 #ifndef __MICROLIB
@@ -101,8 +107,8 @@ int fgetc(FILE *f)
 #define UART_LOG_TIMEOUT   1000        // 发送超时（毫秒）
 #endif
 
-#ifndef UART_LOG_BUF_SIZE
-#define UART_LOG_BUF_SIZE  256         // 格式化缓冲区大小
+#ifndef UART_LOG_LINE_SIZE
+#define UART_LOG_LINE_SIZE 128         // uart_printf 行缓冲大小，超出的部分分多次写入
 #endif
 /* ======================================== */
 
@@ -111,35 +117,67 @@ int fgetc(FILE *f)
  */
 static inline void uart_write_blocking(const uint8_t *data, size_t len)
 {
+#if DEBUG_RETARGET_ENABLE
+    (void)debug_retarget_write(data, len);
+#else
     HAL_UART_Transmit(&UART_LOG_INSTANCE, (uint8_t *)data, (uint16_t)len, UART_LOG_TIMEOUT);
+#endif
+}
+
+/**
+ * @brief 行缓冲：格式化结果先在这里做 CRLF 规范化，再整段交给发送路径。
+ */
+typedef struct {
+    char buf[UART_LOG_LINE_SIZE];
+    size_t len;
+} uart_line_t;
+
+static void uart_line_flush(uart_line_t *line)
+{
+    if (line->len > 0) {
+        uart_write_blocking((const uint8_t*)line->buf, line->len);
+        line->len = 0;
+    }
 }
 
 /**
- * @brief 发送前将换行符规范化为 CRLF。
+ * @brief 追加到行缓冲并将 '\n' 展开为 CRLF，缓冲满时先发出已有内容。
  */
-static void uart_write_with_crlf(const char *s, size_t len)
+static void uart_line_put(uart_line_t *line, const char *s, size_t len)
 {
     for (size_t i = 0; i < len; ++i) {
-        char c = s[i];
-        if (c == '\n') {
-            const char crlf[2] = {'\r','\n'};
-            uart_write_blocking((const uint8_t*)crlf, 2);
-        } else {
-            uart_write_blocking((const uint8_t*)&c, 1);
+        if (line->len + 2 > sizeof(line->buf)) {
+            uart_line_flush(line);
+        }
+        if (s[i] == '\n') {
+            line->buf[line->len++] = '\r';
         }
+        line->buf[line->len++] = s[i];
     }
 }
 
+/**
+ * @brief debug_format 的输出回调。
+ */
+static void uart_format_out(void *ctx, const char *data, size_t len)
+{
+    uart_line_put((uart_line_t*)ctx, data, len);
+}
+
 /**
  * @brief 输出以 0 结尾的字符串（自动做 CRLF 规范化）。
  */
 void uart_puts(const char *s)
 {
+    uart_line_t line;
+
     if (s == NULL) {
         return;
     }
 
-    uart_write_with_crlf(s, strlen(s));
+    line.len = 0;
+    uart_line_put(&line, s, strlen(s));
+    uart_line_flush(&line);
 }
 
 /**
@@ -148,20 +186,15 @@ void uart_puts(const char *s)
  */
 int uart_printf(const char *fmt, ...)
 {
-    char buf[UART_LOG_BUF_SIZE];
+    uart_line_t line;
     va_list ap;
+
+    line.len = 0;
     va_start(ap, fmt);
-    int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    /* 格式化结果先进入行缓冲，末尾一次写入；DROP 模式下一行要么完整发出，要么整行丢弃 */
+    int n = debug_vformat(uart_format_out, &line, fmt, ap);
     va_end(ap);
-    if (n < 0) return n;  
-    size_t out_len = (n < (int)sizeof(buf)) ? (size_t)n : (size_t)sizeof(buf) - 1;
-    uart_write_with_crlf(buf, out_len);
-
-    /* 
-    if (n >= (int)sizeof(buf)) {
-        uart_puts("...[truncated]\n");
-    }
-    */
+    uart_line_flush(&line);
     return n;
 }
 
@@ -176,22 +209,22 @@ void uart_hexdump(const void *data, size_t len, const char *title)
     char line[80];
     for (size_t i = 0; i < len; i += 16) {
         int pos = 0;
-        pos += snprintf(line + pos, sizeof(line) - pos, "%08X  ", (unsigned)i);
+        pos += debug_snprintf(line + pos, sizeof(line) - pos, "%08X  ", (unsigned)i);
 
         /* hex */
         for (size_t j = 0; j < 16; ++j) {
-            if (i + j < len) pos += snprintf(line + pos, sizeof(line) - pos, "%02X ", p[i + j]);
-            else              pos += snprintf(line + pos, sizeof(line) - pos, "   ");
-            if (j == 7) pos += snprintf(line + pos, sizeof(line) - pos, " ");
+            if (i + j < len) pos += debug_snprintf(line + pos, sizeof(line) - pos, "%02X ", p[i + j]);
+            else              pos += debug_snprintf(line + pos, sizeof(line) - pos, "   ");
+            if (j == 7) pos += debug_snprintf(line + pos, sizeof(line) - pos, " ");
         }
 
         /* ascii */
-        pos += snprintf(line + pos, sizeof(line) - pos, " |");
+        pos += debug_snprintf(line + pos, sizeof(line) - pos, " |");
         for (size_t j = 0; j < 16 && i + j < len; ++j) {
             uint8_t c = p[i + j];
-            pos += snprintf(line + pos, sizeof(line) - pos, "%c", (c >= 32 && c <= 126) ? c : '.');
+            pos += debug_snprintf(line + pos, sizeof(line) - pos, "%c", (c >= 32 && c <= 126) ? c : '.');
         }
-        pos += snprintf(line + pos, sizeof(line) - pos, "|\n");
+        pos += debug_snprintf(line + pos, sizeof(line) - pos, "|\n");
 
         uart_puts(line);
     }
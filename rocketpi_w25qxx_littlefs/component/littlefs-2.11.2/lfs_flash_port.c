@@ -23,6 +23,21 @@
                                     FLASH_FLAG_PGSERR)
 #endif
 
+#if LFS_FLASH_PORT_BLOCK_COUNT > 32U
+#error "lfs_flash_port tracks erased sectors in a 32-bit map"
+#endif
+
+#define LFS_FLASH_PORT_BLOCK_MASK \
+    ((uint32_t)((1ULL << LFS_FLASH_PORT_BLOCK_COUNT) - 1U))
+
+/* Bit n set: sector n is erased and has not been programmed since. */
+static uint32_t s_erased_map;
+/* Set when the foreground touched the flash since the last idle pass. */
+static bool s_idle_pending;
+/* Erases issued by lfs_fs_gc() inside lfs_flash_port_idle() count as idle work. */
+static bool s_in_idle;
+static lfs_flash_port_erase_stats_t s_erase_stats;
+
 static int lfs_flash_port_read(const struct lfs_config *cfg, lfs_block_t block,
                                lfs_off_t off, void *buffer, lfs_size_t size);
 static int lfs_flash_port_prog(const struct lfs_config *cfg, lfs_block_t block,
@@ -44,6 +59,7 @@ const struct lfs_config lfs_flash_port_cfg = {
     .cache_size = LFS_FLASH_PORT_CACHE_SIZE,
     .lookahead_size = LFS_FLASH_PORT_LOOKAHEAD_SIZE,
     .block_cycles = 100,
+    .compact_thresh = 0,    /* lfs_fs_gc() compacts logs past 7/8 of a sector */
 };
 
 static inline uint32_t lfs_flash_port_block_address(lfs_block_t block)
@@ -139,6 +155,11 @@ static int lfs_flash_port_prog(const struct lfs_config *cfg, lfs_block_t block,
 
     uint32_t address = lfs_flash_port_block_address(block) + off;
 
+    s_erased_map &= ~(1UL << block);
+    if (!s_in_idle) {
+        s_idle_pending = true;
+    }
+
     HAL_FLASH_Unlock();
     lfs_flash_port_clear_flash_flags();
     HAL_StatusTypeDef status = lfs_flash_port_program(address,
@@ -153,14 +174,8 @@ static int lfs_flash_port_prog(const struct lfs_config *cfg, lfs_block_t block,
     return LFS_ERR_OK;
 }
 
-static int lfs_flash_port_erase(const struct lfs_config *cfg, lfs_block_t block)
+static int lfs_flash_port_erase_sector(lfs_block_t block)
 {
-    (void)cfg;
-
-    if (block >= LFS_FLASH_PORT_BLOCK_COUNT) {
-        return LFS_ERR_CORRUPT;
-    }
-
     FLASH_EraseInitTypeDef erase = {
         .TypeErase = FLASH_TYPEERASE_SECTORS,
         .Banks = FLASH_BANK_1,
@@ -183,19 +198,69 @@ static int lfs_flash_port_erase(const struct lfs_config *cfg, lfs_block_t block)
     return LFS_ERR_OK;
 }
 
+static bool lfs_flash_port_sector_blank(lfs_block_t block)
+{
+    const uint32_t *word = (const uint32_t *)lfs_flash_port_block_address(block);
+
+    for (uint32_t i = 0U; i < (LFS_FLASH_PORT_BLOCK_SIZE / sizeof(uint32_t)); i++) {
+        if (word[i] != 0xFFFFFFFFU) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int lfs_flash_port_erase(const struct lfs_config *cfg, lfs_block_t block)
+{
+    (void)cfg;
+
+    if (block >= LFS_FLASH_PORT_BLOCK_COUNT) {
+        return LFS_ERR_CORRUPT;
+    }
+
+    if (s_erased_map & (1UL << block)) {
+        s_erase_stats.erases_skipped++;
+        return LFS_ERR_OK;
+    }
+
+    if (s_in_idle) {
+        s_erase_stats.idle_erases++;
+    } else {
+        s_erase_stats.erases_foreground++;
+        s_idle_pending = true;
+    }
+
+    int err = lfs_flash_port_erase_sector(block);
+    if (err == LFS_ERR_OK) {
+        s_erased_map |= 1UL << block;
+    }
+
+    return err;
+}
+
 static int lfs_flash_port_sync(const struct lfs_config *cfg)
 {
     (void)cfg;
     return LFS_ERR_OK;
 }
 
+/* The flash may have changed while unmounted; relearn it in lfs_flash_port_idle(). */
+static void lfs_flash_port_reset_erase_state(void)
+{
+    s_erased_map = 0U;
+    s_idle_pending = true;
+}
+
 int lfs_flash_port_format(lfs_t *lfs)
 {
+    lfs_flash_port_reset_erase_state();
     return lfs_format(lfs, &lfs_flash_port_cfg);
 }
 
 int lfs_flash_port_mount(lfs_t *lfs)
 {
+    lfs_flash_port_reset_erase_state();
     return lfs_mount(lfs, &lfs_flash_port_cfg);
 }
 
@@ -203,3 +268,69 @@ int lfs_flash_port_unmount(lfs_t *lfs)
 {
     return lfs_unmount(lfs);
 }
+
+static int lfs_flash_port_mark_used(void *data, lfs_block_t block)
+{
+    if (block < LFS_FLASH_PORT_BLOCK_COUNT) {
+        *(uint32_t *)data |= 1UL << block;
+    }
+
+    return 0;
+}
+
+int lfs_flash_port_idle(lfs_t *lfs)
+{
+    if (!s_idle_pending) {
+        return 0;
+    }
+
+    /* Open files are included, so blocks of an unsynced write count as used. */
+    uint32_t used = 0U;
+    int err = lfs_fs_traverse(lfs, lfs_flash_port_mark_used, &used);
+    if (err < 0) {
+        return err;
+    }
+
+    uint32_t candidates = ~(used | s_erased_map) & LFS_FLASH_PORT_BLOCK_MASK;
+    if (candidates != 0U) {
+        lfs_block_t block = 0U;
+        while ((candidates & (1UL << block)) == 0U) {
+            block++;
+        }
+
+        /* A blank check reads 128 KiB in about a millisecond; an erase takes a second. */
+        if (lfs_flash_port_sector_blank(block)) {
+            s_erase_stats.idle_blank++;
+        } else {
+            err = lfs_flash_port_erase_sector(block);
+            if (err < 0) {
+                return err;
+            }
+            s_erase_stats.idle_erases++;
+        }
+        s_erased_map |= 1UL << block;
+        return 1;
+    }
+
+    /*
+     * No free sector left to prepare. Compact metadata logs now, so that the
+     * erase of the other half of the pair happens here and not when a later
+     * commit finds the log full.
+     */
+    const uint32_t erases = s_erase_stats.idle_erases;
+    s_in_idle = true;
+    err = lfs_fs_gc(lfs);
+    s_in_idle = false;
+    if (err < 0) {
+        return err;
+    }
+
+    /* A compaction may have released blocks, so look once more next time. */
+    s_idle_pending = (s_erase_stats.idle_erases != erases);
+    return s_idle_pending ? 1 : 0;
+}
+
+void lfs_flash_port_get_erase_stats(lfs_flash_port_erase_stats_t *stats)
+{
+    *stats = s_erase_stats;
+}
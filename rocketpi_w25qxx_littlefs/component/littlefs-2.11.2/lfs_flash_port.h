@@ -1,6 +1,13 @@
 /**
  * @file lfs_flash_port.h
  * @brief STM32F401 internal Flash-backed block device glue for littlefs.
+ *
+ * A 128 KiB sector erase takes about a second and stalls the CPU, because
+ * code executes from the same flash bank. lfs_flash_port_idle() moves that
+ * cost out of lfs_file_write()/lfs_file_sync(). It pre-erases free sectors
+ * and compacts nearly full metadata logs while the application is idle. The
+ * erase callback then returns immediately for sectors that are already known
+ * to be erased.
  */
 
 #ifndef LFS_FLASH_PORT_H
@@ -17,12 +24,34 @@ extern "C" {
 #define LFS_FLASH_PORT_BLOCK_SIZE   (0x20000UL)     /* 128 KiB sectors */
 #define LFS_FLASH_PORT_BLOCK_COUNT  (3U)
 
+typedef struct {
+    uint32_t idle_erases;       /* Sectors erased from lfs_flash_port_idle() */
+    uint32_t idle_blank;        /* Free sectors found blank without erasing */
+    uint32_t erases_skipped;    /* Erase requests served by a pre-erased sector */
+    uint32_t erases_foreground; /* Erase requests that had to erase in place */
+} lfs_flash_port_erase_stats_t;
+
 extern const struct lfs_config lfs_flash_port_cfg;
 
 int lfs_flash_port_format(lfs_t *lfs);
 int lfs_flash_port_mount(lfs_t *lfs);
 int lfs_flash_port_unmount(lfs_t *lfs);
 
+/*
+ * Idle-time maintenance. Call it from the main loop while the filesystem is
+ * mounted and no other littlefs call is in progress. Each call does at most
+ * one sector of work, in this order:
+ * 1. Erase (or blank-check) one sector that lfs_fs_traverse() reports as free.
+ * 2. Otherwise run lfs_fs_gc(), which compacts metadata logs past
+ *    compact_thresh.
+ * Returns 1 if a sector was erased, found blank or compacted, 0 when nothing
+ * is pending, or a negative LFS_ERR_* code.
+ * A call that erases blocks the CPU for up to 2 s, so only call it when
+ * nothing else needs to run for that long.
+ */
+int lfs_flash_port_idle(lfs_t *lfs);
+void lfs_flash_port_get_erase_stats(lfs_flash_port_erase_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
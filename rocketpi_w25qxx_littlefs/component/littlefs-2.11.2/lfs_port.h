@@ -15,6 +15,8 @@ extern "C" {
 
 #define lfs_port_cfg lfs_flash_port_cfg
 
+typedef lfs_flash_port_erase_stats_t lfs_port_erase_stats_t;
+
 static inline int lfs_port_format(lfs_t *lfs)
 {
     return lfs_flash_port_format(lfs);
@@ -30,6 +32,16 @@ static inline int lfs_port_unmount(lfs_t *lfs)
     return lfs_flash_port_unmount(lfs);
 }
 
+static inline int lfs_port_idle(lfs_t *lfs)
+{
+    return lfs_flash_port_idle(lfs);
+}
+
+static inline void lfs_port_get_erase_stats(lfs_port_erase_stats_t *stats)
+{
+    lfs_flash_port_get_erase_stats(stats);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,40 @@
+/**
+ * @file host_test.h
+ * @brief 主机测试的最小断言工具：失败时打印位置并计数，main 末尾用 HOST_TEST_DONE() 返回结果。
+ */
+#pragma once
+
+#include <stdio.h>
+
+static int host_test_failures;
+static int host_test_checks;
+
+#define CHECK(cond)                                                             \
+    do                                                                          \
+    {                                                                           \
+        ++host_test_checks;                                                     \
+        if (!(cond))                                                            \
+        {                                                                       \
+            ++host_test_failures;                                               \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);     \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                          \
+    do                                                                          \
+    {                                                                           \
+        long long host_test_a = (long long)(a);                                 \
+        long long host_test_b = (long long)(b);                                 \
+        ++host_test_checks;                                                     \
+        if (host_test_a != host_test_b)                                         \
+        {                                                                       \
+            ++host_test_failures;                                               \
+            printf("%s:%d: %s == %s failed (%lld != %lld)\n", __FILE__,        \
+                   __LINE__, #a, #b, host_test_a, host_test_b);                 \
+        }                                                                       \
+    } while (0)
+
+#define HOST_TEST_DONE()                                                        \
+    (printf("%s: %d checks, %d failed\n", __FILE__, host_test_checks,           \
+            host_test_failures),                                                \
+     host_test_failures != 0)
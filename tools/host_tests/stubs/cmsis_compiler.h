@@ -0,0 +1,57 @@
+/**
+ * @file cmsis_compiler.h
+ * @brief 主机测试用的 LDREX/STREX 替身：模拟一个独占监视器。
+ *
+ * 每次 STREX 前调用 host_exclusive_hook（若设置），测试可在其中"进入中断"执行嵌套的生产者；
+ * 中断返回会清除监视器，因此被打断的 STREX 失败并重试，与 Cortex-M 行为一致。
+ * STREX 成功后调用 host_exclusive_post_hook（若设置），模拟紧跟在这次存储之后到来的中断。
+ * host_strex_fail 非 0 时注入相应次数的伪失败。
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+extern volatile uint32_t *host_monitor;
+extern uint32_t host_strex_fail;
+extern void (*host_exclusive_hook)(void);
+extern void (*host_exclusive_post_hook)(void);
+
+static inline uint32_t __LDREXW(volatile uint32_t *p)
+{
+    host_monitor = p;
+    return *p;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *p)
+{
+    if (host_exclusive_hook != NULL)
+    {
+        host_exclusive_hook();
+    }
+    if ((host_monitor != p) || (host_strex_fail != 0U))
+    {
+        if (host_strex_fail != 0U)
+        {
+            host_strex_fail--;
+        }
+        host_monitor = NULL;
+        return 1U;
+    }
+    *p = value;
+    host_monitor = NULL;
+    if (host_exclusive_post_hook != NULL)
+    {
+        host_exclusive_post_hook();
+    }
+    return 0U;
+}
+
+static inline void __CLREX(void)
+{
+    host_monitor = NULL;
+}
+
+#ifndef __DMB
+#define __DMB()             __sync_synchronize()
+#endif
@@ -0,0 +1,6 @@
+/* 主机测试替身：CubeMX 生成的 dma.h */
+#pragma once
+
+#include "stm32f4xx_hal.h"
+
+void MX_DMA_Init(void);
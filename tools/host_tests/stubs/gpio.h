@@ -0,0 +1,6 @@
+/* 主机测试替身：CubeMX 生成的 gpio.h */
+#pragma once
+
+#include "stm32f4xx_hal.h"
+
+void MX_GPIO_Init(void);
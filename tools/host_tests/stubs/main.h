@@ -0,0 +1,4 @@
+/* 主机测试替身：CubeMX 生成的 main.h 只需提供 HAL 类型 */
+#pragma once
+
+#include "stm32f4xx_hal.h"
@@ -0,0 +1,15 @@
+/**
+ * @file stm32f4xx.h
+ * @brief 主机测试替身：设备头文件只提供 ST USB 中间件用到的 CMSIS 宏，其余转到 HAL 替身。
+ */
+#pragma once
+
+#include "stm32f4xx_hal.h"
+
+#define __IO                volatile
+#define __PACKED            __attribute__((packed))
+#define __STATIC_INLINE     static inline
+
+#ifndef UNUSED
+#define UNUSED(x)           ((void)(x))
+#endif
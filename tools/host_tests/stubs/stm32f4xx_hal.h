@@ -0,0 +1,273 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @brief 主机测试用的 HAL 替身：只提供被测模块用到的类型与函数声明。
+ *
+ * 函数由各 test_*.c 按需实现，记录调用参数供断言使用。
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum
+{
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define DISABLE 0U
+#define ENABLE  1U
+
+#define __DMB()             __sync_synchronize()
+#define __DSB()             __sync_synchronize()
+
+uint32_t HAL_GetTick(void);
+
+/* ---------------- ADC ---------------- */
+typedef struct
+{
+    uint32_t ContinuousConvMode;
+    uint32_t DMAContinuousRequests;
+    uint32_t NbrOfConversion;
+} ADC_InitTypeDef;
+
+typedef struct
+{
+    ADC_InitTypeDef Init;
+    void *DMA_Handle;
+} ADC_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *data, uint32_t length);
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc);
+
+/* ---------------- Cortex-M 中断屏蔽（主机上单线程，只记录状态） ---------------- */
+extern uint32_t host_primask;
+static inline uint32_t __get_PRIMASK(void) { return host_primask; }
+static inline void __set_PRIMASK(uint32_t value) { host_primask = value; }
+static inline void __disable_irq(void) { host_primask = 1U; }
+static inline void __enable_irq(void) { host_primask = 0U; }
+/* 由测试实现：返回非 0 表示处于中断上下文，也可在此模拟等待期间到来的中断 */
+uint32_t __get_IPSR(void);
+/* LDREX/STREX 替身，使用的测试需定义 host_monitor / host_strex_fail / host_exclusive_hook */
+#include "cmsis_compiler.h"
+
+/* ---------------- RCC ---------------- */
+#define RCC_HCLK_DIV1   0x00000000U
+#define RCC_HCLK_DIV2   0x00001000U
+
+#define RCC_OSCILLATORTYPE_HSE          0x00000001U
+#define RCC_HSE_ON                      0x00010000U
+#define RCC_PLL_ON                      0x00000002U
+#define RCC_PLLSOURCE_HSE               0x00400000U
+#define RCC_PLLP_DIV2                   0x00000002U
+#define RCC_CLOCKTYPE_SYSCLK            0x00000001U
+#define RCC_CLOCKTYPE_HCLK              0x00000002U
+#define RCC_CLOCKTYPE_PCLK1             0x00000004U
+#define RCC_CLOCKTYPE_PCLK2             0x00000008U
+#define RCC_SYSCLKSOURCE_PLLCLK         0x00000002U
+#define RCC_SYSCLK_DIV1                 0x00000000U
+#define FLASH_LATENCY_2                 0x00000002U
+#define PWR_REGULATOR_VOLTAGE_SCALE2    0x00008000U
+
+#define __HAL_RCC_PWR_CLK_ENABLE()              ((void)0)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(scale)  ((void)(scale))
+
+typedef struct
+{
+    uint32_t PLLState;
+    uint32_t PLLSource;
+    uint32_t PLLM;
+    uint32_t PLLN;
+    uint32_t PLLP;
+    uint32_t PLLQ;
+} RCC_PLLInitTypeDef;
+
+typedef struct
+{
+    uint32_t OscillatorType;
+    uint32_t HSEState;
+    RCC_PLLInitTypeDef PLL;
+} RCC_OscInitTypeDef;
+
+typedef struct
+{
+    uint32_t ClockType;
+    uint32_t SYSCLKSource;
+    uint32_t AHBCLKDivider;
+    uint32_t APB1CLKDivider;
+    uint32_t APB2CLKDivider;
+} RCC_ClkInitTypeDef;
+
+HAL_StatusTypeDef HAL_Init(void);
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *osc);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *clk, uint32_t latency);
+void HAL_RCC_GetClockConfig(RCC_ClkInitTypeDef *clk, uint32_t *latency);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+
+/* ---------------- GPIO ---------------- */
+typedef struct
+{
+    volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *port, uint16_t pin);
+
+/* ---------------- DMA：数据流寄存器为普通内存 ---------------- */
+typedef struct
+{
+    volatile uint32_t CR;
+    volatile uint32_t NDTR;
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+    DMA_Stream_TypeDef *Instance;
+    void *Parent;
+} DMA_HandleTypeDef;
+
+#define DMA_SxCR_EN                 (1U << 0)
+#define __HAL_DMA_DISABLE(h)        ((h)->Instance->CR &= ~DMA_SxCR_EN)
+#define __HAL_DMA_GET_COUNTER(h)    ((h)->Instance->NDTR)
+
+/* ---------------- UART：只有发送状态机，传输由测试在合适的时刻完成 ---------------- */
+typedef struct
+{
+    volatile uint32_t SR;
+    volatile uint32_t DR;
+    volatile uint32_t CR1;
+    volatile uint32_t CR3;
+} USART_TypeDef;
+
+extern USART_TypeDef host_usart2;
+#define USART2              (&host_usart2)
+
+typedef enum
+{
+    RESET = 0U,
+    SET = !RESET
+} FlagStatus;
+
+#define HAL_MAX_DELAY       0xFFFFFFFFU
+#define SET_BIT(reg, bit)   ((reg) |= (bit))
+#define CLEAR_BIT(reg, bit) ((reg) &= ~(bit))
+
+#define USART_SR_TC         (1U << 6)
+#define USART_SR_TXE        (1U << 7)
+#define USART_CR1_TCIE      (1U << 6)
+#define USART_CR3_DMAT      (1U << 7)
+#define UART_FLAG_TC        USART_SR_TC
+#define UART_FLAG_TXE       USART_SR_TXE
+#define __HAL_UART_GET_FLAG(h, flag)    ((((h)->Instance->SR & (flag)) == (flag)) ? SET : RESET)
+
+typedef enum
+{
+    HAL_UART_STATE_RESET = 0x00U,
+    HAL_UART_STATE_READY = 0x20U,
+    HAL_UART_STATE_BUSY_TX = 0x21U,
+    HAL_UART_STATE_BUSY_RX = 0x22U
+} HAL_UART_StateTypeDef;
+
+#define HAL_UART_RXEVENT_TC     0x00U
+#define HAL_UART_RXEVENT_HT     0x01U
+#define HAL_UART_RXEVENT_IDLE   0x02U
+typedef uint32_t HAL_UART_RxEventTypeTypeDef;
+
+typedef struct
+{
+    USART_TypeDef *Instance;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+    volatile HAL_UART_StateTypeDef gState;
+    volatile HAL_UART_StateTypeDef RxState;
+    volatile HAL_UART_RxEventTypeTypeDef RxEventType;
+} UART_HandleTypeDef;
+
+static inline HAL_UART_RxEventTypeTypeDef HAL_UARTEx_GetRxEventType(UART_HandleTypeDef *huart)
+{
+    return huart->RxEventType;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size);
+
+/* ---------------- TIM：寄存器为普通内存，预装载/影子寄存器由测试模拟 ---------------- */
+typedef struct
+{
+    volatile uint32_t CR1;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+    volatile uint32_t CCR3;
+} TIM_TypeDef;
+
+extern TIM_TypeDef host_tim3;
+#define TIM3                (&host_tim3)
+
+#define TIM_CR1_ARPE        (1U << 7)
+#define TIM_CCMR2_OC3PE     (1U << 3)
+#define TIM_EGR_UG          (1U << 0)
+#define TIM_FLAG_UPDATE     (1U << 0)
+#define TIM_CHANNEL_3       0x00000008U
+
+typedef struct
+{
+    uint32_t Prescaler;
+    uint32_t Period;
+} TIM_Base_InitTypeDef;
+
+typedef struct
+{
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+    DMA_HandleTypeDef *hdma[7];
+} TIM_HandleTypeDef;
+
+#define TIM_DMA_ID_UPDATE   0U
+#define TIM_DMA_UPDATE      (1U << 8)
+#define TIM_DCR_DBL_Pos     8U
+#define TIM_DMABASE_CCR1    0x0000000DU
+#define TIM_DMABASE_CCR4    0x00000010U
+
+#define __HAL_TIM_CLEAR_FLAG(h, flag)   ((h)->Instance->SR = ~(flag))
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t channel);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_DMABurst_MultiWriteStart(TIM_HandleTypeDef *htim, uint32_t base, uint32_t src,
+                                                   uint32_t *buffer, uint32_t length, uint32_t transfers);
+HAL_StatusTypeDef HAL_TIM_DMABurst_WriteStop(TIM_HandleTypeDef *htim, uint32_t src);
+
+/* ---------------- FLASH：编程接口，扇区擦除见 stm32f4xx_hal_flash_ex.h ---------------- */
+#define FLASH_TYPEPROGRAM_BYTE      0x00000000U
+#define FLASH_TYPEPROGRAM_HALFWORD  0x00000001U
+#define FLASH_TYPEPROGRAM_WORD      0x00000002U
+
+#define FLASH_FLAG_EOP              (1U << 0)
+#define FLASH_FLAG_OPERR            (1U << 1)
+#define FLASH_FLAG_WRPERR           (1U << 4)
+#define FLASH_FLAG_PGAERR           (1U << 5)
+#define FLASH_FLAG_PGPERR           (1U << 6)
+#define FLASH_FLAG_PGSERR           (1U << 7)
+#define FLASH_FLAG_RDERR            (1U << 8)
+#define __HAL_FLASH_CLEAR_FLAG(flag)    ((void)(flag))
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
@@ -0,0 +1,23 @@
+/* 主机测试替身：HAL FLASH 扇区擦除 */
+#pragma once
+
+#include "stm32f4xx_hal.h"
+
+typedef struct
+{
+    uint32_t TypeErase;
+    uint32_t Banks;
+    uint32_t Sector;
+    uint32_t NbSectors;
+    uint32_t VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+#define FLASH_TYPEERASE_SECTORS     0x00000000U
+#define FLASH_BANK_1                1U
+#define FLASH_VOLTAGE_RANGE_3       0x00000002U
+
+#define FLASH_SECTOR_5              5U
+#define FLASH_SECTOR_6              6U
+#define FLASH_SECTOR_7              7U
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
@@ -0,0 +1,8 @@
+/* 主机测试替身：CubeMX 生成的 usart.h */
+#pragma once
+
+#include "stm32f4xx_hal.h"
+
+extern UART_HandleTypeDef huart2;
+
+void MX_USART2_UART_Init(void);
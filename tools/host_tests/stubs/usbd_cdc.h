@@ -0,0 +1,52 @@
+/**
+ * @file usbd_cdc.h
+ * @brief 主机测试用的 USB CDC 类替身：只提供 usbd_cdc_if.c 用到的类型、常量与函数声明。
+ *
+ * USBD_CDC_* 由测试实现，模拟 OUT 端点的接收缓冲与 IN 端点的在途传输。
+ */
+#pragma once
+
+#include "stm32f4xx_hal.h"
+
+#define UNUSED(x)                           ((void)(x))
+
+#define CDC_DATA_FS_MAX_PACKET_SIZE         64U
+#define CDC_DATA_FS_IN_PACKET_SIZE          CDC_DATA_FS_MAX_PACKET_SIZE
+#define CDC_DATA_FS_OUT_PACKET_SIZE         CDC_DATA_FS_MAX_PACKET_SIZE
+
+#define CDC_SEND_ENCAPSULATED_COMMAND       0x00U
+#define CDC_GET_ENCAPSULATED_RESPONSE       0x01U
+#define CDC_SET_COMM_FEATURE                0x02U
+#define CDC_GET_COMM_FEATURE                0x03U
+#define CDC_CLEAR_COMM_FEATURE              0x04U
+#define CDC_SET_LINE_CODING                 0x20U
+#define CDC_GET_LINE_CODING                 0x21U
+#define CDC_SET_CONTROL_LINE_STATE          0x22U
+#define CDC_SEND_BREAK                      0x23U
+
+typedef enum
+{
+    USBD_OK = 0U,
+    USBD_BUSY,
+    USBD_EMEM,
+    USBD_FAIL
+} USBD_StatusTypeDef;
+
+typedef struct
+{
+    void *pClassData;
+} USBD_HandleTypeDef;
+
+typedef struct _USBD_CDC_Itf
+{
+    int8_t (*Init)(void);
+    int8_t (*DeInit)(void);
+    int8_t (*Control)(uint8_t cmd, uint8_t *pbuf, uint16_t length);
+    int8_t (*Receive)(uint8_t *Buf, uint32_t *Len);
+    int8_t (*TransmitCplt)(uint8_t *Buf, uint32_t *Len, uint8_t epnum);
+} USBD_CDC_ItfTypeDef;
+
+uint8_t USBD_CDC_SetTxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff, uint32_t length);
+uint8_t USBD_CDC_TransmitPacket(USBD_HandleTypeDef *pdev);
+uint8_t USBD_CDC_SetRxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff);
+uint8_t USBD_CDC_ReceivePacket(USBD_HandleTypeDef *pdev);
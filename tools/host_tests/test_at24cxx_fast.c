@@ -0,0 +1,497 @@
+/**
+ * @file test_at24cxx_fast.c
+ * @brief at24cxx 快速路径：在带页回绕与写周期的 EEPROM 模型上检查跨页写、脏区叠加读、缓存换页与应答轮询。
+ *
+ * 模型按器件真实行为实现：页写入时地址低位在页内回绕（跨页写会覆盖本页开头），
+ * 8 位地址器件的顺序读在 256 字节块内回绕，写周期 tWR 内任何寻址都不应答。
+ * 总线时间按 400 kHz、每字节 9 位累计，delay_ms 直接推进模拟时钟，
+ * 因此快速路径与 libdriver 固定 6 ms 等待的吞吐量可以在同一时间基准下比较。
+ */
+#include "driver_at24cxx_fast.h"
+#include "host_test.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+#define MEM_MAX         32768U
+#define BYTE_NS         22500ULL        /* 400 kHz 下 8 位数据 + 1 位应答 */
+#define EDGE_NS         2500ULL         /* 起始或停止条件 */
+#define TWR_NS          3500000ULL      /* 典型写周期，数据手册上限 5 ms */
+#define RANDOM_OPS      4000U
+
+static uint8_t s_mem[MEM_MAX];
+static uint8_t s_shadow[MEM_MAX];
+static uint32_t s_size;
+static uint16_t s_page;
+static uint64_t s_now_ns;
+static uint64_t s_busy_until_ns;
+static uint8_t s_stuck;
+
+static uint32_t s_page_writes;
+static uint32_t s_bytes_programmed;
+static uint32_t s_wraps;
+static uint32_t s_busy_nacks;
+static uint32_t s_probes;
+static uint32_t s_prints;
+static uint32_t s_last_write_addr;
+static uint16_t s_last_write_len;
+
+static uint32_t s_rand = 0x2468ACE1U;
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+
+    return s_rand >> 8;
+}
+
+static void sim_reset(uint32_t size, uint16_t page)
+{
+    uint32_t i;
+
+    s_size = size;
+    s_page = page;
+    for (i = 0U; i < size; i++)
+    {
+        s_mem[i] = (uint8_t)(i * 7U + 3U);
+    }
+    memcpy(s_shadow, s_mem, size);
+    s_now_ns = 0U;
+    s_busy_until_ns = 0U;
+    s_stuck = 0U;
+    s_page_writes = 0U;
+    s_bytes_programmed = 0U;
+    s_wraps = 0U;
+    s_busy_nacks = 0U;
+    s_probes = 0U;
+    s_prints = 0U;
+}
+
+static uint8_t sim_busy(void)
+{
+    return (uint8_t)((s_stuck != 0U) || (s_now_ns < s_busy_until_ns));
+}
+
+/* 8 位地址器件的高位地址在器件地址 bit3..1 中 */
+static uint32_t sim_base8(uint8_t addr)
+{
+    return (uint32_t)((addr >> 1) & 0x07U) << 8;
+}
+
+static uint8_t sim_write(uint32_t address, uint8_t reg_bytes, const uint8_t *buf, uint16_t len)
+{
+    uint32_t page_base = address - (address % s_page);
+    uint16_t i;
+
+    s_now_ns += 2U * EDGE_NS + BYTE_NS;
+    if (sim_busy() != 0U)
+    {
+        s_busy_nacks++;
+
+        return 1;
+    }
+    s_now_ns += (uint64_t)(reg_bytes + len) * BYTE_NS;
+
+    if ((address % s_page) + len > s_page)
+    {
+        s_wraps++;
+    }
+    for (i = 0U; i < len; i++)
+    {
+        s_mem[page_base + ((address + i) % s_page)] = buf[i];
+    }
+    s_page_writes++;
+    s_bytes_programmed += len;
+    s_last_write_addr = address;
+    s_last_write_len = len;
+    s_busy_until_ns = s_now_ns + TWR_NS;
+
+    return 0;
+}
+
+static uint8_t sim_read(uint32_t address, uint32_t wrap, uint8_t reg_bytes, uint8_t *buf, uint16_t len)
+{
+    uint32_t base = address - (address % wrap);
+    uint16_t i;
+
+    s_now_ns += 2U * EDGE_NS + BYTE_NS;
+    if (sim_busy() != 0U)
+    {
+        s_busy_nacks++;
+
+        return 1;
+    }
+    s_now_ns += (uint64_t)(reg_bytes + 1U + len) * BYTE_NS + EDGE_NS;
+
+    for (i = 0U; i < len; i++)
+    {
+        buf[i] = s_mem[base + ((address + i) % wrap)];
+    }
+
+    return 0;
+}
+
+static uint8_t iic_init(void)
+{
+    return 0;
+}
+
+static uint8_t iic_deinit(void)
+{
+    return 0;
+}
+
+static uint8_t iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return sim_read(sim_base8(addr) + reg, 256U, 1U, buf, len);
+}
+
+static uint8_t iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return sim_write(sim_base8(addr) + reg, 1U, buf, len);
+}
+
+static uint8_t iic_read16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len)
+{
+    return sim_read(reg, s_size, 2U, buf, len);
+}
+
+static uint8_t iic_write16(uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len)
+{
+    return sim_write(reg, 2U, buf, len);
+}
+
+static uint8_t iic_probe(uint8_t addr)
+{
+    s_probes++;
+    s_now_ns += 2U * EDGE_NS + BYTE_NS;
+
+    return sim_busy();
+}
+
+static void delay_ms(uint32_t ms)
+{
+    s_now_ns += (uint64_t)ms * 1000000ULL;
+}
+
+static void debug_print(const char *const fmt, ...)
+{
+    s_prints++;
+}
+
+static void dev_setup(at24cxx_handle_t *dev, at24cxx_t type, uint16_t page)
+{
+    sim_reset((uint32_t)type, page);
+    DRIVER_AT24CXX_LINK_INIT(dev, at24cxx_handle_t);
+    DRIVER_AT24CXX_LINK_IIC_INIT(dev, iic_init);
+    DRIVER_AT24CXX_LINK_IIC_DEINIT(dev, iic_deinit);
+    DRIVER_AT24CXX_LINK_IIC_READ(dev, iic_read);
+    DRIVER_AT24CXX_LINK_IIC_WRITE(dev, iic_write);
+    DRIVER_AT24CXX_LINK_IIC_READ_ADDRESS16(dev, iic_read16);
+    DRIVER_AT24CXX_LINK_IIC_WRITE_ADDRESS16(dev, iic_write16);
+    DRIVER_AT24CXX_LINK_DELAY_MS(dev, delay_ms);
+    DRIVER_AT24CXX_LINK_DEBUG_PRINT(dev, debug_print);
+    at24cxx_set_type(dev, type);
+    at24cxx_set_addr_pin(dev, AT24CXX_ADDRESS_A000);
+    CHECK_EQ(at24cxx_init(dev), 0);
+}
+
+static void fill(uint8_t *buf, uint16_t len, uint8_t seed)
+{
+    uint16_t i;
+
+    for (i = 0U; i < len; i++)
+    {
+        buf[i] = (uint8_t)(seed + i * 13U);
+    }
+}
+
+/* 跨页直接写：按页切分、逐页轮询，器件内不发生回绕 */
+static void test_cross_page_write(void)
+{
+    at24cxx_handle_t dev;
+    at24cxx_fast_handle_t fast;
+    uint8_t data[200];
+    uint8_t back[200];
+
+    dev_setup(&dev, AT24C02, 8U);
+    CHECK_EQ(at24cxx_fast_init(&fast, &dev, iic_probe), 0);
+    CHECK_EQ(fast.page_size, 8);
+
+    fill(data, 20U, 0x40U);
+    CHECK_EQ(at24cxx_fast_write(&fast, 5U, data, 20U), 0);
+    memcpy(&s_shadow[5], data, 20U);
+    CHECK_EQ(s_page_writes, 4);         /* 5..7、8..15、16..23、24 */
+    CHECK_EQ(s_wraps, 0);
+    CHECK_EQ(s_busy_nacks, 0);
+    CHECK_EQ(s_last_write_addr, 24);
+    CHECK_EQ(s_last_write_len, 1);
+    CHECK(memcmp(s_mem, s_shadow, s_size) == 0);
+    CHECK_EQ(fast.write_pending, 1);
+
+    /* 写周期内读取先轮询等待 */
+    CHECK_EQ(at24cxx_fast_read(&fast, 5U, back, 20U), 0);
+    CHECK(memcmp(back, data, 20U) == 0);
+    CHECK_EQ(fast.write_pending, 0);
+    CHECK_EQ(s_busy_nacks, 0);
+
+    /* 越界拒绝 */
+    CHECK_EQ(at24cxx_fast_write(&fast, 250U, data, 7U), 4);
+    CHECK_EQ(at24cxx_fast_read(&fast, 250U, back, 7U), 4);
+
+    /* 16 位地址器件：页长 64，跨越多页 */
+    dev_setup(&dev, AT24C256, 64U);
+    CHECK_EQ(at24cxx_fast_init(&fast, &dev, iic_probe), 0);
+    CHECK_EQ(fast.page_size, 64);
+    fill(data, 200U, 0x11U);
+    CHECK_EQ(at24cxx_fast_write(&fast, 30U, data, 200U), 0);
+    memcpy(&s_shadow[30], data, 200U);
+    CHECK_EQ(s_page_writes, 4);         /* 30..63、64..127、128..191、192..229 */
+    CHECK_EQ(s_wraps, 0);
+    CHECK_EQ(s_busy_nacks, 0);
+    CHECK(memcmp(s_mem, s_shadow, s_size) == 0);
+    CHECK_EQ(at24cxx_fast_read(&fast, 30U, back, 200U), 0);
+    CHECK(memcmp(back, data, 200U) == 0);
+}
+
+/* AT24C16 的顺序读不能跨 256 字节块，需要按块换器件地址 */
+static void test_block_split_read(void)
+{
+    at24cxx_handle_t dev;
+    at24cxx_fast_handle_t fast;
+    uint8_t back[40];
+
+    dev_setup(&dev, AT24C16, 16U);
+    CHECK_EQ(at24cxx_fast_init(&fast, &dev, iic_probe), 0);
+    CHECK_EQ(at24cxx_fast_read(&fast, 500U, back, 40U), 0);
+    CHECK(memcmp(back, &s_shadow[500], 40U) == 0);
+}
+
+/* 写合并缓存：未写回的数据叠加到读结果上，换页时写回旧页且只写脏区间 */
+static void test_cache_overlay_and_page_move(void)
+{
+    at24cxx_handle_t dev;
+    at24cxx_fast_handle_t fast;
+    uint8_t back[32];
+    const uint8_t ab[2] = {'a', 'b'};
+    const uint8_t c[1] = {'c'};
+    const uint8_t xy[2] = {'x', 'y'};
+    const uint8_t wxyz[4] = {'w', 'x', 'y', 'z'};
+
+    dev_setup(&dev, AT24C02, 8U);
+    CHECK_EQ(at24cxx_fast_init(&fast, &dev, iic_probe), 0);
+
+    CHECK_EQ(at24cxx_fast_cache_write(&fast, 3U, ab, 2U), 0);
+    CHECK_EQ(at24cxx_fast_cache_write(&fast, 4U, c, 1U), 0);
+    CHECK_EQ(s_page_writes, 0);
+    CHECK_EQ(fast.cache_page, 0);
+    CHECK_EQ(fast.dirty_lo, 3);
+    CHECK_EQ(fast.dirty_hi, 4);
+    CHECK_EQ(s_mem[3], s_shadow[3]);    /* 器件上仍是旧值 */
+    s_shadow[3] = 'a';
+    s_shadow[4] = 'c';
+
+    /* 读区间覆盖、部分覆盖、起点落在脏区间内 */
+    CHECK_EQ(at24cxx_fast_read(&fast, 0U, back, 32U), 0);
+    CHECK(memcmp(back, s_shadow, 32U) == 0);
+    CHECK_EQ(at24cxx_fast_read(&fast, 4U, back, 2U), 0);
+    CHECK_EQ(back[0], 'c');
+    CHECK_EQ(back[1], s_shadow[5]);
+    CHECK_EQ(at24cxx_fast_read(&fast, 0U, back, 4U), 0);
+    CHECK(memcmp(back, s_shadow, 4U) == 0);
+    CHECK_EQ(at24cxx_fast_read(&fast, 5U, back, 3U), 0);
+    CHECK(memcmp(back, &s_shadow[5], 3U) == 0);
+
+    /* 移到第 2 页：旧页只写回 3..4 */
+    CHECK_EQ(at24cxx_fast_cache_write(&fast, 17U, xy, 2U), 0);
+    CHECK_EQ(s_page_writes, 1);
+    CHECK_EQ(s_last_write_addr, 3);
+    CHECK_EQ(s_last_write_len, 2);
+    CHECK_EQ(s_mem[3], 'a');
+    CHECK_EQ(s_mem[4], 'c');
+    CHECK_EQ(fast.cache_page, 16);
+    s_shadow[17] = 'x';
+    s_shadow[18] = 'y';
+    CHECK(memcmp(fast.cache, &s_shadow[16], 8U) == 0);
+
+    /* 跨页缓存写：14..15 在第 1 页，16..17 回到第 2 页 */
+    CHECK_EQ(at24cxx_fast_cache_write(&fast, 14U, wxyz, 4U), 0);
+    memcpy(&s_shadow[14], wxyz, 4U);
+    CHECK_EQ(s_page_writes, 3);
+    CHECK_EQ(s_last_write_addr, 14);
+    CHECK_EQ(s_last_write_len, 2);
+    CHECK_EQ(fast.cache_page, 16);
+    CHECK_EQ(fast.dirty_lo, 0);
+    CHECK_EQ(fast.dirty_hi, 1);
+    CHECK_EQ(s_mem[17], 'x');           /* 第 2 页的新值仍在缓存中 */
+    CHECK_EQ(at24cxx_fast_read(&fast, 12U, back, 10U), 0);
+    CHECK(memcmp(back, &s_shadow[12], 10U) == 0);
+
+    /* 直接写覆盖缓存页时同步缓存，之后写回不会带回旧数据 */
+    fill(back, 8U, 0x90U);
+    CHECK_EQ(at24cxx_fast_write(&fast, 16U, back, 8U), 0);
+    memcpy(&s_shadow[16], back, 8U);
+    CHECK_EQ(at24cxx_fast_flush(&fast), 0);
+    CHECK_EQ(fast.dirty, 0);
+    CHECK_EQ(at24cxx_fast_flush(&fast), 0);
+    CHECK_EQ(at24cxx_fast_wait_ready(&fast), 0);
+    CHECK(memcmp(s_mem, s_shadow, s_size) == 0);
+
+    /* 脏区间中未改写的字节保持器件原值 */
+    CHECK_EQ(at24cxx_fast_cache_write(&fast, 40U, ab, 1U), 0);
+    CHECK_EQ(at24cxx_fast_cache_write(&fast, 47U, ab + 1, 1U), 0);
+    s_shadow[40] = 'a';
+    s_shadow[47] = 'b';
+    CHECK_EQ(at24cxx_fast_flush(&fast), 0);
+    CHECK_EQ(s_last_write_addr, 40);
+    CHECK_EQ(s_last_write_len, 8);
+    CHECK_EQ(at24cxx_fast_wait_ready(&fast), 0);
+    CHECK(memcmp(&s_mem[32], &s_shadow[32], 16U) == 0);
+    CHECK_EQ(s_wraps, 0);
+    CHECK_EQ(s_busy_nacks, 0);
+}
+
+/* 随机交替直接写、缓存写、读与写回，与逻辑内容逐字节比较 */
+static void test_random_against_shadow(at24cxx_t type, uint16_t page)
+{
+    at24cxx_handle_t dev;
+    at24cxx_fast_handle_t fast;
+    uint8_t buf[160];
+    uint32_t mismatches = 0U;
+    uint32_t op;
+
+    dev_setup(&dev, type, page);
+    CHECK_EQ(at24cxx_fast_init(&fast, &dev, iic_probe), 0);
+
+    for (op = 0U; op < RANDOM_OPS; op++)
+    {
+        uint32_t kind = rand_next() % 8U;
+        uint16_t len = (uint16_t)(1U + rand_next() % sizeof(buf));
+        uint32_t addr = rand_next() % (s_size - len + 1U);
+
+        /* 读写集中在开头几页，提高与缓存页重叠的概率 */
+        if ((rand_next() & 1U) != 0U)
+        {
+            addr %= (uint32_t)page * 4U;
+        }
+        if (kind < 2U)
+        {
+            fill(buf, len, (uint8_t)op);
+            CHECK_EQ(at24cxx_fast_write(&fast, addr, buf, len), 0);
+            memcpy(&s_shadow[addr], buf, len);
+        }
+        else if (kind < 5U)
+        {
+            fill(buf, len, (uint8_t)(op * 3U));
+            CHECK_EQ(at24cxx_fast_cache_write(&fast, addr, buf, len), 0);
+            memcpy(&s_shadow[addr], buf, len);
+        }
+        else if (kind < 7U)
+        {
+            CHECK_EQ(at24cxx_fast_read(&fast, addr, buf, len), 0);
+            if (memcmp(buf, &s_shadow[addr], len) != 0)
+            {
+                mismatches++;
+            }
+        }
+        else
+        {
+            CHECK_EQ(at24cxx_fast_flush(&fast), 0);
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(at24cxx_fast_flush(&fast), 0);
+    CHECK_EQ(at24cxx_fast_wait_ready(&fast), 0);
+    CHECK(memcmp(s_mem, s_shadow, s_size) == 0);
+    CHECK_EQ(s_wraps, 0);
+    CHECK_EQ(s_busy_nacks, 0);
+}
+
+/* 器件一直不应答：轮询突发后按毫秒等待，超过上限返回错误 */
+static void test_poll_timeout(void)
+{
+    at24cxx_handle_t dev;
+    at24cxx_fast_handle_t fast;
+    uint8_t data[4] = {1, 2, 3, 4};
+    uint64_t start;
+
+    dev_setup(&dev, AT24C02, 8U);
+    CHECK_EQ(at24cxx_fast_init(&fast, &dev, iic_probe), 0);
+    CHECK_EQ(at24cxx_fast_write(&fast, 0U, data, 4U), 0);
+    s_stuck = 1U;
+    start = s_now_ns;
+    CHECK_EQ(at24cxx_fast_write(&fast, 8U, data, 4U), 1);
+    CHECK_EQ(fast.poll_count, AT24CXX_FAST_POLL_BURST + AT24CXX_FAST_TWR_MAX_MS + 1U);
+    CHECK(s_now_ns - start >= AT24CXX_FAST_TWR_MAX_MS * 1000000ULL);
+    CHECK_EQ(s_prints, 1);
+    CHECK_EQ(s_page_writes, 1);
+
+    /* 器件恢复后继续可用 */
+    s_stuck = 0U;
+    CHECK_EQ(at24cxx_fast_write(&fast, 8U, data, 4U), 0);
+    CHECK_EQ(at24cxx_fast_wait_ready(&fast), 0);
+    CHECK(memcmp(&s_mem[8], data, 4U) == 0);
+}
+
+/* 同一模拟时钟下整片写入的吞吐量：快速路径对比 libdriver 的 8 字节分段 + 固定 6 ms 等待 */
+static double bench_write(at24cxx_t type, uint16_t page, uint8_t use_fast)
+{
+    static uint8_t data[MEM_MAX];
+    at24cxx_handle_t dev;
+    at24cxx_fast_handle_t fast;
+    uint32_t size = (uint32_t)type;
+    uint32_t addr;
+
+    dev_setup(&dev, type, page);
+    fill(data, (uint16_t)(size > 0xFFFFU ? 0xFFFFU : size), 0x5AU);
+    CHECK_EQ(at24cxx_fast_init(&fast, &dev, iic_probe), 0);
+
+    for (addr = 0U; addr < size; addr += 1024U)
+    {
+        uint16_t len = (uint16_t)((size - addr < 1024U) ? (size - addr) : 1024U);
+
+        if (use_fast != 0U)
+        {
+            CHECK_EQ(at24cxx_fast_write(&fast, addr, &data[addr], len), 0);
+        }
+        else
+        {
+            CHECK_EQ(at24cxx_write(&dev, addr, &data[addr], len), 0);
+        }
+    }
+    if (use_fast != 0U)
+    {
+        CHECK_EQ(at24cxx_fast_wait_ready(&fast), 0);
+    }
+    CHECK(memcmp(s_mem, data, size) == 0);
+    CHECK_EQ(s_busy_nacks, 0);
+
+    return (double)size * 1e9 / (double)s_now_ns;
+}
+
+static void test_throughput(void)
+{
+    double lib02 = bench_write(AT24C02, 8U, 0U);
+    double fast02 = bench_write(AT24C02, 8U, 1U);
+    double lib256 = bench_write(AT24C256, 64U, 0U);
+    double fast256 = bench_write(AT24C256, 64U, 1U);
+
+    printf("at24c02  write: libdriver %7.0f B/s, fast %7.0f B/s (x%.1f)\n", lib02, fast02, fast02 / lib02);
+    printf("at24c256 write: libdriver %7.0f B/s, fast %7.0f B/s (x%.1f)\n", lib256, fast256, fast256 / lib256);
+    CHECK(fast02 > lib02 * 1.5);
+    CHECK(fast256 > lib256 * 8.0);
+}
+
+int main(void)
+{
+    test_cross_page_write();
+    test_block_split_read();
+    test_cache_overlay_and_page_move();
+    test_random_against_shadow(AT24C02, 8U);
+    test_random_against_shadow(AT24C16, 16U);
+    test_random_against_shadow(AT24C256, 64U);
+    test_poll_timeout();
+    test_throughput();
+
+    return HOST_TEST_DONE();
+}
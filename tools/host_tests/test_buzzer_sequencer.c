@@ -0,0 +1,282 @@
+/**
+ * @file test_buzzer_sequencer.c
+ * @brief driver_buzzer_sequencer：按 TIM3 预装载语义回放步骤队列，检查实际发声时间线。
+ *
+ * 模拟定时器：每个 PWM 周期结束产生更新事件，预装载的 PSC/ARR/CCR3 此时进入影子寄存器，
+ * 然后调用 HAL_TIM_PeriodElapsedCallback。测试记录影子寄存器决定的实际输出，
+ * 合并相同音调的相邻周期，与音符表给出的时长比较（误差不超过一个 PWM 周期）。
+ */
+#include "driver_buzzer_sequencer.h"
+#include "driver_buzzer_songs.h"
+#include "host_test.h"
+#include "tim.h"
+
+#include <math.h>
+#include <string.h>
+
+#define PCLK1_HZ        42000000U
+#define TIMER_CLOCK_HZ  (2U * PCLK1_HZ)
+#define MAX_SEGMENTS    512U
+
+uint32_t host_primask;
+TIM_TypeDef host_tim3;
+TIM_HandleTypeDef htim3 = { .Instance = &host_tim3 };
+
+static int s_running;
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+
+void HAL_RCC_GetClockConfig(RCC_ClkInitTypeDef *clk, uint32_t *latency)
+{
+    clk->APB1CLKDivider = RCC_HCLK_DIV2;
+    *latency = 2U;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return PCLK1_HZ;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t channel)
+{
+    s_running = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t channel)
+{
+    s_running = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+    return HAL_OK;
+}
+
+/** 一段连续输出：频率（0 表示静音）与持续时间 */
+typedef struct
+{
+    double frequency;
+    double duration_ms;
+} segment_t;
+
+static segment_t s_segments[MAX_SEGMENTS];
+static uint32_t s_segment_count;
+static uint32_t s_shadow_psc;
+static uint32_t s_shadow_arr;
+static uint32_t s_shadow_ccr;
+static uint32_t s_last_ccr;
+static uint32_t s_ccr_rises;
+
+/** 启动时的 UG 事件：预装载值立即进入影子寄存器 */
+static void timer_force_update(void)
+{
+    s_shadow_psc = host_tim3.PSC;
+    s_shadow_arr = host_tim3.ARR;
+    s_shadow_ccr = host_tim3.CCR3;
+}
+
+/** 以当前影子寄存器跑完一个 PWM 周期，记录输出后触发更新事件 */
+static void timer_run_period(void)
+{
+    double ticks = (double)(s_shadow_psc + 1U) * (double)(s_shadow_arr + 1U);
+    double frequency = (s_shadow_ccr == 0U) ? 0.0 : TIMER_CLOCK_HZ / ticks;
+    double duration_ms = ticks * 1000.0 / TIMER_CLOCK_HZ;
+
+    if ((s_segment_count > 0U) && (s_segments[s_segment_count - 1U].frequency == frequency))
+    {
+        s_segments[s_segment_count - 1U].duration_ms += duration_ms;
+    }
+    else if (s_segment_count < MAX_SEGMENTS)
+    {
+        s_segments[s_segment_count].frequency = frequency;
+        s_segments[s_segment_count].duration_ms = duration_ms;
+        s_segment_count++;
+    }
+
+    timer_force_update();
+    HAL_TIM_PeriodElapsedCallback(&htim3);
+}
+
+static void play_to_end(void)
+{
+    uint32_t guard = 0U;
+
+    while (s_running && (guard++ < 10000000U))
+    {
+        timer_run_period();
+        /* 释放包络期间占空比只能下降 */
+        if ((host_tim3.CCR3 > s_last_ccr) && (s_last_ccr != 0U) && (host_tim3.CCR3 != 0U))
+        {
+            s_ccr_rises++;
+        }
+        s_last_ccr = host_tim3.CCR3;
+    }
+}
+
+static void reset_timeline(void)
+{
+    s_segment_count = 0U;
+    s_ccr_rises = 0U;
+    s_last_ccr = 0U;
+}
+
+/** 期望时间线：音符与间隔交替，静音段（休止符 + 前后间隔）合并 */
+static uint32_t expected_timeline(const buzzer_test_note_t *notes, uint32_t length, uint32_t gap_ms,
+                                  segment_t *out)
+{
+    uint32_t count = 0U;
+
+    for (uint32_t i = 0U; i < length; ++i)
+    {
+        double frequency = (double)notes[i].frequency_hz;
+        double duration = (notes[i].duration_ms == 0U) ? BUZZER_TEST_DEFAULT_DURATION_MS : notes[i].duration_ms;
+
+        for (int part = 0; part < 2; ++part)
+        {
+            if ((count > 0U) && ((out[count - 1U].frequency == 0.0) == (frequency == 0.0)) &&
+                ((frequency == 0.0) || (out[count - 1U].frequency == frequency)))
+            {
+                out[count - 1U].duration_ms += duration;
+            }
+            else
+            {
+                out[count].frequency = frequency;
+                out[count].duration_ms = duration;
+                count++;
+            }
+            if ((part == 1) || (i + 1U == length))
+            {
+                break;
+            }
+            frequency = 0.0;
+            duration = gap_ms;
+        }
+    }
+
+    return count;
+}
+
+/** 逐段比较：频率误差 < 0.5%，时长误差不超过一个周期（最长 1 ms 的静音载波周期） */
+static void check_timeline(const buzzer_test_note_t *notes, uint32_t length, uint32_t gap_ms)
+{
+    static segment_t expected[MAX_SEGMENTS];
+    uint32_t count = expected_timeline(notes, length, gap_ms, expected);
+
+    CHECK_EQ(s_segment_count, count);
+    for (uint32_t i = 0U; (i < count) && (i < s_segment_count); ++i)
+    {
+        double period_ms = (expected[i].frequency == 0.0) ? 1000.0 / BUZZER_SEQ_REST_FREQUENCY_HZ
+                                                          : 1000.0 / expected[i].frequency;
+
+        if (expected[i].frequency == 0.0)
+        {
+            CHECK(s_segments[i].frequency == 0.0);
+        }
+        else
+        {
+            CHECK(fabs(s_segments[i].frequency - expected[i].frequency) < expected[i].frequency * 0.005);
+        }
+        if (fabs(s_segments[i].duration_ms - expected[i].duration_ms) > period_ms * 1.01)
+        {
+            printf("segment %u: %.3f ms, expected %.3f ms\n", (unsigned)i, s_segments[i].duration_ms,
+                   expected[i].duration_ms);
+            CHECK(0);
+        }
+    }
+}
+
+int main(void)
+{
+    static const buzzer_test_note_t short_song[] =
+    {
+        {440U, 50U, 200U},
+        {0U, 0U, 100U},
+        {880U, 30U, 150U},
+        {20000U, 50U, 5U},
+        {31U, 50U, 100U},
+    };
+    const uint32_t short_len = sizeof(short_song) / sizeof(short_song[0]);
+    buzzer_seq_step_t step;
+
+    /* 单步计算：频率误差与寄存器范围 */
+    for (uint32_t f = 31U; f <= 20000U; f += 7U)
+    {
+        CHECK_EQ(buzzer_seq_build_step(TIMER_CLOCK_HZ, f, 50U, 100U, &step), 0U);
+        double actual = (double)TIMER_CLOCK_HZ / ((double)(step.psc + 1U) * (double)(step.arr + 1U));
+        CHECK(fabs(actual - f) < f * 0.001);
+        CHECK(step.ccr <= step.arr);
+        CHECK(step.periods >= 1U);
+    }
+    CHECK_EQ(buzzer_seq_build_step(0U, 440U, 50U, 100U, &step), 1U);
+
+    /* 短曲目：时间线与音符表一致 */
+    reset_timeline();
+    CHECK_EQ(buzzer_seq_enqueue(short_song, short_len, 300U), 0U);
+    CHECK_EQ(buzzer_seq_is_playing(), 1U);
+    timer_force_update();
+    play_to_end();
+    CHECK_EQ(buzzer_seq_is_playing(), 0U);
+    check_timeline(short_song, short_len, 300U);
+    CHECK_EQ(buzzer_seq_free_steps(), BUZZER_SEQ_STEP_CAPACITY);
+
+    /* 示例使用的整首曲子 */
+    reset_timeline();
+    CHECK_EQ(buzzer_seq_enqueue(buzzer_song_ode_to_joy, BUZZER_SONG_ODE_TO_JOY_LENGTH, 300U), 0U);
+    timer_force_update();
+    play_to_end();
+    check_timeline(buzzer_song_ode_to_joy, BUZZER_SONG_ODE_TO_JOY_LENGTH, 300U);
+
+    /* 播放中追加：两段之间没有额外停顿 */
+    reset_timeline();
+    CHECK_EQ(buzzer_seq_enqueue(short_song, 2U, 50U), 0U);
+    timer_force_update();
+    for (int i = 0; i < 20; ++i)
+    {
+        timer_run_period();
+    }
+    CHECK_EQ(buzzer_seq_enqueue(&short_song[2], 1U, 50U), 0U);
+    play_to_end();
+    CHECK_EQ(s_segment_count, 3U);
+    CHECK(fabs(s_segments[1].duration_ms - 150.0) < 1.01);
+    CHECK(fabs(s_segments[2].duration_ms - 150.0) < 1.0 / 880.0 * 1000.0 * 1.01);
+
+    /* 释放包络：占空比单调下降，音符总时长不变 */
+    reset_timeline();
+    CHECK_EQ(buzzer_seq_set_envelope(30U), 0U);
+    CHECK_EQ(buzzer_seq_enqueue(short_song, 1U, 0U), 0U);
+    timer_force_update();
+    play_to_end();
+    CHECK_EQ(s_ccr_rises, 0U);
+    CHECK_EQ(buzzer_seq_set_envelope(101U), 1U);
+    CHECK_EQ(buzzer_seq_set_envelope(0U), 0U);
+
+    /* 速度：200% 时长减半 */
+    reset_timeline();
+    CHECK_EQ(buzzer_seq_set_tempo(200U), 0U);
+    CHECK_EQ(buzzer_seq_enqueue(short_song, 1U, 0U), 0U);
+    timer_force_update();
+    play_to_end();
+    CHECK(fabs(s_segments[0].duration_ms - 100.0) < 1000.0 / 440.0 * 1.01);
+    CHECK_EQ(buzzer_seq_set_tempo(0U), 1U);
+    CHECK_EQ(buzzer_seq_set_tempo(100U), 0U);
+
+    /* 容量不足时整首拒绝，队列保持不变；stop 清空队列 */
+    CHECK_EQ(buzzer_seq_enqueue(buzzer_song_ode_to_joy, BUZZER_SONG_ODE_TO_JOY_LENGTH, 300U), 0U);
+    CHECK_EQ(buzzer_seq_enqueue(buzzer_song_ode_to_joy, BUZZER_SONG_ODE_TO_JOY_LENGTH, 300U), 0U);
+    uint32_t free_steps = buzzer_seq_free_steps();
+    CHECK_EQ(buzzer_seq_enqueue(buzzer_song_ode_to_joy, BUZZER_SONG_ODE_TO_JOY_LENGTH, 300U), 2U);
+    CHECK_EQ(buzzer_seq_free_steps(), free_steps);
+    CHECK_EQ(buzzer_seq_stop(), 0U);
+    CHECK_EQ(buzzer_seq_is_playing(), 0U);
+    CHECK_EQ(buzzer_seq_free_steps(), BUZZER_SEQ_STEP_CAPACITY);
+    CHECK_EQ(buzzer_seq_enqueue(NULL, 1U, 0U), 1U);
+
+    return HOST_TEST_DONE();
+}
@@ -0,0 +1,232 @@
+/**
+ * @file test_cjson_arena.c
+ * @brief cJSON_ParseArena：节点池与缓冲区分配、就地字符串、耗尽时回滚，以及与堆解析的差分比较。
+ *
+ * 通过 cJSON_InitHooks 接管 malloc/free 计数，断言 arena 解析不碰堆；
+ * 随机变异一组文档，堆解析接受的文档在复制与就地两种模式下打印结果必须与堆解析一致，
+ * 堆解析拒绝的文档 arena 也必须拒绝且不留下分配。
+ */
+#include "cJSON.h"
+#include "host_test.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NODE_COUNT      64U
+#define BUFFER_SIZE     512U
+#define FUZZ_ROUNDS     20000U
+
+static unsigned long s_heap_allocs;
+
+static void *count_malloc(size_t size)
+{
+    s_heap_allocs++;
+    return malloc(size);
+}
+
+static cJSON s_nodes[NODE_COUNT];
+static unsigned char s_buffer[BUFFER_SIZE];
+static cJSON_Arena s_arena;
+
+/** 堆上打印，返回新分配的字符串（调用者 free） */
+static char *print(const cJSON *item)
+{
+    return (item != NULL) ? cJSON_PrintUnformatted(item) : NULL;
+}
+
+/** 用指定模式解析 doc 的可写副本，失败时检查 arena 回滚 */
+static cJSON *parse_arena(char *copy, size_t len, int options)
+{
+    size_t nodes_used = s_arena.nodes_used;
+    size_t buffer_used = s_arena.buffer_used;
+    unsigned long heap = s_heap_allocs;
+    cJSON *item = cJSON_ParseArena(&s_arena, copy, len + 1U, NULL, options);
+
+    CHECK_EQ(s_heap_allocs, heap);
+    if (item == NULL)
+    {
+        CHECK_EQ(s_arena.nodes_used, nodes_used);
+        CHECK_EQ(s_arena.buffer_used, buffer_used);
+    }
+    return item;
+}
+
+/** 差分：arena 两种模式与堆解析结果一致 */
+static void differential(const char *doc)
+{
+    static char copy[1024];
+    size_t len = strlen(doc);
+    cJSON *heap_item = cJSON_Parse(doc);
+    char *expected = print(heap_item);
+
+    for (int options = 0; options <= cJSON_ArenaInSitu; options += cJSON_ArenaInSitu)
+    {
+        cJSON *item;
+        char *got;
+
+        memcpy(copy, doc, len + 1U);
+        cJSON_ArenaReset(&s_arena);
+        item = parse_arena(copy, len, options);
+        if (heap_item == NULL)
+        {
+            /* 堆解析失败时 arena 也必须失败（节点池足够大，不会因耗尽而不同） */
+            CHECK(item == NULL);
+            continue;
+        }
+        if ((item == NULL) && (s_arena.node_count == NODE_COUNT))
+        {
+            /* 节点或缓冲区不够：只允许发生在大文档上 */
+            CHECK(len > BUFFER_SIZE / 2U);
+            continue;
+        }
+        got = print(item);
+        if ((got == NULL) || (strcmp(got, expected) != 0))
+        {
+            printf("doc %s\n  heap  %s\n  arena %s\n", doc, expected, (got != NULL) ? got : "(null)");
+            CHECK(0);
+        }
+        free(got);
+    }
+    free(expected);
+    cJSON_Delete(heap_item);
+}
+
+static void mutate(char *doc, size_t *len, size_t max)
+{
+    static const char kChars[] = "{}[]\":,0123456789.-+eE truefalsn\\u00e9\"ab";
+    size_t pos = (*len == 0U) ? 0U : (size_t)rand() % *len;
+    char c = kChars[rand() % (int)(sizeof(kChars) - 1U)];
+
+    switch (rand() % 3)
+    {
+    case 0:
+        if (*len != 0U)
+        {
+            doc[pos] = c;
+        }
+        break;
+    case 1:
+        if (*len + 1U < max)
+        {
+            memmove(&doc[pos + 1U], &doc[pos], *len - pos + 1U);
+            doc[pos] = c;
+            (*len)++;
+        }
+        break;
+    default:
+        if (*len != 0U)
+        {
+            memmove(&doc[pos], &doc[pos + 1U], *len - pos);
+            (*len)--;
+        }
+        break;
+    }
+}
+
+int main(void)
+{
+    static const char *const kSeeds[] =
+    {
+        "{\"led\":\"B\",\"state\":1}",
+        "{\"led\":[\"B\",\"G\"],\"state\":[1,0]}",
+        "{\"LED\":\"all\",\"STATE\":\"off\"}",
+        "{\"a\":[1,-2.5e3,true,false,null,{\"b\":\"x\\ny\\u00e9\\\"\"}],\"c\":{}}",
+        "[0.125,\"\\ud83d\\ude00\",\"tab\\there\",[],[[[]]]]",
+    };
+    cJSON_Hooks hooks = { count_malloc, free };
+    char doc[128];
+    cJSON *item, *first;
+
+    cJSON_InitHooks(&hooks);
+    cJSON_ArenaInit(&s_arena, s_nodes, NODE_COUNT, s_buffer, BUFFER_SIZE);
+
+    /* LED 命令：复制模式字符串占缓冲区，就地模式不占；数字的临时文本解析后归还 */
+    strcpy(doc, kSeeds[1]);
+    item = parse_arena(doc, strlen(doc), 0);
+    CHECK(item != NULL);
+    CHECK_EQ(s_arena.nodes_used, 7U);
+    /* cJSON 按含引号的原始长度分配字符串，每个多占 1 字节 */
+    CHECK_EQ(s_arena.buffer_used, strlen("led") + strlen("B") + strlen("G") + strlen("state") + 4U * 2U);
+    CHECK(strcmp(cJSON_GetObjectItemCaseSensitive(item, "led")->child->next->valuestring, "G") == 0);
+    CHECK_EQ(cJSON_GetArrayItem(cJSON_GetObjectItemCaseSensitive(item, "state"), 0)->valueint, 1);
+
+    cJSON_ArenaReset(&s_arena);
+    CHECK_EQ(s_arena.nodes_used, 0U);
+    CHECK_EQ(s_arena.buffer_used, 0U);
+    strcpy(doc, kSeeds[1]);
+    item = parse_arena(doc, strlen(doc), cJSON_ArenaInSitu);
+    CHECK(item != NULL);
+    CHECK_EQ(s_arena.nodes_used, 7U);
+    CHECK_EQ(s_arena.buffer_used, 0U);
+    /* 就地模式：字符串指向输入缓冲区 */
+    {
+        const char *led = cJSON_GetObjectItemCaseSensitive(item, "led")->child->valuestring;
+        CHECK((led >= doc) && (led < doc + sizeof(doc)));
+        CHECK(strcmp(led, "B") == 0);
+    }
+
+    /* 节点池耗尽：失败并回滚，之前解析的树保持有效 */
+    cJSON_ArenaReset(&s_arena);
+    strcpy(doc, kSeeds[0]);
+    first = parse_arena(doc, strlen(doc), 0);
+    CHECK(first != NULL);
+    {
+        char big[256] = "[";
+        size_t used = s_arena.nodes_used;
+
+        for (uint32_t i = 0U; i < NODE_COUNT; ++i)
+        {
+            strcat(big, (i == 0U) ? "1" : ",1");
+        }
+        strcat(big, "]");
+        CHECK(parse_arena(big, strlen(big), 0) == NULL);
+        CHECK_EQ(s_arena.nodes_used, used);
+    }
+    CHECK(strcmp(cJSON_GetObjectItemCaseSensitive(first, "led")->valuestring, "B") == 0);
+
+    /* 缓冲区耗尽（复制模式的字符串） */
+    {
+        static unsigned char small[8];
+        cJSON_Arena arena;
+
+        cJSON_ArenaInit(&arena, s_nodes, NODE_COUNT, small, sizeof(small));
+        strcpy(doc, "[\"abc\",\"defgh\"]");
+        CHECK(cJSON_ParseArena(&arena, doc, strlen(doc) + 1U, NULL, 0) == NULL);
+        CHECK_EQ(arena.nodes_used, 0U);
+        CHECK_EQ(arena.buffer_used, 0U);
+        strcpy(doc, "[\"abc\",\"defgh\"]");
+        CHECK(cJSON_ParseArena(&arena, doc, strlen(doc) + 1U, NULL, cJSON_ArenaInSitu) != NULL);
+        CHECK(cJSON_ParseArena(NULL, doc, strlen(doc) + 1U, NULL, 0) == NULL);
+    }
+
+    /* 要求以 0 结尾：后面还有内容则失败 */
+    cJSON_ArenaReset(&s_arena);
+    strcpy(doc, "{} x");
+    CHECK(parse_arena(doc, strlen(doc), cJSON_ArenaRequireNullTerminated) == NULL);
+    strcpy(doc, "{} x");
+    CHECK(parse_arena(doc, strlen(doc), 0) != NULL);
+
+    /* 差分：种子文档与随机变异 */
+    srand(46U);
+    for (uint32_t i = 0U; i < sizeof(kSeeds) / sizeof(kSeeds[0]); ++i)
+    {
+        differential(kSeeds[i]);
+    }
+    for (uint32_t round = 0U; round < FUZZ_ROUNDS; ++round)
+    {
+        size_t len;
+        int edits = 1 + rand() % 4;
+
+        strcpy(doc, kSeeds[rand() % (int)(sizeof(kSeeds) / sizeof(kSeeds[0]))]);
+        len = strlen(doc);
+        for (int e = 0; e < edits; ++e)
+        {
+            mutate(doc, &len, sizeof(doc));
+        }
+        differential(doc);
+    }
+
+    cJSON_InitHooks(NULL);
+    return HOST_TEST_DONE();
+}
@@ -0,0 +1,290 @@
+/**
+ * @file test_debug_format.c
+ * @brief debug_format：与 glibc snprintf 逐字节比较整数、字符串、指针与 %f 的输出。
+ *
+ * 格式串由标志、宽度、精度、长度修饰和转换组合生成；浮点值覆盖特殊值、边界值和随机位模式，
+ * 精度不超过 DEBUG_FORMAT_FLOAT_DIGITS 时结果（含舍入）必须与 glibc 完全一致。
+ * 另外检查不支持的转换原样输出、缓冲区截断语义和回调的输出计数。
+ */
+#include "debug_format.h"
+#include "host_test.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FLOAT_ROUNDS    200000U
+
+static const char *const kFlags[] = { "", "-", "+", " ", "#", "0", "-0", "+0", "- ", "#0", "+#", "-+ #0" };
+static const char *const kWidths[] = { "", "1", "5", "12", "25" };
+static const char *const kPrecs[] = { "", ".", ".0", ".1", ".3", ".6", ".10", ".17", ".20" };
+
+static void report(const char *fmt, const char *expected, const char *got)
+{
+    printf("fmt \"%s\"\n  glibc \"%s\"\n  debug \"%s\"\n", fmt, expected, got);
+}
+
+/* 同一组参数分别交给 glibc 与 debug_snprintf，比较输出与返回值 */
+#define COMPARE(fmt, ...)                                                           \
+    do                                                                              \
+    {                                                                               \
+        char expected_[512];                                                        \
+        char got_[512];                                                             \
+        int n1_ = snprintf(expected_, sizeof(expected_), (fmt), __VA_ARGS__);       \
+        int n2_ = debug_snprintf(got_, sizeof(got_), (fmt), __VA_ARGS__);           \
+        int same_ = (n1_ == n2_) && (strcmp(expected_, got_) == 0);                 \
+        if (!same_)                                                                 \
+        {                                                                           \
+            report((fmt), expected_, got_);                                         \
+        }                                                                           \
+        CHECK(same_);                                                               \
+    } while (0)
+
+static void check_integer(const char *spec, const char *length, char conv, int64_t value)
+{
+    char fmt[40];
+
+    snprintf(fmt, sizeof(fmt), "[%%%s%s%c]", spec, length, conv);
+    if ((conv == 'd') || (conv == 'i'))
+    {
+        if (strcmp(length, "hh") == 0)
+        {
+            COMPARE(fmt, (signed char)value);
+        }
+        else if (strcmp(length, "h") == 0)
+        {
+            COMPARE(fmt, (short)value);
+        }
+        else if (strcmp(length, "l") == 0)
+        {
+            COMPARE(fmt, (long)value);
+        }
+        else if (strcmp(length, "ll") == 0)
+        {
+            COMPARE(fmt, (long long)value);
+        }
+        else if (strcmp(length, "j") == 0)
+        {
+            COMPARE(fmt, (intmax_t)value);
+        }
+        else if (strcmp(length, "t") == 0)
+        {
+            COMPARE(fmt, (ptrdiff_t)value);
+        }
+        else
+        {
+            COMPARE(fmt, (int)value);
+        }
+    }
+    else
+    {
+        if (strcmp(length, "hh") == 0)
+        {
+            COMPARE(fmt, (unsigned char)value);
+        }
+        else if (strcmp(length, "h") == 0)
+        {
+            COMPARE(fmt, (unsigned short)value);
+        }
+        else if (strcmp(length, "l") == 0)
+        {
+            COMPARE(fmt, (unsigned long)value);
+        }
+        else if (strcmp(length, "ll") == 0)
+        {
+            COMPARE(fmt, (unsigned long long)value);
+        }
+        else if (strcmp(length, "j") == 0)
+        {
+            COMPARE(fmt, (uintmax_t)value);
+        }
+        else if (strcmp(length, "z") == 0)
+        {
+            COMPARE(fmt, (size_t)value);
+        }
+        else
+        {
+            COMPARE(fmt, (unsigned int)value);
+        }
+    }
+}
+
+static void check_float(const char *spec, double value)
+{
+    char fmt[40];
+
+    snprintf(fmt, sizeof(fmt), "[%%%sf]", spec);
+    COMPARE(fmt, value);
+    snprintf(fmt, sizeof(fmt), "[%%%sF]", spec);
+    COMPARE(fmt, value);
+}
+
+static double random_double(void)
+{
+    uint64_t bits = 0U;
+    double value;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        bits = (bits << 16) ^ (uint64_t)(rand() & 0xFFFF);
+    }
+    switch (rand() % 4)
+    {
+    case 0:
+        /* 任意位模式，覆盖极大、极小与非规格数 */
+        break;
+    case 1:
+        /* 指数落在 2^-70..2^70，走 64 位整数与 60 位定点路径 */
+        bits = (bits & 0x800FFFFFFFFFFFFFULL) | ((uint64_t)(1023 - 70 + rand() % 141) << 52);
+        break;
+    case 2:
+        /* 十进制短小数，容易恰好落在舍入边界附近 */
+        value = (double)(rand() % 2000000 - 1000000) / 1000.0;
+        return value + ((rand() % 2) ? 0.0005 : 0.0);
+    default:
+        /* 二进制短小数，可能恰好是一半 */
+        return (double)(rand() % 100000) / (double)(1U << (rand() % 12));
+    }
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void collect(void *ctx, const char *data, size_t len)
+{
+    size_t *total = (size_t *)ctx;
+
+    CHECK(len > 0U);
+    *total += len;
+}
+
+int main(void)
+{
+    static const int64_t kValues[] =
+    {
+        0, 1, -1, 7, 8, 9, 10, 15, 16, 99, 100, -100, 255, 256, 32767, -32768, 65535,
+        2147483647LL, -2147483647LL - 1, 4294967295LL, 4294967296LL, 1000000000LL,
+        999999999999LL, -123456789012345LL, INT64_MAX, INT64_MIN,
+    };
+    static const char *const kLengths[] = { "", "hh", "h", "l", "ll", "j", "z", "t" };
+    static const char kConvs[] = { 'd', 'i', 'u', 'o', 'x', 'X' };
+    static const double kSpecials[] =
+    {
+        0.0, -0.0, 0.5, 1.5, 2.5, -2.5, 0.125, 0.05, 0.15, 0.25, 0.35, 1e-7, 9.9999995, 0.9999999,
+        123456.789, 1e15, 1e19, 18446744073709551615.0, 18446744073709551616.0, 1e22, 1e300,
+        1.7976931348623157e308, 2.2250738585072014e-308, 4.9406564584124654e-324, 3.14159265358979,
+    };
+    char spec[32];
+    char buf[16];
+    size_t total;
+
+    /* 整数：标志 × 宽度 × 精度 × 长度 × 转换 × 取值 */
+    for (size_t f = 0U; f < sizeof(kFlags) / sizeof(kFlags[0]); ++f)
+    {
+        for (size_t w = 0U; w < sizeof(kWidths) / sizeof(kWidths[0]); ++w)
+        {
+            for (size_t p = 0U; p < sizeof(kPrecs) / sizeof(kPrecs[0]); ++p)
+            {
+                snprintf(spec, sizeof(spec), "%s%s%s", kFlags[f], kWidths[w], kPrecs[p]);
+                for (size_t l = 0U; l < sizeof(kLengths) / sizeof(kLengths[0]); ++l)
+                {
+                    for (size_t c = 0U; c < sizeof(kConvs); ++c)
+                    {
+                        /* glibc 的 %zd 与 %tu 同样合法，这里只取各自常用的一边 */
+                        if (((kLengths[l][0] == 'z') && (kConvs[c] == 'd' || kConvs[c] == 'i')) ||
+                            ((kLengths[l][0] == 't') && (kConvs[c] != 'd' && kConvs[c] != 'i')))
+                        {
+                            continue;
+                        }
+                        for (size_t v = 0U; v < sizeof(kValues) / sizeof(kValues[0]); ++v)
+                        {
+                            check_integer(spec, kLengths[l], kConvs[c], kValues[v]);
+                        }
+                    }
+                }
+                /* 字符、字符串（含 NULL）、指针 */
+                {
+                    char fmt[40];
+
+                    snprintf(fmt, sizeof(fmt), "[%%%sc]", spec);
+                    COMPARE(fmt, 'A');
+                    snprintf(fmt, sizeof(fmt), "[%%%ss]", spec);
+                    COMPARE(fmt, "hello world");
+                    COMPARE(fmt, "");
+                    COMPARE(fmt, (const char *)NULL);
+                    /* %p 带 '+' 或 ' ' 是未定义行为，glibc 会输出符号，这里不比较 */
+                    if (strpbrk(kFlags[f], "+ ") == NULL)
+                    {
+                        snprintf(fmt, sizeof(fmt), "[%%%sp]", spec);
+                        COMPARE(fmt, (void *)(uintptr_t)0x2000ABCDU);
+                        COMPARE(fmt, (void *)NULL);
+                    }
+                }
+                /* 浮点：特殊值与边界值 */
+                for (size_t v = 0U; v < sizeof(kSpecials) / sizeof(kSpecials[0]); ++v)
+                {
+                    check_float(spec, kSpecials[v]);
+                    check_float(spec, -kSpecials[v]);
+                }
+                check_float(spec, INFINITY);
+                check_float(spec, -INFINITY);
+                check_float(spec, NAN);
+            }
+        }
+    }
+
+    /* 浮点：随机值 × 随机精度，包含舍入进位到整数部分 */
+    srand(48U);
+    for (uint32_t round = 0U; round < FLOAT_ROUNDS; ++round)
+    {
+        double value = random_double();
+        int prec = rand() % (DEBUG_FORMAT_FLOAT_DIGITS + 1);
+
+        COMPARE("%.*f", prec, value);
+        COMPARE("%+#.*f", prec, value);
+    }
+    COMPARE("%Lf|%.3Lf", (long double)0.1, (long double)-2.0005);
+
+    /* * 宽度与精度，负宽度转为左对齐，负精度视为未给出 */
+    COMPARE("[%*d|%-*d|%.*d|%*.*x]", 6, 42, -6, 42, 5, 42, 8, 3, 0xAB);
+    COMPARE("[%*d|%.*d|%.*s]", -4, 7, -1, 7, 3, "abcdef");
+    COMPARE("%s%%%c%5s%-5s|%05d", "a", 'b', "c", "d", -12);
+
+    /* 不支持的转换：取走参数，原样输出转换说明，后面的参数不错位 */
+    {
+        int count = 5;
+
+        CHECK_EQ(debug_snprintf(buf, sizeof(buf), "%.3e|%d", 1.5, 7), 6);
+        CHECK(strcmp(buf, "%.3e|7") == 0);
+        CHECK_EQ(debug_snprintf(buf, sizeof(buf), "%G%Lg%a%d", 1.0, (long double)2.0, 3.0, 4), 8);
+        CHECK(strcmp(buf, "%G%Lg%a4") == 0);
+        CHECK_EQ(debug_snprintf(buf, sizeof(buf), "%Le|%.1Lf", (long double)2.0, (long double)5.25), 7);
+        CHECK(strcmp(buf, "%Le|5.2") == 0);
+        CHECK_EQ(debug_snprintf(buf, sizeof(buf), "ab%nc%d", &count, 9), 6);
+        CHECK(strcmp(buf, "ab%nc9") == 0);
+        CHECK_EQ(count, 5);
+        CHECK_EQ(debug_snprintf(buf, sizeof(buf), "%y%5k"), 5);
+        CHECK(strcmp(buf, "%y%5k") == 0);
+        CHECK_EQ(debug_snprintf(buf, sizeof(buf), "tail %"), 5);
+        CHECK(strcmp(buf, "tail ") == 0);
+    }
+
+    /* 截断：总是以 0 结尾，返回完整长度；size 为 0 时不写入 */
+    memset(buf, 'x', sizeof(buf));
+    CHECK_EQ(debug_snprintf(buf, 6U, "%d-%s", 12345, "abcdef"), 12);
+    CHECK(strcmp(buf, "12345") == 0);
+    CHECK_EQ(debug_snprintf(buf, 1U, "%d", 1), 1);
+    CHECK_EQ(buf[0], '\0');
+    buf[0] = 'x';
+    CHECK_EQ(debug_snprintf(NULL, 0U, "%08.3f", 3.14159), 8);
+    CHECK_EQ(debug_snprintf(buf, 0U, "%d", 1), 1);
+    CHECK_EQ(buf[0], 'x');
+
+    /* 回调：交出的段长度之和等于返回值，且不交出空段 */
+    total = 0U;
+    CHECK_EQ(debug_format(collect, &total, "%-30s|%040.20f|%s", "x", -1.0 / 3.0, "end"), 30 + 1 + 40 + 1 + 3);
+    CHECK_EQ(total, 75U);
+
+    return HOST_TEST_DONE();
+}
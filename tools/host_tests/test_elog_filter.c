@@ -0,0 +1,301 @@
+/**
+ * @file test_elog_filter.c
+ * @brief elog.c 的标签 ID 过滤缓存：与参考模型的随机比较、编译期模块级别，以及被过滤与输出的日志的耗时对比。
+ *
+ * 与 elog.c、elog_utils.c 一起编译，elog_port_output 只计数并记下最后一行，输出锁计数加锁次数。
+ * 随机操作序列在 24 个标签上交替修改全局级别、标签过滤与按标签级别并输出日志，
+ * 标签数超过 ELOG_FILTER_TAG_ID_MAX_NUM，表满后的标签走未缓存的旧路径；每条日志是否输出与
+ * "级别 <= 全局级别、标签包含过滤串、级别 <= 该标签级别" 的模型逐条比较。
+ * 本文件以 LOG_LVL = ELOG_LVL_WARN 编译，log_i / elog_i 连同参数在预处理阶段被去掉。
+ * 耗时对比：被标签级别过滤的日志（缓存命中、表满时的旧路径）与实际输出的日志，
+ * x86 上用 TSC 计周期，其他平台用 clock_gettime 计纳秒，取五轮平均值中的最小值。
+ */
+#define LOG_TAG "filter"
+#define LOG_LVL ELOG_LVL_WARN
+
+#include "elog.h"
+#include "host_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define TAG_NUM         24U
+#define RANDOM_OPS      200000U
+#define BENCH_CALLS     100000U
+#define BENCH_ROUNDS    5U
+
+static char s_last[ELOG_LINE_BUF_SIZE + 1];
+static size_t s_lines;
+static size_t s_lock_calls;
+static uint32_t s_rand = 12345U;
+
+static char s_tags[TAG_NUM][12];
+static uint8_t s_model_tag_lvl[TAG_NUM];
+static uint8_t s_model_level;
+static char s_model_filter[8];
+
+ElogErrCode elog_port_init(void)
+{
+    return ELOG_NO_ERR;
+}
+
+ElogErrCode elog_port_deinit(void)
+{
+    return ELOG_NO_ERR;
+}
+
+void elog_port_output(const char *log, size_t size)
+{
+    memcpy(s_last, log, size);
+    s_last[size] = '\0';
+    s_lines++;
+}
+
+void elog_port_output_lock(void)
+{
+    s_lock_calls++;
+}
+
+void elog_port_output_unlock(void)
+{
+}
+
+const char *elog_port_get_time(void)
+{
+    return "12345";
+}
+
+const char *elog_port_get_p_info(void)
+{
+    return "";
+}
+
+const char *elog_port_get_t_info(void)
+{
+    return "";
+}
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+    return s_rand >> 8;
+}
+
+/** 输出一行，返回是否到达端口 */
+static int emit(uint8_t level, const char *tag)
+{
+    size_t before = s_lines;
+
+    elog_output(level, tag, __FILE__, __func__, __LINE__, "value %d", 1);
+    return s_lines != before;
+}
+
+static int model_pass(uint8_t level, size_t tag)
+{
+    return (level <= s_model_level) && (strstr(s_tags[tag], s_model_filter) != NULL) &&
+           (level <= s_model_tag_lvl[tag]);
+}
+
+static void test_compile_time_level(void)
+{
+    int side = 0;
+
+    s_lines = 0U;
+    log_i("dropped %d", side++);
+    log_d("dropped %d", side++);
+    elog_i(LOG_TAG, "dropped %d", side++);
+    CHECK_EQ(side, 0);
+    CHECK_EQ(s_lines, 0);
+    log_w("kept %d", side++);
+    log_e("kept %d", side++);
+    CHECK_EQ(side, 2);
+    CHECK_EQ(s_lines, 2);
+    CHECK(strstr(s_last, "kept 1") != NULL);
+}
+
+static void test_cached_refresh(void)
+{
+    /* 标签先进入缓存，再修改各过滤条件，缓存必须随之刷新 */
+    CHECK(emit(ELOG_LVL_DEBUG, "radar"));
+    elog_set_filter_tag_lvl("radar", ELOG_LVL_WARN);
+    CHECK(!emit(ELOG_LVL_INFO, "radar"));
+    CHECK(emit(ELOG_LVL_WARN, "radar"));
+    CHECK(emit(ELOG_LVL_INFO, "radar2"));
+    elog_set_filter_lvl(ELOG_LVL_ERROR);
+    CHECK(!emit(ELOG_LVL_WARN, "radar"));
+    CHECK(!emit(ELOG_LVL_WARN, "radar2"));
+    CHECK(emit(ELOG_LVL_ERROR, "radar2"));
+    elog_set_filter_lvl(ELOG_LVL_VERBOSE);
+    elog_set_filter_tag("dar2");
+    CHECK(!emit(ELOG_LVL_ERROR, "radar"));
+    CHECK(emit(ELOG_LVL_ERROR, "radar2"));
+    elog_set_filter_tag("");
+    elog_set_filter_tag_lvl("radar", ELOG_FILTER_LVL_SILENT);
+    CHECK(!emit(ELOG_LVL_ERROR, "radar"));
+    CHECK(emit(ELOG_LVL_ASSERT, "radar"));
+    elog_set_filter_tag_lvl("radar", ELOG_FILTER_LVL_ALL);
+    CHECK(emit(ELOG_LVL_VERBOSE, "radar"));
+    CHECK_EQ(elog_get_filter_tag_lvl("radar"), ELOG_FILTER_LVL_ALL);
+
+    /* "glbvs" 与 "yacxa" 的 FNV-1a 哈希相同，必须按标签本身区分 */
+    elog_set_filter_tag_lvl("glbvs", ELOG_LVL_ERROR);
+    CHECK(!emit(ELOG_LVL_WARN, "glbvs"));
+    CHECK(emit(ELOG_LVL_WARN, "yacxa"));
+    CHECK(!emit(ELOG_LVL_WARN, "glbvs"));
+    elog_set_filter_tag_lvl("glbvs", ELOG_FILTER_LVL_ALL);
+}
+
+static void test_random_model(void)
+{
+    static const char *const filters[] = { "", "t1", "g", "tag2", "x" };
+    size_t tag_lvl_used = 0U, emitted = 0U, suppressed = 0U;
+    size_t i, op;
+
+    for (i = 0U; i < TAG_NUM; i++)
+    {
+        snprintf(s_tags[i], sizeof(s_tags[i]), "tag%u", (unsigned)i);
+        s_model_tag_lvl[i] = ELOG_FILTER_LVL_ALL;
+    }
+    s_model_level = ELOG_LVL_VERBOSE;
+    s_model_filter[0] = '\0';
+
+    for (op = 0U; op < RANDOM_OPS; op++)
+    {
+        uint32_t r = rand_next() % 100U;
+        size_t tag = rand_next() % TAG_NUM;
+
+        if (r < 2U)
+        {
+            s_model_level = (uint8_t)(rand_next() % ELOG_LVL_TOTAL_NUM);
+            elog_set_filter_lvl(s_model_level);
+        }
+        else if (r < 4U)
+        {
+            strcpy(s_model_filter, filters[rand_next() % (sizeof(filters) / sizeof(filters[0]))]);
+            elog_set_filter_tag(s_model_filter);
+        }
+        else if (r < 8U)
+        {
+            uint8_t level = (uint8_t)(rand_next() % ELOG_LVL_TOTAL_NUM);
+
+            /* 按标签级别最多 ELOG_FILTER_TAG_LVL_MAX_NUM 个，满了只能修改或删除已有的 */
+            if ((s_model_tag_lvl[tag] != ELOG_FILTER_LVL_ALL) || (tag_lvl_used < ELOG_FILTER_TAG_LVL_MAX_NUM))
+            {
+                tag_lvl_used += (s_model_tag_lvl[tag] == ELOG_FILTER_LVL_ALL) - (level == ELOG_FILTER_LVL_ALL);
+                s_model_tag_lvl[tag] = level;
+                elog_set_filter_tag_lvl(s_tags[tag], level);
+            }
+        }
+        else
+        {
+            uint8_t level = (uint8_t)(rand_next() % ELOG_LVL_TOTAL_NUM);
+            int expected = model_pass(level, tag);
+
+            CHECK_EQ(emit(level, s_tags[tag]), expected);
+            if (expected)
+            {
+                emitted++;
+            }
+            else
+            {
+                suppressed++;
+            }
+        }
+    }
+    printf("model: %zu ops over %u tags, %zu emitted, %zu suppressed\n", (size_t)RANDOM_OPS,
+           (unsigned)TAG_NUM, emitted, suppressed);
+
+    for (i = 0U; i < TAG_NUM; i++)
+    {
+        elog_set_filter_tag_lvl(s_tags[i], ELOG_FILTER_LVL_ALL);
+    }
+    elog_set_filter_lvl(ELOG_LVL_VERBOSE);
+    elog_set_filter_tag("");
+}
+
+static uint64_t bench_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/** 五轮中每次调用的最小平均耗时 */
+static uint64_t bench(uint8_t level, const char *tag)
+{
+    uint64_t best = UINT64_MAX;
+    uint32_t round, i;
+
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        uint64_t start = bench_now(), cost;
+
+        for (i = 0U; i < BENCH_CALLS; i++)
+        {
+            elog_output(level, tag, __FILE__, __func__, __LINE__, "adc ch%d = %d mV, state 0x%08x", 3, 1650, 0x5A);
+        }
+        cost = (bench_now() - start) / BENCH_CALLS;
+        if (cost < best)
+        {
+            best = cost;
+        }
+    }
+    return best;
+}
+
+static void test_cost(void)
+{
+    uint64_t cached, uncached, emitted;
+    size_t locks, lines;
+
+    /* 所有 ID 槽位都已被 test_random_model 的标签占用，"radar" 在此之前已有槽位，"uncached" 只能走旧路径 */
+    elog_set_filter_tag_lvl("radar", ELOG_LVL_INFO);
+    elog_set_filter_tag_lvl("uncached", ELOG_LVL_INFO);
+    CHECK(!emit(ELOG_LVL_DEBUG, "radar"));
+    CHECK(!emit(ELOG_LVL_DEBUG, "uncached"));
+    CHECK(emit(ELOG_LVL_INFO, "uncached"));
+
+    /* 缓存命中的被过滤日志不加锁、不输出 */
+    locks = s_lock_calls;
+    lines = s_lines;
+    cached = bench(ELOG_LVL_DEBUG, "radar");
+    CHECK_EQ(s_lock_calls, locks);
+    CHECK_EQ(s_lines, lines);
+    uncached = bench(ELOG_LVL_DEBUG, "uncached");
+    CHECK(s_lock_calls > locks);
+    CHECK_EQ(s_lines, lines);
+    emitted = bench(ELOG_LVL_INFO, "radar");
+    CHECK_EQ(s_lines, lines + BENCH_CALLS * BENCH_ROUNDS);
+    CHECK(cached * 10U < emitted);
+#if defined(__x86_64__) || defined(__i386__)
+    printf("suppressed %llu cycles (cached tag), %llu cycles (table full), emitted %llu cycles\n",
+#else
+    printf("suppressed %llu ns (cached tag), %llu ns (table full), emitted %llu ns\n",
+#endif
+           (unsigned long long)cached, (unsigned long long)uncached, (unsigned long long)emitted);
+    elog_set_filter_tag_lvl("radar", ELOG_FILTER_LVL_ALL);
+    elog_set_filter_tag_lvl("uncached", ELOG_FILTER_LVL_ALL);
+}
+
+int main(void)
+{
+    CHECK_EQ(elog_init(), ELOG_NO_ERR);
+    elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_DEBUG, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
+    elog_set_output_enabled(true);
+
+    test_compile_time_level();
+    test_cached_refresh();
+    test_random_model();
+    test_cost();
+    return HOST_TEST_DONE();
+}
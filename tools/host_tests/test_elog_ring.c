@@ -0,0 +1,188 @@
+/**
+ * @file test_elog_ring.c
+ * @brief elog_ring：多生产者预留/提交、回绕、满时整行拒绝，以及 CAS 的 STREX 伪失败重试。
+ *
+ * 替身 STREX 在随机位置"进入中断"插入嵌套写入（最多两层），消费者穿插读取。
+ * 检查：每行完整且只出现一次；有写入者未提交时已发布位置不前进。
+ */
+#include "elog_ring.h"
+#include "host_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define RING_SIZE       256U
+#define MAX_LINES       40000U
+#define STREAM_SIZE     (MAX_LINES * 64U)
+
+volatile uint32_t *host_monitor;
+uint32_t host_strex_fail;
+void (*host_exclusive_hook)(void);
+void (*host_exclusive_post_hook)(void);
+
+static uint8_t s_storage[RING_SIZE];
+static elog_ring_t s_ring;
+static uint8_t s_written[MAX_LINES];
+static uint32_t s_next_id;
+static uint32_t s_depth;
+static char s_stream[STREAM_SIZE];
+static uint32_t s_stream_len;
+
+/** 行内容由编号决定：'<id>:' + 变长字母 + '\n' */
+static uint32_t make_line(uint32_t id, char *line)
+{
+    uint32_t len = (uint32_t)sprintf(line, "%05u:", (unsigned)id);
+    uint32_t payload = (id * 7U) % 40U;
+
+    for (uint32_t k = 0U; k < payload; ++k)
+    {
+        line[len++] = (char)('a' + (id + k) % 26U);
+    }
+    line[len++] = '\n';
+    return len;
+}
+
+static void write_line(void)
+{
+    char line[64];
+    uint32_t id = s_next_id++;
+    uint32_t len = make_line(id, line);
+
+    if (id >= MAX_LINES)
+    {
+        return;
+    }
+    s_written[id] = elog_ring_write(&s_ring, line, len) ? 1U : 0U;
+}
+
+/** 模拟中断：在外层的 STREX 之前插入一次写入，返回时清除监视器 */
+static void interrupt_hook(void)
+{
+    uint32_t busy, published;
+
+    if ((s_depth >= 2U) || ((rand() % 6) != 0))
+    {
+        return;
+    }
+    s_depth++;
+    busy = s_ring.state >> 24;
+    published = s_ring.published;
+    write_line();
+    if (busy != 0U)
+    {
+        /* 被打断的写入者尚未提交，嵌套写入不能把它的数据发布出去 */
+        CHECK_EQ(s_ring.published, published);
+    }
+    s_depth--;
+    host_monitor = NULL;
+}
+
+static void drain(uint32_t max)
+{
+    const uint8_t *data;
+    uint32_t len = elog_ring_peek(&s_ring, &data);
+
+    if (len > max)
+    {
+        len = max;
+    }
+    memcpy(&s_stream[s_stream_len], data, len);
+    s_stream_len += len;
+    elog_ring_consume(&s_ring, len);
+}
+
+static void check_stream(void)
+{
+    static uint8_t seen[MAX_LINES];
+    uint32_t pos = 0U;
+
+    while (pos < s_stream_len)
+    {
+        char expected[64];
+        unsigned id;
+        uint32_t len;
+
+        CHECK(sscanf(&s_stream[pos], "%5u:", &id) == 1);
+        if (id >= MAX_LINES)
+        {
+            CHECK(0);
+            return;
+        }
+        len = make_line(id, expected);
+        CHECK(memcmp(&s_stream[pos], expected, len) == 0);
+        CHECK_EQ(seen[id], 0U);
+        seen[id] = 1U;
+        pos += len;
+    }
+    for (uint32_t id = 0U; id < s_next_id && id < MAX_LINES; ++id)
+    {
+        CHECK_EQ(seen[id], s_written[id]);
+    }
+}
+
+int main(void)
+{
+    volatile uint32_t word = 5U;
+    uint32_t accepted = 0U;
+
+    /* CAS：伪失败时在值未变的情况下重试 */
+    host_strex_fail = 3U;
+    CHECK(elog_ring_cas(&word, 5U, 7U));
+    CHECK_EQ(word, 7U);
+    CHECK_EQ(host_strex_fail, 0U);
+    CHECK(!elog_ring_cas(&word, 5U, 9U));
+    CHECK_EQ(word, 7U);
+    host_strex_fail = 2U;
+    CHECK_EQ(elog_ring_add(&word, 3U), 10U);
+
+    /* 整块写入：超过容量或空间不足时拒绝且不改变状态 */
+    elog_ring_init(&s_ring, s_storage, RING_SIZE);
+    CHECK(!elog_ring_write(&s_ring, s_storage, RING_SIZE + 1U));
+    CHECK(!elog_ring_write(&s_ring, s_storage, 0U));
+    CHECK(elog_ring_write(&s_ring, s_storage, RING_SIZE - 10U));
+    CHECK(!elog_ring_write(&s_ring, s_storage, 11U));
+    CHECK_EQ(elog_ring_used(&s_ring), RING_SIZE - 10U);
+    CHECK(elog_ring_write(&s_ring, s_storage, 10U));
+    CHECK_EQ(elog_ring_used(&s_ring), RING_SIZE);
+    drain(RING_SIZE);
+    CHECK_EQ(elog_ring_used(&s_ring), 0U);
+    s_stream_len = 0U;
+
+    /* 随机穿插嵌套写入与部分读取，覆盖回绕与满 */
+    elog_ring_init(&s_ring, s_storage, RING_SIZE);
+    srand(7U);
+    host_exclusive_hook = interrupt_hook;
+    while (s_next_id < MAX_LINES - 4U)
+    {
+        if ((rand() % 3) != 0)
+        {
+            write_line();
+        }
+        else
+        {
+            drain((uint32_t)(rand() % 96));
+        }
+        if ((rand() % 101) == 0)
+        {
+            host_strex_fail = (uint32_t)(rand() % 3);
+        }
+    }
+    host_exclusive_hook = NULL;
+    host_strex_fail = 0U;
+    while (elog_ring_used(&s_ring) != 0U)
+    {
+        drain(RING_SIZE);
+    }
+
+    CHECK_EQ(s_ring.state >> 24, 0U);
+    check_stream();
+    for (uint32_t id = 0U; id < MAX_LINES; ++id)
+    {
+        accepted += s_written[id];
+    }
+    /* 既要覆盖满环拒绝，也要有大部分行写入成功 */
+    CHECK(accepted > MAX_LINES / 2U);
+    CHECK(accepted < s_next_id);
+
+    return HOST_TEST_DONE();
+}
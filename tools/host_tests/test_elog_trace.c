@@ -0,0 +1,309 @@
+/**
+ * @file test_elog_trace.c
+ * @brief elog_trace：二进制记录的字节格式、级别与输出开关过滤，以及与文本日志同一行的耗时对比。
+ *
+ * 与 elog.c、elog_utils.c 一起编译，端口函数由本文件实现：elog_port_output 收集文本行，
+ * elog_port_write 收集二进制记录，时间戳是递增计数。格式按 elog_trace.h 中的说明逐字节核对：
+ * 同步字、参数个数、描述符地址低 32 位、时间戳、参数字与异或校验（整条记录异或为 0）。
+ * 耗时对比按固件 main.c 的配置（颜色、级别/标签/时间格式）对同一行 "adc ch%d = %d mV, state 0x%08x"
+ * 分别调用 elog_i 与 elog_trace_i，x86 上用 TSC 计周期，其他平台用 clock_gettime 计纳秒，
+ * 每种取五轮平均值中的最小值；要求二进制记录至少快 4 倍。
+ */
+#include "elog.h"
+#include "elog_trace.h"
+#include "host_test.h"
+
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define BENCH_CALLS     100000U
+#define BENCH_ROUNDS    5U
+
+static char s_text[4096];
+static size_t s_text_len;
+static size_t s_text_lines;
+static uint8_t s_bin[4096];
+static size_t s_bin_len;
+static size_t s_bin_writes;
+static uint32_t s_timestamp;
+static int s_lock_depth;
+
+ElogErrCode elog_port_init(void)
+{
+    return ELOG_NO_ERR;
+}
+
+ElogErrCode elog_port_deinit(void)
+{
+    return ELOG_NO_ERR;
+}
+
+void elog_port_output(const char *log, size_t size)
+{
+    if (s_text_len + size > sizeof(s_text))
+    {
+        s_text_len = 0U;
+    }
+    memcpy(&s_text[s_text_len], log, size);
+    s_text_len += size;
+    s_text_lines++;
+}
+
+void elog_port_write(const char *log, size_t size)
+{
+    if (s_bin_len + size > sizeof(s_bin))
+    {
+        s_bin_len = 0U;
+    }
+    memcpy(&s_bin[s_bin_len], log, size);
+    s_bin_len += size;
+    s_bin_writes++;
+}
+
+void elog_port_output_lock(void)
+{
+    s_lock_depth++;
+}
+
+void elog_port_output_unlock(void)
+{
+    s_lock_depth--;
+}
+
+const char *elog_port_get_time(void)
+{
+    return "12345";
+}
+
+const char *elog_port_get_p_info(void)
+{
+    return "";
+}
+
+const char *elog_port_get_t_info(void)
+{
+    return "";
+}
+
+uint32_t elog_trace_port_get_timestamp(void)
+{
+    return s_timestamp;
+}
+
+static void sinks_clear(void)
+{
+    s_text_len = 0U;
+    s_text_lines = 0U;
+    s_bin_len = 0U;
+    s_bin_writes = 0U;
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/** 检查 s_bin 起始处的一条记录，返回记录长度 */
+static size_t check_record(const uint8_t *rec, uint8_t nargs, uint32_t timestamp, const uint32_t *args)
+{
+    size_t size = ELOG_TRACE_RECORD_OVERHEAD + nargs * 4U;
+    uint8_t check = 0U;
+    size_t i;
+
+    CHECK_EQ(rec[0], ELOG_TRACE_SYNC);
+    CHECK_EQ(rec[1], nargs);
+    CHECK_EQ(get_le32(&rec[6]), timestamp);
+    for (i = 0U; i < nargs; i++)
+    {
+        CHECK_EQ(get_le32(&rec[10U + i * 4U]), args[i]);
+    }
+    for (i = 0U; i < size; i++)
+    {
+        check ^= rec[i];
+    }
+    CHECK_EQ(check, 0);
+    return size;
+}
+
+static void test_record_format(void)
+{
+    static const elog_trace_desc_t desc = { "raw %u %u", "raw", "test.c", 7U, ELOG_LVL_INFO, 0U };
+    static const uint32_t adc_args[] = { 3U, (uint32_t)-1650, 0x5AU };
+    static const uint32_t raw_args[] = { 0x01020304U, 0xFFFFFFFFU };
+    uint32_t max_args[ELOG_TRACE_MAX_ARGS];
+    uint32_t desc_first, desc_second;
+    uint32_t float_arg;
+    size_t i;
+
+    /* 宏调用：3 个参数，23 字节，不经过文本输出 */
+    sinks_clear();
+    s_timestamp = 0x11223344U;
+    elog_trace_i("main", "adc ch%d = %d mV, state 0x%08x", 3, -1650, 0x5AU);
+    CHECK_EQ(s_bin_writes, 1);
+    CHECK_EQ(s_bin_len, 23);
+    CHECK_EQ(s_text_lines, 0);
+    check_record(s_bin, 3U, 0x11223344U, adc_args);
+
+    /* 同一调用点的描述符地址不变，不同调用点不同 */
+    sinks_clear();
+    for (i = 0U; i < 2U; i++)
+    {
+        elog_trace_d("main", "loop %d", (int)i);
+    }
+    elog_trace_d("main", "loop %d", 9);
+    CHECK_EQ(s_bin_len, 3U * 15U);
+    desc_first = get_le32(&s_bin[2]);
+    desc_second = get_le32(&s_bin[17]);
+    CHECK_EQ(desc_first, desc_second);
+    CHECK(get_le32(&s_bin[32]) != desc_first);
+
+    /* 直接调用：描述符地址是指针的低 32 位 */
+    sinks_clear();
+    s_timestamp = 7U;
+    elog_trace_output(&desc, 2U, desc.format, 0x01020304U, 0xFFFFFFFFU);
+    CHECK_EQ(s_bin_len, 19);
+    CHECK_EQ(get_le32(&s_bin[2]), (uint32_t)(uintptr_t)&desc);
+    check_record(s_bin, 2U, 7U, raw_args);
+
+    /* 无参数与满参数 */
+    sinks_clear();
+    elog_trace_e("main", "boot");
+    CHECK_EQ(s_bin_len, ELOG_TRACE_RECORD_OVERHEAD);
+    check_record(s_bin, 0U, 7U, NULL);
+
+    sinks_clear();
+    for (i = 0U; i < ELOG_TRACE_MAX_ARGS; i++)
+    {
+        max_args[i] = (uint32_t)(i * 0x01010101U);
+    }
+    elog_trace_w("main", "%d %d %d %d %d %d %d %d", 0, 0x01010101, 0x02020202, 0x03030303,
+                 0x04040404, 0x05050505, 0x06060606, 0x07070707);
+    CHECK_EQ(s_bin_len, ELOG_TRACE_RECORD_OVERHEAD + ELOG_TRACE_MAX_ARGS * 4U);
+    check_record(s_bin, ELOG_TRACE_MAX_ARGS, 7U, max_args);
+
+    /* 超过 ELOG_TRACE_MAX_ARGS 的直接调用整条丢弃 */
+    sinks_clear();
+    elog_trace_output(&desc, ELOG_TRACE_MAX_ARGS + 1U, desc.format, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+    CHECK_EQ(s_bin_writes, 0);
+
+    /* 浮点按 IEEE-754 位型传递 */
+    sinks_clear();
+    elog_trace_i("main", "%f", ELOG_TRACE_FLOAT(1.5f));
+    float_arg = 0x3FC00000U;
+    check_record(s_bin, 1U, 7U, &float_arg);
+    CHECK_EQ(s_lock_depth, 0);
+}
+
+static void test_filters(void)
+{
+    /* 运行时级别：高于级别的记录丢弃 */
+    sinks_clear();
+    elog_trace_set_lvl(ELOG_LVL_WARN);
+    CHECK_EQ(elog_trace_get_lvl(), ELOG_LVL_WARN);
+    elog_trace_i("main", "dropped %d", 1);
+    elog_trace_d("main", "dropped %d", 2);
+    elog_trace_v("main", "dropped %d", 3);
+    CHECK_EQ(s_bin_writes, 0);
+    elog_trace_w("main", "kept %d", 4);
+    elog_trace_e("main", "kept %d", 5);
+    elog_trace_a("main", "kept %d", 6);
+    CHECK_EQ(s_bin_writes, 3);
+    elog_trace_set_lvl(ELOG_TRACE_LVL);
+
+    /* 关闭输出时文本与记录都不输出 */
+    sinks_clear();
+    elog_set_output_enabled(false);
+    elog_trace_a("main", "off %d", 1);
+    elog_i("main", "off %d", 1);
+    CHECK_EQ(s_bin_writes, 0);
+    CHECK_EQ(s_text_lines, 0);
+    elog_set_output_enabled(true);
+    elog_trace_a("main", "on %d", 1);
+    CHECK_EQ(s_bin_writes, 1);
+}
+
+static uint64_t bench_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/** 五轮中每次调用的最小平均耗时 */
+static uint64_t bench(int trace)
+{
+    uint64_t best = UINT64_MAX;
+    uint32_t round, i;
+
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        uint64_t start = bench_now(), cost;
+
+        if (trace != 0)
+        {
+            for (i = 0U; i < BENCH_CALLS; i++)
+            {
+                elog_trace_i("main", "adc ch%d = %d mV, state 0x%08x", 3, 1650, 0x5AU);
+            }
+        }
+        else
+        {
+            for (i = 0U; i < BENCH_CALLS; i++)
+            {
+                elog_i("main", "adc ch%d = %d mV, state 0x%08x", 3, 1650, 0x5AU);
+            }
+        }
+        cost = (bench_now() - start) / BENCH_CALLS;
+        if (cost < best)
+        {
+            best = cost;
+        }
+    }
+    return best;
+}
+
+static void test_cost(void)
+{
+    uint64_t text, trace;
+    size_t text_len;
+
+    sinks_clear();
+    elog_i("main", "adc ch%d = %d mV, state 0x%08x", 3, 1650, 0x5AU);
+    text_len = s_text_len;
+    CHECK(strstr(s_text, "adc ch3 = 1650 mV, state 0x0000005a") != NULL);
+
+    text = bench(0);
+    trace = bench(1);
+    CHECK(s_text_lines >= BENCH_CALLS * BENCH_ROUNDS);
+    CHECK(s_bin_writes == BENCH_CALLS * BENCH_ROUNDS);
+    CHECK(trace * 4U < text);
+#if defined(__x86_64__) || defined(__i386__)
+    printf("elog_i %llu cycles (%zu bytes), elog_trace_i %llu cycles (23 bytes)\n",
+           (unsigned long long)text, text_len, (unsigned long long)trace);
+#else
+    printf("elog_i %llu ns (%zu bytes), elog_trace_i %llu ns (23 bytes)\n",
+           (unsigned long long)text, text_len, (unsigned long long)trace);
+#endif
+}
+
+int main(void)
+{
+    CHECK_EQ(elog_init(), ELOG_NO_ERR);
+    elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_DEBUG, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
+    elog_start();
+    CHECK(strstr(s_text, "EasyLogger V") != NULL);
+
+    test_record_format();
+    test_filters();
+    test_cost();
+    return HOST_TEST_DONE();
+}
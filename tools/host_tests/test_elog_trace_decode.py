@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+rocketpi_uart_easylogger/scripts/elog_trace_decode.py 的主机测试。
+
+按 elog_trace.h 的布局在内存里拼一个 ELF32 小端镜像（一个 PROGBITS + ALLOC 段，存放
+描述符与字符串），再把文本行与二进制记录混在一起喂给 decode()，逐行与期望输出比较：
+各种转换说明与 C printf 的结果一致，含 0xA5 字节的中文文本原样通过，坏校验、未知描述符、
+流末尾不完整的记录都不丢文本。最后经命令行跑一次完整流程。
+"""
+
+import io
+import struct
+import subprocess
+import sys
+import tempfile
+import unittest
+from pathlib import Path
+
+SCRIPT = Path(__file__).resolve().parents[2] / "rocketpi_uart_easylogger" / "scripts" / "elog_trace_decode.py"
+sys.path.insert(0, str(SCRIPT.parent))
+
+import elog_trace_decode as decoder  # noqa: E402
+
+BASE = 0x08001000
+LVL_INFO = 3
+
+
+class Image:
+    """描述符与字符串池，build() 生成 ELF32 文件内容。"""
+
+    def __init__(self) -> None:
+        self.data = bytearray()
+        self.strings: dict[str, int] = {}
+
+    def string(self, text: str) -> int:
+        if text not in self.strings:
+            self.strings[text] = BASE + len(self.data)
+            self.data += text.encode("utf-8") + b"\0"
+            self.align()
+        return self.strings[text]
+
+    def desc(self, fmt: str, tag: str = "main", file: str = "Core\\Src\\main.c", line: int = 42,
+             level: int = LVL_INFO) -> int:
+        fields = (self.string(fmt), self.string(tag), self.string(file))
+        addr = BASE + len(self.data)
+        self.data += struct.pack("<IIIHBB", *fields, line, level, 0)
+        return addr
+
+    def align(self) -> None:
+        self.data += b"\0" * (-len(self.data) % 4)
+
+    def build(self) -> bytes:
+        shoff = 52 + len(self.data)
+        header = b"\x7fELF" + bytes([1, 1, 1]) + b"\0" * 9
+        header += struct.pack("<HHIIIIIHHHHHH", 2, 40, 1, BASE, 0, shoff, 0, 52, 0, 0, 40, 3, 0)
+        sections = b"\0" * 40
+        sections += struct.pack("<IIIIIIIIII", 0, 1, 0x2 | 0x4, BASE, 52, len(self.data), 0, 0, 4, 0)
+        # 非 ALLOC 段（例如 .comment）必须被忽略
+        sections += struct.pack("<IIIIIIIIII", 0, 1, 0, 0, 52, len(self.data), 0, 0, 1, 0)
+        return header + bytes(self.data) + sections
+
+
+def record(desc: int, timestamp: int, *args: int) -> bytes:
+    body = bytes([decoder.SYNC, len(args)]) + struct.pack(f"<II{len(args)}I", desc, timestamp,
+                                                          *[a & 0xFFFFFFFF for a in args])
+    check = 0
+    for b in body:
+        check ^= b
+    return body + bytes([check])
+
+
+def float_bits(value: float) -> int:
+    return struct.unpack("<I", struct.pack("<f", value))[0]
+
+
+class ChunkReader:
+    """每次最多返回 size 字节，记录被切在任意位置。"""
+
+    def __init__(self, data: bytes, size: int) -> None:
+        self.stream = io.BytesIO(data)
+        self.size = size
+
+    def read(self, n: int) -> bytes:
+        return self.stream.read(min(n, self.size))
+
+
+class DecodeTest(unittest.TestCase):
+    def setUp(self) -> None:
+        self.image_data = Image()
+        self.tmp = tempfile.TemporaryDirectory()
+        self.addCleanup(self.tmp.cleanup)
+
+    def image(self) -> decoder.ElfImage:
+        path = Path(self.tmp.name) / "fw.axf"
+        path.write_bytes(self.image_data.build())
+        return decoder.ElfImage(path)
+
+    def decode(self, stream: bytes, chunk: int | None = None) -> list[str]:
+        image = self.image()
+        if chunk is None:
+            return list(decoder.decode(io.BytesIO(stream), image))
+        return list(decoder.decode(ChunkReader(stream, chunk), image))  # type: ignore[arg-type]
+
+    def expand(self, fmt: str, *args: int) -> str:
+        desc = self.image_data.desc(fmt)
+        line, = self.decode(record(desc, 5, *args))
+        prefix = "I/main     [5] "
+        self.assertTrue(line.startswith(prefix), line)
+        self.assertTrue(line.endswith(" (main.c:42)"), line)
+        return line[len(prefix):-len(" (main.c:42)")]
+
+    def test_conversions(self) -> None:
+        cases = [
+            ("adc ch%d = %d mV, state 0x%08x", (3, -1650, 0x5A), "adc ch3 = -1650 mV, state 0x0000005a"),
+            ("%i %u %+d % d", (-1, -1, 7, 7), "-1 4294967295 +7  7"),
+            ("%5d|%-5d|%05d", (42, 42, -42), "   42|42   |-0042"),
+            ("%x %X %#x %#X %#x", (0xBEEF, 0xBEEF, 255, 255, 0), "beef BEEF 0xff 0XFF 0"),
+            ("%o %#o %#6o %#-6o| %#o", (8, 15, 15, 15, 0), "10 017    017 017   | 0"),
+            ("%c%c%c", (ord("o"), ord("k"), 0x121), "ok!"),
+            ("%*d|%-*d|%.*d", (6, 12, 4, 3, 3, 5), "    12|3   |005"),
+            ("100%% %lu %ld", (3, -3), "100% 3 -3"),
+            ("%p", (0x20000010,), "0x20000010"),
+            ("%f %.2f %e %E %g %G %F", tuple(float_bits(v) for v in (1.5, -0.125, 1e-5, 1e-5, 2.5e10, 2.5e10, 3.0)),
+             "1.500000 -0.12 1.000000e-05 1.000000E-05 2.5e+10 2.5E+10 3.000000"),
+        ]
+        for fmt, args, expected in cases:
+            with self.subTest(fmt=fmt):
+                self.assertEqual(self.expand(fmt, *args), expected)
+
+    def test_strings_and_levels(self) -> None:
+        name = self.image_data.string("sensor")
+        desc_w = self.image_data.desc("%s=%.3s|%8s", tag="radar", file="bsp/x.c", line=7, level=2)
+        desc_v = self.image_data.desc("v", tag="t", line=1, level=5)
+        desc_bad = self.image_data.desc("?", level=9)
+        lines = self.decode(record(desc_w, 1, name, name, name) + record(desc_v, 2) + record(desc_bad, 3)
+                            + record(desc_w, 4, 0x1234, name, name))
+        self.assertEqual(lines, [
+            "W/radar    [1] sensor=sen|  sensor (x.c:7)",
+            "V/t        [2] v (main.c:1)",
+            "?/main     [3] ? (main.c:42)",
+            "W/radar    [4] <0x00001234>=sen|  sensor (x.c:7)",
+        ])
+
+    def test_interleaved_text(self) -> None:
+        desc = self.image_data.desc("n=%d")
+        # "亥" 的 UTF-8 编码是 E4 BA A5，A5 后面跟 '\n' 看起来像 nargs = 10 的记录头
+        stream = ("I/main 开始\r\n亥\n".encode("utf-8") + record(desc, 1, 1) + b"plain " + record(desc, 2, 2)
+                  + b"tail\r\n" + bytes([0xA5, 0x20]) + "亥".encode("utf-8"))
+        expected = ["I/main 开始", "亥", "I/main     [1] n=1 (main.c:42)",
+                    "I/main     [2] n=2 (main.c:42)", "plain tail", "� 亥"]
+        self.assertEqual(self.decode(stream), expected)
+        for chunk in (1, 2, 3, 7, 11):
+            with self.subTest(chunk=chunk):
+                self.assertEqual(self.decode(stream, chunk), expected)
+
+    def test_damaged_records(self) -> None:
+        desc = self.image_data.desc("n=%d")
+        good = record(desc, 1, 7)
+        bad = bytearray(good)
+        bad[10] ^= 0x01
+        lines = self.decode(bytes(bad) + b"\n" + good)
+        # 坏校验的记录退化为文本，后面的记录照常解码
+        self.assertEqual(len(lines), 2)
+        self.assertEqual(lines[1], "I/main     [1] n=7 (main.c:42)")
+
+        lines = self.decode(record(0x20000000, 9, 1, 2))
+        self.assertEqual(lines, ["?/trace  [9] unknown descriptor 0x20000000 args=[1, 2]"])
+
+        # 流末尾不完整的记录：字节作为文本输出，之前的文本不丢
+        lines = self.decode(b"last line\n" + good[:-3])
+        self.assertEqual(lines[0], "last line")
+        self.assertEqual(len(lines), 2)
+        self.assertEqual(lines[1].encode("utf-8", errors="replace")[:1], b"\xef")
+
+        # nargs 超过上限的同步字直接当作文本
+        self.assertEqual(self.decode(bytes([0xA5, 16]) + b"x\n"), ["�\x10x"])
+
+    def test_elf_rejects(self) -> None:
+        path = Path(self.tmp.name) / "bad.axf"
+        path.write_bytes(b"\x7fELF" + bytes([2, 1]) + b"\0" * 60)
+        with self.assertRaises(ValueError):
+            decoder.ElfImage(path)
+
+    def test_cli(self) -> None:
+        desc = self.image_data.desc("boot %u ms", tag="main")
+        elf = Path(self.tmp.name) / "fw.axf"
+        elf.write_bytes(self.image_data.build())
+        capture = Path(self.tmp.name) / "capture.bin"
+        capture.write_bytes(b"hello\r\n" + record(desc, 100, 250))
+        result = subprocess.run([sys.executable, str(SCRIPT), str(elf), str(capture)],
+                                capture_output=True, check=True)
+        self.assertEqual(result.stdout.decode("utf-8").splitlines(),
+                         ["hello", "I/main     [100] boot 250 ms (main.c:42)"])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,1038 @@
+/**
+ * @file test_esp8266_at.c
+ * @brief ESP8266 AT 驱动的主机测试：事件行 arena 与描述符队列、+IPD 二进制接收、异步命令流水线与 URC 路由。
+ *
+ * 接口层替身记录发送内容并提供可控的节拍，接收字节直接经 esp8266_at_receive_bytes 注入。
+ * 每条注入的行带有序号，取出的事件按序号与生成记录核对：
+ *   1. 取出的事件保持注入顺序，文本、长度、类型、前缀与载荷位置正确；
+ *   2. 已取出事件的 raw_line 在下一次取事件前不会被新行覆盖；
+ *   3. 注入行数 == 已取出 + 排队中 + 丢弃计数，丢弃只发生在消费者落后时；
+ *   4. 短行受队列深度限制、长行受 arena 容量限制，超长行被丢弃后解析继续；
+ *   5. 参数按需切分：引号内逗号、空参数、去空白与去引号。
+ * +IPD 流由单链路、多链路与带 CIPDINFO 地址（含 IPv6）的帧和普通行混合而成，数据中嵌入伪帧头，
+ * 按随机块（含逐字节）馈入后，各链路收到的字节与观察到的行序列必须和生成记录一致。
+ * 流水线由脚本化的模组随机回复 OK / ERROR / busy 或不回复，检查回调顺序、状态、退避间隔与重发次数；
+ * URC 路由对命令表与 URC 表中的每个键检查注册、大小写无关的命中、注销与在途命令的应答不被路由。
+ * 两个 ESP8266 示例中的驱动副本相同，这里编译 rocketpi_esp8266 中的一份。
+ */
+#include "driver_esp8266_at.h"
+#include "driver_esp8266_at_interface.h"
+#include "host_test.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HISTORY         64U
+#define FUZZ_LINES      200000U
+
+/* ---------------- 接口层替身 ---------------- */
+
+static uint32_t s_tick;
+static char s_tx[4096];
+static size_t s_tx_length;
+
+esp8266_at_status_t esp8266_at_interface_hw_init(void)
+{
+    return ESP8266_AT_STATUS_OK;
+}
+
+esp8266_at_status_t esp8266_at_interface_hw_send(const uint8_t *data, size_t length, uint32_t timeout_ms)
+{
+    if (s_tx_length + length < sizeof(s_tx))
+    {
+        memcpy(&s_tx[s_tx_length], data, length);
+        s_tx_length += length;
+        s_tx[s_tx_length] = '\0';
+    }
+    return ESP8266_AT_STATUS_OK;
+}
+
+uint32_t esp8266_at_interface_hw_get_tick(void)
+{
+    return s_tick;
+}
+
+void esp8266_at_interface_hw_restart_rx(void)
+{
+}
+
+uint32_t esp8266_at_interface_hw_enter_critical(void)
+{
+    return 0U;
+}
+
+void esp8266_at_interface_hw_exit_critical(uint32_t state)
+{
+}
+
+void esp8266_at_interface_flush_trace(void)
+{
+}
+
+/* ---------------- 工具 ---------------- */
+
+static uint32_t s_rand = 0x0BADF00DU;
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+    return s_rand >> 8;
+}
+
+static void restart(void)
+{
+    esp8266_at_deinit();
+    CHECK_EQ(esp8266_at_init(), ESP8266_AT_STATUS_OK);
+    s_tx_length = 0U;
+    s_tx[0] = '\0';
+}
+
+static void feed(const char *text)
+{
+    esp8266_at_receive_bytes((const uint8_t *)text, strlen(text));
+}
+
+static void feed_line(const char *line)
+{
+    feed(line);
+    feed("\r\n");
+}
+
+/* ---------------- arena 与事件队列 ---------------- */
+
+/* 注入行的记录：序号 -> 期望文本（已去掉首尾空白）与前缀长度 */
+typedef struct
+{
+    char text[ESP8266_AT_MAX_LINE_LENGTH];
+    uint16_t length;
+    uint8_t prefix_length;
+    esp8266_at_event_type_t type;
+} expected_line_t;
+
+static expected_line_t s_history[HISTORY];
+
+/* 生成一行 "<头>#<序号>#<填充>"：头决定类型，填充长度随机（偶尔接近行长上限） */
+static void make_line(uint32_t seq, expected_line_t *out)
+{
+    static const char *const heads[] = {"+CWLAP:", "+CIPSTA:ip", "+MQTTSUBRECV:0", "info", "+NOTAKEY:"};
+    const uint32_t h = rand_next() % 5U;
+    const uint32_t r = rand_next() % 16U;
+    const size_t max_fill = (r == 0U) ? 200U : ((r < 4U) ? 60U : 12U);
+    const size_t fill = rand_next() % (max_fill + 1U);
+    int n = snprintf(out->text, sizeof(out->text), "%s#%u#", heads[h], (unsigned)seq);
+
+    for (size_t i = 0U; i < fill; ++i)
+    {
+        static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789 ,.=\"";
+        out->text[n++] = alphabet[rand_next() % (sizeof(alphabet) - 1U)];
+    }
+    while (n > 0 && out->text[n - 1] == ' ')
+    {
+        --n;
+    }
+    out->text[n] = '\0';
+    out->length = (uint16_t)n;
+
+    if (out->text[0] == '+')
+    {
+        out->type = ESP8266_AT_EVENT_TYPE_RESPONSE;
+        out->prefix_length = (uint8_t)(strpbrk(out->text, ":=") - out->text);
+    }
+    else
+    {
+        out->type = ESP8266_AT_EVENT_TYPE_INFO;
+        out->prefix_length = 0U;
+    }
+}
+
+static uint32_t line_seq(const char *line)
+{
+    const char *hash = strchr(line, '#');
+    return (hash != NULL) ? (uint32_t)strtoul(hash + 1, NULL, 10) : UINT32_MAX;
+}
+
+static void check_event(const esp8266_at_event_t *event, const expected_line_t *want)
+{
+    CHECK_EQ(event->line_length, want->length);
+    CHECK(strcmp(event->raw_line, want->text) == 0);
+    CHECK_EQ(event->type, want->type);
+    CHECK_EQ(event->prefix_length, want->prefix_length);
+    if (want->prefix_length != 0U)
+    {
+        /* 载荷紧跟在 ':' 或 '=' 之后（跳过空格） */
+        const char *payload = want->text + want->prefix_length + 1;
+        while (*payload == ' ')
+        {
+            ++payload;
+        }
+        CHECK(strcmp(event->payload, payload) == 0);
+    }
+    else
+    {
+        CHECK(event->payload == event->raw_line);
+    }
+}
+
+/*
+ * 消费者随机落后：每注入若干行才取若干个事件，并在取出后继续注入，
+ * 检查已取出事件的文本在下一次取之前保持不变。
+ */
+static void test_arena_fuzz(void)
+{
+    esp8266_at_event_t held;
+    char held_copy[ESP8266_AT_MAX_LINE_LENGTH];
+    bool held_valid = false;
+    uint32_t next_seq = 0U;
+    uint32_t last_fetched = UINT32_MAX;
+    uint32_t fetched = 0U;
+    uint32_t max_pending = 0U;
+
+    restart();
+    while (next_seq < FUZZ_LINES)
+    {
+        /* 注入一批 */
+        const uint32_t burst = rand_next() % 12U;
+        for (uint32_t i = 0U; i < burst; ++i)
+        {
+            expected_line_t *line = &s_history[next_seq % HISTORY];
+            make_line(next_seq, line);
+            ++next_seq;
+            feed_line(line->text);
+
+            if (held_valid)
+            {
+                CHECK(strcmp(held.raw_line, held_copy) == 0);
+            }
+        }
+        if (esp8266_at_pending_event_count() > max_pending)
+        {
+            max_pending = (uint32_t)esp8266_at_pending_event_count();
+        }
+
+        /* 取出一批 */
+        const uint32_t take = rand_next() % 12U;
+        for (uint32_t i = 0U; i < take; ++i)
+        {
+            esp8266_at_event_t event;
+            if (!esp8266_at_fetch_event(&event))
+            {
+                CHECK_EQ(esp8266_at_pending_event_count(), 0U);
+                held_valid = false;
+                break;
+            }
+
+            const uint32_t seq = line_seq(event.raw_line);
+            CHECK(last_fetched == UINT32_MAX || seq > last_fetched);
+            CHECK(seq < next_seq && next_seq - seq <= HISTORY);
+            if (seq < next_seq && next_seq - seq <= HISTORY)
+            {
+                check_event(&event, &s_history[seq % HISTORY]);
+            }
+            last_fetched = seq;
+            ++fetched;
+
+            held = event;
+            strcpy(held_copy, event.raw_line);
+            held_valid = true;
+        }
+
+        CHECK_EQ(next_seq, fetched + esp8266_at_pending_event_count() + esp8266_at_dropped_event_count());
+    }
+
+    printf("arena: %u lines, %u fetched, %u dropped while the consumer lagged, peak queue %u\n",
+           (unsigned)next_seq, (unsigned)fetched, (unsigned)esp8266_at_dropped_event_count(),
+           (unsigned)max_pending);
+}
+
+/* 消费者跟得上时不丢行 */
+static void test_arena_no_loss(void)
+{
+    restart();
+    for (uint32_t seq = 0U; seq < 20000U; ++seq)
+    {
+        expected_line_t *line = &s_history[seq % HISTORY];
+        esp8266_at_event_t event;
+
+        make_line(seq, line);
+        feed_line(line->text);
+        CHECK(esp8266_at_fetch_event(&event));
+        CHECK_EQ(line_seq(event.raw_line), seq);
+        check_event(&event, line);
+    }
+    CHECK_EQ(esp8266_at_dropped_event_count(), 0U);
+}
+
+static void test_arena_capacity(void)
+{
+    char line[ESP8266_AT_MAX_LINE_LENGTH];
+    esp8266_at_event_t event;
+
+    /* 短行：受队列深度限制，满后丢最旧的 */
+    restart();
+    for (uint32_t i = 0U; i < ESP8266_AT_EVENT_QUEUE_DEPTH + 3U; ++i)
+    {
+        (void)snprintf(line, sizeof(line), "short#%u#", (unsigned)i);
+        feed_line(line);
+    }
+    CHECK_EQ(esp8266_at_pending_event_count(), ESP8266_AT_EVENT_QUEUE_DEPTH);
+    CHECK_EQ(esp8266_at_dropped_event_count(), 3U);
+    CHECK(esp8266_at_fetch_event(&event));
+    CHECK_EQ(line_seq(event.raw_line), 3U);
+
+    /* 最长行（255 字节 + NUL）：arena 正好容纳 4 行。持有第一行时队列里最多 3 行，
+     * 此后的新行放不下，只丢新行，不清掉已排队的行 */
+    restart();
+    for (uint32_t i = 0U; i < 6U; ++i)
+    {
+        const int n = snprintf(line, sizeof(line), "long#%u#", (unsigned)i);
+        memset(&line[n], 'x', sizeof(line) - 1U - (size_t)n);
+        line[sizeof(line) - 1U] = '\0';
+        feed_line(line);
+        if (i == 0U)
+        {
+            CHECK(esp8266_at_fetch_event(&event));
+        }
+    }
+    CHECK_EQ(event.line_length, ESP8266_AT_MAX_LINE_LENGTH - 1U);
+    CHECK_EQ(line_seq(event.raw_line), 0U);
+    CHECK(event.raw_line[ESP8266_AT_MAX_LINE_LENGTH - 2U] == 'x');
+    CHECK_EQ(esp8266_at_pending_event_count(), 3U);
+    CHECK_EQ(esp8266_at_dropped_event_count(), 2U);
+    CHECK(esp8266_at_fetch_event(&event));
+    CHECK_EQ(line_seq(event.raw_line), 1U);
+
+    /* 持有的行换成第 1 行后，arena 开头空出，新行重新可以入队 */
+    feed_line("after#9#");
+    CHECK_EQ(esp8266_at_pending_event_count(), 3U);
+    CHECK_EQ(esp8266_at_dropped_event_count(), 2U);
+
+    /* 超过行缓冲的行被丢弃，下一行照常解析 */
+    restart();
+    for (uint32_t i = 0U; i < ESP8266_AT_MAX_LINE_LENGTH + 40U; ++i)
+    {
+        feed("y");
+    }
+    feed("\r\n");
+    feed_line("+CWMODE:1");
+    while (esp8266_at_fetch_event(&event))
+    {
+        if (event.type == ESP8266_AT_EVENT_TYPE_RESPONSE)
+        {
+            break;
+        }
+    }
+    CHECK(esp8266_at_event_has_prefix(&event, "+CWMODE"));
+    CHECK(strcmp(event.payload, "1") == 0);
+
+    /* 清空后持有的事件失效，arena 从头复用 */
+    esp8266_at_clear_events();
+    CHECK_EQ(esp8266_at_pending_event_count(), 0U);
+    CHECK(!esp8266_at_fetch_event(&event));
+}
+
+static void test_arguments(void)
+{
+    esp8266_at_event_t event;
+    esp8266_at_argument_t args[ESP8266_AT_MAX_ARGUMENTS];
+    char buffer[32];
+
+    restart();
+    feed_line("+CWLAP:(3,\"my, ssid\",-70, \"aa:bb:cc\" ,,1)");
+    CHECK(esp8266_at_fetch_event(&event));
+    CHECK(esp8266_at_event_has_prefix(&event, "+cwlap"));
+    CHECK(!esp8266_at_event_has_prefix(&event, "+CWLA"));
+    CHECK_EQ(esp8266_at_event_arguments(&event, NULL, 0U), 6U);
+    CHECK_EQ(esp8266_at_event_arguments(&event, args, ESP8266_AT_MAX_ARGUMENTS), 6U);
+    CHECK(args[1].quoted);
+    CHECK(!args[2].quoted);
+    CHECK_EQ(esp8266_at_event_copy_argument(&event, 1U, buffer, sizeof(buffer)), 8U);
+    CHECK(strcmp(buffer, "my, ssid") == 0);
+    CHECK_EQ(esp8266_at_event_copy_argument(&event, 2U, buffer, sizeof(buffer)), 3U);
+    CHECK(strcmp(buffer, "-70") == 0);
+    CHECK_EQ(esp8266_at_event_copy_argument(&event, 3U, buffer, sizeof(buffer)), 8U);
+    CHECK(strcmp(buffer, "aa:bb:cc") == 0);
+    CHECK_EQ(esp8266_at_event_copy_argument(&event, 4U, buffer, sizeof(buffer)), 0U);
+    CHECK_EQ(esp8266_at_event_copy_argument(&event, 6U, buffer, sizeof(buffer)), 0U);
+    CHECK_EQ(esp8266_at_event_copy_argument(&event, 1U, buffer, 4U), 3U);
+    CHECK(strcmp(buffer, "my,") == 0);
+
+    /* 只取前两个参数 */
+    CHECK_EQ(esp8266_at_event_arguments(&event, args, 2U), 2U);
+
+    /* 无前缀的行整行作为载荷 */
+    feed_line("WIFI GOT IP");
+    CHECK(esp8266_at_fetch_event(&event));
+    CHECK_EQ(event.type, ESP8266_AT_EVENT_TYPE_INDICATION);
+    CHECK(strcmp(event.payload, "WIFI GOT IP") == 0);
+}
+
+/* ---------------- +IPD 二进制接收 ---------------- */
+
+#define IPD_LINKS       5U
+#define IPD_STREAM_MAX  65536U
+#define IPD_LINES_MAX   4096U
+#define IPD_TRIALS      60U
+
+static uint8_t s_ipd_got[IPD_LINKS][IPD_STREAM_MAX];
+static size_t s_ipd_got_length[IPD_LINKS];
+static uint32_t s_ipd_calls;
+static char s_seen_lines[IPD_LINES_MAX][48];
+static uint32_t s_seen_count;
+
+static void ipd_sink(uint8_t link_id, const uint8_t *data, size_t length, void *context)
+{
+    ++s_ipd_calls;
+    CHECK(link_id < IPD_LINKS);
+    CHECK(length > 0U);
+    if (link_id < IPD_LINKS && s_ipd_got_length[link_id] + length <= IPD_STREAM_MAX)
+    {
+        memcpy(&s_ipd_got[link_id][s_ipd_got_length[link_id]], data, length);
+        s_ipd_got_length[link_id] += length;
+    }
+}
+
+static void line_sink(const esp8266_at_event_t *event, void *context)
+{
+    if (s_seen_count < IPD_LINES_MAX)
+    {
+        (void)snprintf(s_seen_lines[s_seen_count], sizeof(s_seen_lines[0]), "%s", event->raw_line);
+    }
+    ++s_seen_count;
+}
+
+static void ipd_reset_sinks(void)
+{
+    memset(s_ipd_got_length, 0, sizeof(s_ipd_got_length));
+    s_ipd_calls = 0U;
+    s_seen_count = 0U;
+}
+
+/* 把字节流按 1..max_chunk 的随机块馈入，模拟 DMA 空闲中断把帧头、数据切在任意位置 */
+static void feed_chunked(const uint8_t *data, size_t length, size_t max_chunk)
+{
+    esp8266_at_event_t event;
+    size_t offset = 0U;
+
+    while (offset < length)
+    {
+        size_t n = 1U + rand_next() % max_chunk;
+        if (n > length - offset)
+        {
+            n = length - offset;
+        }
+        esp8266_at_receive_bytes(&data[offset], n);
+        offset += n;
+        while (esp8266_at_fetch_event(&event))
+        {
+        }
+    }
+}
+
+/*
+ * 随机流：单链路 / 多链路 / 带 CIPDINFO（IPv4、带引号的 IPv6）的 +IPD 帧，
+ * 数据为任意字节并不时嵌入 "\r\n+IPD,3:xyz\r\nOK\r\n" 之类的伪帧头，
+ * 帧之间夹普通行。按随机块馈入后，各链路收到的字节与行序列必须与生成记录一致。
+ */
+static void test_ipd_fuzz(void)
+{
+    static const char *const lines[] = {"OK", "SEND OK", "+CIPRECVLEN:0,0", "2,CONNECT", "1,CLOSED", "busy p..."};
+    static const char decoy[] = "\r\n+IPD,3:xyz\r\nOK\r\n";
+    static uint8_t stream[IPD_STREAM_MAX + 4096U];
+    static uint8_t want[IPD_LINKS][IPD_STREAM_MAX];
+    static const char *want_lines[IPD_LINES_MAX];
+    size_t want_length[IPD_LINKS];
+    uint32_t frames = 0U;
+    uint32_t total_calls = 0U;
+    size_t total_bytes = 0U;
+
+    for (uint32_t trial = 0U; trial < IPD_TRIALS; ++trial)
+    {
+        size_t length = 0U;
+        uint32_t want_count = 0U;
+
+        memset(want_length, 0, sizeof(want_length));
+        while (length < IPD_STREAM_MAX - 2048U && want_count < IPD_LINES_MAX - 1U)
+        {
+            const uint32_t kind = rand_next() % 4U;
+
+            if (kind == 3U)
+            {
+                const char *line = lines[rand_next() % 6U];
+                length += (size_t)sprintf((char *)&stream[length], "%s%s\r\n",
+                                          (rand_next() & 1U) ? "\r\n" : "", line);
+                want_lines[want_count++] = line;
+                continue;
+            }
+
+            const uint32_t link = rand_next() % IPD_LINKS;
+            const size_t data_length = 1U + rand_next() % ((rand_next() % 4U == 0U) ? 1500U : 40U);
+            const uint32_t form = rand_next() % 5U;
+            int n;
+
+            switch (form)
+            {
+                case 0:
+                    n = sprintf((char *)&stream[length], "\r\n+IPD,%u:", (unsigned)data_length);
+                    break;
+                case 1:
+                    n = sprintf((char *)&stream[length], "\r\n+IPD,%u,192.168.4.%u,%u:",
+                                (unsigned)data_length, (unsigned)(rand_next() % 255U),
+                                (unsigned)(rand_next() % 65535U));
+                    break;
+                case 2:
+                    n = sprintf((char *)&stream[length], "\r\n+IPD,%u,%u,\"10.0.0.%u\",%u:", (unsigned)link,
+                                (unsigned)data_length, (unsigned)(rand_next() % 255U),
+                                (unsigned)(rand_next() % 65535U));
+                    break;
+                case 3:
+                    n = sprintf((char *)&stream[length], "\r\n+IPD,%u,%u,\"fe80::%x:%x\",%u:", (unsigned)link,
+                                (unsigned)data_length, (unsigned)(rand_next() & 0xFFFFU),
+                                (unsigned)(rand_next() & 0xFFFFU), (unsigned)(rand_next() % 65535U));
+                    break;
+                default:
+                    n = sprintf((char *)&stream[length], "+IPD,%u,%u:", (unsigned)link, (unsigned)data_length);
+                    break;
+            }
+            length += (size_t)n;
+
+            const uint32_t target = (form <= 1U) ? 0U : link;
+            uint8_t *data = &stream[length];
+            for (size_t i = 0U; i < data_length; ++i)
+            {
+                data[i] = (uint8_t)rand_next();
+            }
+            if (data_length > sizeof(decoy) && (rand_next() % 3U) == 0U)
+            {
+                memcpy(&data[rand_next() % (data_length - sizeof(decoy))], decoy, sizeof(decoy) - 1U);
+            }
+            memcpy(&want[target][want_length[target]], data, data_length);
+            want_length[target] += data_length;
+            length += data_length;
+            ++frames;
+        }
+        length += (size_t)sprintf((char *)&stream[length], "OK\r\n");
+        want_lines[want_count++] = "OK";
+
+        restart();
+        ipd_reset_sinks();
+        esp8266_at_set_ipd_handler(ipd_sink, NULL);
+        esp8266_at_set_line_observer(line_sink, NULL);
+        feed_chunked(stream, length, (trial % 3U == 0U) ? 1U : 300U);
+
+        for (uint32_t link = 0U; link < IPD_LINKS; ++link)
+        {
+            CHECK_EQ(s_ipd_got_length[link], want_length[link]);
+            CHECK(memcmp(s_ipd_got[link], want[link], want_length[link]) == 0);
+        }
+        CHECK_EQ(s_seen_count, want_count);
+        for (uint32_t i = 0U; i < want_count && i < s_seen_count; ++i)
+        {
+            CHECK(strcmp(s_seen_lines[i], want_lines[i]) == 0);
+        }
+        total_calls += s_ipd_calls;
+        total_bytes += length;
+    }
+
+    printf("ipd: %u frames in %u bytes, %u handler calls\n",
+           (unsigned)frames, (unsigned)total_bytes, (unsigned)total_calls);
+}
+
+/* 逐字节馈入：帧头在任意位置断开都能正确进入数据阶段 */
+static void test_ipd_split_header(void)
+{
+    static const char text[] = "+IPD,1,6,\"fe80::1\",80:a\r\n:b\nOK\r\n";
+
+    for (size_t cut = 1U; cut < sizeof(text) - 1U; ++cut)
+    {
+        restart();
+        ipd_reset_sinks();
+        esp8266_at_set_ipd_handler(ipd_sink, NULL);
+        esp8266_at_set_line_observer(line_sink, NULL);
+        esp8266_at_receive_bytes((const uint8_t *)text, cut);
+        esp8266_at_receive_bytes((const uint8_t *)&text[cut], sizeof(text) - 1U - cut);
+
+        CHECK_EQ(s_ipd_got_length[1], 6U);
+        CHECK(memcmp(s_ipd_got[1], "a\r\n:b\n", 6U) == 0);
+        CHECK_EQ(s_seen_count, 1U);
+        CHECK(strcmp(s_seen_lines[0], "OK") == 0);
+    }
+}
+
+/* 没有数据接收函数时保留旧行为，以及不合法的帧头按普通行处理 */
+static void test_ipd_legacy_and_malformed(void)
+{
+    esp8266_at_event_t event;
+    char data[600];
+
+    restart();
+    feed("+IPD,5:hello\r\n");
+    CHECK(esp8266_at_fetch_event(&event));
+    CHECK(strcmp(event.raw_line, "+IPD,5:hello") == 0);
+
+    /* 超过一行的数据被截断，但长度照常计数，随后的行不受影响 */
+    memset(data, 'd', sizeof(data));
+    feed("+IPD,600:");
+    esp8266_at_receive_bytes((const uint8_t *)data, sizeof(data));
+    feed("OK\r\n");
+    CHECK(esp8266_at_fetch_event(&event));
+    CHECK_EQ(event.line_length, ESP8266_AT_MAX_LINE_LENGTH - 1U);
+    CHECK(esp8266_at_fetch_event(&event));
+    CHECK_EQ(event.type, ESP8266_AT_EVENT_TYPE_OK);
+
+    static const char *const malformed[] = {"+IPD,abc:rest", "+IPD,0:x", "+IPD,1,2x:yz", "+IPD,1234567:z", "+IPD,:q"};
+    restart();
+    ipd_reset_sinks();
+    esp8266_at_set_ipd_handler(ipd_sink, NULL);
+    for (size_t i = 0U; i < sizeof(malformed) / sizeof(malformed[0]); ++i)
+    {
+        feed_line(malformed[i]);
+        CHECK(esp8266_at_fetch_event(&event));
+        CHECK(strcmp(event.raw_line, malformed[i]) == 0);
+    }
+    CHECK_EQ(s_ipd_calls, 0U);
+}
+
+/* ---------------- 异步命令流水线 ---------------- */
+
+#define PIPE_COMMANDS   20000U
+#define PIPE_LOG        64U
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t order[PIPE_LOG];
+    esp8266_at_status_t status[PIPE_LOG];
+    esp8266_at_event_type_t terminal[PIPE_LOG];
+} completion_log_t;
+
+static completion_log_t s_done;
+
+static void on_complete(esp8266_at_status_t status, const esp8266_at_event_t *terminal, void *context)
+{
+    if (s_done.count < PIPE_LOG)
+    {
+        s_done.order[s_done.count]    = (uint32_t)(uintptr_t)context;
+        s_done.status[s_done.count]   = status;
+        s_done.terminal[s_done.count] = (terminal != NULL) ? terminal->type : ESP8266_AT_EVENT_TYPE_UNKNOWN;
+    }
+    ++s_done.count;
+}
+
+/* 取走替身自上次以来发送的内容 */
+static void tx_take(char *out, size_t size)
+{
+    (void)snprintf(out, size, "%s", s_tx);
+    s_tx_length = 0U;
+    s_tx[0] = '\0';
+}
+
+static void test_pipeline_basic(void)
+{
+    char tx[256];
+
+    restart();
+    memset(&s_done, 0, sizeof(s_done));
+    CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_CWMODE, ESP8266_AT_COMMAND_MODE_SET, "1", 0U, on_complete, (void *)0), ESP8266_AT_STATUS_OK);
+    CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_CIPMUX, ESP8266_AT_COMMAND_MODE_SET, "1", 0U, on_complete, (void *)1), ESP8266_AT_STATUS_OK);
+    /* CWMODE 不支持执行模式：启动时失败，不发送，直接结束并继续下一条 */
+    CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_CWMODE, ESP8266_AT_COMMAND_MODE_EXECUTE, NULL, 0U, on_complete, (void *)2), ESP8266_AT_STATUS_OK);
+    CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_GMR, ESP8266_AT_COMMAND_MODE_EXECUTE, NULL, 0U, on_complete, (void *)3), ESP8266_AT_STATUS_OK);
+    CHECK_EQ(esp8266_at_pending_command_count(), 4U);
+
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "AT+CWMODE=1\r\n") == 0);
+
+    /* 在途时不发下一条，阻塞接口直接返回 BUSY */
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(tx[0] == '\0');
+    CHECK_EQ(esp8266_at_send_command(ESP8266_AT_CMD_AT, ESP8266_AT_COMMAND_MODE_EXECUTE, NULL, 10U, false), ESP8266_AT_STATUS_BUSY);
+
+    feed("\r\nOK\r\n");
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "AT+CIPMUX=1\r\n") == 0);
+    CHECK_EQ(s_done.count, 1U);
+    CHECK_EQ(s_done.status[0], ESP8266_AT_STATUS_OK);
+    CHECK_EQ(s_done.terminal[0], ESP8266_AT_EVENT_TYPE_OK);
+
+    /* 每次 process 只推进一步：先结束 CIPMUX 并尝试启动下一条（启动失败即结束），再发 GMR */
+    feed("ERROR\r\n");
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(tx[0] == '\0');
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "AT+GMR\r\n") == 0);
+    CHECK_EQ(s_done.count, 3U);
+    CHECK_EQ(s_done.status[1], ESP8266_AT_STATUS_ERROR_RESPONSE);
+    CHECK_EQ(s_done.order[2], 2U);
+    CHECK_EQ(s_done.status[2], ESP8266_AT_STATUS_INVALID_ARGUMENT);
+
+    feed("AT version:2.2.0.0\r\nSDK version:v3.4\r\nOK\r\n");
+    esp8266_at_process();
+    CHECK_EQ(s_done.count, 4U);
+    CHECK_EQ(s_done.status[3], ESP8266_AT_STATUS_OK);
+    CHECK_EQ(esp8266_at_pending_command_count(), 0U);
+    CHECK(esp8266_at_is_ready());
+
+    /* 队列满 */
+    for (uint32_t i = 0U; i < ESP8266_AT_ASYNC_QUEUE_DEPTH; ++i)
+    {
+        CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_AT, ESP8266_AT_COMMAND_MODE_EXECUTE, NULL, 0U, NULL, NULL), ESP8266_AT_STATUS_OK);
+    }
+    CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_AT, ESP8266_AT_COMMAND_MODE_EXECUTE, NULL, 0U, NULL, NULL), ESP8266_AT_STATUS_BUSY);
+}
+
+/* "busy p..." 按 20、40、80、160、320 ms 退避重发，第 6 次仍忙则以 BUSY_RESPONSE 结束 */
+static void test_pipeline_busy_backoff(void)
+{
+    char tx[256];
+
+    restart();
+    memset(&s_done, 0, sizeof(s_done));
+    s_tick = 5000U;
+    CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_CWJAP, ESP8266_AT_COMMAND_MODE_SET, "\"ap\",\"pw\"", 0U, on_complete, (void *)0), ESP8266_AT_STATUS_OK);
+    CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_AT, ESP8266_AT_COMMAND_MODE_EXECUTE, NULL, 0U, on_complete, (void *)1), ESP8266_AT_STATUS_OK);
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "AT+CWJAP=\"ap\",\"pw\"\r\n") == 0);
+
+    for (uint32_t retry = 0U; retry < ESP8266_AT_BUSY_MAX_RETRIES; ++retry)
+    {
+        const uint32_t wait = ESP8266_AT_BUSY_RETRY_MS << retry;
+
+        feed("busy p...\r\n");
+        esp8266_at_process();
+        s_tick += wait - 1U;
+        esp8266_at_process();
+        tx_take(tx, sizeof(tx));
+        CHECK(tx[0] == '\0');
+        s_tick += 1U;
+        esp8266_at_process();
+        tx_take(tx, sizeof(tx));
+        CHECK(strcmp(tx, "AT+CWJAP=\"ap\",\"pw\"\r\n") == 0);
+        CHECK_EQ(s_done.count, 0U);
+    }
+
+    feed("busy p...\r\n");
+    esp8266_at_process();
+    CHECK_EQ(s_done.count, 1U);
+    CHECK_EQ(s_done.status[0], ESP8266_AT_STATUS_BUSY_RESPONSE);
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "AT\r\n") == 0);
+
+    /* 超时只结束自己，下一条照常发出 */
+    CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_GMR, ESP8266_AT_COMMAND_MODE_EXECUTE, NULL, 100U, on_complete, (void *)2), ESP8266_AT_STATUS_OK);
+    feed("OK\r\n");
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "AT+GMR\r\n") == 0);
+    s_tick += 100U;
+    esp8266_at_process();
+    CHECK_EQ(s_done.count, 2U);
+    s_tick += 1U;
+    esp8266_at_process();
+    CHECK_EQ(s_done.count, 3U);
+    CHECK_EQ(s_done.status[2], ESP8266_AT_STATUS_TIMEOUT);
+}
+
+/* 带数据的提示符命令：OK 不结束命令，'>' 后写出数据，SEND OK / +MQTTPUB:OK 结束 */
+static void test_pipeline_prompt(void)
+{
+    static const uint8_t payload[] = "hello";
+    char tx[256];
+
+    restart();
+    memset(&s_done, 0, sizeof(s_done));
+    CHECK_EQ(esp8266_at_submit_data(ESP8266_AT_CMD_CIPSEND, ESP8266_AT_COMMAND_MODE_SET, "0,5", payload, 5U, 0U, on_complete, (void *)0), ESP8266_AT_STATUS_OK);
+    CHECK_EQ(esp8266_at_submit_data(ESP8266_AT_CMD_MQTTPUBRAW, ESP8266_AT_COMMAND_MODE_SET, "0,\"t\",5,1,0", payload, 5U, 0U, on_complete, (void *)1), ESP8266_AT_STATUS_OK);
+    CHECK_EQ(esp8266_at_submit_data(ESP8266_AT_CMD_CIPSEND, ESP8266_AT_COMMAND_MODE_SET, "0,5", payload, 5U, 0U, on_complete, (void *)2), ESP8266_AT_STATUS_OK);
+
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "AT+CIPSEND=0,5\r\n") == 0);
+    feed("\r\nOK\r\n");
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(tx[0] == '\0');
+    feed(">");
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "hello") == 0);
+    feed("\r\nRecv 5 bytes\r\n\r\nSEND OK\r\n");
+    esp8266_at_process();
+    CHECK_EQ(s_done.count, 1U);
+    CHECK_EQ(s_done.status[0], ESP8266_AT_STATUS_OK);
+    CHECK_EQ(s_done.terminal[0], ESP8266_AT_EVENT_TYPE_SEND_OK);
+
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "AT+MQTTPUBRAW=0,\"t\",5,1,0\r\n") == 0);
+    feed("OK\r\n>");
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "hello") == 0);
+    feed("\r\n+MQTTPUB:OK\r\n");
+    esp8266_at_process();
+    CHECK_EQ(s_done.count, 2U);
+    CHECK_EQ(s_done.status[1], ESP8266_AT_STATUS_OK);
+
+    tx_take(tx, sizeof(tx));
+    CHECK(strcmp(tx, "AT+CIPSEND=0,5\r\n") == 0);
+    feed(">");
+    esp8266_at_process();
+    tx_take(tx, sizeof(tx));
+    feed("\r\nSEND FAIL\r\n");
+    esp8266_at_process();
+    CHECK_EQ(s_done.count, 3U);
+    CHECK_EQ(s_done.status[2], ESP8266_AT_STATUS_FAIL_RESPONSE);
+    CHECK(esp8266_at_is_ready());
+}
+
+/* ---------------- URC 路由 ---------------- */
+
+typedef struct
+{
+    uint32_t calls;
+    char last[64];
+} urc_log_t;
+
+static urc_log_t s_urc[ESP8266_AT_MAX_URC_HANDLERS + 1U];
+
+static void on_urc(const esp8266_at_event_t *event, void *context)
+{
+    urc_log_t *log = (urc_log_t *)context;
+
+    ++log->calls;
+    (void)snprintf(log->last, sizeof(log->last), "%s", event->raw_line);
+}
+
+/*
+ * 随机脚本：队列里保持若干条命令，模组对每条发出的命令随机回复 OK / ERROR / busy 或不回复，
+ * 期间穿插已注册的 URC。检查完成回调按提交顺序各触发一次、状态与脚本一致，
+ * 重发只发生在 busy 之后，URC 全部交给处理函数而不进入事件队列。
+ */
+static void test_pipeline_fuzz(void)
+{
+    static esp8266_at_status_t expected[PIPE_COMMANDS];
+    uint32_t submitted = 0U;
+    uint32_t completed_check = 0U;
+    uint32_t busy_replies = 0U;
+    uint32_t exhausted = 0U;
+    uint32_t timeouts = 0U;
+    uint32_t urcs = 0U;
+    uint32_t sends = 0U;
+    uint32_t current = UINT32_MAX;
+    uint32_t current_busy = 0U;
+    char tx[256];
+
+    restart();
+    memset(&s_done, 0, sizeof(s_done));
+    memset(s_urc, 0, sizeof(s_urc));
+    CHECK_EQ(esp8266_at_register_urc("+MQTTSUBRECV", on_urc, &s_urc[0]), ESP8266_AT_STATUS_OK);
+    CHECK_EQ(esp8266_at_register_urc("WIFI DISCONNECT", on_urc, &s_urc[1]), ESP8266_AT_STATUS_OK);
+    s_tick = 0U;
+
+    while (completed_check < PIPE_COMMANDS)
+    {
+        /* 补充队列 */
+        while (submitted < PIPE_COMMANDS && esp8266_at_pending_command_count() < ESP8266_AT_ASYNC_QUEUE_DEPTH
+               && (rand_next() % 3U) != 0U)
+        {
+            char args[16];
+            (void)snprintf(args, sizeof(args), "%u", (unsigned)submitted);
+            CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_SYSLOG, ESP8266_AT_COMMAND_MODE_SET, args, 50U,
+                                       on_complete, (void *)(uintptr_t)submitted), ESP8266_AT_STATUS_OK);
+            ++submitted;
+        }
+
+        if ((rand_next() % 8U) == 0U)
+        {
+            feed((rand_next() & 1U) ? "+MQTTSUBRECV:0,\"t\",1,x\r\n" : "WIFI DISCONNECT\r\n");
+            ++urcs;
+        }
+
+        const uint32_t before = s_done.count;
+        esp8266_at_process();
+        tx_take(tx, sizeof(tx));
+
+        /* 结束的命令按提交顺序、以脚本决定的状态回调 */
+        for (uint32_t i = before; i < s_done.count; ++i)
+        {
+            const uint32_t slot = i % PIPE_LOG;
+            CHECK_EQ(s_done.order[slot], completed_check);
+            CHECK_EQ(s_done.status[slot], expected[completed_check]);
+            ++completed_check;
+        }
+        s_done.count %= PIPE_LOG;
+
+        if (tx[0] != '\0')
+        {
+            unsigned index = 0U;
+            CHECK(sscanf(tx, "AT+SYSLOG=%u\r\n", &index) == 1);
+            current_busy = (index == current) ? current_busy : 0U;
+            current = index;
+            ++sends;
+
+            const uint32_t r = rand_next() % 20U;
+            if (r < 3U)
+            {
+                feed("busy p...\r\n");
+                ++busy_replies;
+                if (current_busy == ESP8266_AT_BUSY_MAX_RETRIES)
+                {
+                    expected[index] = ESP8266_AT_STATUS_BUSY_RESPONSE;
+                    ++exhausted;
+                }
+                ++current_busy;
+            }
+            else if (r < 5U)
+            {
+                feed("ERROR\r\n");
+                expected[index] = ESP8266_AT_STATUS_ERROR_RESPONSE;
+            }
+            else if (r < 6U)
+            {
+                expected[index] = ESP8266_AT_STATUS_TIMEOUT;
+                ++timeouts;
+            }
+            else
+            {
+                feed("OK\r\n");
+                expected[index] = ESP8266_AT_STATUS_OK;
+            }
+        }
+        s_tick += 1U + rand_next() % 30U;
+    }
+
+    esp8266_at_event_t event;
+    CHECK(!esp8266_at_fetch_event(&event) || event.type != ESP8266_AT_EVENT_TYPE_RESPONSE);
+    CHECK_EQ(s_urc[0].calls + s_urc[1].calls, urcs);
+    /* 每个 busy 恰好引起一次重发，重试用尽的除外 */
+    CHECK_EQ(sends, PIPE_COMMANDS + busy_replies - exhausted);
+    printf("pipeline: %u commands, %u sends, %u busy retries, %u timeouts, %u URCs routed\n",
+           (unsigned)PIPE_COMMANDS, (unsigned)sends, (unsigned)busy_replies, (unsigned)timeouts, (unsigned)urcs);
+}
+
+/* 查找键的完美哈希：每个命令前缀与 URC 文本都能注册并路由到自己，大小写无关，近似键不命中 */
+static void test_urc_keys(void)
+{
+    static const struct
+    {
+        const char *key;
+        int command;
+    } keys[] = {
+#define KEY_FROM_COMMAND(ID, NAME, LITERAL, T, Q, S, E) { LITERAL, ID },
+        ESP8266_AT_COMMAND_TABLE(KEY_FROM_COMMAND)
+#undef KEY_FROM_COMMAND
+#define KEY_FROM_URC(NAME, TEXT) { TEXT, -1 },
+        ESP8266_AT_URC_TABLE(KEY_FROM_URC)
+#undef KEY_FROM_URC
+    };
+    esp8266_at_event_t event;
+    char line[96];
+    char lower[64];
+    uint32_t routed = 0U;
+
+    restart();
+    memset(s_urc, 0, sizeof(s_urc));
+    for (size_t i = 0U; i < sizeof(keys) / sizeof(keys[0]); ++i)
+    {
+        const char *plus = strchr(keys[i].key, '+');
+        const char *key = (keys[i].command >= 0) ? plus : keys[i].key;
+        size_t n = 0U;
+
+        if (key == NULL)
+        {
+            continue;       /* AT、ATE0 等没有响应前缀 */
+        }
+        for (; key[n] != '\0' && n < sizeof(lower) - 1U; ++n)
+        {
+            lower[n] = (char)((key[n] >= 'A' && key[n] <= 'Z') ? key[n] + 32 : key[n]);
+        }
+        lower[n] = '\0';
+
+        if (key[0] == '+')
+        {
+            (void)snprintf(line, sizeof(line), "%s:1,\"x\"", key);
+        }
+        else
+        {
+            (void)snprintf(line, sizeof(line), "%s", key);
+        }
+
+        /* 未注册：进入队列，命令前缀解析为对应的命令号 */
+        feed_line(line);
+        CHECK(esp8266_at_fetch_event(&event));
+        CHECK(strcmp(event.raw_line, line) == 0);
+        if (keys[i].command >= 0)
+        {
+            CHECK_EQ(event.command, keys[i].command);
+        }
+
+        /* 用小写键注册后由处理函数接走 */
+        CHECK_EQ(esp8266_at_register_urc(lower, on_urc, &s_urc[0]), ESP8266_AT_STATUS_OK);
+        const uint32_t calls = s_urc[0].calls;
+        feed_line(line);
+        CHECK_EQ(s_urc[0].calls, calls + 1U);
+        CHECK(strcmp(s_urc[0].last, line) == 0);
+        CHECK(!esp8266_at_fetch_event(&event));
+        CHECK_EQ(esp8266_at_register_urc(key, NULL, NULL), ESP8266_AT_STATUS_OK);
+        ++routed;
+    }
+    CHECK(routed > ESP8266_AT_URC_COUNT + 80U);
+
+    static const char *const not_keys[] = {"+CWMOD", "+CWMODEX", "+IPD", "OK", "", "WIFI", "+MQTTSUBRECV:"};
+    for (size_t i = 0U; i < sizeof(not_keys) / sizeof(not_keys[0]); ++i)
+    {
+        CHECK_EQ(esp8266_at_register_urc(not_keys[i], on_urc, &s_urc[0]), ESP8266_AT_STATUS_INVALID_ARGUMENT);
+    }
+    CHECK_EQ(esp8266_at_register_urc(NULL, on_urc, &s_urc[0]), ESP8266_AT_STATUS_INVALID_ARGUMENT);
+
+    /* 处理函数表满；同一键重复注册只替换处理函数，不占新表项 */
+    memset(s_urc, 0, sizeof(s_urc));
+    static const char *const eight[] = {"+CWJAP", "+CWLAP", "+CIPSTA", "+CIPAP", "+MQTTCONNECTED",
+                                        "+MQTTDISCONNECTED", "WIFI GOT IP", "ready"};
+    for (size_t i = 0U; i < 8U; ++i)
+    {
+        CHECK_EQ(esp8266_at_register_urc(eight[i], on_urc, &s_urc[i]), ESP8266_AT_STATUS_OK);
+    }
+    CHECK_EQ(esp8266_at_register_urc("+LINK_CONN", on_urc, &s_urc[8]), ESP8266_AT_STATUS_BUFFER_OVERFLOW);
+    CHECK_EQ(esp8266_at_register_urc("+CWJAP", on_urc, &s_urc[8]), ESP8266_AT_STATUS_OK);
+    feed_line("+CWJAP:\"home\"");
+    CHECK_EQ(s_urc[8].calls, 1U);
+    CHECK_EQ(s_urc[0].calls, 0U);
+
+    /* 正在等待 AT+CWJAP 的应答时，+CWJAP 行属于该命令，不被路由 */
+    memset(&s_done, 0, sizeof(s_done));
+    CHECK_EQ(esp8266_at_submit(ESP8266_AT_CMD_CWJAP, ESP8266_AT_COMMAND_MODE_QUERY, NULL, 0U, on_complete, NULL), ESP8266_AT_STATUS_OK);
+    esp8266_at_process();
+    feed_line("+CWJAP:\"home\",\"aa:bb\",6,-50");
+    feed_line("OK");
+    CHECK_EQ(s_urc[8].calls, 1U);
+    CHECK(esp8266_at_fetch_event(&event));
+    CHECK(esp8266_at_event_has_prefix(&event, "+CWJAP"));
+    esp8266_at_process();
+    CHECK_EQ(s_done.count, 1U);
+    feed_line("+CWJAP:\"home\"");
+    CHECK_EQ(s_urc[8].calls, 2U);
+}
+
+int main(void)
+{
+    test_arguments();
+    test_arena_capacity();
+    test_arena_no_loss();
+    test_arena_fuzz();
+    test_ipd_legacy_and_malformed();
+    test_ipd_split_header();
+    test_ipd_fuzz();
+    test_pipeline_basic();
+    test_pipeline_busy_backoff();
+    test_pipeline_prompt();
+    test_pipeline_fuzz();
+    test_urc_keys();
+    return HOST_TEST_DONE();
+}
@@ -0,0 +1,685 @@
+/**
+ * @file test_esp8266_mqtt.c
+ * @brief esp8266_mqtt 发件箱：窗口、合并、失败重发、应答后出箱与掉电恢复。
+ *
+ * AT 驱动用真实源码，接口层替身捕获发送内容，脚本化的模组逐条解析
+ * AT+MQTTPUB / AT+MQTTPUBRAW（含 '>' 之后的原始数据），随机回复成功、ERROR、+MQTTPUB:FAIL
+ * 或不回复，并随机断开、恢复 broker 连接（+MQTTDISCONNECTED / +MQTTCONNECTED）。
+ * broker 模型只在模组回复成功时记下消息。检查：
+ *   1. QoS 1 消息恰好送达一次，QoS 0 最多一次，统计量与送达记录一致；
+ *   2. 只被发送一次就送达的消息保持发布顺序，失败的消息至少 ESP8266_MQTT_RETRY_DELAY_MS 后才重发；
+ *   3. AT 队列中的发布命令不超过 ESP8266_MQTT_WINDOW，离线后不再派发新命令；
+ *   4. 随机时刻"重启"（AT 驱动与发件箱都重新初始化）后由持久化后端恢复，仍满足第 1 条，
+ *      全部应答后后端中不留记录；
+ *   5. 链路稳定时同主题的连续小消息被合并，输出每条命令平均承载的消息数。
+ */
+#include "driver_esp8266_mqtt.h"
+#include "driver_esp8266_at_interface.h"
+#include "host_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MESSAGES_MAX    20000U
+#define TOPICS          3U
+
+/* ---------------- 接口层替身 ---------------- */
+
+static uint32_t s_tick;
+static uint8_t s_tx[2048];
+static size_t s_tx_length;
+
+esp8266_at_status_t esp8266_at_interface_hw_init(void)
+{
+    return ESP8266_AT_STATUS_OK;
+}
+
+esp8266_at_status_t esp8266_at_interface_hw_send(const uint8_t *data, size_t length, uint32_t timeout_ms)
+{
+    CHECK(s_tx_length + length <= sizeof(s_tx));
+    if (s_tx_length + length <= sizeof(s_tx))
+    {
+        memcpy(&s_tx[s_tx_length], data, length);
+        s_tx_length += length;
+    }
+    return ESP8266_AT_STATUS_OK;
+}
+
+uint32_t esp8266_at_interface_hw_get_tick(void)
+{
+    return s_tick;
+}
+
+void esp8266_at_interface_hw_restart_rx(void)
+{
+}
+
+uint32_t esp8266_at_interface_hw_enter_critical(void)
+{
+    return 0U;
+}
+
+void esp8266_at_interface_hw_exit_critical(uint32_t state)
+{
+}
+
+void esp8266_at_interface_flush_trace(void)
+{
+}
+
+/* ---------------- 持久化后端 ---------------- */
+
+typedef struct
+{
+    bool valid;
+    esp8266_mqtt_record_t record;
+} backend_slot_t;
+
+static backend_slot_t s_store[ESP8266_MQTT_OUTBOX_DEPTH];
+
+static void store_save(uint8_t slot, const esp8266_mqtt_record_t *record, void *context)
+{
+    CHECK(slot < ESP8266_MQTT_OUTBOX_DEPTH);
+    CHECK(!s_store[slot].valid);
+    s_store[slot].valid  = true;
+    s_store[slot].record = *record;
+}
+
+static void store_erase(uint8_t slot, void *context)
+{
+    CHECK(slot < ESP8266_MQTT_OUTBOX_DEPTH);
+    s_store[slot].valid = false;
+}
+
+static bool store_load(uint8_t slot, esp8266_mqtt_record_t *record, void *context)
+{
+    if (!s_store[slot].valid)
+    {
+        return false;
+    }
+    *record = s_store[slot].record;
+    return true;
+}
+
+static const esp8266_mqtt_backend_t s_backend = {store_save, store_erase, store_load, NULL};
+
+/* ---------------- 消息与 broker 模型 ---------------- */
+
+typedef struct
+{
+    uint8_t topic;
+    uint8_t qos;
+    uint8_t length;
+    uint8_t payload[ESP8266_MQTT_PAYLOAD_SIZE];
+    uint16_t sends;         /* 出现在模组收到的命令中的次数 */
+    uint16_t deliveries;
+    uint16_t first_try;     /* 第一次发送即送达 */
+    bool failed;            /* 模组对上一次发送明确回复了失败 */
+    uint32_t failed_at;
+} message_t;
+
+static message_t s_messages[MESSAGES_MAX];
+static uint32_t s_message_count;
+static uint32_t s_last_first_try;
+static uint32_t s_first_try_order_errors;
+static uint32_t s_early_retries;
+static const char *const s_topic_names[TOPICS] = {"dev/temp", "dev/log,\"x\"", "dev/alarm"};
+static esp8266_mqtt_topic_t s_topic_ids[TOPICS];
+
+static uint32_t s_rand = 0x5EED1234U;
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+    return s_rand >> 8;
+}
+
+/* 载荷以 "<编号>|" 开头，其余随机，含需要转义的字符，偶尔含 0 字节（只能走 MQTTPUBRAW） */
+static uint32_t message_new(uint8_t topic, uint8_t qos, size_t max_length)
+{
+    static const char alphabet[] = "abcdefghij0123456789 ,\"\\:-";
+    message_t *m = &s_messages[s_message_count];
+    int n = snprintf((char *)m->payload, sizeof(m->payload), "%u|", (unsigned)s_message_count);
+    const size_t extra = rand_next() % (max_length - (size_t)n + 1U);
+
+    for (size_t i = 0U; i < extra; ++i)
+    {
+        m->payload[n++] = (rand_next() % 64U == 0U) ? 0U : (uint8_t)alphabet[rand_next() % (sizeof(alphabet) - 1U)];
+    }
+    m->length = (uint8_t)n;
+    m->topic = topic;
+    m->qos = qos;
+    return s_message_count++;
+}
+
+static uint32_t message_id(const uint8_t *payload, size_t length)
+{
+    uint32_t id = 0U;
+    size_t i = 0U;
+
+    while (i < length && payload[i] >= '0' && payload[i] <= '9')
+    {
+        id = id * 10U + (uint32_t)(payload[i++] - '0');
+    }
+    return (i > 0U && i < length && payload[i] == '|') ? id : UINT32_MAX;
+}
+
+/* 模组看到一条命令里的某条消息 */
+static message_t *message_seen(const uint8_t *payload, size_t length, uint8_t topic, uint8_t qos)
+{
+    const uint32_t id = message_id(payload, length);
+
+    CHECK(id < s_message_count);
+    if (id >= s_message_count)
+    {
+        return NULL;
+    }
+    message_t *m = &s_messages[id];
+    CHECK_EQ(m->length, length);
+    CHECK(memcmp(m->payload, payload, length) == 0);
+    CHECK_EQ(m->topic, topic);
+    CHECK_EQ(m->qos, qos);
+    if (m->failed && s_tick - m->failed_at < ESP8266_MQTT_RETRY_DELAY_MS)
+    {
+        ++s_early_retries;
+    }
+    m->failed = false;
+    ++m->sends;
+    return m;
+}
+
+static void message_failed(message_t *m)
+{
+    m->failed = true;
+    m->failed_at = s_tick;
+}
+
+static void message_delivered(message_t *m)
+{
+    const uint32_t id = (uint32_t)(m - s_messages);
+
+    ++m->deliveries;
+    if (m->sends == 1U)
+    {
+        m->first_try = 1U;
+        if (s_last_first_try != UINT32_MAX && id < s_last_first_try)
+        {
+            ++s_first_try_order_errors;
+        }
+        s_last_first_try = id;
+    }
+}
+
+/* ---------------- 脚本化模组 ---------------- */
+
+typedef struct
+{
+    bool link_up;
+    uint32_t reconnect_tick;
+    bool raw_pending;           /* AT+MQTTPUBRAW 已回 '>'，等待原始数据 */
+    size_t raw_length;
+    uint8_t raw_topic;
+    uint8_t raw_qos;
+    uint32_t fail_permille;     /* 每条命令失败（ERROR / FAIL）的概率 */
+    uint32_t silent_permille;   /* 每条命令不回复的概率 */
+    uint32_t drop_permille;     /* 每步断开 broker 的概率 */
+    uint32_t commands;
+    uint32_t messages_in_commands;
+    uint32_t sent_while_offline;
+} modem_t;
+
+static modem_t s_modem;
+
+static void feed(const char *text)
+{
+    esp8266_at_receive_bytes((const uint8_t *)text, strlen(text));
+}
+
+static uint8_t topic_index(const char *name)
+{
+    for (uint8_t i = 0U; i < TOPICS; ++i)
+    {
+        if (strcmp(s_topic_names[i], name) == 0)
+        {
+            return i;
+        }
+    }
+    CHECK(0);
+    return 0U;
+}
+
+/* 解析带引号、可能含 \ 转义的 AT 字符串参数，返回其后的位置 */
+static const char *parse_quoted(const char *p, char *out, size_t *out_length, size_t out_size)
+{
+    size_t n = 0U;
+
+    CHECK(*p == '"');
+    ++p;
+    while (*p != '\0' && *p != '"')
+    {
+        if (*p == '\\' && p[1] != '\0')
+        {
+            ++p;
+        }
+        if (n < out_size)
+        {
+            out[n++] = *p;
+        }
+        ++p;
+    }
+    CHECK(*p == '"');
+    *out_length = n;
+    if (n < out_size)
+    {
+        out[n] = '\0';
+    }
+    return (*p == '"') ? p + 1 : p;
+}
+
+static bool roll(uint32_t permille)
+{
+    return (rand_next() % 1000U) < permille;
+}
+
+static void modem_finish_raw(const uint8_t *data)
+{
+    message_t *batch[ESP8266_MQTT_OUTBOX_DEPTH];
+    size_t count = 0U;
+    size_t start = 0U;
+
+    /* 合并的载荷以 '\n' 分隔 */
+    for (size_t i = 0U; i <= s_modem.raw_length; ++i)
+    {
+        if (i == s_modem.raw_length || data[i] == (uint8_t)ESP8266_MQTT_BATCH_SEPARATOR)
+        {
+            message_t *m = message_seen(&data[start], i - start, s_modem.raw_topic, s_modem.raw_qos);
+            if (m != NULL && count < ESP8266_MQTT_OUTBOX_DEPTH)
+            {
+                batch[count++] = m;
+            }
+            start = i + 1U;
+        }
+    }
+    s_modem.messages_in_commands += (uint32_t)count;
+
+    if (!s_modem.link_up || roll(s_modem.fail_permille))
+    {
+        for (size_t i = 0U; i < count; ++i)
+        {
+            message_failed(batch[i]);
+        }
+        feed("\r\n+MQTTPUB:FAIL\r\n");
+    }
+    else if (!roll(s_modem.silent_permille))
+    {
+        for (size_t i = 0U; i < count; ++i)
+        {
+            message_delivered(batch[i]);
+        }
+        feed("\r\n+MQTTPUB:OK\r\n");
+    }
+}
+
+static void modem_handle_tx(void)
+{
+    char line[256];
+
+    if (s_tx_length == 0U)
+    {
+        return;
+    }
+    if (s_modem.raw_pending)
+    {
+        CHECK_EQ(s_tx_length, s_modem.raw_length);
+        s_modem.raw_pending = false;
+        modem_finish_raw(s_tx);
+        s_tx_length = 0U;
+        return;
+    }
+
+    CHECK(s_tx_length < sizeof(line) && s_tx_length >= 2U && s_tx[s_tx_length - 1U] == '\n');
+    memcpy(line, s_tx, s_tx_length);
+    line[s_tx_length - 2U] = '\0';
+    s_tx_length = 0U;
+
+    ++s_modem.commands;
+    if (!s_modem.link_up)
+    {
+        ++s_modem.sent_while_offline;
+    }
+
+    char topic[ESP8266_MQTT_TOPIC_LENGTH];
+    size_t topic_length = 0U;
+    unsigned qos = 0U;
+    unsigned retain = 0U;
+
+    if (strncmp(line, "AT+MQTTPUB=0,", 13U) == 0)
+    {
+        char payload[ESP8266_MQTT_PAYLOAD_SIZE + 1U];
+        size_t payload_length = 0U;
+        const char *p = parse_quoted(&line[13], topic, &topic_length, sizeof(topic) - 1U);
+        CHECK(*p == ',');
+        p = parse_quoted(p + 1, payload, &payload_length, sizeof(payload) - 1U);
+        CHECK(sscanf(p, ",%u,%u", &qos, &retain) == 2);
+
+        message_t *m = message_seen((const uint8_t *)payload, payload_length, topic_index(topic), (uint8_t)qos);
+        ++s_modem.messages_in_commands;
+        if (!s_modem.link_up || roll(s_modem.fail_permille))
+        {
+            if (m != NULL)
+            {
+                message_failed(m);
+            }
+            feed("\r\nERROR\r\n");
+        }
+        else if (!roll(s_modem.silent_permille))
+        {
+            if (m != NULL)
+            {
+                message_delivered(m);
+            }
+            feed("\r\nOK\r\n");
+        }
+        return;
+    }
+
+    if (strncmp(line, "AT+MQTTPUBRAW=0,", 16U) == 0)
+    {
+        unsigned length = 0U;
+        const char *p = parse_quoted(&line[16], topic, &topic_length, sizeof(topic) - 1U);
+        CHECK(sscanf(p, ",%u,%u,%u", &length, &qos, &retain) == 3);
+        if (!s_modem.link_up)
+        {
+            feed("\r\nERROR\r\n");
+            return;
+        }
+        s_modem.raw_pending = true;
+        s_modem.raw_length = length;
+        s_modem.raw_topic = topic_index(topic);
+        s_modem.raw_qos = (uint8_t)qos;
+        feed("\r\nOK\r\n\r\n>");
+        return;
+    }
+
+    printf("unexpected command: %s\n", line);
+    CHECK(0);
+}
+
+static void modem_link_events(void)
+{
+    if (s_modem.link_up && roll(s_modem.drop_permille))
+    {
+        s_modem.link_up = false;
+        s_modem.reconnect_tick = s_tick + 200U + rand_next() % 3000U;
+        feed("+MQTTDISCONNECTED:0\r\n");
+        s_modem.sent_while_offline = 0U;
+    }
+    else if (!s_modem.link_up && (int32_t)(s_tick - s_modem.reconnect_tick) >= 0)
+    {
+        /* 断开后已在 AT 队列中的命令最多一窗 */
+        CHECK(s_modem.sent_while_offline <= ESP8266_MQTT_WINDOW);
+        s_modem.link_up = true;
+        feed("+MQTTCONNECTED:0,1,\"broker\",\"1883\",\"\",1\r\n");
+    }
+}
+
+/* ---------------- 驱动 ---------------- */
+
+static void boot(bool with_backend)
+{
+    esp8266_at_deinit();
+    CHECK_EQ(esp8266_at_init(), ESP8266_AT_STATUS_OK);
+    CHECK_EQ(esp8266_mqtt_init(0U, with_backend ? &s_backend : NULL), ESP8266_AT_STATUS_OK);
+    for (uint8_t i = 0U; i < TOPICS; ++i)
+    {
+        s_topic_ids[i] = esp8266_mqtt_intern(s_topic_names[i]);
+        CHECK(s_topic_ids[i] != ESP8266_MQTT_TOPIC_INVALID);
+    }
+    s_tx_length = 0U;
+    s_modem.raw_pending = false;
+}
+
+/* 一步：处理、检查窗口、模组回复、推进时间 */
+static void step(void)
+{
+    esp8266_mqtt_process();
+    CHECK(esp8266_at_pending_command_count() <= ESP8266_MQTT_WINDOW);
+    modem_handle_tx();
+    s_tick += 1U + rand_next() % 5U;
+}
+
+static void reset_model(void)
+{
+    memset(s_messages, 0, sizeof(s_messages));
+    memset(s_store, 0, sizeof(s_store));
+    memset(&s_modem, 0, sizeof(s_modem));
+    s_message_count = 0U;
+    s_last_first_try = UINT32_MAX;
+    s_first_try_order_errors = 0U;
+    s_early_retries = 0U;
+    s_modem.link_up = true;
+}
+
+/* 发布直到发件箱满；返回被拒绝的次数 */
+static uint32_t publish_random(uint32_t attempts, uint32_t topic_mask, size_t max_length)
+{
+    uint32_t rejected = 0U;
+
+    for (uint32_t i = 0U; i < attempts && s_message_count < MESSAGES_MAX; ++i)
+    {
+        uint8_t topic;
+        do
+        {
+            topic = (uint8_t)(rand_next() % TOPICS);
+        } while ((topic_mask & (1U << topic)) == 0U);
+        const uint8_t qos = (uint8_t)(rand_next() % 2U);
+
+        if (esp8266_mqtt_outbox_count() >= ESP8266_MQTT_OUTBOX_DEPTH)
+        {
+            /* 满时拒绝，不占编号 */
+            const uint8_t probe[] = "0|";
+            CHECK_EQ(esp8266_mqtt_publish(s_topic_ids[topic], probe, 2U, qos, false),
+                     ESP8266_AT_STATUS_BUFFER_OVERFLOW);
+            ++rejected;
+            continue;
+        }
+        const uint32_t id = message_new(topic, qos, max_length);
+        CHECK_EQ(esp8266_mqtt_publish(s_topic_ids[topic], s_messages[id].payload, s_messages[id].length, qos, false),
+                 ESP8266_AT_STATUS_OK);
+    }
+    return rejected;
+}
+
+static void drain(void)
+{
+    for (uint32_t i = 0U; i < 200000U; ++i)
+    {
+        if (esp8266_mqtt_outbox_count() == 0U && esp8266_at_pending_command_count() == 0U)
+        {
+            return;
+        }
+        modem_link_events();
+        step();
+    }
+    CHECK(0);
+}
+
+/* 送达记录与统计一致；QoS 1 恰好一次，QoS 0 最多一次 */
+static void check_deliveries(const esp8266_mqtt_stats_t *stats, uint32_t published_before, uint32_t dropped_before)
+{
+    uint32_t delivered = 0U;
+    uint32_t lost = 0U;
+
+    for (uint32_t i = 0U; i < s_message_count; ++i)
+    {
+        const message_t *m = &s_messages[i];
+        if (m->qos > 0U)
+        {
+            CHECK_EQ(m->deliveries, 1U);
+        }
+        else
+        {
+            CHECK(m->deliveries <= 1U);
+            lost += (m->deliveries == 0U) ? 1U : 0U;
+        }
+        delivered += m->deliveries;
+    }
+    CHECK_EQ(stats->published - published_before, delivered);
+    CHECK_EQ(stats->dropped - dropped_before, lost);
+    CHECK_EQ(s_first_try_order_errors, 0U);
+    CHECK_EQ(s_early_retries, 0U);
+}
+
+/* 链路稳定：同一主题的小消息连续发布，检查合并与顺序 */
+static void test_coalescing(void)
+{
+    esp8266_mqtt_stats_t stats;
+
+    reset_model();
+    boot(false);
+    esp8266_mqtt_set_online(true);
+    for (uint32_t round = 0U; round < 400U; ++round)
+    {
+        (void)publish_random(1U + rand_next() % 6U, 1U, 24U);
+        for (uint32_t i = 0U; i < 4U; ++i)
+        {
+            step();
+        }
+    }
+    drain();
+
+    esp8266_mqtt_get_stats(&stats);
+    check_deliveries(&stats, 0U, 0U);
+    CHECK_EQ(stats.retries, 0U);
+    CHECK_EQ(stats.published, s_message_count);
+    CHECK(s_modem.commands < s_message_count);
+    printf("coalesce: %u messages in %u commands (%.2f per command)\n",
+           (unsigned)s_message_count, (unsigned)s_modem.commands,
+           (double)s_message_count / (double)s_modem.commands);
+}
+
+/*
+ * 故障注入：命令失败、不回复、broker 断开与恢复，以及随机时刻的重启。
+ */
+static void test_faults(void)
+{
+    esp8266_mqtt_stats_t stats;
+    uint32_t published = 0U;
+    uint32_t dropped = 0U;
+    uint32_t retries = 0U;
+    uint32_t rejected = 0U;
+    uint32_t reboots = 0U;
+    uint32_t rejected_by_driver = 0U;
+
+    reset_model();
+    s_modem.fail_permille = 60U;
+    s_modem.silent_permille = 15U;
+    s_modem.drop_permille = 2U;
+    boot(true);
+    esp8266_mqtt_set_online(true);
+
+    while (s_message_count < MESSAGES_MAX - 64U)
+    {
+        rejected += publish_random((rand_next() % 3U == 0U) ? 1U : 0U, 7U, 100U);
+        modem_link_events();
+
+        esp8266_mqtt_process();
+        CHECK(esp8266_at_pending_command_count() <= ESP8266_MQTT_WINDOW);
+
+        /* 已送出的回复都已处理、刚发出的命令还没回复时重启：broker 没收到这条，恢复后重发 */
+        if (rand_next() % 4000U == 0U)
+        {
+            esp8266_mqtt_get_stats(&stats);
+            published += stats.published;
+            dropped += stats.dropped;
+            retries += stats.retries;
+            rejected_by_driver += stats.rejected;
+            boot(true);
+            esp8266_mqtt_set_online(s_modem.link_up);
+            for (uint32_t i = 0U; i < s_message_count; ++i)
+            {
+                s_messages[i].failed = false;   /* 重启清除退避，恢复的消息立即重发 */
+            }
+            ++reboots;
+            s_tick += 1U;
+            continue;
+        }
+
+        modem_handle_tx();
+        s_tick += 1U + rand_next() % 5U;
+    }
+
+    s_modem.fail_permille = 0U;
+    s_modem.silent_permille = 0U;
+    s_modem.drop_permille = 0U;
+    drain();
+
+    esp8266_mqtt_get_stats(&stats);
+    stats.published += published;
+    stats.dropped += dropped;
+    stats.retries += retries;
+    stats.rejected += rejected_by_driver;
+    check_deliveries(&stats, 0U, 0U);
+    CHECK_EQ(stats.rejected, rejected);
+    for (uint32_t i = 0U; i < ESP8266_MQTT_OUTBOX_DEPTH; ++i)
+    {
+        CHECK(!s_store[i].valid);
+    }
+
+    uint32_t first_try = 0U;
+    for (uint32_t i = 0U; i < s_message_count; ++i)
+    {
+        first_try += s_messages[i].first_try;
+    }
+    printf("faults: %u messages, %u commands, %u delivered (%u on the first send), %u retried, "
+           "%u QoS 0 dropped, %u rejected, %u reboots\n",
+           (unsigned)s_message_count, (unsigned)s_modem.commands, (unsigned)stats.published,
+           (unsigned)first_try, (unsigned)stats.retries, (unsigned)stats.dropped,
+           (unsigned)stats.rejected, (unsigned)reboots);
+}
+
+/* 离线时只排队；重启后从后端恢复并按顺序全部送达 */
+static void test_restore(void)
+{
+    esp8266_mqtt_stats_t stats;
+
+    reset_model();
+    boot(true);
+    esp8266_mqtt_set_online(false);
+    (void)publish_random(ESP8266_MQTT_OUTBOX_DEPTH, 5U, 60U);
+    for (uint32_t i = 0U; i < 50U; ++i)
+    {
+        step();
+    }
+    CHECK_EQ(s_modem.commands, 0U);
+    CHECK_EQ(esp8266_mqtt_outbox_count(), ESP8266_MQTT_OUTBOX_DEPTH);
+
+    /* 满箱：拒绝并计数 */
+    CHECK_EQ(esp8266_mqtt_publish(s_topic_ids[0], "x", 1U, 1U, false), ESP8266_AT_STATUS_BUFFER_OVERFLOW);
+    esp8266_mqtt_get_stats(&stats);
+    CHECK_EQ(stats.rejected, 1U);
+
+    boot(true);
+    CHECK_EQ(esp8266_mqtt_outbox_count(), ESP8266_MQTT_OUTBOX_DEPTH);
+    feed("+MQTTCONNECTED:0,1,\"broker\",\"1883\",\"\",1\r\n");
+    CHECK(esp8266_mqtt_is_online());
+    drain();
+    esp8266_mqtt_get_stats(&stats);
+    check_deliveries(&stats, 0U, 0U);
+    CHECK_EQ(stats.published, ESP8266_MQTT_OUTBOX_DEPTH);
+
+    /* 参数检查 */
+    CHECK_EQ(esp8266_mqtt_publish(s_topic_ids[0], "x", 0U, 0U, false), ESP8266_AT_STATUS_INVALID_ARGUMENT);
+    CHECK_EQ(esp8266_mqtt_publish(s_topic_ids[0], "x", 1U, 3U, false), ESP8266_AT_STATUS_INVALID_ARGUMENT);
+    CHECK_EQ(esp8266_mqtt_publish(TOPICS, "x", 1U, 0U, false), ESP8266_AT_STATUS_INVALID_ARGUMENT);
+    CHECK_EQ(esp8266_mqtt_intern(""), ESP8266_MQTT_TOPIC_INVALID);
+    CHECK_EQ(esp8266_mqtt_intern(s_topic_names[1]), s_topic_ids[1]);
+}
+
+int main(void)
+{
+    test_restore();
+    test_coalescing();
+    test_faults();
+    return HOST_TEST_DONE();
+}
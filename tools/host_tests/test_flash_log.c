@@ -0,0 +1,245 @@
+/**
+ * @file test_flash_log.c
+ * @brief elog_flash_log：NOR 段环形日志的写入、回绕、读取，以及任意位置掉电后的重新挂载。
+ *
+ * 模拟 NOR：擦除置 0xFF；编程只允许写已擦除的字节且不跨页，否则判失败。
+ * 掉电在第 N 次编程/擦除时发生：编程按字写入一部分，擦除按地址顺序擦掉一部分，之后的操作全部失败。
+ * 日志内容是递增编号的字，重新挂载后读出的必须是一段连续编号，结尾落在被打断的那次写入范围内。
+ */
+#include "elog_flash_log.h"
+#include "host_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FLASH_SIZE      (ELOG_FLASH_LOG_ADDR + ELOG_FLASH_LOG_SEG_SIZE * ELOG_FLASH_LOG_SEG_NUM)
+#define SEG_DATA_WORDS  ((ELOG_FLASH_LOG_SEG_SIZE - 16U) / 4U)
+#define CAPACITY_WORDS  (SEG_DATA_WORDS * ELOG_FLASH_LOG_SEG_NUM)
+#define MAX_WRITE_WORDS 300U
+#define POWER_CYCLES    300U
+
+static uint8_t s_flash[FLASH_SIZE];
+static uint32_t s_ops_left;
+static int s_power_off;
+static uint32_t s_program_faults;
+static uint32_t s_reads;
+static int s_cut_seg0_erase;
+
+/** 第 i 个日志字：最高位为 0，不会是擦除值 */
+static uint32_t log_word(uint32_t i)
+{
+    return (i ^ 0x5A5A0000U) & 0x7FFFFFFFU;
+}
+
+/** 计数一次编程/擦除，返回 0 表示这次操作被掉电打断 */
+static int power_tick(void)
+{
+    if ((s_ops_left != 0U) && (--s_ops_left == 0U))
+    {
+        s_power_off = 1;
+        return 0;
+    }
+    return 1;
+}
+
+ElogFlashErrCode elog_flash_port_read(uint32_t addr, uint8_t *buf, size_t size)
+{
+    if (s_power_off || (addr + size > FLASH_SIZE))
+    {
+        return ELOG_FLASH_READ_ERR;
+    }
+    s_reads++;
+    memcpy(buf, &s_flash[addr], size);
+    return ELOG_FLASH_NO_ERR;
+}
+
+ElogFlashErrCode elog_flash_port_program(uint32_t addr, const uint8_t *buf, size_t size)
+{
+    size_t done = size;
+
+    if (s_power_off)
+    {
+        return ELOG_FLASH_WRITE_ERR;
+    }
+    if ((size == 0U) || (addr + size > FLASH_SIZE) ||
+        (addr / ELOG_FLASH_LOG_PAGE_SIZE != (addr + size - 1U) / ELOG_FLASH_LOG_PAGE_SIZE))
+    {
+        s_program_faults++;
+        return ELOG_FLASH_WRITE_ERR;
+    }
+    if (!power_tick())
+    {
+        done = (size_t)(rand() % (int)(size / 4U + 1U)) * 4U;
+    }
+    for (size_t i = 0U; i < done; ++i)
+    {
+        if (s_flash[addr + i] != 0xFFU)
+        {
+            s_program_faults++;
+        }
+        s_flash[addr + i] &= buf[i];
+    }
+    return s_power_off ? ELOG_FLASH_WRITE_ERR : ELOG_FLASH_NO_ERR;
+}
+
+ElogFlashErrCode elog_flash_port_erase(uint32_t addr)
+{
+    size_t done = ELOG_FLASH_LOG_SEG_SIZE;
+
+    if (s_power_off)
+    {
+        return ELOG_FLASH_ERASE_ERR;
+    }
+    if ((addr % ELOG_FLASH_LOG_SEG_SIZE != 0U) || (addr + ELOG_FLASH_LOG_SEG_SIZE > FLASH_SIZE))
+    {
+        s_program_faults++;
+        return ELOG_FLASH_ERASE_ERR;
+    }
+    if (s_cut_seg0_erase && (addr == ELOG_FLASH_LOG_ADDR))
+    {
+        s_power_off = 1;
+        done = (size_t)(rand() % ELOG_FLASH_LOG_SEG_SIZE);
+    }
+    else if (!power_tick())
+    {
+        done = (size_t)(rand() % ELOG_FLASH_LOG_SEG_SIZE);
+    }
+    memset(&s_flash[addr], 0xFF, done);
+    return s_power_off ? ELOG_FLASH_ERASE_ERR : ELOG_FLASH_NO_ERR;
+}
+
+/** 读出全部日志，检查编号连续，返回 [first, end) */
+static void read_all(uint32_t *first, uint32_t *end)
+{
+    static uint32_t words[CAPACITY_WORDS];
+    size_t used = elog_flash_log_get_used_size();
+    uint32_t count = (uint32_t)(used / 4U);
+    uint32_t breaks = 0U;
+
+    CHECK_EQ(used % 4U, 0U);
+    CHECK(count <= CAPACITY_WORDS);
+    if ((count == 0U) || (count > CAPACITY_WORDS))
+    {
+        *first = *end = 0U;
+        return;
+    }
+    CHECK_EQ(elog_flash_log_read(0U, words, used), ELOG_FLASH_NO_ERR);
+    *first = log_word(words[0]);
+    for (uint32_t i = 1U; i < count; ++i)
+    {
+        if (words[i] != log_word(*first + i))
+        {
+            breaks++;
+        }
+    }
+    CHECK_EQ(breaks, 0U);
+    *end = *first + count;
+}
+
+/** 写入 n 个字，编号从 next 开始 */
+static ElogFlashErrCode write_words(uint32_t next, uint32_t n)
+{
+    uint32_t words[MAX_WRITE_WORDS];
+
+    for (uint32_t i = 0U; i < n; ++i)
+    {
+        words[i] = log_word(next + i);
+    }
+    return elog_flash_log_write(words, n * 4U);
+}
+
+int main(void)
+{
+    uint32_t word = 0U, first, end, next = 0U;
+    uint32_t wrapped_cycles = 0U;
+
+    /* 空白芯片：挂载即建立存储，容量内写入后完整读回 */
+    memset(s_flash, 0xFF, sizeof(s_flash));
+    CHECK_EQ(elog_flash_log_init(), ELOG_FLASH_NO_ERR);
+    CHECK_EQ(elog_flash_log_get_used_size(), 0U);
+    CHECK_EQ(elog_flash_log_write(&word, 3U), ELOG_FLASH_WRITE_ERR);
+    CHECK_EQ(write_words(0U, 100U), ELOG_FLASH_NO_ERR);
+    CHECK_EQ(elog_flash_log_read(0U, &word, 2U), ELOG_FLASH_OUT_OF_BOUND);
+    CHECK_EQ(elog_flash_log_read(400U, &word, 4U), ELOG_FLASH_OUT_OF_BOUND);
+    CHECK_EQ(elog_flash_log_read(396U, &word, 4U), ELOG_FLASH_NO_ERR);
+    CHECK_EQ(word, log_word(99U));
+    next = 100U;
+
+    /* 挂载只做二分查找：读次数与段数、段大小成对数关系 */
+    s_reads = 0U;
+    CHECK_EQ(elog_flash_log_init(), ELOG_FLASH_NO_ERR);
+    CHECK(s_reads < 64U);
+    read_all(&first, &end);
+    CHECK_EQ(first, 0U);
+    CHECK_EQ(end, next);
+
+    /* 反复在随机操作处掉电，再重新挂载继续写，期间多次回绕 */
+    srand(43U);
+    for (uint32_t cycle = 0U; cycle < POWER_CYCLES; ++cycle)
+    {
+        uint32_t attempted = next;
+        ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+        s_ops_left = 1U + (uint32_t)(rand() % 4000);
+        while (result == ELOG_FLASH_NO_ERR)
+        {
+            uint32_t n = 1U + (uint32_t)(rand() % (int)MAX_WRITE_WORDS);
+
+            result = write_words(next, n);
+            if (result == ELOG_FLASH_NO_ERR)
+            {
+                next += n;
+            }
+            attempted = next + n;
+        }
+
+        s_power_off = 0;
+        s_ops_left = 0U;
+        CHECK_EQ(elog_flash_log_init(), ELOG_FLASH_NO_ERR);
+        read_all(&first, &end);
+        /* 已完成的写入都在，被打断的写入只留下前缀 */
+        CHECK(end >= next);
+        CHECK(end <= attempted);
+        if (end >= CAPACITY_WORDS)
+        {
+            /* 回绕后最多丢掉正在擦除的一段和最旧的一段 */
+            CHECK(end - first >= CAPACITY_WORDS - 2U * SEG_DATA_WORDS);
+            wrapped_cycles++;
+        }
+        else
+        {
+            CHECK_EQ(first, 0U);
+        }
+        next = end;
+    }
+
+    /* 回绕到段 0 时擦除被打断：挂载须从段 1 找到序列起点 */
+    s_cut_seg0_erase = 1;
+    for (uint32_t round = 0U; round < 8U; ++round)
+    {
+        uint32_t n = 1U;
+
+        while (write_words(next, n) == ELOG_FLASH_NO_ERR)
+        {
+            next += n;
+            n = 1U + (uint32_t)(rand() % (int)MAX_WRITE_WORDS);
+        }
+        s_power_off = 0;
+        CHECK_EQ(elog_flash_log_init(), ELOG_FLASH_NO_ERR);
+        read_all(&first, &end);
+        CHECK(end >= next);
+        CHECK(end - first >= CAPACITY_WORDS - 2U * SEG_DATA_WORDS);
+        next = end;
+    }
+    s_cut_seg0_erase = 0;
+    CHECK_EQ(s_program_faults, 0U);
+    CHECK(wrapped_cycles > POWER_CYCLES / 2U);
+
+    /* 清空后从头开始 */
+    CHECK_EQ(elog_flash_log_clean(), ELOG_FLASH_NO_ERR);
+    CHECK_EQ(elog_flash_log_get_used_size(), 0U);
+    CHECK_EQ(elog_flash_log_init(), ELOG_FLASH_NO_ERR);
+    CHECK_EQ(elog_flash_log_get_used_size(), 0U);
+
+    return HOST_TEST_DONE();
+}
@@ -0,0 +1,503 @@
+/**
+ * @file test_i2c_async.c
+ * @brief i2c_async 软件引擎：在模拟的开漏总线与位级从机上检查作业顺序、NACK、超时与节拍数。
+ *
+ * 总线电平为主机与从机输出的线与；从机在 SCL 边沿上按 I2C 时序收发，
+ * 由 SDA 在 SCL 高电平期间的跳变识别起始/停止，并记录事件序列供断言。
+ * 每次定时器节拍调用一次 i2c_async_soft_tick()，作业耗时以节拍计，与状态机的相位数逐一核对。
+ */
+#include "i2c_async.h"
+#include "host_test.h"
+
+#include <string.h>
+
+#define SLAVE_ADDR      0xA0U
+#define SLAVE_MEM_SIZE  256U
+#define EVENT_MAX       512U
+#define TICK_LIMIT      100000U
+
+/* 从机事件：'S' 起始，'P' 停止，'A' 地址被应答，'N' 地址未应答，'W' 写入一字节，'R' 读出一字节 */
+typedef struct
+{
+    char type;
+    uint8_t value;
+} bus_event_t;
+
+enum
+{
+    SL_ADDR = 0,
+    SL_WRITE,
+    SL_READ,
+    SL_DONE
+};
+
+uint32_t host_primask;
+
+static uint8_t s_master_scl = 1U;
+static uint8_t s_master_sda = 1U;
+static uint8_t s_slave_scl_low;
+static uint8_t s_slave_sda_low;
+static uint8_t s_line_scl = 1U;
+static uint8_t s_line_sda = 1U;
+
+static struct
+{
+    uint8_t active;
+    uint8_t phase;
+    uint8_t bit;
+    uint8_t shift;
+    uint8_t rw;
+    uint8_t master_ack;
+    uint8_t after_start;      /* 起始后的第一个 SCL 下降沿不结束任何时隙 */
+    uint8_t pointer;
+    uint8_t mem[SLAVE_MEM_SIZE];
+    uint32_t written;
+    uint32_t nack_after;      /* 写入第几个数据字节后 NACK，0 表示不 NACK */
+    uint32_t stretch;         /* 地址应答后拉低 SCL 的节拍数 */
+    uint8_t stretch_pending;
+} s_slave;
+
+static bus_event_t s_events[EVENT_MAX];
+static uint32_t s_event_count;
+static uint32_t s_glitches;
+static uint8_t s_timer_running;
+static uint32_t s_timer_starts;
+
+static void log_event(char type, uint8_t value)
+{
+    if (s_event_count < EVENT_MAX)
+    {
+        s_events[s_event_count].type = type;
+        s_events[s_event_count].value = value;
+    }
+    s_event_count++;
+}
+
+/** 从机在 SCL 下降沿之后准备下一时隙的 SDA */
+static void slave_drive_read_bit(void)
+{
+    s_slave_sda_low = ((s_slave.shift >> (7U - s_slave.bit)) & 1U) ? 0U : 1U;
+}
+
+static void slave_scl_rise(void)
+{
+    if (!s_slave.active)
+    {
+        return;
+    }
+    if (s_slave.bit < 8U)
+    {
+        if (s_slave.phase != SL_READ)
+        {
+            s_slave.shift = (uint8_t)((s_slave.shift << 1) | s_line_sda);
+        }
+    }
+    else if (s_slave.phase == SL_READ)
+    {
+        s_slave.master_ack = (s_line_sda == 0U) ? 1U : 0U;
+    }
+}
+
+static void slave_scl_fall(void)
+{
+    if (!s_slave.active)
+    {
+        return;
+    }
+    if (s_slave.after_start)
+    {
+        s_slave.after_start = 0U;
+        return;
+    }
+    if (s_slave.bit < 7U)
+    {
+        s_slave.bit++;
+        if (s_slave.phase == SL_READ)
+        {
+            slave_drive_read_bit();
+        }
+        return;
+    }
+    if (s_slave.bit == 7U)
+    {
+        /* 8 个数据位结束，进入应答时隙 */
+        s_slave.bit = 8U;
+        s_slave_sda_low = 0U;
+        if (s_slave.phase == SL_ADDR)
+        {
+            if ((s_slave.shift & 0xFEU) != SLAVE_ADDR)
+            {
+                log_event('N', s_slave.shift);
+                s_slave.active = 0U;
+                return;
+            }
+            log_event('A', s_slave.shift);
+            s_slave.rw = s_slave.shift & 1U;
+            s_slave_sda_low = 1U;
+            if (s_slave.stretch != 0U)
+            {
+                s_slave.stretch_pending = 1U;
+            }
+        }
+        else if (s_slave.phase == SL_WRITE)
+        {
+            log_event('W', s_slave.shift);
+            if (s_slave.written == 0U)
+            {
+                s_slave.pointer = s_slave.shift;
+            }
+            else
+            {
+                s_slave.mem[s_slave.pointer++] = s_slave.shift;
+            }
+            s_slave.written++;
+            s_slave_sda_low = ((s_slave.nack_after == 0U) || (s_slave.written < s_slave.nack_after)) ? 1U : 0U;
+        }
+        return;
+    }
+    /* 应答时隙结束 */
+    s_slave.bit = 0U;
+    s_slave_sda_low = 0U;
+    if (s_slave.phase == SL_ADDR)
+    {
+        s_slave.phase = s_slave.rw ? SL_READ : SL_WRITE;
+        if (s_slave.phase == SL_READ)
+        {
+            s_slave.shift = s_slave.mem[s_slave.pointer];
+            slave_drive_read_bit();
+        }
+        s_slave.written = 0U;
+    }
+    else if (s_slave.phase == SL_READ)
+    {
+        log_event('R', s_slave.mem[s_slave.pointer]);
+        s_slave.pointer++;
+        if (s_slave.master_ack)
+        {
+            s_slave.shift = s_slave.mem[s_slave.pointer];
+            slave_drive_read_bit();
+        }
+        else
+        {
+            s_slave.phase = SL_DONE;
+        }
+    }
+}
+
+/** 重新计算线与电平，并按边沿驱动从机 */
+static void bus_update(void)
+{
+    for (int settle = 0; settle < 4; ++settle)
+    {
+        uint8_t scl = (s_master_scl && !s_slave_scl_low) ? 1U : 0U;
+        uint8_t sda = (s_master_sda && !s_slave_sda_low) ? 1U : 0U;
+        uint8_t old_scl = s_line_scl;
+        uint8_t old_sda = s_line_sda;
+
+        if ((scl == old_scl) && (sda == old_sda))
+        {
+            return;
+        }
+        s_line_scl = scl;
+        s_line_sda = sda;
+        if ((scl == old_scl) && (scl == 1U))
+        {
+            /* SCL 高时从机不改变 SDA，这里的跳变来自主机：起始或停止 */
+            if (sda == 0U)
+            {
+                log_event('S', 0U);
+                s_slave.active = 1U;
+                s_slave.phase = SL_ADDR;
+                s_slave.bit = 0U;
+                s_slave.shift = 0U;
+                s_slave.after_start = 1U;
+            }
+            else
+            {
+                log_event('P', 0U);
+                s_slave.active = 0U;
+            }
+        }
+        else if ((scl != old_scl) && (sda != old_sda))
+        {
+            /* SCL 与 SDA 同时跳变说明主机在 SCL 高时改了数据 */
+            s_glitches++;
+        }
+        if (scl != old_scl)
+        {
+            if (scl)
+            {
+                slave_scl_rise();
+            }
+            else
+            {
+                slave_scl_fall();
+                if (s_slave.stretch_pending)
+                {
+                    s_slave.stretch_pending = 0U;
+                    s_slave_scl_low = 1U;
+                }
+            }
+        }
+    }
+}
+
+static soft_i2c_status_t pin_write(void *ctx, soft_i2c_pin_state_t state)
+{
+    uint8_t *pin = (uint8_t *)ctx;
+
+    *pin = (state == SOFT_I2C_PIN_SET) ? 1U : 0U;
+    bus_update();
+    return SOFT_I2C_STATUS_OK;
+}
+
+static soft_i2c_pin_state_t pin_read(void *ctx)
+{
+    uint8_t *line = (ctx == &s_master_scl) ? &s_line_scl : &s_line_sda;
+
+    return (*line != 0U) ? SOFT_I2C_PIN_SET : SOFT_I2C_PIN_RESET;
+}
+
+static void timer_start(void)
+{
+    s_timer_running = 1U;
+    s_timer_starts++;
+}
+
+static void timer_stop(void)
+{
+    s_timer_running = 0U;
+}
+
+/* 完成记录：按完成顺序保存 ctx 与状态 */
+static uintptr_t s_done_ctx[32];
+static i2c_async_status_t s_done_status[32];
+static uint32_t s_done_count;
+static i2c_async_bus_t s_bus;
+static uint8_t s_chain_buf[2] = { 0x40U, 0x5AU };
+
+static void on_done(i2c_async_status_t status, void *ctx)
+{
+    if (s_done_count < 32U)
+    {
+        s_done_ctx[s_done_count] = (uintptr_t)ctx;
+        s_done_status[s_done_count] = status;
+    }
+    s_done_count++;
+}
+
+/** 回调中串联下一个作业，模拟 AHT30 的触发-读取流程 */
+static void on_done_chain(i2c_async_status_t status, void *ctx)
+{
+    on_done(status, ctx);
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR, s_chain_buf, 2U, on_done, (void *)99), I2C_ASYNC_STATUS_OK);
+}
+
+/** 超时后从机复位并释放总线，模拟从机自身的超时恢复 */
+static void on_done_release(i2c_async_status_t status, void *ctx)
+{
+    on_done(status, ctx);
+    s_slave.stretch = 0U;
+    s_slave.active = 0U;
+    s_slave_sda_low = 0U;
+    bus_update();
+    s_slave_scl_low = 0U;
+    bus_update();
+}
+
+/** 定时器运行期间逐拍推进，返回作业耗费的节拍数；期间按需释放时钟延展 */
+static uint32_t run_ticks(void)
+{
+    uint32_t ticks = 0U;
+
+    while (s_timer_running && (ticks < TICK_LIMIT))
+    {
+        if (s_slave_scl_low && (s_slave.stretch != 0U) && (--s_slave.stretch == 0U))
+        {
+            s_slave_scl_low = 0U;
+            bus_update();
+        }
+        i2c_async_soft_tick(&s_bus);
+        ticks++;
+    }
+    return ticks;
+}
+
+static void reset_log(void)
+{
+    s_event_count = 0U;
+    s_done_count = 0U;
+}
+
+static int events_are(const char *types)
+{
+    size_t n = strlen(types);
+
+    if (s_event_count != n)
+    {
+        return 0;
+    }
+    for (size_t i = 0U; i < n; ++i)
+    {
+        if (s_events[i].type != types[i])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* 相位数：起始 2 拍，每字节 9 个时隙各 2 拍，重复起始 3 拍，停止 3 拍 */
+#define TICKS_START     2U
+#define TICKS_BYTE      18U
+#define TICKS_RESTART   3U
+#define TICKS_STOP      3U
+
+int main(void)
+{
+    const soft_i2c_pin_io_t scl = { pin_write, pin_read, &s_master_scl };
+    const soft_i2c_pin_io_t sda = { pin_write, pin_read, &s_master_sda };
+    const uint8_t tx[4] = { 0x10U, 0xDEU, 0xADU, 0xBEU };
+    uint8_t rx[8];
+    uint32_t ticks;
+
+    for (uint32_t i = 0U; i < SLAVE_MEM_SIZE; ++i)
+    {
+        s_slave.mem[i] = (uint8_t)(i * 37U + 5U);
+    }
+    CHECK_EQ(i2c_async_init_soft(&s_bus, &scl, &sda, NULL, timer_stop), I2C_ASYNC_STATUS_INVALID_PARAM);
+    CHECK_EQ(i2c_async_init_soft(&s_bus, &scl, &sda, timer_start, timer_stop), I2C_ASYNC_STATUS_OK);
+    CHECK(i2c_async_is_idle(&s_bus));
+
+    /* 写：寄存器指针 + 3 字节 */
+    reset_log();
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR, tx, 4U, on_done, (void *)1), I2C_ASYNC_STATUS_OK);
+    CHECK(s_timer_running);
+    ticks = run_ticks();
+    CHECK_EQ(ticks, TICKS_START + 5U * TICKS_BYTE + TICKS_STOP);
+    CHECK(events_are("SAWWWWP"));
+    CHECK_EQ(s_done_count, 1U);
+    CHECK_EQ(s_done_status[0], I2C_ASYNC_STATUS_OK);
+    CHECK_EQ(s_slave.mem[0x10], 0xDEU);
+    CHECK_EQ(s_slave.mem[0x12], 0xBEU);
+    CHECK(i2c_async_is_idle(&s_bus));
+    CHECK_EQ(s_line_scl, 1U);
+    CHECK_EQ(s_line_sda, 1U);
+
+    /* 先写后读：重复起始，中间没有停止；最后一字节由主机 NACK */
+    reset_log();
+    memset(rx, 0, sizeof(rx));
+    CHECK_EQ(i2c_async_write_read(&s_bus, SLAVE_ADDR, tx, 1U, rx, 3U, on_done, (void *)2), I2C_ASYNC_STATUS_OK);
+    ticks = run_ticks();
+    CHECK_EQ(ticks, TICKS_START + 2U * TICKS_BYTE + TICKS_RESTART + 4U * TICKS_BYTE + TICKS_STOP);
+    CHECK(events_are("SAWSARRRP"));
+    CHECK_EQ(rx[0], 0xDEU);
+    CHECK_EQ(rx[1], 0xADU);
+    CHECK_EQ(rx[2], 0xBEU);
+    CHECK_EQ(s_slave.phase, SL_DONE);
+    CHECK_EQ(s_done_status[0], I2C_ASYNC_STATUS_OK);
+
+    /* 纯读：从当前指针继续 */
+    reset_log();
+    s_slave.pointer = 0x20U;
+    CHECK_EQ(i2c_async_read(&s_bus, SLAVE_ADDR, rx, 2U, on_done, (void *)3), I2C_ASYNC_STATUS_OK);
+    CHECK_EQ(run_ticks(), TICKS_START + 3U * TICKS_BYTE + TICKS_STOP);
+    CHECK(events_are("SARRP"));
+    CHECK_EQ(rx[0], s_slave.mem[0x20]);
+    CHECK_EQ(rx[1], s_slave.mem[0x21]);
+    CHECK_EQ(i2c_async_read(&s_bus, SLAVE_ADDR, rx, 0U, on_done, NULL), I2C_ASYNC_STATUS_INVALID_PARAM);
+
+    /* 地址 NACK：报错，仍然发出停止并释放总线 */
+    reset_log();
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR + 2U, tx, 4U, on_done, (void *)4), I2C_ASYNC_STATUS_OK);
+    CHECK_EQ(run_ticks(), TICKS_START + TICKS_BYTE + TICKS_STOP);
+    CHECK(events_are("SNP"));
+    CHECK_EQ(s_done_status[0], I2C_ASYNC_STATUS_ERROR);
+    CHECK_EQ(s_line_sda, 1U);
+
+    /* 数据 NACK：第 2 个数据字节被拒绝后不再发送后续字节 */
+    reset_log();
+    s_slave.nack_after = 2U;
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR, tx, 4U, on_done, (void *)5), I2C_ASYNC_STATUS_OK);
+    CHECK_EQ(run_ticks(), TICKS_START + 3U * TICKS_BYTE + TICKS_STOP);
+    CHECK(events_are("SAWWP"));
+    CHECK_EQ(s_done_status[0], I2C_ASYNC_STATUS_ERROR);
+    s_slave.nack_after = 0U;
+
+    /* 仅地址探测（ACK 轮询）：应答为成功，未应答为错误 */
+    reset_log();
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR, NULL, 0U, on_done, (void *)6), I2C_ASYNC_STATUS_OK);
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR + 4U, NULL, 0U, on_done, (void *)7), I2C_ASYNC_STATUS_OK);
+    CHECK_EQ(run_ticks(), 2U * (TICKS_START + TICKS_BYTE + TICKS_STOP));
+    CHECK(events_are("SAPSNP"));
+    CHECK_EQ(s_done_status[0], I2C_ASYNC_STATUS_OK);
+    CHECK_EQ(s_done_status[1], I2C_ASYNC_STATUS_ERROR);
+
+    /* 时钟延展：从机在应答时隙的下降沿拉低 SCL 50 拍，其中第一拍与该时隙的低电平相位重合 */
+    reset_log();
+    s_slave.stretch = 50U;
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR, tx, 2U, on_done, (void *)8), I2C_ASYNC_STATUS_OK);
+    ticks = run_ticks();
+    CHECK_EQ(ticks, TICKS_START + 3U * TICKS_BYTE + TICKS_STOP + 50U - 1U);
+    CHECK(events_are("SAWWP"));
+    CHECK_EQ(s_done_status[0], I2C_ASYNC_STATUS_OK);
+
+    /* 延展超时：应答时隙的高电平等满 I2C_ASYNC_STRETCH_TICKS 后报超时，下一作业正常执行 */
+    reset_log();
+    s_slave.stretch = TICK_LIMIT;
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR, tx, 2U, on_done_release, (void *)9), I2C_ASYNC_STATUS_OK);
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR, tx, 2U, on_done, (void *)10), I2C_ASYNC_STATUS_OK);
+    ticks = run_ticks();
+    CHECK_EQ(ticks, (TICKS_START + TICKS_BYTE - 1U + I2C_ASYNC_STRETCH_TICKS + 1U) +
+                    (TICKS_START + 3U * TICKS_BYTE + TICKS_STOP));
+    CHECK(events_are("SASAWWP"));
+    CHECK_EQ(s_done_count, 2U);
+    CHECK_EQ(s_done_status[0], I2C_ASYNC_STATUS_TIMEOUT);
+    CHECK_EQ(s_done_ctx[0], 9U);
+    CHECK_EQ(s_done_status[1], I2C_ASYNC_STATUS_OK);
+    CHECK_EQ(s_done_ctx[1], 10U);
+    CHECK_EQ(s_line_scl, 1U);
+    CHECK_EQ(s_line_sda, 1U);
+
+    /* 背靠背：队列填满后拒绝，按提交顺序完成，回调中串联的作业排在最后 */
+    reset_log();
+    s_timer_starts = 0U;
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR, tx, 2U, on_done_chain, (void *)100), I2C_ASYNC_STATUS_OK);
+    for (uint32_t i = 1U; i < I2C_ASYNC_QUEUE_DEPTH; ++i)
+    {
+        if ((i & 1U) != 0U)
+        {
+            CHECK_EQ(i2c_async_read(&s_bus, SLAVE_ADDR, rx, 1U, on_done, (void *)(uintptr_t)(100U + i)), I2C_ASYNC_STATUS_OK);
+        }
+        else
+        {
+            CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR + 2U, tx, 1U, on_done, (void *)(uintptr_t)(100U + i)), I2C_ASYNC_STATUS_OK);
+        }
+    }
+    CHECK_EQ(i2c_async_write(&s_bus, SLAVE_ADDR, tx, 1U, on_done, NULL), I2C_ASYNC_STATUS_QUEUE_FULL);
+    CHECK(!i2c_async_is_idle(&s_bus));
+    {
+        uint32_t completed = s_bus.completed;
+        uint32_t failed = s_bus.failed;
+
+        run_ticks();
+        CHECK_EQ(s_done_count, I2C_ASYNC_QUEUE_DEPTH + 1U);
+        for (uint32_t i = 0U; i < I2C_ASYNC_QUEUE_DEPTH; ++i)
+        {
+            CHECK_EQ(s_done_ctx[i], 100U + i);
+            CHECK_EQ(s_done_status[i], ((i != 0U) && ((i & 1U) == 0U)) ? I2C_ASYNC_STATUS_ERROR : I2C_ASYNC_STATUS_OK);
+        }
+        CHECK_EQ(s_done_ctx[I2C_ASYNC_QUEUE_DEPTH], 99U);
+        CHECK_EQ(s_bus.completed - completed, I2C_ASYNC_QUEUE_DEPTH / 2U + 2U);
+        CHECK_EQ(s_bus.failed - failed, I2C_ASYNC_QUEUE_DEPTH / 2U - 1U);
+        CHECK_EQ(s_slave.mem[0x40], 0x5AU);
+    }
+    /* 作业之间不停表，队列清空后才停 */
+    CHECK_EQ(s_timer_starts, I2C_ASYNC_QUEUE_DEPTH + 1U);
+    CHECK(!s_timer_running);
+    CHECK(i2c_async_is_idle(&s_bus));
+    CHECK_EQ(host_primask, 0U);
+    CHECK_EQ(s_glitches, 0U);
+
+    return HOST_TEST_DONE();
+}
@@ -0,0 +1,381 @@
+/**
+ * @file test_json_stream.c
+ * @brief json_stream / json_reader：逐字节推入的 token 序列、去转义、数字与字面量、各类错误，以及按键名分发。
+ *
+ * token 序列写成紧凑文本（如 "{ K:led S:B K:state N:1 }"）与期望比较；
+ * 另外随机生成嵌套文档，按生成时记录的 token 序列逐个核对。
+ */
+#include "json_stream.h"
+#include "host_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TEXT_SIZE   16U
+
+static char s_text[TEXT_SIZE];
+
+/** token 的紧凑文本形式 */
+static void token_text(const json_token_t *tok, char *out, size_t size)
+{
+    static const char *const kPrefix[] = { "{", "}", "[", "]", "K:", "S:", "N:", "true", "false", "null" };
+
+    if ((tok->type == JSON_TOK_KEY) || (tok->type == JSON_TOK_STRING) || (tok->type == JSON_TOK_NUMBER))
+    {
+        snprintf(out, size, "%s%s", kPrefix[tok->type], tok->text);
+    }
+    else
+    {
+        snprintf(out, size, "%s", kPrefix[tok->type]);
+    }
+}
+
+/** 逐字节推入整个文档，返回最终结果并把 token 序列写入 out */
+static json_result_t lex(const char *doc, uint16_t text_size, char *out, size_t size)
+{
+    json_stream_t js;
+    json_token_t tok;
+    json_result_t result = JSON_OK;
+    size_t len = 0U;
+
+    json_stream_init(&js, s_text, text_size);
+    out[0] = '\0';
+    for (const char *p = doc; *p != '\0'; ++p)
+    {
+        result = json_stream_push(&js, *p);
+        while (json_stream_next(&js, &tok))
+        {
+            char one[64];
+
+            token_text(&tok, one, sizeof(one));
+            CHECK_EQ(tok.len, (tok.text != NULL) ? strlen(tok.text) : 0U);
+            len += (size_t)snprintf(&out[len], size - len, "%s%s", (len != 0U) ? " " : "", one);
+        }
+        if (result >= JSON_ERR_SYNTAX)
+        {
+            return result;
+        }
+    }
+    result = json_stream_end(&js);
+    while (json_stream_next(&js, &tok))
+    {
+        char one[64];
+
+        token_text(&tok, one, sizeof(one));
+        len += (size_t)snprintf(&out[len], size - len, "%s%s", (len != 0U) ? " " : "", one);
+    }
+    return result;
+}
+
+static void expect_tokens(const char *doc, const char *expected)
+{
+    char out[512];
+
+    CHECK_EQ(lex(doc, TEXT_SIZE, out, sizeof(out)), JSON_DONE);
+    if (strcmp(out, expected) != 0)
+    {
+        printf("doc %s\n  got      %s\n  expected %s\n", doc, out, expected);
+        CHECK(0);
+    }
+}
+
+static void expect_error(const char *doc, json_result_t expected)
+{
+    char out[512];
+    json_result_t result = lex(doc, TEXT_SIZE, out, sizeof(out));
+
+    if (result != expected)
+    {
+        printf("doc %s: result %d, expected %d\n", doc, (int)result, (int)expected);
+        CHECK(0);
+    }
+}
+
+/* ---------------- 随机文档：生成文本的同时记录期望的 token 序列 ---------------- */
+static char s_doc[4096];
+static size_t s_doc_len;
+static char s_expect[8192];
+static size_t s_expect_len;
+
+static void doc_put(const char *text)
+{
+    size_t n = strlen(text);
+
+    memcpy(&s_doc[s_doc_len], text, n);
+    s_doc_len += n;
+    s_doc[s_doc_len] = '\0';
+}
+
+static void expect_put(const char *prefix, const char *text)
+{
+    s_expect_len += (size_t)snprintf(&s_expect[s_expect_len], sizeof(s_expect) - s_expect_len, "%s%s%s",
+                                     (s_expect_len != 0U) ? " " : "", prefix, text);
+}
+
+static void random_space(void)
+{
+    static const char *const kSpace[] = { "", "", "", " ", "\t", "\r\n", "  " };
+
+    doc_put(kSpace[rand() % 7]);
+}
+
+/** 随机字符串：部分字符写成转义，期望文本为去转义后的内容 */
+static void random_string(const char *prefix)
+{
+    char plain[TEXT_SIZE];
+    uint32_t n = (uint32_t)(rand() % (int)(TEXT_SIZE - 4U));
+
+    doc_put("\"");
+    for (uint32_t i = 0U; i < n; ++i)
+    {
+        char c = (char)('a' + rand() % 26);
+        int form = rand() % 8;
+
+        plain[i] = c;
+        if (form == 0)
+        {
+            char esc[8];
+
+            snprintf(esc, sizeof(esc), "\\u%04X", (unsigned)c);
+            doc_put(esc);
+        }
+        else if (form == 1)
+        {
+            plain[i] = '\n';
+            doc_put("\\n");
+        }
+        else if (form == 2)
+        {
+            plain[i] = '"';
+            doc_put("\\\"");
+        }
+        else
+        {
+            char one[2] = { c, '\0' };
+
+            doc_put(one);
+        }
+    }
+    plain[n] = '\0';
+    doc_put("\"");
+    expect_put(prefix, plain);
+}
+
+static void random_value(uint32_t depth)
+{
+    int kind = rand() % ((depth < JSON_STREAM_MAX_DEPTH) ? 7 : 5);
+    char number[16];
+
+    random_space();
+    switch (kind)
+    {
+    case 0:
+        random_string("S:");
+        break;
+    case 1:
+        snprintf(number, sizeof(number), "%d", rand() % 2001 - 1000);
+        doc_put(number);
+        expect_put("N:", number);
+        break;
+    case 2:
+        snprintf(number, sizeof(number), "%d.%02de-%d", rand() % 100, rand() % 100, rand() % 10);
+        doc_put(number);
+        expect_put("N:", number);
+        break;
+    case 3:
+        doc_put("true");
+        expect_put("true", "");
+        break;
+    case 4:
+        doc_put((rand() & 1) ? "false" : "null");
+        expect_put((s_doc[s_doc_len - 1U] == 'e') ? "false" : "null", "");
+        break;
+    case 5:
+    {
+        int count = rand() % 4;
+
+        doc_put("[");
+        expect_put("[", "");
+        for (int i = 0; i < count; ++i)
+        {
+            if (i != 0)
+            {
+                doc_put(",");
+            }
+            random_value(depth + 1U);
+        }
+        random_space();
+        doc_put("]");
+        expect_put("]", "");
+        break;
+    }
+    default:
+    {
+        int count = rand() % 4;
+
+        doc_put("{");
+        expect_put("{", "");
+        for (int i = 0; i < count; ++i)
+        {
+            if (i != 0)
+            {
+                doc_put(",");
+            }
+            random_space();
+            random_string("K:");
+            random_space();
+            doc_put(":");
+            random_value(depth + 1U);
+        }
+        random_space();
+        doc_put("}");
+        expect_put("}", "");
+        break;
+    }
+    }
+    random_space();
+}
+
+/* ---------------- json_reader：LED 命令形式的字段表 ---------------- */
+typedef struct
+{
+    char log[256];
+    size_t len;
+    int reject_at;      /* 第几个值 token 时拒绝，-1 表示不拒绝 */
+    int values;
+} reader_ctx_t;
+
+static bool on_field(const json_token_t *tok, void *ctx, const char *name)
+{
+    reader_ctx_t *r = (reader_ctx_t *)ctx;
+    char one[64];
+
+    token_text(tok, one, sizeof(one));
+    r->len += (size_t)snprintf(&r->log[r->len], sizeof(r->log) - r->len, "%s%s=%s",
+                               (r->len != 0U) ? " " : "", name, one);
+    return r->values++ != r->reject_at;
+}
+
+static bool on_led(const json_token_t *tok, void *ctx)
+{
+    return on_field(tok, ctx, "led");
+}
+
+static bool on_state(const json_token_t *tok, void *ctx)
+{
+    return on_field(tok, ctx, "state");
+}
+
+static const json_field_t kFields[] = { { "led", on_led }, { "state", on_state } };
+
+static json_result_t read_doc(json_reader_t *reader, reader_ctx_t *ctx, const char *doc, int reject_at)
+{
+    json_result_t result = JSON_OK;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->reject_at = reject_at;
+    json_reader_reset(reader);
+    for (const char *p = doc; (*p != '\0') && (result < JSON_ERR_SYNTAX); ++p)
+    {
+        result = json_reader_push(reader, *p);
+    }
+    /* 出错后继续推入也保持同一错误 */
+    if (result >= JSON_ERR_SYNTAX)
+    {
+        CHECK_EQ(json_reader_push(reader, '}'), result);
+    }
+    return json_reader_end(reader);
+}
+
+int main(void)
+{
+    char out[512];
+    json_reader_t reader;
+    reader_ctx_t ctx;
+
+    /* token 序列与深度 */
+    expect_tokens("{\"led\":\"B\",\"state\":1}", "{ K:led S:B K:state N:1 }");
+    expect_tokens(" [ 1 , -0.5e+3 , true,false ,null,[],{} ] ", "[ N:1 N:-0.5e+3 true false null [ ] { } ]");
+    expect_tokens("\"a\\\"\\\\\\/\\b\\f\\n\\r\\tz\"", "S:a\"\\/\b\f\n\r\tz");
+    expect_tokens("\"\\u0041\\u00e9\\u20AC\"", "S:A\xC3\xA9\xE2\x82\xAC");
+    expect_tokens("0", "N:0");
+    expect_tokens("-12", "N:-12");
+    expect_tokens("true", "true");
+    expect_tokens("{\"k\":[{\"x\":[1]}]}", "{ K:k [ { K:x [ N:1 ] } ] }");
+
+    /* 语法错误 */
+    expect_error("", JSON_ERR_INCOMPLETE);
+    expect_error("{\"led\":1", JSON_ERR_INCOMPLETE);
+    expect_error("\"abc", JSON_ERR_INCOMPLETE);
+    expect_error("{\"a\" 1}", JSON_ERR_SYNTAX);
+    expect_error("{1:2}", JSON_ERR_SYNTAX);
+    expect_error("[1,]", JSON_ERR_SYNTAX);
+    expect_error("{\"a\":1,}", JSON_ERR_SYNTAX);
+    expect_error("[1}", JSON_ERR_SYNTAX);
+    expect_error("{\"a\":1]", JSON_ERR_SYNTAX);
+    expect_error("]", JSON_ERR_SYNTAX);
+    expect_error("[1 2]", JSON_ERR_SYNTAX);
+    expect_error("{} {}", JSON_ERR_SYNTAX);
+    expect_error("1 x", JSON_ERR_SYNTAX);
+    expect_error("01", JSON_ERR_SYNTAX);
+    expect_error("1.", JSON_ERR_SYNTAX);
+    expect_error("-", JSON_ERR_SYNTAX);
+    expect_error("1e+", JSON_ERR_SYNTAX);
+    expect_error("1-2", JSON_ERR_SYNTAX);
+    expect_error("tru", JSON_ERR_SYNTAX);
+    expect_error("nulls", JSON_ERR_SYNTAX);
+    expect_error("\"a\\x\"", JSON_ERR_SYNTAX);
+    expect_error("\"\\u12G4\"", JSON_ERR_SYNTAX);
+    expect_error("\"\\u0000\"", JSON_ERR_SYNTAX);
+    expect_error("\"a\nb\"", JSON_ERR_SYNTAX);
+
+    /* 嵌套深度与文本长度上限 */
+    expect_tokens("[[[[[[[[]]]]]]]]", "[ [ [ [ [ [ [ [ ] ] ] ] ] ] ] ]");
+    expect_error("[[[[[[[[[]]]]]]]]]", JSON_ERR_DEPTH);
+    expect_tokens("\"123456789012345\"", "S:123456789012345");
+    expect_error("\"1234567890123456\"", JSON_ERR_TOKEN);
+    expect_error("1234567890123456", JSON_ERR_TOKEN);
+    expect_error("\"12345678901234\\u00e9\"", JSON_ERR_TOKEN);
+    CHECK_EQ(lex("\"ab\"", 3U, out, sizeof(out)), JSON_DONE);
+    CHECK_EQ(lex("\"abc\"", 3U, out, sizeof(out)), JSON_ERR_TOKEN);
+
+    /* 随机文档：逐 token 与生成器一致 */
+    srand(45U);
+    for (int i = 0; i < 3000; ++i)
+    {
+        s_doc_len = 0U;
+        s_expect_len = 0U;
+        s_expect[0] = '\0';
+        random_value(0U);
+        expect_tokens(s_doc, s_expect);
+    }
+
+    /* 读取器：键名不区分大小写，值 token 交给对应字段，未知字段整体跳过 */
+    json_reader_init(&reader, kFields, 2U, &ctx, s_text, TEXT_SIZE);
+    CHECK_EQ(read_doc(&reader, &ctx, "{\"LED\":[\"B\",\"G\"],\"x\":{\"led\":[1]},\"State\":[1,0]}", -1), JSON_DONE);
+    CHECK(strcmp(ctx.log, "led=[ led=S:B led=S:G led=] state=[ state=N:1 state=N:0 state=]") == 0);
+    CHECK_EQ(json_reader_seen(&reader), 3U);
+
+    CHECK_EQ(read_doc(&reader, &ctx, "{\"state\":true}", -1), JSON_DONE);
+    CHECK_EQ(json_reader_seen(&reader), 2U);
+    CHECK(strcmp(ctx.log, "state=true") == 0);
+
+    CHECK_EQ(read_doc(&reader, &ctx, "{}", -1), JSON_DONE);
+    CHECK_EQ(json_reader_seen(&reader), 0U);
+
+    /* 重复字段、处理函数拒绝、顶层不是对象、语法错误 */
+    CHECK_EQ(read_doc(&reader, &ctx, "{\"led\":\"B\",\"Led\":\"G\",\"state\":1}", -1), JSON_ERR_DUPLICATE);
+    CHECK_EQ(read_doc(&reader, &ctx, "{\"led\":[\"B\",\"X\"],\"state\":1}", 2), JSON_ERR_FIELD);
+    CHECK(strcmp(ctx.log, "led=[ led=S:B led=S:X") == 0);
+    CHECK_EQ(read_doc(&reader, &ctx, "[1]", -1), JSON_ERR_SYNTAX);
+    CHECK_EQ(read_doc(&reader, &ctx, "\"led\"", -1), JSON_ERR_SYNTAX);
+    CHECK_EQ(read_doc(&reader, &ctx, "{\"led\":\"B\"", -1), JSON_ERR_INCOMPLETE);
+    CHECK_EQ(read_doc(&reader, &ctx, "{\"led\":\"B\" x", -1), JSON_ERR_SYNTAX);
+    CHECK_EQ(read_doc(&reader, &ctx, "{\"led\":\"toolongtoolongtoolong\"}", -1), JSON_ERR_TOKEN);
+
+    /* 出错后复位即可读取下一条 */
+    CHECK_EQ(read_doc(&reader, &ctx, "{\"led\":\"P\",\"state\":\"off\"}", -1), JSON_DONE);
+    CHECK(strcmp(ctx.log, "led=S:P state=S:off") == 0);
+
+    return HOST_TEST_DONE();
+}
@@ -0,0 +1,420 @@
+/**
+ * @file test_kvstore.c
+ * @brief kvstore 掉电一致性：在 kvstore_set / kvstore_del / 垃圾回收的每一个编程步骤处断电，重新挂载后检查各键取值。
+ *
+ * 后端是带断电注入的内存模型，每编程一个字节或擦除一个 8 字节块计为一步，
+ * 步数预算耗尽时当前字节写成随机值（模拟写了一半的单元），其后所有写擦都失败。
+ * 两种介质语义：EEPROM 直接覆盖，NOR Flash 编程只能把 1 变成 0。
+ * 参考流程逐个执行脚本操作，每步前保存镜像；对每个操作重放其全部断电点，
+ * 重新挂载后要求被操作的键为旧值或新值、其余键保持不变，且之后还能继续写入。
+ * 最后跑长时间写入统计各扇区擦除次数，检查轮转回收的磨损均衡。
+ */
+#include "kvstore.h"
+#include "host_test.h"
+
+#include <string.h>
+
+#define MEM_MAX         1024U
+#define ERASE_STEP      8U
+#define KEY_COUNT       6U
+#define VALUE_MAX       16U
+#define SCRIPT_OPS      160U
+#define WEAR_OPS        20000U
+#define SECTOR_MAX      4U
+
+typedef struct
+{
+    uint8_t mem[MEM_MAX];
+    uint8_t nor;                /* 1：NOR 语义，编程只清零位 */
+    int32_t budget;             /* 剩余步数，-1 表示不断电 */
+    uint8_t cut;
+    uint32_t steps;
+    uint32_t erases[SECTOR_MAX];
+} sim_t;
+
+/* 键的期望内容：present 为 0 表示不存在 */
+typedef struct
+{
+    uint8_t present;
+    uint8_t len;
+    uint8_t value[VALUE_MAX];
+} model_key_t;
+
+typedef struct
+{
+    uint8_t kind;               /* 0 set，1 del，2 gc */
+    uint8_t key;
+    uint8_t len;
+    uint8_t value[VALUE_MAX];
+} op_t;
+
+static const char *const s_keys[KEY_COUNT] = {"boot", "mode", "k3", "x", "wifi_ssid", "calibration"};
+
+/* 小扇区只用前几个短键与短值，保证有效数据放得下 */
+static uint32_t s_key_count;
+static uint32_t s_value_max;
+
+static uint32_t s_rand = 0x13579BDFU;
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+
+    return s_rand >> 8;
+}
+
+/* 走一步：预算耗尽时返回 1，调用者把当前单元写坏后失败返回 */
+static uint8_t sim_step(sim_t *sim)
+{
+    if (sim->cut != 0U)
+    {
+        return 1U;
+    }
+    sim->steps++;
+    if (sim->budget == 0)
+    {
+        sim->cut = 1U;
+
+        return 1U;
+    }
+    if (sim->budget > 0)
+    {
+        sim->budget--;
+    }
+
+    return 0U;
+}
+
+static void sim_store(sim_t *sim, uint32_t addr, uint8_t value)
+{
+    if (sim->nor != 0U)
+    {
+        sim->mem[addr] &= value;
+    }
+    else
+    {
+        sim->mem[addr] = value;
+    }
+}
+
+static uint8_t sim_read(void *ctx, uint32_t offset, void *buf, uint32_t len)
+{
+    sim_t *sim = (sim_t *)ctx;
+
+    CHECK(offset + len <= MEM_MAX);
+    memcpy(buf, &sim->mem[offset], len);
+
+    return 0U;
+}
+
+static uint8_t sim_prog(void *ctx, uint32_t offset, const void *buf, uint32_t len)
+{
+    sim_t *sim = (sim_t *)ctx;
+    const uint8_t *src = (const uint8_t *)buf;
+    uint32_t i;
+
+    CHECK(offset + len <= MEM_MAX);
+    for (i = 0U; i < len; i++)
+    {
+        if (sim_step(sim) != 0U)
+        {
+            if (sim->cut != 0U)
+            {
+                sim_store(sim, offset + i, (uint8_t)(src[i] ^ rand_next()));
+            }
+
+            return 1U;
+        }
+        sim_store(sim, offset + i, src[i]);
+    }
+
+    return 0U;
+}
+
+static const kvstore_backend_t *s_backend;
+
+static uint8_t sim_erase(void *ctx, uint16_t sector)
+{
+    sim_t *sim = (sim_t *)ctx;
+    uint32_t base = (uint32_t)sector * s_backend->sector_size;
+    uint32_t done;
+
+    if (sim->cut != 0U)
+    {
+        return 1U;
+    }
+    sim->erases[sector]++;
+    for (done = 0U; done < s_backend->sector_size; done += ERASE_STEP)
+    {
+        if (sim_step(sim) != 0U)
+        {
+            /* 擦了一半的块：随机位仍未恢复 */
+            uint32_t i;
+
+            for (i = 0U; i < ERASE_STEP; i++)
+            {
+                sim->mem[base + done + i] |= (uint8_t)rand_next();
+            }
+
+            return 1U;
+        }
+        memset(&sim->mem[base + done], 0xFF, ERASE_STEP);
+    }
+
+    return 0U;
+}
+
+static uint8_t key_equals(kvstore_t *kv, const char *key, const model_key_t *m)
+{
+    uint8_t buf[VALUE_MAX];
+    uint32_t len = 0U;
+    kvstore_status_t st = kvstore_get(kv, key, buf, sizeof(buf), &len);
+
+    if (m->present == 0U)
+    {
+        return (uint8_t)(st == KVSTORE_ERR_NOT_FOUND);
+    }
+
+    return (uint8_t)((st == KVSTORE_OK) && (len == m->len) && (memcmp(buf, m->value, len) == 0));
+}
+
+static kvstore_status_t op_apply(kvstore_t *kv, const op_t *op)
+{
+    if (op->kind == 0U)
+    {
+        return kvstore_set(kv, s_keys[op->key], op->value, op->len);
+    }
+    if (op->kind == 1U)
+    {
+        return kvstore_del(kv, s_keys[op->key]);
+    }
+
+    return kvstore_gc(kv);
+}
+
+static void model_apply(model_key_t *model, const op_t *op)
+{
+    if (op->kind == 0U)
+    {
+        model[op->key].present = 1U;
+        model[op->key].len = op->len;
+        memcpy(model[op->key].value, op->value, op->len);
+    }
+    else if (op->kind == 1U)
+    {
+        model[op->key].present = 0U;
+    }
+}
+
+static void op_random(op_t *op, const model_key_t *model, uint32_t n)
+{
+    uint32_t r = rand_next() % 16U;
+    uint32_t i;
+
+    op->key = (uint8_t)(rand_next() % s_key_count);
+    if ((r == 0U) && (model[op->key].present != 0U))
+    {
+        op->kind = 1U;
+    }
+    else if (r == 1U)
+    {
+        op->kind = 2U;
+    }
+    else
+    {
+        op->kind = 0U;
+        op->len = (uint8_t)(rand_next() % (s_value_max + 1U));
+        for (i = 0U; i < op->len; i++)
+        {
+            op->value[i] = (uint8_t)(n * 31U + i);
+        }
+    }
+}
+
+/*
+ * 对一个操作的每个断电点：从操作前镜像挂载、带预算执行、断电后重新挂载并核对。
+ * 返回该操作的总步数。
+ */
+static uint32_t cut_every_step(sim_t *sim, const uint8_t *image, const model_key_t *before,
+                               const model_key_t *after, const op_t *op, uint32_t *bad)
+{
+    static kvstore_t kv;
+    uint32_t total;
+    uint32_t k;
+
+    memcpy(sim->mem, image, MEM_MAX);
+    sim->budget = -1;
+    sim->cut = 0U;
+    sim->steps = 0U;
+    CHECK_EQ(kvstore_mount(&kv, s_backend), KVSTORE_OK);
+    sim->steps = 0U;
+    CHECK_EQ(op_apply(&kv, op), KVSTORE_OK);
+    total = sim->steps;
+
+    for (k = 0U; k < total; k++)
+    {
+        uint32_t key;
+        uint8_t ok = 1U;
+        model_key_t probe = {1U, 4U, {0xC0, 0xFF, 0xEE, 0x00}};
+
+        memcpy(sim->mem, image, MEM_MAX);
+        sim->budget = -1;
+        sim->cut = 0U;
+        CHECK_EQ(kvstore_mount(&kv, s_backend), KVSTORE_OK);
+        sim->budget = (int32_t)k;
+        CHECK(op_apply(&kv, op) != KVSTORE_OK);
+        CHECK_EQ(sim->cut, 1U);
+
+        sim->budget = -1;
+        sim->cut = 0U;
+        if (kvstore_mount(&kv, s_backend) != KVSTORE_OK)
+        {
+            (*bad)++;
+            continue;
+        }
+        for (key = 0U; key < s_key_count; key++)
+        {
+            if ((op->kind != 2U) && (key == op->key))
+            {
+                ok &= (uint8_t)(key_equals(&kv, s_keys[key], &before[key]) |
+                                key_equals(&kv, s_keys[key], &after[key]));
+            }
+            else
+            {
+                ok &= key_equals(&kv, s_keys[key], &before[key]);
+            }
+        }
+
+        /* 断电后仍可写入，且写入结果在再次挂载后保持 */
+        probe.value[3] = (uint8_t)k;
+        ok &= (uint8_t)(kvstore_set(&kv, "probe", probe.value, probe.len) == KVSTORE_OK);
+        ok &= (uint8_t)(kvstore_mount(&kv, s_backend) == KVSTORE_OK);
+        ok &= key_equals(&kv, "probe", &probe);
+        if (ok == 0U)
+        {
+            (*bad)++;
+        }
+    }
+
+    return total;
+}
+
+static void test_power_cut(uint32_t sector_size, uint16_t sector_count, uint8_t nor,
+                           uint32_t key_count, uint32_t value_max)
+{
+    static sim_t sim;
+    static kvstore_t kv;
+    static uint8_t image[MEM_MAX];
+    kvstore_backend_t backend;
+    model_key_t model[KEY_COUNT];
+    model_key_t before[KEY_COUNT];
+    uint32_t cuts = 0U;
+    uint32_t bad = 0U;
+    uint32_t gc_ops = 0U;
+    uint32_t n;
+
+    memset(&sim, 0, sizeof(sim));
+    memset(model, 0, sizeof(model));
+    sim.nor = nor;
+    sim.budget = -1;
+    s_key_count = key_count;
+    s_value_max = value_max;
+    backend.sector_size = sector_size;
+    backend.sector_count = sector_count;
+    backend.read = sim_read;
+    backend.prog = sim_prog;
+    backend.erase = sim_erase;
+    backend.ctx = &sim;
+    s_backend = &backend;
+
+    CHECK_EQ(kvstore_format(&kv, &backend), KVSTORE_OK);
+
+    for (n = 0U; n < SCRIPT_OPS; n++)
+    {
+        op_t op;
+        uint32_t gc_before;
+
+        op_random(&op, model, n);
+        memcpy(before, model, sizeof(model));
+        model_apply(model, &op);
+        memcpy(image, sim.mem, MEM_MAX);
+
+        cuts += cut_every_step(&sim, image, before, model, &op, &bad);
+
+        /* 参考流程：从同一镜像挂载后不断电执行 */
+        memcpy(sim.mem, image, MEM_MAX);
+        sim.budget = -1;
+        sim.cut = 0U;
+        CHECK_EQ(kvstore_mount(&kv, &backend), KVSTORE_OK);
+        gc_before = kv.gc_count;
+        CHECK_EQ(op_apply(&kv, &op), KVSTORE_OK);
+        if (kv.gc_count != gc_before)
+        {
+            gc_ops++;
+        }
+    }
+
+    printf("kvstore %s %ux%u: %u ops (%u with gc), %u power cuts, %u inconsistent\n",
+           (nor != 0U) ? "nor" : "eeprom", (unsigned)sector_size, (unsigned)sector_count,
+           (unsigned)SCRIPT_OPS, (unsigned)gc_ops, (unsigned)cuts, (unsigned)bad);
+    CHECK_EQ(bad, 0);
+    CHECK(gc_ops > 10U);
+}
+
+/* 长时间写入：轮转回收使各扇区擦除次数相差不超过 1 */
+static void test_wear(uint32_t sector_size, uint16_t sector_count, uint32_t key_count)
+{
+    static sim_t sim;
+    static kvstore_t kv;
+    kvstore_backend_t backend;
+    kvstore_stats_t stats;
+    uint32_t lo = 0xFFFFFFFFU;
+    uint32_t hi = 0U;
+    uint32_t sum = 0U;
+    uint32_t n;
+    uint16_t s;
+
+    memset(&sim, 0, sizeof(sim));
+    sim.budget = -1;
+    backend.sector_size = sector_size;
+    backend.sector_count = sector_count;
+    backend.read = sim_read;
+    backend.prog = sim_prog;
+    backend.erase = sim_erase;
+    backend.ctx = &sim;
+    s_backend = &backend;
+
+    CHECK_EQ(kvstore_format(&kv, &backend), KVSTORE_OK);
+    memset(sim.erases, 0, sizeof(sim.erases));
+    for (n = 0U; n < WEAR_OPS; n++)
+    {
+        uint32_t value = n;
+
+        CHECK_EQ(kvstore_set(&kv, s_keys[n % key_count], &value, sizeof(value)), KVSTORE_OK);
+    }
+    kvstore_get_stats(&kv, &stats);
+
+    printf("kvstore wear %ux%u after %u sets, erases per sector:", (unsigned)sector_size,
+           (unsigned)sector_count, (unsigned)WEAR_OPS);
+    for (s = 0U; s < sector_count; s++)
+    {
+        printf(" %u", (unsigned)sim.erases[s]);
+        lo = (sim.erases[s] < lo) ? sim.erases[s] : lo;
+        hi = (sim.erases[s] > hi) ? sim.erases[s] : hi;
+        sum += sim.erases[s];
+    }
+    printf("\n");
+    CHECK(hi - lo <= 1U);
+    CHECK_EQ(sum, stats.gc_count);
+    CHECK_EQ(stats.write_count, WEAR_OPS);
+}
+
+int main(void)
+{
+    test_power_cut(128U, 2U, 0U, 4U, 8U);
+    test_power_cut(256U, 3U, 1U, KEY_COUNT, VALUE_MAX);
+    test_wear(128U, 2U, 4U);
+    test_wear(256U, 4U, KEY_COUNT);
+
+    return HOST_TEST_DONE();
+}
@@ -0,0 +1,502 @@
+/**
+ * @file test_lfs_port.c
+ * @brief littlefs 内部 Flash 端口的空闲预擦除：预擦除扇区的擦除请求直接跳过，写过的扇区不被当作已擦除。
+ *
+ * 同时测试 rocketpi_flash_littlefs 的 lfs_port.c（扇区 6-7，2 块）与 rocketpi_w25qxx_littlefs 的
+ * lfs_flash_port.c（扇区 5-7，3 块）。两个文件以 #include 编入本文件以便检查其静态的已擦除位图，
+ * 同名的静态变量在包含前分别改名。Flash 用固定地址 0x08020000 的匿名映射模拟：擦除置 0xFF，
+ * 编程只能把 1 变 0，且每个被编程的字节之前必须是 0xFF（否则说明端口把脏扇区当作已擦除交给了 littlefs）。
+ * 检查：
+ * - 每次操作后位图中标记为已擦除的扇区全为 0xFF；
+ * - 空闲预擦除后的前台写入不再调用 HAL 擦除，erases_skipped 增加；
+ * - 格式化前的脏数据、删除文件后留下的数据、卸载期间写入的最后一个字，空闲时都被擦除而不是判为空白；
+ *   卸载期间已是空白的扇区只做空白检查；
+ * - 随机读写、删除、空闲调用、重新挂载与卸载期间改写空闲扇区的序列中，文件内容与模型一致，
+ *   统计中的前台/空闲擦除次数与 HAL 擦除调用按调用方分别计数一致。
+ */
+#define s_erased_map    s_port_erased_map
+#define s_idle_pending  s_port_idle_pending
+#define s_in_idle       s_port_in_idle
+#define s_erase_stats   s_port_erase_stats
+#include "lfs_port.c"
+#undef s_erased_map
+#undef s_idle_pending
+#undef s_in_idle
+#undef s_erase_stats
+
+#define s_erased_map    s_flash_port_erased_map
+#define s_idle_pending  s_flash_port_idle_pending
+#define s_in_idle       s_flash_port_in_idle
+#define s_erase_stats   s_flash_port_erase_stats
+#include "lfs_flash_port.c"
+#undef s_erased_map
+#undef s_idle_pending
+#undef s_in_idle
+#undef s_erase_stats
+
+#include "host_test.h"
+
+#include <stdio.h>
+#include <sys/mman.h>
+
+#define FLASH_BASE      0x08020000UL    /* 扇区 5 */
+#define FLASH_SIZE      0x60000UL       /* 扇区 5-7 */
+#define SECTOR_SIZE     0x20000UL
+#define SMALL_FILES     6U
+#define SMALL_MAX       200U
+#define BIG_MAX         100000U
+#define RANDOM_OPS      3000U
+
+typedef struct
+{
+    const char *name;
+    const struct lfs_config *cfg;
+    int (*format)(lfs_t *lfs);
+    int (*mount)(lfs_t *lfs);
+    int (*unmount)(lfs_t *lfs);
+    int (*idle)(lfs_t *lfs);
+    void (*get_stats)(lfs_port_erase_stats_t *stats);
+    const uint32_t *erased_map;
+    uint32_t start;
+    uint32_t first_sector;
+    uint32_t block_count;
+} port_t;
+
+typedef struct
+{
+    uint8_t data[BIG_MAX];
+    uint32_t size;
+    int exists;
+} model_file_t;
+
+static uint8_t *s_flash;
+static int s_unlocked;
+static int s_in_idle_call;
+static uint32_t s_hal_erases_fg;
+static uint32_t s_hal_erases_idle;
+static uint32_t s_rand = 12345U;
+static lfs_t s_lfs;
+static model_file_t s_small[SMALL_FILES];
+static model_file_t s_big;
+static uint8_t s_buf[BIG_MAX];
+
+static void flash_port_get_stats(lfs_port_erase_stats_t *stats)
+{
+    lfs_flash_port_erase_stats_t st;
+
+    lfs_flash_port_get_erase_stats(&st);
+    stats->idle_erases = st.idle_erases;
+    stats->idle_blank = st.idle_blank;
+    stats->erases_skipped = st.erases_skipped;
+    stats->erases_foreground = st.erases_foreground;
+}
+
+static const port_t s_ports[] = {
+    { "flash_littlefs/lfs_port", &lfs_port_cfg, lfs_port_format, lfs_port_mount, lfs_port_unmount,
+      lfs_port_idle, lfs_port_get_erase_stats, &s_port_erased_map, LFS_PORT_FLASH_START_ADDR,
+      FLASH_SECTOR_6, LFS_PORT_FLASH_BLOCK_COUNT },
+    { "w25qxx_littlefs/lfs_flash_port", &lfs_flash_port_cfg, lfs_flash_port_format, lfs_flash_port_mount,
+      lfs_flash_port_unmount, lfs_flash_port_idle, flash_port_get_stats, &s_flash_port_erased_map,
+      LFS_FLASH_PORT_START_ADDR, FLASH_SECTOR_5, LFS_FLASH_PORT_BLOCK_COUNT },
+};
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    CHECK(!s_unlocked);
+    s_unlocked = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    CHECK(s_unlocked);
+    s_unlocked = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+    uint32_t size = 1U << TypeProgram;
+    uint32_t i;
+
+    CHECK(s_unlocked);
+    CHECK(TypeProgram <= FLASH_TYPEPROGRAM_WORD);
+    CHECK_EQ(Address % size, 0U);
+    CHECK((Address >= FLASH_BASE) && (Address + size <= FLASH_BASE + FLASH_SIZE));
+    for (i = 0U; i < size; i++)
+    {
+        uint8_t *cell = &s_flash[Address - FLASH_BASE + i];
+
+        /* 只能对已擦除的字节编程 */
+        CHECK_EQ(*cell, 0xFFU);
+        *cell &= (uint8_t)(Data >> (8U * i));
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+    CHECK(s_unlocked);
+    CHECK_EQ(pEraseInit->TypeErase, FLASH_TYPEERASE_SECTORS);
+    CHECK_EQ(pEraseInit->NbSectors, 1U);
+    CHECK((pEraseInit->Sector >= FLASH_SECTOR_5) && (pEraseInit->Sector <= FLASH_SECTOR_7));
+    memset(&s_flash[(pEraseInit->Sector - FLASH_SECTOR_5) * SECTOR_SIZE], 0xFF, SECTOR_SIZE);
+    if (s_in_idle_call)
+    {
+        s_hal_erases_idle++;
+    }
+    else
+    {
+        s_hal_erases_fg++;
+    }
+    *SectorError = 0xFFFFFFFFU;
+    return HAL_OK;
+}
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+    return s_rand >> 8;
+}
+
+static uint8_t *sector(const port_t *p, uint32_t block)
+{
+    return &s_flash[p->start - FLASH_BASE + block * SECTOR_SIZE];
+}
+
+static int sector_blank(const port_t *p, uint32_t block)
+{
+    const uint8_t *s = sector(p, block);
+    uint32_t i;
+
+    for (i = 0U; i < SECTOR_SIZE; i++)
+    {
+        if (s[i] != 0xFFU)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/** 位图中标记为已擦除的扇区必须全为 0xFF */
+static void check_erased_map(const port_t *p)
+{
+    uint32_t b;
+
+    for (b = 0U; b < p->block_count; b++)
+    {
+        if ((*p->erased_map & (1UL << b)) != 0U)
+        {
+            CHECK(sector_blank(p, b));
+        }
+    }
+}
+
+static int idle(const port_t *p)
+{
+    int ret;
+
+    s_in_idle_call = 1;
+    ret = p->idle(&s_lfs);
+    s_in_idle_call = 0;
+    check_erased_map(p);
+    return ret;
+}
+
+static void idle_until_done(const port_t *p)
+{
+    uint32_t i;
+
+    for (i = 0U; i < 16U; i++)
+    {
+        int ret = idle(p);
+
+        CHECK(ret >= 0);
+        if (ret == 0)
+        {
+            return;
+        }
+    }
+    CHECK(0);
+}
+
+static int mark_used(void *data, lfs_block_t block)
+{
+    *(uint32_t *)data |= 1UL << block;
+    return 0;
+}
+
+/** 当前未被文件系统使用的块，没有时返回 block_count */
+static uint32_t free_block(const port_t *p)
+{
+    uint32_t used = 0U;
+    uint32_t b;
+
+    CHECK_EQ(lfs_fs_traverse(&s_lfs, mark_used, &used), 0);
+    for (b = 0U; b < p->block_count; b++)
+    {
+        if ((used & (1UL << b)) == 0U)
+        {
+            return b;
+        }
+    }
+    return p->block_count;
+}
+
+static void fill(uint8_t *data, uint32_t size, uint32_t seed)
+{
+    uint32_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        data[i] = (uint8_t)(seed + i * 31U + (i >> 7));
+    }
+}
+
+/** 写入失败只接受 LFS_ERR_NOSPC：文件已创建但为空 */
+static int write_file(const port_t *p, const char *path, model_file_t *m, uint32_t size)
+{
+    lfs_file_t file;
+    lfs_ssize_t n;
+
+    fill(s_buf, size, rand_next());
+    CHECK_EQ(lfs_file_open(&s_lfs, &file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC), 0);
+    n = lfs_file_write(&s_lfs, &file, s_buf, size);
+    CHECK_EQ(lfs_file_close(&s_lfs, &file), 0);
+    m->exists = 1;
+    check_erased_map(p);
+    if (n == LFS_ERR_NOSPC)
+    {
+        m->size = 0U;
+        return LFS_ERR_NOSPC;
+    }
+    CHECK_EQ(n, (lfs_ssize_t)size);
+    memcpy(m->data, s_buf, size);
+    m->size = size;
+    return 0;
+}
+
+/**
+ * 3 块时 lookahead 窗口覆盖整个文件系统：空闲时 lfs_fs_gc 填好的窗口里，之后删除的块仍记为已用，
+ * 下一次分配走完窗口即报 LFS_ERR_NOSPC，再分配时重新扫描才看到它。这是 littlefs 分配器的行为，
+ * 与擦除位图无关，重试一次必须成功。
+ */
+static void write_big(const port_t *p, uint32_t size, uint32_t *retries)
+{
+    if (write_file(p, "big", &s_big, size) == LFS_ERR_NOSPC)
+    {
+        (*retries)++;
+        CHECK_EQ(write_file(p, "big", &s_big, size), 0);
+    }
+}
+
+static void verify_file(const char *path, const model_file_t *m)
+{
+    lfs_file_t file;
+    int err = lfs_file_open(&s_lfs, &file, path, LFS_O_RDONLY);
+
+    if (!m->exists)
+    {
+        CHECK_EQ(err, LFS_ERR_NOENT);
+        return;
+    }
+    CHECK_EQ(err, 0);
+    CHECK_EQ(lfs_file_read(&s_lfs, &file, s_buf, sizeof(s_buf)), (lfs_ssize_t)m->size);
+    CHECK(memcmp(s_buf, m->data, m->size) == 0);
+    CHECK_EQ(lfs_file_close(&s_lfs, &file), 0);
+}
+
+static void verify_all(void)
+{
+    char path[8];
+    uint32_t i;
+
+    for (i = 0U; i < SMALL_FILES; i++)
+    {
+        snprintf(path, sizeof(path), "s%u", (unsigned)i);
+        verify_file(path, &s_small[i]);
+    }
+    verify_file("big", &s_big);
+}
+
+static void remount(const port_t *p)
+{
+    CHECK_EQ(p->unmount(&s_lfs), 0);
+    CHECK_EQ(p->mount(&s_lfs), 0);
+    CHECK_EQ(*p->erased_map, 0U);
+}
+
+/** 格式化前的脏数据不能被当作已擦除；预擦除后前台分配新块不再擦除 */
+static void test_preerase(const port_t *p)
+{
+    lfs_port_erase_stats_t before, after;
+    uint32_t fg, b;
+
+    memset(&s_flash[p->start - FLASH_BASE], 0x00, p->block_count * SECTOR_SIZE);
+    memset(s_small, 0, sizeof(s_small));
+    s_big.exists = 0;
+    CHECK_EQ(p->format(&s_lfs), 0);
+    CHECK_EQ(p->mount(&s_lfs), 0);
+    p->get_stats(&before);
+    idle_until_done(p);
+    p->get_stats(&after);
+    CHECK_EQ(after.idle_blank, before.idle_blank);
+    if (p->block_count < 3U)
+    {
+        /* 两块都属于超级块对，没有可预擦除的扇区 */
+        CHECK_EQ(free_block(p), p->block_count);
+        return;
+    }
+
+    b = free_block(p);
+    CHECK(b < p->block_count);
+    CHECK(after.idle_erases > before.idle_erases);
+    CHECK(sector_blank(p, b));
+    CHECK((*p->erased_map & (1UL << b)) != 0U);
+
+    /* 大文件需要一个新块：前台不调用 HAL 擦除，由预擦除的扇区直接满足 */
+    fg = s_hal_erases_fg;
+    p->get_stats(&before);
+    CHECK_EQ(write_file(p, "big", &s_big, 4096U), 0);
+    p->get_stats(&after);
+    CHECK_EQ(s_hal_erases_fg, fg);
+    CHECK(after.erases_skipped > before.erases_skipped);
+    CHECK_EQ(after.erases_foreground, before.erases_foreground);
+    CHECK_EQ(*p->erased_map & (1UL << b), 0U);
+    verify_file("big", &s_big);
+
+    /* 删除后该块空闲但写过，空闲时必须真正擦除 */
+    CHECK_EQ(lfs_remove(&s_lfs, "big"), 0);
+    s_big.exists = 0;
+    CHECK(!sector_blank(p, b));
+    p->get_stats(&before);
+    idle_until_done(p);
+    p->get_stats(&after);
+    CHECK_EQ(after.idle_blank, before.idle_blank);
+    CHECK(after.idle_erases > before.idle_erases);
+    CHECK(sector_blank(p, b));
+
+    /* 卸载期间空闲扇区只有最后一个字被改写：挂载后不能判为空白 */
+    CHECK_EQ(p->unmount(&s_lfs), 0);
+    sector(p, b)[SECTOR_SIZE - 1U] = 0x7FU;
+    CHECK_EQ(p->mount(&s_lfs), 0);
+    p->get_stats(&before);
+    idle_until_done(p);
+    p->get_stats(&after);
+    CHECK(after.idle_erases > before.idle_erases);
+    CHECK_EQ(after.idle_blank, before.idle_blank);
+    CHECK(sector_blank(p, b));
+
+    /* 卸载期间保持空白：挂载后只做空白检查 */
+    remount(p);
+    fg = s_hal_erases_idle;
+    p->get_stats(&before);
+    idle_until_done(p);
+    p->get_stats(&after);
+    CHECK_EQ(after.idle_blank, before.idle_blank + 1U);
+    CHECK_EQ(s_hal_erases_idle, fg);
+    CHECK((*p->erased_map & (1UL << b)) != 0U);
+}
+
+static void test_random(const port_t *p)
+{
+    lfs_port_erase_stats_t stats;
+    uint32_t op, remounts = 0U, tampers = 0U, retries = 0U;
+    char path[8];
+
+    for (op = 0U; op < RANDOM_OPS; op++)
+    {
+        uint32_t r = rand_next() % 100U;
+        uint32_t i = rand_next() % SMALL_FILES;
+
+        snprintf(path, sizeof(path), "s%u", (unsigned)i);
+        if (r < 50U)
+        {
+            CHECK_EQ(write_file(p, path, &s_small[i], rand_next() % (SMALL_MAX + 1U)), 0);
+            verify_file(path, &s_small[i]);
+        }
+        else if (r < 60U)
+        {
+            CHECK_EQ(lfs_remove(&s_lfs, path), s_small[i].exists ? 0 : LFS_ERR_NOENT);
+            s_small[i].exists = 0;
+        }
+        else if ((r < 66U) && (p->block_count >= 3U))
+        {
+            /* 只有一个数据块：大文件先删除再写入 */
+            if (s_big.exists)
+            {
+                CHECK_EQ(lfs_remove(&s_lfs, "big"), 0);
+                s_big.exists = 0;
+            }
+            else
+            {
+                write_big(p, 1024U + rand_next() % (BIG_MAX - 1024U), &retries);
+                verify_file("big", &s_big);
+            }
+        }
+        else if (r < 90U)
+        {
+            CHECK(idle(p) >= 0);
+        }
+        else if (r < 97U)
+        {
+            remount(p);
+            remounts++;
+            verify_all();
+        }
+        else
+        {
+            /* 卸载期间改写一个空闲扇区的随机位置 */
+            uint32_t b = free_block(p);
+
+            CHECK_EQ(p->unmount(&s_lfs), 0);
+            if (b < p->block_count)
+            {
+                sector(p, b)[rand_next() % SECTOR_SIZE] = (uint8_t)(rand_next() & 0x7FU);
+                tampers++;
+            }
+            CHECK_EQ(p->mount(&s_lfs), 0);
+        }
+        check_erased_map(p);
+    }
+    verify_all();
+
+    p->get_stats(&stats);
+    CHECK_EQ(stats.erases_foreground, s_hal_erases_fg);
+    CHECK_EQ(stats.idle_erases, s_hal_erases_idle);
+    CHECK(stats.idle_erases > 0U);
+    if (p->block_count >= 3U)
+    {
+        CHECK(stats.erases_skipped > 0U);
+        CHECK(stats.idle_blank > 0U);
+        CHECK(tampers > 0U);
+    }
+    printf("%s: %u ops, %u remounts, %u tampered sectors, %u big writes retried; erases: %u foreground, %u idle, %u skipped, %u found blank\n",
+           p->name, (unsigned)RANDOM_OPS, (unsigned)remounts, (unsigned)tampers, (unsigned)retries,
+           (unsigned)stats.erases_foreground,
+           (unsigned)stats.idle_erases, (unsigned)stats.erases_skipped, (unsigned)stats.idle_blank);
+    CHECK_EQ(p->unmount(&s_lfs), 0);
+}
+
+int main(void)
+{
+    size_t i;
+
+    s_flash = mmap((void *)FLASH_BASE, FLASH_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (s_flash != (uint8_t *)FLASH_BASE)
+    {
+        printf("cannot map the flash image at 0x%08lx\n", FLASH_BASE);
+        return 1;
+    }
+
+    for (i = 0U; i < sizeof(s_ports) / sizeof(s_ports[0]); i++)
+    {
+        s_hal_erases_fg = 0U;
+        s_hal_erases_idle = 0U;
+        test_preerase(&s_ports[i]);
+        test_random(&s_ports[i]);
+    }
+    return HOST_TEST_DONE();
+}
@@ -0,0 +1,510 @@
+/**
+ * @file test_mg58f18_radar.c
+ * @brief mg58f18_radar 解析器模糊测试：随机噪声、截断帧、坏校验与坏帧尾混入真实帧，逐字节与随机分块馈入。
+ *
+ * 生成器记录每个真实帧在流中的位置；参考模型按"窗口起点恒为 5A，校验失败跳到下一个 5A"
+ * 的规则在整条流上独立求出期望的帧序列、frame_errors、dropped_bytes 与窗口内残留字节数。
+ * 检查项：
+ *   1. 逐字节馈入时每个字节后取帧，帧序列与结束位置和参考模型一致；
+ *   2. 按 1..64 字节随机分块馈入（模拟 DMA 空闲回调）时统计量与逐字节一致；
+ *   3. 7 × frames + dropped_bytes + 残留 == 总字节数，且每个真实帧要么被解出，
+ *      要么被一个与之重叠的噪声伪帧吞掉（重同步不会跳过真实帧）；
+ *   4. 任意流之后补 6 个 0x00 再发一帧，该帧一定被解出（不会卡死）；
+ *   5. 异步命令在途时，应答夹在噪声与截断的同命令帧之间乱序到达，future 仍拿到正确应答，
+ *      只收到截断应答的命令按超时结束。
+ * 越界访问由 Makefile 中该测试的 -fsanitize=address,undefined 检查。
+ */
+#include "driver_mg58f18_radar.h"
+#include "driver_mg58f18_radar_interface.h"
+#include "host_test.h"
+
+#include <string.h>
+
+#define STREAM_MAX      4096U
+#define FRAME_MAX       (STREAM_MAX / MG58F18_RADAR_FRAME_SIZE)
+#define TRIALS          400U
+#define CHUNK_MAX       MG58F18_RADAR_RX_BUFFER_SIZE
+#define ASYNC_ROUNDS    300U
+#define ASYNC_CMDS      4U
+
+/* ---------------- 接口层替身 ---------------- */
+
+static uint32_t s_tick;
+static uint8_t s_sent[16][MG58F18_RADAR_FRAME_SIZE];
+static uint32_t s_sent_count;
+
+mg58f18_radar_status_t mg58f18_radar_interface_hw_init(void)
+{
+    return MG58F18_RADAR_STATUS_OK;
+}
+
+mg58f18_radar_status_t mg58f18_radar_interface_hw_send(const uint8_t *data, size_t length, uint32_t timeout_ms)
+{
+    return MG58F18_RADAR_STATUS_HAL_ERROR;
+}
+
+mg58f18_radar_status_t mg58f18_radar_interface_hw_send_async(const uint8_t *data, size_t length)
+{
+    if (s_sent_count < 16U && length == MG58F18_RADAR_FRAME_SIZE)
+    {
+        memcpy(s_sent[s_sent_count], data, length);
+    }
+    ++s_sent_count;
+    return MG58F18_RADAR_STATUS_OK;
+}
+
+bool mg58f18_radar_interface_hw_tx_idle(void)
+{
+    return true;
+}
+
+uint32_t mg58f18_radar_interface_hw_get_tick(void)
+{
+    return s_tick;
+}
+
+void mg58f18_radar_interface_hw_restart_rx(void)
+{
+}
+
+bool mg58f18_radar_interface_hw_read_io(void)
+{
+    return false;
+}
+
+/* ---------------- 流生成与参考模型 ---------------- */
+
+typedef struct
+{
+    uint8_t bytes[STREAM_MAX];
+    uint32_t len;
+    uint32_t real_pos[FRAME_MAX];       /* 生成器放入的真实帧起点 */
+    uint32_t real_count;
+} stream_t;
+
+typedef struct
+{
+    uint32_t pos[FRAME_MAX];            /* 解出帧的起点 */
+    uint32_t count;
+    uint32_t frame_errors;
+    uint32_t dropped;
+    uint32_t pending;                   /* 流结束时窗口内的字节数 */
+} expect_t;
+
+static uint32_t s_rand = 0x2468ACE1U;
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+    return s_rand >> 8;
+}
+
+/* 噪声偏向帧头与帧尾，使伪帧头、伪帧尾足够密集 */
+static uint8_t noise_byte(void)
+{
+    const uint32_t r = rand_next() % 8U;
+
+    if (r == 0U)
+    {
+        return MG58F18_RADAR_HEAD_BYTE;
+    }
+    if (r == 1U)
+    {
+        return MG58F18_RADAR_TAIL_BYTE;
+    }
+    return (uint8_t)rand_next();
+}
+
+static void make_frame(uint8_t out[MG58F18_RADAR_FRAME_SIZE], uint8_t command, uint8_t d2, uint8_t d3, uint8_t d4)
+{
+    out[0] = MG58F18_RADAR_HEAD_BYTE;
+    out[1] = command;
+    out[2] = d2;
+    out[3] = d3;
+    out[4] = d4;
+    out[5] = (uint8_t)(command ^ d2 ^ d3 ^ d4);
+    out[6] = MG58F18_RADAR_TAIL_BYTE;
+}
+
+static void random_frame(uint8_t out[MG58F18_RADAR_FRAME_SIZE])
+{
+    make_frame(out, noise_byte(), noise_byte(), noise_byte(), noise_byte());
+}
+
+static int frame_valid(const uint8_t *p)
+{
+    return p[0] == MG58F18_RADAR_HEAD_BYTE
+        && p[5] == (uint8_t)(p[1] ^ p[2] ^ p[3] ^ p[4])
+        && p[6] == MG58F18_RADAR_TAIL_BYTE;
+}
+
+static void stream_put(stream_t *s, const uint8_t *data, uint32_t len)
+{
+    memcpy(&s->bytes[s->len], data, len);
+    s->len += len;
+}
+
+static void stream_generate(stream_t *s, uint32_t target)
+{
+    uint8_t frame[MG58F18_RADAR_FRAME_SIZE];
+
+    s->len = 0U;
+    s->real_count = 0U;
+    while (s->len + 32U < target)
+    {
+        const uint32_t kind = rand_next() % 8U;
+
+        random_frame(frame);
+        if (kind <= 2U)
+        {
+            s->real_pos[s->real_count++] = s->len;
+            stream_put(s, frame, MG58F18_RADAR_FRAME_SIZE);
+        }
+        else if (kind == 3U)
+        {
+            /* 截断帧：只有前 1..6 字节 */
+            stream_put(s, frame, 1U + rand_next() % 6U);
+        }
+        else if (kind == 4U)
+        {
+            /* 整帧长度但有一个字节损坏（校验、帧尾或载荷） */
+            frame[1U + rand_next() % 6U] ^= (uint8_t)(1U + rand_next() % 255U);
+            stream_put(s, frame, MG58F18_RADAR_FRAME_SIZE);
+        }
+        else if (kind == 5U)
+        {
+            /* 连续帧头 */
+            const uint32_t n = 1U + rand_next() % 8U;
+            for (uint32_t i = 0U; i < n; ++i)
+            {
+                s->bytes[s->len++] = MG58F18_RADAR_HEAD_BYTE;
+            }
+        }
+        else
+        {
+            const uint32_t n = 1U + rand_next() % 20U;
+            for (uint32_t i = 0U; i < n; ++i)
+            {
+                s->bytes[s->len++] = noise_byte();
+            }
+        }
+    }
+}
+
+static uint32_t next_head(const stream_t *s, uint32_t from)
+{
+    while (from < s->len && s->bytes[from] != MG58F18_RADAR_HEAD_BYTE)
+    {
+        ++from;
+    }
+    return from;
+}
+
+/* 参考模型：窗口起点恒为 5A；整窗合法则出帧并从其后找帧头，否则从下一个字节起找帧头 */
+static void reference_decode(const stream_t *s, expect_t *e)
+{
+    uint32_t start = next_head(s, 0U);
+
+    memset(e, 0, sizeof(*e));
+    e->dropped = start;
+    while (start + MG58F18_RADAR_FRAME_SIZE <= s->len)
+    {
+        uint32_t next;
+
+        if (frame_valid(&s->bytes[start]))
+        {
+            e->pos[e->count++] = start;
+            next = next_head(s, start + MG58F18_RADAR_FRAME_SIZE);
+            e->dropped += next - (start + MG58F18_RADAR_FRAME_SIZE);
+        }
+        else
+        {
+            ++e->frame_errors;
+            next = next_head(s, start + 1U);
+            e->dropped += next - start;
+        }
+        start = next;
+    }
+    e->pending = s->len - start;
+}
+
+/* ---------------- 测试 ---------------- */
+
+static void restart(void)
+{
+    mg58f18_radar_deinit();
+    CHECK_EQ(mg58f18_radar_init(), MG58F18_RADAR_STATUS_OK);
+}
+
+static void check_stats(const expect_t *e, const char *what)
+{
+    mg58f18_radar_parser_stats_t stats;
+
+    mg58f18_radar_get_parser_stats(&stats);
+    CHECK_EQ(stats.frames, e->count);
+    CHECK_EQ(stats.frame_errors, e->frame_errors);
+    CHECK_EQ(stats.dropped_bytes, e->dropped);
+    if (stats.frames != e->count || stats.dropped_bytes != e->dropped)
+    {
+        printf("  (%s)\n", what);
+    }
+}
+
+/* 残留窗口后补 6 个 0x00：任何从残留帧头起的 7 字节窗口帧尾都落在 0x00 上，随后的真帧必被解出 */
+static void check_no_stall(void)
+{
+    static const uint8_t filler[MG58F18_RADAR_FRAME_SIZE - 1U] = {0};
+    uint8_t frame[MG58F18_RADAR_FRAME_SIZE];
+    mg58f18_radar_frame_t got;
+
+    make_frame(frame, 0x87U, 0x00U, 0x00U, 0x01U);
+    (void)mg58f18_radar_fetch_frame(NULL);
+    mg58f18_radar_receive_bytes(filler, sizeof(filler));
+    CHECK(!mg58f18_radar_fetch_frame(NULL));
+    mg58f18_radar_receive_bytes(frame, sizeof(frame));
+    CHECK(mg58f18_radar_fetch_frame(&got));
+    CHECK(memcmp(got.raw, frame, sizeof(frame)) == 0);
+}
+
+static void test_fuzz(void)
+{
+    static stream_t s;
+    static expect_t e;
+    uint32_t total_bytes = 0U;
+    uint32_t total_real = 0U;
+    uint32_t swallowed = 0U;
+    uint32_t total_errors = 0U;
+
+    for (uint32_t trial = 0U; trial < TRIALS; ++trial)
+    {
+        stream_generate(&s, 64U + rand_next() % (STREAM_MAX - 64U));
+        reference_decode(&s, &e);
+        CHECK_EQ(MG58F18_RADAR_FRAME_SIZE * e.count + e.dropped + e.pending, s.len);
+        CHECK(e.pending < MG58F18_RADAR_FRAME_SIZE);
+
+        /* 真实帧：要么在参考输出中，要么被与之重叠的伪帧吞掉 */
+        uint32_t k = 0U;
+        for (uint32_t i = 0U; i < s.real_count; ++i)
+        {
+            const uint32_t p = s.real_pos[i];
+            while (k < e.count && e.pos[k] + MG58F18_RADAR_FRAME_SIZE <= p)
+            {
+                ++k;
+            }
+            CHECK(k < e.count);
+            if (k < e.count && e.pos[k] != p)
+            {
+                CHECK(e.pos[k] < p + MG58F18_RADAR_FRAME_SIZE);
+                ++swallowed;
+            }
+        }
+        total_real += s.real_count;
+        total_bytes += s.len;
+        total_errors += e.frame_errors;
+
+        /* 逐字节馈入：每字节后取帧，对比帧内容与结束位置 */
+        restart();
+        uint32_t got_count = 0U;
+        for (uint32_t i = 0U; i < s.len; ++i)
+        {
+            mg58f18_radar_frame_t frame;
+
+            mg58f18_radar_receive_bytes(&s.bytes[i], 1U);
+            if (mg58f18_radar_fetch_frame(&frame))
+            {
+                CHECK(got_count < e.count);
+                if (got_count < e.count)
+                {
+                    const uint32_t p = e.pos[got_count];
+                    CHECK_EQ(i + 1U, p + MG58F18_RADAR_FRAME_SIZE);
+                    CHECK(memcmp(frame.raw, &s.bytes[p], MG58F18_RADAR_FRAME_SIZE) == 0);
+                    CHECK_EQ(frame.command, s.bytes[p + 1U]);
+                    CHECK_EQ(frame.data4, s.bytes[p + 4U]);
+                }
+                ++got_count;
+            }
+        }
+        CHECK_EQ(got_count, e.count);
+        check_stats(&e, "bytewise");
+        check_no_stall();
+
+        /* 随机分块馈入：统计量一致，每块后取到的是该块内最后一个结束的帧 */
+        restart();
+        uint32_t offset = 0U;
+        uint32_t k_end = 0U;
+        while (offset < s.len)
+        {
+            uint32_t n = 1U + rand_next() % CHUNK_MAX;
+            mg58f18_radar_frame_t frame;
+
+            if (n > s.len - offset)
+            {
+                n = s.len - offset;
+            }
+            mg58f18_radar_receive_bytes(&s.bytes[offset], n);
+            offset += n;
+
+            const uint32_t k_begin = k_end;
+            while (k_end < e.count && e.pos[k_end] + MG58F18_RADAR_FRAME_SIZE <= offset)
+            {
+                ++k_end;
+            }
+            const bool have = mg58f18_radar_fetch_frame(&frame);
+            CHECK_EQ(have, k_end != k_begin);
+            if (have && k_end != k_begin)
+            {
+                CHECK(memcmp(frame.raw, &s.bytes[e.pos[k_end - 1U]], MG58F18_RADAR_FRAME_SIZE) == 0);
+            }
+        }
+        check_stats(&e, "chunked");
+        check_no_stall();
+    }
+
+    printf("fuzz: %u trials, %u bytes, %u real frames, %u swallowed by overlapping noise, %u window errors\n",
+           (unsigned)TRIALS, (unsigned)total_bytes, (unsigned)total_real, (unsigned)swallowed,
+           (unsigned)total_errors);
+}
+
+/* 边界：空指针、零长度、未初始化时馈入都不改变状态 */
+static void test_edges(void)
+{
+    uint8_t frame[MG58F18_RADAR_FRAME_SIZE];
+    mg58f18_radar_parser_stats_t stats;
+
+    make_frame(frame, 0x81U, 0x00U, 0x12U, 0x34U);
+    mg58f18_radar_deinit();
+    mg58f18_radar_receive_bytes(frame, sizeof(frame));
+    CHECK(!mg58f18_radar_fetch_frame(NULL));
+
+    restart();
+    mg58f18_radar_receive_bytes(NULL, 7U);
+    mg58f18_radar_receive_bytes(frame, 0U);
+    mg58f18_radar_get_parser_stats(&stats);
+    CHECK_EQ(stats.frames + stats.frame_errors + stats.dropped_bytes, 0U);
+
+    /* 帧头只在窗口末位：丢弃前 6 字节，保留末位帧头继续拼帧 */
+    static const uint8_t tail_head[] = {0x5A, 0x01, 0x02, 0x03, 0x04, 0x05, 0x5A};
+    mg58f18_radar_receive_bytes(tail_head, sizeof(tail_head));
+    mg58f18_radar_receive_bytes(&frame[1], MG58F18_RADAR_FRAME_SIZE - 1U);
+    CHECK(mg58f18_radar_fetch_frame(NULL));
+    mg58f18_radar_get_parser_stats(&stats);
+    CHECK_EQ(stats.frames, 1U);
+    CHECK_EQ(stats.frame_errors, 1U);
+    CHECK_EQ(stats.dropped_bytes, 6U);
+}
+
+/* 不含 5A、FE 的随机字节，保证噪声与截断帧不会拼出伪帧 */
+static uint8_t quiet_byte(void)
+{
+    uint8_t b;
+
+    do
+    {
+        b = (uint8_t)rand_next();
+    } while (b == MG58F18_RADAR_HEAD_BYTE || b == MG58F18_RADAR_TAIL_BYTE);
+    return b;
+}
+
+static void feed_quiet_noise(void)
+{
+    uint8_t noise[24];
+    const uint32_t n = rand_next() % sizeof(noise);
+
+    for (uint32_t i = 0U; i < n; ++i)
+    {
+        noise[i] = quiet_byte();
+    }
+    mg58f18_radar_receive_bytes(noise, n);
+}
+
+static void test_async_under_noise(void)
+{
+    static const uint8_t commands[] = {0x81U, 0x82U, 0x83U, 0x84U, 0x85U, 0x86U, 0x87U, 0x88U};
+    uint32_t ok = 0U;
+    uint32_t timeouts = 0U;
+
+    restart();
+    s_tick = 1000U;
+    for (uint32_t round = 0U; round < ASYNC_ROUNDS; ++round)
+    {
+        mg58f18_radar_future_t futures[ASYNC_CMDS];
+        uint8_t replies[ASYNC_CMDS][MG58F18_RADAR_FRAME_SIZE];
+        uint32_t order[ASYNC_CMDS];
+        const uint32_t first = rand_next() % (sizeof(commands) - ASYNC_CMDS + 1U);
+        const uint32_t lost = rand_next() % (ASYNC_CMDS + 2U);   /* >= ASYNC_CMDS 表示本轮不丢应答 */
+
+        for (uint32_t i = 0U; i < ASYNC_CMDS; ++i)
+        {
+            mg58f18_radar_future_init(&futures[i], NULL, NULL);
+            CHECK_EQ(mg58f18_radar_async_query((mg58f18_radar_command_t)commands[first + i], &futures[i]),
+                     MG58F18_RADAR_STATUS_OK);
+            make_frame(replies[i], commands[first + i], quiet_byte(), quiet_byte(), quiet_byte());
+            order[i] = i;
+        }
+
+        /* 按帧间隔逐条发出，窗口为 4，全部在途 */
+        s_sent_count = 0U;
+        for (uint32_t i = 0U; i < ASYNC_CMDS; ++i)
+        {
+            s_tick += MG58F18_RADAR_ASYNC_GAP_MS;
+            mg58f18_radar_async_process();
+        }
+        CHECK_EQ(s_sent_count, ASYNC_CMDS);
+
+        for (uint32_t i = ASYNC_CMDS - 1U; i > 0U; --i)
+        {
+            const uint32_t j = rand_next() % (i + 1U);
+            const uint32_t t = order[i];
+            order[i] = order[j];
+            order[j] = t;
+        }
+
+        /* 应答乱序、分块到达，之间夹着噪声与同命令码的截断帧 */
+        for (uint32_t i = 0U; i < ASYNC_CMDS; ++i)
+        {
+            const uint32_t idx = order[i];
+            const uint32_t cut = 1U + rand_next() % (MG58F18_RADAR_FRAME_SIZE - 1U);
+
+            feed_quiet_noise();
+            mg58f18_radar_receive_bytes(replies[idx], cut);
+            feed_quiet_noise();
+            if (idx != lost)
+            {
+                mg58f18_radar_receive_bytes(replies[idx], cut);
+                mg58f18_radar_receive_bytes(&replies[idx][cut], MG58F18_RADAR_FRAME_SIZE - cut);
+            }
+            mg58f18_radar_async_process();
+        }
+
+        s_tick += MG58F18_RADAR_DEFAULT_TIMEOUT_MS + 1U;
+        mg58f18_radar_async_process();
+        CHECK(mg58f18_radar_async_idle());
+
+        for (uint32_t i = 0U; i < ASYNC_CMDS; ++i)
+        {
+            CHECK(futures[i].done);
+            if (i == lost)
+            {
+                CHECK_EQ(futures[i].status, MG58F18_RADAR_STATUS_TIMEOUT);
+                ++timeouts;
+            }
+            else
+            {
+                CHECK_EQ(futures[i].status, MG58F18_RADAR_STATUS_OK);
+                CHECK(memcmp(futures[i].reply.raw, replies[i], MG58F18_RADAR_FRAME_SIZE) == 0);
+                ++ok;
+            }
+        }
+    }
+
+    printf("async: %u replies matched through noise, %u timed out as expected\n",
+           (unsigned)ok, (unsigned)timeouts);
+}
+
+int main(void)
+{
+    test_edges();
+    test_fuzz();
+    test_async_under_noise();
+    return HOST_TEST_DONE();
+}
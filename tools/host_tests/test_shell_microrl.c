@@ -0,0 +1,454 @@
+/**
+ * @file test_shell_microrl.c
+ * @brief rocketpi_uart_shell_microrl：按键脚本经 microrl、有序命令表与 uart_tx 回放，核对输出字节流与 UART 调用次数。
+ *
+ * 直接包含固件的 Core/Src/main.c（main 改名，不运行），按键经 HAL_UART_RxCpltCallback 送入，
+ * 主循环步骤 shell_process_input() 由测试调用。HAL_UART_Transmit_DMA 记下在途区并做快照，
+ * 完成时核对在途区未被改写再追加到输出，随后调用 HAL_UART_TxCpltCallback。
+ * uart_tx_puts 被包一层：同时把参数按旧 shell_print 的方式（逐字符、LF 转 CRLF）写入参考流，
+ * 最终 DMA 输出必须与参考流逐字节相同。旧实现每个字符（或一对 CRLF）一次阻塞 HAL_UART_Transmit，
+ * 调用次数由参考流推出，与 DMA 传输次数一起按命令列出（按键之间 DMA 已发完，命令输出在处理期间合并）。
+ * 随机按键序列中 DMA 只偶尔完成，环形缓冲写满时线程模式的等待由 __get_IPSR 中模拟的完成中断解除；
+ * 中断上下文写满时丢弃并计数。命令表部分比较二分查找、前缀下界补全与顺序扫描的结果。
+ */
+#include "uart_tx.h"
+#include "host_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define OUT_SIZE        (1U << 22)
+#define RANDOM_KEYS     400000U
+
+static void ref_puts(const char *str);
+
+/* 所有输出先记入参考流，再交给被测的 uart_tx_puts */
+#define uart_tx_puts(str)   (ref_puts(str), (uart_tx_puts)(str))
+
+void Error_Handler(void);
+static GPIO_TypeDef s_gpiob;
+#define LED_B_GPIO_Port     (&s_gpiob)
+#define LED_B_Pin           0x0001U
+#define LED_G_GPIO_Port     (&s_gpiob)
+#define LED_G_Pin           0x0002U
+#define LED_P_GPIO_Port     (&s_gpiob)
+#define LED_P_Pin           0x0004U
+
+#define main shell_firmware_main
+#include "main.c"
+#undef main
+
+uint32_t host_primask;
+USART_TypeDef host_usart2;
+UART_HandleTypeDef huart2 = { .Instance = &host_usart2, .gState = HAL_UART_STATE_READY };
+
+static uint8_t s_out[OUT_SIZE];
+static size_t s_out_len;
+static uint8_t s_ref[OUT_SIZE];
+static size_t s_ref_len;
+static size_t s_ref_calls;
+
+static const uint8_t *s_dma_src;
+static uint8_t s_dma_snapshot[UART_TX_BUFFER_SIZE];
+static uint16_t s_dma_len;
+static uint32_t s_dma_starts;
+static uint32_t s_rx_arms;
+static uint32_t s_keys;
+static uint32_t s_ipsr;
+static uint32_t s_wait_completions;
+static uint32_t s_rand = 12345U;
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+    return s_rand >> 8;
+}
+
+/* 旧 shell_print：逐字符发送，'\n' 作为一对 CRLF 发送 */
+static void ref_puts(const char *str)
+{
+    if (str == NULL)
+    {
+        return;
+    }
+    for (; *str != '\0'; str++)
+    {
+        if (*str == '\n')
+        {
+            s_ref[s_ref_len++] = '\r';
+        }
+        s_ref[s_ref_len++] = (uint8_t)*str;
+        s_ref_calls++;
+    }
+}
+
+HAL_StatusTypeDef HAL_Init(void)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *osc)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *clk, uint32_t latency)
+{
+    return HAL_OK;
+}
+
+void MX_GPIO_Init(void)
+{
+}
+
+void MX_DMA_Init(void)
+{
+}
+
+void MX_USART2_UART_Init(void)
+{
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+    port->ODR = (state == GPIO_PIN_SET) ? (port->ODR | pin) : (port->ODR & ~(uint32_t)pin);
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *port, uint16_t pin)
+{
+    port->ODR ^= pin;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size)
+{
+    CHECK(data == &s_uart2_rx);
+    CHECK_EQ(size, 1);
+    s_rx_arms++;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size)
+{
+    if (huart->gState != HAL_UART_STATE_READY)
+    {
+        return HAL_BUSY;
+    }
+    CHECK(size > 0U);
+    CHECK(size <= UART_TX_BUFFER_SIZE);
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    s_dma_src = data;
+    s_dma_len = size;
+    memcpy(s_dma_snapshot, data, size);
+    s_dma_starts++;
+    return HAL_OK;
+}
+
+/** DMA 传输完成中断，返回是否有传输完成 */
+static int dma_complete(void)
+{
+    uint32_t ipsr = s_ipsr;
+
+    if (s_dma_len == 0U)
+    {
+        return 0;
+    }
+    CHECK(memcmp(s_dma_src, s_dma_snapshot, s_dma_len) == 0);
+    CHECK(s_out_len + s_dma_len <= OUT_SIZE);
+    memcpy(&s_out[s_out_len], s_dma_snapshot, s_dma_len);
+    s_out_len += s_dma_len;
+    s_dma_len = 0U;
+    huart2.gState = HAL_UART_STATE_READY;
+    s_ipsr = 1U;
+    HAL_UART_TxCpltCallback(&huart2);
+    s_ipsr = ipsr;
+    return 1;
+}
+
+static void dma_drain(void)
+{
+    while (dma_complete())
+    {
+    }
+}
+
+/* 线程模式等待发送缓冲时，正在进行的 DMA 在等待期间完成 */
+uint32_t __get_IPSR(void)
+{
+    if ((s_ipsr == 0U) && (host_primask == 0U) && (s_dma_len != 0U))
+    {
+        s_wait_completions++;
+        (void)dma_complete();
+    }
+    return s_ipsr;
+}
+
+static void shell_boot(void)
+{
+    s_out_len = 0U;
+    s_ref_len = 0U;
+    uart_tx_init(&huart2);
+    shell_show_banner();
+    shell_check_cmd_table();
+    microrl_init(&s_shell, shell_print);
+    microrl_set_execute_callback(&s_shell, shell_execute);
+    microrl_set_complete_callback(&s_shell, shell_complete);
+    shell_start_rx();
+    dma_drain();
+}
+
+/** 一个按键：接收中断入队，主循环处理；DMA 相对 CPU 很慢，处理期间不完成 */
+static void key(uint8_t ch)
+{
+    s_keys++;
+    s_uart2_rx = ch;
+    s_ipsr = 1U;
+    HAL_UART_RxCpltCallback(&huart2);
+    s_ipsr = 0U;
+    shell_process_input();
+}
+
+static void check_stream(void)
+{
+    CHECK_EQ(s_out_len, s_ref_len);
+    CHECK(memcmp(s_out, s_ref, s_ref_len) == 0);
+}
+
+static int output_contains(size_t from, const char *text)
+{
+    size_t len = strlen(text), i;
+
+    for (i = from; i + len <= s_out_len; i++)
+    {
+        if (memcmp(&s_out[i], text, len) == 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void test_commands(void)
+{
+    static const struct
+    {
+        const char *keys;
+        const char *label;
+        const char *expect;
+    } kScripts[] = {
+        { "help\r", "help", "  version - Show shell information\r\n" },
+        { "version\r", "version", "microrl " MICRORL_LIB_VER " on USART2 (115200 8N1)\r\n" },
+        { "echo hello rocket pi\r", "echo hello rocket pi", "\r\nhello rocket pi\r\n" },
+        { "led red on\r", "led red on", "Unknown LED name: red\r\n" },
+        { "led blu\t tog\t\r", "led blu<TAB> tog<TAB>", "LED blue toggled\r\n" },
+        { "v\t\r", "v<TAB>", "microrl " MICRORL_LIB_VER },
+        { "bogus\r", "bogus", "Unknown command: bogus\r\nType 'help' to list commands.\r\n" },
+    };
+    size_t i;
+
+    shell_boot();
+    CHECK_EQ(s_shell_cmd_sorted, 1);
+    CHECK(output_contains(0U, "RocketPi USART2 microrl shell ready.\r\n"));
+    check_stream();
+
+    printf("%-24s %6s   %s\n", "command", "bytes", "UART calls before -> after (uart_tx writes)");
+    for (i = 0U; i < sizeof(kScripts) / sizeof(kScripts[0]); i++)
+    {
+        size_t out_start = s_out_len, calls_start = s_ref_calls;
+        uint32_t dma_start = s_dma_starts;
+        uart_tx_stats_t before, after;
+        const char *k;
+
+        uart_tx_get_stats(&before);
+        /* 按人手输入的速度，两次按键之间回显已经发完 */
+        for (k = kScripts[i].keys; *k != '\0'; k++)
+        {
+            key((uint8_t)*k);
+            dma_drain();
+        }
+        uart_tx_get_stats(&after);
+        CHECK(output_contains(out_start, kScripts[i].expect));
+        check_stream();
+        CHECK(s_dma_starts - dma_start <= after.writes - before.writes);
+        printf("%-24s %6zu   %zu -> %u (%u)\n", kScripts[i].label, s_out_len - out_start,
+               s_ref_calls - calls_start, (unsigned)(s_dma_starts - dma_start),
+               (unsigned)(after.writes - before.writes));
+    }
+
+    /* LED：低电平点亮 */
+    s_gpiob.ODR = 0xFFFFU;
+    for (const char *k = "led GREEN on\r"; *k != '\0'; k++)
+    {
+        key((uint8_t)*k);
+    }
+    CHECK_EQ(s_gpiob.ODR & LED_G_Pin, 0);
+    for (const char *k = "led green toggle\r"; *k != '\0'; k++)
+    {
+        key((uint8_t)*k);
+    }
+    CHECK_EQ(s_gpiob.ODR & LED_G_Pin, LED_G_Pin);
+    dma_drain();
+    check_stream();
+    CHECK_EQ(s_rx_arms, s_keys + 1U);
+}
+
+static void test_cmd_table(void)
+{
+    static const char kAlphabet[] = "ehlvoscrn";
+    char name[8];
+    size_t n, j;
+
+    for (n = 0U; n < 20000U; n++)
+    {
+        size_t len = rand_next() % 8U;
+        const shell_cmd_desc_t *sorted, *linear;
+        const char *argv[1] = { name };
+        const char *sorted_list[_COMMAND_TOKEN_NMB + 1];
+
+        for (j = 0U; j < len; j++)
+        {
+            name[j] = kAlphabet[rand_next() % (sizeof(kAlphabet) - 1U)];
+        }
+        name[len] = '\0';
+        if ((rand_next() % 4U) == 0U)
+        {
+            /* 命令名本身及其前缀 */
+            const char *cmd = kShellCmdTable[rand_next() % ARRAY_SIZE(kShellCmdTable)].name;
+
+            len = rand_next() % (strlen(cmd) + 1U);
+            memcpy(name, cmd, len);
+            name[len] = '\0';
+        }
+
+        s_shell_cmd_sorted = 1U;
+        sorted = shell_find_cmd(name);
+        memcpy(sorted_list, shell_complete(1, argv), sizeof(sorted_list));
+        s_shell_cmd_sorted = 0U;
+        linear = shell_find_cmd(name);
+        CHECK(sorted == linear);
+        CHECK(memcmp(sorted_list, shell_complete(1, argv), sizeof(sorted_list)) == 0);
+    }
+    s_shell_cmd_sorted = 1U;
+    CHECK(shell_find_cmd("led") == &kShellCmdTable[2]);
+    CHECK(shell_find_cmd("le") == NULL);
+    CHECK(shell_find_cmd("leds") == NULL);
+}
+
+static void test_random_keys(void)
+{
+    static const char *const kWords[] = { "help", "version", "echo", "led", "blue", "pink", "on", "off",
+                                          "toggle", "v", "e", "l", "x" };
+    uart_tx_stats_t stats;
+    size_t n;
+
+    shell_boot();
+    for (n = 0U; n < RANDOM_KEYS; n++)
+    {
+        uint32_t r = rand_next() % 100U;
+
+        if (r < 40U)
+        {
+            const char *w = kWords[rand_next() % (sizeof(kWords) / sizeof(kWords[0]))];
+
+            for (; *w != '\0'; w++)
+            {
+                key((uint8_t)*w);
+            }
+        }
+        else if (r < 55U)
+        {
+            key(' ');
+        }
+        else if (r < 68U)
+        {
+            key('\t');
+        }
+        else if (r < 80U)
+        {
+            key('\r');
+        }
+        else if (r < 84U)
+        {
+            key(KEY_DEL);
+        }
+        else if (r < 88U)
+        {
+            /* 上下左右方向键 */
+            key(KEY_ESC);
+            key('[');
+            key((uint8_t)('A' + rand_next() % 4U));
+        }
+        else
+        {
+            key((uint8_t)(' ' + rand_next() % 95U));
+        }
+        /* DMA 只偶尔完成，输出在环形缓冲中积压 */
+        if ((rand_next() % 8U) == 0U)
+        {
+            (void)dma_complete();
+        }
+        if (s_out_len > OUT_SIZE - 65536U)
+        {
+            dma_drain();
+            check_stream();
+            s_out_len = 0U;
+            s_ref_len = 0U;
+        }
+    }
+    dma_drain();
+    check_stream();
+    uart_tx_get_stats(&stats);
+    CHECK_EQ(stats.dropped, 0);
+    CHECK(s_wait_completions > 0U);
+    printf("random: %u keys, %u writes in %u transfers, %u waits for a full ring\n", (unsigned)RANDOM_KEYS,
+           (unsigned)stats.writes, (unsigned)stats.transfers, (unsigned)s_wait_completions);
+}
+
+static void test_drop_in_isr(void)
+{
+    static const uint8_t kBlock[UART_TX_BUFFER_SIZE] = { 0 };
+    uart_tx_stats_t stats;
+    size_t out_start;
+
+    shell_boot();
+    out_start = s_out_len;
+    /* 中断上下文写满后丢弃，不等待 */
+    s_ipsr = 1U;
+    CHECK_EQ(uart_tx_write(kBlock, 200U), 200);
+    CHECK_EQ(uart_tx_write(kBlock, UART_TX_BUFFER_SIZE), UART_TX_BUFFER_SIZE - 200U);
+    s_ipsr = 0U;
+    uart_tx_get_stats(&stats);
+    CHECK_EQ(stats.dropped, 200);
+    dma_drain();
+    CHECK_EQ(s_out_len - out_start, UART_TX_BUFFER_SIZE);
+
+    /* 关中断时同样不等待 */
+    host_primask = 1U;
+    CHECK_EQ(uart_tx_write(kBlock, UART_TX_BUFFER_SIZE), UART_TX_BUFFER_SIZE);
+    CHECK_EQ(uart_tx_write(kBlock, 1U), 0);
+    host_primask = 0U;
+    dma_drain();
+    uart_tx_get_stats(&stats);
+    CHECK_EQ(stats.dropped, 201);
+    CHECK_EQ(s_out_len - out_start, 2U * UART_TX_BUFFER_SIZE);
+
+    /* 接收错误进入 ErrorCallback 时发送仍在进行，不能推进 */
+    CHECK_EQ(uart_tx_write("abc", 3U), 3);
+    CHECK_EQ(huart2.gState, HAL_UART_STATE_BUSY_TX);
+    HAL_UART_ErrorCallback(&huart2);
+    CHECK_EQ(s_dma_len, 3);
+    /* 在途的 3 字节仍占着缓冲区 */
+    s_ipsr = 1U;
+    CHECK_EQ(uart_tx_write(kBlock, UART_TX_BUFFER_SIZE), UART_TX_BUFFER_SIZE - 3U);
+    s_ipsr = 0U;
+    dma_drain();
+    CHECK_EQ(s_out_len - out_start, 3U * UART_TX_BUFFER_SIZE);
+}
+
+int main(void)
+{
+    test_commands();
+    test_cmd_table();
+    test_random_keys();
+    test_drop_in_isr();
+    return HOST_TEST_DONE();
+}
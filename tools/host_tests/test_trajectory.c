@@ -0,0 +1,455 @@
+/**
+ * @file test_trajectory.c
+ * @brief 轨迹引擎：模拟循环 DMA 突发逐帧取走 CCR 表，把输出的 CCR 流与解析曲线逐采样比较。
+ *
+ * 模拟 DMA 每个更新事件从表中取 slot_count 个字，取完前半区时调用半传输回调，
+ * 取完整表时调用传输完成回调并回到开头，与 HAL_TIM_DMABurst_MultiWriteStart 的循环模式一致。
+ * 期望值由 trajectory_profile_q16 按段叠加算出；trajectory_profile_q16 本身再与
+ * 双精度的梯形/S 曲线闭式解比较，并检查端点、单调、对称与斜坡衔接处的速度连续。
+ */
+#include "driver_trajectory.h"
+#include "host_test.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STREAM_MAX      4096U
+#define SLOT_MAX        4U
+
+uint32_t host_primask;
+TIM_HandleTypeDef htim3;
+
+void HAL_TIM_PeriodElapsedHalfCpltCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+
+static DMA_HandleTypeDef s_dma;
+static uint32_t *s_dma_src;
+static uint32_t s_dma_words;
+static uint32_t s_dma_pos;
+static uint32_t s_dma_burst;
+static uint32_t s_dma_base;
+static uint8_t s_dma_running;
+static uint32_t s_callbacks;
+
+/* 输出的 CCR 流：每个更新事件一帧 */
+static uint32_t s_stream[STREAM_MAX][SLOT_MAX];
+static uint32_t s_frames;
+
+HAL_StatusTypeDef HAL_TIM_DMABurst_MultiWriteStart(TIM_HandleTypeDef *htim, uint32_t base, uint32_t src,
+                                                   uint32_t *buffer, uint32_t length, uint32_t transfers)
+{
+    CHECK(htim == &htim3);
+    CHECK_EQ(src, TIM_DMA_UPDATE);
+    s_dma_src = buffer;
+    s_dma_words = transfers;
+    s_dma_burst = (length >> TIM_DCR_DBL_Pos) + 1U;
+    s_dma_base = base;
+    s_dma_pos = 0U;
+    s_dma_running = 1U;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_DMABurst_WriteStop(TIM_HandleTypeDef *htim, uint32_t src)
+{
+    s_dma_running = 0U;
+
+    return HAL_OK;
+}
+
+/* 推进 frames 个更新事件，每个事件搬运一次突发 */
+static void dma_run(uint32_t frames)
+{
+    uint32_t f;
+    uint32_t k;
+
+    for (f = 0U; (f < frames) && (s_dma_running != 0U); f++)
+    {
+        for (k = 0U; k < s_dma_burst; k++)
+        {
+            if (s_frames < STREAM_MAX)
+            {
+                s_stream[s_frames][k] = s_dma_src[s_dma_pos];
+            }
+            s_dma_pos++;
+            if (s_dma_pos == s_dma_words / 2U)
+            {
+                s_callbacks++;
+                HAL_TIM_PeriodElapsedHalfCpltCallback(&htim3);
+            }
+            else if (s_dma_pos == s_dma_words)
+            {
+                s_dma_pos = 0U;
+                s_callbacks++;
+                HAL_TIM_PeriodElapsedCallback(&htim3);
+            }
+        }
+        s_frames++;
+    }
+}
+
+static void stream_reset(void)
+{
+    memset(s_stream, 0, sizeof(s_stream));
+    s_frames = 0U;
+    s_callbacks = 0U;
+}
+
+/* 单段位移在第 k 个采样处的贡献，与引擎相同的截断方式 */
+static int32_t seg_pos(int32_t displacement, trajectory_profile_t profile, uint32_t k, uint32_t total, uint32_t accel)
+{
+    uint32_t s = trajectory_profile_q16(profile, k, total, accel);
+
+    return (int32_t)(((int64_t)displacement * s) / 65536);
+}
+
+/* 双精度闭式解 */
+static double profile_ref(trajectory_profile_t profile, double t, double total, double accel)
+{
+    double cruise = total - accel;
+    double rest;
+    double ramp;
+
+    if (t >= total)
+    {
+        return 1.0;
+    }
+    if (accel == 0.0)
+    {
+        return t / total;
+    }
+    if ((t > accel) && (t < total - accel))
+    {
+        return (t - accel / 2.0) / cruise;
+    }
+    rest = (t <= accel) ? t : (total - t);
+    if (profile == TRAJECTORY_PROFILE_SCURVE)
+    {
+        double x = rest / accel;
+
+        ramp = accel * (x * x * x - x * x * x * x / 2.0) / cruise;
+    }
+    else
+    {
+        ramp = rest * rest / (2.0 * accel * cruise);
+    }
+
+    return (t <= accel) ? ramp : 1.0 - ramp;
+}
+
+static void test_profile_closed_form(void)
+{
+    static const uint32_t totals[] = {1U, 2U, 7U, 50U, 333U, 1000U, 60000U};
+    static const uint32_t permille[] = {0U, 100U, 250U, 300U, 500U};
+    uint32_t worst_q16 = 0U;
+    uint32_t p;
+    uint32_t i;
+    uint32_t j;
+
+    for (p = 0U; p < 2U; p++)
+    {
+        trajectory_profile_t profile = (p == 0U) ? TRAJECTORY_PROFILE_TRAPEZOID : TRAJECTORY_PROFILE_SCURVE;
+
+        for (i = 0U; i < sizeof(totals) / sizeof(totals[0]); i++)
+        {
+            for (j = 0U; j < sizeof(permille) / sizeof(permille[0]); j++)
+            {
+                uint32_t total = totals[i];
+                uint32_t accel = (uint32_t)(((uint64_t)total * permille[j]) / 1000U);
+                uint32_t step = (total > 2000U) ? 7U : 1U;
+                uint32_t prev = 0U;
+                uint32_t t;
+
+                CHECK_EQ(trajectory_profile_q16(profile, 0U, total, accel), 0);
+                CHECK_EQ(trajectory_profile_q16(profile, total, total, accel), 65536);
+                for (t = 0U; t <= total; t += step)
+                {
+                    uint32_t s = trajectory_profile_q16(profile, t, total, accel);
+                    uint32_t mirror = trajectory_profile_q16(profile, total - t, total, accel);
+                    double ref = profile_ref(profile, (double)t, (double)total, (double)accel) * 65536.0;
+                    uint32_t err = (uint32_t)fabs((double)s - ref);
+
+                    worst_q16 = (err > worst_q16) ? err : worst_q16;
+                    CHECK(err <= 2U);
+                    CHECK(s >= prev);
+                    CHECK(s + mirror >= 65536U - 2U);
+                    CHECK(s + mirror <= 65536U + 2U);
+                    prev = s;
+                }
+            }
+        }
+    }
+
+    /* 斜坡与匀速段衔接处速度连续：相邻差分的变化不超过一个峰值速度量级的小量 */
+    {
+        uint32_t total = 1000U;
+        uint32_t accel = 300U;
+        uint32_t vmax = (uint32_t)(65536U / (total - accel)) + 1U;
+        uint32_t t;
+
+        for (p = 0U; p < 2U; p++)
+        {
+            trajectory_profile_t profile = (p == 0U) ? TRAJECTORY_PROFILE_TRAPEZOID : TRAJECTORY_PROFILE_SCURVE;
+            int32_t prev_v = 0;
+
+            for (t = 1U; t <= total; t++)
+            {
+                int32_t v = (int32_t)(trajectory_profile_q16(profile, t, total, accel) -
+                                      trajectory_profile_q16(profile, t - 1U, total, accel));
+
+                CHECK(v >= 0);
+                CHECK(v <= (int32_t)vmax + 1);
+                CHECK(abs(v - prev_v) <= 2);
+                prev_v = v;
+            }
+        }
+    }
+    printf("trajectory_profile_q16 worst error vs closed form: %u / 65536\n", (unsigned)worst_q16);
+}
+
+static void servo_config(trajectory_config_t *config)
+{
+    memset(config, 0, sizeof(*config));
+    config->htim = &htim3;
+    config->burst_base = TIM_DMABASE_CCR4;
+    config->slot_count = 1U;
+    config->axis_count = 1U;
+    config->hold_frames = 1U;
+    config->samples_per_half = 4U;
+    config->sample_period_us = 20000U;
+    config->axes[0].type = TRAJECTORY_AXIS_SERVO;
+    config->axes[0].slot_a = 0U;
+    config->axes[0].min = 500;
+    config->axes[0].max = 2500;
+    config->axes[0].initial = 1500;
+}
+
+/* SG90 配置：单段 S 曲线与梯形，CCR 流逐采样等于解析值 */
+static void test_servo_stream(void)
+{
+    trajectory_config_t config;
+    trajectory_segment_t seg = {2500, 1000U, 300U, 0U, TRAJECTORY_PROFILE_SCURVE};
+    trajectory_segment_t back = {700, 600U, 500U, 0U, TRAJECTORY_PROFILE_TRAPEZOID};
+    const uint32_t lead = 8U;           /* 启动时已填好的两个半区 */
+    uint32_t mismatches = 0U;
+    uint32_t k;
+
+    servo_config(&config);
+    htim3.hdma[TIM_DMA_ID_UPDATE] = &s_dma;
+    stream_reset();
+    CHECK_EQ(trajectory_start(&config), 0);
+    CHECK_EQ(s_dma_words, 8);
+    CHECK_EQ(s_dma_burst, 1);
+    CHECK_EQ(s_dma_base, TIM_DMABASE_CCR4);
+    CHECK_EQ(trajectory_is_idle(0U), 1);
+
+    CHECK_EQ(trajectory_enqueue(0U, &seg), 0);
+    CHECK_EQ(trajectory_enqueue(0U, &back), 0);
+    CHECK_EQ(trajectory_free_segments(0U), TRAJECTORY_QUEUE_DEPTH - 2U);
+    CHECK_EQ(trajectory_is_idle(0U), 0);
+    dma_run(lead + 50U + 30U + 16U);
+
+    for (k = 0U; k < lead; k++)
+    {
+        CHECK_EQ(s_stream[k][0], 1500);
+    }
+    for (k = 1U; k <= 50U; k++)
+    {
+        int32_t expect = 1500 + seg_pos(1000, TRAJECTORY_PROFILE_SCURVE, k, 50U, 15U);
+
+        mismatches += (s_stream[lead + k - 1U][0] != (uint32_t)expect) ? 1U : 0U;
+    }
+    for (k = 1U; k <= 30U; k++)
+    {
+        int32_t expect = 2500 + seg_pos(-1800, TRAJECTORY_PROFILE_TRAPEZOID, k, 30U, 15U);
+
+        mismatches += (s_stream[lead + 50U + k - 1U][0] != (uint32_t)expect) ? 1U : 0U;
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(s_stream[lead + 49U][0], 2500);
+    CHECK_EQ(s_stream[lead + 79U][0], 700);
+    for (k = lead + 80U; k < s_frames; k++)
+    {
+        CHECK_EQ(s_stream[k][0], 700);
+    }
+    CHECK_EQ(trajectory_is_idle(0U), 1);
+    CHECK_EQ(trajectory_get_position(0U), 700);
+    /* CPU 只在每个半区结束时运行一次 */
+    CHECK_EQ(s_callbacks, s_frames / 4U);
+
+    /* 超出范围的目标被限幅 */
+    seg.target = 9000;
+    seg.duration_ms = 100U;
+    CHECK_EQ(trajectory_enqueue(0U, &seg), 0);
+    dma_run(16U);
+    CHECK_EQ(trajectory_get_position(0U), 2500);
+    CHECK_EQ(trajectory_stop(), 0);
+    CHECK_EQ(s_dma_running, 0);
+}
+
+/* 混合窗口：下一段提前 blend 个采样开始，两段位移叠加 */
+static void test_blend_superposition(void)
+{
+    trajectory_config_t config;
+    trajectory_segment_t a = {2300, 800U, 250U, 200U, TRAJECTORY_PROFILE_SCURVE};
+    trajectory_segment_t b = {900, 1000U, 400U, 200U, TRAJECTORY_PROFILE_SCURVE};
+    const uint32_t lead = 8U;
+    const uint32_t t1 = 40U;
+    const uint32_t a1 = 10U;
+    const uint32_t t2 = 50U;
+    const uint32_t a2 = 20U;
+    const uint32_t blend = 10U;
+    uint32_t mismatches = 0U;
+    int32_t peak = 0;
+    uint32_t k;
+
+    servo_config(&config);
+    stream_reset();
+    CHECK_EQ(trajectory_start(&config), 0);
+    CHECK_EQ(trajectory_enqueue(0U, &a), 0);
+    CHECK_EQ(trajectory_enqueue(0U, &b), 0);
+    dma_run(lead + t1 + t2 + 8U);
+
+    for (k = 1U; k <= t1 - blend + t2; k++)
+    {
+        int32_t expect = 1500 + seg_pos(800, TRAJECTORY_PROFILE_SCURVE, (k < t1) ? k : t1, t1, a1);
+
+        if (k > t1 - blend)
+        {
+            expect += seg_pos(-1400, TRAJECTORY_PROFILE_SCURVE, k - (t1 - blend), t2, a2);
+        }
+        mismatches += (s_stream[lead + k - 1U][0] != (uint32_t)expect) ? 1U : 0U;
+        peak = ((int32_t)s_stream[lead + k - 1U][0] > peak) ? (int32_t)s_stream[lead + k - 1U][0] : peak;
+    }
+    CHECK_EQ(mismatches, 0);
+    /* 叠加后在拐角处提前回转，达不到第一段终点 */
+    CHECK(peak < 2300);
+    CHECK_EQ(s_stream[lead + t1 - blend + t2 - 1U][0], 900);
+    CHECK_EQ(trajectory_is_idle(0U), 1);
+    CHECK_EQ(trajectory_stop(), 0);
+}
+
+/* L9110 配置：H 桥两槽位、零阶保持，正反向互斥 */
+static void test_hbridge_stream(void)
+{
+    trajectory_config_t config;
+    trajectory_segment_t fwd = {800, 20U, 250U, 0U, TRAJECTORY_PROFILE_TRAPEZOID};
+    trajectory_segment_t rev = {-1500, 30U, 250U, 0U, TRAJECTORY_PROFILE_SCURVE};    /* 终点限幅到 -1000 */
+    const uint32_t hold = 10U;
+    const uint32_t lead = 2U * 2U * hold;
+    uint32_t mismatches = 0U;
+    uint32_t both_on = 0U;
+    uint32_t k;
+
+    memset(&config, 0, sizeof(config));
+    config.htim = &htim3;
+    config.burst_base = TIM_DMABASE_CCR1;
+    config.slot_count = 2U;
+    config.axis_count = 1U;
+    config.hold_frames = (uint16_t)hold;
+    config.samples_per_half = 2U;
+    config.sample_period_us = 1000U;
+    config.axes[0].type = TRAJECTORY_AXIS_HBRIDGE;
+    config.axes[0].slot_a = 1U;
+    config.axes[0].slot_b = 0U;
+    config.axes[0].min = -1000;
+    config.axes[0].max = 1000;
+    config.axes[0].initial = 0;
+
+    stream_reset();
+    CHECK_EQ(trajectory_start(&config), 0);
+    CHECK_EQ(s_dma_words, 80);
+    CHECK_EQ(s_dma_burst, 2);
+    CHECK_EQ(trajectory_enqueue(0U, &fwd), 0);
+    CHECK_EQ(trajectory_enqueue(0U, &rev), 0);
+    dma_run(lead + (20U + 30U + 4U) * hold);
+
+    for (k = 1U; k <= 50U; k++)
+    {
+        int32_t pos = (k <= 20U) ? seg_pos(800, TRAJECTORY_PROFILE_TRAPEZOID, k, 20U, 5U)
+                                 : 800 + seg_pos(-1800, TRAJECTORY_PROFILE_SCURVE, k - 20U, 30U, 7U);
+        uint32_t fwd_ccr = (pos > 0) ? (uint32_t)pos : 0U;
+        uint32_t rev_ccr = (pos < 0) ? (uint32_t)(-pos) : 0U;
+        uint32_t h;
+
+        for (h = 0U; h < hold; h++)
+        {
+            const uint32_t *frame = s_stream[lead + (k - 1U) * hold + h];
+
+            mismatches += ((frame[1] != fwd_ccr) || (frame[0] != rev_ccr)) ? 1U : 0U;
+        }
+    }
+    for (k = 0U; k < s_frames; k++)
+    {
+        both_on += ((s_stream[k][0] != 0U) && (s_stream[k][1] != 0U)) ? 1U : 0U;
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(both_on, 0);
+    CHECK_EQ(trajectory_get_position(0U), -1000);
+    CHECK_EQ(trajectory_stop(), 0);
+}
+
+/* 中止后停在当前位置，队列满与非法参数 */
+static void test_abort_and_limits(void)
+{
+    trajectory_config_t config;
+    trajectory_segment_t seg = {2500, 1000U, 300U, 0U, TRAJECTORY_PROFILE_SCURVE};
+    int32_t held;
+    uint32_t i;
+    uint32_t k;
+
+    servo_config(&config);
+    stream_reset();
+    CHECK_EQ(trajectory_start(&config), 0);
+    for (i = 0U; i < TRAJECTORY_QUEUE_DEPTH; i++)
+    {
+        CHECK_EQ(trajectory_enqueue(0U, &seg), 0);
+    }
+    CHECK_EQ(trajectory_enqueue(0U, &seg), 2);
+    CHECK_EQ(trajectory_free_segments(0U), 0);
+    CHECK_EQ(trajectory_enqueue(1U, &seg), 1);
+    seg.accel_permille = 501U;
+    CHECK_EQ(trajectory_enqueue(0U, &seg), 1);
+
+    dma_run(8U + 20U);
+    CHECK_EQ(trajectory_abort(0U), 0);
+    CHECK_EQ(host_primask, 0);
+    held = trajectory_get_position(0U);
+    CHECK(held > 1500);
+    CHECK(held < 2500);
+    CHECK_EQ(trajectory_is_idle(0U), 1);
+    CHECK_EQ(trajectory_free_segments(0U), TRAJECTORY_QUEUE_DEPTH);
+    dma_run(16U);
+    for (k = s_frames - 8U; k < s_frames; k++)
+    {
+        CHECK_EQ(s_stream[k][0], (uint32_t)held);
+    }
+    CHECK_EQ(trajectory_abort(3U), 1);
+    CHECK_EQ(trajectory_stop(), 0);
+
+    /* 非法配置 */
+    config.slot_count = 5U;
+    CHECK_EQ(trajectory_start(&config), 1);
+    servo_config(&config);
+    config.samples_per_half = 200U;
+    CHECK_EQ(trajectory_start(&config), 1);
+    servo_config(&config);
+    config.axes[0].slot_a = 1U;
+    CHECK_EQ(trajectory_start(&config), 1);
+    servo_config(&config);
+    htim3.hdma[TIM_DMA_ID_UPDATE] = NULL;
+    CHECK_EQ(trajectory_start(&config), 1);
+    htim3.hdma[TIM_DMA_ID_UPDATE] = &s_dma;
+}
+
+int main(void)
+{
+    test_profile_closed_form();
+    test_servo_stream();
+    test_blend_superposition();
+    test_hbridge_stream();
+    test_abort_and_limits();
+
+    return HOST_TEST_DONE();
+}
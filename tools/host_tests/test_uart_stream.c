@@ -0,0 +1,520 @@
+/**
+ * @file test_uart_stream.c
+ * @brief uart_stream：循环 DMA 接收跨回绕的字节顺序、读取不及时时的丢弃计数、错误重启与零拷贝转发。
+ *
+ * 按 rocketpi_uart_echo 的配置使用 1024 字节缓冲区。替身 DMA 逐字节写入缓冲区，第 k 个字节的值由 k 决定，
+ * 越过半满/末尾时挂起 HT/TC 事件；突发结束时挂起 IDLE 事件，IDLE 处理时按实时 NDTR 上报位置，
+ * 与 HAL 一样位置为 0 时不上报。挂起的事件在随机延迟后以随机先后处理，IDLE 可能先于尚未处理的 HT/TC，
+ * 但同一边界不会在事件处理前被越过第二次（与固件的假设一致）。
+ * 检查：
+ * - 读取及时时收到的字节与发送的完全一致，uart_stream_read 跨缓冲区末尾拷贝两段，rx_dropped 为 0；
+ *   peek 得到的数据在 DMA 继续写入余量以内的字节后仍然不变；
+ * - 读取方随机停顿数圈时，每次同步后读指针与模型 max(tail, DMA 累计写入 - (缓冲区 - 余量)) 一致，
+ *   读出的每个字节都对应其累计位置，rx_dropped 等于模型中跳过的字节数；
+ * - 边界情形：IDLE 越过半个缓冲区、丢弃时计入未上报的字节、未上报部分超过上限时读指针不越过 rx_head；
+ * - 串口错误重启后重启前未读的数据计入 rx_dropped，之后从偏移 0 继续；
+ * - 转发模式下每段 TX DMA 以环形缓冲为源，发送期间不被覆盖，转发输出与发送的完全一致。
+ */
+#include "uart_stream.h"
+#include "host_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BUF_SIZE        1024U
+#define GUARD           (BUF_SIZE / 8U)
+#define LIMIT           (BUF_SIZE - GUARD)
+#define ORDER_BYTES     1000000U
+#define OVERRUN_BYTES   1000000U
+#define FORWARD_BYTES   500000U
+
+uint32_t host_primask;
+volatile uint32_t *host_monitor;
+uint32_t host_strex_fail;
+void (*host_exclusive_hook)(void);
+void (*host_exclusive_post_hook)(void);
+
+USART_TypeDef host_usart2;
+static USART_TypeDef s_usart1;
+static DMA_Stream_TypeDef s_rx_stream;
+static DMA_HandleTypeDef s_hdma_rx = { .Instance = &s_rx_stream };
+UART_HandleTypeDef huart2 = { .Instance = &host_usart2, .hdmarx = &s_hdma_rx,
+                              .gState = HAL_UART_STATE_READY, .RxState = HAL_UART_STATE_READY };
+static UART_HandleTypeDef s_huart1 = { .Instance = &s_usart1, .gState = HAL_UART_STATE_READY };
+
+static uint8_t s_buf[BUF_SIZE];
+static uart_stream_t s_stream;
+static uint32_t s_rand = 12345U;
+
+/* 替身 DMA：写入位置、累计写入字节数与挂起的事件 */
+static uint32_t s_dma_pos;
+static uint32_t s_dma_total;
+static uint32_t s_dma_starts;
+static int s_ht_pending;
+static int s_tc_pending;
+static int s_idle_pending;
+static uint32_t s_lagging_events;
+
+/* 转发：正在发送的段与输出计数 */
+static const uint8_t *s_tx_data;
+static uint16_t s_tx_len;
+static uint8_t s_tx_snap[BUF_SIZE];
+static uint32_t s_tx_out;
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+    return s_rand >> 8;
+}
+
+/** 发送方的第 k 个字节，周期远大于缓冲区 */
+static uint8_t sent_byte(uint32_t k)
+{
+    return (uint8_t)((k * 2654435761U) >> 24);
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size)
+{
+    CHECK(data == s_buf);
+    CHECK_EQ(size, BUF_SIZE);
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    s_dma_pos = 0U;
+    s_rx_stream.NDTR = BUF_SIZE;
+    s_ht_pending = 0;
+    s_tc_pending = 0;
+    s_idle_pending = 0;
+    s_dma_starts++;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size)
+{
+    if (huart->gState != HAL_UART_STATE_READY)
+    {
+        return HAL_BUSY;
+    }
+    CHECK(huart == &s_huart1);
+    CHECK(size > 0U);
+    /* 源是环形缓冲中的连续段 */
+    CHECK((data >= s_buf) && (data + size <= s_buf + BUF_SIZE));
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    s_tx_data = data;
+    s_tx_len = size;
+    memcpy(s_tx_snap, data, size);
+    return HAL_OK;
+}
+
+/** DMA 写入一个字节，越过半满/末尾时挂起 HT/TC */
+static void dma_rx_byte(void)
+{
+    s_buf[s_dma_pos] = sent_byte(s_dma_total);
+    s_dma_total++;
+    s_dma_pos++;
+    if (s_dma_pos == BUF_SIZE / 2U)
+    {
+        CHECK(!s_ht_pending);
+        s_ht_pending = 1;
+    }
+    else if (s_dma_pos == BUF_SIZE)
+    {
+        CHECK(!s_tc_pending);
+        s_tc_pending = 1;
+        s_dma_pos = 0U;
+    }
+    s_rx_stream.NDTR = BUF_SIZE - s_dma_pos;
+}
+
+static void rx_event(uint32_t type, uint16_t size)
+{
+    uint32_t head = s_stream.rx_head;
+
+    huart2.RxEventType = type;
+    uart_stream_on_rx_event(&s_stream, &huart2, size);
+    if ((type != HAL_UART_RXEVENT_IDLE) && (s_stream.rx_head == head))
+    {
+        s_lagging_events++;
+    }
+}
+
+/** DMA 中断：先 HT 后 TC */
+static void dma_isr(void)
+{
+    if (s_ht_pending)
+    {
+        s_ht_pending = 0;
+        rx_event(HAL_UART_RXEVENT_HT, BUF_SIZE / 2U);
+    }
+    if (s_tc_pending)
+    {
+        s_tc_pending = 0;
+        rx_event(HAL_UART_RXEVENT_TC, BUF_SIZE);
+    }
+}
+
+/** 串口空闲中断：按实时 NDTR 上报，位置为 0 时 HAL 不回调 */
+static void idle_isr(void)
+{
+    uint32_t remaining = s_rx_stream.NDTR;
+
+    s_idle_pending = 0;
+    if ((remaining > 0U) && (remaining < BUF_SIZE))
+    {
+        rx_event(HAL_UART_RXEVENT_IDLE, (uint16_t)(BUF_SIZE - remaining));
+    }
+}
+
+static void isr_all(void)
+{
+    if ((rand_next() % 2U) == 0U)
+    {
+        dma_isr();
+        if (s_idle_pending)
+        {
+            idle_isr();
+        }
+    }
+    else
+    {
+        if (s_idle_pending)
+        {
+            idle_isr();
+        }
+        dma_isr();
+    }
+}
+
+/** 转发 DMA 完成：核对发送期间源数据未被改写，追加到输出 */
+static void tx_complete(void)
+{
+    uint16_t i;
+
+    if (s_tx_len == 0U)
+    {
+        return;
+    }
+    CHECK(memcmp(s_tx_data, s_tx_snap, s_tx_len) == 0);
+    for (i = 0U; i < s_tx_len; i++)
+    {
+        CHECK_EQ(s_tx_snap[i], sent_byte(s_tx_out + i));
+    }
+    s_tx_out += s_tx_len;
+    s_tx_len = 0U;
+    s_huart1.gState = HAL_UART_STATE_READY;
+    uart_stream_on_tx_complete(&s_stream, &s_huart1);
+}
+
+/**
+ * 发送一段突发，事件在随机延迟后处理；挂起的 HT/TC 在同一边界被再次越过之前必定处理。
+ * @param isr_rate 每个字节后处理挂起事件的概率为 1/isr_rate。
+ */
+static void burst(uint32_t len, uint32_t isr_rate)
+{
+    uint32_t i;
+
+    for (i = 0U; i < len; i++)
+    {
+        if ((s_ht_pending && (s_dma_pos == BUF_SIZE / 2U - 1U)) ||
+            (s_tc_pending && (s_dma_pos == BUF_SIZE - 1U)))
+        {
+            isr_all();
+        }
+        dma_rx_byte();
+        if ((rand_next() % isr_rate) == 0U)
+        {
+            isr_all();
+        }
+    }
+    s_idle_pending = 1;
+}
+
+static void stream_start(void)
+{
+    memset(s_buf, 0, sizeof(s_buf));
+    s_dma_total = 0U;
+    s_lagging_events = 0U;
+    CHECK_EQ(uart_stream_init(&s_stream, &huart2, s_buf, BUF_SIZE), HAL_OK);
+    CHECK_EQ(uart_stream_start(&s_stream), HAL_OK);
+}
+
+static void test_init_args(void)
+{
+    uart_stream_t s;
+
+    CHECK_EQ(uart_stream_init(&s, &huart2, s_buf, 1000U), HAL_ERROR);
+    CHECK_EQ(uart_stream_init(&s, &huart2, s_buf, 1U), HAL_ERROR);
+    CHECK_EQ(uart_stream_init(&s, NULL, s_buf, BUF_SIZE), HAL_ERROR);
+    CHECK_EQ(uart_stream_init(&s, &huart2, NULL, BUF_SIZE), HAL_ERROR);
+    CHECK_EQ(uart_stream_init(&s, &huart2, s_buf, BUF_SIZE), HAL_OK);
+}
+
+static void test_order_across_wrap(void)
+{
+    uart_stream_stats_t stats;
+    uint32_t got = 0U, wrapped_reads = 0U, peeks = 0U;
+    uint8_t dst[BUF_SIZE];
+
+    stream_start();
+    while (s_dma_total < ORDER_BYTES)
+    {
+        uint32_t r = rand_next();
+
+        burst(1U + rand_next() % (BUF_SIZE / 4U), 1U + rand_next() % 64U);
+        if ((r % 4U) == 0U)
+        {
+            isr_all();
+        }
+        while (uart_stream_available(&s_stream) != 0U)
+        {
+            if ((rand_next() % 2U) == 0U)
+            {
+                uint32_t offset = (s_stream.tail - s_stream.rx_base) & (BUF_SIZE - 1U);
+                size_t n = uart_stream_read(&s_stream, dst, 1U + rand_next() % BUF_SIZE);
+                size_t i;
+
+                wrapped_reads += (offset + n > BUF_SIZE) ? 1U : 0U;
+                for (i = 0U; i < n; i++)
+                {
+                    CHECK_EQ(dst[i], sent_byte(got + (uint32_t)i));
+                }
+                got += (uint32_t)n;
+            }
+            else
+            {
+                const uint8_t *data;
+                size_t n = uart_stream_peek(&s_stream, &data);
+                size_t use = 1U + rand_next() % n;
+                uint32_t extra = rand_next() % GUARD;
+                size_t i;
+
+                /* 读取方处理期间 DMA 继续写入余量以内的字节，已取得的数据不被覆盖 */
+                CHECK(n != 0U);
+                CHECK(data + n <= s_buf + BUF_SIZE);
+                peeks++;
+                while ((extra-- != 0U) && !(s_ht_pending && (s_dma_pos == BUF_SIZE / 2U - 1U)) &&
+                       !(s_tc_pending && (s_dma_pos == BUF_SIZE - 1U)))
+                {
+                    dma_rx_byte();
+                }
+                for (i = 0U; i < n; i++)
+                {
+                    CHECK_EQ(data[i], sent_byte(got + (uint32_t)i));
+                }
+                uart_stream_consume(&s_stream, use);
+                got += (uint32_t)use;
+                s_idle_pending = 1;
+            }
+            isr_all();
+        }
+    }
+    isr_all();
+    got += (uint32_t)uart_stream_read(&s_stream, dst, sizeof(dst));
+    CHECK_EQ(got, s_dma_total);
+    CHECK_EQ(s_stream.rx_head, s_dma_total);
+
+    uart_stream_get_stats(&s_stream, &stats);
+    CHECK_EQ(stats.rx_dropped, 0U);
+    CHECK_EQ(stats.rx_bytes, s_dma_total);
+    CHECK(wrapped_reads > 100U);
+    CHECK(s_lagging_events > 100U);
+    printf("order: %u bytes, %u events (%u lagging HT/TC ignored), %u reads across the wrap, %u peeks\n",
+           (unsigned)s_dma_total, (unsigned)stats.rx_events, (unsigned)s_lagging_events,
+           (unsigned)wrapped_reads, (unsigned)peeks);
+}
+
+static void test_overrun_count(void)
+{
+    uart_stream_stats_t stats;
+    uint32_t model_tail = 0U, model_dropped = 0U, overruns = 0U;
+    uint8_t dst[BUF_SIZE];
+
+    stream_start();
+    while (s_dma_total < OVERRUN_BYTES)
+    {
+        uint32_t stall = ((rand_next() % 8U) == 0U) ? (rand_next() % (4U * BUF_SIZE)) : (rand_next() % GUARD);
+        uint32_t reads = 1U + rand_next() % 3U;
+
+        /* 读取方停顿期间事件照常处理 */
+        burst(stall + 1U, 1U + rand_next() % 32U);
+        isr_all();
+        while (reads-- != 0U)
+        {
+            uint32_t min_tail = s_dma_total - LIMIT;
+            size_t n, i;
+
+            /* 同步：未读加未上报超过 (缓冲区 - 余量) 时跳到 DMA 位置之前 LIMIT 字节处 */
+            if ((s_dma_total > LIMIT) && ((int32_t)(min_tail - model_tail) > 0))
+            {
+                model_dropped += min_tail - model_tail;
+                model_tail = min_tail;
+                overruns++;
+            }
+            n = uart_stream_read(&s_stream, dst, 1U + rand_next() % BUF_SIZE);
+            CHECK_EQ(s_stream.tail, model_tail + (uint32_t)n);
+            for (i = 0U; i < n; i++)
+            {
+                CHECK_EQ(dst[i], sent_byte(model_tail + (uint32_t)i));
+            }
+            model_tail += (uint32_t)n;
+            if ((rand_next() % 4U) == 0U)
+            {
+                /* 读取间隙中 DMA 写入少量字节但尚未上报 */
+                burst(rand_next() % (GUARD / 2U), 1024U);
+            }
+        }
+    }
+    uart_stream_get_stats(&s_stream, &stats);
+    CHECK_EQ(stats.rx_dropped, model_dropped);
+    CHECK(overruns > 200U);
+    printf("overrun: %u bytes, %u overruns, %u bytes dropped\n", (unsigned)s_dma_total, (unsigned)overruns,
+           (unsigned)stats.rx_dropped);
+}
+
+static void dma_rx_bytes(uint32_t n)
+{
+    while (n-- != 0U)
+    {
+        dma_rx_byte();
+    }
+}
+
+/** 读出全部数据并核对，返回读出的字节数 */
+static uint32_t read_check(uint32_t first)
+{
+    uint8_t dst[BUF_SIZE];
+    uint32_t got = 0U;
+    size_t n, i;
+
+    while ((n = uart_stream_read(&s_stream, dst, sizeof(dst))) != 0U)
+    {
+        for (i = 0U; i < n; i++)
+        {
+            CHECK_EQ(dst[i], sent_byte(first + got + (uint32_t)i));
+        }
+        got += (uint32_t)n;
+    }
+    return got;
+}
+
+static void test_event_edges(void)
+{
+    uart_stream_stats_t stats;
+    uint32_t base;
+
+    /* IDLE 先于挂起的 HT 处理且新数据超过半个缓冲区：IDLE 全部接受，随后落后的 HT 忽略 */
+    stream_start();
+    dma_rx_bytes(100U);
+    idle_isr();
+    CHECK_EQ(uart_stream_available(&s_stream), 100U);
+    dma_rx_bytes(BUF_SIZE / 2U + 100U);
+    idle_isr();
+    CHECK_EQ(uart_stream_available(&s_stream), BUF_SIZE / 2U + 200U);
+    dma_isr();
+    CHECK_EQ(uart_stream_available(&s_stream), BUF_SIZE / 2U + 200U);
+    CHECK_EQ(read_check(0U), BUF_SIZE / 2U + 200U);
+
+    /* DMA 已写入但未上报的字节也占用缓冲区：已上报未读 LIMIT - 10 字节，再写入 50 字节，最早的 40 字节作废 */
+    base = s_dma_total;
+    burst(LIMIT - 10U, 1U);
+    isr_all();
+    dma_rx_bytes(50U);
+    CHECK_EQ(read_check(base + 40U), LIMIT - 10U - 40U);
+    uart_stream_get_stats(&s_stream, &stats);
+    CHECK_EQ(stats.rx_dropped, 40U);
+
+    /* 中断被长时间屏蔽，未上报部分本身超过 LIMIT：读指针不越过已上报的 rx_head，事件处理后再丢弃超出部分 */
+    dma_isr();
+    idle_isr();
+    CHECK_EQ(read_check(s_dma_total - 50U), 50U);
+    base = s_dma_total;
+    dma_rx_bytes(LIMIT + 20U);
+    CHECK_EQ(uart_stream_available(&s_stream), 0U);
+    dma_isr();
+    idle_isr();
+    CHECK_EQ(read_check(base + 20U), LIMIT);
+    uart_stream_get_stats(&s_stream, &stats);
+    CHECK_EQ(stats.rx_dropped, 60U);
+}
+
+static void test_error_restart(void)
+{
+    uart_stream_stats_t stats;
+    uint8_t dst[BUF_SIZE];
+    uint32_t starts = s_dma_starts;
+    size_t n, i;
+
+    stream_start();
+    burst(BUF_SIZE / 2U + 100U, 1U);
+    isr_all();
+    CHECK_EQ(uart_stream_read(&s_stream, dst, 100U), 100U);
+
+    /* HAL 在溢出错误时中止了 RX DMA：RxState 回到 READY，DMA 从偏移 0 重新开始 */
+    huart2.RxState = HAL_UART_STATE_READY;
+    uart_stream_on_error(&s_stream, &huart2);
+    CHECK_EQ(s_dma_starts, starts + 2U);
+    burst(200U, 1U);
+    isr_all();
+    n = uart_stream_read(&s_stream, dst, sizeof(dst));
+    CHECK_EQ(n, 200U);
+    for (i = 0U; i < n; i++)
+    {
+        CHECK_EQ(dst[i], sent_byte(BUF_SIZE / 2U + 100U + (uint32_t)i));
+    }
+    uart_stream_get_stats(&s_stream, &stats);
+    CHECK_EQ(stats.rx_errors, 1U);
+    CHECK_EQ(stats.rx_dropped, BUF_SIZE / 2U);
+
+    /* 只有发送错误（RxState 仍为 BUSY_RX）时不重启接收 */
+    uart_stream_on_error(&s_stream, &huart2);
+    CHECK_EQ(s_dma_starts, starts + 2U);
+}
+
+static void test_forward(void)
+{
+    uart_stream_stats_t stats;
+
+    stream_start();
+    s_tx_out = 0U;
+    uart_stream_forward(&s_stream, &s_huart1);
+    CHECK_EQ(host_primask, 0U);
+    while (s_dma_total < FORWARD_BYTES)
+    {
+        uint32_t len = 1U + rand_next() % (BUF_SIZE / 2U);
+        uint32_t i;
+
+        /* 转发串口与接收串口同速：每接收一个字节 TX 至多移出一个字节，段在余量以内发完 */
+        for (i = 0U; i < len; i++)
+        {
+            burst(1U, 16U);
+            if ((rand_next() % 16U) == 0U)
+            {
+                tx_complete();
+            }
+        }
+        isr_all();
+        tx_complete();
+    }
+    while (s_tx_len != 0U)
+    {
+        tx_complete();
+    }
+    isr_all();
+    tx_complete();
+    CHECK_EQ(s_tx_out, s_dma_total);
+
+    uart_stream_get_stats(&s_stream, &stats);
+    CHECK_EQ(stats.tx_bytes, s_dma_total);
+    CHECK_EQ(stats.rx_dropped, 0U);
+    printf("forward: %u bytes in %u TX DMA segments\n", (unsigned)stats.tx_bytes, (unsigned)stats.tx_segments);
+    s_stream.fwd = NULL;
+}
+
+int main(void)
+{
+    test_init_args();
+    test_order_across_wrap();
+    test_overrun_count();
+    test_event_edges();
+    test_error_restart();
+    test_forward();
+    return HOST_TEST_DONE();
+}
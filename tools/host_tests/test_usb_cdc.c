@@ -0,0 +1,377 @@
+/**
+ * @file test_usb_cdc.c
+ * @brief rocketpi_usb_cdc 的 usbd_cdc_if：接收包槽环（NAK 流控）与发送合并环。
+ *
+ * USB CDC 类替身模拟两个端点：
+ *   - OUT：只有 USBD_CDC_ReceivePacket 武装后主机才能写入一个包（否则记一次 NAK），
+ *     写入 USBD_CDC_SetRxBuffer 指定的缓冲后调用 Receive 回调；
+ *   - IN：USBD_CDC_TransmitPacket 启动一次传输，测试在随机时刻"完成"它，
+ *     此时才从缓冲拷出数据（在途区被改写会表现为数据错误），再调用 TransmitCplt。
+ * 主机连续发送满包、短包与零长包，应用随机延迟、随机长度读取，随机长度写入；
+ * 检查两个方向的字节流与参考完全一致、可读字节数一致、接收环满时确实 NAK 而不丢数据、
+ * 每次传输不跨越缓冲末尾，并输出写入次数与传输次数之比。
+ */
+#include "usbd_cdc_if.h"
+#include "host_test.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RX_STREAM_BYTES     (4U * 1024U * 1024U)
+#define TX_STREAM_BYTES     (4U * 1024U * 1024U)
+
+extern uint8_t UserRxBufferFS[APP_RX_DATA_SIZE];
+extern uint8_t UserTxBufferFS[APP_TX_DATA_SIZE];
+
+uint32_t host_primask;
+USBD_HandleTypeDef hUsbDeviceFS;
+
+static uint8_t s_class_data;
+static uint32_t s_tick;
+
+static uint32_t s_rand = 0xC0C0A5A5U;
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+    return s_rand >> 8;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return s_tick++;
+}
+
+/* ---------------- CDC 类替身 ---------------- */
+
+typedef struct
+{
+    uint8_t *rx_buffer;
+    bool rx_armed;
+    uint8_t *tx_buffer;
+    uint32_t tx_length;
+    bool tx_active;
+    uint32_t tx_start_length;
+    uint32_t nak;
+    uint32_t packets;
+    uint32_t transfers;
+    uint32_t zlp;
+} usb_t;
+
+static usb_t s_usb;
+
+uint8_t USBD_CDC_SetTxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff, uint32_t length)
+{
+    s_usb.tx_buffer = pbuff;
+    s_usb.tx_length = length;
+    return USBD_OK;
+}
+
+uint8_t USBD_CDC_TransmitPacket(USBD_HandleTypeDef *pdev)
+{
+    if (s_usb.tx_active)
+    {
+        return USBD_BUSY;
+    }
+    CHECK(s_usb.tx_length > 0U);
+    CHECK(s_usb.tx_buffer >= UserTxBufferFS);
+    CHECK(s_usb.tx_buffer + s_usb.tx_length <= UserTxBufferFS + APP_TX_DATA_SIZE);
+    s_usb.tx_active = true;
+    s_usb.tx_start_length = s_usb.tx_length;
+    ++s_usb.transfers;
+    return USBD_OK;
+}
+
+uint8_t USBD_CDC_SetRxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff)
+{
+    s_usb.rx_buffer = pbuff;
+    return USBD_OK;
+}
+
+uint8_t USBD_CDC_ReceivePacket(USBD_HandleTypeDef *pdev)
+{
+    CHECK(!s_usb.rx_armed);
+    CHECK(s_usb.rx_buffer >= UserRxBufferFS);
+    CHECK(s_usb.rx_buffer + CDC_DATA_FS_OUT_PACKET_SIZE <= UserRxBufferFS + APP_RX_DATA_SIZE);
+    s_usb.rx_armed = true;
+    return USBD_OK;
+}
+
+/* ---------------- 两个方向的参考字节流 ---------------- */
+
+static uint8_t *s_rx_stream;    /* 主机发出的字节 */
+static uint32_t s_rx_sent;
+static uint32_t s_rx_read;
+static uint32_t s_rx_errors;
+
+static uint8_t *s_tx_stream;    /* 应用写入的字节 */
+static uint32_t s_tx_written;
+static uint32_t s_tx_received;
+static uint32_t s_tx_errors;
+static uint32_t s_tx_writes;
+
+static void usb_reset(void)
+{
+    memset(&s_usb, 0, sizeof(s_usb));
+    hUsbDeviceFS.pClassData = &s_class_data;
+    CHECK_EQ(USBD_Interface_fops_FS.Init(), USBD_OK);
+    /* USBD_CDC_Init 在接口 Init 之后武装 OUT 端点 */
+    CHECK(USBD_CDC_ReceivePacket(&hUsbDeviceFS) == USBD_OK);
+}
+
+/* 主机发一个 OUT 包；端点未武装时 NAK */
+static bool host_out(uint32_t length)
+{
+    if (!s_usb.rx_armed)
+    {
+        ++s_usb.nak;
+        return false;
+    }
+    if (length > RX_STREAM_BYTES - s_rx_sent)
+    {
+        length = RX_STREAM_BYTES - s_rx_sent;
+    }
+    memcpy(s_usb.rx_buffer, &s_rx_stream[s_rx_sent], length);
+    s_rx_sent += length;
+    s_usb.rx_armed = false;
+    ++s_usb.packets;
+
+    uint32_t len = length;
+    CHECK_EQ(USBD_Interface_fops_FS.Receive(s_usb.rx_buffer, &len), USBD_OK);
+    return true;
+}
+
+/* IN 传输完成：此刻才从缓冲取数据 */
+static void host_in_complete(void)
+{
+    if (!s_usb.tx_active)
+    {
+        return;
+    }
+    uint32_t length = s_usb.tx_start_length;
+    for (uint32_t i = 0U; i < length; ++i)
+    {
+        if (s_tx_received + i >= s_tx_written || s_usb.tx_buffer[i] != s_tx_stream[s_tx_received + i])
+        {
+            ++s_tx_errors;
+            break;
+        }
+    }
+    s_tx_received += length;
+    if ((length % CDC_DATA_FS_IN_PACKET_SIZE) == 0U)
+    {
+        ++s_usb.zlp;
+    }
+    s_usb.tx_active = false;
+    CHECK_EQ(USBD_Interface_fops_FS.TransmitCplt(s_usb.tx_buffer, &length, 0x81U), USBD_OK);
+}
+
+static void app_read(uint32_t size)
+{
+    static uint8_t buffer[600];
+
+    CHECK_EQ(CDC_GetRxAvailable(), s_rx_sent - s_rx_read);
+    CHECK_EQ(CDC_IsRxReady(), (s_rx_sent != s_rx_read) ? 1U : 0U);
+
+    uint32_t n = CDC_ReadRxData(buffer, size);
+    CHECK(n <= size);
+    CHECK_EQ(n, (s_rx_sent - s_rx_read < size) ? s_rx_sent - s_rx_read : size);
+    if (memcmp(buffer, &s_rx_stream[s_rx_read], n) != 0)
+    {
+        ++s_rx_errors;
+    }
+    s_rx_read += n;
+}
+
+static void app_write(uint32_t size)
+{
+    if (size > TX_STREAM_BYTES - s_tx_written)
+    {
+        size = TX_STREAM_BYTES - s_tx_written;
+    }
+    if (size == 0U)
+    {
+        return;
+    }
+
+    const uint32_t free_before = CDC_GetTxFree();
+    uint32_t n;
+    if (rand_next() % 2U == 0U)
+    {
+        n = CDC_Write(&s_tx_stream[s_tx_written], size);
+        CHECK_EQ(n, (size < free_before) ? size : free_before);
+    }
+    else
+    {
+        /* 全有或全无 */
+        const uint8_t status = CDC_Transmit_FS(&s_tx_stream[s_tx_written], (uint16_t)size);
+        CHECK_EQ(status, (size <= free_before) ? USBD_OK : USBD_BUSY);
+        n = (status == USBD_OK) ? size : 0U;
+    }
+    CHECK_EQ(host_primask, 0U);
+    s_tx_written += n;
+    s_tx_writes += (n > 0U) ? 1U : 0U;
+    CHECK_EQ(CDC_GetTxFree(), free_before - n);
+    /* 端点空闲且有数据时必须已经启动传输 */
+    CHECK(s_usb.tx_active || s_tx_written == s_tx_received);
+}
+
+/*
+ * 主机尽量背靠背发满包，应用时而停顿（接收环填满、端点 NAK），时而一次读很多；
+ * 发送方向同时随机写入与完成传输。
+ */
+static void test_stream(void)
+{
+    uint32_t stalls = 0U;
+    uint32_t steps = 0U;
+    const uint32_t transfers_before = CDC_GetTxTransferCount();
+
+    usb_reset();
+    while (s_rx_read < RX_STREAM_BYTES || s_tx_received < TX_STREAM_BYTES)
+    {
+        ++steps;
+        CHECK(steps < 2000000U);
+        if (steps >= 2000000U)
+        {
+            break;
+        }
+
+        /* 一串 OUT 包：多数是满包，偶尔短包或零长包 */
+        uint32_t burst = 1U + rand_next() % 48U;
+        while (burst-- > 0U && s_rx_sent < RX_STREAM_BYTES)
+        {
+            const uint32_t r = rand_next() % 16U;
+            const uint32_t length = (r < 12U) ? CDC_DATA_FS_OUT_PACKET_SIZE
+                                  : (r < 15U) ? 1U + rand_next() % (CDC_DATA_FS_OUT_PACKET_SIZE - 1U) : 0U;
+            if (!host_out(length))
+            {
+                break;
+            }
+        }
+
+        /* 应用偶尔长时间不读 */
+        if (rand_next() % 8U == 0U)
+        {
+            ++stalls;
+        }
+        else
+        {
+            app_read(1U + rand_next() % ((rand_next() % 4U == 0U) ? 600U : 70U));
+        }
+
+        app_write(1U + rand_next() % ((rand_next() % 8U == 0U) ? APP_TX_DATA_SIZE : 100U));
+        if (rand_next() % 3U == 0U)
+        {
+            host_in_complete();
+        }
+
+        if (s_rx_sent == RX_STREAM_BYTES)
+        {
+            app_read(600U);
+        }
+        if (s_tx_written == TX_STREAM_BYTES)
+        {
+            host_in_complete();
+        }
+    }
+
+    CHECK_EQ(s_rx_errors, 0U);
+    CHECK_EQ(s_tx_errors, 0U);
+    CHECK_EQ(s_rx_read, RX_STREAM_BYTES);
+    CHECK_EQ(s_tx_received, TX_STREAM_BYTES);
+    CHECK(s_usb.nak > 0U);
+    CHECK_EQ(CDC_GetTxTransferCount() - transfers_before, s_usb.transfers);
+    CHECK(s_usb.transfers < s_tx_writes);
+    CHECK_EQ(CDC_TxFlush(10U), USBD_OK);
+
+    printf("rx: %u bytes in %u packets, %u NAKs while the ring was full, %u read stalls\n",
+           (unsigned)s_rx_read, (unsigned)s_usb.packets, (unsigned)s_usb.nak, (unsigned)stalls);
+    printf("tx: %u bytes from %u writes in %u transfers (%.1f writes per transfer, %u ZLPs)\n",
+           (unsigned)s_tx_received, (unsigned)s_tx_writes, (unsigned)s_usb.transfers,
+           (double)s_tx_writes / (double)s_usb.transfers, (unsigned)s_usb.zlp);
+}
+
+/* 环满后端点保持 NAK，直到读走一个完整的包 */
+static void test_rx_pause(void)
+{
+    static uint8_t buffer[APP_RX_DATA_SIZE];
+    const uint32_t slots = APP_RX_DATA_SIZE / CDC_DATA_FS_OUT_PACKET_SIZE;
+
+    s_rx_sent = 0U;
+    s_rx_read = 0U;
+    usb_reset();
+    for (uint32_t i = 0U; i < slots; ++i)
+    {
+        CHECK(host_out(CDC_DATA_FS_OUT_PACKET_SIZE));
+    }
+    CHECK(!s_usb.rx_armed);
+    CHECK(!host_out(CDC_DATA_FS_OUT_PACKET_SIZE));
+    CHECK_EQ(CDC_GetRxAvailable(), APP_RX_DATA_SIZE);
+
+    /* 读半个包不释放槽位 */
+    app_read(CDC_DATA_FS_OUT_PACKET_SIZE / 2U);
+    CHECK(!s_usb.rx_armed);
+    app_read(CDC_DATA_FS_OUT_PACKET_SIZE / 2U);
+    CHECK(s_usb.rx_armed);
+    CHECK(host_out(10U));
+    CHECK(!s_usb.rx_armed);
+
+    CHECK_EQ(CDC_ReadRxData(buffer, sizeof(buffer)), APP_RX_DATA_SIZE - CDC_DATA_FS_OUT_PACKET_SIZE + 10U);
+    CHECK(memcmp(buffer, &s_rx_stream[s_rx_read], APP_RX_DATA_SIZE - CDC_DATA_FS_OUT_PACKET_SIZE + 10U) == 0);
+    s_rx_read = s_rx_sent;
+    CHECK(s_usb.rx_armed);
+    CHECK_EQ(CDC_IsRxReady(), 0U);
+    CHECK_EQ(CDC_ReadRxData(buffer, sizeof(buffer)), 0U);
+    CHECK_EQ(CDC_ReadRxData(NULL, 10U), 0U);
+}
+
+/* 发送环：放不下的长度、未枚举、在途未完成时 Flush 超时 */
+static void test_tx_edges(void)
+{
+    static uint8_t data[APP_TX_DATA_SIZE + 1U];
+
+    s_tx_written = 0U;
+    s_tx_received = 0U;
+    usb_reset();
+    CHECK_EQ(CDC_Transmit_FS(data, APP_TX_DATA_SIZE + 1U), USBD_FAIL);
+    CHECK_EQ(CDC_Transmit_FS(data, APP_TX_DATA_SIZE), USBD_OK);
+    CHECK(s_usb.tx_active);
+    CHECK_EQ(s_usb.tx_start_length, APP_TX_DATA_SIZE);
+    CHECK_EQ(CDC_GetTxFree(), 0U);
+    CHECK_EQ(CDC_Transmit_FS(data, 1U), USBD_BUSY);
+    CHECK_EQ(CDC_Write(data, 1U), 0U);
+    CHECK_EQ(CDC_TxFlush(5U), USBD_BUSY);
+
+    hUsbDeviceFS.pClassData = NULL;
+    CHECK_EQ(CDC_Transmit_FS(data, 1U), USBD_BUSY);
+    CHECK_EQ(CDC_TxFlush(5U), USBD_BUSY);
+    hUsbDeviceFS.pClassData = &s_class_data;
+}
+
+int main(void)
+{
+    s_rx_stream = malloc(RX_STREAM_BYTES);
+    s_tx_stream = malloc(TX_STREAM_BYTES);
+    CHECK(s_rx_stream != NULL && s_tx_stream != NULL);
+    for (uint32_t i = 0U; i < RX_STREAM_BYTES; ++i)
+    {
+        s_rx_stream[i] = (uint8_t)rand_next();
+    }
+    for (uint32_t i = 0U; i < TX_STREAM_BYTES; ++i)
+    {
+        s_tx_stream[i] = (uint8_t)rand_next();
+    }
+
+    test_rx_pause();
+    test_tx_edges();
+    s_rx_sent = 0U;
+    s_rx_read = 0U;
+    s_tx_written = 0U;
+    s_tx_received = 0U;
+    test_stream();
+
+    free(s_rx_stream);
+    free(s_tx_stream);
+    return HOST_TEST_DONE();
+}
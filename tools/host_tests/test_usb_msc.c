@@ -0,0 +1,497 @@
+/**
+ * @file test_usb_msc.c
+ * @brief rocketpi_usb_msc：经真实 ST MSC 类（BOT + SCSI）回放 SCSI 命令序列，检查 RAM 盘的多块媒体包。
+ *
+ * 编译 ST 中间件的 usbd_msc*.c、usbd_storage_if.c 与 bsp/msc_storage，USBD_LL_* 替身模拟两个批量端点：
+ *   - OUT：USBD_LL_PrepareReceive 武装后，主机写入 CBW 或写数据并调用 DataOut；
+ *   - IN：USBD_LL_Transmit 记下一次传输，主机取走后调用 DataIn；
+ *   - STALL：记下被停止的端点，主机按 BOT 规范用 CLEAR_FEATURE(ENDPOINT_HALT) 解除后读 CSW。
+ * 回放的序列先模拟主机枚举后的探测（INQUIRY、READ CAPACITY、MODE SENSE、TEST UNIT READY），
+ * 再随机读写任意 LBA 与长度（含越界），与参考镜像比较数据、CSW 状态与剩余量，
+ * 越界后 REQUEST SENSE 必须报告 ILLEGAL REQUEST / LBA OUT OF RANGE；
+ * 同时检查每个数据阶段按 MSC_MEDIA_PACKET 切分（即每次 STORAGE_Read/Write 处理的块数）。
+ */
+#include "usbd_msc.h"
+#include "usbd_storage_if.h"
+#include "msc_storage.h"
+#include "host_test.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DISK_BLOCKS         128U            /* msc_storage_ram.c：64 KB */
+#define DISK_BYTES          (DISK_BLOCKS * MSC_STORAGE_BLOCK_SIZE)
+#define TRACE_COMMANDS      6000U
+#define CBW_SIGNATURE       0x43425355U
+#define CSW_SIGNATURE       0x53425355U
+
+uint32_t host_primask;
+
+uint32_t HAL_GetTick(void)
+{
+    return 0U;
+}
+
+void HAL_Delay(uint32_t delay)
+{
+}
+
+/* ---------------- USBD 核心与底层替身 ---------------- */
+
+typedef struct
+{
+    uint8_t *out_buffer;
+    uint32_t out_length;
+    bool out_armed;
+    uint32_t rx_size;
+    uint8_t *in_buffer;
+    uint32_t in_length;
+    bool in_pending;
+    bool in_stall;
+    bool out_stall;
+} endpoints_t;
+
+static endpoints_t s_ep;
+static USBD_HandleTypeDef s_dev;
+static USBD_MSC_BOT_HandleTypeDef s_msc_storage;
+static bool s_msc_allocated;
+
+void *USBD_static_malloc(uint32_t size)
+{
+    CHECK(size <= sizeof(s_msc_storage));
+    CHECK(!s_msc_allocated);
+    s_msc_allocated = true;
+    return &s_msc_storage;
+}
+
+void USBD_static_free(void *p)
+{
+    s_msc_allocated = false;
+}
+
+USBD_StatusTypeDef USBD_LL_OpenEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr, uint8_t ep_type, uint16_t ep_mps)
+{
+    return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_CloseEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+    return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_FlushEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+    return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_StallEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+    if ((ep_addr & 0x80U) != 0U)
+    {
+        s_ep.in_stall = true;
+    }
+    else
+    {
+        s_ep.out_stall = true;
+    }
+    return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_ClearStallEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+    if ((ep_addr & 0x80U) != 0U)
+    {
+        s_ep.in_stall = false;
+    }
+    else
+    {
+        s_ep.out_stall = false;
+    }
+    return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_Transmit(USBD_HandleTypeDef *pdev, uint8_t ep_addr, uint8_t *pbuf, uint32_t size)
+{
+    CHECK_EQ(ep_addr, MSC_EPIN_ADDR);
+    CHECK(!s_ep.in_pending);
+    s_ep.in_buffer = pbuf;
+    s_ep.in_length = size;
+    s_ep.in_pending = true;
+    return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_PrepareReceive(USBD_HandleTypeDef *pdev, uint8_t ep_addr, uint8_t *pbuf, uint32_t size)
+{
+    CHECK_EQ(ep_addr, MSC_EPOUT_ADDR);
+    s_ep.out_buffer = pbuf;
+    s_ep.out_length = size;
+    s_ep.out_armed = true;
+    return USBD_OK;
+}
+
+uint32_t USBD_LL_GetRxDataSize(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+    return s_ep.rx_size;
+}
+
+USBD_StatusTypeDef USBD_CtlSendData(USBD_HandleTypeDef *pdev, uint8_t *pbuf, uint32_t len)
+{
+    return USBD_OK;
+}
+
+void USBD_CtlError(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req)
+{
+    CHECK(0);
+}
+
+void *USBD_GetEpDesc(uint8_t *pConfDesc, uint8_t EpAddr)
+{
+    return NULL;
+}
+
+/* ---------------- 主机侧 BOT ---------------- */
+
+typedef struct
+{
+    uint8_t status;             /* CSW bStatus */
+    uint32_t residue;
+    uint32_t received;          /* 数据阶段实际传输的字节数 */
+    uint32_t data_transfers;    /* 数据阶段的 IN/OUT 传输次数 */
+    uint32_t max_transfer;
+    bool stalled;
+} bot_result_t;
+
+static uint32_t s_tag;
+
+static void clear_halt(uint8_t ep_addr)
+{
+    USBD_SetupReqTypedef req;
+
+    memset(&req, 0, sizeof(req));
+    req.bmRequest = USB_REQ_TYPE_STANDARD | USB_REQ_RECIPIENT_ENDPOINT;
+    req.bRequest = USB_REQ_CLEAR_FEATURE;
+    req.wValue = USB_FEATURE_EP_HALT;
+    req.wIndex = ep_addr;
+    /* 核心先解除 STALL，再交给类处理 */
+    (void)USBD_LL_ClearStallEP(&s_dev, ep_addr);
+    CHECK_EQ(USBD_MSC.Setup(&s_dev, &req), USBD_OK);
+}
+
+/*
+ * 执行一条命令：data 为 IN 方向的接收缓冲或 OUT 方向的写数据，length 为 CBW 的 dDataLength。
+ */
+static bot_result_t bot_command(const uint8_t *cdb, uint8_t cdb_length, bool data_in, uint8_t *data, uint32_t length)
+{
+    USBD_MSC_BOT_HandleTypeDef *hmsc = (USBD_MSC_BOT_HandleTypeDef *)s_dev.pClassDataCmsit[0];
+    USBD_MSC_BOT_CBWTypeDef cbw;
+    bot_result_t result;
+
+    memset(&result, 0, sizeof(result));
+    memset(&cbw, 0, sizeof(cbw));
+    cbw.dSignature = CBW_SIGNATURE;
+    cbw.dTag = ++s_tag;
+    cbw.dDataLength = length;
+    cbw.bmFlags = data_in ? 0x80U : 0x00U;
+    cbw.bCBLength = cdb_length;
+    memcpy(cbw.CB, cdb, cdb_length);
+
+    CHECK(s_ep.out_armed && s_ep.out_length == USBD_BOT_CBW_LENGTH);
+    CHECK(s_ep.out_buffer == (uint8_t *)&hmsc->cbw);
+    memcpy(s_ep.out_buffer, &cbw, USBD_BOT_CBW_LENGTH);
+    s_ep.rx_size = USBD_BOT_CBW_LENGTH;
+    s_ep.out_armed = false;
+    CHECK_EQ(USBD_MSC.DataOut(&s_dev, MSC_EPOUT_ADDR & 0x7FU), USBD_OK);
+
+    for (uint32_t guard = 0U; guard < 100000U; ++guard)
+    {
+        if (s_ep.in_stall || s_ep.out_stall)
+        {
+            result.stalled = true;
+            if (s_ep.out_stall)
+            {
+                clear_halt(MSC_EPOUT_ADDR);
+            }
+            if (s_ep.in_stall)
+            {
+                clear_halt(MSC_EPIN_ADDR);
+            }
+            continue;
+        }
+
+        if (s_ep.in_pending && s_ep.in_buffer == (uint8_t *)&hmsc->csw)
+        {
+            USBD_MSC_BOT_CSWTypeDef csw;
+
+            CHECK_EQ(s_ep.in_length, USBD_BOT_CSW_LENGTH);
+            memcpy(&csw, s_ep.in_buffer, USBD_BOT_CSW_LENGTH);
+            CHECK_EQ(csw.dSignature, CSW_SIGNATURE);
+            CHECK_EQ(csw.dTag, cbw.dTag);
+            result.status = csw.bStatus;
+            result.residue = csw.dDataResidue;
+            s_ep.in_pending = false;
+            CHECK_EQ(USBD_MSC.DataIn(&s_dev, MSC_EPIN_ADDR & 0x7FU), USBD_OK);
+            return result;
+        }
+
+        if (s_ep.in_pending)
+        {
+            CHECK(data_in);
+            CHECK(result.received + s_ep.in_length <= length);
+            if (data_in && result.received + s_ep.in_length <= length)
+            {
+                memcpy(&data[result.received], s_ep.in_buffer, s_ep.in_length);
+            }
+            result.received += s_ep.in_length;
+            result.data_transfers++;
+            result.max_transfer = (s_ep.in_length > result.max_transfer) ? s_ep.in_length : result.max_transfer;
+            s_ep.in_pending = false;
+            CHECK_EQ(USBD_MSC.DataIn(&s_dev, MSC_EPIN_ADDR & 0x7FU), USBD_OK);
+            continue;
+        }
+
+        if (s_ep.out_armed && !data_in && result.received < length)
+        {
+            uint32_t n = length - result.received;
+            n = (n < s_ep.out_length) ? n : s_ep.out_length;
+            memcpy(s_ep.out_buffer, &data[result.received], n);
+            s_ep.rx_size = n;
+            s_ep.out_armed = false;
+            result.received += n;
+            result.data_transfers++;
+            result.max_transfer = (n > result.max_transfer) ? n : result.max_transfer;
+            CHECK_EQ(USBD_MSC.DataOut(&s_dev, MSC_EPOUT_ADDR & 0x7FU), USBD_OK);
+            continue;
+        }
+
+        break;
+    }
+
+    printf("command 0x%02X stuck\n", cdb[0]);
+    CHECK(0);
+    result.status = 0xFFU;
+    return result;
+}
+
+/* ---------------- 回放 ---------------- */
+
+static uint8_t s_image[DISK_BYTES];
+static uint8_t s_buffer[DISK_BYTES + MSC_STORAGE_BLOCK_SIZE * 8U];
+static uint32_t s_rand = 0x4D5343A5U;
+
+static uint32_t rand_next(void)
+{
+    s_rand = s_rand * 1103515245U + 12345U;
+    return s_rand >> 8;
+}
+
+static void cdb_rw10(uint8_t *cdb, uint8_t opcode, uint32_t lba, uint16_t blocks)
+{
+    memset(cdb, 0, 10U);
+    cdb[0] = opcode;
+    cdb[2] = (uint8_t)(lba >> 24);
+    cdb[3] = (uint8_t)(lba >> 16);
+    cdb[4] = (uint8_t)(lba >> 8);
+    cdb[5] = (uint8_t)lba;
+    cdb[7] = (uint8_t)(blocks >> 8);
+    cdb[8] = (uint8_t)blocks;
+}
+
+static void expect_sense(uint8_t key, uint8_t asc)
+{
+    uint8_t cdb[6] = {SCSI_REQUEST_SENSE, 0U, 0U, 0U, REQUEST_SENSE_DATA_LEN, 0U};
+    uint8_t sense[REQUEST_SENSE_DATA_LEN];
+    const bot_result_t r = bot_command(cdb, 6U, true, sense, sizeof(sense));
+
+    CHECK_EQ(r.status, USBD_CSW_CMD_PASSED);
+    CHECK_EQ(r.received, REQUEST_SENSE_DATA_LEN);
+    CHECK_EQ(sense[2] & 0x0FU, key);
+    CHECK_EQ(sense[12], asc);
+}
+
+static void boot(void)
+{
+    memset(&s_dev, 0, sizeof(s_dev));
+    memset(&s_ep, 0, sizeof(s_ep));
+    s_dev.dev_speed = USBD_SPEED_FULL;
+    s_dev.dev_state = USBD_STATE_CONFIGURED;
+    CHECK_EQ(USBD_MSC_RegisterStorage(&s_dev, &USBD_Storage_Interface_fops_FS), USBD_OK);
+    CHECK_EQ(USBD_MSC.Init(&s_dev, 0U), USBD_OK);
+}
+
+/* 枚举后主机的探测序列 */
+static void test_probe(void)
+{
+    uint8_t data[64];
+    bot_result_t r;
+
+    const uint8_t inquiry[6] = {SCSI_INQUIRY, 0U, 0U, 0U, 36U, 0U};
+    r = bot_command(inquiry, 6U, true, data, 36U);
+    CHECK_EQ(r.status, USBD_CSW_CMD_PASSED);
+    CHECK_EQ(r.received, 36U);
+    CHECK(memcmp(&data[8], "RocketPiMass Storage", 20U) == 0);
+
+    const uint8_t capacity[10] = {SCSI_READ_CAPACITY10};
+    r = bot_command(capacity, 10U, true, data, 8U);
+    CHECK_EQ(r.status, USBD_CSW_CMD_PASSED);
+    CHECK_EQ(r.received, 8U);
+    CHECK_EQ(((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3],
+             DISK_BLOCKS - 1U);
+    CHECK_EQ(((uint32_t)data[6] << 8) | data[7], MSC_STORAGE_BLOCK_SIZE);
+
+    const uint8_t mode_sense[6] = {SCSI_MODE_SENSE6, 0U, 0x3FU, 0U, 4U, 0U};
+    r = bot_command(mode_sense, 6U, true, data, 4U);
+    CHECK_EQ(r.status, USBD_CSW_CMD_PASSED);
+    CHECK_EQ(r.received, 4U);
+    CHECK_EQ(data[2] & 0x80U, 0U);     /* 未写保护 */
+
+    const uint8_t ready[6] = {SCSI_TEST_UNIT_READY};
+    r = bot_command(ready, 6U, false, NULL, 0U);
+    CHECK_EQ(r.status, USBD_CSW_CMD_PASSED);
+
+    /* 上电内容为 0xFF */
+    uint8_t cdb[10];
+    cdb_rw10(cdb, SCSI_READ10, 0U, DISK_BLOCKS);
+    r = bot_command(cdb, 10U, true, s_buffer, DISK_BYTES);
+    CHECK_EQ(r.status, USBD_CSW_CMD_PASSED);
+    CHECK_EQ(r.residue, 0U);
+    for (uint32_t i = 0U; i < DISK_BYTES; ++i)
+    {
+        if (s_buffer[i] != 0xFFU)
+        {
+            CHECK(0);
+            break;
+        }
+    }
+    memset(s_image, 0xFF, sizeof(s_image));
+}
+
+/*
+ * 随机读写：偏向小的文件系统访问（1..8 块），也有跨多个媒体包的大传输与越界访问。
+ */
+static void test_trace(void)
+{
+    uint32_t reads = 0U;
+    uint32_t writes = 0U;
+    uint32_t rejected = 0U;
+    uint32_t blocks = 0U;
+    uint32_t transfers = 0U;
+
+    for (uint32_t n = 0U; n < TRACE_COMMANDS; ++n)
+    {
+        const bool write = (rand_next() % 2U) == 0U;
+        const uint32_t r = rand_next() % 16U;
+        uint32_t count = (r < 10U) ? 1U + rand_next() % 8U : 1U + rand_next() % DISK_BLOCKS;
+        uint32_t lba = rand_next() % DISK_BLOCKS;
+        const bool out_of_range = (rand_next() % 40U) == 0U;
+
+        if (out_of_range)
+        {
+            lba = DISK_BLOCKS - (rand_next() % 4U);
+            count += 4U;
+        }
+        else if (lba + count > DISK_BLOCKS)
+        {
+            count = DISK_BLOCKS - lba;
+        }
+
+        const uint32_t length = count * MSC_STORAGE_BLOCK_SIZE;
+        uint8_t cdb[10];
+        cdb_rw10(cdb, write ? SCSI_WRITE10 : SCSI_READ10, lba, (uint16_t)count);
+
+        if (write)
+        {
+            for (uint32_t i = 0U; i < length; ++i)
+            {
+                s_buffer[i] = (uint8_t)rand_next();
+            }
+        }
+        else
+        {
+            memset(s_buffer, 0xA5, length);
+        }
+
+        const bot_result_t result = bot_command(cdb, 10U, !write, s_buffer, length);
+
+        if (out_of_range)
+        {
+            CHECK_EQ(result.status, USBD_CSW_CMD_FAILED);
+            CHECK(result.stalled);
+            CHECK_EQ(result.received, 0U);
+            CHECK_EQ(result.residue, length);
+            expect_sense(ILLEGAL_REQUEST, ADDRESS_OUT_OF_RANGE);
+            ++rejected;
+            continue;
+        }
+
+        CHECK_EQ(result.status, USBD_CSW_CMD_PASSED);
+        CHECK(!result.stalled);
+        CHECK_EQ(result.residue, 0U);
+        CHECK_EQ(result.received, length);
+        /* 每个数据阶段按 MSC_MEDIA_PACKET 切分 */
+        CHECK_EQ(result.data_transfers, (length + MSC_MEDIA_PACKET - 1U) / MSC_MEDIA_PACKET);
+        CHECK_EQ(result.max_transfer, (length < MSC_MEDIA_PACKET) ? length : MSC_MEDIA_PACKET);
+
+        if (write)
+        {
+            memcpy(&s_image[lba * MSC_STORAGE_BLOCK_SIZE], s_buffer, length);
+            ++writes;
+        }
+        else
+        {
+            CHECK(memcmp(s_buffer, &s_image[lba * MSC_STORAGE_BLOCK_SIZE], length) == 0);
+            ++reads;
+        }
+        blocks += count;
+        transfers += result.data_transfers;
+    }
+
+    /* 最终镜像逐字节一致 */
+    uint8_t cdb[10];
+    cdb_rw10(cdb, SCSI_READ10, 0U, DISK_BLOCKS);
+    const bot_result_t result = bot_command(cdb, 10U, true, s_buffer, DISK_BYTES);
+    CHECK_EQ(result.status, USBD_CSW_CMD_PASSED);
+    CHECK(memcmp(s_buffer, s_image, DISK_BYTES) == 0);
+
+    printf("trace: %u reads, %u writes, %u out-of-range rejected, %u blocks in %u media packets "
+           "(%.2f blocks per STORAGE_Read/Write)\n",
+           (unsigned)reads, (unsigned)writes, (unsigned)rejected, (unsigned)blocks, (unsigned)transfers,
+           (double)blocks / (double)transfers);
+}
+
+/* 长度与块数不符（BOT case 3/13）、数据方向错误、零长度写 */
+static void test_mismatch(void)
+{
+    uint8_t cdb[10];
+    bot_result_t r;
+
+    cdb_rw10(cdb, SCSI_READ10, 0U, 2U);
+    r = bot_command(cdb, 10U, true, s_buffer, MSC_STORAGE_BLOCK_SIZE);
+    CHECK_EQ(r.status, USBD_CSW_CMD_FAILED);
+    expect_sense(ILLEGAL_REQUEST, INVALID_CDB);
+
+    cdb_rw10(cdb, SCSI_WRITE10, 0U, 1U);
+    r = bot_command(cdb, 10U, true, s_buffer, MSC_STORAGE_BLOCK_SIZE);
+    CHECK_EQ(r.status, USBD_CSW_CMD_FAILED);
+    expect_sense(ILLEGAL_REQUEST, INVALID_CDB);
+
+    cdb_rw10(cdb, SCSI_WRITE10, 0U, 1U);
+    r = bot_command(cdb, 10U, false, s_buffer, 0U);
+    CHECK_EQ(r.status, USBD_CSW_CMD_FAILED);
+    expect_sense(ILLEGAL_REQUEST, INVALID_CDB);
+
+    /* 之后仍可正常读取 */
+    cdb_rw10(cdb, SCSI_READ10, 3U, 9U);
+    r = bot_command(cdb, 10U, true, s_buffer, 9U * MSC_STORAGE_BLOCK_SIZE);
+    CHECK_EQ(r.status, USBD_CSW_CMD_PASSED);
+    CHECK(memcmp(s_buffer, &s_image[3U * MSC_STORAGE_BLOCK_SIZE], 9U * MSC_STORAGE_BLOCK_SIZE) == 0);
+}
+
+int main(void)
+{
+    boot();
+    test_probe();
+    test_trace();
+    test_mismatch();
+    return HOST_TEST_DONE();
+}